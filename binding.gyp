@@ -58,7 +58,28 @@
     {
       "target_name": "pulsar_fileops",
       "sources": [
+        "native/weave/weave.c",
+        "native/hash/nxh.c",
+        "native/dagger/dagger.c",
         "native/fileops/zorya_fileops.c",
+        "native/fileops/zorya_pool.c",
+        "native/fileops/zorya_tree.c",
+        "native/fileops/zorya_walk.c",
+        "native/fileops/zorya_watcher.c",
+        "native/fileops/zorya_glob.c",
+        "native/fileops/zorya_search.c",
+        "native/fileops/zorya_dedup.c",
+        "native/fileops/zorya_snapshot.c",
+        "native/fileops/zorya_batch.c",
+        "native/fileops/zorya_wal.c",
+        "native/fileops/zorya_kv.c",
+        "native/fileops/zorya_paths.c",
+        "native/fileops/zorya_stream.c",
+        "native/fileops/zorya_cache.c",
+        "native/fileops/zorya_channel.c",
+        "native/fileops/zorya_columns.c",
+        "native/fileops/zorya_tar.c",
+        "native/fileops/zorya_du.c",
         "native/fileops/fileops_napi.c"
       ],
       "include_dirs": [
@@ -72,6 +93,10 @@
       ],
       "cflags": ["-Wall", "-Wextra", "-O3", "-std=c99"],
       "cflags!": ["-fno-exceptions"],
+      "libraries": [
+        "<(module_root_dir)/native/compress/lib/libzstd.a",
+        "<(module_root_dir)/native/compress/lib/liblz4.a"
+      ],
       "xcode_settings": {
         "GCC_ENABLE_CPP_EXCEPTIONS": "YES",
         "CLANG_CXX_LIBRARY": "libc++",
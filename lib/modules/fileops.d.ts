@@ -59,6 +59,32 @@ export interface DirEntry {
     isDirectory: boolean;
     isSymlink: boolean;
 }
+/**
+ * Stat results as one typed array per field, index-aligned with the
+ * input. Entries that could not be stat'ed have mode 0.
+ */
+export interface StatColumns {
+    count: number;
+    size: Float64Array;
+    /** Modification time in ms since the epoch */
+    mtime: Float64Array;
+    ino: BigUint64Array;
+    /** st_mode including the file type bits */
+    mode: Uint32Array;
+    type: Uint8Array;
+}
+/**
+ * A directory listing with stats. Entry i is named
+ * names.toString('utf8', nameOffsets[i], nameOffsets[i + 1]).
+ */
+export interface DirColumns extends StatColumns {
+    names: Buffer;
+    nameOffsets: Uint32Array;
+}
+export interface StatManyOptions {
+    /** Stat symlink targets rather than the links (default true) */
+    followSymlinks?: boolean;
+}
 export interface WatchEvent {
     event: number;
     path: string;
@@ -70,10 +96,534 @@ export interface WatchEvent {
     isModify: boolean;
     isMove: boolean;
 }
+export declare enum WatchEventType {
+    Create = 1,
+    Delete = 2,
+    Modify = 4,
+    Rename = 8,
+    Attrib = 16,
+    Open = 32,
+    Close = 64,
+    MoveFrom = 128,
+    MoveTo = 256,
+    Overflow = 512,
+    Error = 1024
+}
+export interface WatchChange extends WatchEvent {
+    /** Raw events folded into this change */
+    count: number;
+}
+export interface EventWatcherOptions {
+    /** Quiet period in ms before a batch is delivered (default 50) */
+    debounce?: number;
+    /** Longest a change is held back in ms (default 1000) */
+    maxLatency?: number;
+    /** Deliver early once this many changes are pending (default 4096) */
+    maxBatch?: number;
+    /** Keep the process alive while open (default true) */
+    persistent?: boolean;
+}
+export interface WatchAddOptions {
+    /** Watch subdirectories too */
+    recursive?: boolean;
+    /** WatchEventType mask (default Create|Delete|Modify|Attrib|Rename) */
+    events?: number;
+}
+export declare enum MmapAdvice {
+    Normal = 0,
+    Sequential = 1,
+    Random = 2,
+    WillNeed = 3,
+    DontNeed = 4
+}
+export interface MmapOptions {
+    /** Byte offset into the file (any alignment) */
+    offset?: number;
+    /** Bytes to map (default: to end of file) */
+    length?: number;
+    /** Map for writing; changes reach the file when shared (default) */
+    write?: boolean;
+    shared?: boolean;
+}
+export declare enum FileAdvice {
+    Normal = 0,
+    Sequential = 1,
+    Random = 2,
+    WillNeed = 3,
+    DontNeed = 4,
+    NoReuse = 5
+}
+export type FileOpenFlags = 'r' | 'r+' | 'w' | 'w+' | 'wx' | 'wx+' | 'a' | 'a+' | 'ax' | 'ax+';
+export interface FileOpenOptions {
+    /** Permissions for a created file (default 0o644) */
+    mode?: number;
+    /** Size of the writeBuffered() coalescing buffer (default 64 KiB) */
+    bufferSize?: number;
+}
+export interface AllocateOptions {
+    /** Reserve blocks without changing the file size */
+    keepSize?: boolean;
+    /** Deallocate the range instead */
+    punchHole?: boolean;
+}
+export interface FileLockOptions {
+    /** Shared (read) lock instead of exclusive */
+    shared?: boolean;
+    /** Return false instead of waiting when the range is held (default true) */
+    wait?: boolean;
+}
+export interface ChunkReaderOptions {
+    /** Bytes per chunk (default 1 MiB) */
+    chunkSize?: number;
+    /** Chunk buffers in the ring (default 4) */
+    buffers?: number;
+    /** First byte to read (default 0) */
+    offset?: number;
+    /** Bytes to read from offset (default to end of file) */
+    length?: number;
+    /** Hash each chunk and the whole stream with nxh64 */
+    hash?: boolean;
+    /** Drop read pages from the page cache behind the reader */
+    dropCache?: boolean;
+    /** Decode a zstd or LZ4-frame file; chunks then hold decoded bytes */
+    decompress?: 'zstd' | 'lz4';
+}
+export interface Chunk {
+    /** View over the reader's buffer; valid until released */
+    data: Buffer;
+    /** File offset of data, or its offset in the decoded stream */
+    offset: number;
+    /** Sequence number, counting from 0 */
+    seq: number;
+    /** nxh64 of data as hex, or null without the hash option */
+    hash: string | null;
+}
+export interface ChunkReaderInfo {
+    /** Bytes read from the file so far */
+    bytesRead: number;
+    /** nxh64 over every chunk produced, or null without the hash option */
+    hash: string | null;
+}
+export interface ContentCacheOptions {
+    /** Budget for cached contents, both variants (default 64 MiB) */
+    maxBytes?: number;
+    /** Larger files are read but not kept (default maxBytes / 4) */
+    maxEntry?: number;
+    /** Level for readCompressed (default 3) */
+    zstdLevel?: number;
+    /**
+     * 'stat' checks dev, inode, mtime and size on every hit (default);
+     * 'none' trusts entries until invalidate() is called
+     */
+    validate?: 'stat' | 'none';
+}
+export interface ContentCacheStats {
+    hits: number;
+    misses: number;
+    evictions: number;
+    entries: number;
+    /** Cached contents, both variants */
+    bytes: number;
+}
+export interface PathTableStats {
+    /** Interned paths and directories, including the roots "/" and "." */
+    paths: number;
+    /** Distinct path components */
+    names: number;
+    /** Approximate memory held */
+    bytes: number;
+}
+export interface ChannelOptions {
+    /** Ring bytes, rounded up to a power of two (default 1 MiB) */
+    capacity?: number;
+    /** Permissions for a created file (default 0o600) */
+    mode?: number;
+}
+export interface ChannelInfo {
+    /** Path other processes pass to Channel.open */
+    path: string;
+    capacity: number;
+    /** Largest message (half the ring, less an 8-byte header) */
+    maxMessage: number;
+    /** Bytes sent and not yet consumed */
+    used: number;
+    /** Bytes sent since creation, padding included */
+    written: number;
+    read: number;
+}
+export interface TarPackOptions {
+    /** Compress the stream (default 'none') */
+    compress?: 'zstd' | 'lz4' | 'none';
+    /** Codec level (default: zstd 3, lz4 fast) */
+    level?: number;
+    /** Walk and zstd worker threads (default: CPU count) */
+    threads?: number;
+    includeHidden?: boolean;
+    /** Archive what symlinks point to instead of the links */
+    followSymlinks?: boolean;
+    /** Index members so tarExtract can jump straight to one */
+    seekable?: boolean;
+    /** Seekable: uncompressed bytes per frame (default 1 MiB) */
+    frameSize?: number;
+}
+export interface TarUnpackOptions {
+    /** File writer threads (default: CPU count) */
+    threads?: number;
+    /** Leading path components to drop from every member */
+    strip?: number;
+}
+export interface TarStats {
+    files: number;
+    dirs: number;
+    /** Symlinks and hard links */
+    links: number;
+    /** File content bytes */
+    bytes: number;
+    /** Size of the archive as stored */
+    archiveBytes: number;
+    /** Entries skipped or not restored */
+    errors: number;
+}
+export interface ReadFileOptions {
+    /** Map the file instead of reading it (copy-on-write, never written back) */
+    mmap?: boolean;
+    /** Map automatically when the file is at least this many bytes */
+    mmapThreshold?: number;
+}
+export interface WriteFileOptions {
+    /** Reserve the whole file with fallocate first so it lands in few extents */
+    preallocate?: boolean;
+    /** Leave runs of zero bytes as holes instead of writing them */
+    sparse?: boolean;
+    /** Smallest zero run left as a hole, rounded up to 4 KiB (default 64 KiB) */
+    holeMin?: number;
+}
+export interface AtomicWrite {
+    path: string;
+    data: Buffer | string;
+}
+export interface AtomicBatchOptions {
+    /** One syncfs per filesystem instead of fdatasync per file (flushes unrelated dirty data too) */
+    syncfs?: boolean;
+    /** Stage data in unnamed O_TMPFILE inodes, so a crash leaves no temp files */
+    tmpfile?: boolean;
+}
+export interface AtomicBatchResult {
+    files: number;
+    /** fdatasync or syncfs calls */
+    flushes: number;
+    /** Directories fsync'ed */
+    dirSyncs: number;
+}
+export interface WalOptions {
+    /** Bytes preallocated per segment (default 64 MiB) */
+    segmentSize?: number;
+    /** Group-commit appends every N ms in the background */
+    syncInterval?: number;
+    /** Group-commit as soon as N bytes are pending */
+    syncBytes?: number;
+}
+export interface WalStats {
+    /** Sequence number the next append gets */
+    nextSeq: number;
+    /** Last record handed to the kernel */
+    writtenSeq: number;
+    /** Last record known to be on disk */
+    durableSeq: number;
+    segments: number;
+    /** fdatasync calls */
+    syncs: number;
+}
+export interface WalReplayResult {
+    /** Records passed to the callback */
+    count: number;
+    /** Last sequence number in the log (0 when empty) */
+    lastSeq: number;
+}
+export interface KeyValueOptions {
+    /** Bytes preallocated per data file before rolling to a new one (default 64 MiB) */
+    maxFileSize?: number;
+    /** Merge once this share of the stored bytes is dead (default 50, over 100 never) */
+    mergeDeadPercent?: number;
+    /** ...and at least this many bytes are dead (default 16 MiB) */
+    mergeMinBytes?: number;
+    /** fdatasync every put and delete */
+    sync?: boolean;
+    /** Merge in the background when the thresholds are crossed (default true) */
+    autoMerge?: boolean;
+}
+export interface KeyValueStats {
+    keys: number;
+    files: number;
+    /** Bytes in all data files, live or not */
+    totalBytes: number;
+    /** Bytes of records still referenced by the key directory */
+    liveBytes: number;
+    /** Completed merges since open */
+    merges: number;
+    merging: boolean;
+}
+export interface TreeProgress {
+    files: number;
+    dirs: number;
+    bytes: number;
+    errors: number;
+}
+export interface TreeError {
+    path: string;
+    code: number;
+    message: string;
+}
+export interface TreeResult extends Omit<TreeProgress, 'errors'> {
+    errors: TreeError[];
+    cancelled: boolean;
+}
+export interface TreeOptions {
+    /** Worker threads (default: online CPUs) */
+    threads?: number;
+    /** Called periodically; return false to cancel */
+    onProgress?: (progress: TreeProgress) => boolean | void;
+    /** Progress interval in ms (default: 100) */
+    progressInterval?: number;
+}
+export interface CopyTreeOptions extends TreeOptions {
+    overwrite?: boolean;
+    preserveMode?: boolean;
+    preserveTimes?: boolean;
+    followSymlinks?: boolean;
+}
+export interface WalkOptions {
+    /** Worker threads (default: online CPUs) */
+    threads?: number;
+    /** Deepest level emitted, 1 = direct children (default: unlimited) */
+    maxDepth?: number;
+    /** statx each emitted entry (default: false, d_type only) */
+    stat?: boolean;
+    followSymlinks?: boolean;
+    /** Include dot-entries (default: true) */
+    includeHidden?: boolean;
+    /** Emit files / directories (both default: true) */
+    files?: boolean;
+    directories?: boolean;
+    /** Only emit files ending in one of these suffixes */
+    extensions?: string[];
+    /** Directory names that are never entered */
+    prune?: string[];
+    /** Entries per batch delivered to JS (default: 256) */
+    batchSize?: number;
+}
+export interface WalkEntry {
+    path: string;
+    name: string;
+    depth: number;
+    type: FileType;
+    isFile: boolean;
+    isDirectory: boolean;
+    isSymlink: boolean;
+    /** Present with `stat: true` (times in seconds) */
+    size?: number;
+    mode?: number;
+    uid?: number;
+    gid?: number;
+    ino?: number;
+    nlink?: number;
+    atime?: number;
+    mtime?: number;
+    ctime?: number;
+}
+export interface SearchOptions {
+    /** Worker threads (default: online CPUs) */
+    threads?: number;
+    maxDepth?: number;
+    followSymlinks?: boolean;
+    /** Include dot-entries (default: true) */
+    includeHidden?: boolean;
+    /** Directory names that are never entered */
+    prune?: string[];
+    /** Only search files matching these globs, relative to root */
+    include?: string[];
+    /** Let include globs match dot-names (default: false) */
+    dot?: boolean;
+    /** Extra ignore rules in .gitignore syntax */
+    ignore?: string[];
+    /** Ignore files read in every directory, e.g. ['.gitignore'] */
+    ignoreFiles?: string[];
+    /** ASCII case-insensitive matching (default: false) */
+    ignoreCase?: boolean;
+    /** Search files with a NUL in their first 8 KB (default: false) */
+    binary?: boolean;
+    /** Stop after this many matching lines */
+    limit?: number;
+    /** Skip files larger than this many bytes */
+    maxFileSize?: number;
+    /** Truncate reported line text to this many bytes */
+    maxLineLength?: number;
+    /** Map files at least this big instead of reading them (default: 256 KB) */
+    mmapThreshold?: number;
+    /** Matches per batch delivered to JS (default: 256) */
+    batchSize?: number;
+}
+export interface SearchMatch {
+    path: string;
+    /** 1-based line number */
+    line: number;
+    /** 1-based byte column of the first match on the line */
+    column: number;
+    /** Line text without the line terminator */
+    text: string;
+    /** Index of the pattern that matched */
+    pattern: number;
+}
+export interface SearchResult extends TreeResult {
+    /** Regular files opened */
+    searched: number;
+    matchedFiles: number;
+    /** Files skipped as binary */
+    binary: number;
+    unreadable: number;
+    bytesSearched: number;
+    /** Matching lines */
+    matches: number;
+    limitReached: boolean;
+}
+export interface DuplicateOptions {
+    /** Worker threads (default: online CPUs) */
+    threads?: number;
+    maxDepth?: number;
+    followSymlinks?: boolean;
+    /** Include dot-entries (default: true) */
+    includeHidden?: boolean;
+    /** Directory names that are never entered */
+    prune?: string[];
+    /** Only consider files matching these globs, relative to root */
+    include?: string[];
+    /** Let include globs match dot-names (default: false) */
+    dot?: boolean;
+    /** Extra ignore rules in .gitignore syntax */
+    ignore?: string[];
+    /** Ignore files read in every directory, e.g. ['.gitignore'] */
+    ignoreFiles?: string[];
+    /** Ignore files smaller than this (default: 1, empty files never count) */
+    minSize?: number;
+    /** Ignore files larger than this */
+    maxSize?: number;
+    /** Bytes hashed at each end in the first pass (default: 4096) */
+    partialBytes?: number;
+    /** Report paths sharing an inode as one file (default: false) */
+    skipHardlinks?: boolean;
+}
+export interface DuplicateGroup {
+    size: number;
+    /** Content hash as 16 hex digits */
+    hash: string;
+    paths: string[];
+}
+export interface DuplicateResult extends TreeResult {
+    /** Largest files first */
+    groups: DuplicateGroup[];
+    scanned: number;
+    /** Files sharing a size with another file */
+    candidates: number;
+    partialHashed: number;
+    fullHashed: number;
+    bytesHashed: number;
+    hardlinksSkipped: number;
+    /** Files that could not be read while hashing */
+    failed: number;
+    /** Bytes that removing every duplicate would free */
+    wastedBytes: number;
+}
+export interface DiskUsageOptions {
+    /** Deepest directory with its own row; -1 for every directory (default 1) */
+    maxDepth?: number;
+    /** Worker threads (default: online CPUs) */
+    threads?: number;
+    /** Include dot-entries (default: true) */
+    includeHidden?: boolean;
+    /** Don't descend into other filesystems (default: false) */
+    oneFileSystem?: boolean;
+    /** Count every hard link instead of each inode once (default: false) */
+    countLinks?: boolean;
+    /** Directory names that are never entered */
+    prune?: string[];
+}
+/**
+ * One row per directory, sorted by path; row 0 is the root. Each
+ * row's totals cover its whole subtree.
+ */
+export interface DiskUsage {
+    count: number;
+    /** Paths relative to the root, packed; row i is names[nameOffsets[i], nameOffsets[i + 1]) */
+    names: Buffer;
+    nameOffsets: Uint32Array;
+    /** Sum of file sizes */
+    apparent: Float64Array;
+    /** Bytes allocated on disk (st_blocks * 512) */
+    allocated: Float64Array;
+    files: Float64Array;
+    /** Directories below, excluding the row itself */
+    dirs: Float64Array;
+    /** Row index of the parent directory, -1 for the root */
+    parent: Int32Array;
+    depth: Uint32Array;
+    /** Hard links skipped as already counted */
+    hardlinks: number;
+    errors: TreeError[];
+}
+export interface SnapshotOptions {
+    /** Worker threads for scans (default: online CPUs) */
+    threads?: number;
+    /** Keep a content hash of every file; only content changes are reported (default: false) */
+    hash?: boolean;
+    /** Include dot-entries (default: true) */
+    includeHidden?: boolean;
+    /** Directory names that are never entered */
+    prune?: string[];
+}
+export interface SnapshotEntry {
+    /** Relative to the snapshot root */
+    path: string;
+    type: FileType;
+    mode: number;
+    inode: number;
+    size: number;
+    mtimeMs: number;
+    ctimeMs: number;
+    mtimeNs: bigint;
+    ctimeNs: bigint;
+    /** Content hash as 16 hex digits, or null without the hash option */
+    hash: string | null;
+}
+export interface SnapshotChange {
+    change: 'added' | 'removed' | 'modified';
+    /** Relative to the snapshot root */
+    path: string;
+    type: FileType;
+}
+export interface SnapshotDiff {
+    /** Sorted by path */
+    changes: SnapshotChange[];
+    /** Paths re-stat'ed */
+    checked: number;
+    /** Directories read */
+    dirsScanned: number;
+}
+export interface GlobMatchOptions {
+    /** Let wildcards and ** match names starting with '.' (default: false) */
+    dot?: boolean;
+    /** Case-insensitive matching (default: false) */
+    nocase?: boolean;
+}
+export interface GlobOptions extends WalkOptions, GlobMatchOptions {
+    /** Extra ignore rules in .gitignore syntax, relative to root */
+    ignore?: string[];
+    /** Ignore files read in every directory, e.g. ['.gitignore'] */
+    ignoreFiles?: string[];
+}
 /**
- * Read entire file into buffer
+ * Read entire file into buffer (no intermediate copy)
  */
-export declare function readFile(path: string): Buffer;
+export declare function readFile(path: string, options?: ReadFileOptions): Buffer;
 /**
  * Read file as UTF-8 text
  */
@@ -81,11 +631,17 @@ export declare function readText(path: string): string;
 /**
  * Write buffer to file
  */
-export declare function writeFile(path: string, data: Buffer | string): void;
+export declare function writeFile(path: string, data: Buffer | string, options?: WriteFileOptions): void;
 /**
  * Append to file
  */
 export declare function appendFile(path: string, data: Buffer | string): void;
+/**
+ * Atomically replace many files under one group commit: every file is
+ * staged, all data is flushed together, then everything is renamed
+ * into place and each directory is fsync'ed once.
+ */
+export declare function writeFilesAtomic(files: AtomicWrite[], options?: AtomicBatchOptions): Promise<AtomicBatchResult>;
 /**
  * Copy file
  */
@@ -102,6 +658,50 @@ export declare function remove(path: string): void;
  * Remove directory and contents recursively
  */
 export declare function removeRecursive(path: string): void;
+/**
+ * Remove a directory tree using a pool of worker threads.
+ * Per-entry failures are collected in `errors` instead of aborting.
+ */
+export declare function removeTree(path: string, options?: TreeOptions): TreeResult;
+/**
+ * Copy a directory tree in parallel
+ */
+export declare function copyTree(src: string, dst: string, options?: CopyTreeOptions): TreeResult;
+/**
+ * Move a tree (rename, or parallel copy + remove across filesystems)
+ */
+export declare function moveTree(src: string, dst: string, options?: CopyTreeOptions): TreeResult;
+/**
+ * Walk a tree in parallel, delivering entries in batches as they are found.
+ * Return false from onBatch to stop early. Entry order is not defined.
+ */
+export declare function walkBatches(root: string, onBatch: (entries: WalkEntry[]) => boolean | void, options?: WalkOptions): Promise<TreeResult>;
+/**
+ * Walk a tree in parallel and collect every entry
+ */
+export declare function walk(root: string, options?: WalkOptions): Promise<WalkEntry[]>;
+/**
+ * Search file contents for literal patterns, delivering matching lines
+ * in batches. Every file is a task on the walker's thread pool; return
+ * false from onBatch to stop early.
+ */
+export declare function searchBatches(root: string, patterns: string | string[], onBatch: (matches: SearchMatch[]) => boolean | void, options?: SearchOptions): Promise<SearchResult>;
+/**
+ * Search file contents for literal patterns and collect matching lines
+ */
+export declare function searchFiles(root: string, patterns: string | string[], options?: SearchOptions): Promise<SearchMatch[]>;
+/**
+ * Find files with identical content. Files are bucketed by size, then
+ * by a hash of their first and last few KB, and only the survivors are
+ * hashed in full on the thread pool.
+ */
+export declare function findDuplicates(root: string, options?: DuplicateOptions): Promise<DuplicateResult>;
+/**
+ * Measure a tree on the parallel walker, summing apparent size and
+ * allocated blocks per directory down to maxDepth. Hard-linked files
+ * count once, in the directory where they are seen first.
+ */
+export declare function duTree(root: string, options?: DiskUsageOptions): Promise<DiskUsage>;
 /**
  * Get file/directory stats
  */
@@ -110,6 +710,10 @@ export declare function stat(path: string): StatResult;
  * Get stats without following symlinks
  */
 export declare function lstat(path: string): StatResult;
+/**
+ * statx many paths in one native call
+ */
+export declare function statMany(paths: string[], options?: StatManyOptions): StatColumns;
 /**
  * Check if path exists
  */
@@ -148,6 +752,11 @@ export declare function readdir(path: string): string[];
  * Read directory with file type info
  */
 export declare function readdirWithTypes(path: string): DirEntry[];
+/**
+ * List a directory and lstat every entry in one native call. Builds a
+ * handful of objects however large the directory is.
+ */
+export declare function readdirPlus(path: string): DirColumns;
 /**
  * Get basename of path
  */
@@ -176,6 +785,32 @@ export declare function resolve(path: string): string;
  * Check if path is absolute
  */
 export declare function isAbsolute(path: string): boolean;
+/**
+ * Relative path from one path to another, worked out lexically
+ * against the current directory
+ */
+export declare function relative(from: string, to: string): string;
+/**
+ * join(base, path) for every path
+ */
+export declare function joinMany(base: string, paths: string[]): string[];
+export declare function joinMany(base: string, paths: Buffer): Buffer;
+/**
+ * normalize() every path
+ */
+export declare function normalizeMany(paths: string[]): string[];
+export declare function normalizeMany(paths: Buffer): Buffer;
+/**
+ * relative(from, path) for every path
+ */
+export declare function relativeMany(from: string, paths: string[]): string[];
+export declare function relativeMany(from: string, paths: Buffer): Buffer;
+/**
+ * resolve() every path, joined to base first when given. Paths that
+ * can't be resolved come back as empty strings instead of throwing.
+ */
+export declare function resolveMany(paths: string[], base?: string): string[];
+export declare function resolveMany(paths: Buffer, base?: string): Buffer;
 /**
  * Create symbolic link
  */
@@ -212,6 +847,260 @@ export declare function chown(path: string, uid: number, gid: number): void;
  * Find files matching glob pattern
  */
 export declare function glob(pattern: string): string[];
+/**
+ * Glob a tree with the parallel walker, delivering matches in batches.
+ * Supports {a,b}, ** and '!' exclusions; directories no pattern can
+ * reach and ignored directories are never read. Directories are only
+ * emitted with `directories: true`.
+ */
+export declare function globBatches(root: string, patterns: string | string[], onBatch: (entries: WalkEntry[]) => boolean | void, options?: GlobOptions): Promise<TreeResult>;
+/**
+ * Glob a tree with the parallel walker and collect matching paths
+ */
+export declare function globTree(root: string, patterns: string | string[], options?: GlobOptions): Promise<string[]>;
+/**
+ * Test relative paths against glob patterns (a trailing '/' marks a directory)
+ */
+export declare function globMatch(paths: string[], patterns: string | string[], options?: GlobMatchOptions): boolean[];
+/**
+ * An open file. Every method is one syscall on the kept descriptor.
+ * A position of null means the current file position, as with read(2)
+ * and write(2); a number reads or writes there without moving it.
+ */
+export declare class FileHandle {
+    private handle;
+    private bufferSize;
+    private buffered;
+    private constructor();
+    static open(path: string, flags?: FileOpenFlags, options?: FileOpenOptions): FileHandle;
+    /**
+     * Read into buffer[offset, offset + length)
+     * @returns Bytes read, 0 at end of file
+     */
+    read(buffer: Buffer, offset?: number, length?: number, position?: number | null): number;
+    /**
+     * Write data, returning the bytes written
+     */
+    write(data: Buffer | string, position?: number | null): number;
+    /**
+     * Fill several buffers in order with one readv
+     */
+    readv(buffers: Buffer[], position?: number | null): number;
+    /**
+     * Write several buffers in order with one writev
+     */
+    writev(buffers: Buffer[], position?: number | null): number;
+    /**
+     * Append at the file position through a native buffer, so many small
+     * writes cost one syscall. Buffered data is written out by flush(),
+     * close(), or before any other operation on the handle.
+     */
+    writeBuffered(data: Buffer | string): void;
+    flush(): void;
+    /**
+     * Move the file position
+     * @returns The new position
+     */
+    seek(offset: number, whence?: 'set' | 'cur' | 'end'): number;
+    stat(): StatResult;
+    truncate(size?: number): void;
+    /** fsync */
+    sync(): void;
+    /** fdatasync */
+    datasync(): void;
+    /**
+     * Access-pattern hint for a range (length 0 = to end of file)
+     */
+    advise(advice: FileAdvice, offset?: number, length?: number): void;
+    /**
+     * Reserve blocks so later writes can't fail with ENOSPC, or punch them out
+     */
+    allocate(offset: number, length: number, options?: AllocateOptions): void;
+    /**
+     * Take a POSIX record lock (length 0 = to end of file)
+     * @returns false if wait is off and another process holds the range
+     */
+    lock(offset?: number, length?: number, options?: FileLockOptions): boolean;
+    unlock(offset?: number, length?: number): void;
+    /**
+     * Flush and close the descriptor
+     */
+    close(): void;
+    private open;
+}
+/**
+ * Reads a large file on a background thread into a small ring of
+ * aligned buffers, one buffer ahead of the consumer. Chunks are views
+ * over those buffers: release each one once done with it so the
+ * reader can refill it. Iterating with for await releases for you.
+ */
+export declare class ChunkReader {
+    private handle;
+    private constructor();
+    static open(path: string, options?: ChunkReaderOptions): ChunkReader;
+    /**
+     * Resolve with the next chunk in order, or null at end of stream
+     */
+    next(): Promise<Chunk | null>;
+    /**
+     * Block until the next chunk is ready
+     */
+    nextSync(): Chunk | null;
+    /**
+     * Hand a chunk's buffer back to the reader. Its data must not be
+     * used afterwards.
+     */
+    release(chunk: Chunk): void;
+    info(): ChunkReaderInfo;
+    /**
+     * Stop the reader thread. Buffers of unreleased chunks stay valid
+     * until they are garbage collected.
+     */
+    close(): void;
+    [Symbol.asyncIterator](): AsyncGenerator<Chunk>;
+    private open;
+}
+/**
+ * Read-through cache of whole-file contents with a byte budget and
+ * CLOCK eviction. A hit costs one stat and returns the same Buffer as
+ * the previous read of that file, without copying; treat the Buffers
+ * as read-only since they are shared.
+ */
+export declare class ContentCache {
+    private handle;
+    constructor(options?: ContentCacheOptions);
+    /**
+     * Contents of path, read and cached on a miss
+     */
+    read(path: string): Buffer;
+    /**
+     * zstd frame of path's contents, compressed once and cached alongside
+     * them (for serving with Content-Encoding: zstd)
+     */
+    readCompressed(path: string): Buffer;
+    /**
+     * Drop path, and with recursive everything below it. Returns the
+     * number of entries dropped.
+     */
+    invalidate(path: string, recursive?: boolean): number;
+    clear(): void;
+    stats(): ContentCacheStats;
+    /**
+     * Drop every entry; Buffers already handed out stay valid
+     */
+    close(): void;
+}
+/**
+ * Interns normalized paths as small integer ids. Paths are stored as a
+ * tree of (directory, name) nodes, so a directory shared by many paths
+ * is kept once and comparing two paths is comparing two numbers.
+ */
+export declare class PathTable {
+    private handle;
+    constructor();
+    /**
+     * Id of path, added if new. "a/./b" and "a/b" share an id.
+     */
+    intern(path: string): number;
+    internMany(paths: string[] | Buffer): Uint32Array;
+    path(id: number): string;
+    paths(ids: Uint32Array | number[]): string[];
+    /**
+     * Id of the directory holding id
+     */
+    dirname(id: number): number;
+    basename(id: number): string;
+    stats(): PathTableStats;
+    close(): void;
+}
+/**
+ * Message channel between processes over a shared mapping: any number
+ * of processes send, one receives. Messages are written and read in
+ * place, so received messages and reserved slots are Buffers viewing
+ * the mapping rather than copies. A blocked side sleeps on a futex and
+ * is woken directly by the other, without going through the event loop.
+ */
+export declare class Channel {
+    private buffer;
+    readonly path: string;
+    private constructor();
+    /**
+     * Create a channel in a file at path (reset if it exists), or in an
+     * anonymous memfd reachable through the returned channel's path
+     */
+    static create(path?: string | null, options?: ChannelOptions): Channel;
+    /** Attach to a channel created by another process */
+    static open(path: string): Channel;
+    /**
+     * Copy data in as one message. Returns false if the ring stayed full
+     * for timeoutMs (0 = don't wait, -1 = wait as long as it takes).
+     */
+    send(data: Buffer | string, timeoutMs?: number): boolean;
+    /**
+     * Claim a slot of length bytes to fill in place, then pass it to
+     * commit(). Returns null if the ring stayed full for timeoutMs.
+     */
+    reserve(length: number, timeoutMs?: number): Buffer | null;
+    /** Publish a slot from reserve() */
+    commit(slot: Buffer): void;
+    /**
+     * Take the next message, or null if none arrived within timeoutMs
+     * (which blocks the thread; prefer wait() on the main thread). The
+     * Buffer is only valid until the next receive() or release().
+     */
+    receive(timeoutMs?: number): Buffer | null;
+    /** Give the last received message's space back to senders */
+    release(): void;
+    /**
+     * Resolve true once receive() has a message, or false on timeout or
+     * close. Waits off the main thread.
+     */
+    wait(timeoutMs?: number): Promise<boolean>;
+    info(): ChannelInfo;
+    /** Unmap; message Buffers still held become empty */
+    close(): void;
+    [Symbol.asyncIterator](): AsyncGenerator<Buffer>;
+}
+/**
+ * Pack a tree into a tar archive, optionally zstd or LZ4 compressed.
+ * Everything runs natively: the tree is walked in parallel and file
+ * data streams through the encoder without passing through JS.
+ */
+export declare function tarPack(root: string, archive: string, options?: TarPackOptions): Promise<TarStats>;
+/**
+ * Unpack a tar, tar.zst or tar.lz4 archive (detected from its first
+ * bytes) into dest, writing files in parallel. Modes and mtimes are
+ * restored; members whose path contains ".." are skipped.
+ */
+export declare function tarUnpack(archive: string, dest: string, options?: TarUnpackOptions): Promise<TarStats>;
+/**
+ * Extract a single member to outPath. Archives packed with seekable
+ * are read from the member's own frame; others are scanned.
+ */
+export declare function tarExtract(archive: string, member: string, outPath: string): Promise<void>;
+/**
+ * A memory-mapped file region. `buffer` is an ArrayBuffer directly over
+ * the mapping; it is detached (length 0) once unmap() is called.
+ */
+export declare class MappedFile {
+    readonly buffer: ArrayBuffer;
+    constructor(path: string, options?: MmapOptions);
+    /** Byte view over the mapping (no copy) */
+    bytes(): Buffer;
+    /** Flush written pages to the file (msync) */
+    sync(): void;
+    /** Access-pattern hint for a range (default: whole mapping) */
+    advise(advice: MmapAdvice, offset?: number, length?: number): void;
+    /** Pin pages in RAM (mlock) */
+    lock(): void;
+    unlock(): void;
+    /** Unmap now instead of waiting for garbage collection */
+    unmap(): void;
+}
+/**
+ * Memory-map a file
+ */
+export declare function mmap(path: string, options?: MmapOptions): MappedFile;
 /**
  * File system watcher using inotify
  */
@@ -221,8 +1110,9 @@ export declare class Watcher {
     constructor();
     /**
      * Add path to watch
+     * @param recursive Also watch subdirectories, including ones created later
      */
-    add(path: string): number;
+    add(path: string, recursive?: boolean): number;
     /**
      * Remove watch
      */
@@ -245,6 +1135,164 @@ export declare class Watcher {
  * Create file watcher
  */
 export declare function watch(path?: string): Watcher;
+/**
+ * Event-driven watcher. Events are read on a native thread, coalesced
+ * (bursts of writes fold into one change, moves pair into renames) and
+ * delivered in batches. Instances are independent of each other.
+ */
+export declare class EventWatcher {
+    private handle;
+    private watches;
+    constructor(onChanges: (changes: WatchChange[]) => void, options?: EventWatcherOptions);
+    /**
+     * Add path to watch
+     */
+    add(path: string, options?: WatchAddOptions): number;
+    /**
+     * Remove watch
+     */
+    remove(wd: number): void;
+    /**
+     * Get path for watch descriptor
+     */
+    getPath(wd: number): string | undefined;
+    /**
+     * Stop the event thread; undelivered changes are dropped
+     */
+    close(): void;
+}
+/**
+ * Watch one or more paths, receiving coalesced batches of changes
+ */
+export declare function watchEvents(paths: string | string[], onChanges: (changes: WatchChange[]) => void, options?: EventWatcherOptions & WatchAddOptions): EventWatcher;
+/**
+ * Persistent index of a directory tree. update() re-stats every entry
+ * but only reads directories whose mtime changed; apply() folds
+ * EventWatcher changes in without touching anything else.
+ */
+export declare class Snapshot {
+    private handle;
+    private constructor();
+    /**
+     * Index every path under root
+     */
+    static create(root: string, options?: SnapshotOptions): Promise<Snapshot>;
+    /**
+     * Map a snapshot written by save()
+     */
+    static load(file: string): Snapshot;
+    get root(): string;
+    /** Number of indexed paths */
+    get size(): number;
+    /**
+     * Rescan changed directories and report what changed
+     */
+    update(threads?: number): Promise<SnapshotDiff>;
+    /**
+     * Apply watcher changes (absolute paths under root). An overflow
+     * event falls back to a full update.
+     */
+    apply(changes: WatchEvent[]): SnapshotDiff;
+    /**
+     * Look up one path relative to root
+     */
+    get(path: string): SnapshotEntry | null;
+    /**
+     * Every entry, in path order
+     */
+    entries(): SnapshotEntry[];
+    /**
+     * Write to a file atomically
+     */
+    save(file: string): void;
+    /**
+     * Release the index now instead of waiting for garbage collection
+     */
+    close(): void;
+    private open;
+}
+/**
+ * Append-only record log in a directory of preallocated segments.
+ * append() only copies into memory; records become durable through
+ * the syncInterval/syncBytes policy or an explicit sync().
+ */
+export declare class WriteAheadLog {
+    private handle;
+    private constructor();
+    /**
+     * Open or create the log in dir. A torn tail from a crash is cut
+     * off, so appends continue after the last complete record.
+     */
+    static open(dir: string, options?: WalOptions): WriteAheadLog;
+    /**
+     * Visit every record with seq >= fromSeq, in order. Return false
+     * from the callback to stop early.
+     */
+    static replay(dir: string, onRecord: (seq: number, data: Buffer) => boolean | void, fromSeq?: number): WalReplayResult;
+    /**
+     * Append one record and return its sequence number
+     */
+    append(data: Buffer | string): number;
+    /**
+     * Hand buffered records to the kernel without waiting for the disk
+     */
+    flush(): void;
+    /**
+     * Block until every appended record is on disk
+     */
+    sync(): void;
+    /**
+     * Delete segments holding only records before beforeSeq
+     */
+    truncate(beforeSeq: number): void;
+    stats(): WalStats;
+    /**
+     * Sync and release the log
+     */
+    close(): void;
+    private open;
+}
+/**
+ * Log-structured key-value store in a directory. Every key lives in
+ * an in-memory directory pointing at its newest record, so get() is a
+ * single read; overwritten and deleted records are reclaimed by merge.
+ */
+export declare class KeyValueStore {
+    private handle;
+    private constructor();
+    /**
+     * Open or create the store in dir. Only one store may have a
+     * directory open at a time.
+     */
+    static open(dir: string, options?: KeyValueOptions): KeyValueStore;
+    /**
+     * Value stored under key, or null
+     */
+    get(key: Buffer | string): Buffer | null;
+    put(key: Buffer | string, value: Buffer | string): void;
+    /**
+     * Remove key; false if it was not stored
+     */
+    delete(key: Buffer | string): boolean;
+    has(key: Buffer | string): boolean;
+    keys(): string[];
+    keys(asBuffers: true): Buffer[];
+    /**
+     * Block until every put and delete is on disk
+     */
+    sync(): void;
+    /**
+     * Rewrite the sealed data files keeping only live records. Reads
+     * and writes continue while it runs.
+     */
+    merge(): Promise<void>;
+    stats(): KeyValueStats;
+    /**
+     * Sync and release the store
+     */
+    close(): void;
+    private open;
+}
 /**
  * Get version
  */
@@ -254,12 +1302,23 @@ declare const _default: {
     readText: typeof readText;
     writeFile: typeof writeFile;
     appendFile: typeof appendFile;
+    writeFilesAtomic: typeof writeFilesAtomic;
     copyFile: typeof copyFile;
     moveFile: typeof moveFile;
     remove: typeof remove;
     removeRecursive: typeof removeRecursive;
+    removeTree: typeof removeTree;
+    copyTree: typeof copyTree;
+    moveTree: typeof moveTree;
+    walk: typeof walk;
+    walkBatches: typeof walkBatches;
+    searchFiles: typeof searchFiles;
+    searchBatches: typeof searchBatches;
+    findDuplicates: typeof findDuplicates;
+    duTree: typeof duTree;
     stat: typeof stat;
     lstat: typeof lstat;
+    statMany: typeof statMany;
     exists: typeof exists;
     isFile: typeof isFile;
     isDirectory: typeof isDirectory;
@@ -269,6 +1328,7 @@ declare const _default: {
     mkdirp: typeof mkdirp;
     readdir: typeof readdir;
     readdirWithTypes: typeof readdirWithTypes;
+    readdirPlus: typeof readdirPlus;
     basename: typeof basename;
     dirname: typeof dirname;
     extname: typeof extname;
@@ -276,6 +1336,11 @@ declare const _default: {
     normalize: typeof normalize;
     resolve: typeof resolve;
     isAbsolute: typeof isAbsolute;
+    relative: typeof relative;
+    joinMany: typeof joinMany;
+    normalizeMany: typeof normalizeMany;
+    relativeMany: typeof relativeMany;
+    resolveMany: typeof resolveMany;
     symlink: typeof symlink;
     readlink: typeof readlink;
     tmpdir: typeof tmpdir;
@@ -285,8 +1350,29 @@ declare const _default: {
     chmod: typeof chmod;
     chown: typeof chown;
     glob: typeof glob;
+    globBatches: typeof globBatches;
+    globTree: typeof globTree;
+    globMatch: typeof globMatch;
+    mmap: typeof mmap;
+    FileHandle: typeof FileHandle;
+    ChunkReader: typeof ChunkReader;
+    ContentCache: typeof ContentCache;
+    PathTable: typeof PathTable;
+    Channel: typeof Channel;
+    tarPack: typeof tarPack;
+    tarUnpack: typeof tarUnpack;
+    tarExtract: typeof tarExtract;
+    MappedFile: typeof MappedFile;
+    MmapAdvice: typeof MmapAdvice;
+    FileAdvice: typeof FileAdvice;
     Watcher: typeof Watcher;
     watch: typeof watch;
+    EventWatcher: typeof EventWatcher;
+    watchEvents: typeof watchEvents;
+    WatchEventType: typeof WatchEventType;
+    Snapshot: typeof Snapshot;
+    WriteAheadLog: typeof WriteAheadLog;
+    KeyValueStore: typeof KeyValueStore;
     version: typeof version;
     FileType: typeof FileType;
 };
@@ -49,14 +49,45 @@ export var FileType;
     FileType[FileType["CharDevice"] = 6] = "CharDevice";
     FileType[FileType["BlockDevice"] = 7] = "BlockDevice";
 })(FileType || (FileType = {}));
+export var WatchEventType;
+(function (WatchEventType) {
+    WatchEventType[WatchEventType["Create"] = 1] = "Create";
+    WatchEventType[WatchEventType["Delete"] = 2] = "Delete";
+    WatchEventType[WatchEventType["Modify"] = 4] = "Modify";
+    WatchEventType[WatchEventType["Rename"] = 8] = "Rename";
+    WatchEventType[WatchEventType["Attrib"] = 16] = "Attrib";
+    WatchEventType[WatchEventType["Open"] = 32] = "Open";
+    WatchEventType[WatchEventType["Close"] = 64] = "Close";
+    WatchEventType[WatchEventType["MoveFrom"] = 128] = "MoveFrom";
+    WatchEventType[WatchEventType["MoveTo"] = 256] = "MoveTo";
+    WatchEventType[WatchEventType["Overflow"] = 512] = "Overflow";
+    WatchEventType[WatchEventType["Error"] = 1024] = "Error";
+})(WatchEventType || (WatchEventType = {}));
+export var MmapAdvice;
+(function (MmapAdvice) {
+    MmapAdvice[MmapAdvice["Normal"] = 0] = "Normal";
+    MmapAdvice[MmapAdvice["Sequential"] = 1] = "Sequential";
+    MmapAdvice[MmapAdvice["Random"] = 2] = "Random";
+    MmapAdvice[MmapAdvice["WillNeed"] = 3] = "WillNeed";
+    MmapAdvice[MmapAdvice["DontNeed"] = 4] = "DontNeed";
+})(MmapAdvice || (MmapAdvice = {}));
+export var FileAdvice;
+(function (FileAdvice) {
+    FileAdvice[FileAdvice["Normal"] = 0] = "Normal";
+    FileAdvice[FileAdvice["Sequential"] = 1] = "Sequential";
+    FileAdvice[FileAdvice["Random"] = 2] = "Random";
+    FileAdvice[FileAdvice["WillNeed"] = 3] = "WillNeed";
+    FileAdvice[FileAdvice["DontNeed"] = 4] = "DontNeed";
+    FileAdvice[FileAdvice["NoReuse"] = 5] = "NoReuse";
+})(FileAdvice || (FileAdvice = {}));
 /* ============================================================
  * File Operations
  * ============================================================ */
 /**
- * Read entire file into buffer
+ * Read entire file into buffer (no intermediate copy)
  */
-export function readFile(path) {
-    return native.readFile(path);
+export function readFile(path, options) {
+    return native.readFile(path, options);
 }
 /**
  * Read file as UTF-8 text
@@ -67,9 +98,9 @@ export function readText(path) {
 /**
  * Write buffer to file
  */
-export function writeFile(path, data) {
+export function writeFile(path, data, options) {
     const buf = typeof data === 'string' ? Buffer.from(data, 'utf-8') : data;
-    native.writeFile(path, buf);
+    native.writeFile(path, buf, options);
 }
 /**
  * Append to file
@@ -78,6 +109,14 @@ export function appendFile(path, data) {
     const buf = typeof data === 'string' ? Buffer.from(data, 'utf-8') : data;
     native.appendFile(path, buf);
 }
+/**
+ * Atomically replace many files under one group commit: every file is
+ * staged, all data is flushed together, then everything is renamed
+ * into place and each directory is fsync'ed once.
+ */
+export function writeFilesAtomic(files, options = {}) {
+    return native.writeFilesAtomic(files, options);
+}
 /**
  * Copy file
  */
@@ -102,6 +141,94 @@ export function remove(path) {
 export function removeRecursive(path) {
     native.removeRecursive(path);
 }
+/* ============================================================
+ * Parallel Tree Operations
+ * ============================================================ */
+/**
+ * Remove a directory tree using a pool of worker threads.
+ * Per-entry failures are collected in `errors` instead of aborting.
+ */
+export function removeTree(path, options = {}) {
+    return native.removeTree(path, options);
+}
+/**
+ * Copy a directory tree in parallel
+ */
+export function copyTree(src, dst, options = {}) {
+    return native.copyTree(src, dst, options);
+}
+/**
+ * Move a tree (rename, or parallel copy + remove across filesystems)
+ */
+export function moveTree(src, dst, options = {}) {
+    return native.moveTree(src, dst, options);
+}
+/* ============================================================
+ * Parallel Walker
+ * ============================================================ */
+/**
+ * Walk a tree in parallel, delivering entries in batches as they are found.
+ * Return false from onBatch to stop early. Entry order is not defined.
+ */
+export function walkBatches(root, onBatch, options = {}) {
+    return native.walk(root, options, onBatch);
+}
+/**
+ * Walk a tree in parallel and collect every entry
+ */
+export async function walk(root, options = {}) {
+    const entries = [];
+    await native.walk(root, options, (batch) => {
+        for (const entry of batch)
+            entries.push(entry);
+    });
+    return entries;
+}
+/* ============================================================
+ * Content Search
+ * ============================================================ */
+/**
+ * Search file contents for literal patterns, delivering matching lines
+ * in batches. Every file is a task on the walker's thread pool; return
+ * false from onBatch to stop early.
+ */
+export function searchBatches(root, patterns, onBatch, options = {}) {
+    const list = Array.isArray(patterns) ? patterns : [patterns];
+    return native.search(root, list, options, onBatch);
+}
+/**
+ * Search file contents for literal patterns and collect matching lines
+ */
+export async function searchFiles(root, patterns, options = {}) {
+    const matches = [];
+    await searchBatches(root, patterns, (batch) => {
+        for (const m of batch)
+            matches.push(m);
+    }, options);
+    return matches;
+}
+/* ============================================================
+ * Duplicate Finder
+ * ============================================================ */
+/**
+ * Find files with identical content. Files are bucketed by size, then
+ * by a hash of their first and last few KB, and only the survivors are
+ * hashed in full on the thread pool.
+ */
+export function findDuplicates(root, options = {}) {
+    return native.findDuplicates(root, options);
+}
+/* ============================================================
+ * Disk Usage
+ * ============================================================ */
+/**
+ * Measure a tree on the parallel walker, summing apparent size and
+ * allocated blocks per directory down to maxDepth. Hard-linked files
+ * count once, in the directory where they are seen first.
+ */
+export function duTree(root, options = {}) {
+    return native.duTree(root, options);
+}
 /* ============================================================
  * Stat Operations
  * ============================================================ */
@@ -129,6 +256,12 @@ export function lstat(path) {
         ctime: new Date(st.ctime * 1000),
     };
 }
+/**
+ * statx many paths in one native call
+ */
+export function statMany(paths, options = {}) {
+    return native.statMany(paths, options);
+}
 /**
  * Check if path exists
  */
@@ -188,6 +321,13 @@ export function readdir(path) {
 export function readdirWithTypes(path) {
     return native.readdirWithTypes(path);
 }
+/**
+ * List a directory and lstat every entry in one native call. Builds a
+ * handful of objects however large the directory is.
+ */
+export function readdirPlus(path) {
+    return native.readdirPlus(path);
+}
 /* ============================================================
  * Path Operations
  * ============================================================ */
@@ -237,6 +377,25 @@ export function resolve(path) {
 export function isAbsolute(path) {
     return native.isAbsolute(path);
 }
+/**
+ * Relative path from one path to another, worked out lexically
+ * against the current directory
+ */
+export function relative(from, to) {
+    return native.relative(from, to);
+}
+export function joinMany(base, paths) {
+    return native.pathBatch('join', paths, base);
+}
+export function normalizeMany(paths) {
+    return native.pathBatch('normalize', paths);
+}
+export function relativeMany(from, paths) {
+    return native.pathBatch('relative', paths, from);
+}
+export function resolveMany(paths, base) {
+    return native.pathBatch('resolve', paths, base);
+}
 /* ============================================================
  * Symlink Operations
  * ============================================================ */
@@ -303,6 +462,498 @@ export function chown(path, uid, gid) {
 export function glob(pattern) {
     return native.glob(pattern);
 }
+/**
+ * Glob a tree with the parallel walker, delivering matches in batches.
+ * Supports {a,b}, ** and '!' exclusions; directories no pattern can
+ * reach and ignored directories are never read. Directories are only
+ * emitted with `directories: true`.
+ */
+export function globBatches(root, patterns, onBatch, options = {}) {
+    const list = Array.isArray(patterns) ? patterns : [patterns];
+    return native.globWalk(root, list, options, onBatch);
+}
+/**
+ * Glob a tree with the parallel walker and collect matching paths
+ */
+export async function globTree(root, patterns, options = {}) {
+    const paths = [];
+    await globBatches(root, patterns, (batch) => {
+        for (const entry of batch)
+            paths.push(entry.path);
+    }, options);
+    return paths;
+}
+/**
+ * Test relative paths against glob patterns (a trailing '/' marks a directory)
+ */
+export function globMatch(paths, patterns, options = {}) {
+    const list = Array.isArray(patterns) ? patterns : [patterns];
+    return native.globMatch(paths, list, options);
+}
+/* ============================================================
+ * File Handles
+ * ============================================================ */
+/* ZFO_OPEN_* bits */
+const OPEN_READ = 0x01;
+const OPEN_WRITE = 0x02;
+const OPEN_APPEND = 0x04;
+const OPEN_CREATE = 0x08;
+const OPEN_TRUNCATE = 0x10;
+const OPEN_EXCLUSIVE = 0x20;
+const OPEN_FLAGS = {
+    'r': OPEN_READ,
+    'r+': OPEN_READ | OPEN_WRITE,
+    'w': OPEN_WRITE | OPEN_CREATE | OPEN_TRUNCATE,
+    'w+': OPEN_READ | OPEN_WRITE | OPEN_CREATE | OPEN_TRUNCATE,
+    'wx': OPEN_WRITE | OPEN_CREATE | OPEN_TRUNCATE | OPEN_EXCLUSIVE,
+    'wx+': OPEN_READ | OPEN_WRITE | OPEN_CREATE | OPEN_TRUNCATE | OPEN_EXCLUSIVE,
+    'a': OPEN_WRITE | OPEN_APPEND | OPEN_CREATE,
+    'a+': OPEN_READ | OPEN_WRITE | OPEN_APPEND | OPEN_CREATE,
+    'ax': OPEN_WRITE | OPEN_APPEND | OPEN_CREATE | OPEN_EXCLUSIVE,
+    'ax+': OPEN_READ | OPEN_WRITE | OPEN_APPEND | OPEN_CREATE | OPEN_EXCLUSIVE,
+};
+const SEEK_WHENCE = { set: 0, cur: 1, end: 2 };
+/* ZFO_LOCK_* bits */
+const LOCK_SHARED = 0x01;
+const LOCK_EXCLUSIVE = 0x02;
+const LOCK_NONBLOCK = 0x04;
+/**
+ * An open file. Every method is one syscall on the kept descriptor.
+ * A position of null means the current file position, as with read(2)
+ * and write(2); a number reads or writes there without moving it.
+ */
+export class FileHandle {
+    handle;
+    bufferSize;
+    buffered = false;
+    constructor(handle, bufferSize) {
+        this.handle = handle;
+        this.bufferSize = bufferSize;
+    }
+    static open(path, flags = 'r', options = {}) {
+        const bits = OPEN_FLAGS[flags];
+        if (bits === undefined)
+            throw new TypeError(`Unknown open flags: ${flags}`);
+        const handle = native.fileOpen(path, bits, options.mode ?? 0o644);
+        return new FileHandle(handle, options.bufferSize ?? 64 * 1024);
+    }
+    /**
+     * Read into buffer[offset, offset + length)
+     * @returns Bytes read, 0 at end of file
+     */
+    read(buffer, offset = 0, length = buffer.length - offset, position = null) {
+        return native.fileRead(this.open(), buffer, offset, length, position);
+    }
+    /**
+     * Write data, returning the bytes written
+     */
+    write(data, position = null) {
+        const buf = typeof data === 'string' ? Buffer.from(data) : data;
+        return native.fileWrite(this.open(), buf, 0, buf.length, position);
+    }
+    /**
+     * Fill several buffers in order with one readv
+     */
+    readv(buffers, position = null) {
+        return native.fileReadv(this.open(), buffers, position);
+    }
+    /**
+     * Write several buffers in order with one writev
+     */
+    writev(buffers, position = null) {
+        return native.fileWritev(this.open(), buffers, position);
+    }
+    /**
+     * Append at the file position through a native buffer, so many small
+     * writes cost one syscall. Buffered data is written out by flush(),
+     * close(), or before any other operation on the handle.
+     */
+    writeBuffered(data) {
+        const handle = this.open();
+        if (!this.buffered) {
+            native.fileSetBuffer(handle, this.bufferSize);
+            this.buffered = true;
+        }
+        native.fileWriteBuffered(handle, typeof data === 'string' ? Buffer.from(data) : data);
+    }
+    flush() {
+        native.fileFlush(this.open());
+    }
+    /**
+     * Move the file position
+     * @returns The new position
+     */
+    seek(offset, whence = 'set') {
+        return native.fileSeek(this.open(), offset, SEEK_WHENCE[whence]);
+    }
+    stat() {
+        return native.fileStat(this.open());
+    }
+    truncate(size = 0) {
+        native.fileTruncate(this.open(), size);
+    }
+    /** fsync */
+    sync() {
+        native.fileSync(this.open());
+    }
+    /** fdatasync */
+    datasync() {
+        native.fileDatasync(this.open());
+    }
+    /**
+     * Access-pattern hint for a range (length 0 = to end of file)
+     */
+    advise(advice, offset = 0, length = 0) {
+        native.fileAdvise(this.open(), advice, offset, length);
+    }
+    /**
+     * Reserve blocks so later writes can't fail with ENOSPC, or punch them out
+     */
+    allocate(offset, length, options = {}) {
+        native.fileAllocate(this.open(), offset, length, options);
+    }
+    /**
+     * Take a POSIX record lock (length 0 = to end of file)
+     * @returns false if wait is off and another process holds the range
+     */
+    lock(offset = 0, length = 0, options = {}) {
+        let flags = options.shared ? LOCK_SHARED : LOCK_EXCLUSIVE;
+        if (options.wait === false)
+            flags |= LOCK_NONBLOCK;
+        return native.fileLock(this.open(), offset, length, flags);
+    }
+    unlock(offset = 0, length = 0) {
+        native.fileUnlock(this.open(), offset, length);
+    }
+    /**
+     * Flush and close the descriptor
+     */
+    close() {
+        if (this.handle) {
+            const handle = this.handle;
+            this.handle = null;
+            native.fileClose(handle);
+        }
+    }
+    open() {
+        if (!this.handle)
+            throw new Error('File closed');
+        return this.handle;
+    }
+}
+/* ============================================================
+ * Chunked Reader
+ * ============================================================ */
+/**
+ * Reads a large file on a background thread into a small ring of
+ * aligned buffers, one buffer ahead of the consumer. Chunks are views
+ * over those buffers: release each one once done with it so the
+ * reader can refill it. Iterating with for await releases for you.
+ */
+export class ChunkReader {
+    handle;
+    constructor(handle) {
+        this.handle = handle;
+    }
+    static open(path, options = {}) {
+        return new ChunkReader(native.readerOpen(path, options));
+    }
+    /**
+     * Resolve with the next chunk in order, or null at end of stream
+     */
+    next() {
+        return native.readerNext(this.open());
+    }
+    /**
+     * Block until the next chunk is ready
+     */
+    nextSync() {
+        return native.readerNextSync(this.open());
+    }
+    /**
+     * Hand a chunk's buffer back to the reader. Its data must not be
+     * used afterwards.
+     */
+    release(chunk) {
+        native.readerRelease(this.open(), chunk.seq);
+    }
+    info() {
+        return native.readerInfo(this.open());
+    }
+    /**
+     * Stop the reader thread. Buffers of unreleased chunks stay valid
+     * until they are garbage collected.
+     */
+    close() {
+        if (this.handle) {
+            const handle = this.handle;
+            this.handle = null;
+            native.readerClose(handle);
+        }
+    }
+    async *[Symbol.asyncIterator]() {
+        let chunk;
+        while ((chunk = await this.next())) {
+            try {
+                yield chunk;
+            }
+            finally {
+                if (this.handle)
+                    this.release(chunk);
+            }
+        }
+    }
+    open() {
+        if (!this.handle)
+            throw new Error('Reader closed');
+        return this.handle;
+    }
+}
+/* ============================================================
+ * Content Cache
+ * ============================================================ */
+/**
+ * Read-through cache of whole-file contents with a byte budget and
+ * CLOCK eviction. A hit costs one stat and returns the same Buffer as
+ * the previous read of that file, without copying; treat the Buffers
+ * as read-only since they are shared.
+ */
+export class ContentCache {
+    handle;
+    constructor(options = {}) {
+        this.handle = native.cacheCreate(options);
+    }
+    /**
+     * Contents of path, read and cached on a miss
+     */
+    read(path) {
+        return native.cacheRead(this.handle, path, false);
+    }
+    /**
+     * zstd frame of path's contents, compressed once and cached alongside
+     * them (for serving with Content-Encoding: zstd)
+     */
+    readCompressed(path) {
+        return native.cacheRead(this.handle, path, true);
+    }
+    /**
+     * Drop path, and with recursive everything below it. Returns the
+     * number of entries dropped.
+     */
+    invalidate(path, recursive = false) {
+        return native.cacheInvalidate(this.handle, path, recursive);
+    }
+    clear() {
+        native.cacheClear(this.handle);
+    }
+    stats() {
+        return native.cacheStats(this.handle);
+    }
+    /**
+     * Drop every entry; Buffers already handed out stay valid
+     */
+    close() {
+        native.cacheClose(this.handle);
+    }
+}
+/* ============================================================
+ * Path Table
+ * ============================================================ */
+/**
+ * Interns normalized paths as small integer ids. Paths are stored as a
+ * tree of (directory, name) nodes, so a directory shared by many paths
+ * is kept once and comparing two paths is comparing two numbers.
+ */
+export class PathTable {
+    handle;
+    constructor() {
+        this.handle = native.pathTableCreate();
+    }
+    /**
+     * Id of path, added if new. "a/./b" and "a/b" share an id.
+     */
+    intern(path) {
+        return native.pathTableIntern(this.handle, path);
+    }
+    internMany(paths) {
+        return native.pathTableIntern(this.handle, paths);
+    }
+    path(id) {
+        return native.pathTableGet(this.handle, id);
+    }
+    paths(ids) {
+        return native.pathTableGet(this.handle, ids);
+    }
+    /**
+     * Id of the directory holding id
+     */
+    dirname(id) {
+        return native.pathTableParent(this.handle, id);
+    }
+    basename(id) {
+        return native.pathTableName(this.handle, id);
+    }
+    stats() {
+        return native.pathTableStats(this.handle);
+    }
+    close() {
+        native.pathTableClose(this.handle);
+    }
+}
+/* ============================================================
+ * Shared-Memory Channel
+ * ============================================================ */
+/**
+ * Message channel between processes over a shared mapping: any number
+ * of processes send, one receives. Messages are written and read in
+ * place, so received messages and reserved slots are Buffers viewing
+ * the mapping rather than copies. A blocked side sleeps on a futex and
+ * is woken directly by the other, without going through the event loop.
+ */
+export class Channel {
+    buffer;
+    path;
+    constructor(buffer) {
+        this.buffer = buffer;
+        this.path = native.channelInfo(buffer).path;
+    }
+    /**
+     * Create a channel in a file at path (reset if it exists), or in an
+     * anonymous memfd reachable through the returned channel's path
+     */
+    static create(path = null, options = {}) {
+        return new Channel(native.channelCreate(path, options));
+    }
+    /** Attach to a channel created by another process */
+    static open(path) {
+        return new Channel(native.channelOpen(path));
+    }
+    /**
+     * Copy data in as one message. Returns false if the ring stayed full
+     * for timeoutMs (0 = don't wait, -1 = wait as long as it takes).
+     */
+    send(data, timeoutMs = 0) {
+        return native.channelSend(this.buffer, typeof data === 'string' ? Buffer.from(data) : data, timeoutMs);
+    }
+    /**
+     * Claim a slot of length bytes to fill in place, then pass it to
+     * commit(). Returns null if the ring stayed full for timeoutMs.
+     */
+    reserve(length, timeoutMs = 0) {
+        const offset = native.channelReserve(this.buffer, length, timeoutMs);
+        return offset === null ? null : Buffer.from(this.buffer, offset, length);
+    }
+    /** Publish a slot from reserve() */
+    commit(slot) {
+        native.channelCommit(this.buffer, slot.byteOffset);
+    }
+    /**
+     * Take the next message, or null if none arrived within timeoutMs
+     * (which blocks the thread; prefer wait() on the main thread). The
+     * Buffer is only valid until the next receive() or release().
+     */
+    receive(timeoutMs = 0) {
+        const msg = native.channelReceive(this.buffer, timeoutMs);
+        return msg ? Buffer.from(this.buffer, msg.offset, msg.length) : null;
+    }
+    /** Give the last received message's space back to senders */
+    release() {
+        native.channelRelease(this.buffer);
+    }
+    /**
+     * Resolve true once receive() has a message, or false on timeout or
+     * close. Waits off the main thread.
+     */
+    wait(timeoutMs = -1) {
+        return native.channelWait(this.buffer, timeoutMs);
+    }
+    info() {
+        return native.channelInfo(this.buffer);
+    }
+    /** Unmap; message Buffers still held become empty */
+    close() {
+        native.channelClose(this.buffer);
+    }
+    async *[Symbol.asyncIterator]() {
+        for (;;) {
+            const msg = this.receive();
+            if (msg) {
+                yield msg;
+            }
+            else if (!(await this.wait())) {
+                return;
+            }
+        }
+    }
+}
+/* ============================================================
+ * Tar Archives
+ * ============================================================ */
+/**
+ * Pack a tree into a tar archive, optionally zstd or LZ4 compressed.
+ * Everything runs natively: the tree is walked in parallel and file
+ * data streams through the encoder without passing through JS.
+ */
+export function tarPack(root, archive, options = {}) {
+    return native.tarPack(root, archive, options);
+}
+/**
+ * Unpack a tar, tar.zst or tar.lz4 archive (detected from its first
+ * bytes) into dest, writing files in parallel. Modes and mtimes are
+ * restored; members whose path contains ".." are skipped.
+ */
+export function tarUnpack(archive, dest, options = {}) {
+    return native.tarUnpack(archive, dest, options);
+}
+/**
+ * Extract a single member to outPath. Archives packed with seekable
+ * are read from the member's own frame; others are scanned.
+ */
+export function tarExtract(archive, member, outPath) {
+    return native.tarExtract(archive, member, outPath);
+}
+/* ============================================================
+ * Memory Mapping
+ * ============================================================ */
+/**
+ * A memory-mapped file region. `buffer` is an ArrayBuffer directly over
+ * the mapping; it is detached (length 0) once unmap() is called.
+ */
+export class MappedFile {
+    buffer;
+    constructor(path, options = {}) {
+        this.buffer = native.mmap(path, options);
+    }
+    /** Byte view over the mapping (no copy) */
+    bytes() {
+        return Buffer.from(this.buffer);
+    }
+    /** Flush written pages to the file (msync) */
+    sync() {
+        native.mmapSync(this.buffer);
+    }
+    /** Access-pattern hint for a range (default: whole mapping) */
+    advise(advice, offset = 0, length = 0) {
+        native.mmapAdvise(this.buffer, advice, offset, length);
+    }
+    /** Pin pages in RAM (mlock) */
+    lock() {
+        native.mmapLock(this.buffer, true);
+    }
+    unlock() {
+        native.mmapLock(this.buffer, false);
+    }
+    /** Unmap now instead of waiting for garbage collection */
+    unmap() {
+        native.mmapUnmap(this.buffer);
+    }
+}
+/**
+ * Memory-map a file
+ */
+export function mmap(path, options = {}) {
+    return new MappedFile(path, options);
+}
 /* ============================================================
  * File Watcher
  * ============================================================ */
@@ -318,11 +969,12 @@ export class Watcher {
     }
     /**
      * Add path to watch
+     * @param recursive Also watch subdirectories, including ones created later
      */
-    add(path) {
+    add(path, recursive = false) {
         if (!this.initialized)
             throw new Error('Watcher closed');
-        const wd = native.watchAdd(path);
+        const wd = native.watchAdd(path, recursive);
         this.watches.set(wd, path);
         return wd;
     }
@@ -370,6 +1022,289 @@ export function watch(path) {
         watcher.add(path);
     return watcher;
 }
+/**
+ * Event-driven watcher. Events are read on a native thread, coalesced
+ * (bursts of writes fold into one change, moves pair into renames) and
+ * delivered in batches. Instances are independent of each other.
+ */
+export class EventWatcher {
+    handle;
+    watches = new Map();
+    constructor(onChanges, options = {}) {
+        this.handle = native.watcherCreate(onChanges, options);
+    }
+    /**
+     * Add path to watch
+     */
+    add(path, options = {}) {
+        if (!this.handle)
+            throw new Error('Watcher closed');
+        const wd = native.watcherAdd(this.handle, path, options);
+        this.watches.set(wd, path);
+        return wd;
+    }
+    /**
+     * Remove watch
+     */
+    remove(wd) {
+        if (!this.handle)
+            throw new Error('Watcher closed');
+        native.watcherRemove(this.handle, wd);
+        this.watches.delete(wd);
+    }
+    /**
+     * Get path for watch descriptor
+     */
+    getPath(wd) {
+        return this.watches.get(wd);
+    }
+    /**
+     * Stop the event thread; undelivered changes are dropped
+     */
+    close() {
+        if (this.handle) {
+            native.watcherClose(this.handle);
+            this.watches.clear();
+            this.handle = null;
+        }
+    }
+}
+/**
+ * Watch one or more paths, receiving coalesced batches of changes
+ */
+export function watchEvents(paths, onChanges, options = {}) {
+    const watcher = new EventWatcher(onChanges, options);
+    try {
+        for (const path of Array.isArray(paths) ? paths : [paths])
+            watcher.add(path, options);
+    }
+    catch (err) {
+        watcher.close();
+        throw err;
+    }
+    return watcher;
+}
+/* ============================================================
+ * Directory Snapshot
+ * ============================================================ */
+/**
+ * Persistent index of a directory tree. update() re-stats every entry
+ * but only reads directories whose mtime changed; apply() folds
+ * EventWatcher changes in without touching anything else.
+ */
+export class Snapshot {
+    handle;
+    constructor(handle) {
+        this.handle = handle;
+    }
+    /**
+     * Index every path under root
+     */
+    static async create(root, options = {}) {
+        return new Snapshot(await native.snapshotCreate(root, options));
+    }
+    /**
+     * Map a snapshot written by save()
+     */
+    static load(file) {
+        return new Snapshot(native.snapshotLoad(file));
+    }
+    get root() {
+        return native.snapshotInfo(this.open()).root;
+    }
+    /** Number of indexed paths */
+    get size() {
+        return native.snapshotInfo(this.open()).count;
+    }
+    /**
+     * Rescan changed directories and report what changed
+     */
+    update(threads = 0) {
+        return native.snapshotUpdate(this.open(), threads);
+    }
+    /**
+     * Apply watcher changes (absolute paths under root). An overflow
+     * event falls back to a full update.
+     */
+    apply(changes) {
+        return native.snapshotApply(this.open(), changes);
+    }
+    /**
+     * Look up one path relative to root
+     */
+    get(path) {
+        return native.snapshotGet(this.open(), path);
+    }
+    /**
+     * Every entry, in path order
+     */
+    entries() {
+        return native.snapshotEntries(this.open());
+    }
+    /**
+     * Write to a file atomically
+     */
+    save(file) {
+        native.snapshotSave(this.open(), file);
+    }
+    /**
+     * Release the index now instead of waiting for garbage collection
+     */
+    close() {
+        if (this.handle) {
+            native.snapshotClose(this.handle);
+            this.handle = null;
+        }
+    }
+    open() {
+        if (!this.handle)
+            throw new Error('Snapshot closed');
+        return this.handle;
+    }
+}
+/* ============================================================
+ * Write-Ahead Log
+ * ============================================================ */
+/**
+ * Append-only record log in a directory of preallocated segments.
+ * append() only copies into memory; records become durable through
+ * the syncInterval/syncBytes policy or an explicit sync().
+ */
+export class WriteAheadLog {
+    handle;
+    constructor(handle) {
+        this.handle = handle;
+    }
+    /**
+     * Open or create the log in dir. A torn tail from a crash is cut
+     * off, so appends continue after the last complete record.
+     */
+    static open(dir, options = {}) {
+        return new WriteAheadLog(native.walOpen(dir, options));
+    }
+    /**
+     * Visit every record with seq >= fromSeq, in order. Return false
+     * from the callback to stop early.
+     */
+    static replay(dir, onRecord, fromSeq = 0) {
+        return native.walReplay(dir, fromSeq, onRecord);
+    }
+    /**
+     * Append one record and return its sequence number
+     */
+    append(data) {
+        return native.walAppend(this.open(), typeof data === 'string' ? Buffer.from(data) : data);
+    }
+    /**
+     * Hand buffered records to the kernel without waiting for the disk
+     */
+    flush() {
+        native.walFlush(this.open());
+    }
+    /**
+     * Block until every appended record is on disk
+     */
+    sync() {
+        native.walSync(this.open());
+    }
+    /**
+     * Delete segments holding only records before beforeSeq
+     */
+    truncate(beforeSeq) {
+        native.walTruncate(this.open(), beforeSeq);
+    }
+    stats() {
+        return native.walStats(this.open());
+    }
+    /**
+     * Sync and release the log
+     */
+    close() {
+        if (this.handle) {
+            const handle = this.handle;
+            this.handle = null;
+            native.walClose(handle);
+        }
+    }
+    open() {
+        if (!this.handle)
+            throw new Error('Log closed');
+        return this.handle;
+    }
+}
+/* ============================================================
+ * Key-Value Store
+ * ============================================================ */
+/**
+ * Log-structured key-value store in a directory. Every key lives in
+ * an in-memory directory pointing at its newest record, so get() is a
+ * single read; overwritten and deleted records are reclaimed by merge.
+ */
+export class KeyValueStore {
+    handle;
+    constructor(handle) {
+        this.handle = handle;
+    }
+    /**
+     * Open or create the store in dir. Only one store may have a
+     * directory open at a time.
+     */
+    static open(dir, options = {}) {
+        return new KeyValueStore(native.kvOpen(dir, options));
+    }
+    /**
+     * Value stored under key, or null
+     */
+    get(key) {
+        return native.kvGet(this.open(), key);
+    }
+    put(key, value) {
+        native.kvPut(this.open(), key, value);
+    }
+    /**
+     * Remove key; false if it was not stored
+     */
+    delete(key) {
+        return native.kvDelete(this.open(), key);
+    }
+    has(key) {
+        return native.kvHas(this.open(), key);
+    }
+    keys(asBuffers = false) {
+        return native.kvKeys(this.open(), asBuffers);
+    }
+    /**
+     * Block until every put and delete is on disk
+     */
+    sync() {
+        native.kvSync(this.open());
+    }
+    /**
+     * Rewrite the sealed data files keeping only live records. Reads
+     * and writes continue while it runs.
+     */
+    merge() {
+        return native.kvMerge(this.open());
+    }
+    stats() {
+        return native.kvStats(this.open());
+    }
+    /**
+     * Sync and release the store
+     */
+    close() {
+        if (this.handle) {
+            const handle = this.handle;
+            this.handle = null;
+            native.kvClose(handle);
+        }
+    }
+    open() {
+        if (!this.handle)
+            throw new Error('Store closed');
+        return this.handle;
+    }
+}
 /**
  * Get version
  */
@@ -381,12 +1316,23 @@ export default {
     readText,
     writeFile,
     appendFile,
+    writeFilesAtomic,
     copyFile,
     moveFile,
     remove,
     removeRecursive,
+    removeTree,
+    copyTree,
+    moveTree,
+    walk,
+    walkBatches,
+    searchFiles,
+    searchBatches,
+    findDuplicates,
+    duTree,
     stat,
     lstat,
+    statMany,
     exists,
     isFile,
     isDirectory,
@@ -396,6 +1342,7 @@ export default {
     mkdirp,
     readdir,
     readdirWithTypes,
+    readdirPlus,
     basename,
     dirname,
     extname,
@@ -403,6 +1350,11 @@ export default {
     normalize,
     resolve,
     isAbsolute,
+    relative,
+    joinMany,
+    normalizeMany,
+    relativeMany,
+    resolveMany,
     symlink,
     readlink,
     tmpdir,
@@ -412,8 +1364,29 @@ export default {
     chmod,
     chown,
     glob,
+    globBatches,
+    globTree,
+    globMatch,
+    FileHandle,
+    ChunkReader,
+    ContentCache,
+    PathTable,
+    Channel,
+    tarPack,
+    tarUnpack,
+    tarExtract,
+    mmap,
+    MappedFile,
+    MmapAdvice,
+    FileAdvice,
     Watcher,
     watch,
+    EventWatcher,
+    watchEvents,
+    WatchEventType,
+    Snapshot,
+    WriteAheadLog,
+    KeyValueStore,
     version,
     FileType,
 };
@@ -52,6 +52,10 @@ export declare function load(handle: IniHandle, path: string): boolean;
  * Load INI from string content into existing handle
  */
 export declare function loadString(handle: IniHandle, content: string): boolean;
+/**
+ * Map a compiled .dd file (from compile()) into an existing handle
+ */
+export declare function loadBinary(handle: IniHandle, path: string): boolean;
 /**
  * Get a string value (key format: "section.key")
  */
@@ -62,16 +66,19 @@ export declare function get(handle: IniHandle, key: string): string | null;
 export declare function getDefault(handle: IniHandle, key: string, defaultValue: string): string;
 /**
  * Get an integer value (key format: "section.key")
+ * Returns defaultValue (0 if omitted) when missing or not an integer.
  */
-export declare function getInt(handle: IniHandle, key: string): number;
+export declare function getInt(handle: IniHandle, key: string, defaultValue?: number): number;
 /**
  * Get a float value (key format: "section.key")
+ * Returns defaultValue (0 if omitted) when missing or not a number.
  */
-export declare function getFloat(handle: IniHandle, key: string): number;
+export declare function getFloat(handle: IniHandle, key: string, defaultValue?: number): number;
 /**
  * Get a boolean value (key format: "section.key")
+ * Returns defaultValue (false if omitted) when missing.
  */
-export declare function getBool(handle: IniHandle, key: string): boolean;
+export declare function getBool(handle: IniHandle, key: string, defaultValue?: boolean): boolean;
 /**
  * Get an array value (split by delimiter, key format: "section.key")
  */
@@ -92,6 +99,10 @@ export declare function toString(handle: IniHandle): string;
  * Save INI to file
  */
 export declare function save(handle: IniHandle, path: string): boolean;
+/**
+ * Compile INI to a binary .dd file for fast loading
+ */
+export declare function compile(handle: IniHandle, path: string): boolean;
 /**
  * Get all section names
  */
@@ -119,6 +130,10 @@ export declare class INIDocument {
      * Parse from string
      */
     static parse(content: string): INIDocument;
+    /**
+     * Load a compiled .dd file
+     */
+    static loadBinary(path: string): INIDocument;
     private checkFreed;
     /**
      * Get a string value (key format: "section.key")
@@ -171,6 +186,10 @@ export declare class INIDocument {
      * Save to file
      */
     save(path: string): boolean;
+    /**
+     * Compile to a binary .dd file
+     */
+    compile(path: string): boolean;
     /**
      * Get all section names
      */
@@ -194,6 +213,7 @@ declare const _default: {
     free: typeof free;
     load: typeof load;
     loadString: typeof loadString;
+    loadBinary: typeof loadBinary;
     get: typeof get;
     getDefault: typeof getDefault;
     getInt: typeof getInt;
@@ -204,6 +224,7 @@ declare const _default: {
     set: typeof set;
     toString: typeof toString;
     save: typeof save;
+    compile: typeof compile;
     sections: typeof sections;
     stats: typeof stats;
     INIDocument: typeof INIDocument;
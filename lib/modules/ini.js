@@ -62,6 +62,12 @@ export function load(handle, path) {
 export function loadString(handle, content) {
     return native.loadString(handle, content);
 }
+/**
+ * Map a compiled .dd file (from compile()) into an existing handle
+ */
+export function loadBinary(handle, path) {
+    return native.loadBinary(handle, path);
+}
 /**
  * Get a string value (key format: "section.key")
  */
@@ -76,21 +82,24 @@ export function getDefault(handle, key, defaultValue) {
 }
 /**
  * Get an integer value (key format: "section.key")
+ * Returns defaultValue (0 if omitted) when missing or not an integer.
  */
-export function getInt(handle, key) {
-    return native.getInt(handle, key);
+export function getInt(handle, key, defaultValue) {
+    return native.getInt(handle, key, defaultValue);
 }
 /**
  * Get a float value (key format: "section.key")
+ * Returns defaultValue (0 if omitted) when missing or not a number.
  */
-export function getFloat(handle, key) {
-    return native.getFloat(handle, key);
+export function getFloat(handle, key, defaultValue) {
+    return native.getFloat(handle, key, defaultValue);
 }
 /**
  * Get a boolean value (key format: "section.key")
+ * Returns defaultValue (false if omitted) when missing.
  */
-export function getBool(handle, key) {
-    return native.getBool(handle, key);
+export function getBool(handle, key, defaultValue) {
+    return native.getBool(handle, key, defaultValue);
 }
 /**
  * Get an array value (split by delimiter, key format: "section.key")
@@ -122,6 +131,12 @@ export function toString(handle) {
 export function save(handle, path) {
     return native.save(handle, path);
 }
+/**
+ * Compile INI to a binary .dd file for fast loading
+ */
+export function compile(handle, path) {
+    return native.compile(handle, path);
+}
 /**
  * Get all section names
  */
@@ -165,6 +180,14 @@ export class INIDocument {
         native.loadString(doc._handle, content);
         return doc;
     }
+    /**
+     * Load a compiled .dd file
+     */
+    static loadBinary(path) {
+        const doc = new INIDocument(native.create());
+        native.loadBinary(doc._handle, path);
+        return doc;
+    }
     checkFreed() {
         if (this._freed) {
             throw new Error('INIDocument has been freed');
@@ -242,6 +265,13 @@ export class INIDocument {
         this.checkFreed();
         return native.save(this._handle, path);
     }
+    /**
+     * Compile to a binary .dd file
+     */
+    compile(path) {
+        this.checkFreed();
+        return native.compile(this._handle, path);
+    }
     /**
      * Get all section names
      */
@@ -278,6 +308,7 @@ export default {
     free,
     load,
     loadString,
+    loadBinary,
     get,
     getDefault,
     getInt,
@@ -288,6 +319,7 @@ export default {
     set,
     toString,
     save,
+    compile,
     sections,
     stats,
     INIDocument,
@@ -17,6 +17,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <errno.h>
+#include <pthread.h>
 
 #include "zorya_fileops.h"
 
@@ -92,6 +93,113 @@ static const char* get_error_string(void) {
     return strerror(errno);
 }
 
+static void throw_zfo_error(napi_env env, int code) {
+    napi_throw_error(env, NULL, zfo_strerror(code));
+}
+
+static bool get_opt_bool(napi_env env, napi_value obj, const char* key, bool fallback) {
+    bool has = false;
+    napi_value val;
+    if (napi_has_named_property(env, obj, key, &has) != napi_ok || !has) return fallback;
+    napi_get_named_property(env, obj, key, &val);
+    napi_valuetype type;
+    napi_typeof(env, val, &type);
+    if (type != napi_boolean) return fallback;
+    bool out = fallback;
+    napi_get_value_bool(env, val, &out);
+    return out;
+}
+
+static int32_t get_opt_int32(napi_env env, napi_value obj, const char* key, int32_t fallback) {
+    bool has = false;
+    napi_value val;
+    if (napi_has_named_property(env, obj, key, &has) != napi_ok || !has) return fallback;
+    napi_get_named_property(env, obj, key, &val);
+    napi_valuetype type;
+    napi_typeof(env, val, &type);
+    if (type != napi_number) return fallback;
+    int32_t out = fallback;
+    napi_get_value_int32(env, val, &out);
+    return out;
+}
+
+static double get_opt_double(napi_env env, napi_value obj, const char* key, double fallback) {
+    bool has = false;
+    napi_value val;
+    if (napi_has_named_property(env, obj, key, &has) != napi_ok || !has) return fallback;
+    napi_get_named_property(env, obj, key, &val);
+    napi_valuetype type;
+    napi_typeof(env, val, &type);
+    if (type != napi_number) return fallback;
+    double out = fallback;
+    napi_get_value_double(env, val, &out);
+    return out;
+}
+
+/* Copy a JS string array into a malloc'd list (NULL if not an array) */
+static char** get_string_list(napi_env env, napi_value arr, size_t* count) {
+    *count = 0;
+    bool is_array = false;
+    napi_is_array(env, arr, &is_array);
+    if (!is_array) return NULL;
+
+    uint32_t len;
+    napi_get_array_length(env, arr, &len);
+    char** list = calloc(len > 0 ? len : 1, sizeof(char*));
+    if (!list) return NULL;
+
+    for (uint32_t i = 0; i < len; i++) {
+        napi_value el;
+        size_t slen;
+        napi_get_element(env, arr, i, &el);
+        if (napi_get_value_string_utf8(env, el, NULL, 0, &slen) != napi_ok) continue;
+        char* str = malloc(slen + 1);
+        if (!str) continue;
+        napi_get_value_string_utf8(env, el, str, slen + 1, &slen);
+        list[(*count)++] = str;
+    }
+    return list;
+}
+
+/* Copy an optional string array property into a malloc'd list */
+static char** get_opt_string_list(napi_env env, napi_value obj, const char* key, size_t* count) {
+    *count = 0;
+    bool has = false;
+    napi_value arr;
+    if (napi_has_named_property(env, obj, key, &has) != napi_ok || !has) return NULL;
+    napi_get_named_property(env, obj, key, &arr);
+    return get_string_list(env, arr, count);
+}
+
+/* Compile a patterns array with dot/nocase options; throws and returns NULL on failure */
+static zfo_glob_set_t* compile_glob_set(napi_env env, napi_value patterns, napi_value options) {
+    size_t count = 0;
+    char** list = get_string_list(env, patterns, &count);
+    if (!list) {
+        napi_throw_type_error(env, NULL, "Patterns must be an array of strings");
+        return NULL;
+    }
+
+    uint32_t flags = 0;
+    napi_valuetype opt_type = napi_undefined;
+    if (options) napi_typeof(env, options, &opt_type);
+    if (opt_type == napi_object) {
+        if (get_opt_bool(env, options, "dot", false)) flags |= ZFO_GLOB_DOT;
+        if (get_opt_bool(env, options, "nocase", false)) flags |= ZFO_GLOB_NOCASE;
+    }
+
+    zfo_glob_set_t* set = NULL;
+    int rc = zfo_glob_compile((const char* const*)list, count, flags, &set);
+    for (size_t i = 0; i < count; i++) free(list[i]);
+    free(list);
+
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return set;
+}
+
 /* ============================================================
  * Version
  * ============================================================ */
@@ -107,10 +215,44 @@ static napi_value get_version(napi_env env, napi_callback_info info) {
  * File Operations
  * ============================================================ */
 
-/* readFile(path: string): Buffer */
+static void free_buffer_data(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)hint;
+    free(data);
+}
+
+static void unmap_buffer_data(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)data;
+    zfo_mmap_close((zfo_mmap_t*)hint);
+}
+
+/*
+ * Wrap memory we own in a Buffer without copying. Runtimes that forbid
+ * external buffers (V8 sandbox) get a copy instead; the finalizer is
+ * then run by hand.
+ */
+static napi_value create_owned_buffer(napi_env env, void* data, size_t size,
+                                      napi_finalize finalize, void* hint) {
+    napi_value buffer;
+    if (napi_create_external_buffer(env, size, data, finalize, hint, &buffer) == napi_ok) {
+        return buffer;
+    }
+
+    void* copy;
+    napi_status status = napi_create_buffer_copy(env, size, data, &copy, &buffer);
+    finalize(env, data, hint);
+    if (status != napi_ok) {
+        napi_throw_error(env, NULL, "Failed to create buffer");
+        return NULL;
+    }
+    return buffer;
+}
+
+/* readFile(path: string, options?: {mmap?: boolean, mmapThreshold?: number}): Buffer */
 static napi_value read_file(napi_env env, napi_callback_info info) {
-    size_t argc = 1;
-    napi_value argv[1];
+    size_t argc = 2;
+    napi_value argv[2];
     NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
 
     if (argc < 1) {
@@ -122,6 +264,35 @@ static napi_value read_file(napi_env env, napi_callback_info info) {
     size_t path_len;
     NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
 
+    /* Large files can be mapped instead of read */
+    bool use_mmap = false;
+    if (argc > 1) {
+        napi_valuetype type;
+        napi_typeof(env, argv[1], &type);
+        if (type == napi_object) {
+            use_mmap = get_opt_bool(env, argv[1], "mmap", false);
+            double threshold = get_opt_double(env, argv[1], "mmapThreshold", -1);
+            if (!use_mmap && threshold >= 0) {
+                zfo_stat_t st;
+                use_mmap = zfo_stat(path, &st) == ZFO_OK && (double)st.size >= threshold;
+            }
+        }
+    }
+
+    if (use_mmap) {
+        zfo_mmap_t* map = NULL;
+        int rc = zfo_mmap_read_file(path, &map);
+        if (rc == ZFO_OK) {
+            return create_owned_buffer(env, zfo_mmap_ptr(map), zfo_mmap_size(map),
+                                       unmap_buffer_data, map);
+        }
+        /* Empty files can't be mapped; read them normally */
+        if (rc != ZFO_ERR_INVALID_ARG) {
+            throw_zfo_error(env, rc);
+            return NULL;
+        }
+    }
+
     uint8_t* data = NULL;
     size_t size = 0;
     int result = zfo_read_file(path, &data, &size);
@@ -130,18 +301,14 @@ static napi_value read_file(napi_env env, napi_callback_info info) {
         return NULL;
     }
 
-    napi_value buffer;
-    void* buffer_data;
-    NAPI_CALL(napi_create_buffer_copy(env, size, data, &buffer_data, &buffer));
-
-    free(data);
-    return buffer;
+    /* Hand the malloc'd block to the Buffer; freed by the GC */
+    return create_owned_buffer(env, data, size, free_buffer_data, NULL);
 }
 
-/* writeFile(path: string, data: Buffer): void */
+/* writeFile(path: string, data: Buffer, options?: {preallocate?, sparse?, holeMin?}): void */
 static napi_value write_file(napi_env env, napi_callback_info info) {
-    size_t argc = 2;
-    napi_value argv[2];
+    size_t argc = 3;
+    napi_value argv[3];
     NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
 
     if (argc < 2) {
@@ -157,7 +324,17 @@ static napi_value write_file(napi_env env, napi_callback_info info) {
     size_t data_len;
     NAPI_CALL(napi_get_buffer_info(env, argv[1], &data, &data_len));
 
-    int result = zfo_write_file(path, data, data_len);
+    zfo_write_options_t opts = {0};
+    napi_valuetype opt_type = napi_undefined;
+    if (argc > 2) napi_typeof(env, argv[2], &opt_type);
+    if (opt_type == napi_object) {
+        if (get_opt_bool(env, argv[2], "preallocate", false)) opts.flags |= ZFO_WRITE_PREALLOCATE;
+        if (get_opt_bool(env, argv[2], "sparse", false)) opts.flags |= ZFO_WRITE_SPARSE;
+        double hole_min = get_opt_double(env, argv[2], "holeMin", 0);
+        if (hole_min > 0) opts.hole_min = (size_t)hole_min;
+    }
+
+    int result = zfo_write_file_opts(path, data, data_len, &opts, NULL);
     if (result != ZFO_OK) {
         napi_throw_error(env, NULL, get_error_string());
         return NULL;
@@ -258,18 +435,4807 @@ static napi_value remove_path(napi_env env, napi_callback_info info) {
     napi_value argv[1];
     NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
 
-    if (argc < 1) {
-        napi_throw_type_error(env, NULL, "Path required");
-        return NULL;
-    }
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Path required");
+        return NULL;
+    }
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+
+    int result = zfo_remove(path);
+    if (result != ZFO_OK) {
+        napi_throw_error(env, NULL, get_error_string());
+        return NULL;
+    }
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* removeRecursive(path: string): void */
+static napi_value remove_recursive(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Path required");
+        return NULL;
+    }
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+
+    int result = zfo_remove_all(path);
+    if (result != ZFO_OK) {
+        napi_throw_error(env, NULL, get_error_string());
+        return NULL;
+    }
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ============================================================
+ * Parallel Tree Operations
+ * ============================================================ */
+
+typedef struct {
+    napi_env env;
+    napi_value callback;
+    bool threw;
+} tree_progress_ctx_t;
+
+static napi_value create_progress_object(napi_env env, const zfo_tree_progress_t* p) {
+    napi_value obj, val;
+    napi_create_object(env, &obj);
+
+    napi_create_double(env, (double)p->files, &val);
+    napi_set_named_property(env, obj, "files", val);
+    napi_create_double(env, (double)p->dirs, &val);
+    napi_set_named_property(env, obj, "dirs", val);
+    napi_create_double(env, (double)p->bytes, &val);
+    napi_set_named_property(env, obj, "bytes", val);
+    napi_create_double(env, (double)p->errors, &val);
+    napi_set_named_property(env, obj, "errors", val);
+
+    return obj;
+}
+
+/* Runs on the calling (JS) thread while workers make progress */
+static int tree_progress_cb(const zfo_tree_progress_t* progress, void* userdata) {
+    tree_progress_ctx_t* ctx = userdata;
+    if (ctx->threw) return 1;
+
+    napi_env env = ctx->env;
+    napi_handle_scope scope;
+    napi_open_handle_scope(env, &scope);
+
+    napi_value global, ret;
+    napi_value arg = create_progress_object(env, progress);
+    napi_get_global(env, &global);
+
+    int cancel = 0;
+    if (napi_call_function(env, global, ctx->callback, 1, &arg, &ret) != napi_ok) {
+        ctx->threw = true;
+        cancel = 1;
+    } else {
+        napi_valuetype type;
+        napi_typeof(env, ret, &type);
+        if (type == napi_boolean) {
+            bool keep_going = true;
+            napi_get_value_bool(env, ret, &keep_going);
+            cancel = !keep_going;
+        }
+    }
+
+    napi_close_handle_scope(env, scope);
+    return cancel;
+}
+
+/* Read {threads, onProgress, progressInterval, ...copy flags} */
+static void parse_tree_options(napi_env env, napi_value obj, zfo_tree_options_t* opts,
+                               zfo_copy_options_t* copy, tree_progress_ctx_t* progress) {
+    memset(opts, 0, sizeof(*opts));
+    memset(copy, 0, sizeof(*copy));
+    copy->preserve_mode = true;
+    copy->preserve_times = true;
+    copy->recursive = true;
+    copy->buffer_size = 64 * 1024;
+
+    progress->env = env;
+    progress->callback = NULL;
+    progress->threw = false;
+
+    if (!obj) return;
+    napi_valuetype type;
+    napi_typeof(env, obj, &type);
+    if (type != napi_object) return;
+
+    opts->threads = get_opt_int32(env, obj, "threads", 0);
+    int32_t interval = get_opt_int32(env, obj, "progressInterval", 0);
+    opts->progress_interval_ms = interval > 0 ? (uint32_t)interval : 0;
+
+    copy->overwrite = get_opt_bool(env, obj, "overwrite", false);
+    copy->preserve_mode = get_opt_bool(env, obj, "preserveMode", true);
+    copy->preserve_times = get_opt_bool(env, obj, "preserveTimes", true);
+    copy->follow_symlinks = get_opt_bool(env, obj, "followSymlinks", false);
+
+    bool has = false;
+    napi_value cb;
+    if (napi_has_named_property(env, obj, "onProgress", &has) == napi_ok && has) {
+        napi_get_named_property(env, obj, "onProgress", &cb);
+        napi_typeof(env, cb, &type);
+        if (type == napi_function) {
+            progress->callback = cb;
+            opts->progress = tree_progress_cb;
+            opts->userdata = progress;
+        }
+    }
+}
+
+/* Build {files, dirs, bytes, errors: [{path, code, message}], cancelled} */
+static napi_value create_tree_result(napi_env env, int rc, const zfo_tree_result_t* result) {
+    napi_value obj = create_progress_object(env, &result->totals);
+    napi_value errors, val;
+    napi_create_array_with_length(env, result->error_count, &errors);
+
+    for (size_t i = 0; i < result->error_count; i++) {
+        napi_value err;
+        napi_create_object(env, &err);
+        napi_create_string_utf8(env, result->errors[i].path, NAPI_AUTO_LENGTH, &val);
+        napi_set_named_property(env, err, "path", val);
+        napi_create_int32(env, result->errors[i].error, &val);
+        napi_set_named_property(env, err, "code", val);
+        napi_create_string_utf8(env, zfo_strerror(result->errors[i].error), NAPI_AUTO_LENGTH, &val);
+        napi_set_named_property(env, err, "message", val);
+        napi_set_element(env, errors, (uint32_t)i, err);
+    }
+    napi_set_named_property(env, obj, "errors", errors);
+
+    napi_get_boolean(env, rc == ZFO_ERR_INTERRUPTED, &val);
+    napi_set_named_property(env, obj, "cancelled", val);
+
+    return obj;
+}
+
+static napi_value finish_tree_call(napi_env env, int rc, zfo_tree_result_t* result,
+                                   const tree_progress_ctx_t* progress) {
+    if (progress->threw) {
+        /* Exception from onProgress is still pending */
+        zfo_tree_result_free(result);
+        return NULL;
+    }
+
+    if (rc != ZFO_OK && result->error_count == 0 && rc != ZFO_ERR_INTERRUPTED) {
+        zfo_tree_result_free(result);
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value obj = create_tree_result(env, rc, result);
+    zfo_tree_result_free(result);
+    return obj;
+}
+
+/* removeTree(path: string, options?: object): TreeResult */
+static napi_value remove_tree(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Path required");
+        return NULL;
+    }
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+
+    zfo_tree_options_t opts;
+    zfo_copy_options_t copy;
+    tree_progress_ctx_t progress;
+    parse_tree_options(env, argc > 1 ? argv[1] : NULL, &opts, &copy, &progress);
+
+    zfo_tree_result_t result;
+    int rc = zfo_remove_all_parallel(path, &opts, &result);
+    return finish_tree_call(env, rc, &result, &progress);
+}
+
+/* copyTree(src: string, dst: string, options?: object): TreeResult */
+static napi_value copy_tree(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Source and destination required");
+        return NULL;
+    }
+
+    char src[4096], dst[4096];
+    size_t len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], src, sizeof(src), &len));
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[1], dst, sizeof(dst), &len));
+
+    zfo_tree_options_t opts;
+    zfo_copy_options_t copy;
+    tree_progress_ctx_t progress;
+    parse_tree_options(env, argc > 2 ? argv[2] : NULL, &opts, &copy, &progress);
+
+    zfo_tree_result_t result;
+    int rc = zfo_copy_parallel(src, dst, &copy, &opts, &result);
+    return finish_tree_call(env, rc, &result, &progress);
+}
+
+/* moveTree(src: string, dst: string, options?: object): TreeResult */
+static napi_value move_tree(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Source and destination required");
+        return NULL;
+    }
+
+    char src[4096], dst[4096];
+    size_t len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], src, sizeof(src), &len));
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[1], dst, sizeof(dst), &len));
+
+    zfo_tree_options_t opts;
+    zfo_copy_options_t copy;
+    tree_progress_ctx_t progress;
+    parse_tree_options(env, argc > 2 ? argv[2] : NULL, &opts, &copy, &progress);
+
+    zfo_tree_result_t result;
+    int rc = zfo_move_parallel(src, dst, &copy, &opts, &result);
+    return finish_tree_call(env, rc, &result, &progress);
+}
+
+/* ============================================================
+ * Parallel Walker
+ * ============================================================ */
+
+#define WALK_DEFAULT_BATCH 256
+#define WALK_QUEUE_DEPTH 4
+
+/* Entries produced by one worker, handed to JS as a unit */
+typedef struct {
+    char* names;                    /* NUL-separated paths */
+    size_t names_len;
+    size_t names_cap;
+    uint32_t* offsets;
+    uint32_t* name_offs;            /* Basename offset within each path */
+    uint8_t* types;
+    int32_t* depths;
+    zfo_stat_t* stats;              /* NULL unless stat requested */
+    size_t count;
+    size_t cap;
+} walk_batch_t;
+
+typedef struct {
+    char root[4096];
+    zfo_walk_options_t opts;
+    char** prune;
+    char** exts;
+    size_t ext_count;
+    bool include_files;
+    bool include_dirs;
+    size_t batch_size;
+
+    zfo_glob_set_t* glob;           /* Set for globWalk */
+    zfo_glob_options_t glob_opts;
+    char** ignore;
+    char** ignore_files;
+
+    walk_batch_t** batches;         /* One open batch per worker */
+    int nworkers;
+
+    napi_threadsafe_function tsfn;
+    napi_deferred deferred;
+    napi_ref error_ref;             /* Exception thrown by onBatch */
+    pthread_t thread;
+    bool started;
+    int stop;                       /* Set from JS (atomic) */
+
+    int rc;
+    zfo_tree_result_t result;
+} walk_job_t;
+
+static walk_batch_t* walk_batch_new(size_t cap, bool with_stats) {
+    walk_batch_t* b = calloc(1, sizeof(walk_batch_t));
+    if (!b) return NULL;
+    b->cap = cap;
+    b->names_cap = cap * 64;
+    b->names = malloc(b->names_cap);
+    b->offsets = malloc(cap * sizeof(uint32_t));
+    b->name_offs = malloc(cap * sizeof(uint32_t));
+    b->types = malloc(cap);
+    b->depths = malloc(cap * sizeof(int32_t));
+    b->stats = with_stats ? malloc(cap * sizeof(zfo_stat_t)) : NULL;
+    if (!b->names || !b->offsets || !b->name_offs || !b->types || !b->depths ||
+        (with_stats && !b->stats)) {
+        free(b->names);
+        free(b->offsets);
+        free(b->name_offs);
+        free(b->types);
+        free(b->depths);
+        free(b->stats);
+        free(b);
+        return NULL;
+    }
+    return b;
+}
+
+static void walk_batch_free(walk_batch_t* b) {
+    if (!b) return;
+    free(b->names);
+    free(b->offsets);
+    free(b->name_offs);
+    free(b->types);
+    free(b->depths);
+    free(b->stats);
+    free(b);
+}
+
+static bool walk_ext_match(const walk_job_t* job, const char* name) {
+    size_t len = strlen(name);
+    for (size_t i = 0; i < job->ext_count; i++) {
+        size_t el = strlen(job->exts[i]);
+        if (len >= el && memcmp(name + len - el, job->exts[i], el) == 0) return true;
+    }
+    return false;
+}
+
+/* Hand a batch to the JS thread (blocks while the queue is full) */
+static bool walk_flush(walk_job_t* job, int worker) {
+    walk_batch_t* b = job->batches[worker];
+    if (!b || b->count == 0) return true;
+
+    job->batches[worker] = NULL;
+    if (napi_call_threadsafe_function(job->tsfn, b, napi_tsfn_blocking) != napi_ok) {
+        walk_batch_free(b);
+        return false;
+    }
+    return true;
+}
+
+/* Runs on pool workers */
+static int walk_visit(const zfo_walk_entry_t* entry, void* userdata) {
+    walk_job_t* job = userdata;
+    if (__atomic_load_n(&job->stop, __ATOMIC_RELAXED)) return ZFO_WALK_STOP;
+
+    bool is_dir = entry->type == ZFO_TYPE_DIR;
+    if (is_dir ? !job->include_dirs : !job->include_files) return ZFO_WALK_CONTINUE;
+    if (!is_dir && job->ext_count > 0 && !walk_ext_match(job, entry->name)) {
+        return ZFO_WALK_CONTINUE;
+    }
+
+    walk_batch_t* b = job->batches[entry->worker];
+    if (!b) {
+        b = walk_batch_new(job->batch_size, (job->opts.flags & ZFO_WALK_STAT) != 0);
+        if (!b) return ZFO_WALK_STOP;
+        job->batches[entry->worker] = b;
+    }
+
+    if (b->names_len + entry->path_len + 1 > b->names_cap) {
+        size_t ncap = (b->names_len + entry->path_len + 1) * 2;
+        char* nnames = realloc(b->names, ncap);
+        if (!nnames) return ZFO_WALK_STOP;
+        b->names = nnames;
+        b->names_cap = ncap;
+    }
+
+    size_t i = b->count++;
+    b->offsets[i] = (uint32_t)b->names_len;
+    b->name_offs[i] = (uint32_t)(entry->name - entry->path);
+    b->types[i] = (uint8_t)entry->type;
+    b->depths[i] = entry->depth;
+    if (b->stats && entry->stat) b->stats[i] = *entry->stat;
+    memcpy(b->names + b->names_len, entry->path, entry->path_len + 1);
+    b->names_len += entry->path_len + 1;
+
+    if (b->count == b->cap && !walk_flush(job, entry->worker)) return ZFO_WALK_STOP;
+    return ZFO_WALK_CONTINUE;
+}
+
+static void* walk_thread(void* arg) {
+    walk_job_t* job = arg;
+
+    if (job->glob) {
+        job->glob_opts.walk = job->opts;
+        job->rc = zfo_glob_walk(job->root, job->glob, &job->glob_opts, &job->result);
+    } else {
+        job->rc = zfo_walk_parallel(job->root, &job->opts, &job->result);
+    }
+    for (int i = 0; i < job->nworkers; i++) walk_flush(job, i);
+
+    napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+    return NULL;
+}
+
+/* Runs on the JS thread for every batch */
+static void walk_call_js(napi_env env, napi_value callback, void* context, void* data) {
+    walk_job_t* job = context;
+    walk_batch_t* b = data;
+
+    if (!env || __atomic_load_n(&job->stop, __ATOMIC_RELAXED)) {
+        walk_batch_free(b);
+        return;
+    }
+
+    napi_value arr, val;
+    napi_create_array_with_length(env, b->count, &arr);
+
+    for (size_t i = 0; i < b->count; i++) {
+        const char* path = b->names + b->offsets[i];
+        napi_value obj;
+        if (b->stats) {
+            obj = create_stat_object(env, &b->stats[i]);
+        } else {
+            napi_create_object(env, &obj);
+            napi_create_int32(env, b->types[i], &val);
+            napi_set_named_property(env, obj, "type", val);
+            napi_get_boolean(env, b->types[i] == ZFO_TYPE_FILE, &val);
+            napi_set_named_property(env, obj, "isFile", val);
+            napi_get_boolean(env, b->types[i] == ZFO_TYPE_DIR, &val);
+            napi_set_named_property(env, obj, "isDirectory", val);
+            napi_get_boolean(env, b->types[i] == ZFO_TYPE_SYMLINK, &val);
+            napi_set_named_property(env, obj, "isSymlink", val);
+        }
+        napi_create_string_utf8(env, path, NAPI_AUTO_LENGTH, &val);
+        napi_set_named_property(env, obj, "path", val);
+        napi_create_string_utf8(env, path + b->name_offs[i], NAPI_AUTO_LENGTH, &val);
+        napi_set_named_property(env, obj, "name", val);
+        napi_create_int32(env, b->depths[i], &val);
+        napi_set_named_property(env, obj, "depth", val);
+        napi_set_element(env, arr, (uint32_t)i, obj);
+    }
+    walk_batch_free(b);
+
+    napi_value global, ret;
+    napi_get_global(env, &global);
+    if (napi_call_function(env, global, callback, 1, &arr, &ret) != napi_ok) {
+        napi_value exc;
+        napi_get_and_clear_last_exception(env, &exc);
+        if (!job->error_ref) napi_create_reference(env, exc, 1, &job->error_ref);
+        __atomic_store_n(&job->stop, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    napi_valuetype type;
+    napi_typeof(env, ret, &type);
+    if (type == napi_boolean) {
+        bool keep_going = true;
+        napi_get_value_bool(env, ret, &keep_going);
+        if (!keep_going) __atomic_store_n(&job->stop, 1, __ATOMIC_RELAXED);
+    }
+}
+
+static void walk_job_free(walk_job_t* job) {
+    for (size_t i = 0; i < job->opts.prune_count; i++) free(job->prune[i]);
+    for (size_t i = 0; i < job->ext_count; i++) free(job->exts[i]);
+    for (size_t i = 0; i < job->glob_opts.ignore_count; i++) free(job->ignore[i]);
+    for (size_t i = 0; i < job->glob_opts.ignore_file_count; i++) free(job->ignore_files[i]);
+    free(job->prune);
+    free(job->exts);
+    free(job->ignore);
+    free(job->ignore_files);
+    zfo_glob_set_free(job->glob);
+    if (job->batches) {
+        for (int i = 0; i < job->nworkers; i++) walk_batch_free(job->batches[i]);
+        free(job->batches);
+    }
+    zfo_tree_result_free(&job->result);
+    free(job);
+}
+
+/* Runs on the JS thread once every batch has been delivered */
+static void walk_finalize(napi_env env, void* data, void* hint) {
+    (void)hint;
+    walk_job_t* job = data;
+    if (job->started) pthread_join(job->thread, NULL);
+
+    if (job->error_ref) {
+        napi_value exc;
+        napi_get_reference_value(env, job->error_ref, &exc);
+        napi_reject_deferred(env, job->deferred, exc);
+        napi_delete_reference(env, job->error_ref);
+    } else if (job->rc != ZFO_OK && job->result.error_count == 0 &&
+               job->rc != ZFO_ERR_INTERRUPTED) {
+        napi_value msg, err;
+        napi_create_string_utf8(env, zfo_strerror(job->rc), NAPI_AUTO_LENGTH, &msg);
+        napi_create_error(env, NULL, msg, &err);
+        napi_reject_deferred(env, job->deferred, err);
+    } else {
+        int rc = __atomic_load_n(&job->stop, __ATOMIC_RELAXED) ? ZFO_ERR_INTERRUPTED : job->rc;
+        napi_value summary = create_tree_result(env, rc, &job->result);
+        napi_resolve_deferred(env, job->deferred, summary);
+    }
+
+    walk_job_free(job);
+}
+
+/* Parse root and walk options into a new job; throws and returns NULL on failure */
+static walk_job_t* walk_job_new(napi_env env, napi_value root, napi_value options,
+                                bool include_dirs) {
+    walk_job_t* job = calloc(1, sizeof(walk_job_t));
+    if (!job) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+
+    size_t len;
+    if (napi_get_value_string_utf8(env, root, job->root, sizeof(job->root), &len) != napi_ok) {
+        free(job);
+        napi_throw_type_error(env, NULL, "Root must be a string");
+        return NULL;
+    }
+
+    job->opts.max_depth = -1;
+    job->include_files = true;
+    job->include_dirs = include_dirs;
+    job->batch_size = WALK_DEFAULT_BATCH;
+
+    napi_valuetype opt_type;
+    napi_typeof(env, options, &opt_type);
+    if (opt_type == napi_object) {
+        napi_value o = options;
+        job->opts.threads = get_opt_int32(env, o, "threads", 0);
+        job->opts.max_depth = get_opt_int32(env, o, "maxDepth", -1);
+        if (get_opt_bool(env, o, "stat", false)) job->opts.flags |= ZFO_WALK_STAT;
+        if (get_opt_bool(env, o, "followSymlinks", false)) job->opts.flags |= ZFO_WALK_FOLLOW_SYMLINKS;
+        if (!get_opt_bool(env, o, "includeHidden", true)) job->opts.flags |= ZFO_WALK_SKIP_HIDDEN;
+        job->include_files = get_opt_bool(env, o, "files", true);
+        job->include_dirs = get_opt_bool(env, o, "directories", include_dirs);
+        int32_t batch = get_opt_int32(env, o, "batchSize", WALK_DEFAULT_BATCH);
+        job->batch_size = batch > 0 ? (size_t)batch : WALK_DEFAULT_BATCH;
+        job->prune = get_opt_string_list(env, o, "prune", &job->opts.prune_count);
+        job->exts = get_opt_string_list(env, o, "extensions", &job->ext_count);
+    }
+    job->opts.prune = (const char* const*)job->prune;
+    job->opts.visit = walk_visit;
+    job->opts.userdata = job;
+
+    job->nworkers = zfo_thread_count(job->opts.threads);
+    job->batches = calloc(job->nworkers, sizeof(walk_batch_t*));
+    if (!job->batches) {
+        walk_job_free(job);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    return job;
+}
+
+/* Start the walk thread; batches go to on_batch on the JS thread */
+static napi_value walk_job_start(napi_env env, walk_job_t* job, napi_value on_batch,
+                                 const char* resource) {
+    napi_value promise, name;
+    napi_create_string_utf8(env, resource, NAPI_AUTO_LENGTH, &name);
+    if (napi_create_promise(env, &job->deferred, &promise) != napi_ok ||
+        napi_create_threadsafe_function(env, on_batch, NULL, name, WALK_QUEUE_DEPTH, 1,
+                                        job, walk_finalize, job, walk_call_js,
+                                        &job->tsfn) != napi_ok) {
+        walk_job_free(job);
+        napi_throw_error(env, NULL, "Failed to start walk");
+        return NULL;
+    }
+
+    if (pthread_create(&job->thread, NULL, walk_thread, job) != 0) {
+        /* The finalizer rejects the promise once the tsfn is released */
+        job->rc = ZFO_ERR_UNKNOWN;
+        napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+        return promise;
+    }
+    job->started = true;
+
+    return promise;
+}
+
+/* walk(root: string, options: object, onBatch: (entries) => boolean|void): Promise<TreeResult> */
+static napi_value walk_tree(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    napi_valuetype cb_type = napi_undefined;
+    if (argc >= 3) napi_typeof(env, argv[2], &cb_type);
+    if (argc < 3 || cb_type != napi_function) {
+        napi_throw_type_error(env, NULL, "Root, options and batch callback required");
+        return NULL;
+    }
+
+    walk_job_t* job = walk_job_new(env, argv[0], argv[1], true);
+    if (!job) return NULL;
+    return walk_job_start(env, job, argv[2], "pulsar.walk");
+}
+
+/* ============================================================
+ * Content Search
+ * ============================================================ */
+
+#define SEARCH_DEFAULT_BATCH 256
+
+/* Matches found by one worker, handed to JS as a unit */
+typedef struct {
+    char* chars;                    /* Paths and line texts, packed */
+    size_t chars_len;
+    size_t chars_cap;
+    uint32_t* path_offs;
+    uint32_t* path_lens;
+    uint32_t* text_offs;
+    uint32_t* text_lens;
+    double* lines;
+    double* columns;
+    uint32_t* patterns;
+    size_t count;
+    size_t cap;
+} search_batch_t;
+
+typedef struct {
+    char root[4096];
+    char** patterns;
+    size_t pattern_count;
+    zfo_search_options_t opts;
+    zfo_glob_set_t* include;
+    char** prune;
+    char** ignore;
+    char** ignore_files;
+    size_t batch_size;
+
+    search_batch_t** batches;       /* One open batch per worker */
+    int nworkers;
+
+    napi_threadsafe_function tsfn;
+    napi_deferred deferred;
+    napi_ref error_ref;             /* Exception thrown by onBatch */
+    pthread_t thread;
+    bool started;
+    int stop;                       /* Set from JS (atomic) */
+
+    int rc;
+    zfo_search_result_t result;
+} search_job_t;
+
+static search_batch_t* search_batch_new(size_t cap) {
+    search_batch_t* b = calloc(1, sizeof(search_batch_t));
+    if (!b) return NULL;
+    b->cap = cap;
+    b->chars_cap = cap * 128;
+    b->chars = malloc(b->chars_cap);
+    b->path_offs = malloc(cap * sizeof(uint32_t));
+    b->path_lens = malloc(cap * sizeof(uint32_t));
+    b->text_offs = malloc(cap * sizeof(uint32_t));
+    b->text_lens = malloc(cap * sizeof(uint32_t));
+    b->lines = malloc(cap * sizeof(double));
+    b->columns = malloc(cap * sizeof(double));
+    b->patterns = malloc(cap * sizeof(uint32_t));
+    if (!b->chars || !b->path_offs || !b->path_lens || !b->text_offs || !b->text_lens ||
+        !b->lines || !b->columns || !b->patterns) {
+        free(b->chars);
+        free(b->path_offs);
+        free(b->path_lens);
+        free(b->text_offs);
+        free(b->text_lens);
+        free(b->lines);
+        free(b->columns);
+        free(b->patterns);
+        free(b);
+        return NULL;
+    }
+    return b;
+}
+
+static void search_batch_free(search_batch_t* b) {
+    if (!b) return;
+    free(b->chars);
+    free(b->path_offs);
+    free(b->path_lens);
+    free(b->text_offs);
+    free(b->text_lens);
+    free(b->lines);
+    free(b->columns);
+    free(b->patterns);
+    free(b);
+}
+
+/* Hand a batch to the JS thread (blocks while the queue is full) */
+static bool search_flush(search_job_t* job, int worker) {
+    search_batch_t* b = job->batches[worker];
+    if (!b || b->count == 0) return true;
+
+    job->batches[worker] = NULL;
+    if (napi_call_threadsafe_function(job->tsfn, b, napi_tsfn_blocking) != napi_ok) {
+        search_batch_free(b);
+        return false;
+    }
+    return true;
+}
+
+/* Runs on pool workers */
+static int search_on_match(const zfo_search_match_t* m, void* userdata) {
+    search_job_t* job = userdata;
+    if (__atomic_load_n(&job->stop, __ATOMIC_RELAXED)) return ZFO_WALK_STOP;
+
+    search_batch_t* b = job->batches[m->worker];
+    if (!b) {
+        b = search_batch_new(job->batch_size);
+        if (!b) return ZFO_WALK_STOP;
+        job->batches[m->worker] = b;
+    }
+
+    /* Consecutive matches in one file share the stored path */
+    size_t i = b->count;
+    bool same_path = i > 0 && b->path_lens[i - 1] == m->path_len &&
+                     memcmp(b->chars + b->path_offs[i - 1], m->path, m->path_len) == 0;
+    size_t need = m->text_len + (same_path ? 0 : m->path_len);
+    if (b->chars_len + need > b->chars_cap) {
+        size_t ncap = (b->chars_len + need) * 2;
+        char* nchars = realloc(b->chars, ncap);
+        if (!nchars) return ZFO_WALK_STOP;
+        b->chars = nchars;
+        b->chars_cap = ncap;
+    }
+
+    if (same_path) {
+        b->path_offs[i] = b->path_offs[i - 1];
+    } else {
+        b->path_offs[i] = (uint32_t)b->chars_len;
+        memcpy(b->chars + b->chars_len, m->path, m->path_len);
+        b->chars_len += m->path_len;
+    }
+    b->path_lens[i] = (uint32_t)m->path_len;
+    b->text_offs[i] = (uint32_t)b->chars_len;
+    b->text_lens[i] = (uint32_t)m->text_len;
+    memcpy(b->chars + b->chars_len, m->text, m->text_len);
+    b->chars_len += m->text_len;
+    b->lines[i] = (double)m->line;
+    b->columns[i] = (double)m->column;
+    b->patterns[i] = m->pattern;
+    b->count++;
+
+    if (b->count == b->cap && !search_flush(job, m->worker)) return ZFO_WALK_STOP;
+    return ZFO_WALK_CONTINUE;
+}
+
+static void* search_thread(void* arg) {
+    search_job_t* job = arg;
+
+    job->rc = zfo_search(job->root, (const char* const*)job->patterns, job->pattern_count,
+                         &job->opts, &job->result);
+    for (int i = 0; i < job->nworkers; i++) search_flush(job, i);
+
+    napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+    return NULL;
+}
+
+/* Runs on the JS thread for every batch */
+static void search_call_js(napi_env env, napi_value callback, void* context, void* data) {
+    search_job_t* job = context;
+    search_batch_t* b = data;
+
+    if (!env || __atomic_load_n(&job->stop, __ATOMIC_RELAXED)) {
+        search_batch_free(b);
+        return;
+    }
+
+    napi_value arr, val, path = NULL;
+    napi_create_array_with_length(env, b->count, &arr);
+
+    for (size_t i = 0; i < b->count; i++) {
+        if (i == 0 || b->path_offs[i] != b->path_offs[i - 1]) {
+            napi_create_string_utf8(env, b->chars + b->path_offs[i], b->path_lens[i], &path);
+        }
+        napi_value obj;
+        napi_create_object(env, &obj);
+        napi_set_named_property(env, obj, "path", path);
+        napi_create_double(env, b->lines[i], &val);
+        napi_set_named_property(env, obj, "line", val);
+        napi_create_double(env, b->columns[i], &val);
+        napi_set_named_property(env, obj, "column", val);
+        napi_create_string_utf8(env, b->chars + b->text_offs[i], b->text_lens[i], &val);
+        napi_set_named_property(env, obj, "text", val);
+        napi_create_uint32(env, b->patterns[i], &val);
+        napi_set_named_property(env, obj, "pattern", val);
+        napi_set_element(env, arr, (uint32_t)i, obj);
+    }
+    search_batch_free(b);
+
+    napi_value global, ret;
+    napi_get_global(env, &global);
+    if (napi_call_function(env, global, callback, 1, &arr, &ret) != napi_ok) {
+        napi_value exc;
+        napi_get_and_clear_last_exception(env, &exc);
+        if (!job->error_ref) napi_create_reference(env, exc, 1, &job->error_ref);
+        __atomic_store_n(&job->stop, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    napi_valuetype type;
+    napi_typeof(env, ret, &type);
+    if (type == napi_boolean) {
+        bool keep_going = true;
+        napi_get_value_bool(env, ret, &keep_going);
+        if (!keep_going) __atomic_store_n(&job->stop, 1, __ATOMIC_RELAXED);
+    }
+}
+
+static void search_job_free(search_job_t* job) {
+    for (size_t i = 0; i < job->pattern_count; i++) free(job->patterns[i]);
+    for (size_t i = 0; i < job->opts.files.walk.prune_count; i++) free(job->prune[i]);
+    for (size_t i = 0; i < job->opts.files.ignore_count; i++) free(job->ignore[i]);
+    for (size_t i = 0; i < job->opts.files.ignore_file_count; i++) free(job->ignore_files[i]);
+    free(job->patterns);
+    free(job->prune);
+    free(job->ignore);
+    free(job->ignore_files);
+    zfo_glob_set_free(job->include);
+    if (job->batches) {
+        for (int i = 0; i < job->nworkers; i++) search_batch_free(job->batches[i]);
+        free(job->batches);
+    }
+    zfo_tree_result_free(&job->result.walk);
+    free(job);
+}
+
+/* Runs on the JS thread once every batch has been delivered */
+static void search_finalize(napi_env env, void* data, void* hint) {
+    (void)hint;
+    search_job_t* job = data;
+    if (job->started) pthread_join(job->thread, NULL);
+
+    if (job->error_ref) {
+        napi_value exc;
+        napi_get_reference_value(env, job->error_ref, &exc);
+        napi_reject_deferred(env, job->deferred, exc);
+        napi_delete_reference(env, job->error_ref);
+    } else if (job->rc != ZFO_OK && job->result.walk.error_count == 0 &&
+               job->rc != ZFO_ERR_INTERRUPTED) {
+        napi_value msg, err;
+        napi_create_string_utf8(env, zfo_strerror(job->rc), NAPI_AUTO_LENGTH, &msg);
+        napi_create_error(env, NULL, msg, &err);
+        napi_reject_deferred(env, job->deferred, err);
+    } else {
+        const zfo_search_result_t* r = &job->result;
+        int rc = __atomic_load_n(&job->stop, __ATOMIC_RELAXED) ? ZFO_ERR_INTERRUPTED : job->rc;
+        napi_value summary = create_tree_result(env, rc, &r->walk);
+        napi_value val;
+        napi_create_double(env, (double)r->files_searched, &val);
+        napi_set_named_property(env, summary, "searched", val);
+        napi_create_double(env, (double)r->files_matched, &val);
+        napi_set_named_property(env, summary, "matchedFiles", val);
+        napi_create_double(env, (double)r->files_binary, &val);
+        napi_set_named_property(env, summary, "binary", val);
+        napi_create_double(env, (double)r->files_unreadable, &val);
+        napi_set_named_property(env, summary, "unreadable", val);
+        napi_create_double(env, (double)r->bytes_searched, &val);
+        napi_set_named_property(env, summary, "bytesSearched", val);
+        napi_create_double(env, (double)r->matches, &val);
+        napi_set_named_property(env, summary, "matches", val);
+        napi_get_boolean(env, r->limit_reached, &val);
+        napi_set_named_property(env, summary, "limitReached", val);
+        napi_resolve_deferred(env, job->deferred, summary);
+    }
+
+    search_job_free(job);
+}
+
+/* search(root: string, patterns: string[], options: object, onBatch: (matches) => boolean|void): Promise<SearchResult> */
+static napi_value search_files(napi_env env, napi_callback_info info) {
+    size_t argc = 4;
+    napi_value argv[4];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    napi_valuetype cb_type = napi_undefined;
+    if (argc >= 4) napi_typeof(env, argv[3], &cb_type);
+    if (argc < 4 || cb_type != napi_function) {
+        napi_throw_type_error(env, NULL, "Root, patterns, options and batch callback required");
+        return NULL;
+    }
+
+    search_job_t* job = calloc(1, sizeof(search_job_t));
+    if (!job) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+
+    size_t len;
+    if (napi_get_value_string_utf8(env, argv[0], job->root, sizeof(job->root), &len) != napi_ok) {
+        free(job);
+        napi_throw_type_error(env, NULL, "Root must be a string");
+        return NULL;
+    }
+
+    job->patterns = get_string_list(env, argv[1], &job->pattern_count);
+    if (job->pattern_count == 0) {
+        search_job_free(job);
+        napi_throw_type_error(env, NULL, "Patterns must be a non-empty array of strings");
+        return NULL;
+    }
+
+    zfo_search_options_t* so = &job->opts;
+    so->files.walk.max_depth = -1;
+    job->batch_size = SEARCH_DEFAULT_BATCH;
+
+    napi_valuetype opt_type;
+    napi_typeof(env, argv[2], &opt_type);
+    if (opt_type == napi_object) {
+        napi_value o = argv[2];
+        so->files.walk.threads = get_opt_int32(env, o, "threads", 0);
+        so->files.walk.max_depth = get_opt_int32(env, o, "maxDepth", -1);
+        if (get_opt_bool(env, o, "followSymlinks", false)) so->files.walk.flags |= ZFO_WALK_FOLLOW_SYMLINKS;
+        if (!get_opt_bool(env, o, "includeHidden", true)) so->files.walk.flags |= ZFO_WALK_SKIP_HIDDEN;
+        job->prune = get_opt_string_list(env, o, "prune", &so->files.walk.prune_count);
+        job->ignore = get_opt_string_list(env, o, "ignore", &so->files.ignore_count);
+        job->ignore_files = get_opt_string_list(env, o, "ignoreFiles", &so->files.ignore_file_count);
+
+        if (get_opt_bool(env, o, "ignoreCase", false)) so->flags |= ZFO_SEARCH_NOCASE;
+        if (get_opt_bool(env, o, "binary", false)) so->flags |= ZFO_SEARCH_BINARY;
+        double limit = get_opt_double(env, o, "limit", 0);
+        double max_size = get_opt_double(env, o, "maxFileSize", 0);
+        so->max_matches = limit > 0 ? (uint64_t)limit : 0;
+        so->max_file_size = max_size > 0 ? (uint64_t)max_size : 0;
+        int32_t threshold = get_opt_int32(env, o, "mmapThreshold", 0);
+        int32_t max_line = get_opt_int32(env, o, "maxLineLength", 0);
+        so->mmap_threshold = threshold > 0 ? (size_t)threshold : 0;
+        so->max_line_len = max_line > 0 ? (size_t)max_line : 0;
+        int32_t batch = get_opt_int32(env, o, "batchSize", SEARCH_DEFAULT_BATCH);
+        job->batch_size = batch > 0 ? (size_t)batch : SEARCH_DEFAULT_BATCH;
+
+        bool has_include = false;
+        napi_has_named_property(env, o, "include", &has_include);
+        if (has_include) {
+            napi_value include;
+            napi_get_named_property(env, o, "include", &include);
+            job->include = compile_glob_set(env, include, o);
+            if (!job->include) {
+                search_job_free(job);
+                return NULL;
+            }
+        }
+    }
+    so->files.walk.prune = (const char* const*)job->prune;
+    so->files.ignore = (const char* const*)job->ignore;
+    so->files.ignore_files = (const char* const*)job->ignore_files;
+    so->include = job->include;
+    so->on_match = search_on_match;
+    so->userdata = job;
+
+    job->nworkers = zfo_thread_count(so->files.walk.threads);
+    job->batches = calloc(job->nworkers, sizeof(search_batch_t*));
+    if (!job->batches) {
+        search_job_free(job);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+
+    napi_value promise, name;
+    napi_create_string_utf8(env, "pulsar.search", NAPI_AUTO_LENGTH, &name);
+    if (napi_create_promise(env, &job->deferred, &promise) != napi_ok ||
+        napi_create_threadsafe_function(env, argv[3], NULL, name, WALK_QUEUE_DEPTH, 1,
+                                        job, search_finalize, job, search_call_js,
+                                        &job->tsfn) != napi_ok) {
+        search_job_free(job);
+        napi_throw_error(env, NULL, "Failed to start search");
+        return NULL;
+    }
+
+    if (pthread_create(&job->thread, NULL, search_thread, job) != 0) {
+        /* The finalizer rejects the promise once the tsfn is released */
+        job->rc = ZFO_ERR_UNKNOWN;
+        napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+        return promise;
+    }
+    job->started = true;
+
+    return promise;
+}
+
+/* ============================================================
+ * Duplicate Finder
+ * ============================================================ */
+
+typedef struct {
+    char root[4096];
+    zfo_dedup_options_t opts;
+    zfo_glob_set_t* include;
+    char** prune;
+    char** ignore;
+    char** ignore_files;
+
+    napi_threadsafe_function tsfn;  /* Only used to finish on the JS thread */
+    napi_deferred deferred;
+    pthread_t thread;
+    bool started;
+
+    int rc;
+    zfo_dedup_result_t result;
+} dedup_job_t;
+
+static void dedup_job_free(dedup_job_t* job) {
+    for (size_t i = 0; i < job->opts.files.walk.prune_count; i++) free(job->prune[i]);
+    for (size_t i = 0; i < job->opts.files.ignore_count; i++) free(job->ignore[i]);
+    for (size_t i = 0; i < job->opts.files.ignore_file_count; i++) free(job->ignore_files[i]);
+    free(job->prune);
+    free(job->ignore);
+    free(job->ignore_files);
+    zfo_glob_set_free(job->include);
+    zfo_dedup_result_free(&job->result);
+    free(job);
+}
+
+static void* dedup_thread(void* arg) {
+    dedup_job_t* job = arg;
+    job->rc = zfo_find_duplicates(job->root, &job->opts, &job->result);
+    napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+    return NULL;
+}
+
+static void dedup_call_js(napi_env env, napi_value callback, void* context, void* data) {
+    (void)env;
+    (void)callback;
+    (void)context;
+    (void)data;
+}
+
+static void set_named_double(napi_env env, napi_value obj, const char* key, double value) {
+    napi_value val;
+    napi_create_double(env, value, &val);
+    napi_set_named_property(env, obj, key, val);
+}
+
+static void dedup_finalize(napi_env env, void* data, void* hint) {
+    (void)hint;
+    dedup_job_t* job = data;
+    if (job->started) pthread_join(job->thread, NULL);
+
+    const zfo_dedup_result_t* r = &job->result;
+    if (job->rc != ZFO_OK && r->walk.error_count == 0) {
+        napi_value msg, err;
+        napi_create_string_utf8(env, zfo_strerror(job->rc), NAPI_AUTO_LENGTH, &msg);
+        napi_create_error(env, NULL, msg, &err);
+        napi_reject_deferred(env, job->deferred, err);
+        dedup_job_free(job);
+        return;
+    }
+
+    napi_value summary = create_tree_result(env, job->rc, &r->walk);
+    napi_value groups, val;
+    napi_create_array_with_length(env, r->group_count, &groups);
+    for (size_t i = 0; i < r->group_count; i++) {
+        const zfo_dup_group_t* g = &r->groups[i];
+        napi_value obj, paths;
+        napi_create_object(env, &obj);
+        set_named_double(env, obj, "size", (double)g->size);
+        char hex[17];
+        snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)g->hash);
+        napi_create_string_utf8(env, hex, 16, &val);
+        napi_set_named_property(env, obj, "hash", val);
+        napi_create_array_with_length(env, g->count, &paths);
+        for (size_t k = 0; k < g->count; k++) {
+            napi_create_string_utf8(env, g->paths[k], NAPI_AUTO_LENGTH, &val);
+            napi_set_element(env, paths, (uint32_t)k, val);
+        }
+        napi_set_named_property(env, obj, "paths", paths);
+        napi_set_element(env, groups, (uint32_t)i, obj);
+    }
+    napi_set_named_property(env, summary, "groups", groups);
+    set_named_double(env, summary, "scanned", (double)r->files_scanned);
+    set_named_double(env, summary, "candidates", (double)r->candidates);
+    set_named_double(env, summary, "partialHashed", (double)r->partial_hashed);
+    set_named_double(env, summary, "fullHashed", (double)r->full_hashed);
+    set_named_double(env, summary, "bytesHashed", (double)r->bytes_hashed);
+    set_named_double(env, summary, "hardlinksSkipped", (double)r->hardlinks_skipped);
+    set_named_double(env, summary, "failed", (double)r->files_failed);
+    set_named_double(env, summary, "wastedBytes", (double)r->wasted_bytes);
+    napi_resolve_deferred(env, job->deferred, summary);
+
+    dedup_job_free(job);
+}
+
+/* findDuplicates(root: string, options?: object): Promise<DuplicateResult> */
+static napi_value find_duplicates(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Root required");
+        return NULL;
+    }
+
+    dedup_job_t* job = calloc(1, sizeof(dedup_job_t));
+    if (!job) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+
+    size_t len;
+    if (napi_get_value_string_utf8(env, argv[0], job->root, sizeof(job->root), &len) != napi_ok) {
+        free(job);
+        napi_throw_type_error(env, NULL, "Root must be a string");
+        return NULL;
+    }
+
+    zfo_dedup_options_t* d = &job->opts;
+    d->files.walk.max_depth = -1;
+
+    napi_valuetype opt_type = napi_undefined;
+    if (argc > 1) napi_typeof(env, argv[1], &opt_type);
+    if (opt_type == napi_object) {
+        napi_value o = argv[1];
+        d->files.walk.threads = get_opt_int32(env, o, "threads", 0);
+        d->files.walk.max_depth = get_opt_int32(env, o, "maxDepth", -1);
+        if (get_opt_bool(env, o, "followSymlinks", false)) d->files.walk.flags |= ZFO_WALK_FOLLOW_SYMLINKS;
+        if (!get_opt_bool(env, o, "includeHidden", true)) d->files.walk.flags |= ZFO_WALK_SKIP_HIDDEN;
+        job->prune = get_opt_string_list(env, o, "prune", &d->files.walk.prune_count);
+        job->ignore = get_opt_string_list(env, o, "ignore", &d->files.ignore_count);
+        job->ignore_files = get_opt_string_list(env, o, "ignoreFiles", &d->files.ignore_file_count);
+
+        double min_size = get_opt_double(env, o, "minSize", 0);
+        double max_size = get_opt_double(env, o, "maxSize", 0);
+        int32_t partial = get_opt_int32(env, o, "partialBytes", 0);
+        d->min_size = min_size > 0 ? (uint64_t)min_size : 0;
+        d->max_size = max_size > 0 ? (uint64_t)max_size : 0;
+        d->partial_bytes = partial > 0 ? (size_t)partial : 0;
+        d->skip_hardlinks = get_opt_bool(env, o, "skipHardlinks", false);
+
+        bool has_include = false;
+        napi_has_named_property(env, o, "include", &has_include);
+        if (has_include) {
+            napi_value include;
+            napi_get_named_property(env, o, "include", &include);
+            job->include = compile_glob_set(env, include, o);
+            if (!job->include) {
+                dedup_job_free(job);
+                return NULL;
+            }
+        }
+    }
+    d->files.walk.prune = (const char* const*)job->prune;
+    d->files.ignore = (const char* const*)job->ignore;
+    d->files.ignore_files = (const char* const*)job->ignore_files;
+    d->include = job->include;
+
+    napi_value promise, name;
+    napi_create_string_utf8(env, "pulsar.findDuplicates", NAPI_AUTO_LENGTH, &name);
+    if (napi_create_promise(env, &job->deferred, &promise) != napi_ok ||
+        napi_create_threadsafe_function(env, NULL, NULL, name, 1, 1,
+                                        job, dedup_finalize, job, dedup_call_js,
+                                        &job->tsfn) != napi_ok) {
+        dedup_job_free(job);
+        napi_throw_error(env, NULL, "Failed to start duplicate scan");
+        return NULL;
+    }
+
+    if (pthread_create(&job->thread, NULL, dedup_thread, job) != 0) {
+        job->rc = ZFO_ERR_UNKNOWN;
+        napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+        return promise;
+    }
+    job->started = true;
+
+    return promise;
+}
+
+/* ============================================================
+ * Directory Snapshot
+ * ============================================================ */
+
+/*
+ * Owned by the external handle. An update in flight holds a reference
+ * to the handle and sets busy; other calls on the handle throw until
+ * it settles.
+ */
+typedef struct {
+    zfo_snapshot_t* snap;
+    bool busy;
+} js_snapshot_t;
+
+typedef struct {
+    char root[4096];
+    zfo_snapshot_options_t opts;
+    char** prune;
+    js_snapshot_t* js;              /* Set for updates, NULL for create */
+    napi_ref handle_ref;
+    int threads;
+
+    napi_threadsafe_function tsfn;  /* Only used to finish on the JS thread */
+    napi_deferred deferred;
+    pthread_t thread;
+    bool started;
+
+    int rc;
+    zfo_snapshot_t* snap;
+    zfo_snap_diff_t diff;
+} snapshot_job_t;
+
+static void snapshot_handle_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)hint;
+    js_snapshot_t* js = data;
+    zfo_snapshot_free(js->snap);
+    free(js);
+}
+
+static napi_value create_snapshot_handle(napi_env env, zfo_snapshot_t* snap) {
+    js_snapshot_t* js = calloc(1, sizeof(js_snapshot_t));
+    napi_value handle;
+    if (!js || napi_create_external(env, js, snapshot_handle_finalize, NULL, &handle) != napi_ok) {
+        free(js);
+        zfo_snapshot_free(snap);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    js->snap = snap;
+    return handle;
+}
+
+static js_snapshot_t* get_js_snapshot(napi_env env, napi_value handle) {
+    js_snapshot_t* js = NULL;
+    if (napi_get_value_external(env, handle, (void**)&js) != napi_ok || !js) {
+        napi_throw_type_error(env, NULL, "Invalid snapshot handle");
+        return NULL;
+    }
+    if (!js->snap) {
+        napi_throw_error(env, NULL, "Snapshot is closed");
+        return NULL;
+    }
+    if (js->busy) {
+        napi_throw_error(env, NULL, "Snapshot is busy");
+        return NULL;
+    }
+    return js;
+}
+
+static void set_named_bigint(napi_env env, napi_value obj, const char* key, int64_t value) {
+    napi_value val;
+    napi_create_bigint_int64(env, value, &val);
+    napi_set_named_property(env, obj, key, val);
+}
+
+static napi_value create_snapshot_entry(napi_env env, const zfo_snap_entry_t* e) {
+    napi_value obj, val;
+    napi_create_object(env, &obj);
+
+    napi_create_string_utf8(env, e->path, e->path_len, &val);
+    napi_set_named_property(env, obj, "path", val);
+    napi_create_int32(env, e->type, &val);
+    napi_set_named_property(env, obj, "type", val);
+    napi_create_uint32(env, e->mode, &val);
+    napi_set_named_property(env, obj, "mode", val);
+    set_named_double(env, obj, "inode", (double)e->inode);
+    set_named_double(env, obj, "size", (double)e->size);
+    set_named_double(env, obj, "mtimeMs", (double)e->mtime_ns / 1e6);
+    set_named_double(env, obj, "ctimeMs", (double)e->ctime_ns / 1e6);
+    set_named_bigint(env, obj, "mtimeNs", e->mtime_ns);
+    set_named_bigint(env, obj, "ctimeNs", e->ctime_ns);
+
+    if (e->has_hash) {
+        char hex[17];
+        snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)e->hash);
+        napi_create_string_utf8(env, hex, 16, &val);
+    } else {
+        napi_get_null(env, &val);
+    }
+    napi_set_named_property(env, obj, "hash", val);
+    return obj;
+}
+
+static napi_value create_snapshot_diff(napi_env env, const zfo_snap_diff_t* diff) {
+    static const char* const kinds[] = { "", "added", "removed", "modified" };
+
+    napi_value obj, changes, val;
+    napi_create_object(env, &obj);
+    napi_create_array_with_length(env, diff->count, &changes);
+    for (size_t i = 0; i < diff->count; i++) {
+        const zfo_snap_change_t* c = &diff->changes[i];
+        napi_value change;
+        napi_create_object(env, &change);
+        napi_create_string_utf8(env, kinds[c->kind], NAPI_AUTO_LENGTH, &val);
+        napi_set_named_property(env, change, "change", val);
+        napi_create_string_utf8(env, c->path, NAPI_AUTO_LENGTH, &val);
+        napi_set_named_property(env, change, "path", val);
+        napi_create_int32(env, c->type, &val);
+        napi_set_named_property(env, change, "type", val);
+        napi_set_element(env, changes, (uint32_t)i, change);
+    }
+    napi_set_named_property(env, obj, "changes", changes);
+    set_named_double(env, obj, "checked", (double)diff->entries_checked);
+    set_named_double(env, obj, "dirsScanned", (double)diff->dirs_scanned);
+    return obj;
+}
+
+static void snapshot_job_free(napi_env env, snapshot_job_t* job) {
+    for (size_t i = 0; i < job->opts.prune_count; i++) free(job->prune[i]);
+    free(job->prune);
+    if (job->handle_ref) napi_delete_reference(env, job->handle_ref);
+    zfo_snapshot_free(job->snap);
+    zfo_snap_diff_free(&job->diff);
+    free(job);
+}
+
+static void* snapshot_thread(void* arg) {
+    snapshot_job_t* job = arg;
+    if (job->js) {
+        job->rc = zfo_snapshot_update(job->js->snap, job->threads, &job->diff);
+    } else {
+        job->rc = zfo_snapshot_create(job->root, &job->opts, &job->snap);
+    }
+    napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+    return NULL;
+}
+
+static void snapshot_call_js(napi_env env, napi_value callback, void* context, void* data) {
+    (void)env;
+    (void)callback;
+    (void)context;
+    (void)data;
+}
+
+static void snapshot_finalize(napi_env env, void* data, void* hint) {
+    (void)hint;
+    snapshot_job_t* job = data;
+    if (job->started) pthread_join(job->thread, NULL);
+    if (job->js) job->js->busy = false;
+
+    napi_value result = NULL;
+    if (job->rc == ZFO_OK) {
+        if (job->js) {
+            result = create_snapshot_diff(env, &job->diff);
+        } else {
+            result = create_snapshot_handle(env, job->snap);
+            job->snap = NULL;
+            if (!result) {
+                napi_value exc;
+                napi_get_and_clear_last_exception(env, &exc);
+                napi_reject_deferred(env, job->deferred, exc);
+            }
+        }
+    } else {
+        napi_value msg;
+        napi_create_string_utf8(env, zfo_strerror(job->rc), NAPI_AUTO_LENGTH, &msg);
+        napi_create_error(env, NULL, msg, &result);
+        napi_reject_deferred(env, job->deferred, result);
+        result = NULL;
+    }
+    if (result) napi_resolve_deferred(env, job->deferred, result);
+
+    snapshot_job_free(env, job);
+}
+
+static napi_value snapshot_job_start(napi_env env, snapshot_job_t* job) {
+    napi_value promise, name;
+    napi_create_string_utf8(env, "pulsar.snapshot", NAPI_AUTO_LENGTH, &name);
+    if (napi_create_promise(env, &job->deferred, &promise) != napi_ok ||
+        napi_create_threadsafe_function(env, NULL, NULL, name, 1, 1,
+                                        job, snapshot_finalize, job, snapshot_call_js,
+                                        &job->tsfn) != napi_ok) {
+        if (job->js) job->js->busy = false;
+        snapshot_job_free(env, job);
+        napi_throw_error(env, NULL, "Failed to start snapshot scan");
+        return NULL;
+    }
+
+    if (pthread_create(&job->thread, NULL, snapshot_thread, job) != 0) {
+        job->rc = ZFO_ERR_UNKNOWN;
+        napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+        return promise;
+    }
+    job->started = true;
+    return promise;
+}
+
+/* snapshotCreate(root: string, options?: object): Promise<handle> */
+static napi_value snapshot_create(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Root required");
+        return NULL;
+    }
+
+    snapshot_job_t* job = calloc(1, sizeof(snapshot_job_t));
+    if (!job) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+
+    size_t len;
+    if (napi_get_value_string_utf8(env, argv[0], job->root, sizeof(job->root), &len) != napi_ok) {
+        free(job);
+        napi_throw_type_error(env, NULL, "Root must be a string");
+        return NULL;
+    }
+
+    napi_valuetype opt_type = napi_undefined;
+    if (argc > 1) napi_typeof(env, argv[1], &opt_type);
+    if (opt_type == napi_object) {
+        napi_value o = argv[1];
+        job->opts.threads = get_opt_int32(env, o, "threads", 0);
+        if (get_opt_bool(env, o, "hash", false)) job->opts.flags |= ZFO_SNAP_HASH;
+        job->opts.skip_hidden = !get_opt_bool(env, o, "includeHidden", true);
+        job->prune = get_opt_string_list(env, o, "prune", &job->opts.prune_count);
+    }
+    job->opts.prune = (const char* const*)job->prune;
+
+    return snapshot_job_start(env, job);
+}
+
+/* snapshotUpdate(handle, threads?: number): Promise<SnapshotDiff> */
+static napi_value snapshot_update(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_snapshot_t* js = argc >= 1 ? get_js_snapshot(env, argv[0]) : NULL;
+    if (!js) {
+        if (argc < 1) napi_throw_type_error(env, NULL, "Snapshot required");
+        return NULL;
+    }
+
+    snapshot_job_t* job = calloc(1, sizeof(snapshot_job_t));
+    if (!job || napi_create_reference(env, argv[0], 1, &job->handle_ref) != napi_ok) {
+        free(job);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    job->js = js;
+
+    napi_valuetype threads_type = napi_undefined;
+    if (argc > 1) napi_typeof(env, argv[1], &threads_type);
+    if (threads_type == napi_number) napi_get_value_int32(env, argv[1], &job->threads);
+
+    js->busy = true;
+    return snapshot_job_start(env, job);
+}
+
+/* snapshotLoad(file: string): handle */
+static napi_value snapshot_load(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Path required");
+        return NULL;
+    }
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+
+    zfo_snapshot_t* snap = NULL;
+    int rc = zfo_snapshot_load(path, &snap);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return create_snapshot_handle(env, snap);
+}
+
+/* snapshotSave(handle, file: string): void */
+static napi_value snapshot_save(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Snapshot and path required");
+        return NULL;
+    }
+
+    js_snapshot_t* js = get_js_snapshot(env, argv[0]);
+    if (!js) return NULL;
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[1], path, sizeof(path), &path_len));
+
+    int rc = zfo_snapshot_save(js->snap, path);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+static char* get_opt_string_dup(napi_env env, napi_value obj, const char* key) {
+    napi_value val;
+    napi_valuetype type = napi_undefined;
+    if (napi_get_named_property(env, obj, key, &val) == napi_ok) napi_typeof(env, val, &type);
+    if (type != napi_string) return NULL;
+
+    size_t len;
+    napi_get_value_string_utf8(env, val, NULL, 0, &len);
+    if (len == 0) return NULL;
+    char* str = malloc(len + 1);
+    if (str) napi_get_value_string_utf8(env, val, str, len + 1, &len);
+    return str;
+}
+
+/* snapshotApply(handle, changes: WatchChange[]): SnapshotDiff */
+static napi_value snapshot_apply(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    bool is_array = false;
+    if (argc >= 2) napi_is_array(env, argv[1], &is_array);
+    if (!is_array) {
+        napi_throw_type_error(env, NULL, "Snapshot and change array required");
+        return NULL;
+    }
+
+    js_snapshot_t* js = get_js_snapshot(env, argv[0]);
+    if (!js) return NULL;
+
+    uint32_t count;
+    NAPI_CALL(napi_get_array_length(env, argv[1], &count));
+    zfo_watch_change_t* changes = calloc(count ? count : 1, sizeof(zfo_watch_change_t));
+    if (!changes) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        napi_value item;
+        napi_valuetype type = napi_undefined;
+        if (napi_get_element(env, argv[1], i, &item) == napi_ok) napi_typeof(env, item, &type);
+        if (type != napi_object) continue;
+
+        zfo_watch_change_t* c = &changes[n++];
+        c->event = (zfo_watch_event_t)get_opt_int32(env, item, "event", 0);
+        c->path = get_opt_string_dup(env, item, "path");
+        c->old_path = get_opt_string_dup(env, item, "oldPath");
+        c->is_dir = get_opt_bool(env, item, "isDir", false);
+    }
+
+    zfo_snap_diff_t diff;
+    int rc = zfo_snapshot_apply(js->snap, changes, n, &diff);
+    zfo_watch_changes_free(changes, n);
+    if (rc != ZFO_OK) {
+        zfo_snap_diff_free(&diff);
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value result = create_snapshot_diff(env, &diff);
+    zfo_snap_diff_free(&diff);
+    return result;
+}
+
+/* snapshotGet(handle, path: string): SnapshotEntry | null */
+static napi_value snapshot_get(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Snapshot and path required");
+        return NULL;
+    }
+
+    js_snapshot_t* js = get_js_snapshot(env, argv[0]);
+    if (!js) return NULL;
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[1], path, sizeof(path), &path_len));
+
+    zfo_snap_entry_t entry;
+    if (zfo_snapshot_find(js->snap, path, &entry) != ZFO_OK) {
+        napi_value null_val;
+        napi_get_null(env, &null_val);
+        return null_val;
+    }
+    return create_snapshot_entry(env, &entry);
+}
+
+/* snapshotEntries(handle): SnapshotEntry[] */
+static napi_value snapshot_entries(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_snapshot_t* js = argc >= 1 ? get_js_snapshot(env, argv[0]) : NULL;
+    if (!js) {
+        if (argc < 1) napi_throw_type_error(env, NULL, "Snapshot required");
+        return NULL;
+    }
+
+    size_t count = zfo_snapshot_count(js->snap);
+    napi_value arr;
+    napi_create_array_with_length(env, count, &arr);
+    for (size_t i = 0; i < count; i++) {
+        zfo_snap_entry_t entry;
+        zfo_snapshot_entry(js->snap, i, &entry);
+        napi_set_element(env, arr, (uint32_t)i, create_snapshot_entry(env, &entry));
+    }
+    return arr;
+}
+
+/* snapshotInfo(handle): { root, count } */
+static napi_value snapshot_info(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_snapshot_t* js = argc >= 1 ? get_js_snapshot(env, argv[0]) : NULL;
+    if (!js) {
+        if (argc < 1) napi_throw_type_error(env, NULL, "Snapshot required");
+        return NULL;
+    }
+
+    napi_value obj, val;
+    napi_create_object(env, &obj);
+    napi_create_string_utf8(env, zfo_snapshot_root(js->snap), NAPI_AUTO_LENGTH, &val);
+    napi_set_named_property(env, obj, "root", val);
+    set_named_double(env, obj, "count", (double)zfo_snapshot_count(js->snap));
+    return obj;
+}
+
+/* snapshotClose(handle): void */
+static napi_value snapshot_close(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_snapshot_t* js = NULL;
+    if (argc < 1 || napi_get_value_external(env, argv[0], (void**)&js) != napi_ok || !js) {
+        napi_throw_type_error(env, NULL, "Invalid snapshot handle");
+        return NULL;
+    }
+    if (js->busy) {
+        napi_throw_error(env, NULL, "Snapshot is busy");
+        return NULL;
+    }
+    zfo_snapshot_free(js->snap);
+    js->snap = NULL;
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ============================================================
+ * Group-Commit Writes
+ * ============================================================ */
+
+typedef struct {
+    char* path;
+    const void* data;
+    size_t size;
+    char* owned;                    /* Copy of string data */
+    napi_ref ref;                   /* Keeps Buffer data alive */
+} batch_item_t;
+
+typedef struct {
+    batch_item_t* items;
+    size_t count;
+    uint32_t flags;
+
+    napi_threadsafe_function tsfn;  /* Only used to finish on the JS thread */
+    napi_deferred deferred;
+    pthread_t thread;
+    bool started;
+
+    int rc;
+    size_t failed;                  /* Item that failed to stage, or count */
+    zfo_batch_stats_t stats;
+} batch_job_t;
+
+static void batch_job_free(napi_env env, batch_job_t* job) {
+    for (size_t i = 0; i < job->count; i++) {
+        free(job->items[i].path);
+        free(job->items[i].owned);
+        if (job->items[i].ref) napi_delete_reference(env, job->items[i].ref);
+    }
+    free(job->items);
+    free(job);
+}
+
+static void* batch_thread(void* arg) {
+    batch_job_t* job = arg;
+    job->failed = job->count;
+
+    zfo_write_batch_t* batch = zfo_batch_create(job->flags);
+    if (!batch) {
+        job->rc = ZFO_ERR_NO_MEMORY;
+    } else {
+        for (size_t i = 0; i < job->count && job->rc == ZFO_OK; i++) {
+            job->rc = zfo_batch_add(batch, job->items[i].path, job->items[i].data, job->items[i].size);
+            if (job->rc != ZFO_OK) job->failed = i;
+        }
+        if (job->rc == ZFO_OK) job->rc = zfo_batch_commit(batch, &job->stats);
+        zfo_batch_free(batch);
+    }
+
+    napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+    return NULL;
+}
+
+static void batch_call_js(napi_env env, napi_value callback, void* context, void* data) {
+    (void)env;
+    (void)callback;
+    (void)context;
+    (void)data;
+}
+
+static void batch_finalize(napi_env env, void* data, void* hint) {
+    (void)hint;
+    batch_job_t* job = data;
+    if (job->started) pthread_join(job->thread, NULL);
+
+    if (job->rc != ZFO_OK) {
+        char msg_buf[4200];
+        if (job->failed < job->count) {
+            snprintf(msg_buf, sizeof(msg_buf), "%s: %s", zfo_strerror(job->rc),
+                     job->items[job->failed].path);
+        } else {
+            snprintf(msg_buf, sizeof(msg_buf), "%s", zfo_strerror(job->rc));
+        }
+        napi_value msg, err;
+        napi_create_string_utf8(env, msg_buf, NAPI_AUTO_LENGTH, &msg);
+        napi_create_error(env, NULL, msg, &err);
+        napi_reject_deferred(env, job->deferred, err);
+    } else {
+        napi_value result;
+        napi_create_object(env, &result);
+        set_named_double(env, result, "files", (double)job->stats.files);
+        set_named_double(env, result, "flushes", (double)job->stats.flushes);
+        set_named_double(env, result, "dirSyncs", (double)job->stats.dir_syncs);
+        napi_resolve_deferred(env, job->deferred, result);
+    }
+    batch_job_free(env, job);
+}
+
+static bool batch_item_init(napi_env env, napi_value obj, batch_item_t* item) {
+    napi_value path_val, data_val;
+    napi_valuetype type = napi_undefined;
+    if (napi_get_named_property(env, obj, "path", &path_val) != napi_ok) return false;
+    napi_typeof(env, path_val, &type);
+    if (type != napi_string) return false;
+
+    size_t len;
+    napi_get_value_string_utf8(env, path_val, NULL, 0, &len);
+    item->path = malloc(len + 1);
+    if (!item->path) return false;
+    napi_get_value_string_utf8(env, path_val, item->path, len + 1, &len);
+
+    if (napi_get_named_property(env, obj, "data", &data_val) != napi_ok) return false;
+    napi_typeof(env, data_val, &type);
+    if (type == napi_string) {
+        napi_get_value_string_utf8(env, data_val, NULL, 0, &len);
+        item->owned = malloc(len + 1);
+        if (!item->owned) return false;
+        napi_get_value_string_utf8(env, data_val, item->owned, len + 1, &len);
+        item->data = item->owned;
+        item->size = len;
+        return true;
+    }
+
+    void* data;
+    if (napi_get_buffer_info(env, data_val, &data, &item->size) != napi_ok) return false;
+    item->data = data;
+    return napi_create_reference(env, data_val, 1, &item->ref) == napi_ok;
+}
+
+/* writeFilesAtomic(files: { path, data }[], options?: object): Promise<BatchWriteResult> */
+static napi_value write_files_atomic(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    bool is_array = false;
+    if (argc >= 1) napi_is_array(env, argv[0], &is_array);
+    if (!is_array) {
+        napi_throw_type_error(env, NULL, "Array of { path, data } required");
+        return NULL;
+    }
+
+    uint32_t count;
+    NAPI_CALL(napi_get_array_length(env, argv[0], &count));
+    batch_job_t* job = calloc(1, sizeof(batch_job_t));
+    if (job) job->items = calloc(count ? count : 1, sizeof(batch_item_t));
+    if (!job || !job->items) {
+        free(job);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        napi_value item;
+        napi_valuetype type = napi_undefined;
+        if (napi_get_element(env, argv[0], i, &item) == napi_ok) napi_typeof(env, item, &type);
+        job->count = i + 1;
+        if (type != napi_object || !batch_item_init(env, item, &job->items[i])) {
+            batch_job_free(env, job);
+            napi_throw_type_error(env, NULL, "Each file needs a string path and Buffer or string data");
+            return NULL;
+        }
+    }
+
+    napi_valuetype opt_type = napi_undefined;
+    if (argc > 1) napi_typeof(env, argv[1], &opt_type);
+    if (opt_type == napi_object) {
+        if (get_opt_bool(env, argv[1], "syncfs", false)) job->flags |= ZFO_BATCH_SYNCFS;
+        if (get_opt_bool(env, argv[1], "tmpfile", false)) job->flags |= ZFO_BATCH_TMPFILE;
+    }
+
+    napi_value promise, name;
+    napi_create_string_utf8(env, "pulsar.writeFilesAtomic", NAPI_AUTO_LENGTH, &name);
+    if (napi_create_promise(env, &job->deferred, &promise) != napi_ok ||
+        napi_create_threadsafe_function(env, NULL, NULL, name, 1, 1,
+                                        job, batch_finalize, job, batch_call_js,
+                                        &job->tsfn) != napi_ok) {
+        batch_job_free(env, job);
+        napi_throw_error(env, NULL, "Failed to start batch write");
+        return NULL;
+    }
+
+    if (pthread_create(&job->thread, NULL, batch_thread, job) != 0) {
+        job->rc = ZFO_ERR_UNKNOWN;
+        napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+        return promise;
+    }
+    job->started = true;
+
+    return promise;
+}
+
+/* ============================================================
+ * Write-Ahead Log
+ * ============================================================ */
+
+typedef struct {
+    zfo_wal_t* wal;
+} js_wal_t;
+
+static void wal_handle_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)hint;
+    js_wal_t* js = data;
+    if (js->wal) zfo_wal_close(js->wal);
+    free(js);
+}
+
+static js_wal_t* get_js_wal(napi_env env, napi_value handle) {
+    js_wal_t* js = NULL;
+    if (napi_get_value_external(env, handle, (void**)&js) != napi_ok || !js) {
+        napi_throw_type_error(env, NULL, "Invalid log handle");
+        return NULL;
+    }
+    if (!js->wal) {
+        napi_throw_error(env, NULL, "Log is closed");
+        return NULL;
+    }
+    return js;
+}
+
+/* walOpen(dir: string, options?: object): handle */
+static napi_value wal_open(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Directory required");
+        return NULL;
+    }
+
+    char dir[4096];
+    size_t dir_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], dir, sizeof(dir), &dir_len));
+
+    zfo_wal_options_t opts = {0};
+    napi_valuetype opt_type = napi_undefined;
+    if (argc > 1) napi_typeof(env, argv[1], &opt_type);
+    if (opt_type == napi_object) {
+        double segment = get_opt_double(env, argv[1], "segmentSize", 0);
+        double interval = get_opt_double(env, argv[1], "syncInterval", 0);
+        double bytes = get_opt_double(env, argv[1], "syncBytes", 0);
+        opts.segment_size = segment > 0 ? (uint64_t)segment : 0;
+        opts.sync_ms = interval > 0 ? (uint32_t)interval : 0;
+        opts.sync_bytes = bytes > 0 ? (uint64_t)bytes : 0;
+    }
+
+    zfo_wal_t* wal;
+    int rc = zfo_wal_open(dir, &opts, &wal);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    js_wal_t* js = calloc(1, sizeof(js_wal_t));
+    napi_value handle;
+    if (!js || napi_create_external(env, js, wal_handle_finalize, NULL, &handle) != napi_ok) {
+        free(js);
+        zfo_wal_close(wal);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    js->wal = wal;
+    return handle;
+}
+
+/* walAppend(handle, data: Buffer): number */
+static napi_value wal_append(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Log and data required");
+        return NULL;
+    }
+    js_wal_t* js = get_js_wal(env, argv[0]);
+    if (!js) return NULL;
+
+    void* data;
+    size_t data_len;
+    NAPI_CALL(napi_get_buffer_info(env, argv[1], &data, &data_len));
+
+    uint64_t seq;
+    int rc = zfo_wal_append(js->wal, data, data_len, &seq);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value result;
+    napi_create_double(env, (double)seq, &result);
+    return result;
+}
+
+typedef int (*wal_op_fn)(zfo_wal_t* wal);
+
+static napi_value wal_call(napi_env env, napi_callback_info info, wal_op_fn op) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_wal_t* js = argc >= 1 ? get_js_wal(env, argv[0]) : NULL;
+    if (!js) {
+        if (argc < 1) napi_throw_type_error(env, NULL, "Log required");
+        return NULL;
+    }
+
+    int rc = op(js->wal);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* walFlush(handle): void */
+static napi_value wal_flush(napi_env env, napi_callback_info info) {
+    return wal_call(env, info, zfo_wal_flush);
+}
+
+/* walSync(handle): void */
+static napi_value wal_sync(napi_env env, napi_callback_info info) {
+    return wal_call(env, info, zfo_wal_sync);
+}
+
+/* walTruncate(handle, beforeSeq: number): void */
+static napi_value wal_truncate(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Log and sequence number required");
+        return NULL;
+    }
+    js_wal_t* js = get_js_wal(env, argv[0]);
+    if (!js) return NULL;
+
+    double before;
+    NAPI_CALL(napi_get_value_double(env, argv[1], &before));
+
+    int rc = zfo_wal_truncate(js->wal, before > 0 ? (uint64_t)before : 0);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* walStats(handle): { nextSeq, writtenSeq, durableSeq, segments, syncs } */
+static napi_value wal_stats(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_wal_t* js = argc >= 1 ? get_js_wal(env, argv[0]) : NULL;
+    if (!js) {
+        if (argc < 1) napi_throw_type_error(env, NULL, "Log required");
+        return NULL;
+    }
+
+    zfo_wal_stats_t stats;
+    zfo_wal_stats(js->wal, &stats);
+
+    napi_value obj;
+    napi_create_object(env, &obj);
+    set_named_double(env, obj, "nextSeq", (double)stats.next_seq);
+    set_named_double(env, obj, "writtenSeq", (double)stats.written_seq);
+    set_named_double(env, obj, "durableSeq", (double)stats.durable_seq);
+    set_named_double(env, obj, "segments", (double)stats.segments);
+    set_named_double(env, obj, "syncs", (double)stats.syncs);
+    return obj;
+}
+
+/* walClose(handle): void */
+static napi_value wal_close(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_wal_t* js = argc >= 1 ? get_js_wal(env, argv[0]) : NULL;
+    if (!js) {
+        if (argc < 1) napi_throw_type_error(env, NULL, "Log required");
+        return NULL;
+    }
+
+    int rc = zfo_wal_close(js->wal);
+    js->wal = NULL;
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+typedef struct {
+    napi_env env;
+    napi_value callback;
+    size_t count;
+    bool failed;                    /* Callback threw */
+} wal_replay_ctx_t;
+
+static bool wal_replay_record(uint64_t seq, const void* data, size_t len, void* userdata) {
+    wal_replay_ctx_t* ctx = userdata;
+    napi_env env = ctx->env;
+
+    napi_value args[2], global, ret;
+    napi_create_double(env, (double)seq, &args[0]);
+    void* copy;
+    if (napi_create_buffer_copy(env, len, data, &copy, &args[1]) != napi_ok) {
+        ctx->failed = true;
+        return false;
+    }
+    napi_get_global(env, &global);
+    if (napi_call_function(env, global, ctx->callback, 2, args, &ret) != napi_ok) {
+        ctx->failed = true;
+        return false;
+    }
+    ctx->count++;
+
+    /* Returning false stops the replay; anything else continues */
+    napi_valuetype type;
+    bool keep_going = true;
+    if (napi_typeof(env, ret, &type) == napi_ok && type == napi_boolean) {
+        napi_get_value_bool(env, ret, &keep_going);
+    }
+    return keep_going;
+}
+
+/* walReplay(dir: string, fromSeq: number, callback: (seq, data) => boolean|void): { count, lastSeq } */
+static napi_value wal_replay(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    napi_valuetype cb_type = napi_undefined;
+    if (argc >= 3) napi_typeof(env, argv[2], &cb_type);
+    if (cb_type != napi_function) {
+        napi_throw_type_error(env, NULL, "Directory, sequence number and callback required");
+        return NULL;
+    }
+
+    char dir[4096];
+    size_t dir_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], dir, sizeof(dir), &dir_len));
+    double from;
+    NAPI_CALL(napi_get_value_double(env, argv[1], &from));
+
+    wal_replay_ctx_t ctx = {env, argv[2], 0, false};
+    uint64_t last_seq;
+    int rc = zfo_wal_replay(dir, from > 0 ? (uint64_t)from : 0, wal_replay_record, &ctx, &last_seq);
+    if (ctx.failed) return NULL;    /* Let the callback's exception propagate */
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value obj;
+    napi_create_object(env, &obj);
+    set_named_double(env, obj, "count", (double)ctx.count);
+    set_named_double(env, obj, "lastSeq", (double)last_seq);
+    return obj;
+}
+
+/* ============================================================
+ * Key-Value Store
+ * ============================================================ */
+
+/*
+ * kvMerge runs on its own thread and holds the store open: a close
+ * issued meanwhile marks the handle closed and the merge's finalizer
+ * does the actual zfo_kv_close.
+ */
+typedef struct {
+    zfo_kv_t* kv;
+    int merges;
+    bool closed;
+} js_kv_t;
+
+typedef struct {
+    js_kv_t* js;
+    int rc;
+    napi_deferred deferred;
+    napi_threadsafe_function tsfn;
+    napi_ref handle_ref;
+    pthread_t thread;
+    bool started;
+} kv_merge_job_t;
+
+static void kv_handle_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)hint;
+    js_kv_t* js = data;
+    if (js->kv) zfo_kv_close(js->kv);
+    free(js);
+}
+
+static js_kv_t* get_js_kv(napi_env env, napi_value handle) {
+    js_kv_t* js = NULL;
+    if (napi_get_value_external(env, handle, (void**)&js) != napi_ok || !js) {
+        napi_throw_type_error(env, NULL, "Invalid store handle");
+        return NULL;
+    }
+    if (js->closed) {
+        napi_throw_error(env, NULL, "Store is closed");
+        return NULL;
+    }
+    return js;
+}
+
+/* A key or value given as a Buffer or a string */
+typedef struct {
+    void* data;
+    size_t len;
+    char* owned;
+} kv_bytes_t;
+
+static bool get_kv_bytes(napi_env env, napi_value value, kv_bytes_t* out) {
+    out->owned = NULL;
+    napi_valuetype type;
+    napi_typeof(env, value, &type);
+    if (type == napi_string) {
+        size_t len;
+        if (napi_get_value_string_utf8(env, value, NULL, 0, &len) != napi_ok) return false;
+        out->owned = malloc(len + 1);
+        if (!out->owned) {
+            napi_throw_error(env, NULL, "Out of memory");
+            return false;
+        }
+        napi_get_value_string_utf8(env, value, out->owned, len + 1, &len);
+        out->data = out->owned;
+        out->len = len;
+        return true;
+    }
+    bool is_buffer = false;
+    napi_is_buffer(env, value, &is_buffer);
+    if (!is_buffer || napi_get_buffer_info(env, value, &out->data, &out->len) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Expected a string or Buffer");
+        return false;
+    }
+    return true;
+}
+
+/* kvOpen(dir: string, options?: object): handle */
+static napi_value kv_open(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Directory required");
+        return NULL;
+    }
+
+    char dir[4096];
+    size_t dir_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], dir, sizeof(dir), &dir_len));
+
+    zfo_kv_options_t opts = {0};
+    napi_valuetype opt_type = napi_undefined;
+    if (argc > 1) napi_typeof(env, argv[1], &opt_type);
+    if (opt_type == napi_object) {
+        double file_size = get_opt_double(env, argv[1], "maxFileSize", 0);
+        double min_bytes = get_opt_double(env, argv[1], "mergeMinBytes", 0);
+        int32_t percent = get_opt_int32(env, argv[1], "mergeDeadPercent", 0);
+        opts.max_file_size = file_size > 0 ? (uint64_t)file_size : 0;
+        opts.merge_min_bytes = min_bytes > 0 ? (uint64_t)min_bytes : 0;
+        opts.merge_dead_percent = percent > 0 ? (uint32_t)percent : 0;
+        if (get_opt_bool(env, argv[1], "sync", false)) opts.flags |= ZFO_KV_SYNC;
+        if (!get_opt_bool(env, argv[1], "autoMerge", true)) opts.flags |= ZFO_KV_NO_AUTO_MERGE;
+    }
+
+    zfo_kv_t* kv;
+    int rc = zfo_kv_open(dir, &opts, &kv);
+    if (rc == ZFO_ERR_BUSY) {
+        napi_throw_error(env, NULL, "Store is already open");
+        return NULL;
+    }
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    js_kv_t* js = calloc(1, sizeof(js_kv_t));
+    napi_value handle;
+    if (!js || napi_create_external(env, js, kv_handle_finalize, NULL, &handle) != napi_ok) {
+        free(js);
+        zfo_kv_close(kv);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    js->kv = kv;
+    return handle;
+}
+
+/* kvGet(handle, key: string | Buffer): Buffer | null */
+static napi_value kv_get(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Store and key required");
+        return NULL;
+    }
+    js_kv_t* js = get_js_kv(env, argv[0]);
+    kv_bytes_t key;
+    if (!js || !get_kv_bytes(env, argv[1], &key)) return NULL;
+
+    void* value;
+    size_t len;
+    int rc = zfo_kv_get(js->kv, key.data, key.len, &value, &len);
+    free(key.owned);
+
+    napi_value result;
+    if (rc == ZFO_ERR_NOT_FOUND) {
+        napi_get_null(env, &result);
+        return result;
+    }
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return create_owned_buffer(env, value, len, free_buffer_data, NULL);
+}
+
+/* kvPut(handle, key: string | Buffer, value: string | Buffer): void */
+static napi_value kv_put(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 3) {
+        napi_throw_type_error(env, NULL, "Store, key and value required");
+        return NULL;
+    }
+    js_kv_t* js = get_js_kv(env, argv[0]);
+    kv_bytes_t key, value;
+    if (!js || !get_kv_bytes(env, argv[1], &key)) return NULL;
+    if (!get_kv_bytes(env, argv[2], &value)) {
+        free(key.owned);
+        return NULL;
+    }
+
+    int rc = zfo_kv_put(js->kv, key.data, key.len, value.data, value.len);
+    free(key.owned);
+    free(value.owned);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* kvDelete(handle, key): boolean (false if it wasn't stored) */
+static napi_value kv_delete(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Store and key required");
+        return NULL;
+    }
+    js_kv_t* js = get_js_kv(env, argv[0]);
+    kv_bytes_t key;
+    if (!js || !get_kv_bytes(env, argv[1], &key)) return NULL;
+
+    int rc = zfo_kv_delete(js->kv, key.data, key.len);
+    free(key.owned);
+    if (rc != ZFO_OK && rc != ZFO_ERR_NOT_FOUND) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value result;
+    napi_get_boolean(env, rc == ZFO_OK, &result);
+    return result;
+}
+
+/* kvHas(handle, key): boolean */
+static napi_value kv_has(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Store and key required");
+        return NULL;
+    }
+    js_kv_t* js = get_js_kv(env, argv[0]);
+    kv_bytes_t key;
+    if (!js || !get_kv_bytes(env, argv[1], &key)) return NULL;
+
+    bool found = zfo_kv_has(js->kv, key.data, key.len);
+    free(key.owned);
+
+    napi_value result;
+    napi_get_boolean(env, found, &result);
+    return result;
+}
+
+typedef struct {
+    napi_env env;
+    napi_value array;
+    uint32_t count;
+    bool as_buffers;
+} kv_keys_ctx_t;
+
+static bool kv_push_key(const void* key, size_t len, void* userdata) {
+    kv_keys_ctx_t* c = userdata;
+    napi_value val;
+    napi_status status = c->as_buffers
+        ? napi_create_buffer_copy(c->env, len, key, NULL, &val)
+        : napi_create_string_utf8(c->env, key, len, &val);
+    if (status != napi_ok) return false;
+    napi_set_element(c->env, c->array, c->count++, val);
+    return true;
+}
+
+/* kvKeys(handle, asBuffers?: boolean): Array<string | Buffer> */
+static napi_value kv_keys(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_kv_t* js = argc >= 1 ? get_js_kv(env, argv[0]) : NULL;
+    if (!js) return NULL;
+
+    kv_keys_ctx_t c = { env, NULL, 0, false };
+    if (argc > 1) napi_get_value_bool(env, argv[1], &c.as_buffers);
+    NAPI_CALL(napi_create_array(env, &c.array));
+    zfo_kv_keys(js->kv, kv_push_key, &c);
+    return c.array;
+}
+
+/* kvSync(handle): void */
+static napi_value kv_sync(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_kv_t* js = argc >= 1 ? get_js_kv(env, argv[0]) : NULL;
+    if (!js) return NULL;
+
+    int rc = zfo_kv_sync(js->kv);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* kvStats(handle): {keys, files, totalBytes, liveBytes, merges, merging} */
+static napi_value kv_stats(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_kv_t* js = argc >= 1 ? get_js_kv(env, argv[0]) : NULL;
+    if (!js) return NULL;
+
+    zfo_kv_stats_t st;
+    zfo_kv_stats(js->kv, &st);
+
+    napi_value obj, merging;
+    napi_create_object(env, &obj);
+    set_named_double(env, obj, "keys", (double)st.keys);
+    set_named_double(env, obj, "files", (double)st.files);
+    set_named_double(env, obj, "totalBytes", (double)st.total_bytes);
+    set_named_double(env, obj, "liveBytes", (double)st.live_bytes);
+    set_named_double(env, obj, "merges", (double)st.merges);
+    napi_get_boolean(env, st.merging, &merging);
+    napi_set_named_property(env, obj, "merging", merging);
+    return obj;
+}
+
+static void* kv_merge_thread(void* arg) {
+    kv_merge_job_t* job = arg;
+    job->rc = zfo_kv_merge(job->js->kv);
+    napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+    return NULL;
+}
+
+static void kv_merge_call_js(napi_env env, napi_value callback, void* context, void* data) {
+    (void)env;
+    (void)callback;
+    (void)context;
+    (void)data;
+}
+
+static void kv_merge_finalize(napi_env env, void* data, void* hint) {
+    (void)hint;
+    kv_merge_job_t* job = data;
+    if (job->started) pthread_join(job->thread, NULL);
+
+    js_kv_t* js = job->js;
+    int close_rc = ZFO_OK;
+    if (--js->merges == 0 && js->closed && js->kv) {
+        close_rc = zfo_kv_close(js->kv);
+        js->kv = NULL;
+    }
+
+    int rc = job->rc != ZFO_OK ? job->rc : close_rc;
+    if (rc == ZFO_OK) {
+        napi_value undefined;
+        napi_get_undefined(env, &undefined);
+        napi_resolve_deferred(env, job->deferred, undefined);
+    } else {
+        napi_value msg, err;
+        const char* text = rc == ZFO_ERR_BUSY ? "A merge is already running" : zfo_strerror(rc);
+        napi_create_string_utf8(env, text, NAPI_AUTO_LENGTH, &msg);
+        napi_create_error(env, NULL, msg, &err);
+        napi_reject_deferred(env, job->deferred, err);
+    }
+    napi_delete_reference(env, job->handle_ref);
+    free(job);
+}
+
+/* kvMerge(handle): Promise<void> */
+static napi_value kv_merge(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_kv_t* js = argc >= 1 ? get_js_kv(env, argv[0]) : NULL;
+    if (!js) return NULL;
+
+    kv_merge_job_t* job = calloc(1, sizeof(kv_merge_job_t));
+    if (!job) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    job->js = js;
+    /* The handle reference keeps js alive until the merge settles */
+    if (napi_create_reference(env, argv[0], 1, &job->handle_ref) != napi_ok) {
+        free(job);
+        napi_throw_error(env, NULL, "Failed to start merge");
+        return NULL;
+    }
+
+    napi_value promise, name;
+    napi_create_string_utf8(env, "pulsar.kvMerge", NAPI_AUTO_LENGTH, &name);
+    if (napi_create_promise(env, &job->deferred, &promise) != napi_ok ||
+        napi_create_threadsafe_function(env, NULL, NULL, name, 1, 1,
+                                        job, kv_merge_finalize, job, kv_merge_call_js,
+                                        &job->tsfn) != napi_ok) {
+        napi_delete_reference(env, job->handle_ref);
+        free(job);
+        napi_throw_error(env, NULL, "Failed to start merge");
+        return NULL;
+    }
+
+    js->merges++;
+    if (pthread_create(&job->thread, NULL, kv_merge_thread, job) != 0) {
+        /* The finalizer rejects the promise once the tsfn is released */
+        job->rc = ZFO_ERR_UNKNOWN;
+        napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+        return promise;
+    }
+    job->started = true;
+
+    return promise;
+}
+
+/* kvClose(handle): void */
+static napi_value kv_close(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_kv_t* js = argc >= 1 ? get_js_kv(env, argv[0]) : NULL;
+    if (!js) return NULL;
+
+    js->closed = true;
+    if (js->merges > 0) {
+        /* The last merge to finish closes the store */
+        napi_value undefined;
+        napi_get_undefined(env, &undefined);
+        return undefined;
+    }
+
+    int rc = zfo_kv_close(js->kv);
+    js->kv = NULL;
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ============================================================
+ * File Handles
+ * ============================================================ */
+
+typedef struct {
+    zfo_file_t* file;
+} js_file_t;
+
+static void file_handle_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)hint;
+    js_file_t* js = data;
+    if (js->file) zfo_close(js->file);
+    free(js);
+}
+
+static js_file_t* get_js_file(napi_env env, napi_value handle) {
+    js_file_t* js = NULL;
+    if (napi_get_value_external(env, handle, (void**)&js) != napi_ok || !js) {
+        napi_throw_type_error(env, NULL, "Invalid file handle");
+        return NULL;
+    }
+    if (!js->file) {
+        napi_throw_error(env, NULL, "File is closed");
+        return NULL;
+    }
+    return js;
+}
+
+static napi_value get_undefined_value(napi_env env) {
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* Returns the byte count, or throws for a negative zfo result */
+static napi_value io_result(napi_env env, zfo_off_t n) {
+    if (n < 0) {
+        throw_zfo_error(env, (int)n);
+        return NULL;
+    }
+    napi_value result;
+    napi_create_double(env, (double)n, &result);
+    return result;
+}
+
+/* Position argument: missing, null or negative means the file position */
+static zfo_off_t get_position(napi_env env, napi_value val) {
+    napi_valuetype type = napi_undefined;
+    napi_typeof(env, val, &type);
+    if (type != napi_number) return -1;
+    double pos;
+    napi_get_value_double(env, val, &pos);
+    return pos < 0 ? -1 : (zfo_off_t)pos;
+}
+
+/* fileOpen(path: string, flags: number, mode?: number): handle */
+static napi_value file_open(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Path and flags required");
+        return NULL;
+    }
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+
+    int32_t flags;
+    uint32_t mode = 0644;
+    NAPI_CALL(napi_get_value_int32(env, argv[1], &flags));
+    if (argc > 2) napi_get_value_uint32(env, argv[2], &mode);
+
+    zfo_file_t* file = zfo_open(path, flags, mode);
+    if (!file) {
+        napi_throw_error(env, NULL, get_error_string());
+        return NULL;
+    }
+
+    js_file_t* js = calloc(1, sizeof(js_file_t));
+    napi_value handle;
+    if (!js || napi_create_external(env, js, file_handle_finalize, NULL, &handle) != napi_ok) {
+        free(js);
+        zfo_close(file);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    js->file = file;
+    return handle;
+}
+
+/* Resolve (buffer, offset, length) to a byte range, throwing if out of bounds */
+static bool get_buffer_range(napi_env env, size_t argc, napi_value* argv, char** data, size_t* len) {
+    void* base;
+    size_t size;
+    if (napi_get_buffer_info(env, argv[1], &base, &size) != napi_ok) {
+        napi_throw_type_error(env, NULL, "Buffer required");
+        return false;
+    }
+
+    double offset = 0, length = -1;
+    if (argc > 2) napi_get_value_double(env, argv[2], &offset);
+    if (argc > 3) napi_get_value_double(env, argv[3], &length);
+    if (length < 0) length = (double)size - offset;
+    if (offset < 0 || length < 0 || offset + length > (double)size) {
+        napi_throw_range_error(env, NULL, "Offset and length must lie within the buffer");
+        return false;
+    }
+    *data = (char*)base + (size_t)offset;
+    *len = (size_t)length;
+    return true;
+}
+
+/* fileRead(handle, buffer: Buffer, offset?, length?, position?): number */
+static napi_value file_read(napi_env env, napi_callback_info info) {
+    size_t argc = 5;
+    napi_value argv[5];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "File and buffer required");
+        return NULL;
+    }
+    js_file_t* js = get_js_file(env, argv[0]);
+    char* data;
+    size_t len;
+    if (!js || !get_buffer_range(env, argc, argv, &data, &len)) return NULL;
+
+    zfo_off_t pos = argc > 4 ? get_position(env, argv[4]) : -1;
+    if (len == 0) return io_result(env, 0);
+    return io_result(env, pos < 0 ? zfo_read(js->file, data, len) : zfo_pread(js->file, data, len, pos));
+}
+
+/* fileWrite(handle, buffer: Buffer, offset?, length?, position?): number */
+static napi_value file_write(napi_env env, napi_callback_info info) {
+    size_t argc = 5;
+    napi_value argv[5];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "File and buffer required");
+        return NULL;
+    }
+    js_file_t* js = get_js_file(env, argv[0]);
+    char* data;
+    size_t len;
+    if (!js || !get_buffer_range(env, argc, argv, &data, &len)) return NULL;
+
+    zfo_off_t pos = argc > 4 ? get_position(env, argv[4]) : -1;
+    if (len == 0) return io_result(env, 0);
+    return io_result(env, pos < 0 ? zfo_write(js->file, data, len) : zfo_pwrite(js->file, data, len, pos));
+}
+
+#define FILE_IOV_MAX 1024
+
+static napi_value file_vectored(napi_env env, napi_callback_info info, bool write) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    bool is_array = false;
+    if (argc >= 2) napi_is_array(env, argv[1], &is_array);
+    if (!is_array) {
+        napi_throw_type_error(env, NULL, "File and array of Buffers required");
+        return NULL;
+    }
+    js_file_t* js = get_js_file(env, argv[0]);
+    if (!js) return NULL;
+
+    uint32_t count;
+    NAPI_CALL(napi_get_array_length(env, argv[1], &count));
+    if (count > FILE_IOV_MAX) {
+        napi_throw_range_error(env, NULL, "At most 1024 buffers per call");
+        return NULL;
+    }
+
+    zfo_iovec_t iov[FILE_IOV_MAX];
+    for (uint32_t i = 0; i < count; i++) {
+        napi_value item;
+        if (napi_get_element(env, argv[1], i, &item) != napi_ok ||
+            napi_get_buffer_info(env, item, &iov[i].base, &iov[i].len) != napi_ok) {
+            napi_throw_type_error(env, NULL, "Array of Buffers required");
+            return NULL;
+        }
+    }
+
+    zfo_off_t pos = argc > 2 ? get_position(env, argv[2]) : -1;
+    return io_result(env, write ? zfo_writev(js->file, iov, (int)count, pos)
+                                : zfo_readv(js->file, iov, (int)count, pos));
+}
+
+/* fileReadv(handle, buffers: Buffer[], position?): number */
+static napi_value file_readv(napi_env env, napi_callback_info info) {
+    return file_vectored(env, info, false);
+}
+
+/* fileWritev(handle, buffers: Buffer[], position?): number */
+static napi_value file_writev(napi_env env, napi_callback_info info) {
+    return file_vectored(env, info, true);
+}
+
+/* fileWriteBuffered(handle, data: Buffer): void */
+static napi_value file_write_buffered(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "File and data required");
+        return NULL;
+    }
+    js_file_t* js = get_js_file(env, argv[0]);
+    if (!js) return NULL;
+
+    void* data;
+    size_t len;
+    NAPI_CALL(napi_get_buffer_info(env, argv[1], &data, &len));
+
+    int rc = zfo_write_buffered(js->file, data, len);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return get_undefined_value(env);
+}
+
+/* fileSetBuffer(handle, size: number): void */
+static napi_value file_set_buffer(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "File and size required");
+        return NULL;
+    }
+    js_file_t* js = get_js_file(env, argv[0]);
+    if (!js) return NULL;
+
+    double size;
+    NAPI_CALL(napi_get_value_double(env, argv[1], &size));
+
+    int rc = zfo_set_write_buffer(js->file, size > 0 ? (size_t)size : 0);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return get_undefined_value(env);
+}
+
+typedef int (*file_op_fn)(zfo_file_t* file);
+
+static napi_value file_call(napi_env env, napi_callback_info info, file_op_fn op) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_file_t* js = argc >= 1 ? get_js_file(env, argv[0]) : NULL;
+    if (!js) {
+        if (argc < 1) napi_throw_type_error(env, NULL, "File required");
+        return NULL;
+    }
+
+    int rc = op(js->file);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return get_undefined_value(env);
+}
+
+/* fileFlush(handle): void */
+static napi_value file_flush(napi_env env, napi_callback_info info) {
+    return file_call(env, info, zfo_flush);
+}
+
+/* fileSync(handle): void */
+static napi_value file_sync(napi_env env, napi_callback_info info) {
+    return file_call(env, info, zfo_sync);
+}
+
+/* fileDatasync(handle): void */
+static napi_value file_datasync(napi_env env, napi_callback_info info) {
+    return file_call(env, info, zfo_datasync);
+}
+
+/* fileSeek(handle, offset: number, whence: number): number */
+static napi_value file_seek(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "File and offset required");
+        return NULL;
+    }
+    js_file_t* js = get_js_file(env, argv[0]);
+    if (!js) return NULL;
+
+    double offset;
+    int32_t whence = SEEK_SET;
+    NAPI_CALL(napi_get_value_double(env, argv[1], &offset));
+    if (argc > 2) napi_get_value_int32(env, argv[2], &whence);
+    if (whence != SEEK_SET && whence != SEEK_CUR && whence != SEEK_END) {
+        napi_throw_range_error(env, NULL, "Invalid whence");
+        return NULL;
+    }
+    return io_result(env, zfo_seek(js->file, (zfo_off_t)offset, whence));
+}
+
+/* fileStat(handle): StatResult */
+static napi_value file_stat(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_file_t* js = argc >= 1 ? get_js_file(env, argv[0]) : NULL;
+    if (!js) {
+        if (argc < 1) napi_throw_type_error(env, NULL, "File required");
+        return NULL;
+    }
+
+    zfo_stat_t st;
+    int rc = zfo_fstat(js->file, &st);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return create_stat_object(env, &st);
+}
+
+/* fileTruncate(handle, size: number): void */
+static napi_value file_truncate(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_file_t* js = argc >= 1 ? get_js_file(env, argv[0]) : NULL;
+    if (!js) {
+        if (argc < 1) napi_throw_type_error(env, NULL, "File required");
+        return NULL;
+    }
+
+    double size = 0;
+    if (argc > 1) napi_get_value_double(env, argv[1], &size);
+    if (size < 0) {
+        napi_throw_range_error(env, NULL, "Size must be non-negative");
+        return NULL;
+    }
+
+    int rc = zfo_truncate(js->file, (zfo_off_t)size);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return get_undefined_value(env);
+}
+
+/* fileAdvise(handle, advice: number, offset?: number, length?: number): void */
+static napi_value file_advise(napi_env env, napi_callback_info info) {
+    size_t argc = 4;
+    napi_value argv[4];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "File and advice required");
+        return NULL;
+    }
+    js_file_t* js = get_js_file(env, argv[0]);
+    if (!js) return NULL;
+
+    int32_t advice;
+    double offset = 0, length = 0;
+    NAPI_CALL(napi_get_value_int32(env, argv[1], &advice));
+    if (argc > 2) napi_get_value_double(env, argv[2], &offset);
+    if (argc > 3) napi_get_value_double(env, argv[3], &length);
+
+    int rc = zfo_advise(js->file, (zfo_off_t)offset, (zfo_off_t)length, (zfo_advice_t)advice);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return get_undefined_value(env);
+}
+
+/* fileAllocate(handle, offset: number, length: number, options?: {keepSize, punchHole}): void */
+static napi_value file_allocate(napi_env env, napi_callback_info info) {
+    size_t argc = 4;
+    napi_value argv[4];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 3) {
+        napi_throw_type_error(env, NULL, "File, offset and length required");
+        return NULL;
+    }
+    js_file_t* js = get_js_file(env, argv[0]);
+    if (!js) return NULL;
+
+    double offset, length;
+    NAPI_CALL(napi_get_value_double(env, argv[1], &offset));
+    NAPI_CALL(napi_get_value_double(env, argv[2], &length));
+
+    int flags = 0;
+    napi_valuetype opt_type = napi_undefined;
+    if (argc > 3) napi_typeof(env, argv[3], &opt_type);
+    if (opt_type == napi_object) {
+        if (get_opt_bool(env, argv[3], "keepSize", false)) flags |= ZFO_ALLOC_KEEP_SIZE;
+        if (get_opt_bool(env, argv[3], "punchHole", false)) flags |= ZFO_ALLOC_PUNCH_HOLE;
+    }
+
+    int rc = zfo_allocate(js->file, (zfo_off_t)offset, (zfo_off_t)length, flags);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return get_undefined_value(env);
+}
+
+/* fileLock(handle, offset: number, length: number, flags: number): boolean */
+static napi_value file_lock(napi_env env, napi_callback_info info) {
+    size_t argc = 4;
+    napi_value argv[4];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_file_t* js = argc >= 1 ? get_js_file(env, argv[0]) : NULL;
+    if (!js) {
+        if (argc < 1) napi_throw_type_error(env, NULL, "File required");
+        return NULL;
+    }
+
+    double offset = 0, length = 0;
+    int32_t flags = ZFO_LOCK_EXCLUSIVE;
+    if (argc > 1) napi_get_value_double(env, argv[1], &offset);
+    if (argc > 2) napi_get_value_double(env, argv[2], &length);
+    if (argc > 3) napi_get_value_int32(env, argv[3], &flags);
+
+    int rc = zfo_lock(js->file, (zfo_off_t)offset, (zfo_off_t)length, flags);
+    if (rc != ZFO_OK && rc != ZFO_ERR_BUSY) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value result;
+    napi_get_boolean(env, rc == ZFO_OK, &result);
+    return result;
+}
+
+/* fileUnlock(handle, offset: number, length: number): void */
+static napi_value file_unlock(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_file_t* js = argc >= 1 ? get_js_file(env, argv[0]) : NULL;
+    if (!js) {
+        if (argc < 1) napi_throw_type_error(env, NULL, "File required");
+        return NULL;
+    }
+
+    double offset = 0, length = 0;
+    if (argc > 1) napi_get_value_double(env, argv[1], &offset);
+    if (argc > 2) napi_get_value_double(env, argv[2], &length);
+
+    int rc = zfo_unlock(js->file, (zfo_off_t)offset, (zfo_off_t)length);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return get_undefined_value(env);
+}
+
+/* fileClose(handle): void */
+static napi_value file_close(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_file_t* js = argc >= 1 ? get_js_file(env, argv[0]) : NULL;
+    if (!js) {
+        if (argc < 1) napi_throw_type_error(env, NULL, "File required");
+        return NULL;
+    }
+
+    int rc = zfo_close(js->file);
+    js->file = NULL;
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return get_undefined_value(env);
+}
+
+/* ============================================================
+ * Chunked Reader
+ * ============================================================ */
+
+/*
+ * Chunk Buffers point straight into the reader's ring, so the reader
+ * is refcounted: the handle holds one reference and every live chunk
+ * Buffer another. readerNext resolves from the reader thread's notify
+ * through a threadsafe function, which is only ref'd while a call is
+ * pending so an idle reader doesn't keep the process alive.
+ */
+typedef struct {
+    zfo_reader_t* reader;
+    int refs;
+    bool closed;
+    bool hashing;
+    napi_threadsafe_function tsfn;
+    napi_deferred pending;
+} js_reader_t;
+
+typedef struct {
+    js_reader_t* js;
+    uint64_t seq;
+} chunk_hint_t;
+
+static void js_reader_unref(js_reader_t* js) {
+    if (--js->refs > 0) return;
+    zfo_reader_close(js->reader);
+    free(js);
+}
+
+/* Stop the thread and drop the tsfn; chunk Buffers stay readable */
+static void js_reader_shutdown(napi_env env, js_reader_t* js) {
+    if (js->closed) return;
+    js->closed = true;
+    zfo_reader_stop(js->reader);
+    if (js->tsfn) {
+        napi_release_threadsafe_function(js->tsfn, napi_tsfn_abort);
+        js->tsfn = NULL;
+    }
+    if (js->pending) {
+        napi_value null_val;
+        napi_get_null(env, &null_val);
+        napi_resolve_deferred(env, js->pending, null_val);
+        js->pending = NULL;
+    }
+}
+
+static void chunk_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)data;
+    chunk_hint_t* h = hint;
+    zfo_reader_release(h->js->reader, h->seq);
+    js_reader_unref(h->js);
+    free(h);
+}
+
+static void reader_handle_finalize(napi_env env, void* data, void* hint) {
+    (void)hint;
+    js_reader_t* js = data;
+    js_reader_shutdown(env, js);
+    js_reader_unref(js);
+}
+
+static js_reader_t* get_js_reader(napi_env env, napi_value handle) {
+    js_reader_t* js = NULL;
+    if (napi_get_value_external(env, handle, (void**)&js) != napi_ok || !js) {
+        napi_throw_type_error(env, NULL, "Invalid reader handle");
+        return NULL;
+    }
+    if (js->closed) {
+        napi_throw_error(env, NULL, "Reader is closed");
+        return NULL;
+    }
+    return js;
+}
+
+/* { data, offset, seq, hash } or null at end of stream */
+static napi_value create_chunk(napi_env env, js_reader_t* js, const zfo_chunk_t* chunk) {
+    napi_value obj, val;
+    if (!chunk->data) {
+        napi_get_null(env, &obj);
+        return obj;
+    }
+
+    chunk_hint_t* h = malloc(sizeof(chunk_hint_t));
+    if (!h) {
+        zfo_reader_release(js->reader, chunk->seq);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    h->js = js;
+    h->seq = chunk->seq;
+    js->refs++;
+
+    napi_value data = create_owned_buffer(env, (void*)chunk->data, chunk->len, chunk_finalize, h);
+    if (!data) return NULL;
+
+    napi_create_object(env, &obj);
+    napi_set_named_property(env, obj, "data", data);
+    set_named_double(env, obj, "offset", (double)chunk->offset);
+    set_named_double(env, obj, "seq", (double)chunk->seq);
+    if (js->hashing) {
+        char hex[17];
+        snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)chunk->hash);
+        napi_create_string_utf8(env, hex, 16, &val);
+    } else {
+        napi_get_null(env, &val);
+    }
+    napi_set_named_property(env, obj, "hash", val);
+    return obj;
+}
+
+static const char* reader_strerror(int rc) {
+    return rc == ZFO_ERR_BUSY ? "Every buffer is held; release a chunk first" : zfo_strerror(rc);
+}
+
+static void reader_settle(napi_env env, js_reader_t* js, int rc, const zfo_chunk_t* chunk) {
+    napi_deferred deferred = js->pending;
+    js->pending = NULL;
+    if (js->tsfn) napi_unref_threadsafe_function(env, js->tsfn);
+
+    if (rc != ZFO_OK) {
+        napi_value msg, err;
+        napi_create_string_utf8(env, reader_strerror(rc), NAPI_AUTO_LENGTH, &msg);
+        napi_create_error(env, NULL, msg, &err);
+        napi_reject_deferred(env, deferred, err);
+        return;
+    }
+
+    napi_value result = create_chunk(env, js, chunk);
+    if (!result) {
+        napi_value err;
+        napi_get_and_clear_last_exception(env, &err);
+        napi_reject_deferred(env, deferred, err);
+        return;
+    }
+    napi_resolve_deferred(env, deferred, result);
+}
+
+static void reader_call_js(napi_env env, napi_value callback, void* context, void* data) {
+    (void)callback;
+    (void)data;
+    js_reader_t* js = context;
+    if (!env || !js->pending || js->closed) return;
+
+    zfo_chunk_t chunk;
+    int rc = zfo_reader_next(js->reader, &chunk, false);
+    if (rc == ZFO_ERR_TIMEOUT) return;    /* Notified again once ready */
+    reader_settle(env, js, rc, &chunk);
+}
+
+static void reader_notify(void* userdata) {
+    js_reader_t* js = userdata;
+    napi_call_threadsafe_function(js->tsfn, NULL, napi_tsfn_nonblocking);
+}
+
+/* readerOpen(path: string, options?: object): handle */
+static napi_value reader_open(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Path required");
+        return NULL;
+    }
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+
+    zfo_reader_options_t opts = {0};
+    napi_valuetype opt_type = napi_undefined;
+    if (argc > 1) napi_typeof(env, argv[1], &opt_type);
+    if (opt_type == napi_object) {
+        double chunk = get_opt_double(env, argv[1], "chunkSize", 0);
+        double offset = get_opt_double(env, argv[1], "offset", 0);
+        double length = get_opt_double(env, argv[1], "length", 0);
+        opts.chunk_size = chunk > 0 ? (size_t)chunk : 0;
+        opts.slots = get_opt_int32(env, argv[1], "buffers", 0);
+        opts.offset = offset > 0 ? (zfo_off_t)offset : 0;
+        opts.length = length > 0 ? (zfo_off_t)length : 0;
+        if (get_opt_bool(env, argv[1], "hash", false)) opts.flags |= ZFO_READER_HASH;
+        if (get_opt_bool(env, argv[1], "dropCache", false)) opts.flags |= ZFO_READER_DROP_CACHE;
+
+        char* codec = get_opt_string_dup(env, argv[1], "decompress");
+        if (codec) {
+            if (strcmp(codec, "zstd") == 0) opts.codec = ZFO_CODEC_ZSTD;
+            else if (strcmp(codec, "lz4") == 0) opts.codec = ZFO_CODEC_LZ4;
+            free(codec);
+            if (opts.codec == ZFO_CODEC_NONE) {
+                napi_throw_type_error(env, NULL, "decompress must be 'zstd' or 'lz4'");
+                return NULL;
+            }
+        }
+    }
+
+    js_reader_t* js = calloc(1, sizeof(js_reader_t));
+    if (!js) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    js->refs = 1;
+    js->hashing = (opts.flags & ZFO_READER_HASH) != 0;
+
+    napi_value name;
+    napi_create_string_utf8(env, "pulsar.reader", NAPI_AUTO_LENGTH, &name);
+    if (napi_create_threadsafe_function(env, NULL, NULL, name, 0, 1, NULL, NULL, js,
+                                        reader_call_js, &js->tsfn) != napi_ok) {
+        free(js);
+        napi_throw_error(env, NULL, "Failed to create reader");
+        return NULL;
+    }
+    napi_unref_threadsafe_function(env, js->tsfn);
+
+    opts.notify = reader_notify;
+    opts.userdata = js;
+    int rc = zfo_reader_open(path, &opts, &js->reader);
+    if (rc != ZFO_OK) {
+        napi_release_threadsafe_function(js->tsfn, napi_tsfn_abort);
+        free(js);
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value handle;
+    if (napi_create_external(env, js, reader_handle_finalize, NULL, &handle) != napi_ok) {
+        js_reader_shutdown(env, js);
+        js_reader_unref(js);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    return handle;
+}
+
+/* readerNext(handle): Promise<Chunk | null> */
+static napi_value reader_next(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_reader_t* js = argc >= 1 ? get_js_reader(env, argv[0]) : NULL;
+    if (!js) {
+        if (argc < 1) napi_throw_type_error(env, NULL, "Reader required");
+        return NULL;
+    }
+    if (js->pending) {
+        napi_throw_error(env, NULL, "A read is already pending");
+        return NULL;
+    }
+
+    napi_value promise;
+    NAPI_CALL(napi_create_promise(env, &js->pending, &promise));
+
+    zfo_chunk_t chunk;
+    int rc = zfo_reader_next(js->reader, &chunk, false);
+    if (rc == ZFO_ERR_TIMEOUT) {
+        napi_ref_threadsafe_function(env, js->tsfn);
+        return promise;
+    }
+    reader_settle(env, js, rc, &chunk);
+    return promise;
+}
+
+/* readerNextSync(handle): Chunk | null */
+static napi_value reader_next_sync(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_reader_t* js = argc >= 1 ? get_js_reader(env, argv[0]) : NULL;
+    if (!js) {
+        if (argc < 1) napi_throw_type_error(env, NULL, "Reader required");
+        return NULL;
+    }
+    if (js->pending) {
+        napi_throw_error(env, NULL, "A read is already pending");
+        return NULL;
+    }
+
+    zfo_chunk_t chunk;
+    int rc = zfo_reader_next(js->reader, &chunk, true);
+    if (rc != ZFO_OK) {
+        napi_throw_error(env, NULL, reader_strerror(rc));
+        return NULL;
+    }
+    return create_chunk(env, js, &chunk);
+}
+
+/* readerRelease(handle, seq: number): void */
+static napi_value reader_release(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Reader and sequence number required");
+        return NULL;
+    }
+    js_reader_t* js = NULL;
+    if (napi_get_value_external(env, argv[0], (void**)&js) != napi_ok || !js) {
+        napi_throw_type_error(env, NULL, "Invalid reader handle");
+        return NULL;
+    }
+
+    double seq;
+    NAPI_CALL(napi_get_value_double(env, argv[1], &seq));
+    if (seq >= 0) zfo_reader_release(js->reader, (uint64_t)seq);
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* readerInfo(handle): { bytesRead, hash } */
+static napi_value reader_info(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_reader_t* js = NULL;
+    if (argc < 1 || napi_get_value_external(env, argv[0], (void**)&js) != napi_ok || !js) {
+        napi_throw_type_error(env, NULL, "Invalid reader handle");
+        return NULL;
+    }
+
+    napi_value obj, val;
+    napi_create_object(env, &obj);
+    set_named_double(env, obj, "bytesRead", (double)zfo_reader_bytes_read(js->reader));
+    if (js->hashing) {
+        char hex[17];
+        snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)zfo_reader_hash(js->reader));
+        napi_create_string_utf8(env, hex, 16, &val);
+    } else {
+        napi_get_null(env, &val);
+    }
+    napi_set_named_property(env, obj, "hash", val);
+    return obj;
+}
+
+/* readerClose(handle): void */
+static napi_value reader_close(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_reader_t* js = NULL;
+    if (argc < 1 || napi_get_value_external(env, argv[0], (void**)&js) != napi_ok || !js) {
+        napi_throw_type_error(env, NULL, "Invalid reader handle");
+        return NULL;
+    }
+    js_reader_shutdown(env, js);
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ============================================================
+ * Content Cache
+ * ============================================================ */
+
+/*
+ * Each cached blob is wrapped in one Buffer, held by a strong reference
+ * in blob->user for as long as the blob stays cached, so every hit
+ * returns that same object. The Buffer holds its own blob reference,
+ * so an evicted blob lives on until JS drops the Buffer.
+ */
+typedef struct {
+    zfo_cache_t* cache;
+    napi_env env;
+} js_cache_t;
+
+static void cache_release_user(zfo_cache_blob_t* blob, void* userdata) {
+    js_cache_t* js = userdata;
+    napi_delete_reference(js->env, (napi_ref)blob->user);
+}
+
+static void cache_buffer_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)data;
+    zfo_cache_blob_release(hint);
+}
+
+static void cache_handle_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)hint;
+    js_cache_t* js = data;
+    zfo_cache_destroy(js->cache);
+    free(js);
+}
+
+static js_cache_t* get_js_cache(napi_env env, napi_value handle) {
+    js_cache_t* js = NULL;
+    if (napi_get_value_external(env, handle, (void**)&js) != napi_ok || !js) {
+        napi_throw_type_error(env, NULL, "Invalid cache handle");
+        return NULL;
+    }
+    if (!js->cache) {
+        napi_throw_error(env, NULL, "Cache is closed");
+        return NULL;
+    }
+    return js;
+}
+
+/* cacheCreate(options?: {maxBytes?, maxEntry?, zstdLevel?, validate?}): handle */
+static napi_value cache_create(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    zfo_cache_options_t opts = {0};
+    napi_valuetype opt_type = napi_undefined;
+    if (argc > 0) napi_typeof(env, argv[0], &opt_type);
+    if (opt_type == napi_object) {
+        double max_bytes = get_opt_double(env, argv[0], "maxBytes", 0);
+        double max_entry = get_opt_double(env, argv[0], "maxEntry", 0);
+        opts.max_bytes = max_bytes > 0 ? (size_t)max_bytes : 0;
+        opts.max_entry = max_entry > 0 ? (size_t)max_entry : 0;
+        opts.zstd_level = get_opt_int32(env, argv[0], "zstdLevel", 0);
+
+        char* validate = get_opt_string_dup(env, argv[0], "validate");
+        if (validate) {
+            bool none = strcmp(validate, "none") == 0;
+            bool known = none || strcmp(validate, "stat") == 0;
+            free(validate);
+            if (!known) {
+                napi_throw_type_error(env, NULL, "validate must be 'stat' or 'none'");
+                return NULL;
+            }
+            if (none) opts.flags |= ZFO_CACHE_NO_VALIDATE;
+        }
+    }
+
+    js_cache_t* js = calloc(1, sizeof(js_cache_t));
+    if (!js) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    js->env = env;
+    opts.release = cache_release_user;
+    opts.userdata = js;
+    js->cache = zfo_cache_create(&opts);
+    if (!js->cache) {
+        free(js);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+
+    napi_value handle;
+    if (napi_create_external(env, js, cache_handle_finalize, NULL, &handle) != napi_ok) {
+        zfo_cache_destroy(js->cache);
+        free(js);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    return handle;
+}
+
+/* cacheRead(handle, path: string, zstd?: boolean): Buffer */
+static napi_value cache_read(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Handle and path required");
+        return NULL;
+    }
+    js_cache_t* js = get_js_cache(env, argv[0]);
+    if (!js) return NULL;
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[1], path, sizeof(path), &path_len));
+
+    bool zstd = false;
+    if (argc > 2) napi_get_value_bool(env, argv[2], &zstd);
+
+    zfo_cache_result_t res;
+    int rc = zfo_cache_get(js->cache, path, zstd ? ZFO_CACHE_ZSTD : ZFO_CACHE_RAW, &res);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    zfo_cache_blob_t* blob = res.blob;
+    napi_value buffer;
+    if (blob->user) {
+        zfo_cache_blob_release(blob);
+        NAPI_CALL(napi_get_reference_value(env, (napi_ref)blob->user, &buffer));
+        return buffer;
+    }
+
+    /* The Buffer takes over the reference zfo_cache_get handed out */
+    buffer = create_owned_buffer(env, blob->data, blob->size, cache_buffer_finalize, blob);
+    if (!buffer) return NULL;
+    if (res.cached) {
+        napi_ref ref;
+        if (napi_create_reference(env, buffer, 1, &ref) == napi_ok) blob->user = ref;
+    }
+    return buffer;
+}
+
+/* cacheInvalidate(handle, path: string, recursive?: boolean): number */
+static napi_value cache_invalidate(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Handle and path required");
+        return NULL;
+    }
+    js_cache_t* js = get_js_cache(env, argv[0]);
+    if (!js) return NULL;
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[1], path, sizeof(path), &path_len));
+
+    bool recursive = false;
+    if (argc > 2) napi_get_value_bool(env, argv[2], &recursive);
+
+    napi_value result;
+    NAPI_CALL(napi_create_double(env, (double)zfo_cache_invalidate(js->cache, path, recursive), &result));
+    return result;
+}
+
+/* cacheClear(handle): void */
+static napi_value cache_clear(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_cache_t* js = argc > 0 ? get_js_cache(env, argv[0]) : NULL;
+    if (!js) return NULL;
+    zfo_cache_clear(js->cache);
+    return NULL;
+}
+
+/* cacheStats(handle): CacheStats */
+static napi_value cache_stats(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_cache_t* js = argc > 0 ? get_js_cache(env, argv[0]) : NULL;
+    if (!js) return NULL;
+
+    zfo_cache_stats_t st;
+    zfo_cache_stats(js->cache, &st);
+    napi_value obj;
+    NAPI_CALL(napi_create_object(env, &obj));
+    set_named_double(env, obj, "hits", (double)st.hits);
+    set_named_double(env, obj, "misses", (double)st.misses);
+    set_named_double(env, obj, "evictions", (double)st.evictions);
+    set_named_double(env, obj, "entries", (double)st.entries);
+    set_named_double(env, obj, "bytes", (double)st.bytes);
+    return obj;
+}
+
+/* cacheClose(handle): void */
+static napi_value cache_close(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_cache_t* js = NULL;
+    if (argc < 1 || napi_get_value_external(env, argv[0], (void**)&js) != napi_ok || !js) {
+        napi_throw_type_error(env, NULL, "Invalid cache handle");
+        return NULL;
+    }
+    zfo_cache_destroy(js->cache);
+    js->cache = NULL;
+    return NULL;
+}
+
+/* ============================================================
+ * Shared-Memory Channel
+ * ============================================================ */
+
+/*
+ * As with mmap, the ArrayBuffer over the whole mapping is the handle
+ * and JS builds message Buffers as views into it. channelWait blocks
+ * on its own thread; close interrupts those threads and waits for them
+ * to leave the channel before it detaches the buffer and unmaps.
+ *
+ * Detaching runs the backing-store finalizer right away while the
+ * ArrayBuffer object (and its wrap) lives on, so each holds a
+ * reference to the js_channel_t.
+ */
+typedef struct {
+    zfo_channel_t* ch;
+    pthread_mutex_t lock;
+    pthread_cond_t idle;
+    int waiters;
+    int refs;
+} js_channel_t;
+
+typedef struct {
+    js_channel_t* js;
+    int timeout_ms;
+    int rc;
+    napi_deferred deferred;
+    napi_threadsafe_function tsfn;
+    pthread_t thread;
+    bool started;
+} channel_wait_job_t;
+
+static void js_channel_unref(js_channel_t* js) {
+    if (__atomic_sub_fetch(&js->refs, 1, __ATOMIC_ACQ_REL) > 0) return;
+    pthread_mutex_destroy(&js->lock);
+    pthread_cond_destroy(&js->idle);
+    free(js);
+}
+
+static void js_channel_shutdown(js_channel_t* js) {
+    zfo_channel_interrupt(js->ch);
+    pthread_mutex_lock(&js->lock);
+    while (js->waiters > 0) pthread_cond_wait(&js->idle, &js->lock);
+    pthread_mutex_unlock(&js->lock);
+}
+
+/* Backing store gone: unmap unless channelClose already did */
+static void channel_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)data;
+    js_channel_t* js = hint;
+    if (js->ch) {
+        js_channel_shutdown(js);
+        zfo_channel_close(js->ch);
+        js->ch = NULL;
+    }
+    js_channel_unref(js);
+}
+
+static void channel_wrap_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)hint;
+    js_channel_unref(data);
+}
+
+static js_channel_t* get_js_channel(napi_env env, napi_value value) {
+    js_channel_t* js = NULL;
+    if (napi_unwrap(env, value, (void**)&js) != napi_ok || !js) {
+        napi_throw_type_error(env, NULL, "Invalid channel handle");
+        return NULL;
+    }
+    if (!js->ch) {
+        napi_throw_error(env, NULL, "Channel is closed");
+        return NULL;
+    }
+    return js;
+}
+
+static napi_value wrap_channel(napi_env env, zfo_channel_t* ch) {
+    js_channel_t* js = calloc(1, sizeof(js_channel_t));
+    if (!js) {
+        zfo_channel_close(ch);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    js->ch = ch;
+    js->refs = 2;
+    pthread_mutex_init(&js->lock, NULL);
+    pthread_cond_init(&js->idle, NULL);
+
+    napi_value ab;
+    if (napi_create_external_arraybuffer(env, zfo_channel_base(ch), zfo_channel_map_size(ch),
+                                         channel_finalize, js, &ab) != napi_ok) {
+        js->refs = 1;
+        channel_finalize(env, NULL, js);
+        napi_throw_error(env, NULL, "External ArrayBuffers are not supported");
+        return NULL;
+    }
+    if (napi_wrap(env, ab, js, channel_wrap_finalize, NULL, NULL) != napi_ok) {
+        js_channel_unref(js);
+        napi_throw_error(env, NULL, "Failed to wrap channel");
+        return NULL;
+    }
+    return ab;
+}
+
+/* channelCreate(path: string | null, options?: {capacity?, mode?}): ArrayBuffer */
+static napi_value channel_create(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    char path[4096];
+    bool has_path = false;
+    napi_valuetype type = napi_undefined;
+    if (argc > 0) napi_typeof(env, argv[0], &type);
+    if (type == napi_string) {
+        size_t len;
+        NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &len));
+        has_path = true;
+    } else if (type != napi_undefined && type != napi_null) {
+        napi_throw_type_error(env, NULL, "Path must be a string or null");
+        return NULL;
+    }
+
+    zfo_channel_options_t opts = {0};
+    if (argc > 1) {
+        napi_typeof(env, argv[1], &type);
+        if (type == napi_object) {
+            double capacity = get_opt_double(env, argv[1], "capacity", 0);
+            if (capacity < 0) {
+                napi_throw_range_error(env, NULL, "Capacity must be non-negative");
+                return NULL;
+            }
+            opts.capacity = (size_t)capacity;
+            opts.mode = (uint32_t)get_opt_int32(env, argv[1], "mode", 0);
+        }
+    }
+
+    zfo_channel_t* ch = NULL;
+    int rc = zfo_channel_create(has_path ? path : NULL, &opts, &ch);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return wrap_channel(env, ch);
+}
+
+/* channelOpen(path: string): ArrayBuffer */
+static napi_value channel_open(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Path required");
+        return NULL;
+    }
+
+    char path[4096];
+    size_t len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &len));
+
+    zfo_channel_t* ch = NULL;
+    int rc = zfo_channel_open(path, &ch);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return wrap_channel(env, ch);
+}
+
+/* channelInfo(ch: ArrayBuffer): {path, capacity, maxMessage, used, written, read} */
+static napi_value channel_info(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_channel_t* js = argc > 0 ? get_js_channel(env, argv[0]) : NULL;
+    if (!js) return NULL;
+
+    zfo_channel_stats_t st;
+    zfo_channel_stats(js->ch, &st);
+
+    napi_value obj, path;
+    napi_create_object(env, &obj);
+    napi_create_string_utf8(env, zfo_channel_path(js->ch), NAPI_AUTO_LENGTH, &path);
+    napi_set_named_property(env, obj, "path", path);
+    set_named_double(env, obj, "capacity", (double)st.capacity);
+    set_named_double(env, obj, "maxMessage", (double)zfo_channel_max_message(js->ch));
+    set_named_double(env, obj, "used", (double)st.used);
+    set_named_double(env, obj, "written", (double)st.written);
+    set_named_double(env, obj, "read", (double)st.read);
+    return obj;
+}
+
+/* Timeouts: 0 = don't wait, < 0 = forever */
+static int get_timeout_arg(napi_env env, size_t argc, napi_value* argv, size_t index, int def) {
+    int32_t timeout = def;
+    if (argc > index) {
+        napi_valuetype type;
+        napi_typeof(env, argv[index], &type);
+        if (type == napi_number) napi_get_value_int32(env, argv[index], &timeout);
+    }
+    return timeout;
+}
+
+/* channelSend(ch: ArrayBuffer, data: Buffer, timeoutMs?: number): boolean */
+static napi_value channel_send(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Channel and data required");
+        return NULL;
+    }
+
+    js_channel_t* js = get_js_channel(env, argv[0]);
+    if (!js) return NULL;
+
+    void* data;
+    size_t len;
+    NAPI_CALL(napi_get_buffer_info(env, argv[1], &data, &len));
+
+    int rc = zfo_channel_send(js->ch, data, len, get_timeout_arg(env, argc, argv, 2, 0));
+    if (rc != ZFO_OK && rc != ZFO_ERR_TIMEOUT) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value result;
+    napi_get_boolean(env, rc == ZFO_OK, &result);
+    return result;
+}
+
+/* channelReserve(ch: ArrayBuffer, length: number, timeoutMs?: number): number | null */
+static napi_value channel_reserve(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Channel and length required");
+        return NULL;
+    }
+
+    js_channel_t* js = get_js_channel(env, argv[0]);
+    if (!js) return NULL;
+
+    double len;
+    NAPI_CALL(napi_get_value_double(env, argv[1], &len));
+    if (len < 0 || len > (double)zfo_channel_max_message(js->ch)) {
+        napi_throw_range_error(env, NULL, "Message is larger than half the channel");
+        return NULL;
+    }
+
+    size_t offset;
+    int rc = zfo_channel_reserve(js->ch, (size_t)len, get_timeout_arg(env, argc, argv, 2, 0), &offset);
+    napi_value result;
+    if (rc == ZFO_ERR_TIMEOUT) {
+        napi_get_null(env, &result);
+        return result;
+    }
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    napi_create_double(env, (double)offset, &result);
+    return result;
+}
+
+/* channelCommit(ch: ArrayBuffer, offset: number): void */
+static napi_value channel_commit(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Channel and offset required");
+        return NULL;
+    }
+
+    js_channel_t* js = get_js_channel(env, argv[0]);
+    if (!js) return NULL;
+
+    double offset;
+    NAPI_CALL(napi_get_value_double(env, argv[1], &offset));
+    if (offset < 0 || offset >= (double)zfo_channel_map_size(js->ch)) {
+        napi_throw_range_error(env, NULL, "Offset is outside the channel");
+        return NULL;
+    }
+    zfo_channel_commit(js->ch, (size_t)offset);
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* channelReceive(ch: ArrayBuffer, timeoutMs?: number): {offset, length} | null */
+static napi_value channel_receive(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_channel_t* js = argc > 0 ? get_js_channel(env, argv[0]) : NULL;
+    if (!js) return NULL;
+
+    size_t offset, len;
+    int rc = zfo_channel_receive(js->ch, get_timeout_arg(env, argc, argv, 1, 0), &offset, &len);
+    napi_value result;
+    if (rc == ZFO_ERR_TIMEOUT) {
+        napi_get_null(env, &result);
+        return result;
+    }
+    if (rc == ZFO_ERR_BUSY) {
+        napi_throw_error(env, NULL, "Another process is receiving from this channel");
+        return NULL;
+    }
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_create_object(env, &result);
+    set_named_double(env, result, "offset", (double)offset);
+    set_named_double(env, result, "length", (double)len);
+    return result;
+}
+
+/* channelRelease(ch: ArrayBuffer): void */
+static napi_value channel_release(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_channel_t* js = argc > 0 ? get_js_channel(env, argv[0]) : NULL;
+    if (!js) return NULL;
+    zfo_channel_release(js->ch);
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+static void* channel_wait_thread(void* arg) {
+    channel_wait_job_t* job = arg;
+    js_channel_t* js = job->js;
+    job->rc = zfo_channel_wait(js->ch, job->timeout_ms);
+
+    /* The channel may be closed as soon as waiters drops */
+    pthread_mutex_lock(&js->lock);
+    if (--js->waiters == 0) pthread_cond_broadcast(&js->idle);
+    pthread_mutex_unlock(&js->lock);
+
+    napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+    return NULL;
+}
+
+static void channel_wait_call_js(napi_env env, napi_value callback, void* context, void* data) {
+    (void)env;
+    (void)callback;
+    (void)context;
+    (void)data;
+}
+
+static void channel_wait_finalize(napi_env env, void* data, void* hint) {
+    (void)hint;
+    channel_wait_job_t* job = data;
+    if (job->started) pthread_join(job->thread, NULL);
+
+    if (job->rc == ZFO_OK || job->rc == ZFO_ERR_TIMEOUT || job->rc == ZFO_ERR_INTERRUPTED) {
+        napi_value result;
+        napi_get_boolean(env, job->rc == ZFO_OK, &result);
+        napi_resolve_deferred(env, job->deferred, result);
+    } else {
+        napi_value msg, err;
+        napi_create_string_utf8(env, zfo_strerror(job->rc), NAPI_AUTO_LENGTH, &msg);
+        napi_create_error(env, NULL, msg, &err);
+        napi_reject_deferred(env, job->deferred, err);
+    }
+    free(job);
+}
+
+/* channelWait(ch: ArrayBuffer, timeoutMs?: number): Promise<boolean> */
+static napi_value channel_wait(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_channel_t* js = argc > 0 ? get_js_channel(env, argv[0]) : NULL;
+    if (!js) return NULL;
+
+    channel_wait_job_t* job = calloc(1, sizeof(channel_wait_job_t));
+    if (!job) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    job->js = js;
+    job->timeout_ms = get_timeout_arg(env, argc, argv, 1, -1);
+
+    napi_value promise, name;
+    napi_create_string_utf8(env, "pulsar.channelWait", NAPI_AUTO_LENGTH, &name);
+    if (napi_create_promise(env, &job->deferred, &promise) != napi_ok ||
+        napi_create_threadsafe_function(env, NULL, NULL, name, 1, 1,
+                                        job, channel_wait_finalize, job, channel_wait_call_js,
+                                        &job->tsfn) != napi_ok) {
+        free(job);
+        napi_throw_error(env, NULL, "Failed to start channel wait");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&js->lock);
+    js->waiters++;
+    pthread_mutex_unlock(&js->lock);
+
+    if (pthread_create(&job->thread, NULL, channel_wait_thread, job) != 0) {
+        pthread_mutex_lock(&js->lock);
+        js->waiters--;
+        pthread_mutex_unlock(&js->lock);
+        job->rc = ZFO_ERR_UNKNOWN;
+        napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+        return promise;
+    }
+    job->started = true;
+    return promise;
+}
+
+/* channelClose(ch: ArrayBuffer): void */
+static napi_value channel_close(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_channel_t* js = argc > 0 ? get_js_channel(env, argv[0]) : NULL;
+    if (!js) return NULL;
+
+    /* Pending waits resolve false; no view may outlive the mapping */
+    js_channel_shutdown(js);
+    zfo_channel_t* ch = js->ch;
+    js->ch = NULL;
+    NAPI_CALL(napi_detach_arraybuffer(env, argv[0]));
+    zfo_channel_close(ch);
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* ============================================================
+ * Columnar Stat
+ * ============================================================ */
+
+static bool set_column(napi_env env, napi_value obj, const char* key, napi_typedarray_type type,
+                       size_t length, napi_value ab, size_t base, const void* col, const void* block) {
+    napi_value arr;
+    size_t offset = base + (size_t)((const uint8_t*)col - (const uint8_t*)block);
+    if (napi_create_typedarray(env, type, length, ab, offset, &arr) != napi_ok) return false;
+    return napi_set_named_property(env, obj, key, arr) == napi_ok;
+}
+
+/*
+ * Hand the columns to JS without copying: the numeric block becomes one
+ * Buffer and each column a typed array over its ArrayBuffer. Takes over
+ * both allocations in cols.
+ */
+static napi_value create_columns(napi_env env, zfo_statcols_t* cols) {
+    napi_value obj;
+    NAPI_CALL(napi_create_object(env, &obj));
+    set_named_double(env, obj, "count", (double)cols->count);
+
+    size_t n = cols->count;
+    void* block = cols->block;
+    cols->block = NULL;
+    napi_value buf = create_owned_buffer(env, block, cols->block_size, free_buffer_data, NULL);
+    if (!buf) {
+        zfo_statcols_free(cols);
+        return NULL;
+    }
+
+    /* The copy fallback may place the data anywhere in its ArrayBuffer */
+    napi_value ab;
+    size_t base;
+    if (napi_get_typedarray_info(env, buf, NULL, NULL, NULL, &ab, &base) != napi_ok) {
+        zfo_statcols_free(cols);
+        napi_throw_error(env, NULL, "Failed to create column arrays");
+        return NULL;
+    }
+    bool ok = set_column(env, obj, "size", napi_float64_array, n, ab, base, cols->size, block) &&
+              set_column(env, obj, "mtime", napi_float64_array, n, ab, base, cols->mtime_ms, block) &&
+              set_column(env, obj, "ino", napi_biguint64_array, n, ab, base, cols->inode, block) &&
+              set_column(env, obj, "mode", napi_uint32_array, n, ab, base, cols->mode, block) &&
+              set_column(env, obj, "type", napi_uint8_array, n, ab, base, cols->type, block);
+
+    if (ok && cols->names) {
+        ok = set_column(env, obj, "nameOffsets", napi_uint32_array, n + 1, ab, base,
+                        cols->name_offsets, block);
+        char* names = cols->names;
+        cols->names = NULL;
+        napi_value packed = create_owned_buffer(env, names, cols->names_len, free_buffer_data, NULL);
+        if (!packed) return NULL;
+        napi_set_named_property(env, obj, "names", packed);
+    }
+    if (!ok) {
+        napi_throw_error(env, NULL, "Failed to create column arrays");
+        return NULL;
+    }
+    return obj;
+}
+
+/* statMany(paths: string[], options?: {followSymlinks?}): StatColumns */
+static napi_value stat_many(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    bool is_array = false;
+    if (argc < 1 || napi_is_array(env, argv[0], &is_array) != napi_ok || !is_array) {
+        napi_throw_type_error(env, NULL, "Path array required");
+        return NULL;
+    }
+    bool follow = argc < 2 || get_opt_bool(env, argv[1], "followSymlinks", true);
+
+    uint32_t count;
+    NAPI_CALL(napi_get_array_length(env, argv[0], &count));
+
+    /* Pack every path into one arena, NUL-terminated */
+    size_t arena_cap = (size_t)count * 64 + 1, arena_len = 0;
+    char* arena = malloc(arena_cap);
+    size_t* starts = malloc((count ? count : 1) * sizeof(size_t));
+    if (!arena || !starts) {
+        free(arena);
+        free(starts);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        napi_value item;
+        size_t len;
+        napi_get_element(env, argv[0], i, &item);
+        if (napi_get_value_string_utf8(env, item, NULL, 0, &len) != napi_ok) {
+            free(arena);
+            free(starts);
+            napi_throw_type_error(env, NULL, "Paths must be strings");
+            return NULL;
+        }
+        if (arena_len + len + 1 > arena_cap) {
+            while (arena_len + len + 1 > arena_cap) arena_cap *= 2;
+            char* grown = realloc(arena, arena_cap);
+            if (!grown) {
+                free(arena);
+                free(starts);
+                napi_throw_error(env, NULL, "Out of memory");
+                return NULL;
+            }
+            arena = grown;
+        }
+        napi_get_value_string_utf8(env, item, arena + arena_len, len + 1, &len);
+        starts[i] = arena_len;
+        arena_len += len + 1;
+    }
+
+    const char** paths = malloc((count ? count : 1) * sizeof(char*));
+    if (!paths) {
+        free(arena);
+        free(starts);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    for (uint32_t i = 0; i < count; i++) paths[i] = arena + starts[i];
+
+    zfo_statcols_t cols;
+    int rc = zfo_stat_many(paths, count, follow, &cols);
+    free(paths);
+    free(starts);
+    free(arena);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return create_columns(env, &cols);
+}
+
+/* readdirPlus(path: string): DirColumns */
+static napi_value readdir_plus(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Path required");
+        return NULL;
+    }
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+
+    zfo_statcols_t cols;
+    int rc = zfo_readdir_plus(path, &cols);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+    return create_columns(env, &cols);
+}
+
+/* ============================================================
+ * Tar Archives
+ * ============================================================ */
+
+typedef enum { TAR_PACK, TAR_UNPACK, TAR_EXTRACT } tar_op_t;
+
+typedef struct {
+    tar_op_t op;
+    char src[4096];                 /* Root to pack, or the archive */
+    char dst[4096];                 /* Archive to write, or where to extract */
+    char member[4096];
+    zfo_tar_pack_options_t pack;
+    zfo_tar_unpack_options_t unpack;
+    zfo_tar_stats_t stats;
+    int rc;
+    napi_deferred deferred;
+    napi_threadsafe_function tsfn;
+    pthread_t thread;
+    bool started;
+} tar_job_t;
+
+static void* tar_thread(void* arg) {
+    tar_job_t* job = arg;
+    switch (job->op) {
+        case TAR_PACK:
+            job->rc = zfo_tar_pack(job->src, job->dst, &job->pack, &job->stats);
+            break;
+        case TAR_UNPACK:
+            job->rc = zfo_tar_unpack(job->src, job->dst, &job->unpack, &job->stats);
+            break;
+        case TAR_EXTRACT:
+            job->rc = zfo_tar_extract(job->src, job->member, job->dst);
+            break;
+    }
+    napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+    return NULL;
+}
+
+static void tar_call_js(napi_env env, napi_value callback, void* context, void* data) {
+    (void)env;
+    (void)callback;
+    (void)context;
+    (void)data;
+}
+
+static void tar_finalize(napi_env env, void* data, void* hint) {
+    (void)hint;
+    tar_job_t* job = data;
+    if (job->started) pthread_join(job->thread, NULL);
+
+    napi_value result;
+    if (job->rc != ZFO_OK) {
+        napi_value msg;
+        napi_create_string_utf8(env, zfo_strerror(job->rc), NAPI_AUTO_LENGTH, &msg);
+        napi_create_error(env, NULL, msg, &result);
+        napi_reject_deferred(env, job->deferred, result);
+        free(job);
+        return;
+    }
+
+    if (job->op == TAR_EXTRACT) {
+        napi_get_undefined(env, &result);
+    } else {
+        napi_create_object(env, &result);
+        set_named_double(env, result, "files", (double)job->stats.files);
+        set_named_double(env, result, "dirs", (double)job->stats.dirs);
+        set_named_double(env, result, "links", (double)job->stats.links);
+        set_named_double(env, result, "bytes", (double)job->stats.bytes);
+        set_named_double(env, result, "archiveBytes", (double)job->stats.archive_bytes);
+        set_named_double(env, result, "errors", (double)job->stats.errors);
+    }
+    napi_resolve_deferred(env, job->deferred, result);
+    free(job);
+}
+
+static napi_value tar_job_start(napi_env env, tar_job_t* job) {
+    napi_value promise, name;
+    napi_create_string_utf8(env, "pulsar.tar", NAPI_AUTO_LENGTH, &name);
+    if (napi_create_promise(env, &job->deferred, &promise) != napi_ok ||
+        napi_create_threadsafe_function(env, NULL, NULL, name, 1, 1,
+                                        job, tar_finalize, job, tar_call_js,
+                                        &job->tsfn) != napi_ok) {
+        free(job);
+        napi_throw_error(env, NULL, "Failed to start tar job");
+        return NULL;
+    }
+
+    if (pthread_create(&job->thread, NULL, tar_thread, job) != 0) {
+        job->rc = ZFO_ERR_UNKNOWN;
+        napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+        return promise;
+    }
+    job->started = true;
+    return promise;
+}
+
+static tar_job_t* tar_job_create(napi_env env, tar_op_t op, size_t argc, napi_value* argv,
+                                 size_t required, const char* usage) {
+    if (argc < required) {
+        napi_throw_type_error(env, NULL, usage);
+        return NULL;
+    }
+    tar_job_t* job = calloc(1, sizeof(tar_job_t));
+    if (!job) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    job->op = op;
+
+    size_t len;
+    char* dst = op == TAR_EXTRACT ? job->member : job->dst;
+    if (napi_get_value_string_utf8(env, argv[0], job->src, sizeof(job->src), &len) != napi_ok ||
+        napi_get_value_string_utf8(env, argv[1], dst, sizeof(job->dst), &len) != napi_ok ||
+        (op == TAR_EXTRACT &&
+         napi_get_value_string_utf8(env, argv[2], job->dst, sizeof(job->dst), &len) != napi_ok)) {
+        free(job);
+        napi_throw_type_error(env, NULL, "Paths must be strings");
+        return NULL;
+    }
+    return job;
+}
+
+/* tarPack(root, archive, options?): Promise<TarStats> */
+static napi_value tar_pack(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    tar_job_t* job = tar_job_create(env, TAR_PACK, argc, argv, 2, "Root and archive path required");
+    if (!job) return NULL;
+
+    napi_valuetype opt_type = napi_undefined;
+    if (argc > 2) napi_typeof(env, argv[2], &opt_type);
+    if (opt_type == napi_object) {
+        napi_value o = argv[2];
+        char* codec = get_opt_string_dup(env, o, "compress");
+        if (codec) {
+            if (strcmp(codec, "zstd") == 0) job->pack.codec = ZFO_CODEC_ZSTD;
+            else if (strcmp(codec, "lz4") == 0) job->pack.codec = ZFO_CODEC_LZ4;
+            bool known = job->pack.codec != ZFO_CODEC_NONE || strcmp(codec, "none") == 0;
+            free(codec);
+            if (!known) {
+                free(job);
+                napi_throw_type_error(env, NULL, "compress must be 'zstd', 'lz4' or 'none'");
+                return NULL;
+            }
+        }
+        double frame = get_opt_double(env, o, "frameSize", 0);
+        job->pack.level = get_opt_int32(env, o, "level", 0);
+        job->pack.threads = get_opt_int32(env, o, "threads", 0);
+        job->pack.frame_size = frame > 0 ? (size_t)frame : 0;
+        if (!get_opt_bool(env, o, "includeHidden", true)) job->pack.flags |= ZFO_TAR_SKIP_HIDDEN;
+        if (get_opt_bool(env, o, "followSymlinks", false)) job->pack.flags |= ZFO_TAR_FOLLOW_SYMLINKS;
+        if (get_opt_bool(env, o, "seekable", false)) job->pack.flags |= ZFO_TAR_SEEKABLE;
+    }
+    return tar_job_start(env, job);
+}
+
+/* tarUnpack(archive, dest, options?): Promise<TarStats> */
+static napi_value tar_unpack(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    tar_job_t* job = tar_job_create(env, TAR_UNPACK, argc, argv, 2,
+                                    "Archive and destination required");
+    if (!job) return NULL;
+
+    napi_valuetype opt_type = napi_undefined;
+    if (argc > 2) napi_typeof(env, argv[2], &opt_type);
+    if (opt_type == napi_object) {
+        job->unpack.threads = get_opt_int32(env, argv[2], "threads", 0);
+        job->unpack.strip = get_opt_int32(env, argv[2], "strip", 0);
+    }
+    return tar_job_start(env, job);
+}
+
+/* tarExtract(archive, member, outPath): Promise<void> */
+static napi_value tar_extract(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    tar_job_t* job = tar_job_create(env, TAR_EXTRACT, argc, argv, 3,
+                                    "Archive, member and output path required");
+    if (!job) return NULL;
+    return tar_job_start(env, job);
+}
+
+/* ============================================================
+ * Disk Usage
+ * ============================================================ */
+
+typedef struct {
+    char root[4096];
+    zfo_du_options_t opts;
+    char** prune;
+    zfo_du_result_t result;
+    int rc;
+    napi_deferred deferred;
+    napi_threadsafe_function tsfn;
+    pthread_t thread;
+    bool started;
+} du_job_t;
+
+static void du_job_free(du_job_t* job) {
+    for (size_t i = 0; i < job->opts.prune_count; i++) free(job->prune[i]);
+    free(job->prune);
+    zfo_du_result_free(&job->result);
+    free(job);
+}
+
+static void* du_thread(void* arg) {
+    du_job_t* job = arg;
+    job->rc = zfo_du(job->root, &job->opts, &job->result);
+    napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+    return NULL;
+}
+
+static void du_call_js(napi_env env, napi_value callback, void* context, void* data) {
+    (void)env;
+    (void)callback;
+    (void)context;
+    (void)data;
+}
+
+/* Rows become typed arrays over the block, as in create_columns */
+static napi_value create_du_result(napi_env env, int rc, zfo_du_result_t* r) {
+    napi_value tree = create_tree_result(env, rc, &r->walk);
+    napi_value obj, errors;
+    napi_create_object(env, &obj);
+    napi_get_named_property(env, tree, "errors", &errors);
+    napi_set_named_property(env, obj, "errors", errors);
+    set_named_double(env, obj, "count", (double)r->count);
+    set_named_double(env, obj, "hardlinks", (double)r->hardlinks);
+
+    size_t n = r->count;
+    void* block = r->block;
+    r->block = NULL;
+    napi_value buf = create_owned_buffer(env, block, r->block_size, free_buffer_data, NULL);
+    if (!buf) return NULL;
+
+    napi_value ab;
+    size_t base;
+    if (napi_get_typedarray_info(env, buf, NULL, NULL, NULL, &ab, &base) != napi_ok) return NULL;
+    bool ok = set_column(env, obj, "apparent", napi_float64_array, n, ab, base, r->apparent, block) &&
+              set_column(env, obj, "allocated", napi_float64_array, n, ab, base, r->allocated, block) &&
+              set_column(env, obj, "files", napi_float64_array, n, ab, base, r->files, block) &&
+              set_column(env, obj, "dirs", napi_float64_array, n, ab, base, r->dirs, block) &&
+              set_column(env, obj, "parent", napi_int32_array, n, ab, base, r->parent, block) &&
+              set_column(env, obj, "depth", napi_uint32_array, n, ab, base, r->depth, block) &&
+              set_column(env, obj, "nameOffsets", napi_uint32_array, n + 1, ab, base,
+                         r->name_offsets, block);
+    if (!ok) return NULL;
+
+    char* names = r->names;
+    r->names = NULL;
+    napi_value packed = create_owned_buffer(env, names, r->names_len, free_buffer_data, NULL);
+    if (!packed) return NULL;
+    napi_set_named_property(env, obj, "names", packed);
+    return obj;
+}
+
+static void du_finalize(napi_env env, void* data, void* hint) {
+    (void)hint;
+    du_job_t* job = data;
+    if (job->started) pthread_join(job->thread, NULL);
+
+    napi_value result = NULL;
+    if (job->rc == ZFO_OK || job->result.walk.error_count > 0) {
+        result = create_du_result(env, job->rc, &job->result);
+    }
+    if (result) {
+        napi_resolve_deferred(env, job->deferred, result);
+    } else {
+        napi_value msg, err;
+        int rc = job->rc != ZFO_OK ? job->rc : ZFO_ERR_NO_MEMORY;
+        napi_create_string_utf8(env, zfo_strerror(rc), NAPI_AUTO_LENGTH, &msg);
+        napi_create_error(env, NULL, msg, &err);
+        napi_reject_deferred(env, job->deferred, err);
+    }
+    du_job_free(job);
+}
+
+/* duTree(root: string, options?: object): Promise<DiskUsage> */
+static napi_value du_tree(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Root required");
+        return NULL;
+    }
+
+    du_job_t* job = calloc(1, sizeof(du_job_t));
+    if (!job) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+
+    size_t len;
+    if (napi_get_value_string_utf8(env, argv[0], job->root, sizeof(job->root), &len) != napi_ok) {
+        free(job);
+        napi_throw_type_error(env, NULL, "Root must be a string");
+        return NULL;
+    }
+
+    zfo_du_options_t* d = &job->opts;
+    d->max_depth = 1;
+
+    napi_valuetype opt_type = napi_undefined;
+    if (argc > 1) napi_typeof(env, argv[1], &opt_type);
+    if (opt_type == napi_object) {
+        napi_value o = argv[1];
+        d->threads = get_opt_int32(env, o, "threads", 0);
+        d->max_depth = get_opt_int32(env, o, "maxDepth", 1);
+        if (!get_opt_bool(env, o, "includeHidden", true)) d->flags |= ZFO_DU_SKIP_HIDDEN;
+        if (get_opt_bool(env, o, "oneFileSystem", false)) d->flags |= ZFO_DU_ONE_FS;
+        if (get_opt_bool(env, o, "countLinks", false)) d->flags |= ZFO_DU_COUNT_LINKS;
+        job->prune = get_opt_string_list(env, o, "prune", &d->prune_count);
+    }
+    d->prune = (const char* const*)job->prune;
+
+    napi_value promise, name;
+    napi_create_string_utf8(env, "pulsar.duTree", NAPI_AUTO_LENGTH, &name);
+    if (napi_create_promise(env, &job->deferred, &promise) != napi_ok ||
+        napi_create_threadsafe_function(env, NULL, NULL, name, 1, 1,
+                                        job, du_finalize, job, du_call_js,
+                                        &job->tsfn) != napi_ok) {
+        du_job_free(job);
+        napi_throw_error(env, NULL, "Failed to start disk usage scan");
+        return NULL;
+    }
+
+    if (pthread_create(&job->thread, NULL, du_thread, job) != 0) {
+        job->rc = ZFO_ERR_UNKNOWN;
+        napi_release_threadsafe_function(job->tsfn, napi_tsfn_release);
+        return promise;
+    }
+    job->started = true;
+    return promise;
+}
+
+/* ============================================================
+ * Memory Mapping
+ * ============================================================ */
+
+/*
+ * The ArrayBuffer is the handle. Its backing-store finalizer owns the
+ * mapping; mmapUnmap detaches the buffer first so JS can never touch
+ * unmapped pages.
+ *
+ * Detaching queues the backing-store finalizer while the ArrayBuffer
+ * object (and its wrap) lives on, so each holds a reference to the
+ * js_mapping_t, as with channels.
+ */
+typedef struct {
+    zfo_mmap_t* map;
+    int refs;
+} js_mapping_t;
+
+static void js_mapping_unref(js_mapping_t* m) {
+    if (__atomic_sub_fetch(&m->refs, 1, __ATOMIC_ACQ_REL) > 0) return;
+    free(m);
+}
+
+/* Backing store gone: unmap unless mmapUnmap already did */
+static void mapping_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)data;
+    js_mapping_t* m = hint;
+    if (m->map) {
+        zfo_mmap_close(m->map);
+        m->map = NULL;
+    }
+    js_mapping_unref(m);
+}
+
+static void mapping_wrap_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)hint;
+    js_mapping_unref(data);
+}
+
+static js_mapping_t* get_mapping(napi_env env, napi_value value) {
+    js_mapping_t* m = NULL;
+    if (napi_unwrap(env, value, (void**)&m) != napi_ok || !m) {
+        napi_throw_type_error(env, NULL, "Expected a mapped ArrayBuffer");
+        return NULL;
+    }
+    if (!m->map) {
+        napi_throw_error(env, NULL, "Mapping has been unmapped");
+        return NULL;
+    }
+    return m;
+}
+
+/* mmap(path: string, options?: {offset?, length?, write?, shared?}): ArrayBuffer */
+static napi_value mmap_path(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Path required");
+        return NULL;
+    }
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+
+    double offset = 0, length = 0;
+    bool write = false, shared = true;
+    if (argc > 1) {
+        napi_valuetype type;
+        napi_typeof(env, argv[1], &type);
+        if (type == napi_object) {
+            offset = get_opt_double(env, argv[1], "offset", 0);
+            length = get_opt_double(env, argv[1], "length", 0);
+            write = get_opt_bool(env, argv[1], "write", false);
+            shared = get_opt_bool(env, argv[1], "shared", true);
+        }
+    }
+    if (offset < 0 || length < 0) {
+        napi_throw_range_error(env, NULL, "Offset and length must be non-negative");
+        return NULL;
+    }
+
+    /* Read-only maps are private copy-on-write so stray JS writes can't
+     * fault; only shared writable maps need the file open for writing */
+    int flags = ZFO_MMAP_READ | ZFO_MMAP_WRITE;
+    flags |= (write && shared) ? ZFO_MMAP_SHARED : ZFO_MMAP_PRIVATE;
+
+    zfo_mmap_t* map = zfo_mmap(path, (zfo_off_t)offset, (size_t)length, flags);
+    if (!map) {
+        napi_throw_error(env, NULL, get_error_string());
+        return NULL;
+    }
+
+    js_mapping_t* m = malloc(sizeof(js_mapping_t));
+    if (!m) {
+        zfo_mmap_close(map);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    m->map = map;
+    m->refs = 2;
+
+    napi_value ab;
+    if (napi_create_external_arraybuffer(env, zfo_mmap_ptr(map), zfo_mmap_size(map),
+                                         mapping_finalize, m, &ab) != napi_ok) {
+        zfo_mmap_close(map);
+        free(m);
+        napi_throw_error(env, NULL, "External ArrayBuffers are not supported");
+        return NULL;
+    }
+    if (napi_wrap(env, ab, m, mapping_wrap_finalize, NULL, NULL) != napi_ok) {
+        js_mapping_unref(m);
+        napi_throw_error(env, NULL, "Failed to wrap mapping");
+        return NULL;
+    }
+
+    return ab;
+}
+
+/* mmapSync(map: ArrayBuffer): void */
+static napi_value mmap_sync(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_mapping_t* m = argc > 0 ? get_mapping(env, argv[0]) : NULL;
+    if (!m) return NULL;
+
+    int rc = zfo_mmap_sync(m->map);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* mmapAdvise(map: ArrayBuffer, advice: number, offset?: number, length?: number): void */
+static napi_value mmap_advise(napi_env env, napi_callback_info info) {
+    size_t argc = 4;
+    napi_value argv[4];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Mapping and advice required");
+        return NULL;
+    }
+
+    js_mapping_t* m = get_mapping(env, argv[0]);
+    if (!m) return NULL;
+
+    int32_t advice;
+    double offset = 0, length = 0;
+    NAPI_CALL(napi_get_value_int32(env, argv[1], &advice));
+    if (argc > 2) napi_get_value_double(env, argv[2], &offset);
+    if (argc > 3) napi_get_value_double(env, argv[3], &length);
+    if (offset < 0 || length < 0) {
+        napi_throw_range_error(env, NULL, "Offset and length must be non-negative");
+        return NULL;
+    }
+
+    int rc = zfo_mmap_advise(m->map, (zfo_mmap_advice_t)advice, (size_t)offset, (size_t)length);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* mmapLock(map: ArrayBuffer, lock?: boolean): void */
+static napi_value mmap_lock(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_mapping_t* m = argc > 0 ? get_mapping(env, argv[0]) : NULL;
+    if (!m) return NULL;
 
-    char path[4096];
-    size_t path_len;
-    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+    bool lock = true;
+    if (argc > 1) napi_get_value_bool(env, argv[1], &lock);
 
-    int result = zfo_remove(path);
-    if (result != ZFO_OK) {
-        napi_throw_error(env, NULL, get_error_string());
+    int rc = zfo_mmap_lock(m->map, lock);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
         return NULL;
     }
 
@@ -278,24 +5244,23 @@ static napi_value remove_path(napi_env env, napi_callback_info info) {
     return undefined;
 }
 
-/* removeRecursive(path: string): void */
-static napi_value remove_recursive(napi_env env, napi_callback_info info) {
+/* mmapUnmap(map: ArrayBuffer): void */
+static napi_value mmap_unmap(napi_env env, napi_callback_info info) {
     size_t argc = 1;
     napi_value argv[1];
     NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
 
-    if (argc < 1) {
-        napi_throw_type_error(env, NULL, "Path required");
-        return NULL;
-    }
+    js_mapping_t* m = argc > 0 ? get_mapping(env, argv[0]) : NULL;
+    if (!m) return NULL;
 
-    char path[4096];
-    size_t path_len;
-    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+    /* Unmap only once detached; the finalizer may already have done it */
+    NAPI_CALL(napi_detach_arraybuffer(env, argv[0]));
+    zfo_mmap_t* map = m->map;
+    m->map = NULL;
 
-    int result = zfo_remove_all(path);
-    if (result != ZFO_OK) {
-        napi_throw_error(env, NULL, get_error_string());
+    int rc = map ? zfo_mmap_close(map) : ZFO_OK;
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
         return NULL;
     }
 
@@ -632,130 +5597,617 @@ static napi_value path_dirname(napi_env env, napi_callback_info info) {
     size_t path_len;
     NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
 
-    char result_buf[4096];
-    zfo_dirname(path, result_buf, sizeof(result_buf));
+    char result_buf[4096];
+    zfo_dirname(path, result_buf, sizeof(result_buf));
+
+    napi_value result;
+    napi_create_string_utf8(env, result_buf, NAPI_AUTO_LENGTH, &result);
+    return result;
+}
+
+/* extname(path: string): string */
+static napi_value path_extname(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Path required");
+        return NULL;
+    }
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+
+    char result_buf[256];
+    zfo_extname(path, result_buf, sizeof(result_buf));
+
+    napi_value result;
+    napi_create_string_utf8(env, result_buf, NAPI_AUTO_LENGTH, &result);
+    return result;
+}
+
+/* join(base: string, path: string): string */
+static napi_value path_join(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "At least two paths required");
+        return NULL;
+    }
+
+    char base[4096], path[4096];
+    size_t len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], base, sizeof(base), &len));
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[1], path, sizeof(path), &len));
+
+    char result_buf[4096];
+    zfo_join(result_buf, sizeof(result_buf), base, path);
+
+    napi_value result;
+    napi_create_string_utf8(env, result_buf, NAPI_AUTO_LENGTH, &result);
+    return result;
+}
+
+/* normalize(path: string): string */
+static napi_value path_normalize(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Path required");
+        return NULL;
+    }
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+
+    char result_buf[4096];
+    zfo_normalize(path, result_buf, sizeof(result_buf));
+
+    napi_value result;
+    napi_create_string_utf8(env, result_buf, NAPI_AUTO_LENGTH, &result);
+    return result;
+}
+
+/* resolve(path: string): string */
+static napi_value path_resolve(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Path required");
+        return NULL;
+    }
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+
+    char result_buf[4096];
+    int rc = zfo_realpath(path, result_buf, sizeof(result_buf));
+    if (rc != ZFO_OK) {
+        napi_throw_error(env, NULL, get_error_string());
+        return NULL;
+    }
+
+    napi_value result;
+    napi_create_string_utf8(env, result_buf, NAPI_AUTO_LENGTH, &result);
+    return result;
+}
+
+/* isAbsolute(path: string): boolean */
+static napi_value path_is_absolute(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 1) {
+        napi_throw_type_error(env, NULL, "Path required");
+        return NULL;
+    }
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+
+    /* Simple check: absolute path starts with / on Unix */
+    napi_value result;
+    napi_get_boolean(env, path[0] == '/', &result);
+    return result;
+}
+
+/* relative(from: string, to: string): string */
+static napi_value path_relative(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "From and to paths required");
+        return NULL;
+    }
+
+    char from[4096], to[4096];
+    size_t len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], from, sizeof(from), &len));
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[1], to, sizeof(to), &len));
+
+    char result_buf[8192];
+    int rc = zfo_relative(from, to, result_buf, sizeof(result_buf));
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value result;
+    napi_create_string_utf8(env, result_buf, NAPI_AUTO_LENGTH, &result);
+    return result;
+}
+
+/*
+ * Paths given as a string array or a Buffer of NUL-separated paths.
+ * An array is packed into a malloc'd list (*owned is set); a Buffer
+ * is used in place.
+ */
+static const char* get_packed_paths(napi_env env, napi_value input, size_t* out_len,
+                                    size_t* out_count, char** owned) {
+    *owned = NULL;
+    *out_count = 0;
+
+    bool is_buffer = false;
+    napi_is_buffer(env, input, &is_buffer);
+    if (is_buffer) {
+        void* data;
+        napi_get_buffer_info(env, input, &data, out_len);
+        return *out_len > 0 ? data : "";
+    }
+
+    bool is_array = false;
+    napi_is_array(env, input, &is_array);
+    if (!is_array) {
+        napi_throw_type_error(env, NULL, "Paths must be an array of strings or a Buffer");
+        return NULL;
+    }
+
+    uint32_t count;
+    napi_get_array_length(env, input, &count);
+    size_t cap = (size_t)count * 64 + 256;
+    size_t len = 0;
+    char* buf = malloc(cap);
+
+    napi_handle_scope scope = NULL;
+    for (uint32_t i = 0; buf && i < count; i++) {
+        if ((i & 1023) == 0) {
+            if (scope) napi_close_handle_scope(env, scope);
+            napi_open_handle_scope(env, &scope);
+        }
+        napi_value el;
+        napi_get_element(env, input, i, &el);
+
+        /* Copy straight in when it fits; ask for the length only when it may not */
+        size_t slen = 0;
+        if (cap - len < 256) {
+            char* grown = realloc(buf, cap * 2);
+            if (!grown) break;
+            buf = grown;
+            cap *= 2;
+        }
+        if (napi_get_value_string_utf8(env, el, buf + len, cap - len, &slen) != napi_ok) {
+            napi_close_handle_scope(env, scope);
+            free(buf);
+            napi_throw_type_error(env, NULL, "Paths must be strings");
+            return NULL;
+        }
+        if (slen == cap - len - 1) {
+            napi_get_value_string_utf8(env, el, NULL, 0, &slen);
+            if (slen + 1 > cap - len) {
+                size_t grow = cap * 2;
+                while (grow - len < slen + 1) grow *= 2;
+                char* grown = realloc(buf, grow);
+                if (!grown) break;
+                buf = grown;
+                cap = grow;
+                napi_get_value_string_utf8(env, el, buf + len, cap - len, &slen);
+            }
+        }
+        len += slen + 1;
+        (*out_count)++;
+    }
+    if (scope) napi_close_handle_scope(env, scope);
+
+    if (!buf || *out_count != count) {
+        free(buf);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+
+    *owned = buf;
+    *out_len = len;
+    return buf;
+}
+
+/* Split NUL-terminated results into a string array */
+static napi_value packed_to_array(napi_env env, const char* data, size_t len, size_t count) {
+    napi_value arr;
+    napi_create_array_with_length(env, count, &arr);
+
+    size_t pos = 0;
+    napi_handle_scope scope = NULL;
+    for (uint32_t i = 0; pos < len; i++) {
+        /* Let the strings of each 1024 go once they're in the array */
+        if ((i & 1023) == 0) {
+            if (scope) napi_close_handle_scope(env, scope);
+            napi_open_handle_scope(env, &scope);
+        }
+        size_t slen = strlen(data + pos);
+        napi_value str;
+        napi_create_string_utf8(env, data + pos, slen, &str);
+        napi_set_element(env, arr, i, str);
+        pos += slen + 1;
+    }
+    if (scope) napi_close_handle_scope(env, scope);
+    return arr;
+}
+
+/* pathBatch(op: string, paths: string[] | Buffer, base?: string): string[] | Buffer */
+static napi_value path_batch(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Operation and paths required");
+        return NULL;
+    }
+
+    char op_name[16];
+    size_t len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], op_name, sizeof(op_name), &len));
+
+    zfo_path_op_t op;
+    if (strcmp(op_name, "join") == 0) op = ZFO_PATH_JOIN;
+    else if (strcmp(op_name, "normalize") == 0) op = ZFO_PATH_NORMALIZE;
+    else if (strcmp(op_name, "relative") == 0) op = ZFO_PATH_RELATIVE;
+    else if (strcmp(op_name, "resolve") == 0) op = ZFO_PATH_RESOLVE;
+    else {
+        napi_throw_type_error(env, NULL, "Unknown path operation");
+        return NULL;
+    }
+
+    char base[4096];
+    bool has_base = false;
+    napi_valuetype base_type = napi_undefined;
+    if (argc > 2) napi_typeof(env, argv[2], &base_type);
+    if (base_type == napi_string) {
+        NAPI_CALL(napi_get_value_string_utf8(env, argv[2], base, sizeof(base), &len));
+        has_base = true;
+    }
+    if (op == ZFO_PATH_JOIN && !has_base) {
+        napi_throw_type_error(env, NULL, "Base path required");
+        return NULL;
+    }
+
+    char* owned;
+    size_t in_len, in_count;
+    const char* in = get_packed_paths(env, argv[1], &in_len, &in_count, &owned);
+    if (!in) return NULL;
+
+    char* out;
+    size_t out_len, out_count;
+    int rc = zfo_path_batch(op, has_base ? base : NULL, in, in_len, &out, &out_len, &out_count);
+    bool packed = owned == NULL;
+    free(owned);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    if (!packed) {
+        napi_value arr = packed_to_array(env, out, out_len, out_count);
+        free(out);
+        return arr;
+    }
+    if (!out) {
+        napi_value empty;
+        napi_create_buffer(env, 0, NULL, &empty);
+        return empty;
+    }
+    return create_owned_buffer(env, out, out_len, free_buffer_data, NULL);
+}
+
+/* ============================================================
+ * Path Table
+ * ============================================================ */
+
+typedef struct {
+    zfo_path_table_t* table;
+} js_path_table_t;
+
+static void path_table_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)hint;
+    js_path_table_t* js = data;
+    zfo_path_table_destroy(js->table);
+    free(js);
+}
+
+static zfo_path_table_t* get_path_table(napi_env env, napi_value handle) {
+    js_path_table_t* js = NULL;
+    if (napi_get_value_external(env, handle, (void**)&js) != napi_ok || !js) {
+        napi_throw_type_error(env, NULL, "Invalid path table handle");
+        return NULL;
+    }
+    if (!js->table) {
+        napi_throw_error(env, NULL, "Path table is closed");
+        return NULL;
+    }
+    return js->table;
+}
+
+static bool get_path_id(napi_env env, const zfo_path_table_t* table, napi_value value, uint32_t* id) {
+    if (napi_get_value_uint32(env, value, id) != napi_ok ||
+        zfo_path_table_parent(table, *id) == UINT32_MAX) {
+        napi_throw_range_error(env, NULL, "Unknown path id");
+        return false;
+    }
+    return true;
+}
+
+/* pathTableCreate(): handle */
+static napi_value path_table_create(napi_env env, napi_callback_info info) {
+    (void)info;
+
+    js_path_table_t* js = calloc(1, sizeof(js_path_table_t));
+    if (js) js->table = zfo_path_table_create();
+
+    napi_value handle;
+    if (!js || !js->table || napi_create_external(env, js, path_table_finalize, NULL, &handle) != napi_ok) {
+        if (js) zfo_path_table_destroy(js->table);
+        free(js);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    return handle;
+}
+
+/* pathTableIntern(handle, path: string | string[] | Buffer): number | Uint32Array */
+static napi_value path_table_intern(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Path table and path required");
+        return NULL;
+    }
+    zfo_path_table_t* table = get_path_table(env, argv[0]);
+    if (!table) return NULL;
+
+    napi_valuetype type;
+    napi_typeof(env, argv[1], &type);
+    if (type == napi_string) {
+        char path[4096];
+        size_t len;
+        NAPI_CALL(napi_get_value_string_utf8(env, argv[1], path, sizeof(path), &len));
+
+        uint32_t id;
+        int rc = zfo_path_table_intern(table, path, len, &id);
+        if (rc != ZFO_OK) {
+            throw_zfo_error(env, rc);
+            return NULL;
+        }
+        napi_value result;
+        napi_create_uint32(env, id, &result);
+        return result;
+    }
+
+    char* owned;
+    size_t in_len, count;
+    const char* in = get_packed_paths(env, argv[1], &in_len, &count, &owned);
+    if (!in) return NULL;
+    if (!owned) {
+        /* Count entries in a packed Buffer; a trailing NUL is optional */
+        count = 0;
+        for (size_t i = 0; i < in_len; i++) count += in[i] == 0;
+        if (in_len > 0 && in[in_len - 1] != 0) count++;
+    }
+
+    napi_value ab, ids;
+    uint32_t* data;
+    if (napi_create_arraybuffer(env, count * sizeof(uint32_t), (void**)&data, &ab) != napi_ok) {
+        free(owned);
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+
+    size_t pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        const char* p = in + pos;
+        const char* end = memchr(p, 0, in_len - pos);
+        size_t len = end ? (size_t)(end - p) : in_len - pos;
+        pos += len + 1;
+
+        int rc = zfo_path_table_intern(table, p, len, &data[i]);
+        if (rc != ZFO_OK) {
+            free(owned);
+            throw_zfo_error(env, rc);
+            return NULL;
+        }
+    }
+    free(owned);
+
+    NAPI_CALL(napi_create_typedarray(env, napi_uint32_array, count, ab, 0, &ids));
+    return ids;
+}
 
+static napi_value path_table_string(napi_env env, const zfo_path_table_t* table, uint32_t id) {
+    char stack[4096];
+    size_t len = zfo_path_table_get(table, id, stack, sizeof(stack));
     napi_value result;
-    napi_create_string_utf8(env, result_buf, NAPI_AUTO_LENGTH, &result);
+    if (len < sizeof(stack)) {
+        napi_create_string_utf8(env, stack, len, &result);
+        return result;
+    }
+
+    char* heap = malloc(len + 1);
+    if (!heap) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+    zfo_path_table_get(table, id, heap, len + 1);
+    napi_create_string_utf8(env, heap, len, &result);
+    free(heap);
     return result;
 }
 
-/* extname(path: string): string */
-static napi_value path_extname(napi_env env, napi_callback_info info) {
-    size_t argc = 1;
-    napi_value argv[1];
+/* pathTableGet(handle, id: number | Uint32Array | number[]): string | string[] */
+static napi_value path_table_get(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
     NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
 
-    if (argc < 1) {
-        napi_throw_type_error(env, NULL, "Path required");
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Path table and id required");
         return NULL;
     }
+    zfo_path_table_t* table = get_path_table(env, argv[0]);
+    if (!table) return NULL;
+
+    bool is_typed = false, is_array = false;
+    napi_is_typedarray(env, argv[1], &is_typed);
+    napi_is_array(env, argv[1], &is_array);
+
+    if (is_typed) {
+        napi_typedarray_type type;
+        size_t count;
+        void* data;
+        NAPI_CALL(napi_get_typedarray_info(env, argv[1], &type, &count, &data, NULL, NULL));
+        if (type != napi_uint32_array) {
+            napi_throw_type_error(env, NULL, "Ids must be a Uint32Array");
+            return NULL;
+        }
+
+        const uint32_t* ids = data;
+        napi_value arr;
+        napi_create_array_with_length(env, count, &arr);
+        for (size_t i = 0; i < count; i++) {
+            if (zfo_path_table_parent(table, ids[i]) == UINT32_MAX) {
+                napi_throw_range_error(env, NULL, "Unknown path id");
+                return NULL;
+            }
+            napi_value str = path_table_string(env, table, ids[i]);
+            if (!str) return NULL;
+            napi_set_element(env, arr, (uint32_t)i, str);
+        }
+        return arr;
+    }
 
-    char path[4096];
-    size_t path_len;
-    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
-
-    char result_buf[256];
-    zfo_extname(path, result_buf, sizeof(result_buf));
+    if (is_array) {
+        uint32_t count;
+        napi_get_array_length(env, argv[1], &count);
+        napi_value arr;
+        napi_create_array_with_length(env, count, &arr);
+        for (uint32_t i = 0; i < count; i++) {
+            napi_value el;
+            uint32_t id;
+            napi_get_element(env, argv[1], i, &el);
+            if (!get_path_id(env, table, el, &id)) return NULL;
+            napi_value str = path_table_string(env, table, id);
+            if (!str) return NULL;
+            napi_set_element(env, arr, i, str);
+        }
+        return arr;
+    }
 
-    napi_value result;
-    napi_create_string_utf8(env, result_buf, NAPI_AUTO_LENGTH, &result);
-    return result;
+    uint32_t id;
+    if (!get_path_id(env, table, argv[1], &id)) return NULL;
+    return path_table_string(env, table, id);
 }
 
-/* join(base: string, path: string): string */
-static napi_value path_join(napi_env env, napi_callback_info info) {
+/* pathTableParent(handle, id: number): number */
+static napi_value path_table_parent(napi_env env, napi_callback_info info) {
     size_t argc = 2;
     napi_value argv[2];
     NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
 
     if (argc < 2) {
-        napi_throw_type_error(env, NULL, "At least two paths required");
+        napi_throw_type_error(env, NULL, "Path table and id required");
         return NULL;
     }
-
-    char base[4096], path[4096];
-    size_t len;
-    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], base, sizeof(base), &len));
-    NAPI_CALL(napi_get_value_string_utf8(env, argv[1], path, sizeof(path), &len));
-
-    char result_buf[4096];
-    zfo_join(result_buf, sizeof(result_buf), base, path);
+    zfo_path_table_t* table = get_path_table(env, argv[0]);
+    uint32_t id;
+    if (!table || !get_path_id(env, table, argv[1], &id)) return NULL;
 
     napi_value result;
-    napi_create_string_utf8(env, result_buf, NAPI_AUTO_LENGTH, &result);
+    napi_create_uint32(env, zfo_path_table_parent(table, id), &result);
     return result;
 }
 
-/* normalize(path: string): string */
-static napi_value path_normalize(napi_env env, napi_callback_info info) {
-    size_t argc = 1;
-    napi_value argv[1];
+/* pathTableName(handle, id: number): string */
+static napi_value path_table_name(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
     NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
 
-    if (argc < 1) {
-        napi_throw_type_error(env, NULL, "Path required");
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Path table and id required");
         return NULL;
     }
+    zfo_path_table_t* table = get_path_table(env, argv[0]);
+    uint32_t id;
+    if (!table || !get_path_id(env, table, argv[1], &id)) return NULL;
 
-    char path[4096];
-    size_t path_len;
-    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
-
-    char result_buf[4096];
-    zfo_normalize(path, result_buf, sizeof(result_buf));
-
+    size_t len;
+    const char* name = zfo_path_table_name(table, id, &len);
     napi_value result;
-    napi_create_string_utf8(env, result_buf, NAPI_AUTO_LENGTH, &result);
+    napi_create_string_utf8(env, name, len, &result);
     return result;
 }
 
-/* resolve(path: string): string */
-static napi_value path_resolve(napi_env env, napi_callback_info info) {
+/* pathTableStats(handle): {paths, names, bytes} */
+static napi_value path_table_stats(napi_env env, napi_callback_info info) {
     size_t argc = 1;
     napi_value argv[1];
     NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
 
-    if (argc < 1) {
-        napi_throw_type_error(env, NULL, "Path required");
-        return NULL;
-    }
-
-    char path[4096];
-    size_t path_len;
-    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
+    zfo_path_table_t* table = argc >= 1 ? get_path_table(env, argv[0]) : NULL;
+    if (!table) return NULL;
 
-    char result_buf[4096];
-    int rc = zfo_realpath(path, result_buf, sizeof(result_buf));
-    if (rc != ZFO_OK) {
-        napi_throw_error(env, NULL, get_error_string());
-        return NULL;
-    }
+    zfo_path_table_stats_t st;
+    zfo_path_table_stats(table, &st);
 
-    napi_value result;
-    napi_create_string_utf8(env, result_buf, NAPI_AUTO_LENGTH, &result);
-    return result;
+    napi_value obj;
+    napi_create_object(env, &obj);
+    set_named_double(env, obj, "paths", (double)st.paths);
+    set_named_double(env, obj, "names", (double)st.names);
+    set_named_double(env, obj, "bytes", (double)st.bytes);
+    return obj;
 }
 
-/* isAbsolute(path: string): boolean */
-static napi_value path_is_absolute(napi_env env, napi_callback_info info) {
+/* pathTableClose(handle): void */
+static napi_value path_table_close(napi_env env, napi_callback_info info) {
     size_t argc = 1;
     napi_value argv[1];
     NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
 
-    if (argc < 1) {
-        napi_throw_type_error(env, NULL, "Path required");
+    js_path_table_t* js = NULL;
+    if (argc < 1 || napi_get_value_external(env, argv[0], (void**)&js) != napi_ok || !js) {
+        napi_throw_type_error(env, NULL, "Invalid path table handle");
         return NULL;
     }
+    zfo_path_table_destroy(js->table);
+    js->table = NULL;
 
-    char path[4096];
-    size_t path_len;
-    NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
-
-    /* Simple check: absolute path starts with / on Unix */
-    napi_value result;
-    napi_get_boolean(env, path[0] == '/', &result);
-    return result;
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
 }
 
 /* ============================================================
@@ -994,6 +6446,82 @@ static napi_value glob_paths(napi_env env, napi_callback_info info) {
     return arr;
 }
 
+/* globWalk(root: string, patterns: string[], options: object, onBatch: (entries) => boolean|void): Promise<TreeResult> */
+static napi_value glob_walk(napi_env env, napi_callback_info info) {
+    size_t argc = 4;
+    napi_value argv[4];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    napi_valuetype cb_type = napi_undefined;
+    if (argc >= 4) napi_typeof(env, argv[3], &cb_type);
+    if (argc < 4 || cb_type != napi_function) {
+        napi_throw_type_error(env, NULL, "Root, patterns, options and batch callback required");
+        return NULL;
+    }
+
+    zfo_glob_set_t* set = compile_glob_set(env, argv[1], argv[2]);
+    if (!set) return NULL;
+
+    walk_job_t* job = walk_job_new(env, argv[0], argv[2], false);
+    if (!job) {
+        zfo_glob_set_free(set);
+        return NULL;
+    }
+    job->glob = set;
+
+    napi_valuetype opt_type;
+    napi_typeof(env, argv[2], &opt_type);
+    if (opt_type == napi_object) {
+        job->ignore = get_opt_string_list(env, argv[2], "ignore", &job->glob_opts.ignore_count);
+        job->ignore_files = get_opt_string_list(env, argv[2], "ignoreFiles",
+                                                &job->glob_opts.ignore_file_count);
+    }
+    job->glob_opts.ignore = (const char* const*)job->ignore;
+    job->glob_opts.ignore_files = (const char* const*)job->ignore_files;
+
+    return walk_job_start(env, job, argv[3], "pulsar.globWalk");
+}
+
+/* globMatch(paths: string[], patterns: string[], options?: object): boolean[] */
+static napi_value glob_match(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    bool is_array = false;
+    if (argc >= 2) napi_is_array(env, argv[0], &is_array);
+    if (!is_array) {
+        napi_throw_type_error(env, NULL, "Paths and patterns arrays required");
+        return NULL;
+    }
+
+    zfo_glob_set_t* set = compile_glob_set(env, argv[1], argc > 2 ? argv[2] : NULL);
+    if (!set) return NULL;
+
+    uint32_t len;
+    napi_get_array_length(env, argv[0], &len);
+    napi_value arr;
+    napi_create_array_with_length(env, len, &arr);
+
+    char path[4096];
+    for (uint32_t i = 0; i < len; i++) {
+        napi_value el, val;
+        size_t plen = 0;
+        napi_get_element(env, argv[0], i, &el);
+        bool ok = false;
+        if (napi_get_value_string_utf8(env, el, path, sizeof(path), &plen) == napi_ok) {
+            /* A trailing '/' marks a directory */
+            bool is_dir = plen > 0 && path[plen - 1] == '/';
+            ok = zfo_glob_set_match(set, path, is_dir);
+        }
+        napi_get_boolean(env, ok, &val);
+        napi_set_element(env, arr, i, val);
+    }
+
+    zfo_glob_set_free(set);
+    return arr;
+}
+
 /* ============================================================
  * Watch (inotify wrapper)
  * ============================================================ */
@@ -1008,19 +6536,17 @@ typedef struct {
     uint32_t count;
 } watch_poll_data_t;
 
-static void watch_poll_callback(const zfo_watch_data_t* data, void* userdata) {
-    watch_poll_data_t* poll_data = (watch_poll_data_t*)userdata;
-    napi_env env = poll_data->env;
-
+static napi_value create_watch_event(napi_env env, zfo_watch_event_t event, const char* path,
+                                     const char* old_path, uint32_t cookie, bool is_dir) {
     napi_value obj;
     napi_create_object(env, &obj);
 
     napi_value event_val, path_val, old_path_val, is_dir_val, cookie_val;
-    napi_create_int32(env, (int32_t)data->event, &event_val);
-    napi_create_string_utf8(env, data->path, NAPI_AUTO_LENGTH, &path_val);
-    napi_create_string_utf8(env, data->old_path, NAPI_AUTO_LENGTH, &old_path_val);
-    napi_get_boolean(env, data->is_dir, &is_dir_val);
-    napi_create_uint32(env, data->cookie, &cookie_val);
+    napi_create_int32(env, (int32_t)event, &event_val);
+    napi_create_string_utf8(env, path, NAPI_AUTO_LENGTH, &path_val);
+    napi_create_string_utf8(env, old_path, NAPI_AUTO_LENGTH, &old_path_val);
+    napi_get_boolean(env, is_dir, &is_dir_val);
+    napi_create_uint32(env, cookie, &cookie_val);
 
     napi_set_named_property(env, obj, "event", event_val);
     napi_set_named_property(env, obj, "path", path_val);
@@ -1030,17 +6556,25 @@ static void watch_poll_callback(const zfo_watch_data_t* data, void* userdata) {
 
     /* Event type helpers */
     napi_value isCreate, isDelete, isModify, isMove;
-    napi_get_boolean(env, data->event == ZFO_EVENT_CREATE, &isCreate);
-    napi_get_boolean(env, data->event == ZFO_EVENT_DELETE, &isDelete);
-    napi_get_boolean(env, data->event == ZFO_EVENT_MODIFY, &isModify);
-    napi_get_boolean(env, data->event == ZFO_EVENT_MOVE_FROM || data->event == ZFO_EVENT_MOVE_TO, &isMove);
+    napi_get_boolean(env, event == ZFO_EVENT_CREATE, &isCreate);
+    napi_get_boolean(env, event == ZFO_EVENT_DELETE, &isDelete);
+    napi_get_boolean(env, event == ZFO_EVENT_MODIFY, &isModify);
+    napi_get_boolean(env, event == ZFO_EVENT_MOVE_FROM || event == ZFO_EVENT_MOVE_TO ||
+                          event == ZFO_EVENT_RENAME, &isMove);
 
     napi_set_named_property(env, obj, "isCreate", isCreate);
     napi_set_named_property(env, obj, "isDelete", isDelete);
     napi_set_named_property(env, obj, "isModify", isModify);
     napi_set_named_property(env, obj, "isMove", isMove);
 
-    napi_set_element(env, poll_data->arr, poll_data->count++, obj);
+    return obj;
+}
+
+static void watch_poll_callback(const zfo_watch_data_t* data, void* userdata) {
+    watch_poll_data_t* poll_data = (watch_poll_data_t*)userdata;
+    napi_value obj = create_watch_event(poll_data->env, data->event, data->path,
+                                        data->old_path, data->cookie, data->is_dir);
+    napi_set_element(poll_data->env, poll_data->arr, poll_data->count++, obj);
 }
 
 /* watchInit(): void */
@@ -1064,10 +6598,10 @@ static napi_value watch_init(napi_env env, napi_callback_info info) {
     return undefined;
 }
 
-/* watchAdd(path: string): number */
+/* watchAdd(path: string, recursive?: boolean): number */
 static napi_value watch_add(napi_env env, napi_callback_info info) {
-    size_t argc = 1;
-    napi_value argv[1];
+    size_t argc = 2;
+    napi_value argv[2];
     NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
 
     if (argc < 1) {
@@ -1084,7 +6618,10 @@ static napi_value watch_add(napi_env env, napi_callback_info info) {
     size_t path_len;
     NAPI_CALL(napi_get_value_string_utf8(env, argv[0], path, sizeof(path), &path_len));
 
-    int wd = zfo_watch_add(g_watcher, path, ZFO_EVENT_ALL, false);
+    bool recursive = false;
+    if (argc >= 2) napi_get_value_bool(env, argv[1], &recursive);
+
+    int wd = zfo_watch_add(g_watcher, path, ZFO_EVENT_ALL, recursive);
     if (wd < 0) {
         napi_throw_error(env, NULL, get_error_string());
         return NULL;
@@ -1169,6 +6706,266 @@ static napi_value watch_close(napi_env env, napi_callback_info info) {
     return undefined;
 }
 
+/* ============================================================
+ * Event-Driven Watcher
+ * ============================================================ */
+
+#define WATCHER_DEFAULT_EVENTS (ZFO_EVENT_CREATE | ZFO_EVENT_DELETE | ZFO_EVENT_MODIFY | \
+                                ZFO_EVENT_ATTRIB | ZFO_EVENT_RENAME)
+
+/*
+ * Owned jointly by the external handle and the threadsafe function;
+ * both finalizers run on the JS thread, so refs needs no atomics.
+ */
+typedef struct {
+    zfo_watcher_t* watcher;
+    napi_threadsafe_function tsfn;
+    int refs;
+    bool closed;
+} js_watcher_t;
+
+typedef struct {
+    zfo_watch_change_t* changes;
+    size_t count;
+} js_watch_batch_t;
+
+static void js_watcher_unref(js_watcher_t* jw) {
+    if (--jw->refs == 0) free(jw);
+}
+
+static void js_watcher_close(js_watcher_t* jw) {
+    if (jw->closed) return;
+    jw->closed = true;
+
+    /* Joins the event thread: no batches are produced after this */
+    zfo_watcher_destroy(jw->watcher);
+    jw->watcher = NULL;
+    napi_release_threadsafe_function(jw->tsfn, napi_tsfn_release);
+}
+
+/* Runs on the watcher thread */
+static void watcher_on_batch(zfo_watch_change_t* changes, size_t count, void* userdata) {
+    js_watcher_t* jw = userdata;
+    js_watch_batch_t* batch = malloc(sizeof(js_watch_batch_t));
+    if (!batch) {
+        zfo_watch_changes_free(changes, count);
+        return;
+    }
+    batch->changes = changes;
+    batch->count = count;
+
+    /* Unbounded queue: never blocks, so close() can join without deadlock */
+    if (napi_call_threadsafe_function(jw->tsfn, batch, napi_tsfn_nonblocking) != napi_ok) {
+        zfo_watch_changes_free(changes, count);
+        free(batch);
+    }
+}
+
+static void watcher_call_js(napi_env env, napi_value callback, void* context, void* data) {
+    js_watcher_t* jw = context;
+    js_watch_batch_t* batch = data;
+
+    if (!env || jw->closed) {
+        zfo_watch_changes_free(batch->changes, batch->count);
+        free(batch);
+        return;
+    }
+
+    napi_value arr, val;
+    napi_create_array_with_length(env, batch->count, &arr);
+    for (size_t i = 0; i < batch->count; i++) {
+        const zfo_watch_change_t* c = &batch->changes[i];
+        napi_value obj = create_watch_event(env, c->event, c->path, c->old_path ? c->old_path : "",
+                                            c->cookie, c->is_dir);
+        napi_create_uint32(env, c->count, &val);
+        napi_set_named_property(env, obj, "count", val);
+        napi_set_element(env, arr, (uint32_t)i, obj);
+    }
+    zfo_watch_changes_free(batch->changes, batch->count);
+    free(batch);
+
+    /* A throwing listener surfaces as an uncaught exception, like fs.watch */
+    napi_value global, ret;
+    napi_get_global(env, &global);
+    napi_call_function(env, global, callback, 1, &arr, &ret);
+}
+
+static void watcher_tsfn_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)hint;
+    js_watcher_unref(data);
+}
+
+static void watcher_handle_finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    (void)hint;
+    js_watcher_t* jw = data;
+    js_watcher_close(jw);
+    js_watcher_unref(jw);
+}
+
+static js_watcher_t* get_js_watcher(napi_env env, napi_value handle) {
+    js_watcher_t* jw = NULL;
+    if (napi_get_value_external(env, handle, (void**)&jw) != napi_ok || !jw) {
+        napi_throw_type_error(env, NULL, "Invalid watcher handle");
+        return NULL;
+    }
+    if (jw->closed) {
+        napi_throw_error(env, NULL, "Watcher is closed");
+        return NULL;
+    }
+    return jw;
+}
+
+/* watcherCreate(onBatch: (changes) => void, options?: object): handle */
+static napi_value watcher_create(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    napi_valuetype cb_type = napi_undefined;
+    if (argc >= 1) napi_typeof(env, argv[0], &cb_type);
+    if (cb_type != napi_function) {
+        napi_throw_type_error(env, NULL, "Batch callback required");
+        return NULL;
+    }
+
+    zfo_watcher_options_t opts = {0};
+    bool persistent = true;
+    napi_valuetype opt_type = napi_undefined;
+    if (argc >= 2) napi_typeof(env, argv[1], &opt_type);
+    if (opt_type == napi_object) {
+        int32_t debounce = get_opt_int32(env, argv[1], "debounce", 0);
+        int32_t latency = get_opt_int32(env, argv[1], "maxLatency", 0);
+        int32_t max_batch = get_opt_int32(env, argv[1], "maxBatch", 0);
+        opts.debounce_ms = debounce > 0 ? (uint32_t)debounce : 0;
+        opts.max_latency_ms = latency > 0 ? (uint32_t)latency : 0;
+        opts.max_batch = max_batch > 0 ? (size_t)max_batch : 0;
+        persistent = get_opt_bool(env, argv[1], "persistent", true);
+    }
+
+    js_watcher_t* jw = calloc(1, sizeof(js_watcher_t));
+    if (!jw) {
+        napi_throw_error(env, NULL, "Out of memory");
+        return NULL;
+    }
+
+    napi_value name;
+    napi_create_string_utf8(env, "pulsar.watcher", NAPI_AUTO_LENGTH, &name);
+    if (napi_create_threadsafe_function(env, argv[0], NULL, name, 0, 1, jw,
+                                        watcher_tsfn_finalize, jw, watcher_call_js,
+                                        &jw->tsfn) != napi_ok) {
+        free(jw);
+        napi_throw_error(env, NULL, "Failed to initialize watcher");
+        return NULL;
+    }
+    jw->refs = 1;
+
+    opts.on_batch = watcher_on_batch;
+    opts.userdata = jw;
+    jw->watcher = zfo_watcher_create(&opts);
+    if (!jw->watcher) {
+        jw->closed = true;
+        napi_release_threadsafe_function(jw->tsfn, napi_tsfn_release);
+        napi_throw_error(env, NULL, "Failed to initialize watcher");
+        return NULL;
+    }
+    if (!persistent) napi_unref_threadsafe_function(env, jw->tsfn);
+
+    napi_value handle;
+    if (napi_create_external(env, jw, watcher_handle_finalize, NULL, &handle) != napi_ok) {
+        js_watcher_close(jw);
+        napi_throw_error(env, NULL, "Failed to initialize watcher");
+        return NULL;
+    }
+    jw->refs++;
+    return handle;
+}
+
+/* watcherAdd(handle, path: string, options?: { recursive?, events? }): number */
+static napi_value watcher_add(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Watcher and path required");
+        return NULL;
+    }
+
+    js_watcher_t* jw = get_js_watcher(env, argv[0]);
+    if (!jw) return NULL;
+
+    char path[4096];
+    size_t path_len;
+    NAPI_CALL(napi_get_value_string_utf8(env, argv[1], path, sizeof(path), &path_len));
+
+    bool recursive = false;
+    int32_t events = WATCHER_DEFAULT_EVENTS;
+    napi_valuetype opt_type = napi_undefined;
+    if (argc >= 3) napi_typeof(env, argv[2], &opt_type);
+    if (opt_type == napi_object) {
+        recursive = get_opt_bool(env, argv[2], "recursive", false);
+        events = get_opt_int32(env, argv[2], "events", WATCHER_DEFAULT_EVENTS);
+    }
+
+    int wd = zfo_watcher_add(jw->watcher, path, events, recursive);
+    if (wd < 0) {
+        throw_zfo_error(env, wd);
+        return NULL;
+    }
+
+    napi_value result;
+    napi_create_int32(env, wd, &result);
+    return result;
+}
+
+/* watcherRemove(handle, wd: number): void */
+static napi_value watcher_remove(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Watcher and watch descriptor required");
+        return NULL;
+    }
+
+    js_watcher_t* jw = get_js_watcher(env, argv[0]);
+    if (!jw) return NULL;
+
+    int32_t wd;
+    NAPI_CALL(napi_get_value_int32(env, argv[1], &wd));
+
+    int rc = zfo_watcher_remove(jw->watcher, wd);
+    if (rc != ZFO_OK) {
+        throw_zfo_error(env, rc);
+        return NULL;
+    }
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
+/* watcherClose(handle): void */
+static napi_value watcher_close(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+
+    js_watcher_t* jw = NULL;
+    if (argc < 1 || napi_get_value_external(env, argv[0], (void**)&jw) != napi_ok || !jw) {
+        napi_throw_type_error(env, NULL, "Invalid watcher handle");
+        return NULL;
+    }
+    js_watcher_close(jw);
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    return undefined;
+}
+
 /* ============================================================
  * Module Registration
  * ============================================================ */
@@ -1194,6 +6991,123 @@ static napi_value Init(napi_env env, napi_value exports) {
     EXPORT_FUNCTION("remove", remove_path);
     EXPORT_FUNCTION("removeRecursive", remove_recursive);
 
+    /* Parallel Tree Operations */
+    EXPORT_FUNCTION("removeTree", remove_tree);
+    EXPORT_FUNCTION("copyTree", copy_tree);
+    EXPORT_FUNCTION("moveTree", move_tree);
+
+    /* Parallel Walker */
+    EXPORT_FUNCTION("walk", walk_tree);
+
+    /* Content Search */
+    EXPORT_FUNCTION("search", search_files);
+
+    /* Duplicate Finder */
+    EXPORT_FUNCTION("findDuplicates", find_duplicates);
+
+    /* Directory Snapshot */
+    EXPORT_FUNCTION("snapshotCreate", snapshot_create);
+    EXPORT_FUNCTION("snapshotLoad", snapshot_load);
+    EXPORT_FUNCTION("snapshotSave", snapshot_save);
+    EXPORT_FUNCTION("snapshotUpdate", snapshot_update);
+    EXPORT_FUNCTION("snapshotApply", snapshot_apply);
+    EXPORT_FUNCTION("snapshotGet", snapshot_get);
+    EXPORT_FUNCTION("snapshotEntries", snapshot_entries);
+    EXPORT_FUNCTION("snapshotInfo", snapshot_info);
+    EXPORT_FUNCTION("snapshotClose", snapshot_close);
+
+    /* Group-Commit Writes */
+    EXPORT_FUNCTION("writeFilesAtomic", write_files_atomic);
+
+    /* Write-Ahead Log */
+    EXPORT_FUNCTION("walOpen", wal_open);
+    EXPORT_FUNCTION("walAppend", wal_append);
+    EXPORT_FUNCTION("walFlush", wal_flush);
+    EXPORT_FUNCTION("walSync", wal_sync);
+    EXPORT_FUNCTION("walTruncate", wal_truncate);
+    EXPORT_FUNCTION("walStats", wal_stats);
+    EXPORT_FUNCTION("walClose", wal_close);
+    EXPORT_FUNCTION("walReplay", wal_replay);
+
+    /* Key-Value Store */
+    EXPORT_FUNCTION("kvOpen", kv_open);
+    EXPORT_FUNCTION("kvGet", kv_get);
+    EXPORT_FUNCTION("kvPut", kv_put);
+    EXPORT_FUNCTION("kvDelete", kv_delete);
+    EXPORT_FUNCTION("kvHas", kv_has);
+    EXPORT_FUNCTION("kvKeys", kv_keys);
+    EXPORT_FUNCTION("kvSync", kv_sync);
+    EXPORT_FUNCTION("kvStats", kv_stats);
+    EXPORT_FUNCTION("kvMerge", kv_merge);
+    EXPORT_FUNCTION("kvClose", kv_close);
+
+    /* File Handles */
+    EXPORT_FUNCTION("fileOpen", file_open);
+    EXPORT_FUNCTION("fileRead", file_read);
+    EXPORT_FUNCTION("fileWrite", file_write);
+    EXPORT_FUNCTION("fileReadv", file_readv);
+    EXPORT_FUNCTION("fileWritev", file_writev);
+    EXPORT_FUNCTION("fileWriteBuffered", file_write_buffered);
+    EXPORT_FUNCTION("fileSetBuffer", file_set_buffer);
+    EXPORT_FUNCTION("fileFlush", file_flush);
+    EXPORT_FUNCTION("fileSync", file_sync);
+    EXPORT_FUNCTION("fileDatasync", file_datasync);
+    EXPORT_FUNCTION("fileSeek", file_seek);
+    EXPORT_FUNCTION("fileStat", file_stat);
+    EXPORT_FUNCTION("fileTruncate", file_truncate);
+    EXPORT_FUNCTION("fileAdvise", file_advise);
+    EXPORT_FUNCTION("fileAllocate", file_allocate);
+    EXPORT_FUNCTION("fileLock", file_lock);
+    EXPORT_FUNCTION("fileUnlock", file_unlock);
+    EXPORT_FUNCTION("fileClose", file_close);
+
+    /* Chunked Reader */
+    EXPORT_FUNCTION("readerOpen", reader_open);
+    EXPORT_FUNCTION("readerNext", reader_next);
+    EXPORT_FUNCTION("readerNextSync", reader_next_sync);
+    EXPORT_FUNCTION("readerRelease", reader_release);
+    EXPORT_FUNCTION("readerInfo", reader_info);
+    EXPORT_FUNCTION("readerClose", reader_close);
+
+    /* Content Cache */
+    EXPORT_FUNCTION("cacheCreate", cache_create);
+    EXPORT_FUNCTION("cacheRead", cache_read);
+    EXPORT_FUNCTION("cacheInvalidate", cache_invalidate);
+    EXPORT_FUNCTION("cacheClear", cache_clear);
+    EXPORT_FUNCTION("cacheStats", cache_stats);
+    EXPORT_FUNCTION("cacheClose", cache_close);
+
+    /* Shared-Memory Channel */
+    EXPORT_FUNCTION("channelCreate", channel_create);
+    EXPORT_FUNCTION("channelOpen", channel_open);
+    EXPORT_FUNCTION("channelInfo", channel_info);
+    EXPORT_FUNCTION("channelSend", channel_send);
+    EXPORT_FUNCTION("channelReserve", channel_reserve);
+    EXPORT_FUNCTION("channelCommit", channel_commit);
+    EXPORT_FUNCTION("channelReceive", channel_receive);
+    EXPORT_FUNCTION("channelRelease", channel_release);
+    EXPORT_FUNCTION("channelWait", channel_wait);
+    EXPORT_FUNCTION("channelClose", channel_close);
+
+    /* Columnar Stat */
+    EXPORT_FUNCTION("statMany", stat_many);
+    EXPORT_FUNCTION("readdirPlus", readdir_plus);
+
+    /* Tar Archives */
+    EXPORT_FUNCTION("tarPack", tar_pack);
+    EXPORT_FUNCTION("tarUnpack", tar_unpack);
+    EXPORT_FUNCTION("tarExtract", tar_extract);
+
+    /* Disk Usage */
+    EXPORT_FUNCTION("duTree", du_tree);
+
+    /* Memory Mapping */
+    EXPORT_FUNCTION("mmap", mmap_path);
+    EXPORT_FUNCTION("mmapSync", mmap_sync);
+    EXPORT_FUNCTION("mmapAdvise", mmap_advise);
+    EXPORT_FUNCTION("mmapLock", mmap_lock);
+    EXPORT_FUNCTION("mmapUnmap", mmap_unmap);
+
     /* Stat Operations */
     EXPORT_FUNCTION("stat", stat_path);
     EXPORT_FUNCTION("lstat", lstat_path);
@@ -1216,6 +7130,17 @@ static napi_value Init(napi_env env, napi_value exports) {
     EXPORT_FUNCTION("normalize", path_normalize);
     EXPORT_FUNCTION("resolve", path_resolve);
     EXPORT_FUNCTION("isAbsolute", path_is_absolute);
+    EXPORT_FUNCTION("relative", path_relative);
+    EXPORT_FUNCTION("pathBatch", path_batch);
+
+    /* Path Table */
+    EXPORT_FUNCTION("pathTableCreate", path_table_create);
+    EXPORT_FUNCTION("pathTableIntern", path_table_intern);
+    EXPORT_FUNCTION("pathTableGet", path_table_get);
+    EXPORT_FUNCTION("pathTableParent", path_table_parent);
+    EXPORT_FUNCTION("pathTableName", path_table_name);
+    EXPORT_FUNCTION("pathTableStats", path_table_stats);
+    EXPORT_FUNCTION("pathTableClose", path_table_close);
 
     /* Symlinks */
     EXPORT_FUNCTION("symlink", create_symlink);
@@ -1233,6 +7158,8 @@ static napi_value Init(napi_env env, napi_value exports) {
 
     /* Glob */
     EXPORT_FUNCTION("glob", glob_paths);
+    EXPORT_FUNCTION("globWalk", glob_walk);
+    EXPORT_FUNCTION("globMatch", glob_match);
 
     /* Watch */
     EXPORT_FUNCTION("watchInit", watch_init);
@@ -1241,6 +7168,12 @@ static napi_value Init(napi_env env, napi_value exports) {
     EXPORT_FUNCTION("watchPoll", watch_poll);
     EXPORT_FUNCTION("watchClose", watch_close);
 
+    /* Event-driven watcher */
+    EXPORT_FUNCTION("watcherCreate", watcher_create);
+    EXPORT_FUNCTION("watcherAdd", watcher_add);
+    EXPORT_FUNCTION("watcherRemove", watcher_remove);
+    EXPORT_FUNCTION("watcherClose", watcher_close);
+
     return exports;
 }
 
@@ -0,0 +1,397 @@
+/**
+ * @file zorya_batch.c
+ * @brief Zorya FileOps - Group-commit atomic writes
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   zfo_atomic_write pays one fsync per file. A batch stages every file
+ *   into a temp file next to its target first, then commits in three
+ *   steps:
+ *
+ *     1. Flush all data at once: one syncfs per filesystem, or start
+ *        writeback on every temp file and then fdatasync them, so the
+ *        device sees one queue of writes instead of a series of flushes.
+ *     2. Rename every temp file over its target.
+ *     3. fsync each affected directory once to make the renames durable.
+ *
+ *   With ZFO_BATCH_TMPFILE temp files are unnamed O_TMPFILE inodes,
+ *   linked into place only after their data is durable, so a crash
+ *   never leaves stray temp files behind.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+#include "dagger.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#define BATCH_NAME_TRIES 100
+
+/* ============================================================
+ * Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    char* path;                     /* Target */
+    char* tmp_path;                 /* Named temp file, NULL for O_TMPFILE */
+    int fd;
+    size_t dir;                     /* Index into dirs */
+} batch_file_t;
+
+typedef struct {
+    char* path;
+    int fd;
+    dev_t dev;
+    bool dirty;                     /* A rename landed here */
+} batch_dir_t;
+
+struct zfo_write_batch {
+    uint32_t flags;
+    batch_file_t* files;
+    size_t count;
+    size_t cap;
+    batch_dir_t* dirs;
+    size_t dir_count;
+    size_t dir_cap;
+    DaggerTable* by_path;           /* Target -> file index + 1 */
+    DaggerTable* by_dir;            /* Directory -> dir index + 1 */
+    unsigned seq;
+};
+
+/* ============================================================
+ * Helpers
+ * ============================================================ */
+
+static int write_all(int fd, const void* buf, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        ssize_t n = write(fd, (const char*)buf + written, size - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return zfo_error_from_errno(errno);
+        }
+        written += (size_t)n;
+    }
+    return ZFO_OK;
+}
+
+static void file_discard(batch_file_t* f) {
+    if (f->fd >= 0) close(f->fd);
+    if (f->tmp_path) unlink(f->tmp_path);
+    free(f->tmp_path);
+    free(f->path);
+    f->fd = -1;
+    f->tmp_path = NULL;
+    f->path = NULL;
+}
+
+/* Open (once) the directory holding path */
+static int batch_dir(zfo_write_batch_t* batch, const char* path, size_t* index) {
+    const char* slash = strrchr(path, '/');
+    size_t len = slash ? (size_t)(slash - path) : 1;
+    if (slash == path) len = 1;
+
+    char dir[PATH_MAX];
+    if (len >= sizeof(dir)) return ZFO_ERR_NAME_TOO_LONG;
+    memcpy(dir, slash ? path : ".", len);
+    dir[len] = '\0';
+
+    void* val;
+    if (dagger_get(batch->by_dir, dir, (uint32_t)len, &val) == DAGGER_OK) {
+        *index = (size_t)(uintptr_t)val - 1;
+        return ZFO_OK;
+    }
+
+    if (batch->dir_count == batch->dir_cap) {
+        size_t ncap = batch->dir_cap ? batch->dir_cap * 2 : 8;
+        batch_dir_t* ndirs = realloc(batch->dirs, ncap * sizeof(batch_dir_t));
+        if (!ndirs) return ZFO_ERR_NO_MEMORY;
+        batch->dirs = ndirs;
+        batch->dir_cap = ncap;
+    }
+
+    batch_dir_t* d = &batch->dirs[batch->dir_count];
+    struct stat st;
+    d->fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (d->fd < 0) return zfo_error_from_errno(errno);
+    if (fstat(d->fd, &st) != 0 || !(d->path = strdup(dir))) {
+        int rc = d->path ? zfo_error_from_errno(errno) : ZFO_ERR_NO_MEMORY;
+        close(d->fd);
+        return rc;
+    }
+    d->dev = st.st_dev;
+    d->dirty = false;
+
+    if (dagger_set(batch->by_dir, d->path, (uint32_t)len,
+                   (void*)(uintptr_t)(batch->dir_count + 1), 1) != DAGGER_OK) {
+        close(d->fd);
+        free(d->path);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    *index = batch->dir_count++;
+    return ZFO_OK;
+}
+
+/* Create a uniquely named file next to path ("<path>.<pid>.<seq>.tmp") */
+static int open_named_temp(zfo_write_batch_t* batch, const char* path, char** out_tmp) {
+    char tmp[PATH_MAX];
+    for (int tries = 0; tries < BATCH_NAME_TRIES; tries++) {
+        int n = snprintf(tmp, sizeof(tmp), "%s.%ld.%u.tmp", path, (long)getpid(), batch->seq++);
+        if (n < 0 || (size_t)n >= sizeof(tmp)) return ZFO_ERR_NAME_TOO_LONG;
+
+        int fd = open(tmp, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+        if (fd >= 0) {
+            *out_tmp = strdup(tmp);
+            if (!*out_tmp) {
+                close(fd);
+                unlink(tmp);
+                return ZFO_ERR_NO_MEMORY;
+            }
+            return fd;
+        }
+        if (errno != EEXIST) return zfo_error_from_errno(errno);
+    }
+    return ZFO_ERR_EXISTS;
+}
+
+/* Give an unnamed O_TMPFILE inode a name next to its target */
+static int link_unnamed(zfo_write_batch_t* batch, batch_file_t* f) {
+    char proc[64];
+    snprintf(proc, sizeof(proc), "/proc/self/fd/%d", f->fd);
+
+    /* No target yet: link straight into place */
+    if (linkat(AT_FDCWD, proc, AT_FDCWD, f->path, AT_SYMLINK_FOLLOW) == 0) return 1;
+    if (errno != EEXIST) return zfo_error_from_errno(errno);
+
+    char tmp[PATH_MAX];
+    for (int tries = 0; tries < BATCH_NAME_TRIES; tries++) {
+        int n = snprintf(tmp, sizeof(tmp), "%s.%ld.%u.tmp", f->path, (long)getpid(), batch->seq++);
+        if (n < 0 || (size_t)n >= sizeof(tmp)) return ZFO_ERR_NAME_TOO_LONG;
+        if (linkat(AT_FDCWD, proc, AT_FDCWD, tmp, AT_SYMLINK_FOLLOW) == 0) {
+            f->tmp_path = strdup(tmp);
+            if (!f->tmp_path) {
+                unlink(tmp);
+                return ZFO_ERR_NO_MEMORY;
+            }
+            return ZFO_OK;
+        }
+        if (errno != EEXIST) return zfo_error_from_errno(errno);
+    }
+    return ZFO_ERR_EXISTS;
+}
+
+/* ============================================================
+ * Public API
+ * ============================================================ */
+
+zfo_write_batch_t* zfo_batch_create(uint32_t flags) {
+    zfo_write_batch_t* batch = calloc(1, sizeof(zfo_write_batch_t));
+    if (!batch) return NULL;
+    batch->flags = flags;
+    batch->by_path = dagger_create(64, NULL);
+    batch->by_dir = dagger_create(16, NULL);
+    if (!batch->by_path || !batch->by_dir) {
+        zfo_batch_free(batch);
+        return NULL;
+    }
+    return batch;
+}
+
+int zfo_batch_add(zfo_write_batch_t* batch, const char* path, const void* buf, size_t size) {
+    if (!batch || !path || !*path || (!buf && size > 0)) return ZFO_ERR_INVALID_ARG;
+
+    size_t dir;
+    int rc = batch_dir(batch, path, &dir);
+    if (rc != ZFO_OK) return rc;
+
+    char* tmp_path = NULL;
+    int fd = -1;
+#ifdef O_TMPFILE
+    if (batch->flags & ZFO_BATCH_TMPFILE) {
+        fd = openat(batch->dirs[dir].fd, ".", O_TMPFILE | O_WRONLY | O_CLOEXEC, 0666);
+        /* Filesystems without O_TMPFILE fall back to named temp files */
+        if (fd < 0 && errno != EOPNOTSUPP && errno != EISDIR && errno != EINVAL) {
+            return zfo_error_from_errno(errno);
+        }
+    }
+#endif
+    if (fd < 0) {
+        fd = open_named_temp(batch, path, &tmp_path);
+        if (fd < 0) return fd;
+    }
+
+    /* Keep the permissions of the file being replaced */
+    struct stat st;
+    if (stat(path, &st) == 0 && S_ISREG(st.st_mode)) fchmod(fd, st.st_mode & 07777);
+
+    rc = write_all(fd, buf, size);
+    if (rc != ZFO_OK) {
+        close(fd);
+        if (tmp_path) unlink(tmp_path);
+        free(tmp_path);
+        return rc;
+    }
+
+    /* A later write to the same target replaces the staged one */
+    void* val;
+    size_t len = strlen(path);
+    if (dagger_get(batch->by_path, path, (uint32_t)len, &val) == DAGGER_OK) {
+        batch_file_t* f = &batch->files[(size_t)(uintptr_t)val - 1];
+        close(f->fd);
+        if (f->tmp_path) unlink(f->tmp_path);
+        free(f->tmp_path);
+        f->fd = fd;
+        f->tmp_path = tmp_path;
+        f->dir = dir;
+        return ZFO_OK;
+    }
+
+    if (batch->count == batch->cap) {
+        size_t ncap = batch->cap ? batch->cap * 2 : 64;
+        batch_file_t* nfiles = realloc(batch->files, ncap * sizeof(batch_file_t));
+        if (!nfiles) {
+            rc = ZFO_ERR_NO_MEMORY;
+            goto fail;
+        }
+        batch->files = nfiles;
+        batch->cap = ncap;
+    }
+
+    batch_file_t* f = &batch->files[batch->count];
+    f->path = strdup(path);
+    if (!f->path) {
+        rc = ZFO_ERR_NO_MEMORY;
+        goto fail;
+    }
+    if (dagger_set(batch->by_path, f->path, (uint32_t)len,
+                   (void*)(uintptr_t)(batch->count + 1), 1) != DAGGER_OK) {
+        free(f->path);
+        rc = ZFO_ERR_NO_MEMORY;
+        goto fail;
+    }
+    f->fd = fd;
+    f->tmp_path = tmp_path;
+    f->dir = dir;
+    batch->count++;
+    return ZFO_OK;
+
+fail:
+    close(fd);
+    if (tmp_path) unlink(tmp_path);
+    free(tmp_path);
+    return rc;
+}
+
+size_t zfo_batch_count(const zfo_write_batch_t* batch) {
+    return batch ? batch->count : 0;
+}
+
+static int batch_flush(zfo_write_batch_t* batch, zfo_batch_stats_t* stats) {
+#ifdef __linux__
+    if (batch->flags & ZFO_BATCH_SYNCFS) {
+        for (size_t i = 0; i < batch->dir_count; i++) {
+            bool seen = false;
+            for (size_t k = 0; k < i && !seen; k++) seen = batch->dirs[k].dev == batch->dirs[i].dev;
+            if (seen) continue;
+            if (syncfs(batch->dirs[i].fd) != 0) return zfo_error_from_errno(errno);
+            stats->flushes++;
+        }
+        return ZFO_OK;
+    }
+
+    /* Queue writeback for everything before waiting on any of it */
+    for (size_t i = 0; i < batch->count; i++) {
+        sync_file_range(batch->files[i].fd, 0, 0, SYNC_FILE_RANGE_WRITE);
+    }
+#endif
+    for (size_t i = 0; i < batch->count; i++) {
+        if (fdatasync(batch->files[i].fd) != 0) return zfo_error_from_errno(errno);
+        stats->flushes++;
+    }
+    return ZFO_OK;
+}
+
+static void batch_reset(zfo_write_batch_t* batch) {
+    for (size_t i = 0; i < batch->count; i++) file_discard(&batch->files[i]);
+    batch->count = 0;
+    dagger_clear(batch->by_path);
+    for (size_t i = 0; i < batch->dir_count; i++) {
+        close(batch->dirs[i].fd);
+        free(batch->dirs[i].path);
+    }
+    batch->dir_count = 0;
+    dagger_clear(batch->by_dir);
+}
+
+int zfo_batch_commit(zfo_write_batch_t* batch, zfo_batch_stats_t* stats) {
+    zfo_batch_stats_t local;
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+    if (!batch) return ZFO_ERR_INVALID_ARG;
+
+    int rc = batch_flush(batch, stats);
+
+    for (size_t i = 0; i < batch->count && rc == ZFO_OK; i++) {
+        batch_file_t* f = &batch->files[i];
+        if (!f->tmp_path) {
+            int linked = link_unnamed(batch, f);
+            if (linked < 0) {
+                rc = linked;
+                break;
+            }
+            if (linked == 1) {
+                batch->dirs[f->dir].dirty = true;
+                stats->files++;
+                continue;
+            }
+        }
+        if (rename(f->tmp_path, f->path) != 0) {
+            rc = zfo_error_from_errno(errno);
+            break;
+        }
+        free(f->tmp_path);
+        f->tmp_path = NULL;
+        batch->dirs[f->dir].dirty = true;
+        stats->files++;
+    }
+
+    /* Renames that did land are made durable even if a later one failed */
+    for (size_t i = 0; i < batch->dir_count; i++) {
+        if (!batch->dirs[i].dirty) continue;
+        if (fsync(batch->dirs[i].fd) != 0 && rc == ZFO_OK) rc = zfo_error_from_errno(errno);
+        stats->dir_syncs++;
+    }
+
+    batch_reset(batch);
+    return rc;
+}
+
+void zfo_batch_abort(zfo_write_batch_t* batch) {
+    if (batch) batch_reset(batch);
+}
+
+void zfo_batch_free(zfo_write_batch_t* batch) {
+    if (!batch) return;
+    if (batch->by_path && batch->by_dir) batch_reset(batch);
+    free(batch->files);
+    free(batch->dirs);
+    if (batch->by_path) dagger_destroy(batch->by_path);
+    if (batch->by_dir) dagger_destroy(batch->by_dir);
+    free(batch);
+}
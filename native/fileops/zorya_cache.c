@@ -0,0 +1,566 @@
+/**
+ * @file zorya_cache.c
+ * @brief Zorya FileOps - Read-through file content cache
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   Keeps whole-file contents in memory keyed by path. A hit costs one
+ *   stat, compared against the (dev, inode, mtime_ns, size) the entry
+ *   was read with, instead of open/fstat/read/close and a copy. With
+ *   ZFO_CACHE_NO_VALIDATE even the stat is skipped and the owner is
+ *   expected to invalidate entries, typically from a watcher.
+ *
+ *   Contents live in reference-counted blobs so a caller can keep
+ *   using one after the cache has evicted or replaced it. Eviction is
+ *   CLOCK: entries sit on a ring, a hit sets the entry's reference bit
+ *   and the hand clears bits until it finds an entry without one.
+ *
+ *   File I/O and compression run outside the lock; only the table
+ *   lookups and the ring are serialized.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+#include "nxh.h"
+#include "zstd.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#define CACHE_DEFAULT_BYTES    (64u * 1024 * 1024)
+#define CACHE_DEFAULT_LEVEL    3
+#define CACHE_INITIAL_BUCKETS  256
+#define CACHE_STORED_BLOCK     (128u * 1024)    /* zstd maximum block size */
+
+/* ============================================================
+ * Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    uint64_t dev;
+    uint64_t ino;
+    int64_t mtime_ns;
+    uint64_t size;
+} cache_ident_t;
+
+typedef struct cache_entry {
+    char* path;
+    size_t path_len;
+    uint64_t hash;
+    cache_ident_t ident;
+    zfo_cache_blob_t* blobs[2];     /* Indexed by zfo_cache_variant_t */
+    bool referenced;
+    bool incompressible;            /* zstd gained nothing; store raw blocks */
+    struct cache_entry* chain;      /* Bucket chain */
+    struct cache_entry* prev;       /* CLOCK ring */
+    struct cache_entry* next;
+} cache_entry_t;
+
+struct zfo_cache {
+    zfo_cache_options_t opts;
+    pthread_mutex_t lock;
+    cache_entry_t** buckets;
+    size_t bucket_count;            /* Power of two */
+    cache_entry_t* hand;
+    zfo_cache_stats_t stats;
+};
+
+/* ============================================================
+ * Blobs
+ * ============================================================ */
+
+static zfo_cache_blob_t* blob_new(uint8_t* data, size_t size) {
+    zfo_cache_blob_t* blob = calloc(1, sizeof(zfo_cache_blob_t));
+    if (!blob) return NULL;
+    blob->data = data;
+    blob->size = size;
+    blob->refs = 1;
+    return blob;
+}
+
+void zfo_cache_blob_retain(zfo_cache_blob_t* blob) {
+    if (blob) ZFO_ATOMIC_ADD(&blob->refs, 1);
+}
+
+void zfo_cache_blob_release(zfo_cache_blob_t* blob) {
+    if (blob && ZFO_ATOMIC_SUB(&blob->refs, 1) == 0) {
+        free(blob->data);
+        free(blob);
+    }
+}
+
+/* Give up the cache's reference, letting the caller drop its wrapper */
+static void cache_drop_blob(zfo_cache_t* cache, zfo_cache_blob_t* blob) {
+    if (!blob) return;
+    cache->stats.bytes -= blob->size;
+    if (blob->user && cache->opts.release) cache->opts.release(blob, cache->opts.userdata);
+    blob->user = NULL;
+    zfo_cache_blob_release(blob);
+}
+
+/* ============================================================
+ * Table and Ring
+ * ============================================================ */
+
+static cache_entry_t** cache_slot(zfo_cache_t* cache, const char* path, size_t len, uint64_t hash) {
+    cache_entry_t** slot = &cache->buckets[hash & (cache->bucket_count - 1)];
+    while (*slot) {
+        cache_entry_t* e = *slot;
+        if (e->hash == hash && e->path_len == len && memcmp(e->path, path, len) == 0) break;
+        slot = &e->chain;
+    }
+    return slot;
+}
+
+static void cache_grow(zfo_cache_t* cache) {
+    size_t ncount = cache->bucket_count * 2;
+    cache_entry_t** nb = calloc(ncount, sizeof(cache_entry_t*));
+    if (!nb) return;                /* Longer chains, still correct */
+    for (size_t i = 0; i < cache->bucket_count; i++) {
+        cache_entry_t* e = cache->buckets[i];
+        while (e) {
+            cache_entry_t* next = e->chain;
+            size_t b = e->hash & (ncount - 1);
+            e->chain = nb[b];
+            nb[b] = e;
+            e = next;
+        }
+    }
+    free(cache->buckets);
+    cache->buckets = nb;
+    cache->bucket_count = ncount;
+}
+
+static void ring_insert(zfo_cache_t* cache, cache_entry_t* e) {
+    if (!cache->hand) {
+        e->prev = e->next = e;
+        cache->hand = e;
+        return;
+    }
+    /* Just behind the hand: the last entry it will look at */
+    cache_entry_t* h = cache->hand;
+    e->next = h;
+    e->prev = h->prev;
+    h->prev->next = e;
+    h->prev = e;
+}
+
+static void ring_remove(zfo_cache_t* cache, cache_entry_t* e) {
+    if (e->next == e) {
+        cache->hand = NULL;
+    } else {
+        e->prev->next = e->next;
+        e->next->prev = e->prev;
+        if (cache->hand == e) cache->hand = e->next;
+    }
+    e->prev = e->next = NULL;
+}
+
+static void cache_remove(zfo_cache_t* cache, cache_entry_t** slot) {
+    cache_entry_t* e = *slot;
+    *slot = e->chain;
+    ring_remove(cache, e);
+    cache_drop_blob(cache, e->blobs[ZFO_CACHE_RAW]);
+    cache_drop_blob(cache, e->blobs[ZFO_CACHE_ZSTD]);
+    cache->stats.entries--;
+    free(e->path);
+    free(e);
+}
+
+static void cache_evict(zfo_cache_t* cache, const cache_entry_t* keep) {
+    while (cache->stats.bytes > cache->opts.max_bytes && cache->hand) {
+        cache_entry_t* e = cache->hand;
+        if (e == keep && e->next == e) break;
+        if (e->referenced || e == keep) {
+            e->referenced = false;
+            cache->hand = e->next;
+            continue;
+        }
+        cache->hand = e->next;
+        cache_remove(cache, cache_slot(cache, e->path, e->path_len, e->hash));
+        cache->stats.evictions++;
+    }
+}
+
+/* ============================================================
+ * File I/O
+ * ============================================================ */
+
+static void ident_from_stat(const struct stat* st, cache_ident_t* id) {
+    id->dev = (uint64_t)st->st_dev;
+    id->ino = (uint64_t)st->st_ino;
+    id->mtime_ns = (int64_t)ZFO_ST_MTIM(st).tv_sec * 1000000000LL + ZFO_ST_MTIM(st).tv_nsec;
+    id->size = (uint64_t)st->st_size;
+}
+
+static bool ident_equal(const cache_ident_t* a, const cache_ident_t* b) {
+    return a->dev == b->dev && a->ino == b->ino && a->mtime_ns == b->mtime_ns && a->size == b->size;
+}
+
+static int cache_stat(const char* path, cache_ident_t* id) {
+    struct stat st;
+    if (stat(path, &st) != 0) return zfo_error_from_errno(errno);
+    if (S_ISDIR(st.st_mode)) return ZFO_ERR_IS_DIR;
+    ident_from_stat(&st, id);
+    return ZFO_OK;
+}
+
+/*
+ * Read a whole file. stable is false when the file changed while it was
+ * read, so the contents are returned but must not be cached.
+ */
+static int cache_read(const char* path, uint8_t** out, cache_ident_t* id, bool* stable) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC | O_NOCTTY);
+    if (fd < 0) return zfo_error_from_errno(errno);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int rc = zfo_error_from_errno(errno);
+        close(fd);
+        return rc;
+    }
+    if (S_ISDIR(st.st_mode)) {
+        close(fd);
+        return ZFO_ERR_IS_DIR;
+    }
+    ident_from_stat(&st, id);
+
+    size_t size = (size_t)st.st_size;
+    uint8_t* data = malloc(size ? size : 1);
+    if (!data) {
+        close(fd);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    size_t got = 0;
+    while (got < size) {
+        ssize_t n = pread(fd, data + got, size - got, (off_t)got);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            int rc = zfo_error_from_errno(errno);
+            free(data);
+            close(fd);
+            return rc;
+        }
+        if (n == 0) break;
+        got += (size_t)n;
+    }
+
+    cache_ident_t after;
+    *stable = got == size && fstat(fd, &st) == 0;
+    if (*stable) {
+        ident_from_stat(&st, &after);
+        *stable = ident_equal(id, &after);
+    }
+    id->size = got;
+    close(fd);
+    *out = data;
+    return ZFO_OK;
+}
+
+/*
+ * zstd frame made of raw (stored) blocks: what the compressor emits for
+ * incompressible input anyway, built with memcpy alone.
+ */
+static zfo_cache_blob_t* cache_store_frame(const zfo_cache_blob_t* raw) {
+    size_t blocks = raw->size ? (raw->size + CACHE_STORED_BLOCK - 1) / CACHE_STORED_BLOCK : 1;
+    size_t total = 4 + 1 + 8 + blocks * 3 + raw->size;
+    uint8_t* dst = malloc(total);
+    if (!dst) return NULL;
+
+    /* Magic, then a single-segment descriptor with an 8-byte content size */
+    uint8_t* p = dst;
+    uint32_t magic = ZSTD_MAGICNUMBER;
+    for (int i = 0; i < 4; i++) *p++ = (uint8_t)(magic >> (8 * i));
+    *p++ = 0xE0;
+    for (int i = 0; i < 8; i++) *p++ = (uint8_t)((uint64_t)raw->size >> (8 * i));
+
+    size_t off = 0;
+    for (size_t b = 0; b < blocks; b++) {
+        size_t n = raw->size - off < CACHE_STORED_BLOCK ? raw->size - off : CACHE_STORED_BLOCK;
+        uint32_t header = (uint32_t)(n << 3) | (b + 1 == blocks ? 1u : 0u);
+        *p++ = (uint8_t)header;
+        *p++ = (uint8_t)(header >> 8);
+        *p++ = (uint8_t)(header >> 16);
+        memcpy(p, raw->data + off, n);
+        p += n;
+        off += n;
+    }
+
+    zfo_cache_blob_t* blob = blob_new(dst, total);
+    if (!blob) free(dst);
+    return blob;
+}
+
+/* incompressible is set when the frame is no smaller than the input */
+static zfo_cache_blob_t* cache_compress(const zfo_cache_blob_t* raw, int level,
+                                        bool* incompressible) {
+    size_t bound = ZSTD_compressBound(raw->size);
+    uint8_t* dst = malloc(bound);
+    if (!dst) return NULL;
+    size_t n = ZSTD_compress(dst, bound, raw->data, raw->size, level);
+    if (ZSTD_isError(n)) {
+        free(dst);
+        return NULL;
+    }
+    *incompressible = n >= raw->size;
+    uint8_t* fit = realloc(dst, n ? n : 1);
+    zfo_cache_blob_t* blob = blob_new(fit ? fit : dst, n);
+    if (!blob) free(fit ? fit : dst);
+    return blob;
+}
+
+/* ============================================================
+ * Public API
+ * ============================================================ */
+
+zfo_cache_t* zfo_cache_create(const zfo_cache_options_t* opts) {
+    zfo_cache_t* cache = calloc(1, sizeof(zfo_cache_t));
+    if (!cache) return NULL;
+    if (opts) cache->opts = *opts;
+    if (cache->opts.max_bytes == 0) cache->opts.max_bytes = CACHE_DEFAULT_BYTES;
+    if (cache->opts.max_entry == 0) cache->opts.max_entry = cache->opts.max_bytes / 4;
+    if (cache->opts.zstd_level == 0) cache->opts.zstd_level = CACHE_DEFAULT_LEVEL;
+
+    cache->bucket_count = CACHE_INITIAL_BUCKETS;
+    cache->buckets = calloc(cache->bucket_count, sizeof(cache_entry_t*));
+    if (!cache->buckets) {
+        free(cache);
+        return NULL;
+    }
+    pthread_mutex_init(&cache->lock, NULL);
+    return cache;
+}
+
+/* Under the lock: the entry for path if it is still current */
+static cache_entry_t* cache_lookup(zfo_cache_t* cache, const char* path, size_t len,
+                                   uint64_t hash, const cache_ident_t* id) {
+    cache_entry_t** slot = cache_slot(cache, path, len, hash);
+    if (!*slot) return NULL;
+    if (id && !ident_equal(&(*slot)->ident, id)) {
+        cache_remove(cache, slot);
+        return NULL;
+    }
+    return *slot;
+}
+
+static void cache_hit(zfo_cache_t* cache, cache_entry_t* e, zfo_cache_blob_t* blob,
+                      zfo_cache_result_t* out) {
+    e->referenced = true;
+    zfo_cache_blob_retain(blob);
+    cache->stats.hits++;
+    out->blob = blob;
+    out->hit = true;
+    out->cached = true;
+}
+
+int zfo_cache_get(zfo_cache_t* cache, const char* path, zfo_cache_variant_t variant,
+                  zfo_cache_result_t* out) {
+    if (!cache || !path || !out || (variant != ZFO_CACHE_RAW && variant != ZFO_CACHE_ZSTD)) {
+        return ZFO_ERR_INVALID_ARG;
+    }
+    memset(out, 0, sizeof(*out));
+
+    size_t len = strlen(path);
+    uint64_t hash = nxh64(path, len, NXH_SEED_DEFAULT);
+    bool validate = !(cache->opts.flags & ZFO_CACHE_NO_VALIDATE);
+
+    cache_ident_t id;
+    if (validate) {
+        int rc = cache_stat(path, &id);
+        if (rc != ZFO_OK) {
+            zfo_cache_invalidate(cache, path, false);
+            return rc;
+        }
+    }
+
+    /* Hit, possibly only on the raw contents */
+    zfo_cache_blob_t* raw = NULL;
+    bool incompressible = false;
+    pthread_mutex_lock(&cache->lock);
+    cache_entry_t* e = cache_lookup(cache, path, len, hash, validate ? &id : NULL);
+    if (e && e->blobs[variant]) {
+        cache_hit(cache, e, e->blobs[variant], out);
+        pthread_mutex_unlock(&cache->lock);
+        return ZFO_OK;
+    }
+    if (e) {
+        raw = e->blobs[ZFO_CACHE_RAW];
+        zfo_cache_blob_retain(raw);
+        incompressible = e->incompressible;
+        id = e->ident;
+    }
+    cache->stats.misses++;
+    pthread_mutex_unlock(&cache->lock);
+    bool raw_cached = raw != NULL;
+
+    bool stable = true;
+    if (!raw) {
+        uint8_t* data = NULL;
+        int rc = cache_read(path, &data, &id, &stable);
+        if (rc != ZFO_OK) return rc;
+        raw = blob_new(data, (size_t)id.size);
+        if (!raw) {
+            free(data);
+            return ZFO_ERR_NO_MEMORY;
+        }
+    }
+
+    zfo_cache_blob_t* want = raw;
+    zfo_cache_blob_t* packed = NULL;
+    if (variant == ZFO_CACHE_ZSTD) {
+        packed = incompressible ? cache_store_frame(raw)
+                                : cache_compress(raw, cache->opts.zstd_level, &incompressible);
+        if (!packed) {
+            zfo_cache_blob_release(raw);
+            return ZFO_ERR_NO_MEMORY;
+        }
+        want = packed;
+    }
+
+    /* A raw blob that came from the cache is already paid for. If both
+     * fresh variants don't fit, keep just the one that was asked for. */
+    bool keep_raw = !raw_cached;
+    size_t total = (keep_raw ? raw->size : 0) + (packed ? packed->size : 0);
+    if (total > cache->opts.max_entry && keep_raw && packed) {
+        keep_raw = false;
+        total = packed->size;
+    }
+    if (!stable || total > cache->opts.max_entry) {
+        /* Served, not kept; remember incompressible input for next time */
+        if (incompressible && raw_cached) {
+            pthread_mutex_lock(&cache->lock);
+            e = *cache_slot(cache, path, len, hash);
+            if (e && ident_equal(&e->ident, &id)) e->incompressible = true;
+            pthread_mutex_unlock(&cache->lock);
+        }
+        if (packed) zfo_cache_blob_release(raw);
+        out->blob = want;
+        return ZFO_OK;
+    }
+    if (!keep_raw && !raw_cached) {
+        zfo_cache_blob_release(raw);
+        raw = NULL;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    cache_entry_t** slot = cache_slot(cache, path, len, hash);
+    e = *slot;
+    if (e && !ident_equal(&e->ident, &id)) {
+        /* Replaced by a newer read while this one ran; keep the newer */
+        pthread_mutex_unlock(&cache->lock);
+        if (packed) zfo_cache_blob_release(raw);
+        out->blob = want;
+        return ZFO_OK;
+    }
+    if (!e) {
+        e = calloc(1, sizeof(cache_entry_t));
+        char* copy = malloc(len + 1);
+        if (!e || !copy) {
+            pthread_mutex_unlock(&cache->lock);
+            free(e);
+            free(copy);
+            if (packed) zfo_cache_blob_release(raw);
+            out->blob = want;
+            return ZFO_OK;
+        }
+        memcpy(copy, path, len + 1);
+        e->path = copy;
+        e->path_len = len;
+        e->hash = hash;
+        e->ident = id;
+        *slot = e;
+        ring_insert(cache, e);
+        if (++cache->stats.entries > cache->bucket_count) cache_grow(cache);
+    }
+
+    if (incompressible) e->incompressible = true;
+
+    /* Another caller may have filled either variant meanwhile */
+    zfo_cache_blob_t* fresh[2] = { raw, packed };
+    for (int v = 0; v < 2; v++) {
+        if (!fresh[v]) continue;
+        if (!e->blobs[v]) {
+            e->blobs[v] = fresh[v];
+            cache->stats.bytes += fresh[v]->size;
+        } else {
+            if (fresh[v] == want) want = e->blobs[v];
+            zfo_cache_blob_release(fresh[v]);
+        }
+    }
+    zfo_cache_blob_retain(want);
+    out->blob = want;
+    out->cached = true;
+    cache_evict(cache, e);
+    pthread_mutex_unlock(&cache->lock);
+    return ZFO_OK;
+}
+
+size_t zfo_cache_invalidate(zfo_cache_t* cache, const char* path, bool recursive) {
+    if (!cache || !path) return 0;
+    size_t len = strlen(path);
+    while (len > 1 && path[len - 1] == '/') len--;
+    size_t dropped = 0;
+
+    pthread_mutex_lock(&cache->lock);
+    cache_entry_t** slot = cache_slot(cache, path, len, nxh64(path, len, NXH_SEED_DEFAULT));
+    if (*slot) {
+        cache_remove(cache, slot);
+        dropped++;
+    }
+    if (recursive) {
+        for (size_t b = 0; b < cache->bucket_count; b++) {
+            slot = &cache->buckets[b];
+            while (*slot) {
+                const cache_entry_t* e = *slot;
+                bool under = e->path_len > len && memcmp(e->path, path, len) == 0 &&
+                             (e->path[len] == '/' || (len == 1 && path[0] == '/'));
+                if (under) {
+                    cache_remove(cache, slot);
+                    dropped++;
+                } else {
+                    slot = &(*slot)->chain;
+                }
+            }
+        }
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return dropped;
+}
+
+void zfo_cache_clear(zfo_cache_t* cache) {
+    if (!cache) return;
+    pthread_mutex_lock(&cache->lock);
+    for (size_t b = 0; b < cache->bucket_count; b++) {
+        while (cache->buckets[b]) cache_remove(cache, &cache->buckets[b]);
+    }
+    pthread_mutex_unlock(&cache->lock);
+}
+
+void zfo_cache_stats(zfo_cache_t* cache, zfo_cache_stats_t* out) {
+    if (!cache || !out) return;
+    pthread_mutex_lock(&cache->lock);
+    *out = cache->stats;
+    pthread_mutex_unlock(&cache->lock);
+}
+
+void zfo_cache_destroy(zfo_cache_t* cache) {
+    if (!cache) return;
+    zfo_cache_clear(cache);
+    pthread_mutex_destroy(&cache->lock);
+    free(cache->buckets);
+    free(cache);
+}
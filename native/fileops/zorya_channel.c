@@ -0,0 +1,498 @@
+/**
+ * @file zorya_channel.c
+ * @brief Zorya FileOps - Shared-memory message channel
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   A byte ring in a shared mapping that any number of processes can
+ *   write to and one can read from. The file is a one-page header
+ *   followed by the ring:
+ *
+ *     header   magic, capacity, then head, tail and the two wake-up
+ *              words on cache lines of their own
+ *     ring     records of [int32 state][uint32 length][payload], each
+ *              padded to 8 bytes and never split across the end
+ *
+ *   Producers claim space by advancing head with a CAS, fill the
+ *   payload in place and publish it by storing the record's size in
+ *   state. A record that would run past the end is preceded by a
+ *   padding record (negative state) covering the rest of the ring.
+ *   The consumer reads in order from tail, zeroes what it consumed and
+ *   then advances tail, so a zero state always means "not yet written".
+ *
+ *   Waiting spins briefly (on multi-core machines) and then sleeps on a
+ *   futex in the shared page (not FUTEX_PRIVATE, since the waker is
+ *   another process). Wakers only make the syscall when the other side
+ *   has said it is asleep.
+ *
+ *   The creator initializes the file under an exclusive zfo_lock on the
+ *   header; openers take a shared lock, so they wait for it to finish.
+ *   A second lock byte keeps a single consumer across processes.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+#define CHAN_MAGIC            0x314E4148435A5AULL   /* "ZZCHAN1" */
+#define CHAN_VERSION          1
+#define CHAN_HEADER_SIZE      4096
+#define CHAN_DEFAULT_CAPACITY (1u << 20)
+#define CHAN_MIN_CAPACITY     4096
+#define CHAN_MAX_CAPACITY     (1u << 30)
+#define CHAN_RECORD_HEADER    8
+#define CHAN_SPINS            2000
+#define CHAN_LOCK_INIT        0               /* Byte locked while initializing */
+#define CHAN_LOCK_CONSUMER    1               /* Byte held by the consumer */
+
+/* ============================================================
+ * Shared Layout
+ * ============================================================ */
+
+typedef struct {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t capacity;
+    uint64_t head __attribute__((aligned(64)));         /* Next byte producers claim */
+    uint64_t tail __attribute__((aligned(64)));         /* Next byte the consumer reads */
+    uint32_t data_seq __attribute__((aligned(64)));     /* Bumped on every commit */
+    uint32_t consumer_waiting;
+    uint32_t space_seq __attribute__((aligned(64)));    /* Bumped as space frees up */
+    uint32_t producers_waiting;
+} chan_header_t;
+
+struct zfo_channel {
+    zfo_file_t* file;
+    zfo_mmap_t* map;
+    chan_header_t* hdr;
+    uint8_t* ring;
+    uint64_t mask;
+    int memfd;                      /* Keeps a memfd channel's path alive */
+    char path[64 + PATH_MAX];
+    bool consumer;                  /* Holds the consumer lock */
+    uint64_t held;                  /* Bytes of the record last received (read by wait) */
+    uint32_t interrupted;
+};
+
+#define CHAN_ALIGN(n) (((n) + 7) & ~(uint64_t)7)
+
+/* ============================================================
+ * Waiting
+ * ============================================================ */
+
+static inline void chan_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static int64_t chan_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* Sleep while *word == val, at most ms (< 0 = forever) */
+static void chan_sleep(uint32_t* word, uint32_t val, int64_t ms) {
+#ifdef __linux__
+    struct timespec ts, *tp = NULL;
+    if (ms >= 0) {
+        ts.tv_sec = ms / 1000;
+        ts.tv_nsec = (ms % 1000) * 1000000;
+        tp = &ts;
+    }
+    syscall(SYS_futex, word, FUTEX_WAIT, val, tp, NULL, 0);
+#else
+    (void)val;
+    struct timespec ts = { 0, (ms >= 0 && ms < 1) ? 0 : 50000 };
+    if (ZFO_ATOMIC_LOAD(word) == val) nanosleep(&ts, NULL);
+#endif
+}
+
+static void chan_wake(uint32_t* word) {
+#ifdef __linux__
+    syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#else
+    (void)word;
+#endif
+}
+
+typedef bool (*chan_ready_fn)(zfo_channel_t* ch, uint64_t arg);
+
+/* Spinning only helps when the other side can run meanwhile */
+static int chan_spins(void) {
+    static int spins = -1;
+    int n = ZFO_ATOMIC_LOAD(&spins);
+    if (n < 0) {
+        n = zfo_thread_count(0) > 1 ? CHAN_SPINS : 0;
+        ZFO_ATOMIC_STORE(&spins, n);
+    }
+    return n;
+}
+
+/*
+ * Wait until ready() holds: spin first, then announce ourselves in
+ * *waiting and sleep on *seq. The waker bumps seq before it checks
+ * waiting, so a wake-up can't fall between our check and the sleep.
+ */
+static int chan_wait(zfo_channel_t* ch, chan_ready_fn ready, uint64_t arg,
+                     uint32_t* seq, uint32_t* waiting, int timeout_ms) {
+    for (int i = chan_spins(); i > 0; i--) {
+        if (ready(ch, arg)) return ZFO_OK;
+        chan_relax();
+    }
+
+    int64_t deadline = timeout_ms >= 0 ? chan_now_ms() + timeout_ms : -1;
+    for (;;) {
+        if (ZFO_ATOMIC_LOAD(&ch->interrupted)) return ZFO_ERR_INTERRUPTED;
+        uint32_t s = ZFO_ATOMIC_LOAD(seq);
+        ZFO_ATOMIC_ADD(waiting, 1);
+        bool ok = ready(ch, arg);
+        if (!ok) {
+            int64_t left = deadline >= 0 ? deadline - chan_now_ms() : -1;
+            if (deadline >= 0 && left <= 0) {
+                ZFO_ATOMIC_SUB(waiting, 1);
+                return ZFO_ERR_TIMEOUT;
+            }
+            chan_sleep(seq, s, left);
+            ok = ready(ch, arg);
+        }
+        ZFO_ATOMIC_SUB(waiting, 1);
+        if (ok) return ZFO_OK;
+    }
+}
+
+/* A record (or padding) is committed past the one the consumer holds */
+static bool chan_has_data(zfo_channel_t* ch, uint64_t arg) {
+    (void)arg;
+    uint64_t next = ZFO_ATOMIC_LOAD(&ch->hdr->tail) + ZFO_ATOMIC_LOAD(&ch->held);
+    return __atomic_load_n((int32_t*)(ch->ring + (next & ch->mask)), __ATOMIC_ACQUIRE) != 0;
+}
+
+static bool chan_has_space(zfo_channel_t* ch, uint64_t need) {
+    uint64_t head = ZFO_ATOMIC_LOAD(&ch->hdr->head);
+    uint64_t tail = ZFO_ATOMIC_LOAD(&ch->hdr->tail);
+    uint64_t pos = head & ch->mask;
+    uint64_t pad = pos + need > ch->hdr->capacity ? ch->hdr->capacity - pos : 0;
+    return head + pad + need - tail <= ch->hdr->capacity;
+}
+
+/* ============================================================
+ * Setup
+ * ============================================================ */
+
+static uint64_t chan_round_capacity(size_t requested) {
+    uint64_t cap = requested ? requested : CHAN_DEFAULT_CAPACITY;
+    if (cap < CHAN_MIN_CAPACITY) cap = CHAN_MIN_CAPACITY;
+    if (cap > CHAN_MAX_CAPACITY) cap = CHAN_MAX_CAPACITY;
+    uint64_t p = CHAN_MIN_CAPACITY;
+    while (p < cap) p <<= 1;
+    return p;
+}
+
+static void chan_free(zfo_channel_t* ch) {
+    if (ch->map) zfo_mmap_close(ch->map);
+    if (ch->file) zfo_close(ch->file);
+    if (ch->memfd >= 0) close(ch->memfd);
+    free(ch);
+}
+
+static int chan_map(zfo_channel_t* ch, uint64_t capacity) {
+    ch->map = zfo_mmap_file(ch->file, 0, CHAN_HEADER_SIZE + capacity,
+                            ZFO_MMAP_READ | ZFO_MMAP_WRITE | ZFO_MMAP_SHARED);
+    if (!ch->map) return zfo_error_from_errno(errno);
+    ch->hdr = zfo_mmap_ptr(ch->map);
+    ch->ring = (uint8_t*)ch->hdr + CHAN_HEADER_SIZE;
+    ch->mask = capacity - 1;
+    return ZFO_OK;
+}
+
+int zfo_channel_create(const char* path, const zfo_channel_options_t* opts, zfo_channel_t** out) {
+    if (!out) return ZFO_ERR_INVALID_ARG;
+    *out = NULL;
+
+    zfo_channel_t* ch = calloc(1, sizeof(zfo_channel_t));
+    if (!ch) return ZFO_ERR_NO_MEMORY;
+    ch->memfd = -1;
+    uint64_t capacity = chan_round_capacity(opts ? opts->capacity : 0);
+    uint32_t mode = opts && opts->mode ? opts->mode : 0600;
+
+    if (path) {
+        snprintf(ch->path, sizeof(ch->path), "%s", path);
+    } else {
+#ifdef __linux__
+        /* Other processes of the same user reach it through /proc */
+        ch->memfd = memfd_create("zorya-channel", MFD_CLOEXEC);
+        if (ch->memfd < 0) {
+            int rc = zfo_error_from_errno(errno);
+            free(ch);
+            return rc;
+        }
+        snprintf(ch->path, sizeof(ch->path), "/proc/%d/fd/%d", (int)getpid(), ch->memfd);
+#else
+        free(ch);
+        return ZFO_ERR_UNSUPPORTED;
+#endif
+    }
+
+    ch->file = zfo_open(ch->path, ZFO_OPEN_READ | ZFO_OPEN_WRITE | ZFO_OPEN_CREATE, mode);
+    if (!ch->file) {
+        int rc = zfo_error_from_errno(errno);
+        chan_free(ch);
+        return rc;
+    }
+
+    /* Openers block on their shared lock until the header is written */
+    int rc = zfo_lock(ch->file, CHAN_LOCK_INIT, 1, ZFO_LOCK_EXCLUSIVE);
+    if (rc == ZFO_OK) rc = zfo_truncate(ch->file, 0);
+    if (rc == ZFO_OK) rc = zfo_truncate(ch->file, (zfo_off_t)(CHAN_HEADER_SIZE + capacity));
+    if (rc == ZFO_OK) rc = chan_map(ch, capacity);
+    if (rc != ZFO_OK) {
+        chan_free(ch);
+        return rc;
+    }
+
+    ch->hdr->version = CHAN_VERSION;
+    ch->hdr->header_size = CHAN_HEADER_SIZE;
+    ch->hdr->capacity = capacity;
+    ZFO_ATOMIC_STORE(&ch->hdr->magic, CHAN_MAGIC);
+    zfo_unlock(ch->file, CHAN_LOCK_INIT, 1);
+
+    *out = ch;
+    return ZFO_OK;
+}
+
+int zfo_channel_open(const char* path, zfo_channel_t** out) {
+    if (!path || !out) return ZFO_ERR_INVALID_ARG;
+    *out = NULL;
+
+    zfo_channel_t* ch = calloc(1, sizeof(zfo_channel_t));
+    if (!ch) return ZFO_ERR_NO_MEMORY;
+    ch->memfd = -1;
+    snprintf(ch->path, sizeof(ch->path), "%s", path);
+
+    ch->file = zfo_open(path, ZFO_OPEN_READ | ZFO_OPEN_WRITE, 0);
+    if (!ch->file) {
+        int rc = zfo_error_from_errno(errno);
+        chan_free(ch);
+        return rc;
+    }
+
+    int rc = zfo_lock(ch->file, CHAN_LOCK_INIT, 1, ZFO_LOCK_SHARED);
+    chan_header_t hdr;
+    if (rc == ZFO_OK) {
+        zfo_off_t n = zfo_pread(ch->file, &hdr, sizeof(hdr), 0);
+        if (n != (zfo_off_t)sizeof(hdr) || hdr.magic != CHAN_MAGIC || hdr.version != CHAN_VERSION ||
+            hdr.header_size != CHAN_HEADER_SIZE || hdr.capacity < CHAN_MIN_CAPACITY ||
+            (hdr.capacity & (hdr.capacity - 1)) != 0) {
+            rc = ZFO_ERR_INVALID_ARG;
+        }
+    }
+    if (rc == ZFO_OK) rc = chan_map(ch, hdr.capacity);
+    zfo_unlock(ch->file, CHAN_LOCK_INIT, 1);
+    if (rc != ZFO_OK) {
+        chan_free(ch);
+        return rc;
+    }
+
+    *out = ch;
+    return ZFO_OK;
+}
+
+const char* zfo_channel_path(const zfo_channel_t* ch) {
+    return ch ? ch->path : NULL;
+}
+
+void* zfo_channel_base(zfo_channel_t* ch) {
+    return ch ? zfo_mmap_ptr(ch->map) : NULL;
+}
+
+size_t zfo_channel_map_size(zfo_channel_t* ch) {
+    return ch ? zfo_mmap_size(ch->map) : 0;
+}
+
+size_t zfo_channel_max_message(const zfo_channel_t* ch) {
+    /* Half the ring keeps a record plus its padding within capacity */
+    return ch ? (size_t)(ch->hdr->capacity / 2 - CHAN_RECORD_HEADER) : 0;
+}
+
+/* ============================================================
+ * Producers
+ * ============================================================ */
+
+int zfo_channel_reserve(zfo_channel_t* ch, size_t len, int timeout_ms, size_t* offset) {
+    if (!ch || !offset) return ZFO_ERR_INVALID_ARG;
+    if (len > zfo_channel_max_message(ch)) return ZFO_ERR_INVALID_ARG;
+
+    chan_header_t* hdr = ch->hdr;
+    uint64_t cap = hdr->capacity;
+    uint64_t need = CHAN_ALIGN(CHAN_RECORD_HEADER + len);
+    uint64_t head, pad;
+
+    for (;;) {
+        head = ZFO_ATOMIC_LOAD(&hdr->head);
+        uint64_t tail = ZFO_ATOMIC_LOAD(&hdr->tail);
+        uint64_t pos = head & ch->mask;
+        pad = pos + need > cap ? cap - pos : 0;
+
+        if (head + pad + need - tail > cap) {
+            if (timeout_ms == 0) return ZFO_ERR_TIMEOUT;
+            int rc = chan_wait(ch, chan_has_space, need, &hdr->space_seq,
+                               &hdr->producers_waiting, timeout_ms);
+            if (rc != ZFO_OK) return rc;
+            continue;
+        }
+        if (__atomic_compare_exchange_n(&hdr->head, &head, head + pad + need, false,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+            break;
+        }
+    }
+
+    if (pad) {
+        uint8_t* p = ch->ring + (head & ch->mask);
+        __atomic_store_n((int32_t*)p, -(int32_t)pad, __ATOMIC_RELEASE);
+    }
+    uint8_t* rec = ch->ring + ((head + pad) & ch->mask);
+    ((uint32_t*)rec)[1] = (uint32_t)len;
+    *offset = CHAN_HEADER_SIZE + (size_t)((head + pad) & ch->mask) + CHAN_RECORD_HEADER;
+    return ZFO_OK;
+}
+
+void zfo_channel_commit(zfo_channel_t* ch, size_t offset) {
+    if (!ch || offset < CHAN_HEADER_SIZE + CHAN_RECORD_HEADER) return;
+    uint8_t* rec = (uint8_t*)ch->hdr + offset - CHAN_RECORD_HEADER;
+    uint64_t need = CHAN_ALIGN(CHAN_RECORD_HEADER + ((uint32_t*)rec)[1]);
+    ZFO_ATOMIC_STORE((int32_t*)rec, (int32_t)need);
+
+    ZFO_ATOMIC_ADD(&ch->hdr->data_seq, 1);
+    if (ZFO_ATOMIC_LOAD(&ch->hdr->consumer_waiting)) chan_wake(&ch->hdr->data_seq);
+}
+
+int zfo_channel_send(zfo_channel_t* ch, const void* data, size_t len, int timeout_ms) {
+    if (!ch || (!data && len)) return ZFO_ERR_INVALID_ARG;
+    size_t offset;
+    int rc = zfo_channel_reserve(ch, len, timeout_ms, &offset);
+    if (rc != ZFO_OK) return rc;
+    if (len) memcpy((uint8_t*)ch->hdr + offset, data, len);
+    zfo_channel_commit(ch, offset);
+    return ZFO_OK;
+}
+
+/* ============================================================
+ * Consumer
+ * ============================================================ */
+
+void zfo_channel_release(zfo_channel_t* ch) {
+    if (!ch || !ch->held) return;
+    chan_header_t* hdr = ch->hdr;
+    uint64_t tail = hdr->tail;
+    uint64_t held = ch->held;
+    memset(ch->ring + (tail & ch->mask), 0, held);
+    ZFO_ATOMIC_STORE(&ch->held, 0);
+    ZFO_ATOMIC_STORE(&hdr->tail, tail + held);
+
+    ZFO_ATOMIC_ADD(&hdr->space_seq, 1);
+    if (ZFO_ATOMIC_LOAD(&hdr->producers_waiting)) chan_wake(&hdr->space_seq);
+}
+
+static int chan_claim_consumer(zfo_channel_t* ch) {
+    if (ch->consumer) return ZFO_OK;
+    int rc = zfo_lock(ch->file, CHAN_LOCK_CONSUMER, 1, ZFO_LOCK_EXCLUSIVE | ZFO_LOCK_NONBLOCK);
+    if (rc == ZFO_OK) ch->consumer = true;
+    return rc;
+}
+
+int zfo_channel_receive(zfo_channel_t* ch, int timeout_ms, size_t* offset, size_t* len) {
+    if (!ch || !offset || !len) return ZFO_ERR_INVALID_ARG;
+    int rc = chan_claim_consumer(ch);
+    if (rc != ZFO_OK) return rc;
+    zfo_channel_release(ch);
+
+    chan_header_t* hdr = ch->hdr;
+    for (;;) {
+        uint64_t tail = hdr->tail;
+        uint8_t* rec = ch->ring + (tail & ch->mask);
+        int32_t state = __atomic_load_n((int32_t*)rec, __ATOMIC_ACQUIRE);
+
+        if (state < 0) {
+            /* Padding up to the end of the ring */
+            memset(rec, 0, (size_t)-state);
+            ZFO_ATOMIC_STORE(&hdr->tail, tail + (uint64_t)-state);
+            continue;
+        }
+        if (state > 0) {
+            ZFO_ATOMIC_STORE(&ch->held, (uint64_t)state);
+            *len = ((uint32_t*)rec)[1];
+            *offset = CHAN_HEADER_SIZE + (size_t)(tail & ch->mask) + CHAN_RECORD_HEADER;
+            return ZFO_OK;
+        }
+
+        if (timeout_ms == 0) return ZFO_ERR_TIMEOUT;
+        rc = chan_wait(ch, chan_has_data, 0, &hdr->data_seq, &hdr->consumer_waiting, timeout_ms);
+        if (rc != ZFO_OK) return rc;
+    }
+}
+
+int zfo_channel_wait(zfo_channel_t* ch, int timeout_ms) {
+    if (!ch) return ZFO_ERR_INVALID_ARG;
+    if (chan_has_data(ch, 0)) return ZFO_OK;
+    if (timeout_ms == 0) return ZFO_ERR_TIMEOUT;
+    return chan_wait(ch, chan_has_data, 0, &ch->hdr->data_seq, &ch->hdr->consumer_waiting, timeout_ms);
+}
+
+void zfo_channel_stats(zfo_channel_t* ch, zfo_channel_stats_t* out) {
+    if (!ch || !out) return;
+    uint64_t head = ZFO_ATOMIC_LOAD(&ch->hdr->head);
+    uint64_t tail = ZFO_ATOMIC_LOAD(&ch->hdr->tail);
+    out->capacity = ch->hdr->capacity;
+    out->used = head - tail;
+    out->written = head;
+    out->read = tail;
+}
+
+/* ============================================================
+ * Teardown
+ * ============================================================ */
+
+void zfo_channel_interrupt(zfo_channel_t* ch) {
+    if (!ch) return;
+    ZFO_ATOMIC_STORE(&ch->interrupted, 1);
+    /* Wakes every sleeper on these words; other processes just re-check */
+    ZFO_ATOMIC_ADD(&ch->hdr->data_seq, 1);
+    ZFO_ATOMIC_ADD(&ch->hdr->space_seq, 1);
+    chan_wake(&ch->hdr->data_seq);
+    chan_wake(&ch->hdr->space_seq);
+}
+
+void zfo_channel_close(zfo_channel_t* ch) {
+    if (!ch) return;
+    zfo_channel_release(ch);
+    if (ch->consumer) zfo_unlock(ch->file, CHAN_LOCK_CONSUMER, 1);
+    chan_free(ch);
+}
@@ -0,0 +1,177 @@
+/**
+ * @file zorya_columns.c
+ * @brief Zorya FileOps - Columnar stat and directory listing
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   Stats many entries in one call and returns one array per field
+ *   instead of one struct per entry. The numeric columns share a single
+ *   allocation and names are packed back to back with an offset table,
+ *   so a 100k-entry listing costs two allocations however many entries
+ *   it has, and the binding can hand both to JS without copying.
+ *
+ *   Directory entries are read in a single getdents pass and stat'ed
+ *   relative to the directory descriptor, so the kernel never walks the
+ *   full path again.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+
+/* ============================================================
+ * Column Block
+ * ============================================================ */
+
+static int cols_alloc(zfo_statcols_t* c, size_t count) {
+    /* 8-byte columns first so every column stays naturally aligned */
+    size_t size = count * (3 * sizeof(double) + sizeof(uint32_t) + sizeof(uint8_t))
+                + (count + 1) * sizeof(uint32_t);
+    uint8_t* block = calloc(1, size);
+    if (!block) return ZFO_ERR_NO_MEMORY;
+
+    c->count = count;
+    c->block = block;
+    c->block_size = size;
+    c->size = (double*)block;
+    c->mtime_ms = c->size + count;
+    c->inode = (uint64_t*)(c->mtime_ms + count);
+    c->mode = (uint32_t*)(c->inode + count);
+    c->name_offsets = c->mode + count;
+    c->type = (uint8_t*)(c->name_offsets + count + 1);
+    return ZFO_OK;
+}
+
+static void fill_row(zfo_statcols_t* c, size_t i, int dirfd, const char* name, bool follow) {
+#if defined(__linux__) && defined(STATX_BASIC_STATS)
+    /* Ask only for what the columns hold; DONT_SYNC as in zfo_stat_at */
+    struct statx sx;
+    int flags = AT_STATX_DONT_SYNC | (follow ? 0 : AT_SYMLINK_NOFOLLOW);
+    unsigned mask = STATX_TYPE | STATX_MODE | STATX_INO | STATX_SIZE | STATX_MTIME;
+    if (statx(dirfd, name, flags, mask, &sx) == 0) {
+        c->size[i] = (double)sx.stx_size;
+        c->mtime_ms[i] = (double)sx.stx_mtime.tv_sec * 1e3 + sx.stx_mtime.tv_nsec / 1e6;
+        c->inode[i] = sx.stx_ino;
+        c->mode[i] = sx.stx_mode;
+        c->type[i] = (uint8_t)zfo_type_from_mode(sx.stx_mode);
+        return;
+    }
+    if (errno != ENOSYS) return;
+#endif
+
+    struct stat st;
+    if (fstatat(dirfd, name, &st, follow ? 0 : AT_SYMLINK_NOFOLLOW) != 0) return;
+    c->size[i] = (double)st.st_size;
+    c->mtime_ms[i] = (double)st.st_mtim.tv_sec * 1e3 + st.st_mtim.tv_nsec / 1e6;
+    c->inode[i] = st.st_ino;
+    c->mode[i] = st.st_mode;
+    c->type[i] = (uint8_t)zfo_type_from_mode(st.st_mode);
+}
+
+/* ============================================================
+ * Public API
+ * ============================================================ */
+
+int zfo_stat_many(const char* const* paths, size_t count, bool follow,
+                  zfo_statcols_t* out) {
+    if ((!paths && count) || !out) return ZFO_ERR_INVALID_ARG;
+    memset(out, 0, sizeof(*out));
+
+    int rc = cols_alloc(out, count);
+    if (rc != ZFO_OK) return rc;
+
+    for (size_t i = 0; i < count; i++) {
+        if (paths[i]) fill_row(out, i, AT_FDCWD, paths[i], follow);
+    }
+    return ZFO_OK;
+}
+
+int zfo_readdir_plus(const char* path, zfo_statcols_t* out) {
+    if (!path || !out) return ZFO_ERR_INVALID_ARG;
+    memset(out, 0, sizeof(*out));
+
+    int fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return zfo_error_from_errno(errno);
+
+    zfo_dirscan_t scan;
+    int rc = zfo_dirscan_open(&scan, fd);
+    if (rc != ZFO_OK) {
+        close(fd);
+        return rc;
+    }
+
+    /* Pass 1: pack names while getdents hands them over */
+    size_t names_cap = 16 * 1024, names_len = 0;
+    size_t offs_cap = 1024, count = 0;
+    char* names = malloc(names_cap);
+    uint32_t* offs = malloc(offs_cap * sizeof(uint32_t));
+    if (!names || !offs) rc = ZFO_ERR_NO_MEMORY;
+
+    const char* name;
+    while (rc == ZFO_OK && zfo_dirscan_next(&scan, &name, NULL, NULL)) {
+        size_t len = strlen(name);
+        if (names_len + len > names_cap) {
+            while (names_len + len > names_cap) names_cap *= 2;
+            char* grown = realloc(names, names_cap);
+            if (!grown) { rc = ZFO_ERR_NO_MEMORY; break; }
+            names = grown;
+        }
+        if (count == offs_cap) {
+            uint32_t* grown = realloc(offs, offs_cap * 2 * sizeof(uint32_t));
+            if (!grown) { rc = ZFO_ERR_NO_MEMORY; break; }
+            offs = grown;
+            offs_cap *= 2;
+        }
+        offs[count++] = (uint32_t)names_len;
+        memcpy(names + names_len, name, len);
+        names_len += len;
+    }
+    if (rc == ZFO_OK) rc = zfo_dirscan_error(&scan);
+    zfo_dirscan_close(&scan);
+
+    /* Pass 2: statx each name against the open directory */
+    if (rc == ZFO_OK) rc = cols_alloc(out, count);
+    if (rc == ZFO_OK) {
+        memcpy(out->name_offsets, offs, count * sizeof(uint32_t));
+        out->name_offsets[count] = (uint32_t)names_len;
+
+        char buf[NAME_MAX + 1];
+        for (size_t i = 0; i < count; i++) {
+            size_t len = out->name_offsets[i + 1] - out->name_offsets[i];
+            if (len >= sizeof(buf)) continue;
+            memcpy(buf, names + out->name_offsets[i], len);
+            buf[len] = '\0';
+            fill_row(out, i, fd, buf, false);
+        }
+        out->names = names;
+        out->names_len = names_len;
+        names = NULL;
+    }
+
+    free(offs);
+    free(names);
+    close(fd);
+    return rc;
+}
+
+void zfo_statcols_free(zfo_statcols_t* cols) {
+    if (!cols) return;
+    free(cols->block);
+    free(cols->names);
+    memset(cols, 0, sizeof(*cols));
+}
@@ -0,0 +1,483 @@
+/**
+ * @file zorya_dedup.c
+ * @brief Zorya FileOps - Duplicate file finder
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   Narrows candidates in passes so that most files are never read:
+ *
+ *     1. Walk with stat and bucket regular files by size. Files with a
+ *        unique size can't have a duplicate.
+ *     2. Hash the first and last few KB of each remaining file with
+ *        nxh64. Files whose partial hash is unique within their size
+ *        bucket drop out.
+ *     3. Fully hash the survivors through a read-only mapping.
+ *
+ *   Both hashing passes run as tasks on the walker's work-stealing
+ *   pool. With skip_hardlinks, paths sharing a (dev, inode) pair are
+ *   hashed once and reported as one file.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+#include "nxh.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#define DEDUP_PARTIAL_BYTES   4096
+#define DEDUP_HASH_CHUNK      (64u * 1024 * 1024)
+#define DEDUP_PARTIAL_BATCH   64
+
+/* ============================================================
+ * Internal Structures
+ * ============================================================ */
+
+typedef enum {
+    DEDUP_PENDING,
+    DEDUP_HASHED,                   /* partial covers the whole file */
+    DEDUP_FAILED,
+    DEDUP_LINKED                    /* Hard link to an earlier entry */
+} dedup_state_t;
+
+typedef struct {
+    char* path;
+    uint64_t size;
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t partial;
+    uint64_t full;
+    dedup_state_t state;
+} dedup_file_t;
+
+typedef struct {
+    dedup_file_t* files;
+    size_t count;
+    size_t cap;
+} dedup_list_t;
+
+typedef struct {
+    zfo_pool_t* pool;
+    const zfo_dedup_options_t* opts;
+    size_t partial_bytes;
+    dedup_list_t* lists;            /* One per worker */
+    int nworkers;
+    bool oom;
+
+    uint64_t partial_hashed;        /* Counters are atomic */
+    uint64_t full_hashed;
+    uint64_t bytes_hashed;
+    uint64_t failed;
+} dedup_ctx_t;
+
+typedef struct {
+    dedup_ctx_t* ctx;
+    dedup_file_t** files;
+    size_t count;
+} dedup_task_t;
+
+/* ============================================================
+ * Collection
+ * ============================================================ */
+
+static int dedup_visit(const zfo_walk_entry_t* entry, void* userdata) {
+    dedup_ctx_t* ctx = userdata;
+    if (entry->type != ZFO_TYPE_FILE || !entry->stat) return ZFO_WALK_CONTINUE;
+
+    uint64_t size = (uint64_t)entry->stat->size;
+    uint64_t min_size = ctx->opts->min_size > 0 ? ctx->opts->min_size : 1;
+    if (size < min_size) return ZFO_WALK_CONTINUE;
+    if (ctx->opts->max_size > 0 && size > ctx->opts->max_size) return ZFO_WALK_CONTINUE;
+
+    dedup_list_t* list = &ctx->lists[entry->worker];
+    if (list->count == list->cap) {
+        size_t ncap = list->cap ? list->cap * 2 : 256;
+        dedup_file_t* nfiles = realloc(list->files, ncap * sizeof(dedup_file_t));
+        if (!nfiles) {
+            ctx->oom = true;
+            return ZFO_WALK_STOP;
+        }
+        list->files = nfiles;
+        list->cap = ncap;
+    }
+
+    char* path = malloc(entry->path_len + 1);
+    if (!path) {
+        ctx->oom = true;
+        return ZFO_WALK_STOP;
+    }
+    memcpy(path, entry->path, entry->path_len + 1);
+
+    dedup_file_t* f = &list->files[list->count++];
+    memset(f, 0, sizeof(*f));
+    f->path = path;
+    f->size = size;
+    f->dev = entry->stat->dev;
+    f->ino = entry->stat->inode;
+    return ZFO_WALK_CONTINUE;
+}
+
+static int cmp_size_inode(const void* a, const void* b) {
+    const dedup_file_t* x = a;
+    const dedup_file_t* y = b;
+    if (x->size != y->size) return x->size < y->size ? 1 : -1;  /* Largest first */
+    if (x->dev != y->dev) return x->dev < y->dev ? -1 : 1;
+    if (x->ino != y->ino) return x->ino < y->ino ? -1 : 1;
+    return strcmp(x->path, y->path);
+}
+
+static int cmp_partial(const void* a, const void* b) {
+    const dedup_file_t* x = *(dedup_file_t* const*)a;
+    const dedup_file_t* y = *(dedup_file_t* const*)b;
+    if (x->partial != y->partial) return x->partial < y->partial ? -1 : 1;
+    return 0;
+}
+
+static int cmp_full(const void* a, const void* b) {
+    const dedup_file_t* x = *(dedup_file_t* const*)a;
+    const dedup_file_t* y = *(dedup_file_t* const*)b;
+    if (x->full != y->full) return x->full < y->full ? -1 : 1;
+    return strcmp(x->path, y->path);
+}
+
+/* ============================================================
+ * Hashing Tasks
+ * ============================================================ */
+
+static bool read_exact(int fd, void* buf, size_t len, off_t off) {
+    size_t got = 0;
+    while (got < len) {
+        ssize_t r = pread(fd, (char*)buf + got, len - got, off + (off_t)got);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        got += (size_t)r;
+    }
+    return true;
+}
+
+static void hash_partial(dedup_ctx_t* ctx, dedup_file_t* f, char* buf) {
+    int fd = open(f->path, O_RDONLY | O_CLOEXEC | O_NOCTTY);
+    if (fd < 0) {
+        f->state = DEDUP_FAILED;
+        ZFO_ATOMIC_ADD(&ctx->failed, 1);
+        return;
+    }
+
+    size_t chunk = ctx->partial_bytes;
+    bool whole = f->size <= 2 * (uint64_t)chunk;
+    bool ok;
+    if (whole) {
+        ok = read_exact(fd, buf, (size_t)f->size, 0);
+        if (ok) f->partial = nxh64(buf, (size_t)f->size, NXH_SEED_DEFAULT);
+    } else {
+        ok = read_exact(fd, buf, chunk, 0) &&
+             read_exact(fd, buf + chunk, chunk, (off_t)(f->size - chunk));
+        if (ok) f->partial = nxh64(buf, 2 * chunk, NXH_SEED_DEFAULT);
+    }
+    close(fd);
+
+    if (!ok) {
+        f->state = DEDUP_FAILED;
+        ZFO_ATOMIC_ADD(&ctx->failed, 1);
+        return;
+    }
+    if (whole) {
+        f->full = f->partial;
+        f->state = DEDUP_HASHED;
+    }
+    ZFO_ATOMIC_ADD(&ctx->partial_hashed, 1);
+    ZFO_ATOMIC_ADD(&ctx->bytes_hashed, whole ? f->size : 2 * (uint64_t)chunk);
+}
+
+static void partial_task(zfo_pool_t* pool, int worker, void* arg) {
+    (void)worker;
+    dedup_task_t* task = arg;
+    dedup_ctx_t* ctx = task->ctx;
+
+    char* buf = malloc(2 * ctx->partial_bytes);
+    for (size_t i = 0; i < task->count && !zfo_pool_cancelled(pool); i++) {
+        if (buf) {
+            hash_partial(ctx, task->files[i], buf);
+        } else {
+            task->files[i]->state = DEDUP_FAILED;
+        }
+    }
+    free(buf);
+    free(task);
+}
+
+/* Hash a whole file through a mapping, releasing pages as it goes */
+int zfo_hash_fd(int fd, uint64_t size, uint64_t* out) {
+    /* A file that changed size since it was listed could fault past EOF */
+    struct stat st;
+    if (fstat(fd, &st) != 0) return zfo_error_from_errno(errno);
+    if ((uint64_t)st.st_size != size) return ZFO_ERR_BUSY;
+
+    uint64_t h = NXH_SEED_DEFAULT;
+    if (size > 0) {
+        void* map = mmap(NULL, (size_t)size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) return zfo_error_from_errno(errno);
+        madvise(map, (size_t)size, MADV_SEQUENTIAL);
+
+        const char* p = map;
+        for (uint64_t off = 0; off < size; off += DEDUP_HASH_CHUNK) {
+            size_t len = (size_t)(size - off < DEDUP_HASH_CHUNK ? size - off : DEDUP_HASH_CHUNK);
+            h = nxh_combine(h, nxh64(p + off, len, NXH_SEED_DEFAULT));
+            madvise((void*)(p + off), len, MADV_DONTNEED);
+        }
+        munmap(map, (size_t)size);
+    }
+    *out = h;
+    return ZFO_OK;
+}
+
+static void full_task(zfo_pool_t* pool, int worker, void* arg) {
+    (void)worker;
+    dedup_task_t* task = arg;
+    dedup_ctx_t* ctx = task->ctx;
+    dedup_file_t* f = task->files[0];
+    free(task);
+    if (zfo_pool_cancelled(pool)) return;
+
+    int fd = open(f->path, O_RDONLY | O_CLOEXEC | O_NOCTTY);
+    int rc = fd >= 0 ? zfo_hash_fd(fd, f->size, &f->full) : ZFO_ERR_IO;
+    if (fd >= 0) close(fd);
+    if (rc != ZFO_OK) {
+        f->state = DEDUP_FAILED;
+        ZFO_ATOMIC_ADD(&ctx->failed, 1);
+        return;
+    }
+
+    f->state = DEDUP_HASHED;
+    ZFO_ATOMIC_ADD(&ctx->full_hashed, 1);
+    ZFO_ATOMIC_ADD(&ctx->bytes_hashed, f->size);
+}
+
+static int submit(dedup_ctx_t* ctx, zfo_task_fn fn, dedup_file_t** files, size_t count) {
+    dedup_task_t* task = malloc(sizeof(dedup_task_t));
+    if (!task) return ZFO_ERR_NO_MEMORY;
+    task->ctx = ctx;
+    task->files = files;
+    task->count = count;
+    if (zfo_pool_submit(ctx->pool, -1, fn, task) != ZFO_OK) {
+        free(task);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    return ZFO_OK;
+}
+
+/* ============================================================
+ * Grouping
+ * ============================================================ */
+
+/* Split [0, n) into runs of equal key; keep runs of 2+ */
+static size_t keep_runs(dedup_file_t** v, size_t n, bool by_full) {
+    size_t out = 0, i = 0;
+    while (i < n) {
+        size_t j = i + 1;
+        while (j < n && v[j]->size == v[i]->size &&
+               (by_full ? v[j]->full == v[i]->full : v[j]->partial == v[i]->partial)) {
+            j++;
+        }
+        if (j - i >= 2) {
+            for (size_t k = i; k < j; k++) v[out++] = v[k];
+        }
+        i = j;
+    }
+    return out;
+}
+
+/* Sort each same-size bucket by cmp */
+static void sort_buckets(dedup_file_t** v, size_t n, int (*cmp)(const void*, const void*)) {
+    size_t i = 0;
+    while (i < n) {
+        size_t j = i + 1;
+        while (j < n && v[j]->size == v[i]->size) j++;
+        qsort(v + i, j - i, sizeof(dedup_file_t*), cmp);
+        i = j;
+    }
+}
+
+static size_t drop_failed(dedup_file_t** v, size_t n) {
+    size_t out = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (v[i]->state != DEDUP_FAILED) v[out++] = v[i];
+    }
+    return out;
+}
+
+static int build_groups(dedup_file_t** v, size_t n, zfo_dedup_result_t* result) {
+    size_t ngroups = 0;
+    for (size_t i = 0; i < n;) {
+        size_t j = i + 1;
+        while (j < n && v[j]->size == v[i]->size && v[j]->full == v[i]->full) j++;
+        ngroups++;
+        i = j;
+    }
+
+    result->groups = calloc(ngroups > 0 ? ngroups : 1, sizeof(zfo_dup_group_t));
+    if (!result->groups) return ZFO_ERR_NO_MEMORY;
+
+    for (size_t i = 0; i < n;) {
+        size_t j = i + 1;
+        while (j < n && v[j]->size == v[i]->size && v[j]->full == v[i]->full) j++;
+
+        zfo_dup_group_t* g = &result->groups[result->group_count];
+        g->paths = malloc((j - i) * sizeof(char*));
+        if (!g->paths) return ZFO_ERR_NO_MEMORY;
+        g->size = v[i]->size;
+        g->hash = v[i]->full;
+        for (size_t k = i; k < j; k++) {
+            g->paths[g->count++] = v[k]->path;
+            v[k]->path = NULL;      /* Ownership moves to the group */
+        }
+        result->group_count++;
+        result->wasted_bytes += g->size * (g->count - 1);
+        i = j;
+    }
+    return ZFO_OK;
+}
+
+/* ============================================================
+ * Public API
+ * ============================================================ */
+
+int zfo_find_duplicates(const char* root, const zfo_dedup_options_t* opts,
+                        zfo_dedup_result_t* result) {
+    if (!root || !opts || !result) return ZFO_ERR_INVALID_ARG;
+    memset(result, 0, sizeof(*result));
+
+    dedup_ctx_t ctx = {0};
+    ctx.opts = opts;
+    ctx.partial_bytes = opts->partial_bytes > 0 ? opts->partial_bytes : DEDUP_PARTIAL_BYTES;
+
+    dedup_file_t* all = NULL;
+    dedup_file_t** v = NULL;
+    size_t total = 0, n = 0;
+
+    int rc = ZFO_ERR_NO_MEMORY;
+    ctx.pool = zfo_pool_create(opts->files.walk.threads);
+    if (!ctx.pool) return rc;
+    ctx.nworkers = zfo_pool_size(ctx.pool);
+    ctx.lists = calloc((size_t)ctx.nworkers, sizeof(dedup_list_t));
+    if (!ctx.lists) goto out;
+
+    /* Pass 1: collect sizes */
+    zfo_glob_options_t files = opts->files;
+    files.walk.visit = dedup_visit;
+    files.walk.userdata = &ctx;
+    files.walk.flags |= ZFO_WALK_STAT;
+    rc = zfo_glob_walk_run(ctx.pool, root, opts->include, &files, &result->walk);
+    if (ctx.oom) rc = ZFO_ERR_NO_MEMORY;
+    if (rc != ZFO_OK && (rc == ZFO_ERR_INTERRUPTED || rc == ZFO_ERR_NO_MEMORY ||
+                         result->walk.error_count == 0)) {
+        goto out;
+    }
+
+    for (int w = 0; w < ctx.nworkers; w++) total += ctx.lists[w].count;
+    result->files_scanned = total;
+    all = malloc((total > 0 ? total : 1) * sizeof(dedup_file_t));
+    v = malloc((total > 0 ? total : 1) * sizeof(dedup_file_t*));
+    rc = ZFO_ERR_NO_MEMORY;
+    if (!all || !v) goto out;
+    for (int w = 0, k = 0; w < ctx.nworkers; w++) {
+        memcpy(all + k, ctx.lists[w].files, ctx.lists[w].count * sizeof(dedup_file_t));
+        k += (int)ctx.lists[w].count;
+        free(ctx.lists[w].files);
+        ctx.lists[w].files = NULL;
+        ctx.lists[w].count = 0;
+    }
+
+    /* Size buckets; hard links sort next to each other */
+    qsort(all, total, sizeof(dedup_file_t), cmp_size_inode);
+    for (size_t i = 0; i < total; i++) {
+        if (opts->skip_hardlinks && i > 0 && all[i].size == all[i - 1].size &&
+            all[i].dev == all[i - 1].dev && all[i].ino == all[i - 1].ino) {
+            all[i].state = DEDUP_LINKED;
+            result->hardlinks_skipped++;
+            continue;
+        }
+        v[n++] = &all[i];
+    }
+    n = keep_runs(v, n, false);
+    result->candidates = n;
+
+    /* Pass 2: partial hashes */
+    for (size_t i = 0; i < n; i += DEDUP_PARTIAL_BATCH) {
+        size_t count = n - i < DEDUP_PARTIAL_BATCH ? n - i : DEDUP_PARTIAL_BATCH;
+        if ((rc = submit(&ctx, partial_task, v + i, count)) != ZFO_OK) break;
+    }
+    zfo_pool_wait(ctx.pool, 0, NULL, NULL);
+    if (rc != ZFO_OK) goto out;
+
+    n = drop_failed(v, n);
+    sort_buckets(v, n, cmp_partial);
+    n = keep_runs(v, n, false);
+
+    /* Pass 3: full hashes where the partial hash didn't cover the file */
+    for (size_t i = 0; i < n; i++) {
+        if (v[i]->state == DEDUP_PENDING &&
+            (rc = submit(&ctx, full_task, v + i, 1)) != ZFO_OK) {
+            break;
+        }
+    }
+    zfo_pool_wait(ctx.pool, 0, NULL, NULL);
+    if (rc != ZFO_OK) goto out;
+
+    n = drop_failed(v, n);
+    sort_buckets(v, n, cmp_full);
+    n = keep_runs(v, n, true);
+    rc = build_groups(v, n, result);
+
+    result->partial_hashed = ctx.partial_hashed;
+    result->full_hashed = ctx.full_hashed;
+    result->bytes_hashed = ctx.bytes_hashed;
+    result->files_failed = ctx.failed;
+
+out:
+    if (all) {
+        for (size_t i = 0; i < total; i++) free(all[i].path);
+    }
+    if (ctx.lists) {
+        for (int w = 0; w < ctx.nworkers; w++) {
+            for (size_t i = 0; i < ctx.lists[w].count; i++) free(ctx.lists[w].files[i].path);
+            free(ctx.lists[w].files);
+        }
+        free(ctx.lists);
+    }
+    free(all);
+    free(v);
+    zfo_pool_destroy(ctx.pool);
+    if (rc != ZFO_OK && result->groups) {
+        zfo_tree_result_t walk = result->walk;
+        result->walk = (zfo_tree_result_t){0};
+        zfo_dedup_result_free(result);
+        result->walk = walk;
+    }
+    return rc;
+}
+
+void zfo_dedup_result_free(zfo_dedup_result_t* result) {
+    if (!result) return;
+    for (size_t i = 0; i < result->group_count; i++) {
+        for (size_t k = 0; k < result->groups[i].count; k++) free(result->groups[i].paths[k]);
+        free(result->groups[i].paths);
+    }
+    free(result->groups);
+    zfo_tree_result_free(&result->walk);
+    memset(result, 0, sizeof(*result));
+}
@@ -0,0 +1,440 @@
+/**
+ * @file zorya_du.c
+ * @brief Zorya FileOps - Parallel disk usage
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   Sums apparent size and allocated blocks for a tree on the parallel
+ *   walker. Each worker adds what it sees into its own table of rows,
+ *   one row per directory down to max_depth; deeper entries land in
+ *   their ancestor at max_depth. Nothing is shared on the hot path
+ *   except the hard link set, which only files with nlink > 1 touch.
+ *
+ *   Once the walk is done the tables are merged, sorted by path (so a
+ *   parent always precedes its children) and rolled up from the last
+ *   row to the first, giving each row the totals of its whole subtree.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+#include "nxh.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#define DU_MAP_INITIAL   64
+#define DU_LINKS_INITIAL 1024
+
+/* ============================================================
+ * Row Tables
+ * ============================================================ */
+
+typedef struct {
+    uint64_t hash;
+    size_t key_off;                 /* Into the owning map's keys */
+    size_t key_len;
+    bool used;
+    uint64_t apparent;
+    uint64_t allocated;
+    uint64_t files;
+    uint64_t dirs;
+} du_row_t;
+
+typedef struct {
+    du_row_t* slots;
+    size_t cap;                     /* Power of two */
+    size_t count;
+    char* keys;
+    size_t keys_len;
+    size_t keys_cap;
+} du_map_t;
+
+static bool du_map_grow(du_map_t* m) {
+    size_t ncap = m->cap ? m->cap * 2 : DU_MAP_INITIAL;
+    du_row_t* slots = calloc(ncap, sizeof(du_row_t));
+    if (!slots) return false;
+    for (size_t i = 0; i < m->cap; i++) {
+        if (!m->slots[i].used) continue;
+        size_t j = m->slots[i].hash & (ncap - 1);
+        while (slots[j].used) j = (j + 1) & (ncap - 1);
+        slots[j] = m->slots[i];
+    }
+    free(m->slots);
+    m->slots = slots;
+    m->cap = ncap;
+    return true;
+}
+
+static du_row_t* du_map_get(du_map_t* m, const char* key, size_t len) {
+    if ((m->count + 1) * 2 > m->cap && !du_map_grow(m)) return NULL;
+
+    uint64_t hash = nxh64(key, len, NXH_SEED_DEFAULT);
+    size_t i = hash & (m->cap - 1);
+    while (m->slots[i].used) {
+        du_row_t* r = &m->slots[i];
+        if (r->hash == hash && r->key_len == len && memcmp(m->keys + r->key_off, key, len) == 0) {
+            return r;
+        }
+        i = (i + 1) & (m->cap - 1);
+    }
+
+    if (m->keys_len + len > m->keys_cap) {
+        size_t ncap = m->keys_cap ? m->keys_cap : 4096;
+        while (m->keys_len + len > ncap) ncap *= 2;
+        char* keys = realloc(m->keys, ncap);
+        if (!keys) return NULL;
+        m->keys = keys;
+        m->keys_cap = ncap;
+    }
+    memcpy(m->keys + m->keys_len, key, len);
+
+    du_row_t* r = &m->slots[i];
+    memset(r, 0, sizeof(*r));
+    r->used = true;
+    r->hash = hash;
+    r->key_off = m->keys_len;
+    r->key_len = len;
+    m->keys_len += len;
+    m->count++;
+    return r;
+}
+
+static void du_map_free(du_map_t* m) {
+    free(m->slots);
+    free(m->keys);
+    memset(m, 0, sizeof(*m));
+}
+
+/* ============================================================
+ * Hard Link Set
+ * ============================================================ */
+
+typedef struct {
+    uint64_t* keys;                 /* (dev, inode) pairs; (0, 0) is empty */
+    size_t cap;
+    size_t count;
+    pthread_mutex_t lock;
+} du_links_t;
+
+static size_t du_links_slot(const du_links_t* s, uint64_t dev, uint64_t ino) {
+    uint64_t h = (dev * 0x9E3779B97F4A7C15ULL) ^ ino;
+    h ^= h >> 31;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 29;
+    return (size_t)h & (s->cap - 1);
+}
+
+/* True the first time a (dev, inode) is seen; false for repeats and OOM */
+static bool du_links_first(du_links_t* s, uint64_t dev, uint64_t ino, bool* oom) {
+    pthread_mutex_lock(&s->lock);
+    if ((s->count + 1) * 2 > s->cap) {
+        size_t ncap = s->cap ? s->cap * 2 : DU_LINKS_INITIAL;
+        uint64_t* keys = calloc(ncap * 2, sizeof(uint64_t));
+        if (!keys) {
+            pthread_mutex_unlock(&s->lock);
+            *oom = true;
+            return false;
+        }
+        du_links_t grown = { .keys = keys, .cap = ncap };
+        for (size_t i = 0; i < s->cap; i++) {
+            uint64_t d = s->keys[2 * i], n = s->keys[2 * i + 1];
+            if (!d && !n) continue;
+            size_t j = du_links_slot(&grown, d, n);
+            while (keys[2 * j] || keys[2 * j + 1]) j = (j + 1) & (ncap - 1);
+            keys[2 * j] = d;
+            keys[2 * j + 1] = n;
+        }
+        free(s->keys);
+        s->keys = keys;
+        s->cap = ncap;
+    }
+
+    size_t i = du_links_slot(s, dev, ino);
+    bool first = true;
+    while (s->keys[2 * i] || s->keys[2 * i + 1]) {
+        if (s->keys[2 * i] == dev && s->keys[2 * i + 1] == ino) {
+            first = false;
+            break;
+        }
+        i = (i + 1) & (s->cap - 1);
+    }
+    if (first) {
+        s->keys[2 * i] = dev;
+        s->keys[2 * i + 1] = ino;
+        s->count++;
+    }
+    pthread_mutex_unlock(&s->lock);
+    return first;
+}
+
+/* ============================================================
+ * Collection
+ * ============================================================ */
+
+typedef struct {
+    const zfo_du_options_t* opts;
+    size_t root_len;
+    uint64_t root_dev;
+    du_map_t* maps;                 /* One per worker */
+    du_links_t links;
+    uint64_t hardlinks;             /* Atomic */
+    bool oom;
+} du_ctx_t;
+
+/* Length of the first n components of a relative path */
+static size_t du_prefix_len(const char* rel, size_t len, int n) {
+    if (n <= 0) return 0;
+    for (size_t i = 0; i < len; i++) {
+        if (rel[i] == '/' && --n == 0) return i;
+    }
+    return len;
+}
+
+static int du_visit(const zfo_walk_entry_t* entry, void* userdata) {
+    du_ctx_t* ctx = userdata;
+    const zfo_stat_t* st = entry->stat;
+    if (!st) return ZFO_WALK_CONTINUE;
+
+    if ((ctx->opts->flags & ZFO_DU_ONE_FS) && st->dev != ctx->root_dev) return ZFO_WALK_PRUNE;
+
+    bool is_dir = entry->type == ZFO_TYPE_DIR;
+    bool counted = true;
+    if (!is_dir && st->nlink > 1 && !(ctx->opts->flags & ZFO_DU_COUNT_LINKS)) {
+        bool oom = false;
+        counted = du_links_first(&ctx->links, st->dev, st->inode, &oom);
+        if (oom) {
+            ctx->oom = true;
+            return ZFO_WALK_STOP;
+        }
+        if (!counted) ZFO_ATOMIC_ADD(&ctx->hardlinks, 1);
+    }
+
+    /* A directory within the limit is its own row; anything else goes
+     * to its parent, or to the ancestor at max_depth */
+    int max = ctx->opts->max_depth;
+    bool own_row = is_dir && (max < 0 || entry->depth <= max);
+    int keep = own_row ? entry->depth : entry->depth - 1;
+    if (max >= 0 && keep > max) keep = max;
+
+    const char* rel = entry->path + ctx->root_len + 1;
+    size_t rel_len = entry->path_len - ctx->root_len - 1;
+    du_row_t* row = du_map_get(&ctx->maps[entry->worker], rel, du_prefix_len(rel, rel_len, keep));
+    if (!row) {
+        ctx->oom = true;
+        return ZFO_WALK_STOP;
+    }
+
+    if (counted) {
+        row->apparent += (uint64_t)st->size;
+        row->allocated += st->blocks * 512;
+    }
+    if (!is_dir) row->files++;
+    else if (!own_row) row->dirs++;
+    return ZFO_WALK_CONTINUE;
+}
+
+/* ============================================================
+ * Merge and Roll-up
+ * ============================================================ */
+
+typedef struct {
+    const char* key;
+    size_t len;
+    const du_row_t* row;
+} du_ref_t;
+
+static int du_cmp_key(const char* a, size_t alen, const char* b, size_t blen) {
+    int c = memcmp(a, b, alen < blen ? alen : blen);
+    if (c != 0) return c;
+    return alen < blen ? -1 : (alen > blen);
+}
+
+static int du_cmp_refs(const void* a, const void* b) {
+    const du_ref_t* x = a;
+    const du_ref_t* y = b;
+    return du_cmp_key(x->key, x->len, y->key, y->len);
+}
+
+static int du_build(const du_map_t* all, zfo_du_result_t* out) {
+    size_t n = all->count;
+    du_ref_t* refs = malloc(n * sizeof(du_ref_t));
+    if (!refs) return ZFO_ERR_NO_MEMORY;
+    size_t k = 0;
+    for (size_t i = 0; i < all->cap; i++) {
+        const du_row_t* r = &all->slots[i];
+        if (!r->used) continue;
+        refs[k].key = all->keys + r->key_off;
+        refs[k].len = r->key_len;
+        refs[k].row = r;
+        k++;
+    }
+    qsort(refs, n, sizeof(du_ref_t), du_cmp_refs);
+
+    size_t size = n * (4 * sizeof(double) + 2 * sizeof(uint32_t)) + (n + 1) * sizeof(uint32_t);
+    uint8_t* block = calloc(1, size);
+    char* names = malloc(all->keys_len ? all->keys_len : 1);
+    if (!block || !names) {
+        free(refs);
+        free(block);
+        free(names);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    out->count = n;
+    out->block = block;
+    out->block_size = size;
+    out->apparent = (double*)block;
+    out->allocated = out->apparent + n;
+    out->files = out->allocated + n;
+    out->dirs = out->files + n;
+    out->parent = (int32_t*)(out->dirs + n);
+    out->depth = (uint32_t*)(out->parent + n);
+    out->name_offsets = out->depth + n;
+    out->names = names;
+
+    size_t off = 0;
+    for (size_t i = 0; i < n; i++) {
+        const du_ref_t* r = &refs[i];
+        memcpy(names + off, r->key, r->len);
+        out->name_offsets[i] = (uint32_t)off;
+        off += r->len;
+
+        uint32_t depth = r->len ? 1 : 0;
+        for (size_t j = 0; j < r->len; j++) depth += r->key[j] == '/';
+        out->depth[i] = depth;
+        out->parent[i] = -1;
+        out->apparent[i] = (double)r->row->apparent;
+        out->allocated[i] = (double)r->row->allocated;
+        out->files[i] = (double)r->row->files;
+        out->dirs[i] = (double)r->row->dirs;
+
+        if (i == 0) continue;
+        /* A parent sorts before its children: binary search rows [0, i) */
+        size_t plen = r->len;
+        while (plen > 0 && r->key[plen - 1] != '/') plen--;
+        plen = plen > 0 ? plen - 1 : 0;
+        size_t lo = 0, hi = i;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            int c = du_cmp_key(refs[mid].key, refs[mid].len, r->key, plen);
+            if (c == 0) {
+                out->parent[i] = (int32_t)mid;
+                break;
+            }
+            if (c < 0) lo = mid + 1;
+            else hi = mid;
+        }
+    }
+    out->name_offsets[n] = (uint32_t)off;
+    out->names_len = off;
+
+    /* Children sort after their parents, so one backward pass rolls up */
+    for (size_t i = n; i-- > 1;) {
+        int32_t p = out->parent[i];
+        if (p < 0) continue;
+        out->apparent[p] += out->apparent[i];
+        out->allocated[p] += out->allocated[i];
+        out->files[p] += out->files[i];
+        out->dirs[p] += out->dirs[i] + 1;
+    }
+
+    free(refs);
+    return ZFO_OK;
+}
+
+/* ============================================================
+ * Public API
+ * ============================================================ */
+
+int zfo_du(const char* root, const zfo_du_options_t* opts, zfo_du_result_t* result) {
+    if (!root || !result) return ZFO_ERR_INVALID_ARG;
+    memset(result, 0, sizeof(*result));
+
+    zfo_du_options_t defaults = { .max_depth = 1 };
+    if (!opts) opts = &defaults;
+
+    struct stat st;
+    if (stat(root, &st) != 0) return zfo_error_from_errno(errno);
+    if (!S_ISDIR(st.st_mode)) return ZFO_ERR_NOT_DIR;
+
+    du_ctx_t ctx = {0};
+    ctx.opts = opts;
+    ctx.root_len = strlen(root);
+    while (ctx.root_len > 1 && root[ctx.root_len - 1] == '/') ctx.root_len--;
+    if (ctx.root_len == 1 && root[0] == '/') ctx.root_len = 0;
+    ctx.root_dev = (uint64_t)st.st_dev;
+
+    int nworkers = zfo_thread_count(opts->threads);
+    ctx.maps = calloc((size_t)nworkers, sizeof(du_map_t));
+    if (!ctx.maps) return ZFO_ERR_NO_MEMORY;
+    pthread_mutex_init(&ctx.links.lock, NULL);
+
+    zfo_walk_options_t walk = {
+        .threads = nworkers,
+        .max_depth = -1,
+        .flags = ZFO_WALK_STAT | ((opts->flags & ZFO_DU_SKIP_HIDDEN) ? ZFO_WALK_SKIP_HIDDEN : 0),
+        .prune = opts->prune,
+        .prune_count = opts->prune_count,
+        .visit = du_visit,
+        .userdata = &ctx
+    };
+    int rc = zfo_walk_parallel(root, &walk, &result->walk);
+    if (ctx.oom) rc = ZFO_ERR_NO_MEMORY;
+
+    /* Merge into one table seeded with the root's own row */
+    du_map_t all = {0};
+    du_row_t* top = rc != ZFO_ERR_NO_MEMORY ? du_map_get(&all, "", 0) : NULL;
+    if (top) {
+        top->apparent = (uint64_t)st.st_size;
+        top->allocated = (uint64_t)st.st_blocks * 512;
+    } else {
+        rc = ZFO_ERR_NO_MEMORY;
+    }
+    for (int w = 0; w < nworkers && rc != ZFO_ERR_NO_MEMORY; w++) {
+        du_map_t* m = &ctx.maps[w];
+        for (size_t i = 0; i < m->cap; i++) {
+            const du_row_t* src = &m->slots[i];
+            if (!src->used) continue;
+            du_row_t* dst = du_map_get(&all, m->keys + src->key_off, src->key_len);
+            if (!dst) {
+                rc = ZFO_ERR_NO_MEMORY;
+                break;
+            }
+            dst->apparent += src->apparent;
+            dst->allocated += src->allocated;
+            dst->files += src->files;
+            dst->dirs += src->dirs;
+        }
+    }
+    for (int w = 0; w < nworkers; w++) du_map_free(&ctx.maps[w]);
+    free(ctx.maps);
+    free(ctx.links.keys);
+    pthread_mutex_destroy(&ctx.links.lock);
+
+    if (rc != ZFO_ERR_NO_MEMORY) {
+        int brc = du_build(&all, result);
+        if (brc != ZFO_OK) rc = brc;
+    }
+    du_map_free(&all);
+    result->hardlinks = ctx.hardlinks;
+    return rc;
+}
+
+void zfo_du_result_free(zfo_du_result_t* result) {
+    if (!result) return;
+    free(result->block);
+    free(result->names);
+    zfo_tree_result_free(&result->walk);
+    memset(result, 0, sizeof(*result));
+}
@@ -14,6 +14,9 @@
 #define _FILE_OFFSET_BITS 64
 
 #include "zorya_fileops.h"
+#include "zorya_fileops_internal.h"
+#include "dagger.h"
+#include "weave.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -27,6 +30,7 @@
 #include <sys/statvfs.h>
 #include <sys/mman.h>
 #include <sys/file.h>
+#include <sys/uio.h>
 #include <limits.h>
 #include <fnmatch.h>
 #include <glob.h>
@@ -34,7 +38,12 @@
 
 #ifdef __linux__
     #include <sys/inotify.h>
+    #include <sys/ioctl.h>
+    #include <sys/sendfile.h>
+    #include <sys/syscall.h>
+    #include <sys/sysmacros.h>
     #include <poll.h>
+    #include <pthread.h>
 #elif defined(__APPLE__)
     #include <sys/event.h>
     #include <CoreServices/CoreServices.h>
@@ -48,6 +57,9 @@ struct zfo_file {
     int fd;
     char path[PATH_MAX];
     int flags;
+    char* wbuf;                     /* Write-coalescing buffer */
+    size_t wbuf_len;
+    size_t wbuf_cap;
 };
 
 struct zfo_dir {
@@ -59,6 +71,7 @@ struct zfo_dir {
 struct zfo_mmap {
     void* ptr;
     size_t size;
+    size_t delta;           /* ptr - mapping start (page alignment) */
     int fd;
     bool owns_fd;
 };
@@ -66,13 +79,10 @@ struct zfo_mmap {
 #ifdef __linux__
 struct zfo_watch {
     int inotify_fd;
-    struct {
-        int wd;
-        char path[PATH_MAX];
-        int events;
-        bool recursive;
-    } watches[256];
-    int watch_count;
+    pthread_mutex_t lock;   /* Guards the tables (event threads read them) */
+    DaggerTable* by_wd;     /* wd -> watch entry */
+    Tablet* paths;          /* Interned watch paths */
+    uint32_t gen;           /* Overflow rescan generation */
 };
 #elif defined(__APPLE__)
 struct zfo_watch {
@@ -120,6 +130,10 @@ static int errno_to_zfo(int err) {
     }
 }
 
+int zfo_error_from_errno(int err) {
+    return errno_to_zfo(err);
+}
+
 static const char* error_messages[] = {
     [0] = "Success",
     [1] = "Invalid argument",
@@ -170,7 +184,7 @@ const char* zfo_strerror(int error) {
  * File Type Detection
  * ============================================================ */
 
-static zfo_file_type_t mode_to_type(mode_t mode) {
+zfo_file_type_t zfo_type_from_mode(mode_t mode) {
     if (S_ISREG(mode))  return ZFO_TYPE_FILE;
     if (S_ISDIR(mode))  return ZFO_TYPE_DIR;
     if (S_ISLNK(mode))  return ZFO_TYPE_SYMLINK;
@@ -226,18 +240,76 @@ zfo_file_t* zfo_open(const char* path, int flags, uint32_t mode) {
     return file;
 }
 
+/* Write everything in iov, retrying short writes; done counts bytes written */
+static int write_all_iov(int fd, struct iovec* iov, int count, size_t* done) {
+    *done = 0;
+    while (count > 0) {
+        ssize_t n = writev(fd, iov, count);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return errno_to_zfo(errno);
+        }
+        *done += (size_t)n;
+        while (count > 0 && (size_t)n >= iov->iov_len) {
+            n -= (ssize_t)iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char*)iov->iov_base + n;
+            iov->iov_len -= (size_t)n;
+        }
+    }
+    return ZFO_OK;
+}
+
+/*
+ * Write the buffer, then extra. On failure the buffered bytes that did
+ * not reach the file stay buffered so a later flush can retry them.
+ */
+static int flush_with(zfo_file_t* file, const void* extra, size_t extra_len) {
+    size_t len = file->wbuf_len;
+    if (len == 0 && extra_len == 0) return ZFO_OK;
+
+    struct iovec iov[2] = {
+        { file->wbuf, len },
+        { (void*)extra, extra_len }
+    };
+    size_t done;
+    int rc = len ? write_all_iov(file->fd, iov, extra_len ? 2 : 1, &done)
+                 : write_all_iov(file->fd, iov + 1, 1, &done);
+    if (rc == ZFO_OK || done >= len) {
+        file->wbuf_len = 0;
+        return rc;
+    }
+
+    memmove(file->wbuf, file->wbuf + done, len - done);
+    file->wbuf_len = len - done;
+    return rc;
+}
+
+/* Buffered data must land before anything else touches the file */
+static int flush_pending(zfo_file_t* file) {
+    return flush_with(file, NULL, 0);
+}
+
 int zfo_close(zfo_file_t* file) {
     if (!file) return ZFO_ERR_INVALID_ARG;
 
+    int flushed = flush_pending(file);
     int ret = close(file->fd);
     int err = errno;
+    free(file->wbuf);
     free(file);
 
+    if (flushed != ZFO_OK) return flushed;
     return ret == 0 ? ZFO_OK : errno_to_zfo(err);
 }
 
 zfo_off_t zfo_read(zfo_file_t* file, void* buf, size_t size) {
     if (!file || !buf) return ZFO_ERR_INVALID_ARG;
+    int rc = flush_pending(file);
+    if (rc != ZFO_OK) return rc;
 
     ssize_t n = read(file->fd, buf, size);
     if (n < 0) return errno_to_zfo(errno);
@@ -246,6 +318,8 @@ zfo_off_t zfo_read(zfo_file_t* file, void* buf, size_t size) {
 
 zfo_off_t zfo_write(zfo_file_t* file, const void* buf, size_t size) {
     if (!file || !buf) return ZFO_ERR_INVALID_ARG;
+    int rc = flush_pending(file);
+    if (rc != ZFO_OK) return rc;
 
     ssize_t n = write(file->fd, buf, size);
     if (n < 0) return errno_to_zfo(errno);
@@ -254,6 +328,8 @@ zfo_off_t zfo_write(zfo_file_t* file, const void* buf, size_t size) {
 
 zfo_off_t zfo_seek(zfo_file_t* file, zfo_off_t offset, int whence) {
     if (!file) return ZFO_ERR_INVALID_ARG;
+    int rc = flush_pending(file);
+    if (rc != ZFO_OK) return rc;
 
     off_t pos = lseek(file->fd, offset, whence);
     if (pos < 0) return errno_to_zfo(errno);
@@ -262,19 +338,178 @@ zfo_off_t zfo_seek(zfo_file_t* file, zfo_off_t offset, int whence) {
 
 zfo_off_t zfo_tell(zfo_file_t* file) {
     if (!file) return ZFO_ERR_INVALID_ARG;
-    return lseek(file->fd, 0, SEEK_CUR);
+    off_t pos = lseek(file->fd, 0, SEEK_CUR);
+    if (pos < 0) return errno_to_zfo(errno);
+    return pos + (zfo_off_t)file->wbuf_len;
 }
 
 int zfo_sync(zfo_file_t* file) {
     if (!file) return ZFO_ERR_INVALID_ARG;
+    int rc = flush_pending(file);
+    if (rc != ZFO_OK) return rc;
     return fsync(file->fd) == 0 ? ZFO_OK : errno_to_zfo(errno);
 }
 
 int zfo_truncate(zfo_file_t* file, zfo_off_t size) {
     if (!file) return ZFO_ERR_INVALID_ARG;
+    int rc = flush_pending(file);
+    if (rc != ZFO_OK) return rc;
     return ftruncate(file->fd, size) == 0 ? ZFO_OK : errno_to_zfo(errno);
 }
 
+int zfo_datasync(zfo_file_t* file) {
+    if (!file) return ZFO_ERR_INVALID_ARG;
+    int rc = flush_pending(file);
+    if (rc != ZFO_OK) return rc;
+#ifdef __linux__
+    return fdatasync(file->fd) == 0 ? ZFO_OK : errno_to_zfo(errno);
+#else
+    return fsync(file->fd) == 0 ? ZFO_OK : errno_to_zfo(errno);
+#endif
+}
+
+/* ============================================================
+ * Positional & Vectored I/O
+ * ============================================================ */
+
+zfo_off_t zfo_pread(zfo_file_t* file, void* buf, size_t size, zfo_off_t offset) {
+    if (!file || (!buf && size > 0) || offset < 0) return ZFO_ERR_INVALID_ARG;
+    int rc = flush_pending(file);
+    if (rc != ZFO_OK) return rc;
+
+    ssize_t n;
+    do {
+        n = pread(file->fd, buf, size, offset);
+    } while (n < 0 && errno == EINTR);
+    return n < 0 ? errno_to_zfo(errno) : n;
+}
+
+zfo_off_t zfo_pwrite(zfo_file_t* file, const void* buf, size_t size, zfo_off_t offset) {
+    if (!file || (!buf && size > 0) || offset < 0) return ZFO_ERR_INVALID_ARG;
+    int rc = flush_pending(file);
+    if (rc != ZFO_OK) return rc;
+
+    ssize_t n;
+    do {
+        n = pwrite(file->fd, buf, size, offset);
+    } while (n < 0 && errno == EINTR);
+    return n < 0 ? errno_to_zfo(errno) : n;
+}
+
+zfo_off_t zfo_readv(zfo_file_t* file, const zfo_iovec_t* iov, int count, zfo_off_t offset) {
+    if (!file || (!iov && count > 0) || count < 0 || count > IOV_MAX) return ZFO_ERR_INVALID_ARG;
+    int rc = flush_pending(file);
+    if (rc != ZFO_OK) return rc;
+
+    ssize_t n;
+    do {
+        n = offset < 0 ? readv(file->fd, (const struct iovec*)iov, count)
+                       : preadv(file->fd, (const struct iovec*)iov, count, offset);
+    } while (n < 0 && errno == EINTR);
+    return n < 0 ? errno_to_zfo(errno) : n;
+}
+
+zfo_off_t zfo_writev(zfo_file_t* file, const zfo_iovec_t* iov, int count, zfo_off_t offset) {
+    if (!file || (!iov && count > 0) || count < 0 || count > IOV_MAX) return ZFO_ERR_INVALID_ARG;
+    int rc = flush_pending(file);
+    if (rc != ZFO_OK) return rc;
+
+    ssize_t n;
+    do {
+        n = offset < 0 ? writev(file->fd, (const struct iovec*)iov, count)
+                       : pwritev(file->fd, (const struct iovec*)iov, count, offset);
+    } while (n < 0 && errno == EINTR);
+    return n < 0 ? errno_to_zfo(errno) : n;
+}
+
+int zfo_advise(zfo_file_t* file, zfo_off_t offset, zfo_off_t length, zfo_advice_t advice) {
+    if (!file || offset < 0 || length < 0) return ZFO_ERR_INVALID_ARG;
+#ifdef POSIX_FADV_NORMAL
+    static const int advices[] = {
+        POSIX_FADV_NORMAL, POSIX_FADV_SEQUENTIAL, POSIX_FADV_RANDOM,
+        POSIX_FADV_WILLNEED, POSIX_FADV_DONTNEED, POSIX_FADV_NOREUSE
+    };
+    if ((unsigned)advice >= sizeof(advices) / sizeof(advices[0])) return ZFO_ERR_INVALID_ARG;
+    int err = posix_fadvise(file->fd, offset, length, advices[advice]);
+    return err == 0 ? ZFO_OK : errno_to_zfo(err);
+#else
+    (void)advice;
+    return ZFO_OK;                  /* Only a hint */
+#endif
+}
+
+int zfo_allocate(zfo_file_t* file, zfo_off_t offset, zfo_off_t length, int flags) {
+    if (!file || offset < 0 || length <= 0) return ZFO_ERR_INVALID_ARG;
+    int rc = flush_pending(file);
+    if (rc != ZFO_OK) return rc;
+
+#ifdef __linux__
+    int mode = 0;
+    if (flags & ZFO_ALLOC_PUNCH_HOLE) mode = FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE;
+    else if (flags & ZFO_ALLOC_KEEP_SIZE) mode = FALLOC_FL_KEEP_SIZE;
+    if (fallocate(file->fd, mode, offset, length) == 0) return ZFO_OK;
+    if (errno != EOPNOTSUPP || mode != 0) return errno_to_zfo(errno);
+#else
+    if (flags) return ZFO_ERR_UNSUPPORTED;
+#endif
+    int err = posix_fallocate(file->fd, offset, length);
+    return err == 0 ? ZFO_OK : errno_to_zfo(err);
+}
+
+/* ============================================================
+ * Buffered Writes
+ * ============================================================ */
+
+int zfo_set_write_buffer(zfo_file_t* file, size_t size) {
+    if (!file) return ZFO_ERR_INVALID_ARG;
+    int rc = flush_pending(file);
+    if (rc != ZFO_OK) return rc;
+
+    if (size == 0) {
+        free(file->wbuf);
+        file->wbuf = NULL;
+        file->wbuf_cap = 0;
+        return ZFO_OK;
+    }
+    char* buf = realloc(file->wbuf, size);
+    if (!buf) return ZFO_ERR_NO_MEMORY;
+    file->wbuf = buf;
+    file->wbuf_cap = size;
+    return ZFO_OK;
+}
+
+int zfo_write_buffered(zfo_file_t* file, const void* buf, size_t size) {
+    if (!file || (!buf && size > 0)) return ZFO_ERR_INVALID_ARG;
+
+    if (file->wbuf_len + size <= file->wbuf_cap) {
+        memcpy(file->wbuf + file->wbuf_len, buf, size);
+        file->wbuf_len += size;
+        return ZFO_OK;
+    }
+
+    /* Send the buffer topped up to capacity when that's enough to keep the
+     * rest, otherwise send it along with all of buf. On failure none of buf
+     * is kept, only the earlier bytes that are still unwritten. */
+    size_t room = file->wbuf_cap - file->wbuf_len;
+    if (size - room < file->wbuf_cap) {
+        int rc = flush_with(file, buf, room);
+        if (rc != ZFO_OK) return rc;
+        memcpy(file->wbuf, (const char*)buf + room, size - room);
+        file->wbuf_len = size - room;
+        return ZFO_OK;
+    }
+    return flush_with(file, buf, size);
+}
+
+int zfo_flush(zfo_file_t* file) {
+    if (!file) return ZFO_ERR_INVALID_ARG;
+    return flush_pending(file);
+}
+
+size_t zfo_buffered(const zfo_file_t* file) {
+    return file ? file->wbuf_len : 0;
+}
+
 /* ============================================================
  * Convenience I/O
  * ============================================================ */
@@ -317,29 +552,137 @@ int zfo_read_file(const char* path, uint8_t** out_buf, size_t* out_size) {
     return ZFO_OK;
 }
 
-int zfo_write_file(const char* path, const void* buf, size_t size) {
-    if (!path || !buf) return ZFO_ERR_INVALID_ARG;
-
-    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
-    if (fd < 0) return errno_to_zfo(errno);
-
+static int write_all_at(int fd, const uint8_t* buf, size_t size, off_t offset) {
     size_t total = 0;
     while (total < size) {
-        ssize_t n = write(fd, (const uint8_t*)buf + total, size - total);
+        ssize_t n = pwrite(fd, buf + total, size - total, offset + (off_t)total);
         if (n < 0) {
             if (errno == EINTR) continue;
-            close(fd);
             return errno_to_zfo(errno);
         }
         total += n;
     }
+    return ZFO_OK;
+}
 
-    close(fd);
+/*
+ * Zero test for one block. The OR reduction has no early exit so the
+ * compiler vectorizes it; callers stop between blocks.
+ */
+static bool block_is_zero(const uint8_t* p, size_t len) {
+    uint64_t acc = 0;
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        uint64_t w[8];
+        memcpy(w, p + i, sizeof(w));
+        acc |= w[0] | w[1] | w[2] | w[3] | w[4] | w[5] | w[6] | w[7];
+    }
+    for (; i < len; i++) acc |= p[i];
+    return acc == 0;
+}
+
+/* Reserve blocks for [offset, offset + len); only a hint where unsupported */
+static int write_reserve(int fd, off_t offset, off_t len) {
+#ifdef __linux__
+    if (fallocate(fd, 0, offset, len) == 0) return ZFO_OK;
+    if (errno != EOPNOTSUPP && errno != ENOSYS) return errno_to_zfo(errno);
+    return ZFO_OK;
+#else
+    int err = posix_fallocate(fd, offset, len);
+    return err == 0 || err == EINVAL || err == EOPNOTSUPP ? ZFO_OK : errno_to_zfo(err);
+#endif
+}
+
+/* Write the data runs of buf and leave zero runs of at least hole_min as holes */
+static int write_sparse(int fd, const uint8_t* buf, size_t size, size_t hole_min,
+                        bool reserve, zfo_write_stats_t* stats) {
+    /* One truncate sets the final size; skipped ranges read back as zeros */
+    if (ftruncate(fd, (off_t)size) != 0) return errno_to_zfo(errno);
+
+    const size_t block = ZFO_WRITE_BLOCK;
+    size_t data_start = 0;
+    size_t pos = 0;
+
+    while (pos < size) {
+        size_t run = 0;
+        while (pos + run < size) {
+            size_t len = size - pos - run < block ? size - pos - run : block;
+            if (!block_is_zero(buf + pos + run, len)) break;
+            run += len;
+        }
+
+        if (run == 0) {
+            pos += block;
+            continue;
+        }
+        if (run < hole_min && pos + run < size) {
+            pos += run;
+            continue;
+        }
+
+        if (pos > data_start) {
+            if (reserve) {
+                int rc = write_reserve(fd, (off_t)data_start, (off_t)(pos - data_start));
+                if (rc != ZFO_OK) return rc;
+            }
+            int rc = write_all_at(fd, buf + data_start, pos - data_start, (off_t)data_start);
+            if (rc != ZFO_OK) return rc;
+            stats->written += pos - data_start;
+        }
+        stats->holes++;
+        stats->hole_bytes += run;
+        pos += run;
+        data_start = pos;
+    }
+
+    if (size > data_start) {
+        if (reserve) {
+            int rc = write_reserve(fd, (off_t)data_start, (off_t)(size - data_start));
+            if (rc != ZFO_OK) return rc;
+        }
+        int rc = write_all_at(fd, buf + data_start, size - data_start, (off_t)data_start);
+        if (rc != ZFO_OK) return rc;
+        stats->written += size - data_start;
+    }
     return ZFO_OK;
 }
 
+int zfo_write_file_opts(const char* path, const void* buf, size_t size,
+                        const zfo_write_options_t* opts, zfo_write_stats_t* stats) {
+    if (!path || (!buf && size > 0)) return ZFO_ERR_INVALID_ARG;
+
+    zfo_write_stats_t local = {0};
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+
+    uint32_t flags = opts ? opts->flags : 0;
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return errno_to_zfo(errno);
+
+    int rc = ZFO_OK;
+    if (size == 0) {
+        /* Nothing to write */
+    } else if (flags & ZFO_WRITE_SPARSE) {
+        size_t hole_min = opts->hole_min ? opts->hole_min : ZFO_WRITE_HOLE_MIN;
+        hole_min = (hole_min + ZFO_WRITE_BLOCK - 1) / ZFO_WRITE_BLOCK * ZFO_WRITE_BLOCK;
+        rc = write_sparse(fd, buf, size, hole_min, (flags & ZFO_WRITE_PREALLOCATE) != 0, stats);
+    } else {
+        /* Reserving the whole file up front also sets its size once */
+        if (flags & ZFO_WRITE_PREALLOCATE) rc = write_reserve(fd, 0, (off_t)size);
+        if (rc == ZFO_OK) rc = write_all_at(fd, buf, size, 0);
+        if (rc == ZFO_OK) stats->written = size;
+    }
+
+    if (close(fd) != 0 && rc == ZFO_OK) rc = errno_to_zfo(errno);
+    return rc;
+}
+
+int zfo_write_file(const char* path, const void* buf, size_t size) {
+    return zfo_write_file_opts(path, buf, size, NULL, NULL);
+}
+
 int zfo_append_file(const char* path, const void* buf, size_t size) {
-    if (!path || !buf) return ZFO_ERR_INVALID_ARG;
+    if (!path || (!buf && size > 0)) return ZFO_ERR_INVALID_ARG;
 
     int fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
     if (fd < 0) return errno_to_zfo(errno);
@@ -373,7 +716,7 @@ int zfo_write_text(const char* path, const char* str) {
  * ============================================================ */
 
 static void stat_to_zfo(const struct stat* st, zfo_stat_t* zst) {
-    zst->type = mode_to_type(st->st_mode);
+    zst->type = zfo_type_from_mode(st->st_mode);
     zst->size = st->st_size;
     zst->mode = st->st_mode & 07777;
     zst->uid = st->st_uid;
@@ -393,6 +736,60 @@ static void stat_to_zfo(const struct stat* st, zfo_stat_t* zst) {
     zst->blksize = st->st_blksize;
 }
 
+#if defined(__linux__) && defined(STATX_BASIC_STATS)
+static void statx_to_zfo(const struct statx* sx, zfo_stat_t* zst) {
+    zst->type = zfo_type_from_mode(sx->stx_mode);
+    zst->size = (zfo_off_t)sx->stx_size;
+    zst->mode = sx->stx_mode & 07777;
+    zst->uid = sx->stx_uid;
+    zst->gid = sx->stx_gid;
+    zst->inode = sx->stx_ino;
+    zst->dev = makedev(sx->stx_dev_major, sx->stx_dev_minor);
+    zst->nlink = sx->stx_nlink;
+    zst->atime = sx->stx_atime.tv_sec;
+    zst->mtime = sx->stx_mtime.tv_sec;
+    zst->ctime = sx->stx_ctime.tv_sec;
+    zst->btime = (sx->stx_mask & STATX_BTIME) ? sx->stx_btime.tv_sec : 0;
+    zst->blocks = sx->stx_blocks;
+    zst->blksize = sx->stx_blksize;
+}
+#endif
+
+int zfo_stat_at(int dirfd, const char* name, bool follow, zfo_stat_t* zst) {
+    if (!name || !zst) return ZFO_ERR_INVALID_ARG;
+
+#if defined(__linux__) && defined(STATX_BASIC_STATS)
+    /* AT_STATX_DONT_SYNC: never force a round trip on network filesystems */
+    struct statx sx;
+    int flags = AT_STATX_DONT_SYNC | (follow ? 0 : AT_SYMLINK_NOFOLLOW);
+    if (statx(dirfd, name, flags, STATX_BASIC_STATS | STATX_BTIME, &sx) == 0) {
+        statx_to_zfo(&sx, zst);
+        return ZFO_OK;
+    }
+    if (errno != ENOSYS) return errno_to_zfo(errno);
+#endif
+
+    struct stat st;
+    if (fstatat(dirfd, name, &st, follow ? 0 : AT_SYMLINK_NOFOLLOW) != 0) {
+        return errno_to_zfo(errno);
+    }
+    stat_to_zfo(&st, zst);
+    return ZFO_OK;
+}
+
+zfo_file_type_t zfo_type_from_dtype(unsigned char d_type) {
+    switch (d_type) {
+        case DT_REG:  return ZFO_TYPE_FILE;
+        case DT_DIR:  return ZFO_TYPE_DIR;
+        case DT_LNK:  return ZFO_TYPE_SYMLINK;
+        case DT_FIFO: return ZFO_TYPE_FIFO;
+        case DT_SOCK: return ZFO_TYPE_SOCKET;
+        case DT_BLK:  return ZFO_TYPE_BLOCK;
+        case DT_CHR:  return ZFO_TYPE_CHAR;
+        default:      return ZFO_TYPE_UNKNOWN;
+    }
+}
+
 int zfo_stat(const char* path, zfo_stat_t* zst) {
     if (!path || !zst) return ZFO_ERR_INVALID_ARG;
 
@@ -415,6 +812,8 @@ int zfo_lstat(const char* path, zfo_stat_t* zst) {
 
 int zfo_fstat(zfo_file_t* file, zfo_stat_t* zst) {
     if (!file || !zst) return ZFO_ERR_INVALID_ARG;
+    int rc = flush_pending(file);
+    if (rc != ZFO_OK) return rc;
 
     struct stat st;
     if (fstat(file->fd, &st) != 0) return errno_to_zfo(errno);
@@ -453,6 +852,208 @@ zfo_off_t zfo_size(const char* path) {
  * File Manipulation
  * ============================================================ */
 
+/*
+ * Data copy strategy, tried in order of cost:
+ *   1. FICLONE        - reflink, shares extents on btrfs/XFS (no data moved)
+ *   2. copy_file_range - in-kernel copy, may offload to the filesystem
+ *   3. sendfile       - in-kernel copy through the page cache
+ *   4. pread/pwrite   - user-space buffer, last resort
+ * Each method that reports "not supported" is disabled for the rest
+ * of the copy so sparse files don't re-probe it for every extent.
+ */
+
+#ifdef __linux__
+    #ifndef FICLONE
+        #define FICLONE _IOW(0x94, 9, int)
+    #endif
+#endif
+
+typedef struct {
+    bool try_copy_range;
+    bool try_sendfile;
+    char* buf;
+    size_t bufsize;
+} copy_state_t;
+
+static bool copy_method_unsupported(int err) {
+    return err == ENOSYS || err == EXDEV || err == EINVAL ||
+           err == EBADF || err == ENOTSUP || err == EOPNOTSUPP;
+}
+
+static int copy_range_buffered(int src_fd, int dst_fd, off_t off, off_t len,
+                               copy_state_t* cs) {
+    if (!cs->buf) {
+        cs->buf = malloc(cs->bufsize);
+        if (!cs->buf) return ZFO_ERR_NO_MEMORY;
+    }
+
+    while (len > 0) {
+        size_t chunk = (size_t)len < cs->bufsize ? (size_t)len : cs->bufsize;
+        ssize_t n = pread(src_fd, cs->buf, chunk, off);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return errno_to_zfo(errno);
+        }
+        if (n == 0) break;  /* Source shrank underneath us */
+
+        ssize_t written = 0;
+        while (written < n) {
+            ssize_t w = pwrite(dst_fd, cs->buf + written, n - written, off + written);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                return errno_to_zfo(errno);
+            }
+            written += w;
+        }
+
+        off += n;
+        len -= n;
+    }
+
+    return ZFO_OK;
+}
+
+/*
+ * Copy from off until read() reports end of file. Used for files whose
+ * st_size is not their length: procfs and sysfs report 0 (or a page).
+ */
+static int copy_stream_buffered(int src_fd, int dst_fd, off_t off, copy_state_t* cs) {
+    if (!cs->buf) {
+        cs->buf = malloc(cs->bufsize);
+        if (!cs->buf) return ZFO_ERR_NO_MEMORY;
+    }
+
+    /* Unseekable sources can only be streamed from their start */
+    if (lseek(src_fd, off, SEEK_SET) < 0 && !(errno == ESPIPE && off == 0)) {
+        return errno_to_zfo(errno);
+    }
+    if (lseek(dst_fd, off, SEEK_SET) < 0) return errno_to_zfo(errno);
+
+    for (;;) {
+        ssize_t n = read(src_fd, cs->buf, cs->bufsize);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return errno_to_zfo(errno);
+        }
+        if (n == 0) return ZFO_OK;
+
+        ssize_t written = 0;
+        while (written < n) {
+            ssize_t w = write(dst_fd, cs->buf + written, n - written);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                return errno_to_zfo(errno);
+            }
+            written += w;
+        }
+    }
+}
+
+/* Copy [off, off + len) from src_fd to the same offset in dst_fd */
+static int copy_range(int src_fd, int dst_fd, off_t off, off_t len, copy_state_t* cs) {
+#if defined(__linux__) && defined(__NR_copy_file_range)
+    while (cs->try_copy_range && len > 0) {
+        loff_t in_off = off, out_off = off;
+        ssize_t n = syscall(__NR_copy_file_range, src_fd, &in_off, dst_fd, &out_off,
+                            (size_t)len, 0u);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (!copy_method_unsupported(errno)) return errno_to_zfo(errno);
+            cs->try_copy_range = false;
+            break;
+        }
+        if (n == 0) return copy_stream_buffered(src_fd, dst_fd, off, cs);
+        off += n;
+        len -= n;
+    }
+#endif
+
+#ifdef __linux__
+    while (cs->try_sendfile && len > 0) {
+        if (lseek(dst_fd, off, SEEK_SET) < 0) return errno_to_zfo(errno);
+
+        off_t in_off = off;
+        size_t chunk = (size_t)len > 0x7ffff000 ? 0x7ffff000 : (size_t)len;
+        ssize_t n = sendfile(dst_fd, src_fd, &in_off, chunk);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (!copy_method_unsupported(errno)) return errno_to_zfo(errno);
+            cs->try_sendfile = false;
+            break;
+        }
+        if (n == 0) return copy_stream_buffered(src_fd, dst_fd, off, cs);
+        off += n;
+        len -= n;
+    }
+#endif
+
+    if (len <= 0) return ZFO_OK;
+    return copy_range_buffered(src_fd, dst_fd, off, len, cs);
+}
+
+/*
+ * Copy file contents between two open descriptors. dst_fd must refer
+ * to an empty file. Holes in the source are preserved when the
+ * filesystem reports them through SEEK_DATA/SEEK_HOLE.
+ */
+int zfo_copy_fd_data(int src_fd, int dst_fd, const struct stat* st, size_t bufsize) {
+    off_t size = st->st_size;
+    copy_state_t cs = {
+        .try_copy_range = true,
+        .try_sendfile = true,
+        .buf = NULL,
+        .bufsize = bufsize
+    };
+    int ret = ZFO_OK;
+
+    /* Empty, or a pseudo-file that doesn't know its length yet */
+    if (size == 0) {
+        ret = copy_stream_buffered(src_fd, dst_fd, 0, &cs);
+        free(cs.buf);
+        return ret;
+    }
+
+#ifdef __linux__
+    if (ioctl(dst_fd, FICLONE, src_fd) == 0) return ZFO_OK;
+#endif
+
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+    /* Allocated blocks smaller than the size means there are holes */
+    if ((off_t)st->st_blocks * 512 < size) {
+        off_t pos = 0;
+        while (pos < size) {
+            off_t data = lseek(src_fd, pos, SEEK_DATA);
+            if (data < 0) {
+                if (errno == ENXIO) break;  /* Only a hole remains */
+                if (pos == 0) goto dense;   /* SEEK_DATA unsupported */
+                ret = errno_to_zfo(errno);
+                goto done;
+            }
+
+            off_t hole = lseek(src_fd, data, SEEK_HOLE);
+            if (hole < 0) hole = size;
+
+            ret = copy_range(src_fd, dst_fd, data, hole - data, &cs);
+            if (ret != ZFO_OK) goto done;
+            pos = hole;
+        }
+
+        /* Extend over any trailing hole */
+        if (ftruncate(dst_fd, size) != 0) ret = errno_to_zfo(errno);
+        goto done;
+    }
+
+dense:
+#endif
+    ret = copy_range(src_fd, dst_fd, 0, size, &cs);
+
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+done:
+#endif
+    free(cs.buf);
+    return ret;
+}
+
 int zfo_copy(const char* src, const char* dst, const zfo_copy_options_t* opts) {
     if (!src || !dst) return ZFO_ERR_INVALID_ARG;
 
@@ -538,41 +1139,16 @@ int zfo_copy(const char* src, const char* dst, const zfo_copy_options_t* opts) {
         return errno_to_zfo(err);
     }
 
-    char* buf = malloc(bufsize);
-    if (!buf) {
-        close(src_fd);
-        close(dst_fd);
-        return ZFO_ERR_NO_MEMORY;
+    int ret = zfo_copy_fd_data(src_fd, dst_fd, &st, bufsize);
+
+    /* Preserve attributes */
+    if (ret == ZFO_OK) {
+        if (opts->preserve_mode) fchmod(dst_fd, st.st_mode);
+        if (opts->preserve_owner) fchown(dst_fd, st.st_uid, st.st_gid);
     }
 
-    ssize_t n;
-    int ret = ZFO_OK;
-
-    while ((n = read(src_fd, buf, bufsize)) > 0) {
-        ssize_t written = 0;
-        while (written < n) {
-            ssize_t w = write(dst_fd, buf + written, n - written);
-            if (w < 0) {
-                if (errno == EINTR) continue;
-                ret = errno_to_zfo(errno);
-                goto cleanup;
-            }
-            written += w;
-        }
-    }
-
-    if (n < 0) ret = errno_to_zfo(errno);
-
-    /* Preserve attributes */
-    if (ret == ZFO_OK) {
-        if (opts->preserve_mode) fchmod(dst_fd, st.st_mode);
-        if (opts->preserve_owner) fchown(dst_fd, st.st_uid, st.st_gid);
-    }
-
-cleanup:
-    free(buf);
-    close(src_fd);
-    close(dst_fd);
+    close(src_fd);
+    close(dst_fd);
 
     if (ret == ZFO_OK && opts->preserve_times) {
         struct utimbuf times = { .actime = st.st_atime, .modtime = st.st_mtime };
@@ -794,6 +1370,118 @@ int zfo_closedir(zfo_dir_t* dir) {
     return ZFO_OK;
 }
 
+/*
+ * Raw directory scanner. On Linux this reads getdents64 records
+ * directly into a 32 KB buffer: no DIR* allocation, no per-entry
+ * copy, and d_type comes for free on every mainstream filesystem.
+ */
+
+#if defined(__linux__) && defined(SYS_getdents64)
+#define ZFO_DIRSCAN_GETDENTS 1
+
+struct zfo_linux_dirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+#define ZFO_DIRSCAN_BUFSIZE (32 * 1024)
+#endif
+
+int zfo_dirscan_open(zfo_dirscan_t* scan, int fd) {
+    if (!scan || fd < 0) return ZFO_ERR_INVALID_ARG;
+    memset(scan, 0, sizeof(*scan));
+    scan->fd = fd;
+
+#ifdef ZFO_DIRSCAN_GETDENTS
+    scan->buf = malloc(ZFO_DIRSCAN_BUFSIZE);
+    if (!scan->buf) return ZFO_ERR_NO_MEMORY;
+#else
+    int dup_fd = dup(fd);
+    if (dup_fd < 0) return errno_to_zfo(errno);
+    DIR* dir = fdopendir(dup_fd);
+    if (!dir) {
+        int err = errno;
+        close(dup_fd);
+        return errno_to_zfo(err);
+    }
+    rewinddir(dir);
+    scan->dir = dir;
+#endif
+
+    return ZFO_OK;
+}
+
+static bool is_dot_or_dotdot(const char* name) {
+    return name[0] == '.' && (name[1] == 0 || (name[1] == '.' && name[2] == 0));
+}
+
+bool zfo_dirscan_next(zfo_dirscan_t* scan, const char** name,
+                      unsigned char* d_type, uint64_t* inode) {
+#ifdef ZFO_DIRSCAN_GETDENTS
+    for (;;) {
+        if (scan->pos >= scan->len) {
+            long n = syscall(SYS_getdents64, scan->fd, scan->buf, ZFO_DIRSCAN_BUFSIZE);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0) scan->error = errno_to_zfo(errno);
+            if (n <= 0) return false;
+            scan->len = (size_t)n;
+            scan->pos = 0;
+        }
+
+        struct zfo_linux_dirent64* d = (struct zfo_linux_dirent64*)(scan->buf + scan->pos);
+        scan->pos += d->d_reclen;
+        if (is_dot_or_dotdot(d->d_name)) continue;
+
+        *name = d->d_name;
+        if (d_type) *d_type = d->d_type;
+        if (inode) *inode = d->d_ino;
+        return true;
+    }
+#else
+    struct dirent* entry;
+    errno = 0;
+    while ((entry = readdir((DIR*)scan->dir)) != NULL) {
+        if (is_dot_or_dotdot(entry->d_name)) continue;
+        *name = entry->d_name;
+#ifdef _DIRENT_HAVE_D_TYPE
+        if (d_type) *d_type = entry->d_type;
+#else
+        if (d_type) *d_type = DT_UNKNOWN;
+#endif
+        if (inode) *inode = entry->d_ino;
+        return true;
+    }
+    if (errno != 0) scan->error = errno_to_zfo(errno);
+    return false;
+#endif
+}
+
+int zfo_dirscan_error(const zfo_dirscan_t* scan) {
+    return scan ? scan->error : ZFO_ERR_INVALID_ARG;
+}
+
+void zfo_dirscan_close(zfo_dirscan_t* scan) {
+    if (!scan) return;
+    free(scan->buf);
+    if (scan->dir) closedir((DIR*)scan->dir);
+    scan->buf = NULL;
+    scan->dir = NULL;
+}
+
+typedef struct {
+    zfo_walk_callback_t callback;
+    void* userdata;
+} walk_adapter_t;
+
+static int walk_adapter_visit(const zfo_walk_entry_t* entry, void* userdata) {
+    walk_adapter_t* adapter = userdata;
+    return adapter->callback(entry->path, entry->stat, entry->depth, adapter->userdata) != 0
+        ? ZFO_WALK_STOP : ZFO_WALK_CONTINUE;
+}
+
 int zfo_walk(const char* path, zfo_walk_callback_t callback, int max_depth, void* userdata) {
     if (!path || !callback) return ZFO_ERR_INVALID_ARG;
 
@@ -806,84 +1494,71 @@ int zfo_walk(const char* path, zfo_walk_callback_t callback, int max_depth, void
     if (st.type != ZFO_TYPE_DIR) return ZFO_OK;
     if (max_depth == 0) return ZFO_OK;
 
-    DIR* dir = opendir(path);
-    if (!dir) return errno_to_zfo(errno);
-
-    struct dirent* entry;
-    while ((entry = readdir(dir)) != NULL) {
-        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-            continue;
-        }
-
-        char child[PATH_MAX];
-        snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
-
-        ret = zfo_stat(child, &st);
-        if (ret != ZFO_OK) continue;
-
-        if (callback(child, &st, 1, userdata) != 0) break;
-
-        if (st.type == ZFO_TYPE_DIR && max_depth != 0) {
-            /* Recursively walk subdirectories */
-            zfo_walk(child, callback, max_depth > 0 ? max_depth - 1 : -1, userdata);
-        }
-    }
+    /* Single worker keeps the callback serial, as it always was */
+    walk_adapter_t adapter = { callback, userdata };
+    zfo_walk_options_t opts = {
+        .threads = 1,
+        .max_depth = max_depth,
+        .flags = ZFO_WALK_STAT | ZFO_WALK_FOLLOW_SYMLINKS,
+        .visit = walk_adapter_visit,
+        .userdata = &adapter
+    };
 
-    closedir(dir);
+    /* Unreadable entries are skipped, as before */
+    zfo_walk_parallel(path, &opts, NULL);
     return ZFO_OK;
 }
 
 int zfo_listdir(const char* path, zfo_dirent_t** out_entries, size_t* out_count) {
     if (!path || !out_entries || !out_count) return ZFO_ERR_INVALID_ARG;
 
-    DIR* dir = opendir(path);
-    if (!dir) return errno_to_zfo(errno);
-
-    /* Count entries first */
-    size_t count = 0;
-    struct dirent* entry;
-    while ((entry = readdir(dir)) != NULL) {
-        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
-            count++;
-        }
-    }
+    int fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return errno_to_zfo(errno);
 
-    zfo_dirent_t* entries = calloc(count, sizeof(zfo_dirent_t));
-    if (!entries) {
-        closedir(dir);
-        return ZFO_ERR_NO_MEMORY;
+    zfo_dirscan_t scan;
+    int rc = zfo_dirscan_open(&scan, fd);
+    if (rc != ZFO_OK) {
+        close(fd);
+        return rc;
     }
 
-    rewinddir(dir);
-    size_t i = 0;
-    while ((entry = readdir(dir)) != NULL && i < count) {
-        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-            continue;
-        }
-
-        size_t name_len = strlen(entry->d_name);
-        if (name_len >= sizeof(entries[i].name)) {
-            name_len = sizeof(entries[i].name) - 1;
-        }
-        memcpy(entries[i].name, entry->d_name, name_len);
-        entries[i].name[name_len] = '\0';
-
-#ifdef _DIRENT_HAVE_D_TYPE
-        switch (entry->d_type) {
-            case DT_REG:  entries[i].type = ZFO_TYPE_FILE; break;
-            case DT_DIR:  entries[i].type = ZFO_TYPE_DIR; break;
-            case DT_LNK:  entries[i].type = ZFO_TYPE_SYMLINK; break;
-            default:      entries[i].type = ZFO_TYPE_UNKNOWN; break;
+    /* One pass, growing the array instead of counting first */
+    zfo_dirent_t* entries = NULL;
+    size_t count = 0, cap = 0;
+    const char* name;
+    unsigned char d_type;
+    uint64_t inode;
+    while (zfo_dirscan_next(&scan, &name, &d_type, &inode)) {
+        if (count == cap) {
+            size_t new_cap = cap ? cap * 2 : 64;
+            zfo_dirent_t* grown = realloc(entries, new_cap * sizeof(zfo_dirent_t));
+            if (!grown) {
+                rc = ZFO_ERR_NO_MEMORY;
+                break;
+            }
+            entries = grown;
+            cap = new_cap;
         }
-#endif
 
-        i++;
+        zfo_dirent_t* e = &entries[count++];
+        size_t name_len = strlen(name);
+        if (name_len >= sizeof(e->name)) name_len = sizeof(e->name) - 1;
+        memcpy(e->name, name, name_len);
+        e->name[name_len] = '\0';
+        e->type = zfo_type_from_dtype(d_type);
+        e->inode = inode;
     }
 
-    closedir(dir);
+    if (rc == ZFO_OK) rc = zfo_dirscan_error(&scan);
+    zfo_dirscan_close(&scan);
+    close(fd);
 
+    if (rc != ZFO_OK) {
+        free(entries);
+        return rc;
+    }
     *out_entries = entries;
-    *out_count = i;
+    *out_count = count;
     return ZFO_OK;
 }
 
@@ -985,58 +1660,19 @@ int zfo_normalize(const char* path, char* buf, size_t size) {
     if (!path || !buf || size == 0) return ZFO_ERR_INVALID_ARG;
 
     /* Handle . and .. without requiring path to exist */
-    char tmp[4096];
-    strncpy(tmp, path, sizeof(tmp) - 1);
-    tmp[sizeof(tmp) - 1] = 0;
-
-    /* Split path into components */
-    char* components[256];
-    int count = 0;
-    bool is_absolute = (tmp[0] == '/');
-    
-    char* saveptr = NULL;
-    char* token = strtok_r(tmp, "/", &saveptr);
-    while (token && count < 256) {
-        if (strcmp(token, ".") == 0) {
-            /* Skip "." */
-        } else if (strcmp(token, "..") == 0) {
-            /* Go up one level if possible */
-            if (count > 0 && strcmp(components[count - 1], "..") != 0) {
-                count--;
-            } else if (!is_absolute) {
-                components[count++] = "..";
-            }
-        } else {
-            components[count++] = token;
-        }
-        token = strtok_r(NULL, "/", &saveptr);
-    }
-
-    /* Rebuild path */
-    buf[0] = 0;
-    size_t pos = 0;
-    
-    if (is_absolute) {
-        buf[pos++] = '/';
-        buf[pos] = 0;
-    }
-
-    for (int i = 0; i < count; i++) {
-        if (i > 0) {
-            if (pos < size - 1) buf[pos++] = '/';
-        }
-        size_t clen = strlen(components[i]);
-        size_t copy_len = (pos + clen < size - 1) ? clen : (size - 1 - pos);
-        memcpy(buf + pos, components[i], copy_len);
-        pos += copy_len;
-        buf[pos] = 0;
-    }
-
-    if (pos == 0) {
-        buf[0] = '.';
-        buf[1] = 0;
+    size_t len = strlen(path);
+    if (len + 2 <= size) {
+        zfo_normalize_len(path, len, buf);
+        return ZFO_OK;
     }
 
+    char* tmp = malloc(len + 2);
+    if (!tmp) return ZFO_ERR_NO_MEMORY;
+    size_t n = zfo_normalize_len(path, len, tmp);
+    if (n >= size) n = size - 1;
+    memcpy(buf, tmp, n);
+    buf[n] = 0;
+    free(tmp);
     return ZFO_OK;
 }
 
@@ -1113,13 +1749,35 @@ zfo_file_t* zfo_tmpfile(const char* prefix, char* out_path) {
  * Memory Mapping
  * ============================================================ */
 
+/*
+ * Resolve length 0 to the rest of the file and refuse ranges past end of
+ * file: pages beyond it raise SIGBUS when touched.
+ */
+static bool mmap_check_range(int fd, zfo_off_t offset, size_t* length) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) return false;
+
+    if (offset < 0 || offset > st.st_size) {
+        errno = EINVAL;
+        return false;
+    }
+    size_t avail = (size_t)(st.st_size - offset);
+    if (*length == 0) *length = avail;
+    if (*length > avail) {
+        errno = EINVAL;
+        return false;
+    }
+    return true;
+}
+
 zfo_mmap_t* zfo_mmap(const char* path, zfo_off_t offset, size_t length, int flags) {
     if (!path) return NULL;
 
+    /* Private writes are copy-on-write and never reach the file */
     int oflags = O_RDONLY;
-    if (flags & ZFO_MMAP_WRITE) oflags = O_RDWR;
+    if ((flags & ZFO_MMAP_WRITE) && (flags & ZFO_MMAP_SHARED)) oflags = O_RDWR;
 
-    int fd = open(path, oflags);
+    int fd = open(path, oflags | O_CLOEXEC);
     if (fd < 0) return NULL;
 
     zfo_mmap_t* map = calloc(1, sizeof(zfo_mmap_t));
@@ -1131,15 +1789,12 @@ zfo_mmap_t* zfo_mmap(const char* path, zfo_off_t offset, size_t length, int flag
     map->fd = fd;
     map->owns_fd = true;
 
-    /* Get file size if length not specified */
-    if (length == 0) {
-        struct stat st;
-        if (fstat(fd, &st) != 0) {
-            close(fd);
-            free(map);
-            return NULL;
-        }
-        length = st.st_size - offset;
+    if (!mmap_check_range(fd, offset, &length)) {
+        int err = errno;
+        close(fd);
+        free(map);
+        errno = err;
+        return NULL;
     }
 
     int prot = 0;
@@ -1151,15 +1806,18 @@ zfo_mmap_t* zfo_mmap(const char* path, zfo_off_t offset, size_t length, int flag
     if (flags & ZFO_MMAP_SHARED) mflags |= MAP_SHARED;
     else mflags |= MAP_PRIVATE;
 
-    void* ptr = mmap(NULL, length, prot, mflags, fd, offset);
+    /* mmap offsets must be page aligned; map from the page start */
+    size_t delta = (size_t)(offset % sysconf(_SC_PAGESIZE));
+    void* ptr = mmap(NULL, length + delta, prot, mflags, fd, offset - delta);
     if (ptr == MAP_FAILED) {
         close(fd);
         free(map);
         return NULL;
     }
 
-    map->ptr = ptr;
+    map->ptr = (uint8_t*)ptr + delta;
     map->size = length;
+    map->delta = delta;
 
     return map;
 }
@@ -1173,13 +1831,11 @@ zfo_mmap_t* zfo_mmap_file(zfo_file_t* file, zfo_off_t offset, size_t length, int
     map->fd = file->fd;
     map->owns_fd = false;
 
-    if (length == 0) {
-        struct stat st;
-        if (fstat(file->fd, &st) != 0) {
-            free(map);
-            return NULL;
-        }
-        length = st.st_size - offset;
+    if (!mmap_check_range(file->fd, offset, &length)) {
+        int err = errno;
+        free(map);
+        errno = err;
+        return NULL;
     }
 
     int prot = 0;
@@ -1191,14 +1847,16 @@ zfo_mmap_t* zfo_mmap_file(zfo_file_t* file, zfo_off_t offset, size_t length, int
     if (flags & ZFO_MMAP_SHARED) mflags |= MAP_SHARED;
     else mflags |= MAP_PRIVATE;
 
-    void* ptr = mmap(NULL, length, prot, mflags, file->fd, offset);
+    size_t delta = (size_t)(offset % sysconf(_SC_PAGESIZE));
+    void* ptr = mmap(NULL, length + delta, prot, mflags, file->fd, offset - delta);
     if (ptr == MAP_FAILED) {
         free(map);
         return NULL;
     }
 
-    map->ptr = ptr;
+    map->ptr = (uint8_t*)ptr + delta;
     map->size = length;
+    map->delta = delta;
 
     return map;
 }
@@ -1213,14 +1871,93 @@ size_t zfo_mmap_size(zfo_mmap_t* map) {
 
 int zfo_mmap_sync(zfo_mmap_t* map) {
     if (!map) return ZFO_ERR_INVALID_ARG;
-    return msync(map->ptr, map->size, MS_SYNC) == 0 ? ZFO_OK : errno_to_zfo(errno);
+    void* base = (uint8_t*)map->ptr - map->delta;
+    return msync(base, map->size + map->delta, MS_SYNC) == 0 ? ZFO_OK : errno_to_zfo(errno);
+}
+
+int zfo_mmap_advise(zfo_mmap_t* map, zfo_mmap_advice_t advice, size_t offset, size_t length) {
+    if (!map || offset > map->size) return ZFO_ERR_INVALID_ARG;
+    if (length == 0 || length > map->size - offset) length = map->size - offset;
+    if (length == 0) return ZFO_OK;
+
+    int madv;
+    switch (advice) {
+        case ZFO_MADV_NORMAL:     madv = MADV_NORMAL; break;
+        case ZFO_MADV_SEQUENTIAL: madv = MADV_SEQUENTIAL; break;
+        case ZFO_MADV_RANDOM:     madv = MADV_RANDOM; break;
+        case ZFO_MADV_WILLNEED:   madv = MADV_WILLNEED; break;
+        case ZFO_MADV_DONTNEED:   madv = MADV_DONTNEED; break;
+        default: return ZFO_ERR_INVALID_ARG;
+    }
+
+    /* madvise wants a page-aligned start; widen the range down to it */
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)map->ptr + offset;
+    uintptr_t aligned = start & ~(page - 1);
+
+    if (madvise((void*)aligned, length + (start - aligned), madv) != 0) {
+        return errno_to_zfo(errno);
+    }
+    return ZFO_OK;
+}
+
+int zfo_mmap_lock(zfo_mmap_t* map, bool lock) {
+    if (!map) return ZFO_ERR_INVALID_ARG;
+    int rc = lock ? mlock(map->ptr, map->size) : munlock(map->ptr, map->size);
+    return rc == 0 ? ZFO_OK : errno_to_zfo(errno);
+}
+
+int zfo_mmap_read_file(const char* path, zfo_mmap_t** out_map) {
+    if (!path || !out_map) return ZFO_ERR_INVALID_ARG;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return errno_to_zfo(errno);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int err = errno;
+        close(fd);
+        return errno_to_zfo(err);
+    }
+    if (!S_ISREG(st.st_mode)) {
+        close(fd);
+        return ZFO_ERR_IS_DIR;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return ZFO_ERR_INVALID_ARG;
+    }
+
+    zfo_mmap_t* map = calloc(1, sizeof(zfo_mmap_t));
+    if (!map) {
+        close(fd);
+        return ZFO_ERR_NO_MEMORY;
+    }
+
+    size_t length = (size_t)st.st_size;
+    void* ptr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    int err = errno;
+    close(fd);  /* The mapping keeps the file referenced */
+
+    if (ptr == MAP_FAILED) {
+        free(map);
+        return errno_to_zfo(err);
+    }
+
+    map->ptr = ptr;
+    map->size = length;
+    map->fd = -1;
+    map->owns_fd = false;
+
+    *out_map = map;
+    return ZFO_OK;
 }
 
 int zfo_mmap_close(zfo_mmap_t* map) {
     if (!map) return ZFO_ERR_INVALID_ARG;
 
     int ret = ZFO_OK;
-    if (munmap(map->ptr, map->size) != 0) {
+    if (munmap((uint8_t*)map->ptr - map->delta, map->size + map->delta) != 0) {
         ret = errno_to_zfo(errno);
     }
 
@@ -1238,6 +1975,24 @@ int zfo_mmap_close(zfo_mmap_t* map) {
 
 #ifdef __linux__
 
+/*
+ * Watches live in a DAGGER table keyed by wd (the key borrows the
+ * entry's own wd field) and their paths are interned in a Tablet, so
+ * a directory that comes and goes reuses one string. Entries found by
+ * a recursive scan are not roots: they are pruned when their directory
+ * disappears or when an overflow rescan no longer finds them.
+ */
+typedef struct {
+    int wd;
+    const Weave* path;          /* Interned */
+    int events;                 /* ZFO_EVENT_* requested */
+    bool recursive;
+    bool root;                  /* Added by the caller */
+    uint32_t gen;               /* Rescan generation that last saw it */
+} watch_entry_t;
+
+#define WATCH_INITIAL_CAPACITY 64
+
 zfo_watch_t* zfo_watch_create(void) {
     int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
     if (fd < 0) return NULL;
@@ -1248,14 +2003,22 @@ zfo_watch_t* zfo_watch_create(void) {
         return NULL;
     }
 
+    watch->by_wd = dagger_create(WATCH_INITIAL_CAPACITY, NULL);
+    watch->paths = tablet_create();
+    if (!watch->by_wd || !watch->paths) {
+        if (watch->by_wd) dagger_destroy(watch->by_wd);
+        tablet_destroy(watch->paths);
+        close(fd);
+        free(watch);
+        return NULL;
+    }
+
     watch->inotify_fd = fd;
+    pthread_mutex_init(&watch->lock, NULL);
     return watch;
 }
 
-int zfo_watch_add(zfo_watch_t* watch, const char* path, int events, bool recursive) {
-    if (!watch || !path) return ZFO_ERR_INVALID_ARG;
-    if (watch->watch_count >= 256) return ZFO_ERR_TOO_MANY_OPEN;
-
+static uint32_t watch_mask(int events, bool recursive) {
     uint32_t mask = 0;
     if (events & ZFO_EVENT_CREATE)    mask |= IN_CREATE;
     if (events & ZFO_EVENT_DELETE)    mask |= IN_DELETE | IN_DELETE_SELF;
@@ -1267,47 +2030,302 @@ int zfo_watch_add(zfo_watch_t* watch, const char* path, int events, bool recursi
     if (events & ZFO_EVENT_MOVE_FROM) mask |= IN_MOVED_FROM;
     if (events & ZFO_EVENT_MOVE_TO)   mask |= IN_MOVED_TO;
 
-    int wd = inotify_add_watch(watch->inotify_fd, path, mask);
+    /* New subdirectories must be seen to be watched */
+    if (recursive) mask |= IN_CREATE | IN_MOVED_TO;
+    return mask;
+}
+
+static bool watch_wants(int events, zfo_watch_event_t ev) {
+    if (ev == ZFO_EVENT_OVERFLOW) return true;
+    if (ev == ZFO_EVENT_MOVE_FROM || ev == ZFO_EVENT_MOVE_TO) {
+        return (events & (ZFO_EVENT_RENAME | ev)) != 0;
+    }
+    return (events & ev) != 0;
+}
+
+/* Caller holds watch->lock */
+static watch_entry_t* watch_lookup(zfo_watch_t* watch, int wd) {
+    void* value = NULL;
+    if (dagger_get(watch->by_wd, &wd, sizeof(int), &value) != DAGGER_OK) return NULL;
+    return value;
+}
+
+/* Caller holds watch->lock */
+static void watch_forget(zfo_watch_t* watch, watch_entry_t* entry, bool rm) {
+    if (rm) inotify_rm_watch(watch->inotify_fd, entry->wd);
+    dagger_remove(watch->by_wd, &entry->wd, sizeof(int));
+    free(entry);
+}
+
+/* Caller holds watch->lock */
+static int watch_register(zfo_watch_t* watch, const char* path, int events,
+                          bool recursive, bool root) {
+    int wd = inotify_add_watch(watch->inotify_fd, path, watch_mask(events, recursive));
     if (wd < 0) return errno_to_zfo(errno);
 
-    int idx = watch->watch_count++;
-    watch->watches[idx].wd = wd;
-    strncpy(watch->watches[idx].path, path, PATH_MAX - 1);
-    watch->watches[idx].events = events;
-    watch->watches[idx].recursive = recursive;
-
-    /* Add subdirectories if recursive */
-    if (recursive) {
-        DIR* dir = opendir(path);
-        if (dir) {
-            struct dirent* entry;
-            while ((entry = readdir(dir)) != NULL) {
-                if (entry->d_name[0] == '.') continue;
-                if (entry->d_type != DT_DIR) continue;
-
-                char subpath[PATH_MAX];
-                snprintf(subpath, sizeof(subpath), "%s/%s", path, entry->d_name);
-                zfo_watch_add(watch, subpath, events, true);
-            }
-            closedir(dir);
+    /* The same inode yields the same wd: refresh the existing entry */
+    watch_entry_t* entry = watch_lookup(watch, wd);
+    if (!entry) {
+        entry = calloc(1, sizeof(watch_entry_t));
+        if (!entry) {
+            inotify_rm_watch(watch->inotify_fd, wd);
+            return ZFO_ERR_NO_MEMORY;
         }
+        entry->wd = wd;
+        if (dagger_set(watch->by_wd, &entry->wd, sizeof(int), entry, 1) != DAGGER_OK) {
+            free(entry);
+            inotify_rm_watch(watch->inotify_fd, wd);
+            return ZFO_ERR_NO_MEMORY;
+        }
+    }
+
+    const Weave* interned = tablet_intern(watch->paths, path);
+    if (!interned) {
+        watch_forget(watch, entry, true);
+        return ZFO_ERR_NO_MEMORY;
     }
 
+    entry->path = interned;
+    entry->events = events;
+    entry->recursive = recursive;
+    entry->root = entry->root || root;
+    entry->gen = watch->gen;
     return wd;
 }
 
+typedef struct {
+    zfo_watch_t* watch;
+    int events;
+    zfo_watch_callback_t emit;  /* Report entries found as CREATE (NULL = silent) */
+    void* userdata;
+    zfo_watch_data_t* data;     /* Scratch for emitted events */
+    int count;
+} watch_scan_t;
+
+/* Directory waiting to be scanned; paths live on the heap, not the stack */
+typedef struct watch_scan_dir {
+    struct watch_scan_dir* next;
+    size_t len;
+    char path[];
+} watch_scan_dir_t;
+
+/* path, or path/name when name is given */
+static watch_scan_dir_t* watch_scan_dir_new(const char* path, size_t path_len,
+                                            const char* name, size_t name_len) {
+    size_t len = name ? path_len + 1 + name_len : path_len;
+    watch_scan_dir_t* dir = malloc(sizeof(watch_scan_dir_t) + len + 1);
+    if (!dir) return NULL;
+    dir->next = NULL;
+    dir->len = len;
+    memcpy(dir->path, path, path_len);
+    if (name) {
+        dir->path[path_len] = '/';
+        memcpy(dir->path + path_len + 1, name, name_len);
+    }
+    dir->path[len] = 0;
+    return dir;
+}
+
+/* Scan one directory, queueing each newly registered subdirectory */
+static void watch_scan_dir(watch_scan_t* ctx, const watch_scan_dir_t* dir,
+                           watch_scan_dir_t*** tail) {
+    int fd = open(dir->path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return;
+
+    zfo_dirscan_t scan;
+    if (zfo_dirscan_open(&scan, fd) != ZFO_OK) {
+        close(fd);
+        return;
+    }
+
+    const char* name;
+    unsigned char d_type;
+    uint64_t inode;
+
+    while (zfo_dirscan_next(&scan, &name, &d_type, &inode)) {
+        bool is_dir = d_type == DT_DIR;
+        if (d_type == DT_UNKNOWN) {
+            struct stat st;
+            is_dir = fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode);
+        }
+
+        size_t name_len = strlen(name);
+        size_t len = dir->len + 1 + name_len;
+        if (len >= PATH_MAX) continue;
+
+        watch_scan_dir_t* sub = watch_scan_dir_new(dir->path, dir->len, name, name_len);
+        if (!sub) continue;
+
+        if (ctx->emit && watch_wants(ctx->events, ZFO_EVENT_CREATE)) {
+            zfo_watch_data_t* data = ctx->data;
+            memset(data, 0, sizeof(*data));
+            data->event = ZFO_EVENT_CREATE;
+            memcpy(data->path, sub->path, len + 1);
+            data->is_dir = is_dir;
+            ctx->emit(data, ctx->userdata);
+            ctx->count++;
+        }
+
+        int wd = -1;
+        if (is_dir && name[0] != '.') {
+            pthread_mutex_lock(&ctx->watch->lock);
+            wd = watch_register(ctx->watch, sub->path, ctx->events, true, false);
+            pthread_mutex_unlock(&ctx->watch->lock);
+        }
+        if (wd < 0) {
+            free(sub);
+            continue;
+        }
+        **tail = sub;
+        *tail = &sub->next;
+    }
+
+    zfo_dirscan_close(&scan);
+    close(fd);
+}
+
+/*
+ * Register every non-hidden subdirectory below path (no depth cap).
+ * Breadth-first from a heap queue, so deep trees cost neither stack
+ * nor more than one open directory at a time.
+ */
+static void watch_scan(watch_scan_t* ctx, const char* path) {
+    watch_scan_dir_t* head = watch_scan_dir_new(path, strlen(path), NULL, 0);
+    watch_scan_dir_t** tail = &head;
+
+    while (head) {
+        watch_scan_dir_t* dir = head;
+        head = dir->next;
+        if (!head) tail = &head;
+        watch_scan_dir(ctx, dir, &tail);
+        free(dir);
+    }
+}
+
+int zfo_watch_add(zfo_watch_t* watch, const char* path, int events, bool recursive) {
+    if (!watch || !path) return ZFO_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&watch->lock);
+    int wd = watch_register(watch, path, events, recursive, true);
+    pthread_mutex_unlock(&watch->lock);
+
+    if (wd >= 0 && recursive) {
+        watch_scan_t ctx = { watch, events, NULL, NULL, NULL, 0 };
+        watch_scan(&ctx, path);
+    }
+    return wd;
+}
+
+typedef struct {
+    zfo_watch_t* watch;
+    const char* prefix;         /* NULL = match by generation */
+    size_t prefix_len;
+    watch_entry_t** found;
+    size_t count;
+    size_t cap;
+} watch_collect_t;
+
+static int collect_stale(const void* key, uint32_t key_len, void* value, void* ctx) {
+    (void)key;
+    (void)key_len;
+    watch_collect_t* c = ctx;
+    watch_entry_t* entry = value;
+    if (entry->root) return 0;
+
+    if (c->prefix) {
+        const char* p = weave_cstr(entry->path);
+        if (strncmp(p, c->prefix, c->prefix_len) != 0 || p[c->prefix_len] != '/') return 0;
+    } else if (entry->gen == c->watch->gen) {
+        return 0;
+    }
+
+    if (c->count == c->cap) {
+        size_t ncap = c->cap ? c->cap * 2 : 64;
+        watch_entry_t** nfound = realloc(c->found, ncap * sizeof(watch_entry_t*));
+        if (!nfound) return 1;
+        c->found = nfound;
+        c->cap = ncap;
+    }
+    c->found[c->count++] = entry;
+    return 0;
+}
+
+/* Caller holds watch->lock */
+static void watch_prune(zfo_watch_t* watch, const char* prefix) {
+    watch_collect_t c = { watch, prefix, prefix ? strlen(prefix) : 0, NULL, 0, 0 };
+    dagger_foreach(watch->by_wd, collect_stale, &c);
+    for (size_t i = 0; i < c.count; i++) watch_forget(watch, c.found[i], true);
+    free(c.found);
+}
+
 int zfo_watch_remove(zfo_watch_t* watch, int wd) {
     if (!watch) return ZFO_ERR_INVALID_ARG;
-    return inotify_rm_watch(watch->inotify_fd, wd) == 0 ? ZFO_OK : errno_to_zfo(errno);
+
+    pthread_mutex_lock(&watch->lock);
+    watch_entry_t* entry = watch_lookup(watch, wd);
+    if (entry) {
+        if (entry->recursive) watch_prune(watch, weave_cstr(entry->path));
+        dagger_remove(watch->by_wd, &entry->wd, sizeof(int));
+        free(entry);
+    }
+    int ret = inotify_rm_watch(watch->inotify_fd, wd) == 0 ? ZFO_OK : errno_to_zfo(errno);
+    pthread_mutex_unlock(&watch->lock);
+    return ret;
 }
 
-static const char* find_watch_path(zfo_watch_t* watch, int wd) {
-    for (int i = 0; i < watch->watch_count; i++) {
-        if (watch->watches[i].wd == wd) {
-            return watch->watches[i].path;
-        }
+typedef struct {
+    const Weave* path;
+    int events;
+} watch_root_t;
+
+typedef struct {
+    watch_root_t* roots;
+    size_t count;
+    size_t cap;
+} watch_roots_t;
+
+static int collect_roots(const void* key, uint32_t key_len, void* value, void* ctx) {
+    (void)key;
+    (void)key_len;
+    watch_roots_t* r = ctx;
+    watch_entry_t* entry = value;
+    if (!entry->root || !entry->recursive) return 0;
+
+    if (r->count == r->cap) {
+        size_t ncap = r->cap ? r->cap * 2 : 8;
+        watch_root_t* nroots = realloc(r->roots, ncap * sizeof(watch_root_t));
+        if (!nroots) return 1;
+        r->roots = nroots;
+        r->cap = ncap;
+    }
+    r->roots[r->count].path = entry->path;
+    r->roots[r->count].events = entry->events;
+    r->count++;
+    return 0;
+}
+
+/*
+ * After IN_Q_OVERFLOW the event stream can't be trusted: re-walk every
+ * recursive root so directories created meanwhile get watches, then
+ * drop watches whose directories were not found again.
+ */
+static void watch_rescan(zfo_watch_t* watch) {
+    watch_roots_t r = { NULL, 0, 0 };
+
+    pthread_mutex_lock(&watch->lock);
+    watch->gen++;
+    dagger_foreach(watch->by_wd, collect_roots, &r);
+    pthread_mutex_unlock(&watch->lock);
+
+    for (size_t i = 0; i < r.count; i++) {
+        watch_scan_t ctx = { watch, r.roots[i].events, NULL, NULL, NULL, 0 };
+        watch_scan(&ctx, weave_cstr(r.roots[i].path));
     }
-    return "";
+    free(r.roots);
+
+    pthread_mutex_lock(&watch->lock);
+    watch_prune(watch, NULL);
+    pthread_mutex_unlock(&watch->lock);
 }
 
 int zfo_watch_poll(zfo_watch_t* watch, zfo_watch_callback_t callback, void* userdata) {
@@ -1322,10 +2340,34 @@ int zfo_watch_poll(zfo_watch_t* watch, zfo_watch_callback_t callback, void* user
     const char* ptr = buf;
     while (ptr < buf + len) {
         const struct inotify_event* event = (const struct inotify_event*)ptr;
+        ptr += sizeof(struct inotify_event) + event->len;
 
         zfo_watch_data_t data = {0};
-        const char* base_path = find_watch_path(watch, event->wd);
 
+        if (event->mask & IN_Q_OVERFLOW) {
+            data.event = ZFO_EVENT_OVERFLOW;
+            callback(&data, userdata);
+            count++;
+            watch_rescan(watch);
+            continue;
+        }
+
+        pthread_mutex_lock(&watch->lock);
+        watch_entry_t* entry = watch_lookup(watch, event->wd);
+        if (!entry) {
+            /* Removed while the event was queued */
+            pthread_mutex_unlock(&watch->lock);
+            continue;
+        }
+
+        if (event->mask & IN_IGNORED) {
+            /* Directory gone (or watch removed): the kernel dropped the wd */
+            watch_forget(watch, entry, false);
+            pthread_mutex_unlock(&watch->lock);
+            continue;
+        }
+
+        const char* base_path = weave_cstr(entry->path);
         if (event->len > 0) {
             snprintf(data.path, sizeof(data.path), "%s/%s", base_path, event->name);
         } else {
@@ -1343,12 +2385,39 @@ int zfo_watch_poll(zfo_watch_t* watch, zfo_watch_callback_t callback, void* user
         else if (event->mask & IN_ATTRIB) data.event = ZFO_EVENT_ATTRIB;
         else if (event->mask & IN_OPEN)   data.event = ZFO_EVENT_OPEN;
         else if (event->mask & IN_CLOSE)  data.event = ZFO_EVENT_CLOSE;
-        else if (event->mask & IN_Q_OVERFLOW) data.event = ZFO_EVENT_OVERFLOW;
+        else if ((event->mask & IN_DELETE_SELF) && entry->root) {
+            /* A subdirectory's deletion is already reported by its parent */
+            data.event = ZFO_EVENT_DELETE;
+            data.is_dir = true;
+        }
 
-        callback(&data, userdata);
-        count++;
+        /* New directory under a recursive watch: watch it and what it holds */
+        bool scan = entry->recursive && (event->mask & IN_ISDIR) &&
+                    (event->mask & (IN_CREATE | IN_MOVED_TO)) &&
+                    event->len > 0 && event->name[0] != '.';
+        int events = entry->events;
+        bool deliver = data.event != 0 && watch_wants(events, data.event);
+        if (scan && watch_register(watch, data.path, events, true, false) < 0) scan = false;
+        pthread_mutex_unlock(&watch->lock);
+
+        if (deliver) {
+            callback(&data, userdata);
+            count++;
+        }
 
-        ptr += sizeof(struct inotify_event) + event->len;
+        if (scan) {
+            /*
+             * Entries created before the watch existed produced no events:
+             * report them as creations. A moved-in directory only needs its
+             * watches (re)registered under the new path.
+             */
+            char dir[PATH_MAX];
+            snprintf(dir, sizeof(dir), "%s", data.path);
+            bool created = (event->mask & IN_CREATE) != 0;
+            watch_scan_t ctx = { watch, events, created ? callback : NULL, userdata, &data, 0 };
+            watch_scan(&ctx, dir);
+            count += ctx.count;
+        }
     }
 
     return count;
@@ -1370,14 +2439,23 @@ int zfo_watch_fd(zfo_watch_t* watch) {
     return watch ? watch->inotify_fd : -1;
 }
 
+static int free_entry(const void* key, uint32_t key_len, void* value, void* ctx) {
+    (void)key;
+    (void)key_len;
+    (void)ctx;
+    free(value);
+    return 0;
+}
+
 void zfo_watch_destroy(zfo_watch_t* watch) {
     if (!watch) return;
 
-    for (int i = 0; i < watch->watch_count; i++) {
-        inotify_rm_watch(watch->inotify_fd, watch->watches[i].wd);
-    }
-
+    /* Closing the inotify descriptor drops every watch at once */
     close(watch->inotify_fd);
+    dagger_foreach(watch->by_wd, free_entry, NULL);
+    dagger_destroy(watch->by_wd);
+    tablet_destroy(watch->paths);
+    pthread_mutex_destroy(&watch->lock);
     free(watch);
 }
 
@@ -1398,7 +2476,9 @@ int zfo_lock(zfo_file_t* file, zfo_off_t offset, zfo_off_t length, int flags) {
     };
 
     int cmd = (flags & ZFO_LOCK_NONBLOCK) ? F_SETLK : F_SETLKW;
-    return fcntl(file->fd, cmd, &fl) == 0 ? ZFO_OK : errno_to_zfo(errno);
+    if (fcntl(file->fd, cmd, &fl) == 0) return ZFO_OK;
+    if ((flags & ZFO_LOCK_NONBLOCK) && (errno == EAGAIN || errno == EACCES)) return ZFO_ERR_BUSY;
+    return errno_to_zfo(errno);
 }
 
 int zfo_unlock(zfo_file_t* file, zfo_off_t offset, zfo_off_t length) {
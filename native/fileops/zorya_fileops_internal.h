@@ -0,0 +1,206 @@
+/**
+ * @file zorya_fileops_internal.h
+ * @brief Zorya FileOps - Internal helpers shared between translation units
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   Not part of the public API. Declares the work-stealing thread pool,
+ *   the raw directory scanner and the descriptor-level copy routine
+ *   used by the parallel tree operations.
+ */
+
+#ifndef ZORYA_FILEOPS_INTERNAL_H
+#define ZORYA_FILEOPS_INTERNAL_H
+
+#include "zorya_fileops.h"
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+/* ============================================================
+ * Error Mapping
+ * ============================================================ */
+
+/**
+ * Map a POSIX errno value to a ZFO_ERR_* code
+ */
+int zfo_error_from_errno(int err);
+
+/* ============================================================
+ * Descriptor-Relative Stat
+ * ============================================================ */
+
+/**
+ * Stat an entry relative to a directory descriptor.
+ * Uses statx (with birth time) where available, fstatat otherwise.
+ */
+int zfo_stat_at(int dirfd, const char* name, bool follow, zfo_stat_t* zst);
+
+/**
+ * Map a DT_* directory entry type to zfo_file_type_t
+ */
+zfo_file_type_t zfo_type_from_dtype(unsigned char d_type);
+
+/**
+ * Map st_mode to zfo_file_type_t
+ */
+zfo_file_type_t zfo_type_from_mode(mode_t mode);
+
+/* ============================================================
+ * Descriptor-Level Copy
+ * ============================================================ */
+
+/**
+ * Copy file contents between open descriptors (dst must be empty)
+ * Uses FICLONE, copy_file_range, sendfile, then a buffered loop.
+ */
+int zfo_copy_fd_data(int src_fd, int dst_fd, const struct stat* st, size_t bufsize);
+
+/* ============================================================
+ * Directory Scanner
+ * ============================================================ */
+
+/**
+ * Streaming reader over an open directory descriptor.
+ * On Linux entries come straight from getdents64 into a private
+ * buffer; elsewhere it wraps fdopendir() on a dup of the fd.
+ * The descriptor itself is never closed by the scanner.
+ */
+typedef struct {
+    int fd;
+    char* buf;
+    size_t len;
+    size_t pos;
+    void* dir;              /* DIR* on non-Linux platforms */
+    int error;              /* ZFO_ERR_* once a read fails */
+} zfo_dirscan_t;
+
+int zfo_dirscan_open(zfo_dirscan_t* scan, int fd);
+
+/**
+ * Next entry ("." and ".." are skipped)
+ * @param d_type DT_* value, DT_UNKNOWN when the filesystem doesn't say
+ * @return true while entries remain; false at the end or on a read
+ *         error, which zfo_dirscan_error tells apart
+ */
+bool zfo_dirscan_next(zfo_dirscan_t* scan, const char** name,
+                      unsigned char* d_type, uint64_t* inode);
+
+/**
+ * ZFO_OK, or the error that cut the listing short
+ */
+int zfo_dirscan_error(const zfo_dirscan_t* scan);
+
+void zfo_dirscan_close(zfo_dirscan_t* scan);
+
+/* ============================================================
+ * Work-Stealing Thread Pool
+ * ============================================================ */
+
+typedef struct zfo_pool zfo_pool_t;
+
+/**
+ * Task entry point
+ * @param worker Index of the executing worker (pass to zfo_pool_submit)
+ */
+typedef void (*zfo_task_fn)(zfo_pool_t* pool, int worker, void* arg);
+
+/**
+ * Periodic hook run on the waiting thread
+ * @return false to request cancellation
+ */
+typedef bool (*zfo_pool_tick_fn)(void* ctx);
+
+/**
+ * Create a pool
+ * @param threads Worker count (<= 0 = online CPUs)
+ */
+zfo_pool_t* zfo_pool_create(int threads);
+
+/**
+ * Queue a task. Workers push onto their own deque (LIFO, depth-first);
+ * idle workers steal from the opposite end of other deques.
+ * @param worker Calling worker index, or -1 from outside the pool
+ */
+int zfo_pool_submit(zfo_pool_t* pool, int worker, zfo_task_fn fn, void* arg);
+
+/**
+ * Block until every submitted task (and their children) has finished
+ * @param tick_ms Interval for tick (0 = no ticks)
+ */
+void zfo_pool_wait(zfo_pool_t* pool, uint32_t tick_ms, zfo_pool_tick_fn tick, void* ctx);
+
+/**
+ * Wake the waiting thread early so it runs its tick immediately
+ */
+void zfo_pool_notify(zfo_pool_t* pool);
+
+/**
+ * Cooperative cancellation flag checked by tasks
+ */
+void zfo_pool_cancel(zfo_pool_t* pool);
+bool zfo_pool_cancelled(const zfo_pool_t* pool);
+
+int zfo_pool_size(const zfo_pool_t* pool);
+
+void zfo_pool_destroy(zfo_pool_t* pool);
+
+/* ============================================================
+ * Content Hashing
+ * ============================================================ */
+
+/**
+ * nxh64-based hash of a whole file, read through a mapping in chunks
+ * whose pages are dropped once hashed. Fails if the size changed.
+ */
+int zfo_hash_fd(int fd, uint64_t size, uint64_t* out);
+
+/* ============================================================
+ * Walks on a Caller-Owned Pool
+ * ============================================================ */
+
+/**
+ * zfo_walk_parallel on an existing pool (NULL = create one). Visit
+ * callbacks may queue their own tasks with entry->worker; the call
+ * returns once those have finished too.
+ */
+int zfo_walk_run(zfo_pool_t* pool, const char* root, const zfo_walk_options_t* opts,
+                 zfo_tree_result_t* result);
+
+/**
+ * zfo_glob_walk on an existing pool. A NULL set matches everything,
+ * leaving only the ignore rules to filter.
+ */
+int zfo_glob_walk_run(zfo_pool_t* pool, const char* root, const zfo_glob_set_t* set,
+                      const zfo_glob_options_t* opts, zfo_tree_result_t* result);
+
+/* ============================================================
+ * Portable stat Timestamps
+ * ============================================================ */
+
+#ifdef __APPLE__
+    #define ZFO_ST_ATIM(st) ((st)->st_atimespec)
+    #define ZFO_ST_MTIM(st) ((st)->st_mtimespec)
+    #define ZFO_ST_CTIM(st) ((st)->st_ctimespec)
+#else
+    #define ZFO_ST_ATIM(st) ((st)->st_atim)
+    #define ZFO_ST_MTIM(st) ((st)->st_mtim)
+    #define ZFO_ST_CTIM(st) ((st)->st_ctim)
+#endif
+
+/* ============================================================
+ * Atomics (GCC/Clang builtins, usable from C99)
+ * ============================================================ */
+
+#define ZFO_ATOMIC_ADD(p, v)  __atomic_add_fetch((p), (v), __ATOMIC_SEQ_CST)
+#define ZFO_ATOMIC_SUB(p, v)  __atomic_sub_fetch((p), (v), __ATOMIC_SEQ_CST)
+#define ZFO_ATOMIC_LOAD(p)    __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define ZFO_ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+
+#endif /* ZORYA_FILEOPS_INTERNAL_H */
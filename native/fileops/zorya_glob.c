@@ -0,0 +1,844 @@
+/**
+ * @file zorya_glob.c
+ * @brief Zorya FileOps - Glob matcher and ignore-aware parallel glob
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   Patterns are brace-expanded once and split into segments that are
+ *   literal, wildcard (* ? [...]) or globstar (**). Matching works on
+ *   path components without allocating. The same segment test tells
+ *   the walker whether any pattern can still match below a directory,
+ *   so trees that cannot contain results are never opened.
+ *
+ *   Ignore files use .gitignore rules: the last matching rule wins,
+ *   '!' re-includes, a trailing '/' matches directories only, and a
+ *   pattern without an inner '/' matches the basename at any depth.
+ *   Each directory's rules are loaded when the walker reaches it, so
+ *   they are in place before any of its entries are visited.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+#include "dagger.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <limits.h>
+
+#define GLOB_MAX_EXPANSIONS  4096
+#define GLOB_STACK_COMPS     64
+#define GLOB_MAX_IGNORE_FILE (1024 * 1024)
+
+/* ============================================================
+ * Internal Structures
+ * ============================================================ */
+
+typedef enum {
+    SEG_LITERAL,
+    SEG_WILD,
+    SEG_GLOBSTAR
+} seg_kind_t;
+
+typedef struct {
+    seg_kind_t kind;
+    char* text;
+    size_t len;
+} glob_seg_t;
+
+typedef struct {
+    glob_seg_t* segs;
+    size_t nsegs;
+    bool negate;
+    bool dir_only;
+    bool anchored;              /* Ignore rules: match from the base, not the basename */
+} glob_pat_t;
+
+struct zfo_glob_set {
+    glob_pat_t* pats;
+    size_t count;
+    uint32_t flags;
+};
+
+typedef struct {
+    const char* s;
+    size_t len;
+} glob_comp_t;
+
+/* ============================================================
+ * Segment Matching
+ * ============================================================ */
+
+static inline bool char_eq(char a, char b, bool nocase) {
+    return nocase ? tolower((unsigned char)a) == tolower((unsigned char)b) : a == b;
+}
+
+/* [...] class at p[0]; returns bytes consumed on a match, 0 otherwise */
+static size_t class_match(const char* p, size_t pn, char ch, bool nocase) {
+    size_t i = 1;
+    bool negate = false;
+    if (i < pn && (p[i] == '!' || p[i] == '^')) {
+        negate = true;
+        i++;
+    }
+
+    unsigned char c = (unsigned char)(nocase ? tolower((unsigned char)ch) : ch);
+    bool hit = false;
+    bool first = true;
+
+    while (i < pn && (p[i] != ']' || first)) {
+        first = false;
+        unsigned char lo = (unsigned char)p[i];
+        if (lo == '\\' && i + 1 < pn) lo = (unsigned char)p[++i];
+        i++;
+
+        unsigned char hi = lo;
+        if (i + 1 < pn && p[i] == '-' && p[i + 1] != ']') {
+            hi = (unsigned char)p[i + 1];
+            if (hi == '\\' && i + 2 < pn) hi = (unsigned char)p[++i + 1];
+            i += 2;
+        }
+
+        if (nocase) {
+            lo = (unsigned char)tolower(lo);
+            hi = (unsigned char)tolower(hi);
+        }
+        if (c >= lo && c <= hi) hit = true;
+    }
+
+    /* Unterminated: '[' is an ordinary character */
+    if (i >= pn) return ch == '[' ? 1 : 0;
+    return hit != negate ? i + 1 : 0;
+}
+
+/* One token that isn't '*'; returns bytes consumed, 0 on mismatch */
+static size_t token_match(const char* p, size_t pn, char ch, bool nocase) {
+    switch (p[0]) {
+        case '?':
+            return 1;
+        case '[':
+            return class_match(p, pn, ch, nocase);
+        case '\\':
+            if (pn > 1) return char_eq(p[1], ch, nocase) ? 2 : 0;
+            return ch == '\\' ? 1 : 0;
+        default:
+            return char_eq(p[0], ch, nocase) ? 1 : 0;
+    }
+}
+
+static bool wild_match(const char* p, size_t pn, const char* s, size_t sn, bool nocase) {
+    size_t pi = 0, si = 0;
+    size_t star_p = SIZE_MAX, star_s = 0;
+
+    while (si < sn) {
+        if (pi < pn && p[pi] == '*') {
+            star_p = ++pi;
+            star_s = si;
+            continue;
+        }
+        size_t used = pi < pn ? token_match(p + pi, pn - pi, s[si], nocase) : 0;
+        if (used > 0) {
+            pi += used;
+            si++;
+            continue;
+        }
+        if (star_p == SIZE_MAX) return false;
+        pi = star_p;
+        si = ++star_s;
+    }
+
+    while (pi < pn && p[pi] == '*') pi++;
+    return pi == pn;
+}
+
+static inline bool dot_ok(const glob_comp_t* comp, uint32_t flags) {
+    return (flags & ZFO_GLOB_DOT) || comp->len == 0 || comp->s[0] != '.';
+}
+
+static bool seg_match(const glob_seg_t* seg, const glob_comp_t* comp, uint32_t flags) {
+    bool nocase = (flags & ZFO_GLOB_NOCASE) != 0;
+
+    /* A leading dot must be matched explicitly */
+    if (!dot_ok(comp, flags) && seg->text[0] != '.') return false;
+
+    if (seg->kind == SEG_LITERAL) {
+        if (seg->len != comp->len) return false;
+        return nocase ? strncasecmp(seg->text, comp->s, comp->len) == 0
+                      : memcmp(seg->text, comp->s, comp->len) == 0;
+    }
+    return wild_match(seg->text, seg->len, comp->s, comp->len, nocase);
+}
+
+/* ============================================================
+ * Path Matching
+ * ============================================================ */
+
+/* Full match of segs[si, nsegs) against comps[ci, n) */
+static bool match_from(const glob_pat_t* pat, size_t si, size_t nsegs,
+                       const glob_comp_t* comps, size_t ci, size_t n, uint32_t flags) {
+    while (si < nsegs) {
+        const glob_seg_t* seg = &pat->segs[si];
+
+        if (seg->kind == SEG_GLOBSTAR) {
+            if (si + 1 == nsegs) {
+                for (size_t k = ci; k < n; k++) {
+                    if (!dot_ok(&comps[k], flags)) return false;
+                }
+                return true;
+            }
+            for (size_t k = ci; k <= n; k++) {
+                if (match_from(pat, si + 1, nsegs, comps, k, n, flags)) return true;
+                if (k < n && !dot_ok(&comps[k], flags)) return false;
+            }
+            return false;
+        }
+
+        if (ci >= n || !seg_match(seg, &comps[ci], flags)) return false;
+        si++;
+        ci++;
+    }
+    return ci == n;
+}
+
+/* Could something strictly below the directory comps[0, n) match? */
+static bool prefix_from(const glob_pat_t* pat, size_t si,
+                        const glob_comp_t* comps, size_t ci, size_t n, uint32_t flags) {
+    while (ci < n) {
+        if (si >= pat->nsegs) return false;
+        const glob_seg_t* seg = &pat->segs[si];
+
+        if (seg->kind == SEG_GLOBSTAR) {
+            for (size_t k = ci; k < n; k++) {
+                if (prefix_from(pat, si + 1, comps, k, n, flags)) return true;
+                if (!dot_ok(&comps[k], flags)) return false;
+            }
+            return true;
+        }
+
+        if (!seg_match(seg, &comps[ci], flags)) return false;
+        si++;
+        ci++;
+    }
+    return si < pat->nsegs;
+}
+
+/* Split "a/b/c" into components; *heap is set when comps had to grow */
+static size_t split_path(const char* path, glob_comp_t* stack, size_t stack_cap,
+                         glob_comp_t** out) {
+    glob_comp_t* comps = stack;
+    size_t cap = stack_cap, n = 0;
+    const char* p = path;
+
+    while (*p) {
+        while (*p == '/') p++;
+        if (!*p) break;
+        const char* start = p;
+        while (*p && *p != '/') p++;
+
+        if (n == cap) {
+            size_t ncap = cap * 2;
+            glob_comp_t* grown = malloc(ncap * sizeof(glob_comp_t));
+            if (!grown) break;
+            memcpy(grown, comps, n * sizeof(glob_comp_t));
+            if (comps != stack) free(comps);
+            comps = grown;
+            cap = ncap;
+        }
+        comps[n].s = start;
+        comps[n].len = (size_t)(p - start);
+        n++;
+    }
+
+    *out = comps;
+    return n;
+}
+
+static bool set_match_comps(const zfo_glob_set_t* set, const glob_comp_t* comps, size_t n,
+                            bool is_dir) {
+    bool matched = false;
+    for (size_t i = 0; i < set->count && !matched; i++) {
+        const glob_pat_t* pat = &set->pats[i];
+        if (pat->negate || (pat->dir_only && !is_dir)) continue;
+        matched = match_from(pat, 0, pat->nsegs, comps, 0, n, set->flags);
+    }
+    if (!matched) return false;
+
+    for (size_t i = 0; i < set->count; i++) {
+        const glob_pat_t* pat = &set->pats[i];
+        if (!pat->negate || (pat->dir_only && !is_dir)) continue;
+        if (match_from(pat, 0, pat->nsegs, comps, 0, n, set->flags)) return false;
+    }
+    return true;
+}
+
+static bool set_descend_comps(const zfo_glob_set_t* set, const glob_comp_t* comps, size_t n) {
+    /* A negated pattern ending in globstar excludes the whole subtree */
+    for (size_t i = 0; i < set->count; i++) {
+        const glob_pat_t* pat = &set->pats[i];
+        if (!pat->negate || pat->nsegs < 2) continue;
+        if (pat->segs[pat->nsegs - 1].kind != SEG_GLOBSTAR) continue;
+        if (match_from(pat, 0, pat->nsegs - 1, comps, 0, n, set->flags)) return false;
+    }
+
+    for (size_t i = 0; i < set->count; i++) {
+        const glob_pat_t* pat = &set->pats[i];
+        if (!pat->negate && prefix_from(pat, 0, comps, 0, n, set->flags)) return true;
+    }
+    return false;
+}
+
+/* ============================================================
+ * Compilation
+ * ============================================================ */
+
+typedef struct {
+    char** items;
+    size_t count;
+    size_t cap;
+} str_list_t;
+
+static int str_list_push(str_list_t* list, char* s) {
+    if (!s) return ZFO_ERR_NO_MEMORY;
+    if (list->count >= GLOB_MAX_EXPANSIONS) {
+        free(s);
+        return ZFO_ERR_INVALID_ARG;
+    }
+    if (list->count == list->cap) {
+        size_t ncap = list->cap ? list->cap * 2 : 8;
+        char** nitems = realloc(list->items, ncap * sizeof(char*));
+        if (!nitems) {
+            free(s);
+            return ZFO_ERR_NO_MEMORY;
+        }
+        list->items = nitems;
+        list->cap = ncap;
+    }
+    list->items[list->count++] = s;
+    return ZFO_OK;
+}
+
+static void str_list_free(str_list_t* list) {
+    for (size_t i = 0; i < list->count; i++) free(list->items[i]);
+    free(list->items);
+}
+
+/* "a{b,c{d,e}}f" -> abf acdf acef; braces without a top-level ',' stay literal */
+static int brace_expand(const char* pat, str_list_t* out) {
+    size_t len = strlen(pat);
+
+    for (size_t i = 0; i < len; i++) {
+        if (pat[i] == '\\') {
+            i++;
+            continue;
+        }
+        if (pat[i] != '{') continue;
+
+        int depth = 0;
+        size_t close = 0;
+        bool comma = false;
+        for (size_t j = i; j < len; j++) {
+            if (pat[j] == '\\') {
+                j++;
+            } else if (pat[j] == '{') {
+                depth++;
+            } else if (pat[j] == '}') {
+                if (--depth == 0) {
+                    close = j;
+                    break;
+                }
+            } else if (pat[j] == ',' && depth == 1) {
+                comma = true;
+            }
+        }
+        if (close == 0) return str_list_push(out, strdup(pat));
+        if (!comma) {
+            i = close;
+            continue;
+        }
+
+        /* Emit prefix + alternative + suffix for every alternative */
+        size_t start = i + 1;
+        depth = 0;
+        for (size_t j = start; j <= close; j++) {
+            if (pat[j] == '\\' && j < close) {
+                j++;
+                continue;
+            }
+            if (pat[j] == '{') depth++;
+            else if (pat[j] == '}' && depth > 0 && j < close) depth--;
+            else if ((pat[j] == ',' && depth == 0) || j == close) {
+                size_t alt_len = j - start;
+                size_t total = i + alt_len + (len - close - 1);
+                char* s = malloc(total + 1);
+                if (!s) return ZFO_ERR_NO_MEMORY;
+                memcpy(s, pat, i);
+                memcpy(s + i, pat + start, alt_len);
+                memcpy(s + i + alt_len, pat + close + 1, len - close - 1);
+                s[total] = 0;
+
+                int rc = brace_expand(s, out);
+                free(s);
+                if (rc != ZFO_OK) return rc;
+                start = j + 1;
+            }
+        }
+        return ZFO_OK;
+    }
+
+    return str_list_push(out, strdup(pat));
+}
+
+static void pat_free(glob_pat_t* pat) {
+    for (size_t i = 0; i < pat->nsegs; i++) free(pat->segs[i].text);
+    free(pat->segs);
+}
+
+static int pat_compile(const char* text, bool negate, glob_pat_t* pat) {
+    memset(pat, 0, sizeof(*pat));
+    pat->negate = negate;
+
+    while (text[0] == '.' && text[1] == '/') text += 2;
+    if (text[0] == '/') {
+        pat->anchored = true;
+        while (*text == '/') text++;
+    }
+
+    size_t len = strlen(text);
+    if (len > 0 && text[len - 1] == '/') {
+        pat->dir_only = true;
+        while (len > 0 && text[len - 1] == '/') len--;
+    }
+    if (len == 0) return ZFO_ERR_INVALID_ARG;
+    if (memchr(text, '/', len)) pat->anchored = true;
+
+    size_t cap = 1;
+    for (size_t i = 0; i < len; i++) {
+        if (text[i] == '/') cap++;
+    }
+    pat->segs = calloc(cap, sizeof(glob_seg_t));
+    if (!pat->segs) return ZFO_ERR_NO_MEMORY;
+
+    size_t i = 0;
+    while (i < len) {
+        size_t start = i;
+        while (i < len && text[i] != '/') i++;
+        size_t seg_len = i - start;
+        while (i < len && text[i] == '/') i++;
+        if (seg_len == 0) continue;
+
+        const char* s = text + start;
+        seg_kind_t kind = SEG_LITERAL;
+        if (seg_len == 2 && s[0] == '*' && s[1] == '*') {
+            kind = SEG_GLOBSTAR;
+            if (pat->nsegs > 0 && pat->segs[pat->nsegs - 1].kind == SEG_GLOBSTAR) continue;
+        } else {
+            for (size_t k = 0; k < seg_len; k++) {
+                if (strchr("*?[\\", s[k])) {
+                    kind = SEG_WILD;
+                    break;
+                }
+            }
+        }
+
+        glob_seg_t* seg = &pat->segs[pat->nsegs];
+        seg->text = strndup(s, seg_len);
+        if (!seg->text) {
+            pat_free(pat);
+            return ZFO_ERR_NO_MEMORY;
+        }
+        seg->len = seg_len;
+        seg->kind = kind;
+        pat->nsegs++;
+    }
+
+    return ZFO_OK;
+}
+
+static int set_add(zfo_glob_set_t* set, size_t* cap, const char* text, bool negate) {
+    if (set->count == *cap) {
+        size_t ncap = *cap ? *cap * 2 : 8;
+        glob_pat_t* npats = realloc(set->pats, ncap * sizeof(glob_pat_t));
+        if (!npats) return ZFO_ERR_NO_MEMORY;
+        set->pats = npats;
+        *cap = ncap;
+    }
+    int rc = pat_compile(text, negate, &set->pats[set->count]);
+    if (rc == ZFO_OK) set->count++;
+    return rc;
+}
+
+int zfo_glob_compile(const char* const* patterns, size_t count, uint32_t flags,
+                     zfo_glob_set_t** out) {
+    if (!patterns || !out) return ZFO_ERR_INVALID_ARG;
+    *out = NULL;
+
+    zfo_glob_set_t* set = calloc(1, sizeof(zfo_glob_set_t));
+    if (!set) return ZFO_ERR_NO_MEMORY;
+    set->flags = flags;
+
+    size_t cap = 0;
+    int rc = ZFO_OK;
+    for (size_t i = 0; i < count && rc == ZFO_OK; i++) {
+        const char* p = patterns[i];
+        if (!p) continue;
+        bool negate = p[0] == '!';
+        if (negate) p++;
+
+        str_list_t expanded = {0};
+        rc = brace_expand(p, &expanded);
+        for (size_t j = 0; j < expanded.count && rc == ZFO_OK; j++) {
+            rc = set_add(set, &cap, expanded.items[j], negate);
+        }
+        str_list_free(&expanded);
+    }
+
+    if (rc != ZFO_OK) {
+        zfo_glob_set_free(set);
+        return rc;
+    }
+    *out = set;
+    return ZFO_OK;
+}
+
+bool zfo_glob_set_match(const zfo_glob_set_t* set, const char* path, bool is_dir) {
+    if (!set || !path) return false;
+
+    glob_comp_t stack[GLOB_STACK_COMPS];
+    glob_comp_t* comps;
+    size_t n = split_path(path, stack, GLOB_STACK_COMPS, &comps);
+    bool ok = set_match_comps(set, comps, n, is_dir);
+    if (comps != stack) free(comps);
+    return ok;
+}
+
+void zfo_glob_set_free(zfo_glob_set_t* set) {
+    if (!set) return;
+    for (size_t i = 0; i < set->count; i++) pat_free(&set->pats[i]);
+    free(set->pats);
+    free(set);
+}
+
+/* ============================================================
+ * Ignore Rules
+ * ============================================================ */
+
+typedef struct {
+    glob_pat_t* rules;
+    size_t count;
+    size_t depth;               /* Components in the directory holding them */
+} ignore_list_t;
+
+static void ignore_list_free(ignore_list_t* list) {
+    if (!list) return;
+    for (size_t i = 0; i < list->count; i++) pat_free(&list->rules[i]);
+    free(list->rules);
+    free(list);
+}
+
+static int ignore_list_add(ignore_list_t* list, size_t* cap, const char* line) {
+    bool negate = false;
+    if (line[0] == '!') {
+        negate = true;
+        line++;
+    } else if (line[0] == '\\' && (line[1] == '!' || line[1] == '#')) {
+        line++;
+    }
+
+    if (list->count == *cap) {
+        size_t ncap = *cap ? *cap * 2 : 8;
+        glob_pat_t* nrules = realloc(list->rules, ncap * sizeof(glob_pat_t));
+        if (!nrules) return ZFO_ERR_NO_MEMORY;
+        list->rules = nrules;
+        *cap = ncap;
+    }
+    int rc = pat_compile(line, negate, &list->rules[list->count]);
+    if (rc == ZFO_OK) list->count++;
+    return rc == ZFO_ERR_INVALID_ARG ? ZFO_OK : rc;
+}
+
+/* Parse .gitignore-style text into a rule list (NULL when it has no rules) */
+static ignore_list_t* ignore_parse(const char* text, size_t len, size_t depth) {
+    ignore_list_t* list = calloc(1, sizeof(ignore_list_t));
+    if (!list) return NULL;
+    list->depth = depth;
+
+    size_t cap = 0;
+    char line[PATH_MAX];
+    size_t pos = 0;
+
+    while (pos < len) {
+        size_t start = pos;
+        while (pos < len && text[pos] != '\n') pos++;
+        size_t n = pos - start;
+        pos++;
+
+        if (n > 0 && text[start + n - 1] == '\r') n--;
+        /* Trailing spaces are dropped unless escaped */
+        while (n > 0 && text[start + n - 1] == ' ' &&
+               !(n > 1 && text[start + n - 2] == '\\')) {
+            n--;
+        }
+        if (n == 0 || n >= sizeof(line) || text[start] == '#') continue;
+
+        memcpy(line, text + start, n);
+        line[n] = 0;
+        if (ignore_list_add(list, &cap, line) != ZFO_OK) break;
+    }
+
+    if (list->count == 0) {
+        ignore_list_free(list);
+        return NULL;
+    }
+    return list;
+}
+
+static ignore_list_t* ignore_load(int dir_fd, const char* name, size_t depth) {
+    int fd = openat(dir_fd, name, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 ||
+        st.st_size > GLOB_MAX_IGNORE_FILE) {
+        close(fd);
+        return NULL;
+    }
+
+    char* buf = malloc((size_t)st.st_size);
+    size_t got = 0;
+    while (buf && got < (size_t)st.st_size) {
+        ssize_t r = read(fd, buf + got, (size_t)st.st_size - got);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) break;
+        got += (size_t)r;
+    }
+    close(fd);
+
+    ignore_list_t* list = buf ? ignore_parse(buf, got, depth) : NULL;
+    free(buf);
+    return list;
+}
+
+/* Apply one list to comps (the full relative path); updates *ignored */
+static void ignore_apply(const ignore_list_t* list, const glob_comp_t* comps, size_t n,
+                         bool is_dir, bool* ignored) {
+    if (n <= list->depth) return;
+
+    const glob_comp_t* sub = comps + list->depth;
+    size_t sub_n = n - list->depth;
+
+    for (size_t i = 0; i < list->count; i++) {
+        const glob_pat_t* rule = &list->rules[i];
+        if (rule->dir_only && !is_dir) continue;
+
+        bool hit = rule->anchored
+            ? match_from(rule, 0, rule->nsegs, sub, 0, sub_n, ZFO_GLOB_DOT)
+            : rule->nsegs == 1 && seg_match(&rule->segs[0], &sub[sub_n - 1], ZFO_GLOB_DOT);
+        if (hit) *ignored = !rule->negate;
+    }
+}
+
+/* ============================================================
+ * Parallel Glob
+ * ============================================================ */
+
+typedef struct {
+    const zfo_glob_set_t* set;
+    const zfo_glob_options_t* opts;
+    size_t rel_off;             /* Offset of the relative path in entry->path */
+
+    ignore_list_t* extra;       /* opts->ignore, rooted at the walk root */
+    ignore_list_t** root_lists; /* Ignore files found in the root */
+
+    pthread_rwlock_t lock;
+    DaggerTable* dir_lists;     /* Relative dir -> ignore_list_t* */
+    size_t dir_list_count;      /* atomic */
+} glob_ctx_t;
+
+static bool glob_ignored(glob_ctx_t* g, const char* rel, const glob_comp_t* comps,
+                         size_t n, bool is_dir) {
+    bool ignored = false;
+
+    if (g->extra) ignore_apply(g->extra, comps, n, is_dir, &ignored);
+    for (size_t i = 0; i < g->opts->ignore_file_count; i++) {
+        if (g->root_lists[i]) ignore_apply(g->root_lists[i], comps, n, is_dir, &ignored);
+    }
+
+    if (ZFO_ATOMIC_LOAD(&g->dir_list_count) == 0) return ignored;
+
+    /* Deeper directories' rules override shallower ones */
+    pthread_rwlock_rdlock(&g->lock);
+    for (size_t d = 1; d < n; d++) {
+        size_t key_len = (size_t)(comps[d - 1].s + comps[d - 1].len - rel);
+        void* value = NULL;
+        if (dagger_get(g->dir_lists, rel, (uint32_t)key_len, &value) == DAGGER_OK) {
+            for (ignore_list_t** l = value; *l; l++) ignore_apply(*l, comps, n, is_dir, &ignored);
+        }
+    }
+    pthread_rwlock_unlock(&g->lock);
+
+    return ignored;
+}
+
+/* Read a directory's ignore files before the walker descends into it */
+static void glob_load_dir(glob_ctx_t* g, const zfo_walk_entry_t* entry, const char* rel,
+                          size_t depth) {
+    size_t nfiles = g->opts->ignore_file_count;
+    ignore_list_t** lists = NULL;
+    size_t found = 0;
+
+    int fd = openat(entry->dir_fd, entry->name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return;
+
+    for (size_t i = 0; i < nfiles; i++) {
+        ignore_list_t* list = ignore_load(fd, g->opts->ignore_files[i], depth);
+        if (!list) continue;
+        if (!lists) lists = calloc(nfiles + 1, sizeof(ignore_list_t*));
+        if (!lists) {
+            ignore_list_free(list);
+            break;
+        }
+        lists[found++] = list;
+    }
+    close(fd);
+    if (found == 0) {
+        free(lists);
+        return;
+    }
+
+    char* key = strdup(rel);
+    pthread_rwlock_wrlock(&g->lock);
+    if (key && dagger_set(g->dir_lists, key, (uint32_t)strlen(key), lists, 0) == DAGGER_OK) {
+        ZFO_ATOMIC_ADD(&g->dir_list_count, 1);
+        key = NULL;
+        lists = NULL;
+    }
+    pthread_rwlock_unlock(&g->lock);
+
+    free(key);
+    if (lists) {
+        for (size_t i = 0; i < found; i++) ignore_list_free(lists[i]);
+        free(lists);
+    }
+}
+
+static int glob_visit(const zfo_walk_entry_t* entry, void* userdata) {
+    glob_ctx_t* g = userdata;
+    const char* rel = entry->path + g->rel_off;
+    bool is_dir = entry->type == ZFO_TYPE_DIR;
+
+    glob_comp_t stack[GLOB_STACK_COMPS];
+    glob_comp_t* comps;
+    size_t n = split_path(rel, stack, GLOB_STACK_COMPS, &comps);
+    int action = ZFO_WALK_CONTINUE;
+
+    if (glob_ignored(g, rel, comps, n, is_dir)) {
+        action = is_dir ? ZFO_WALK_PRUNE : ZFO_WALK_CONTINUE;
+        goto done;
+    }
+
+    if (is_dir) {
+        if (!g->set || set_descend_comps(g->set, comps, n)) {
+            if (g->opts->ignore_file_count > 0) glob_load_dir(g, entry, rel, n);
+        } else {
+            action = ZFO_WALK_PRUNE;
+        }
+    }
+
+    if ((!g->set || set_match_comps(g->set, comps, n, is_dir)) && g->opts->walk.visit) {
+        int r = g->opts->walk.visit(entry, g->opts->walk.userdata);
+        if (r == ZFO_WALK_STOP || (r == ZFO_WALK_PRUNE && is_dir)) action = r;
+    }
+
+done:
+    if (comps != stack) free(comps);
+    return action;
+}
+
+static int free_dir_lists(const void* key, uint32_t key_len, void* value, void* ctx) {
+    (void)key_len;
+    (void)ctx;
+    for (ignore_list_t** l = value; *l; l++) ignore_list_free(*l);
+    free(value);
+    free((void*)key);
+    return 0;
+}
+
+int zfo_glob_walk(const char* root, const zfo_glob_set_t* set,
+                  const zfo_glob_options_t* opts, zfo_tree_result_t* result) {
+    if (!set) return ZFO_ERR_INVALID_ARG;
+    return zfo_glob_walk_run(NULL, root, set, opts, result);
+}
+
+int zfo_glob_walk_run(zfo_pool_t* pool, const char* root, const zfo_glob_set_t* set,
+                      const zfo_glob_options_t* opts, zfo_tree_result_t* result) {
+    if (!root || !opts) return ZFO_ERR_INVALID_ARG;
+    if (result) memset(result, 0, sizeof(*result));
+
+    glob_ctx_t g = {0};
+    g.set = set;
+    g.opts = opts;
+
+    /* Must agree with how zfo_walk_parallel joins child paths */
+    size_t root_len = strlen(root);
+    while (root_len > 1 && root[root_len - 1] == '/') root_len--;
+    g.rel_off = root_len + (root[root_len - 1] == '/' ? 0 : 1);
+
+    int rc = ZFO_ERR_NO_MEMORY;
+    g.dir_lists = dagger_create(64, NULL);
+    g.root_lists = calloc(opts->ignore_file_count + 1, sizeof(ignore_list_t*));
+    if (!g.dir_lists || !g.root_lists) goto out;
+
+    if (opts->ignore_count > 0) {
+        g.extra = calloc(1, sizeof(ignore_list_t));
+        if (!g.extra) goto out;
+        size_t cap = 0;
+        for (size_t i = 0; i < opts->ignore_count; i++) {
+            if (opts->ignore[i] && ignore_list_add(g.extra, &cap, opts->ignore[i]) != ZFO_OK) goto out;
+        }
+    }
+
+    if (opts->ignore_file_count > 0) {
+        int fd = open(root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd >= 0) {
+            for (size_t i = 0; i < opts->ignore_file_count; i++) {
+                g.root_lists[i] = ignore_load(fd, opts->ignore_files[i], 0);
+            }
+            close(fd);
+        }
+    }
+
+    pthread_rwlock_init(&g.lock, NULL);
+
+    zfo_walk_options_t walk = opts->walk;
+    walk.visit = glob_visit;
+    walk.userdata = &g;
+    rc = zfo_walk_run(pool, root, &walk, result);
+
+    pthread_rwlock_destroy(&g.lock);
+
+out:
+    if (g.dir_lists) {
+        dagger_foreach(g.dir_lists, free_dir_lists, NULL);
+        dagger_destroy(g.dir_lists);
+    }
+    if (g.root_lists) {
+        for (size_t i = 0; i < opts->ignore_file_count; i++) ignore_list_free(g.root_lists[i]);
+        free(g.root_lists);
+    }
+    ignore_list_free(g.extra);
+    return rc;
+}
@@ -0,0 +1,1091 @@
+/**
+ * @file zorya_kv.c
+ * @brief Zorya FileOps - Log-structured key-value store
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   A bitcask-style store: a directory of append-only data files
+ *   ("0000000001.data") and an in-memory DAGGER keydir mapping each key
+ *   to the file, offset and size of its latest record. A put is one
+ *   pwritev at the end of the active file; a get is one pread of the
+ *   record, checked before the value is returned.
+ *
+ *   Each record is framed as
+ *
+ *     u32 check | u32 key_len | u32 val_len | u32 0 | u64 seq | key | value | pad to 8
+ *
+ *   where check is an nxh64 of key and value seeded with seq and the
+ *   lengths, and val_len is all ones for a delete. Data files are
+ *   preallocated like WAL segments, so the zero tail never validates and
+ *   a torn write ends the file at the last good record.
+ *
+ *   The newest seq wins when the keydir is rebuilt, so files can be
+ *   loaded in any order and a crash in the middle of a merge only
+ *   leaves duplicates behind. A merge rewrites the live records of
+ *   every immutable file into new files, each with a hint file
+ *   (key, seq, offset, length per record) that is loaded at startup
+ *   instead of scanning the data. It runs on a background thread once
+ *   enough of the store is dead, or on request.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+#include "dagger.h"
+#include "nxh.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sys/file.h>
+
+#define KV_RECORD_SIZE       24
+#define KV_TOMBSTONE         UINT32_MAX
+#define KV_DEFAULT_FILE      (64ull * 1024 * 1024)
+#define KV_DEFAULT_DEAD      50
+#define KV_MERGE_BATCH       (1u << 20)
+#define KV_HINT_MAGIC        0x31544E4948564B5AULL   /* "ZKVHINT1" */
+#define KV_NAME_DIGITS       10
+#define KV_NAME_LEN          (KV_NAME_DIGITS + 5)    /* digits + ".data" */
+
+/* ============================================================
+ * Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    uint32_t check;
+    uint32_t key_len;
+    uint32_t val_len;
+    uint32_t reserved;
+    uint64_t seq;
+} kv_record_t;
+
+typedef struct {
+    uint64_t magic;
+    uint64_t data_size;             /* Data file bytes the hint covers */
+    uint64_t count;
+    uint64_t check;                 /* nxh64 of the entries */
+} kv_hint_header_t;
+
+typedef struct {
+    uint64_t seq;
+    uint64_t offset;
+    uint32_t key_len;
+    uint32_t val_len;
+} kv_hint_entry_t;                  /* Followed by the key */
+
+typedef struct {
+    uint32_t id;
+    int fd;
+    uint64_t size;                  /* Bytes of valid records */
+    uint64_t alloc;                 /* Preallocated bytes (active file) */
+    uint64_t live_bytes;
+    uint64_t live_count;
+    uint32_t refs;                  /* The file list's, plus readers' */
+} kv_file_t;
+
+typedef struct {
+    kv_file_t* file;
+    uint64_t offset;
+    uint64_t seq;
+    uint32_t val_len;               /* KV_TOMBSTONE only while loading */
+    uint32_t key_len;
+    char key[];
+} kv_entry_t;
+
+struct zfo_kv {
+    int dir_fd;
+    uint64_t max_file_size;
+    uint32_t dead_percent;
+    uint64_t merge_min_bytes;
+    uint32_t flags;
+
+    pthread_mutex_t lock;
+    DaggerTable* keydir;
+    kv_file_t** files;              /* Every file, active included */
+    size_t file_count;
+    size_t file_cap;
+    kv_file_t* active;
+    uint32_t next_file_id;
+    uint64_t next_seq;
+    uint64_t total_bytes;           /* Records in every file, dead or alive */
+    uint64_t live_bytes;
+
+    pthread_t thread;
+    bool thread_started;
+    pthread_cond_t wake;
+    bool merge_requested;
+    bool merging;
+    bool stop;
+    uint64_t merges;
+};
+
+static inline uint64_t kv_record_total(uint32_t key_len, uint32_t val_len) {
+    uint64_t len = KV_RECORD_SIZE + (uint64_t)key_len + (val_len == KV_TOMBSTONE ? 0 : val_len);
+    return (len + 7) & ~(uint64_t)7;
+}
+
+static uint32_t kv_check(const kv_record_t* r, const void* key, const void* val) {
+    uint64_t h = nxh64(key, r->key_len, r->seq ^ ((uint64_t)r->key_len << 32) ^ r->val_len);
+    if (r->val_len != KV_TOMBSTONE) h = nxh64(val, r->val_len, h);
+    uint32_t c = (uint32_t)(h ^ (h >> 32));
+    return c ? c : 1;
+}
+
+static int kv_key_eq(const void* k1, uint32_t k1_len, const void* k2, uint32_t k2_len) {
+    return k1_len == k2_len && memcmp(k1, k2, k1_len) == 0;
+}
+
+/* ============================================================
+ * Files
+ * ============================================================ */
+
+static void kv_name(uint32_t id, const char* ext, char* name) {
+    snprintf(name, KV_NAME_LEN + 1, "%010u.%s", id, ext);
+}
+
+static bool kv_parse_name(const char* name, uint32_t* id) {
+    if (strlen(name) != KV_NAME_LEN || strcmp(name + KV_NAME_DIGITS, ".data") != 0) return false;
+    uint64_t v = 0;
+    for (int i = 0; i < KV_NAME_DIGITS; i++) {
+        if (name[i] < '0' || name[i] > '9') return false;
+        v = v * 10 + (uint64_t)(name[i] - '0');
+    }
+    if (v == 0 || v > UINT32_MAX) return false;
+    *id = (uint32_t)v;
+    return true;
+}
+
+static void kv_preallocate(int fd, uint64_t size) {
+#ifdef __linux__
+    if (fallocate(fd, 0, 0, (off_t)size) == 0) return;
+#endif
+    /* No fallocate: extend with a hole so the tail still reads as zeroes */
+    if (ftruncate(fd, (off_t)size) != 0) return;
+}
+
+static void kv_file_unref(kv_file_t* f) {
+    if (ZFO_ATOMIC_SUB(&f->refs, 1) > 0) return;
+    if (f->fd >= 0) close(f->fd);
+    free(f);
+}
+
+static int kv_add_file(zfo_kv_t* kv, kv_file_t* f) {
+    if (kv->file_count == kv->file_cap) {
+        size_t ncap = kv->file_cap ? kv->file_cap * 2 : 16;
+        kv_file_t** nfiles = realloc(kv->files, ncap * sizeof(kv_file_t*));
+        if (!nfiles) return ZFO_ERR_NO_MEMORY;
+        kv->files = nfiles;
+        kv->file_cap = ncap;
+    }
+    kv->files[kv->file_count++] = f;
+    return ZFO_OK;
+}
+
+static void kv_remove_file(zfo_kv_t* kv, kv_file_t* f) {
+    for (size_t i = 0; i < kv->file_count; i++) {
+        if (kv->files[i] == f) {
+            memmove(&kv->files[i], &kv->files[i + 1], (kv->file_count - i - 1) * sizeof(kv_file_t*));
+            kv->file_count--;
+            return;
+        }
+    }
+}
+
+/* Create the next data file, preallocated and listed (lock held or not yet shared) */
+static int kv_create_file(zfo_kv_t* kv, uint64_t min_size, kv_file_t** out) {
+    char name[KV_NAME_LEN + 1];
+    uint32_t id = kv->next_file_id++;
+    kv_name(id, "data", name);
+
+    int fd = openat(kv->dir_fd, name, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return zfo_error_from_errno(errno);
+
+    kv_file_t* f = calloc(1, sizeof(kv_file_t));
+    if (!f || kv_add_file(kv, f) != ZFO_OK) {
+        free(f);
+        close(fd);
+        unlinkat(kv->dir_fd, name, 0);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    f->id = id;
+    f->fd = fd;
+    f->refs = 1;
+    f->alloc = kv->max_file_size > min_size ? kv->max_file_size : min_size;
+    kv_preallocate(fd, f->alloc);
+
+    /* The new name must survive a crash before any record in it does */
+    fsync(kv->dir_fd);
+    *out = f;
+    return ZFO_OK;
+}
+
+/* Cut the preallocated tail off and make the file durable */
+static int kv_seal(kv_file_t* f) {
+    if (ftruncate(f->fd, (off_t)f->size) != 0 || fdatasync(f->fd) != 0) {
+        return zfo_error_from_errno(errno);
+    }
+    f->alloc = f->size;
+    return ZFO_OK;
+}
+
+static int kv_pwritev_all(int fd, struct iovec* iov, int iovcnt, uint64_t offset) {
+    while (iovcnt > 0) {
+        ssize_t n = pwritev(fd, iov, iovcnt, (off_t)offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return zfo_error_from_errno(errno);
+        }
+        offset += (uint64_t)n;
+        while (iovcnt > 0 && (size_t)n >= iov->iov_len) {
+            n -= (ssize_t)iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = (char*)iov->iov_base + n;
+            iov->iov_len -= (size_t)n;
+        }
+    }
+    return ZFO_OK;
+}
+
+/* ============================================================
+ * Keydir (lock held)
+ * ============================================================ */
+
+static void kv_unlink_live(zfo_kv_t* kv, kv_entry_t* e) {
+    if (e->val_len == KV_TOMBSTONE) return;
+    uint64_t total = kv_record_total(e->key_len, e->val_len);
+    e->file->live_bytes -= total;
+    e->file->live_count--;
+    kv->live_bytes -= total;
+}
+
+static void kv_link_live(zfo_kv_t* kv, kv_entry_t* e) {
+    if (e->val_len == KV_TOMBSTONE) return;
+    uint64_t total = kv_record_total(e->key_len, e->val_len);
+    e->file->live_bytes += total;
+    e->file->live_count++;
+    kv->live_bytes += total;
+}
+
+static kv_entry_t* kv_lookup(zfo_kv_t* kv, const void* key, uint32_t key_len) {
+    void* val = NULL;
+    return dagger_get(kv->keydir, key, key_len, &val) == DAGGER_OK ? val : NULL;
+}
+
+/*
+ * Point key at a record unless the keydir already holds a newer one.
+ * Tombstones stay in the keydir so that loading can order them against
+ * puts in other files; kv_put/kv_delete drop them right away.
+ */
+static int kv_apply(zfo_kv_t* kv, kv_file_t* f, uint64_t offset, uint64_t seq,
+                    const void* key, uint32_t key_len, uint32_t val_len) {
+    kv_entry_t* e = kv_lookup(kv, key, key_len);
+    if (e) {
+        if (e->seq > seq) return ZFO_OK;
+        kv_unlink_live(kv, e);
+    } else {
+        e = malloc(sizeof(kv_entry_t) + key_len);
+        if (!e) return ZFO_ERR_NO_MEMORY;
+        e->key_len = key_len;
+        memcpy(e->key, key, key_len);
+        if (dagger_set(kv->keydir, e->key, key_len, e, 0) != DAGGER_OK) {
+            free(e);
+            return ZFO_ERR_NO_MEMORY;
+        }
+    }
+    e->file = f;
+    e->offset = offset;
+    e->seq = seq;
+    e->val_len = val_len;
+    kv_link_live(kv, e);
+    return ZFO_OK;
+}
+
+static void kv_drop(zfo_kv_t* kv, kv_entry_t* e) {
+    kv_unlink_live(kv, e);
+    dagger_remove(kv->keydir, e->key, e->key_len);
+}
+
+typedef struct {
+    kv_entry_t** items;
+    size_t count;
+    size_t cap;
+    kv_file_t* file;                /* Collect entries in this file, or tombstones */
+} kv_collect_t;
+
+static int kv_collect(const void* key, uint32_t key_len, void* value, void* ctx) {
+    (void)key;
+    (void)key_len;
+    kv_collect_t* c = ctx;
+    kv_entry_t* e = value;
+    bool want = c->file ? (e->file == c->file && e->val_len != KV_TOMBSTONE)
+                        : e->val_len == KV_TOMBSTONE;
+    if (!want) return 0;
+    if (c->count == c->cap) {
+        size_t ncap = c->cap ? c->cap * 2 : 64;
+        kv_entry_t** nitems = realloc(c->items, ncap * sizeof(kv_entry_t*));
+        if (!nitems) return 1;
+        c->items = nitems;
+        c->cap = ncap;
+    }
+    c->items[c->count++] = e;
+    return 0;
+}
+
+/* Remove every tombstone, or every live entry still in file */
+static void kv_purge(zfo_kv_t* kv, kv_file_t* file) {
+    kv_collect_t c = { .file = file };
+    dagger_foreach(kv->keydir, kv_collect, &c);
+    for (size_t i = 0; i < c.count; i++) kv_drop(kv, c.items[i]);
+    free(c.items);
+}
+
+/* ============================================================
+ * Loading
+ * ============================================================ */
+
+/* Apply a hint file; returns the data bytes it covers (0 if unusable) */
+static uint64_t kv_load_hint(zfo_kv_t* kv, kv_file_t* f, uint64_t data_size, int* rc) {
+    char name[KV_NAME_LEN + 1];
+    kv_name(f->id, "hint", name);
+    int fd = openat(kv->dir_fd, name, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+
+    struct stat st;
+    uint64_t covered = 0;
+    if (fstat(fd, &st) == 0 && (uint64_t)st.st_size >= sizeof(kv_hint_header_t)) {
+        size_t size = (size_t)st.st_size;
+        char* map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (map != MAP_FAILED) {
+            kv_hint_header_t hdr;
+            memcpy(&hdr, map, sizeof(hdr));
+            const char* p = map + sizeof(hdr);
+            size_t len = size - sizeof(hdr);
+            if (hdr.magic == KV_HINT_MAGIC && hdr.data_size <= data_size &&
+                hdr.check == nxh64(p, len, NXH_SEED_DEFAULT)) {
+                size_t off = 0;
+                for (uint64_t i = 0; i < hdr.count && *rc == ZFO_OK; i++) {
+                    kv_hint_entry_t h;
+                    if (len - off < sizeof(h)) break;
+                    memcpy(&h, p + off, sizeof(h));
+                    off += sizeof(h);
+                    if (len - off < h.key_len) break;
+                    *rc = kv_apply(kv, f, h.offset, h.seq, p + off, h.key_len, h.val_len);
+                    if (h.seq >= kv->next_seq) kv->next_seq = h.seq + 1;
+                    off += h.key_len;
+                }
+                /* Records the hint leaves out were dead when it was written */
+                covered = hdr.data_size;
+                kv->total_bytes += covered;
+            }
+            munmap(map, size);
+        }
+    }
+    close(fd);
+    return covered;
+}
+
+static int kv_load_file(zfo_kv_t* kv, uint32_t id) {
+    char name[KV_NAME_LEN + 1];
+    kv_name(id, "data", name);
+    int fd = openat(kv->dir_fd, name, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return zfo_error_from_errno(errno);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int rc = zfo_error_from_errno(errno);
+        close(fd);
+        return rc;
+    }
+
+    kv_file_t* f = calloc(1, sizeof(kv_file_t));
+    if (!f || kv_add_file(kv, f) != ZFO_OK) {
+        free(f);
+        close(fd);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    f->id = id;
+    f->fd = fd;
+    f->refs = 1;
+
+    int rc = ZFO_OK;
+    uint64_t size = (uint64_t)st.st_size;
+    uint64_t off = kv_load_hint(kv, f, size, &rc);
+
+    if (rc == ZFO_OK && off < size) {
+        char* map = mmap(NULL, (size_t)size, PROT_READ, MAP_SHARED, fd, 0);
+        if (map == MAP_FAILED) {
+            rc = zfo_error_from_errno(errno);
+        } else {
+            madvise(map, (size_t)size, MADV_SEQUENTIAL);
+            while (rc == ZFO_OK && size - off >= KV_RECORD_SIZE) {
+                kv_record_t r;
+                memcpy(&r, map + off, sizeof(r));
+                uint64_t body = (uint64_t)r.key_len + (r.val_len == KV_TOMBSTONE ? 0 : r.val_len);
+                if (r.key_len == 0 || r.reserved != 0 || body > size - off - KV_RECORD_SIZE) break;
+                const char* key = map + off + KV_RECORD_SIZE;
+                if (r.check != kv_check(&r, key, key + r.key_len)) break;
+
+                rc = kv_apply(kv, f, off, r.seq, key, r.key_len, r.val_len);
+                uint64_t total = kv_record_total(r.key_len, r.val_len);
+                kv->total_bytes += total;
+                if (r.seq >= kv->next_seq) kv->next_seq = r.seq + 1;
+                off += total;
+            }
+            munmap(map, (size_t)size);
+        }
+    }
+    f->size = off < size ? off : size;
+    f->alloc = f->size;
+    return rc;
+}
+
+static int cmp_id(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+static int kv_load(zfo_kv_t* kv) {
+    int fd = dup(kv->dir_fd);
+    if (fd < 0) return zfo_error_from_errno(errno);
+
+    zfo_dirscan_t scan;
+    int rc = zfo_dirscan_open(&scan, fd);
+    if (rc != ZFO_OK) {
+        close(fd);
+        return rc;
+    }
+
+    uint32_t* ids = NULL;
+    size_t count = 0, cap = 0;
+    const char* name;
+    unsigned char d_type;
+    uint64_t inode;
+    while (zfo_dirscan_next(&scan, &name, &d_type, &inode)) {
+        uint32_t id;
+        if (!kv_parse_name(name, &id)) continue;
+        if (count == cap) {
+            size_t ncap = cap ? cap * 2 : 16;
+            uint32_t* nids = realloc(ids, ncap * sizeof(uint32_t));
+            if (!nids) {
+                rc = ZFO_ERR_NO_MEMORY;
+                break;
+            }
+            ids = nids;
+            cap = ncap;
+        }
+        ids[count++] = id;
+    }
+    if (rc == ZFO_OK) rc = zfo_dirscan_error(&scan);
+    zfo_dirscan_close(&scan);
+    close(fd);
+
+    if (rc == ZFO_OK) {
+        qsort(ids, count, sizeof(uint32_t), cmp_id);
+        for (size_t i = 0; i < count && rc == ZFO_OK; i++) rc = kv_load_file(kv, ids[i]);
+        if (count > 0) kv->next_file_id = ids[count - 1] + 1;
+    }
+    free(ids);
+    if (rc != ZFO_OK) return rc;
+
+    kv_purge(kv, NULL);
+
+    /* Files with nothing valid in them (an unused active file) */
+    for (size_t i = 0; i < kv->file_count;) {
+        kv_file_t* f = kv->files[i];
+        if (f->size > 0) {
+            i++;
+            continue;
+        }
+        char fname[KV_NAME_LEN + 1];
+        kv_name(f->id, "data", fname);
+        unlinkat(kv->dir_fd, fname, 0);
+        kv_name(f->id, "hint", fname);
+        unlinkat(kv->dir_fd, fname, 0);
+        kv_remove_file(kv, f);
+        kv_file_unref(f);
+    }
+    return ZFO_OK;
+}
+
+/* ============================================================
+ * Merging
+ * ============================================================ */
+
+typedef struct {
+    kv_file_t* from;
+    uint64_t from_offset;
+    uint64_t to_offset;
+    uint64_t seq;
+    uint32_t key_len;
+    uint32_t val_len;
+    const char* key;                /* In the source file's mapping */
+} kv_move_t;
+
+typedef struct {
+    zfo_kv_t* kv;
+    kv_file_t* out;
+    char* buf;
+    size_t buf_len;
+    kv_move_t* moves;
+    size_t move_count;
+    size_t move_cap;
+    char* hint;                     /* Entries for out, header written last */
+    size_t hint_len;
+    size_t hint_cap;
+    uint64_t hint_count;
+} kv_merger_t;
+
+static int kv_hint_add(kv_merger_t* m, const kv_move_t* mv) {
+    size_t need = sizeof(kv_hint_entry_t) + mv->key_len;
+    if (m->hint_len + need > m->hint_cap) {
+        size_t ncap = m->hint_cap ? m->hint_cap * 2 : 64 * 1024;
+        while (ncap < m->hint_len + need) ncap *= 2;
+        char* nhint = realloc(m->hint, ncap);
+        if (!nhint) return ZFO_ERR_NO_MEMORY;
+        m->hint = nhint;
+        m->hint_cap = ncap;
+    }
+    kv_hint_entry_t h = { mv->seq, mv->to_offset, mv->key_len, mv->val_len };
+    memcpy(m->hint + m->hint_len, &h, sizeof(h));
+    memcpy(m->hint + m->hint_len + sizeof(h), mv->key, mv->key_len);
+    m->hint_len += need;
+    m->hint_count++;
+    return ZFO_OK;
+}
+
+/* Write the batch, then repoint the keys that still live where they were */
+static int kv_merge_flush(kv_merger_t* m) {
+    if (m->buf_len == 0) return ZFO_OK;
+    zfo_kv_t* kv = m->kv;
+    struct iovec iov = { m->buf, m->buf_len };
+    int rc = kv_pwritev_all(m->out->fd, &iov, 1, m->out->size);
+    if (rc != ZFO_OK) return rc;
+
+    pthread_mutex_lock(&kv->lock);
+    m->out->size += m->buf_len;
+    kv->total_bytes += m->buf_len;
+    for (size_t i = 0; i < m->move_count && rc == ZFO_OK; i++) {
+        kv_move_t* mv = &m->moves[i];
+        kv_entry_t* e = kv_lookup(kv, mv->key, mv->key_len);
+        if (!e || e->file != mv->from || e->offset != mv->from_offset) continue;
+        kv_unlink_live(kv, e);
+        e->file = m->out;
+        e->offset = mv->to_offset;
+        kv_link_live(kv, e);
+        rc = kv_hint_add(m, mv);
+    }
+    pthread_mutex_unlock(&kv->lock);
+
+    m->buf_len = 0;
+    m->move_count = 0;
+    return rc;
+}
+
+/* Seal the current output and write its hint */
+static int kv_merge_finish_output(kv_merger_t* m) {
+    if (!m->out) return ZFO_OK;
+    int rc = kv_merge_flush(m);
+    if (rc == ZFO_OK) rc = kv_seal(m->out);
+    if (rc == ZFO_OK && m->out->size > 0) {
+        char name[KV_NAME_LEN + 1];
+        kv_name(m->out->id, "hint", name);
+        kv_hint_header_t hdr = {
+            .magic = KV_HINT_MAGIC,
+            .data_size = m->out->size,
+            .count = m->hint_count,
+            .check = nxh64(m->hint, m->hint_len, NXH_SEED_DEFAULT)
+        };
+        int fd = openat(m->kv->dir_fd, name, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            rc = zfo_error_from_errno(errno);
+        } else {
+            struct iovec iov[2] = { { &hdr, sizeof(hdr) }, { m->hint, m->hint_len } };
+            rc = kv_pwritev_all(fd, iov, 2, 0);
+            if (rc == ZFO_OK && fdatasync(fd) != 0) rc = zfo_error_from_errno(errno);
+            close(fd);
+        }
+    }
+    m->out = NULL;
+    m->hint_len = 0;
+    m->hint_count = 0;
+    return rc;
+}
+
+static int kv_merge_copy(kv_merger_t* m, kv_file_t* from, uint64_t offset,
+                         const kv_record_t* r, const char* rec) {
+    zfo_kv_t* kv = m->kv;
+    uint64_t total = kv_record_total(r->key_len, r->val_len);
+    int rc;
+
+    if (m->out && m->out->size + m->buf_len + total > kv->max_file_size &&
+        m->out->size + m->buf_len > 0) {
+        rc = kv_merge_finish_output(m);
+        if (rc != ZFO_OK) return rc;
+    }
+    if (!m->out) {
+        pthread_mutex_lock(&kv->lock);
+        rc = kv_create_file(kv, total, &m->out);
+        pthread_mutex_unlock(&kv->lock);
+        if (rc != ZFO_OK) return rc;
+    }
+    if (m->buf_len + total > KV_MERGE_BATCH || m->move_count == m->move_cap) {
+        rc = kv_merge_flush(m);
+        if (rc != ZFO_OK) return rc;
+    }
+    if (total > KV_MERGE_BATCH) {
+        /* Too big for the batch: write it straight from the mapping */
+        struct iovec iov = { (void*)rec, total };
+        rc = kv_pwritev_all(m->out->fd, &iov, 1, m->out->size);
+        if (rc != ZFO_OK) return rc;
+        kv_move_t mv = { from, offset, m->out->size, r->seq, r->key_len, r->val_len,
+                         rec + KV_RECORD_SIZE };
+        pthread_mutex_lock(&kv->lock);
+        m->out->size += total;
+        kv->total_bytes += total;
+        kv_entry_t* e = kv_lookup(kv, mv.key, mv.key_len);
+        if (e && e->file == from && e->offset == offset) {
+            kv_unlink_live(kv, e);
+            e->file = m->out;
+            e->offset = mv.to_offset;
+            kv_link_live(kv, e);
+            rc = kv_hint_add(m, &mv);
+        }
+        pthread_mutex_unlock(&kv->lock);
+        return rc;
+    }
+
+    memcpy(m->buf + m->buf_len, rec, total);
+    kv_move_t* mv = &m->moves[m->move_count++];
+    mv->from = from;
+    mv->from_offset = offset;
+    mv->to_offset = m->out->size + m->buf_len;
+    mv->seq = r->seq;
+    mv->key_len = r->key_len;
+    mv->val_len = r->val_len;
+    mv->key = rec + KV_RECORD_SIZE;
+    m->buf_len += total;
+    return ZFO_OK;
+}
+
+static int kv_merge_file(kv_merger_t* m, kv_file_t* f) {
+    if (f->size == 0) return ZFO_OK;
+    zfo_kv_t* kv = m->kv;
+    char* map = mmap(NULL, (size_t)f->size, PROT_READ, MAP_SHARED, f->fd, 0);
+    if (map == MAP_FAILED) return zfo_error_from_errno(errno);
+    madvise(map, (size_t)f->size, MADV_SEQUENTIAL);
+
+    int rc = ZFO_OK;
+    uint64_t off = 0;
+    while (rc == ZFO_OK && f->size - off >= KV_RECORD_SIZE && !ZFO_ATOMIC_LOAD(&kv->stop)) {
+        kv_record_t r;
+        memcpy(&r, map + off, sizeof(r));
+        uint64_t total = kv_record_total(r.key_len, r.val_len);
+        if (total > f->size - off) break;
+        if (r.val_len != KV_TOMBSTONE) {
+            const char* key = map + off + KV_RECORD_SIZE;
+            pthread_mutex_lock(&kv->lock);
+            kv_entry_t* e = kv_lookup(kv, key, r.key_len);
+            bool live = e && e->file == f && e->offset == off;
+            pthread_mutex_unlock(&kv->lock);
+            if (live) rc = kv_merge_copy(m, f, off, &r, map + off);
+        }
+        off += total;
+    }
+
+    /* Moves point into this mapping */
+    if (rc == ZFO_OK) rc = kv_merge_flush(m);
+    munmap(map, (size_t)f->size);
+    return rc;
+}
+
+/* Start a fresh active file so the old one can be merged too (lock held) */
+static int kv_rotate_locked(zfo_kv_t* kv, uint64_t need) {
+    int rc = kv_seal(kv->active);
+    if (rc != ZFO_OK) return rc;
+    return kv_create_file(kv, need, &kv->active);
+}
+
+int zfo_kv_merge(zfo_kv_t* kv) {
+    if (!kv) return ZFO_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&kv->lock);
+    if (kv->merging) {
+        pthread_mutex_unlock(&kv->lock);
+        return ZFO_ERR_BUSY;
+    }
+    kv->merging = true;
+    kv->merge_requested = false;
+    int rc = kv->active->size > 0 ? kv_rotate_locked(kv, 0) : ZFO_OK;
+
+    size_t count = 0;
+    kv_file_t** olds = rc == ZFO_OK ? malloc((kv->file_count + 1) * sizeof(kv_file_t*)) : NULL;
+    if (rc == ZFO_OK && !olds) rc = ZFO_ERR_NO_MEMORY;
+    if (rc == ZFO_OK) {
+        for (size_t i = 0; i < kv->file_count; i++) {
+            if (kv->files[i] == kv->active) continue;
+            ZFO_ATOMIC_ADD(&kv->files[i]->refs, 1);
+            olds[count++] = kv->files[i];
+        }
+    }
+    pthread_mutex_unlock(&kv->lock);
+
+    kv_merger_t m = { .kv = kv };
+    m.move_cap = 4096;
+    m.buf = malloc(KV_MERGE_BATCH);
+    m.moves = malloc(m.move_cap * sizeof(kv_move_t));
+    if (rc == ZFO_OK && (!m.buf || !m.moves)) rc = ZFO_ERR_NO_MEMORY;
+
+    for (size_t i = 0; i < count && rc == ZFO_OK; i++) rc = kv_merge_file(&m, olds[i]);
+    int frc = kv_merge_finish_output(&m);
+    if (rc == ZFO_OK) rc = frc;
+    if (rc == ZFO_OK && ZFO_ATOMIC_LOAD(&kv->stop)) rc = ZFO_ERR_INTERRUPTED;
+    if (rc == ZFO_OK && fsync(kv->dir_fd) != 0) rc = zfo_error_from_errno(errno);
+
+    /*
+     * Only once the copies are durable do the originals go. On failure
+     * they stay: any record already copied exists twice, with the same
+     * seq, which loading resolves either way.
+     */
+    pthread_mutex_lock(&kv->lock);
+    for (size_t i = 0; i < count; i++) {
+        kv_file_t* f = olds[i];
+        if (rc == ZFO_OK) {
+            /* Keys whose record no longer checks out can't be moved */
+            if (f->live_count > 0) kv_purge(kv, f);
+            kv->total_bytes -= f->size;
+            kv_remove_file(kv, f);
+
+            char name[KV_NAME_LEN + 1];
+            kv_name(f->id, "hint", name);
+            unlinkat(kv->dir_fd, name, 0);
+            kv_name(f->id, "data", name);
+            unlinkat(kv->dir_fd, name, 0);
+            kv_file_unref(f);
+        }
+        kv_file_unref(f);
+    }
+    if (rc == ZFO_OK) kv->merges++;
+    kv->merging = false;
+    pthread_mutex_unlock(&kv->lock);
+
+    free(olds);
+    free(m.buf);
+    free(m.moves);
+    free(m.hint);
+    return rc;
+}
+
+static bool kv_should_merge(zfo_kv_t* kv) {
+    if (kv->dead_percent > 100 || kv->merging) return false;
+    uint64_t dead = kv->total_bytes - kv->live_bytes;
+    return dead >= kv->merge_min_bytes && dead * 100 >= kv->total_bytes * kv->dead_percent;
+}
+
+static void* kv_merger(void* arg) {
+    zfo_kv_t* kv = arg;
+    pthread_mutex_lock(&kv->lock);
+    while (!kv->stop) {
+        if (!kv->merge_requested) {
+            pthread_cond_wait(&kv->wake, &kv->lock);
+            continue;
+        }
+        pthread_mutex_unlock(&kv->lock);
+        zfo_kv_merge(kv);
+        pthread_mutex_lock(&kv->lock);
+    }
+    pthread_mutex_unlock(&kv->lock);
+    return NULL;
+}
+
+/* ============================================================
+ * Public API
+ * ============================================================ */
+
+int zfo_kv_open(const char* dir, const zfo_kv_options_t* opts, zfo_kv_t** out) {
+    if (!dir || !*dir || !out) return ZFO_ERR_INVALID_ARG;
+    *out = NULL;
+
+    int rc = zfo_mkdir_p(dir, 0755);
+    if (rc != ZFO_OK) return rc;
+
+    zfo_kv_t* kv = calloc(1, sizeof(zfo_kv_t));
+    if (!kv) return ZFO_ERR_NO_MEMORY;
+    kv->dir_fd = -1;
+    kv->max_file_size = opts && opts->max_file_size ? opts->max_file_size : KV_DEFAULT_FILE;
+    kv->dead_percent = opts && opts->merge_dead_percent ? opts->merge_dead_percent : KV_DEFAULT_DEAD;
+    kv->merge_min_bytes = opts && opts->merge_min_bytes ? opts->merge_min_bytes : kv->max_file_size / 4;
+    kv->flags = opts ? opts->flags : 0;
+    kv->next_file_id = 1;
+    kv->next_seq = 1;
+    pthread_mutex_init(&kv->lock, NULL);
+    pthread_cond_init(&kv->wake, NULL);
+
+    kv->keydir = dagger_create(1024, kv_key_eq);
+    if (!kv->keydir) {
+        zfo_kv_close(kv);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    dagger_set_value_destroy(kv->keydir, free);
+
+    kv->dir_fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (kv->dir_fd < 0) {
+        rc = zfo_error_from_errno(errno);
+        kv->dir_fd = -1;
+        zfo_kv_close(kv);
+        return rc;
+    }
+
+    /* One writer per directory, in this process or any other */
+    if (flock(kv->dir_fd, LOCK_EX | LOCK_NB) != 0) {
+        rc = errno == EWOULDBLOCK ? ZFO_ERR_BUSY : zfo_error_from_errno(errno);
+        zfo_kv_close(kv);
+        return rc;
+    }
+
+    rc = kv_load(kv);
+    if (rc == ZFO_OK) rc = kv_create_file(kv, 0, &kv->active);
+    if (rc == ZFO_OK && !(kv->flags & ZFO_KV_NO_AUTO_MERGE)) {
+        if (pthread_create(&kv->thread, NULL, kv_merger, kv) != 0) {
+            rc = ZFO_ERR_UNKNOWN;
+        } else {
+            kv->thread_started = true;
+        }
+    }
+    if (rc != ZFO_OK) {
+        zfo_kv_close(kv);
+        return rc;
+    }
+    *out = kv;
+    return ZFO_OK;
+}
+
+/* Append one record to the active file (lock held) */
+static int kv_append_locked(zfo_kv_t* kv, const void* key, uint32_t key_len,
+                            const void* value, uint32_t val_len, uint64_t* offset, uint64_t* seq) {
+    uint64_t total = kv_record_total(key_len, val_len);
+    kv_file_t* f = kv->active;
+    if (f->size + total > f->alloc && f->size > 0) {
+        int rc = kv_rotate_locked(kv, total);
+        if (rc != ZFO_OK) return rc;
+        f = kv->active;
+    }
+
+    kv_record_t r = { 0, key_len, val_len, 0, kv->next_seq };
+    r.check = kv_check(&r, key, value);
+    static const char zeros[8];
+    size_t body = KV_RECORD_SIZE + key_len + (val_len == KV_TOMBSTONE ? 0 : val_len);
+    struct iovec iov[4] = {
+        { &r, sizeof(r) },
+        { (void*)key, key_len },
+        { (void*)value, val_len == KV_TOMBSTONE ? 0 : val_len },
+        { (void*)zeros, total - body }
+    };
+    int rc = kv_pwritev_all(f->fd, iov, 4, f->size);
+    if (rc == ZFO_OK && (kv->flags & ZFO_KV_SYNC) && fdatasync(f->fd) != 0) {
+        rc = zfo_error_from_errno(errno);
+    }
+    if (rc != ZFO_OK) return rc;
+
+    *offset = f->size;
+    *seq = kv->next_seq++;
+    f->size += total;
+    kv->total_bytes += total;
+    return ZFO_OK;
+}
+
+static void kv_maybe_merge(zfo_kv_t* kv) {
+    if (kv->thread_started && !kv->merge_requested && kv_should_merge(kv)) {
+        kv->merge_requested = true;
+        pthread_cond_signal(&kv->wake);
+    }
+}
+
+int zfo_kv_put(zfo_kv_t* kv, const void* key, size_t key_len, const void* value, size_t val_len) {
+    if (!kv || !key || key_len == 0 || key_len > UINT32_MAX / 2 ||
+        (!value && val_len > 0) || val_len >= KV_TOMBSTONE / 2) {
+        return ZFO_ERR_INVALID_ARG;
+    }
+
+    pthread_mutex_lock(&kv->lock);
+    uint64_t offset, seq;
+    int rc = kv_append_locked(kv, key, (uint32_t)key_len, value, (uint32_t)val_len, &offset, &seq);
+    if (rc == ZFO_OK) {
+        rc = kv_apply(kv, kv->active, offset, seq, key, (uint32_t)key_len, (uint32_t)val_len);
+        kv_maybe_merge(kv);
+    }
+    pthread_mutex_unlock(&kv->lock);
+    return rc;
+}
+
+int zfo_kv_get(zfo_kv_t* kv, const void* key, size_t key_len, void** out, size_t* out_len) {
+    if (!kv || !key || key_len == 0 || key_len > UINT32_MAX || !out || !out_len) {
+        return ZFO_ERR_INVALID_ARG;
+    }
+    *out = NULL;
+    *out_len = 0;
+
+    pthread_mutex_lock(&kv->lock);
+    kv_entry_t* e = kv_lookup(kv, key, (uint32_t)key_len);
+    if (!e) {
+        pthread_mutex_unlock(&kv->lock);
+        return ZFO_ERR_NOT_FOUND;
+    }
+    kv_file_t* f = e->file;
+    uint64_t offset = e->offset;
+    uint64_t seq = e->seq;
+    uint32_t val_len = e->val_len;
+    ZFO_ATOMIC_ADD(&f->refs, 1);
+    pthread_mutex_unlock(&kv->lock);
+
+    /* The whole record in one read, so the check covers what we return */
+    size_t len = KV_RECORD_SIZE + key_len + val_len;
+    char* buf = malloc(len);
+    if (!buf) {
+        kv_file_unref(f);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    ssize_t n;
+    do {
+        n = pread(f->fd, buf, len, (off_t)offset);
+    } while (n < 0 && errno == EINTR);
+    int rc = n < 0 ? zfo_error_from_errno(errno) : ZFO_OK;
+    kv_file_unref(f);
+
+    kv_record_t r;
+    if (rc == ZFO_OK) {
+        memcpy(&r, buf, sizeof(r));
+        if ((size_t)n != len || r.seq != seq || r.key_len != key_len || r.val_len != val_len ||
+            memcmp(buf + KV_RECORD_SIZE, key, key_len) != 0 ||
+            r.check != kv_check(&r, buf + KV_RECORD_SIZE, buf + KV_RECORD_SIZE + key_len)) {
+            rc = ZFO_ERR_IO;
+        }
+    }
+    if (rc != ZFO_OK) {
+        free(buf);
+        return rc;
+    }
+
+    memmove(buf, buf + KV_RECORD_SIZE + key_len, val_len);
+    *out = buf;
+    *out_len = val_len;
+    return ZFO_OK;
+}
+
+bool zfo_kv_has(zfo_kv_t* kv, const void* key, size_t key_len) {
+    if (!kv || !key || key_len == 0 || key_len > UINT32_MAX) return false;
+    pthread_mutex_lock(&kv->lock);
+    bool found = kv_lookup(kv, key, (uint32_t)key_len) != NULL;
+    pthread_mutex_unlock(&kv->lock);
+    return found;
+}
+
+int zfo_kv_delete(zfo_kv_t* kv, const void* key, size_t key_len) {
+    if (!kv || !key || key_len == 0 || key_len > UINT32_MAX / 2) return ZFO_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&kv->lock);
+    kv_entry_t* e = kv_lookup(kv, key, (uint32_t)key_len);
+    int rc = ZFO_ERR_NOT_FOUND;
+    if (e) {
+        uint64_t offset, seq;
+        rc = kv_append_locked(kv, key, (uint32_t)key_len, NULL, KV_TOMBSTONE, &offset, &seq);
+        if (rc == ZFO_OK) {
+            kv_drop(kv, e);
+            kv_maybe_merge(kv);
+        }
+    }
+    pthread_mutex_unlock(&kv->lock);
+    return rc;
+}
+
+typedef struct {
+    zfo_kv_key_fn fn;
+    void* userdata;
+} kv_keys_ctx_t;
+
+static int kv_visit_key(const void* key, uint32_t key_len, void* value, void* ctx) {
+    (void)value;
+    kv_keys_ctx_t* c = ctx;
+    return c->fn(key, key_len, c->userdata) ? 0 : 1;
+}
+
+size_t zfo_kv_keys(zfo_kv_t* kv, zfo_kv_key_fn fn, void* userdata) {
+    if (!kv || !fn) return 0;
+    kv_keys_ctx_t c = { fn, userdata };
+    pthread_mutex_lock(&kv->lock);
+    size_t n = dagger_foreach(kv->keydir, kv_visit_key, &c);
+    pthread_mutex_unlock(&kv->lock);
+    return n;
+}
+
+int zfo_kv_sync(zfo_kv_t* kv) {
+    if (!kv) return ZFO_ERR_INVALID_ARG;
+    pthread_mutex_lock(&kv->lock);
+    int rc = fdatasync(kv->active->fd) == 0 ? ZFO_OK : zfo_error_from_errno(errno);
+    pthread_mutex_unlock(&kv->lock);
+    return rc;
+}
+
+void zfo_kv_stats(zfo_kv_t* kv, zfo_kv_stats_t* out) {
+    if (!kv || !out) return;
+    pthread_mutex_lock(&kv->lock);
+    out->keys = kv->keydir->count;
+    out->files = kv->file_count;
+    out->total_bytes = kv->total_bytes;
+    out->live_bytes = kv->live_bytes;
+    out->merges = kv->merges;
+    out->merging = kv->merging;
+    pthread_mutex_unlock(&kv->lock);
+}
+
+int zfo_kv_close(zfo_kv_t* kv) {
+    if (!kv) return ZFO_ERR_INVALID_ARG;
+
+    /* A merge in progress stops at the next record and keeps its copies */
+    if (kv->thread_started) {
+        pthread_mutex_lock(&kv->lock);
+        ZFO_ATOMIC_STORE(&kv->stop, true);
+        pthread_cond_signal(&kv->wake);
+        pthread_mutex_unlock(&kv->lock);
+        pthread_join(kv->thread, NULL);
+    }
+
+    int rc = ZFO_OK;
+    if (kv->active) {
+        if (kv->active->size > 0) {
+            rc = kv_seal(kv->active);
+        } else {
+            char name[KV_NAME_LEN + 1];
+            kv_name(kv->active->id, "data", name);
+            unlinkat(kv->dir_fd, name, 0);
+        }
+    }
+    for (size_t i = 0; i < kv->file_count; i++) kv_file_unref(kv->files[i]);
+    free(kv->files);
+    if (kv->keydir) dagger_destroy(kv->keydir);
+    if (kv->dir_fd >= 0) close(kv->dir_fd);
+
+    pthread_cond_destroy(&kv->wake);
+    pthread_mutex_destroy(&kv->lock);
+    free(kv);
+    return rc;
+}
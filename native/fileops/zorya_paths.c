@@ -0,0 +1,598 @@
+/**
+ * @file zorya_paths.c
+ * @brief Zorya FileOps - Batched path operations and path interning
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   Lexical path work for callers that handle paths by the million.
+ *   zfo_normalize_len is a single pass over a length-delimited path
+ *   with no component limit; zfo_relative and zfo_path_batch build on
+ *   it. A batch takes NUL-separated paths in one buffer and returns
+ *   the results the same way, so the binding crosses into C once per
+ *   batch instead of once per path.
+ *
+ *   A path table interns normalized paths as nodes of a tree: each
+ *   node is (parent id, name) with the name interned in a Tablet, so a
+ *   directory shared by many paths is stored once and every path is an
+ *   integer id. Ids 0 and 1 are the roots "/" and ".".
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+#include "weave.h"
+#include "nxh.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+
+/* ============================================================
+ * Lexical Paths
+ * ============================================================ */
+
+size_t zfo_normalize_len(const char* path, size_t len, char* out) {
+    bool absolute = len > 0 && path[0] == '/';
+    size_t o = 0;
+    if (absolute) out[o++] = '/';
+
+    size_t root = o;
+    size_t floor = o;   /* ".." components before this can't be popped */
+    size_t i = 0;
+
+    while (i < len) {
+        while (i < len && path[i] == '/') i++;
+        size_t start = i;
+        while (i < len && path[i] != '/') i++;
+        size_t clen = i - start;
+
+        if (clen == 0 || (clen == 1 && path[start] == '.')) continue;
+
+        if (clen == 2 && path[start] == '.' && path[start + 1] == '.') {
+            if (o > floor) {
+                while (o > floor && out[o - 1] != '/') o--;
+                if (o > root) o--;
+            } else if (!absolute) {
+                if (o > root) out[o++] = '/';
+                out[o++] = '.';
+                out[o++] = '.';
+                floor = o;
+            }
+            continue;
+        }
+
+        if (o > root) out[o++] = '/';
+        memcpy(out + o, path + start, clen);
+        o += clen;
+    }
+
+    if (o == 0) out[o++] = '.';
+    out[o] = 0;
+    return o;
+}
+
+/* Lexically resolve path against cwd into out (cwd_len + len + 3 bytes) */
+static size_t path_absolute(const char* path, size_t len, const char* cwd, size_t cwd_len,
+                            char* scratch, char* out) {
+    if (len > 0 && path[0] == '/') return zfo_normalize_len(path, len, out);
+
+    memcpy(scratch, cwd, cwd_len);
+    scratch[cwd_len] = '/';
+    memcpy(scratch + cwd_len + 1, path, len);
+    return zfo_normalize_len(scratch, cwd_len + 1 + len, out);
+}
+
+/* Next component of a normalized path, advancing *pos past it */
+static bool path_next(const char* p, size_t len, size_t* pos, const char** comp, size_t* clen) {
+    size_t i = *pos;
+    while (i < len && p[i] == '/') i++;
+    if (i >= len) return false;
+    size_t start = i;
+    while (i < len && p[i] != '/') i++;
+    *comp = p + start;
+    *clen = i - start;
+    *pos = i;
+    return true;
+}
+
+/* Relative path between two normalized absolute paths; out needs from_len * 3 / 2 + to_len + 2 */
+static size_t path_relative(const char* from, size_t from_len, const char* to, size_t to_len, char* out) {
+    size_t pf = 0, pt = 0;
+    const char *cf, *ct = NULL;
+    size_t lf, lt = 0;
+    bool has_f, has_t;
+
+    for (;;) {
+        size_t save_t = pt;
+        has_f = path_next(from, from_len, &pf, &cf, &lf);
+        has_t = path_next(to, to_len, &pt, &ct, &lt);
+        if (!has_f || !has_t || lf != lt || memcmp(cf, ct, lf) != 0) {
+            if (has_t) pt = save_t;
+            break;
+        }
+    }
+
+    size_t o = 0;
+    while (has_f) {
+        if (o > 0) out[o++] = '/';
+        out[o++] = '.';
+        out[o++] = '.';
+        has_f = path_next(from, from_len, &pf, &cf, &lf);
+    }
+    while (path_next(to, to_len, &pt, &ct, &lt)) {
+        if (o > 0) out[o++] = '/';
+        memcpy(out + o, ct, lt);
+        o += lt;
+    }
+    out[o] = 0;
+    return o;
+}
+
+int zfo_relative(const char* from, const char* to, char* buf, size_t size) {
+    if (!from || !to || !buf || size == 0) return ZFO_ERR_INVALID_ARG;
+
+    char cwd[PATH_MAX];
+    if (!getcwd(cwd, sizeof(cwd))) return zfo_error_from_errno(errno);
+
+    size_t cwd_len = strlen(cwd);
+    size_t from_len = strlen(from);
+    size_t to_len = strlen(to);
+    size_t max_len = cwd_len + (from_len > to_len ? from_len : to_len) + 3;
+
+    /* scratch, both absolute paths, and at most 3/2 of one plus the other */
+    char* mem = malloc(max_len * 6);
+    if (!mem) return ZFO_ERR_NO_MEMORY;
+    char* scratch = mem;
+    char* a = scratch + max_len;
+    char* b = a + max_len;
+    char* out = b + max_len;
+
+    size_t a_len = path_absolute(from, from_len, cwd, cwd_len, scratch, a);
+    size_t b_len = path_absolute(to, to_len, cwd, cwd_len, scratch, b);
+    size_t out_len = path_relative(a, a_len, b, b_len, out);
+
+    int rc = ZFO_OK;
+    if (out_len < size) {
+        memcpy(buf, out, out_len + 1);
+    } else {
+        rc = ZFO_ERR_NAME_TOO_LONG;
+    }
+    free(mem);
+    return rc;
+}
+
+/* ============================================================
+ * Batches
+ * ============================================================ */
+
+typedef struct {
+    char* data;
+    size_t len;
+    size_t cap;
+} path_buf_t;
+
+static bool path_buf_reserve(path_buf_t* b, size_t extra) {
+    if (b->len + extra <= b->cap) return true;
+    size_t cap = b->cap ? b->cap : 4096;
+    while (cap < b->len + extra) cap *= 2;
+    char* data = realloc(b->data, cap);
+    if (!data) return false;
+    b->data = data;
+    b->cap = cap;
+    return true;
+}
+
+static bool path_scratch(char** scratch, size_t* cap, size_t need) {
+    if (need <= *cap) return true;
+    size_t n = *cap ? *cap : 4096;
+    while (n < need) n *= 2;
+    char* p = realloc(*scratch, n);
+    if (!p) return false;
+    *scratch = p;
+    *cap = n;
+    return true;
+}
+
+int zfo_path_batch(zfo_path_op_t op, const char* base, const char* in, size_t in_len,
+                   char** out, size_t* out_len, size_t* out_count) {
+    if ((!in && in_len > 0) || !out || !out_len) return ZFO_ERR_INVALID_ARG;
+    if (op == ZFO_PATH_JOIN && !base) return ZFO_ERR_INVALID_ARG;
+
+    *out = NULL;
+    *out_len = 0;
+    if (out_count) *out_count = 0;
+
+    char cwd[PATH_MAX];
+    size_t cwd_len = 0;
+    if (op == ZFO_PATH_RELATIVE) {
+        if (!getcwd(cwd, sizeof(cwd))) return zfo_error_from_errno(errno);
+        cwd_len = strlen(cwd);
+    }
+
+    size_t base_len = base ? strlen(base) : 0;
+    path_buf_t result = {0};
+    char* scratch = NULL;
+    size_t scratch_cap = 0;
+    char* from = NULL;
+    size_t from_len = 0;
+    size_t count = 0;
+    int rc = ZFO_OK;
+
+    if (op == ZFO_PATH_RELATIVE) {
+        /* Resolve the common starting point once */
+        const char* f = base ? base : ".";
+        size_t fl = base ? base_len : 1;
+        from = malloc(cwd_len * 2 + fl * 2 + 6);
+        if (!from) return ZFO_ERR_NO_MEMORY;
+        from_len = path_absolute(f, fl, cwd, cwd_len, from + cwd_len + fl + 3, from);
+    }
+
+    size_t pos = 0;
+    while (pos < in_len) {
+        const char* p = in + pos;
+        const char* end = memchr(p, 0, in_len - pos);
+        size_t len = end ? (size_t)(end - p) : in_len - pos;
+        pos += len + 1;
+
+        /* Worst case: base + '/' + path, or ".." per component of from */
+        size_t need = base_len + cwd_len + len + 4;
+        if (op == ZFO_PATH_RELATIVE) need = need * 2 + from_len * 3 / 2 + 2;
+        if (!path_scratch(&scratch, &scratch_cap, need * 2) ||
+            !path_buf_reserve(&result, need + 1)) {
+            rc = ZFO_ERR_NO_MEMORY;
+            break;
+        }
+        char* dst = result.data + result.len;
+        size_t n = 0;
+
+        switch (op) {
+        case ZFO_PATH_NORMALIZE:
+            n = zfo_normalize_len(p, len, dst);
+            break;
+
+        case ZFO_PATH_JOIN:
+            if (len > 0 && p[0] == '/') {
+                memcpy(dst, p, len);
+                n = len;
+            } else {
+                memcpy(dst, base, base_len);
+                n = base_len;
+                if (base_len > 0 && base[base_len - 1] != '/') dst[n++] = '/';
+                memcpy(dst + n, p, len);
+                n += len;
+            }
+            dst[n] = 0;
+            break;
+
+        case ZFO_PATH_RELATIVE: {
+            char* abs = scratch + need;
+            size_t abs_len = path_absolute(p, len, cwd, cwd_len, scratch, abs);
+            n = path_relative(from, from_len, abs, abs_len, dst);
+            break;
+        }
+
+        case ZFO_PATH_RESOLVE: {
+            /* Filesystem resolution like zfo_realpath; failures come back empty */
+            char* joined = scratch;
+            if (base && !(len > 0 && p[0] == '/')) {
+                memcpy(joined, base, base_len);
+                size_t j = base_len;
+                if (base_len > 0 && base[base_len - 1] != '/') joined[j++] = '/';
+                memcpy(joined + j, p, len);
+                joined[j + len] = 0;
+            } else {
+                memcpy(joined, p, len);
+                joined[len] = 0;
+            }
+            char* real = realpath(joined, NULL);
+            if (real) {
+                n = strlen(real);
+                if (!path_buf_reserve(&result, n + 1)) {
+                    free(real);
+                    rc = ZFO_ERR_NO_MEMORY;
+                    break;
+                }
+                dst = result.data + result.len;
+                memcpy(dst, real, n + 1);
+                free(real);
+            } else {
+                dst[0] = 0;
+            }
+            break;
+        }
+
+        default:
+            rc = ZFO_ERR_INVALID_ARG;
+            break;
+        }
+        if (rc != ZFO_OK) break;
+
+        result.len += n + 1;
+        count++;
+    }
+
+    free(scratch);
+    free(from);
+    if (rc != ZFO_OK) {
+        free(result.data);
+        return rc;
+    }
+
+    *out = result.data;
+    *out_len = result.len;
+    if (out_count) *out_count = count;
+    return ZFO_OK;
+}
+
+/* ============================================================
+ * Path Table
+ * ============================================================ */
+
+#define PATH_ROOT_ABS 0u
+#define PATH_ROOT_REL 1u
+
+/* One directory of the last interned path: where it ends and its id */
+typedef struct {
+    size_t end;
+    uint32_t id;
+} path_step_t;
+
+struct zfo_path_table {
+    Tablet* names;
+    uint32_t* parent;
+    const Weave** name;
+    uint32_t* hash;
+    uint32_t count;
+    uint32_t cap;
+
+    /* Open addressing over (parent, name); 0 marks a free slot */
+    uint32_t* slots;
+    uint32_t mask;
+
+    /* Directories of the last path, so the next one skips the shared prefix */
+    char* last_dir;
+    size_t last_dir_len;
+    size_t last_dir_cap;
+    path_step_t* steps;
+    size_t step_count;
+    size_t step_cap;
+
+    char* scratch;
+    size_t scratch_cap;
+};
+
+static inline uint32_t path_node_hash(uint32_t parent, const char* name, size_t len) {
+    return (uint32_t)nxh64(name, len, NXH_SEED_DEFAULT ^ parent);
+}
+
+static bool path_table_rehash(zfo_path_table_t* T, uint32_t slots) {
+    uint32_t* table = calloc(slots, sizeof(uint32_t));
+    if (!table) return false;
+    uint32_t mask = slots - 1;
+    for (uint32_t id = 2; id < T->count; id++) {
+        uint32_t i = T->hash[id] & mask;
+        while (table[i]) i = (i + 1) & mask;
+        table[i] = id;
+    }
+    free(T->slots);
+    T->slots = table;
+    T->mask = mask;
+    return true;
+}
+
+static bool path_table_grow(zfo_path_table_t* T) {
+    uint32_t cap = T->cap * 2;
+    uint32_t* parent = realloc(T->parent, cap * sizeof(uint32_t));
+    if (!parent) return false;
+    T->parent = parent;
+    uint32_t* hash = realloc(T->hash, cap * sizeof(uint32_t));
+    if (!hash) return false;
+    T->hash = hash;
+    const Weave** name = realloc(T->name, cap * sizeof(const Weave*));
+    if (!name) return false;
+    T->name = name;
+    T->cap = cap;
+    return true;
+}
+
+zfo_path_table_t* zfo_path_table_create(void) {
+    zfo_path_table_t* T = calloc(1, sizeof(zfo_path_table_t));
+    if (!T) return NULL;
+
+    T->names = tablet_create();
+    T->cap = 256;
+    T->parent = malloc(T->cap * sizeof(uint32_t));
+    T->hash = malloc(T->cap * sizeof(uint32_t));
+    T->name = malloc(T->cap * sizeof(const Weave*));
+    if (!T->names || !T->parent || !T->hash || !T->name || !path_table_rehash(T, 512)) {
+        zfo_path_table_destroy(T);
+        return NULL;
+    }
+
+    T->parent[PATH_ROOT_ABS] = PATH_ROOT_ABS;
+    T->parent[PATH_ROOT_REL] = PATH_ROOT_REL;
+    T->name[PATH_ROOT_ABS] = NULL;
+    T->name[PATH_ROOT_REL] = NULL;
+    T->count = 2;
+    return T;
+}
+
+void zfo_path_table_destroy(zfo_path_table_t* T) {
+    if (!T) return;
+    tablet_destroy(T->names);
+    free(T->parent);
+    free(T->hash);
+    free(T->name);
+    free(T->slots);
+    free(T->last_dir);
+    free(T->steps);
+    free(T->scratch);
+    free(T);
+}
+
+/* Find or add the child of parent called comp; names are interned only when added */
+static int path_table_child(zfo_path_table_t* T, uint32_t parent, const char* comp, size_t len,
+                            uint32_t* out) {
+    uint32_t h = path_node_hash(parent, comp, len);
+    uint32_t i = h & T->mask;
+    while (T->slots[i]) {
+        uint32_t id = T->slots[i];
+        if (T->hash[id] == h && T->parent[id] == parent &&
+            weave_len(T->name[id]) == len && memcmp(weave_cstr(T->name[id]), comp, len) == 0) {
+            *out = id;
+            return ZFO_OK;
+        }
+        i = (i + 1) & T->mask;
+    }
+
+    if (T->count == UINT32_MAX) return ZFO_ERR_NO_MEMORY;
+    if (T->count == T->cap && !path_table_grow(T)) return ZFO_ERR_NO_MEMORY;
+    const Weave* name = tablet_intern_len(T->names, comp, len);
+    if (!name) return ZFO_ERR_NO_MEMORY;
+
+    uint32_t id = T->count++;
+    T->parent[id] = parent;
+    T->name[id] = name;
+    T->hash[id] = h;
+    T->slots[i] = id;
+
+    /* Keep the table at most half full */
+    if ((uint64_t)(T->count - 2) * 2 > T->mask) {
+        if (!path_table_rehash(T, (T->mask + 1) * 2)) return ZFO_ERR_NO_MEMORY;
+    }
+
+    *out = id;
+    return ZFO_OK;
+}
+
+int zfo_path_table_intern(zfo_path_table_t* T, const char* path, size_t len, uint32_t* out_id) {
+    if (!T || (!path && len > 0) || !out_id) return ZFO_ERR_INVALID_ARG;
+
+    if (!path_scratch(&T->scratch, &T->scratch_cap, len + 2)) return ZFO_ERR_NO_MEMORY;
+    char* norm = T->scratch;
+    size_t n = zfo_normalize_len(path, len, norm);
+    if (n == 1 && norm[0] == '.') {
+        *out_id = PATH_ROOT_REL;
+        return ZFO_OK;
+    }
+
+    char* slash = memrchr(norm, '/', n);
+    size_t dir_len = slash ? (size_t)(slash - norm) : 0;
+
+    /* Resume from the deepest directory shared with the last path */
+    size_t common = 0;
+    size_t limit = dir_len < T->last_dir_len ? dir_len : T->last_dir_len;
+    while (common < limit && norm[common] == T->last_dir[common]) common++;
+
+    size_t keep = T->step_count;
+    while (keep > 0 && !(T->steps[keep - 1].end <= common && norm[T->steps[keep - 1].end] == '/')) keep--;
+
+    uint32_t cur = norm[0] == '/' ? PATH_ROOT_ABS : PATH_ROOT_REL;
+    size_t pos = 0;
+    if (keep > 0) {
+        cur = T->steps[keep - 1].id;
+        pos = T->steps[keep - 1].end;
+    }
+    T->step_count = keep;
+
+    const char* comp;
+    size_t clen;
+    while (path_next(norm, n, &pos, &comp, &clen)) {
+        int rc = path_table_child(T, cur, comp, clen, &cur);
+        if (rc != ZFO_OK) return rc;
+        if (pos > dir_len) break;
+
+        if (T->step_count == T->step_cap) {
+            size_t cap = T->step_cap ? T->step_cap * 2 : 32;
+            path_step_t* steps = realloc(T->steps, cap * sizeof(path_step_t));
+            if (!steps) return ZFO_ERR_NO_MEMORY;
+            T->steps = steps;
+            T->step_cap = cap;
+        }
+        T->steps[T->step_count].end = pos;
+        T->steps[T->step_count].id = cur;
+        T->step_count++;
+    }
+
+    if (!path_scratch(&T->last_dir, &T->last_dir_cap, dir_len + 1)) {
+        T->last_dir_len = 0;
+        T->step_count = 0;
+    } else {
+        memcpy(T->last_dir + common, norm + common, dir_len - common);
+        T->last_dir_len = dir_len;
+    }
+
+    *out_id = cur;
+    return ZFO_OK;
+}
+
+size_t zfo_path_table_get(const zfo_path_table_t* T, uint32_t id, char* buf, size_t size) {
+    if (!T || id >= T->count) return 0;
+    if (id == PATH_ROOT_ABS || id == PATH_ROOT_REL) {
+        if (size > 1) {
+            buf[0] = id == PATH_ROOT_ABS ? '/' : '.';
+            buf[1] = 0;
+        }
+        return 1;
+    }
+
+    /* Measure, then fill from the end */
+    size_t total = 0;
+    uint32_t cur = id;
+    while (cur > PATH_ROOT_REL) {
+        total += weave_len(T->name[cur]) + 1;
+        cur = T->parent[cur];
+    }
+    bool absolute = cur == PATH_ROOT_ABS;
+    if (!absolute) total--;
+
+    if (total < size) {
+        size_t end = total;
+        buf[end] = 0;
+        cur = id;
+        while (cur > PATH_ROOT_REL) {
+            size_t len = weave_len(T->name[cur]);
+            end -= len;
+            memcpy(buf + end, weave_cstr(T->name[cur]), len);
+            cur = T->parent[cur];
+            if (end > 0) buf[--end] = '/';
+        }
+    }
+    return total;
+}
+
+uint32_t zfo_path_table_parent(const zfo_path_table_t* T, uint32_t id) {
+    if (!T || id >= T->count) return UINT32_MAX;
+    return T->parent[id];
+}
+
+const char* zfo_path_table_name(const zfo_path_table_t* T, uint32_t id, size_t* len) {
+    if (!T || id >= T->count) return NULL;
+    if (id == PATH_ROOT_ABS || id == PATH_ROOT_REL) {
+        if (len) *len = id == PATH_ROOT_ABS ? 0 : 1;
+        return id == PATH_ROOT_ABS ? "" : ".";
+    }
+    if (len) *len = weave_len(T->name[id]);
+    return weave_cstr(T->name[id]);
+}
+
+void zfo_path_table_stats(const zfo_path_table_t* T, zfo_path_table_stats_t* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!T) return;
+    out->paths = T->count;
+    out->names = tablet_count(T->names);
+    out->bytes = tablet_memory(T->names) +
+                 (size_t)T->cap * (sizeof(uint32_t) + sizeof(const Weave*)) +
+                 (size_t)(T->mask + 1) * sizeof(uint32_t);
+}
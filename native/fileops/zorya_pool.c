@@ -0,0 +1,358 @@
+/**
+ * @file zorya_pool.c
+ * @brief Zorya FileOps - Work-stealing thread pool
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   Each worker owns a deque. Tasks submitted from a worker go to the
+ *   bottom of its own deque and are popped LIFO, so a tree traversal
+ *   runs depth-first per worker and keeps few directories open. Idle
+ *   workers steal from the top (oldest, usually largest subtree) of
+ *   other deques. Deques are mutex-protected rings; tasks are coarse
+ *   (a directory or a batch of files), so lock cost is negligible.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/time.h>
+
+#define ZFO_POOL_MAX_THREADS 64
+#define ZFO_POOL_DEQUE_INITIAL 64
+
+/* ============================================================
+ * Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    zfo_task_fn fn;
+    void* arg;
+} pool_task_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pool_task_t* ring;
+    size_t cap;             /* Power of two */
+    size_t head;            /* Steal end (oldest) */
+    size_t tail;            /* Owner end (newest) */
+} pool_deque_t;
+
+typedef struct {
+    zfo_pool_t* pool;
+    int index;
+    pthread_t thread;
+} pool_worker_t;
+
+struct zfo_pool {
+    int nthreads;
+    int ndeques;
+    pool_worker_t* workers;
+    pool_deque_t* deques;   /* nthreads + 1; last is the external inbox */
+
+    pthread_mutex_t lock;
+    pthread_cond_t work_cv;
+    pthread_cond_t done_cv;
+
+    size_t queued;          /* Tasks sitting in deques (atomic) */
+    size_t pending;         /* Submitted and not yet finished (atomic) */
+    int sleepers;           /* Workers blocked on work_cv (atomic) */
+    int notified;           /* Waiter wake-up requested (under lock) */
+    int cancelled;          /* atomic */
+    int shutdown;           /* under lock */
+};
+
+/* ============================================================
+ * Deque
+ * ============================================================ */
+
+static int deque_init(pool_deque_t* dq) {
+    dq->ring = malloc(ZFO_POOL_DEQUE_INITIAL * sizeof(pool_task_t));
+    if (!dq->ring) return ZFO_ERR_NO_MEMORY;
+    dq->cap = ZFO_POOL_DEQUE_INITIAL;
+    dq->head = dq->tail = 0;
+    pthread_mutex_init(&dq->lock, NULL);
+    return ZFO_OK;
+}
+
+static void deque_free(pool_deque_t* dq) {
+    pthread_mutex_destroy(&dq->lock);
+    free(dq->ring);
+}
+
+static int deque_push(pool_deque_t* dq, pool_task_t task) {
+    pthread_mutex_lock(&dq->lock);
+
+    if (dq->tail - dq->head == dq->cap) {
+        size_t ncap = dq->cap * 2;
+        pool_task_t* nring = malloc(ncap * sizeof(pool_task_t));
+        if (!nring) {
+            pthread_mutex_unlock(&dq->lock);
+            return ZFO_ERR_NO_MEMORY;
+        }
+        for (size_t i = dq->head; i != dq->tail; i++) {
+            nring[i & (ncap - 1)] = dq->ring[i & (dq->cap - 1)];
+        }
+        free(dq->ring);
+        dq->ring = nring;
+        dq->cap = ncap;
+    }
+
+    dq->ring[dq->tail & (dq->cap - 1)] = task;
+    dq->tail++;
+
+    pthread_mutex_unlock(&dq->lock);
+    return ZFO_OK;
+}
+
+static bool deque_pop(pool_deque_t* dq, pool_task_t* out) {
+    bool ok = false;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->tail != dq->head) {
+        dq->tail--;
+        *out = dq->ring[dq->tail & (dq->cap - 1)];
+        ok = true;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return ok;
+}
+
+static bool deque_steal(pool_deque_t* dq, pool_task_t* out) {
+    bool ok = false;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->tail != dq->head) {
+        *out = dq->ring[dq->head & (dq->cap - 1)];
+        dq->head++;
+        ok = true;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return ok;
+}
+
+/* ============================================================
+ * Workers
+ * ============================================================ */
+
+static bool pool_take(zfo_pool_t* pool, int self, pool_task_t* task) {
+    if (deque_pop(&pool->deques[self], task)) return true;
+
+    /* Inbox first (tasks from outside), then the other workers */
+    int n = pool->nthreads;
+    if (deque_steal(&pool->deques[n], task)) return true;
+
+    for (int i = 1; i < n; i++) {
+        int victim = (self + i) % n;
+        if (deque_steal(&pool->deques[victim], task)) return true;
+    }
+    return false;
+}
+
+static void task_finished(zfo_pool_t* pool) {
+    if (ZFO_ATOMIC_SUB(&pool->pending, 1) == 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->done_cv);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static void* worker_main(void* arg) {
+    pool_worker_t* w = arg;
+    zfo_pool_t* pool = w->pool;
+    pool_task_t task;
+
+    for (;;) {
+        if (pool_take(pool, w->index, &task)) {
+            ZFO_ATOMIC_SUB(&pool->queued, 1);
+            task.fn(pool, w->index, task.arg);
+            task_finished(pool);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        ZFO_ATOMIC_ADD(&pool->sleepers, 1);
+        while (ZFO_ATOMIC_LOAD(&pool->queued) == 0 && !pool->shutdown) {
+            pthread_cond_wait(&pool->work_cv, &pool->lock);
+        }
+        ZFO_ATOMIC_SUB(&pool->sleepers, 1);
+        int stop = pool->shutdown && ZFO_ATOMIC_LOAD(&pool->queued) == 0;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (stop) break;
+    }
+
+    return NULL;
+}
+
+/* ============================================================
+ * Public (internal) API
+ * ============================================================ */
+
+int zfo_thread_count(int requested) {
+    if (requested <= 0) {
+        long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        requested = ncpu > 0 ? (int)ncpu : 4;
+    }
+    return requested > ZFO_POOL_MAX_THREADS ? ZFO_POOL_MAX_THREADS : requested;
+}
+
+zfo_pool_t* zfo_pool_create(int threads) {
+    threads = zfo_thread_count(threads);
+
+    zfo_pool_t* pool = calloc(1, sizeof(zfo_pool_t));
+    if (!pool) return NULL;
+
+    pool->nthreads = threads;
+    pool->workers = calloc(threads, sizeof(pool_worker_t));
+    pool->deques = calloc(threads + 1, sizeof(pool_deque_t));
+    if (!pool->workers || !pool->deques) goto fail;
+
+    for (int i = 0; i <= threads; i++) {
+        if (deque_init(&pool->deques[i]) != ZFO_OK) {
+            for (int j = 0; j < i; j++) deque_free(&pool->deques[j]);
+            goto fail;
+        }
+    }
+    pool->ndeques = threads + 1;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cv, NULL);
+    pthread_cond_init(&pool->done_cv, NULL);
+
+    for (int i = 0; i < threads; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+        if (pthread_create(&pool->workers[i].thread, NULL, worker_main, &pool->workers[i]) != 0) {
+            /* Run with however many workers we managed to start */
+            pool->nthreads = i;
+            break;
+        }
+    }
+
+    if (pool->nthreads == 0) {
+        zfo_pool_destroy(pool);
+        return NULL;
+    }
+
+    return pool;
+
+fail:
+    free(pool->workers);
+    free(pool->deques);
+    free(pool);
+    return NULL;
+}
+
+int zfo_pool_submit(zfo_pool_t* pool, int worker, zfo_task_fn fn, void* arg) {
+    if (!pool || !fn) return ZFO_ERR_INVALID_ARG;
+
+    int dq = (worker >= 0 && worker < pool->nthreads) ? worker : pool->nthreads;
+    pool_task_t task = { fn, arg };
+
+    ZFO_ATOMIC_ADD(&pool->pending, 1);
+    if (deque_push(&pool->deques[dq], task) != ZFO_OK) {
+        task_finished(pool);
+        return ZFO_ERR_NO_MEMORY;
+    }
+
+    ZFO_ATOMIC_ADD(&pool->queued, 1);
+    if (ZFO_ATOMIC_LOAD(&pool->sleepers) > 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_signal(&pool->work_cv);
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    return ZFO_OK;
+}
+
+void zfo_pool_wait(zfo_pool_t* pool, uint32_t tick_ms, zfo_pool_tick_fn tick, void* ctx) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    while (ZFO_ATOMIC_LOAD(&pool->pending) > 0) {
+        if (!tick || tick_ms == 0) {
+            pthread_cond_wait(&pool->done_cv, &pool->lock);
+            continue;
+        }
+
+        struct timeval now;
+        gettimeofday(&now, NULL);
+        uint64_t ns = (uint64_t)now.tv_usec * 1000 + (uint64_t)tick_ms * 1000000;
+        struct timespec deadline = {
+            .tv_sec = now.tv_sec + (time_t)(ns / 1000000000),
+            .tv_nsec = (long)(ns % 1000000000)
+        };
+
+        while (ZFO_ATOMIC_LOAD(&pool->pending) > 0 && !pool->notified) {
+            if (pthread_cond_timedwait(&pool->done_cv, &pool->lock, &deadline) == ETIMEDOUT) break;
+        }
+        pool->notified = 0;
+        if (ZFO_ATOMIC_LOAD(&pool->pending) == 0) break;
+
+        /* Run the tick unlocked: it may call back into JavaScript */
+        pthread_mutex_unlock(&pool->lock);
+        if (!tick(ctx)) zfo_pool_cancel(pool);
+        pthread_mutex_lock(&pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    /* Final tick so consumers see everything produced (too late to cancel) */
+    if (tick && tick_ms > 0) tick(ctx);
+}
+
+void zfo_pool_notify(zfo_pool_t* pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->notified = 1;
+    pthread_cond_broadcast(&pool->done_cv);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void zfo_pool_cancel(zfo_pool_t* pool) {
+    if (pool) ZFO_ATOMIC_STORE(&pool->cancelled, 1);
+}
+
+bool zfo_pool_cancelled(const zfo_pool_t* pool) {
+    return pool && __atomic_load_n(&pool->cancelled, __ATOMIC_RELAXED) != 0;
+}
+
+int zfo_pool_size(const zfo_pool_t* pool) {
+    return pool ? pool->nthreads : 0;
+}
+
+void zfo_pool_destroy(zfo_pool_t* pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work_cv);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->nthreads; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    for (int i = 0; i < pool->ndeques; i++) {
+        deque_free(&pool->deques[i]);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->work_cv);
+    pthread_cond_destroy(&pool->done_cv);
+
+    free(pool->workers);
+    free(pool->deques);
+    free(pool);
+}
@@ -0,0 +1,383 @@
+/**
+ * @file zorya_search.c
+ * @brief Zorya FileOps - Parallel content search
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   Walks a tree with the glob walker and searches every file as its
+ *   own task on the same work-stealing pool, so one huge directory
+ *   still spreads across all workers. Small files are pread into a
+ *   per-worker buffer; large ones are mapped read-only.
+ *
+ *   Each pattern keeps the offset of its next hit, so with several
+ *   patterns every one of them scans the file once rather than once
+ *   per matching line. Case-sensitive patterns use memmem; the
+ *   case-insensitive path jumps between candidates with memchr on
+ *   both cases of the first byte.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#define SEARCH_BINARY_PROBE     8192
+#define SEARCH_MMAP_THRESHOLD   (256 * 1024)
+#define SEARCH_NO_HIT           SIZE_MAX
+#define SEARCH_UNKNOWN          (SIZE_MAX - 1)
+
+/* ============================================================
+ * Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    const char* text;
+    size_t len;
+    unsigned char first_lo;
+    unsigned char first_up;
+} search_pat_t;
+
+typedef struct {
+    char* buf;
+    size_t cap;
+    size_t* next;                   /* Per-pattern offset of the next hit */
+} search_worker_t;
+
+typedef struct {
+    zfo_pool_t* pool;
+    const zfo_search_options_t* opts;
+    search_pat_t* pats;
+    size_t npats;
+    size_t mmap_threshold;
+    bool nocase;
+
+    search_worker_t* workers;
+    int nworkers;
+
+    uint64_t files_searched;        /* Counters are atomic */
+    uint64_t files_matched;
+    uint64_t files_binary;
+    uint64_t files_unreadable;
+    uint64_t bytes_searched;
+    uint64_t matches;
+    int limit_reached;
+} search_ctx_t;
+
+typedef struct {
+    search_ctx_t* ctx;
+    size_t path_len;
+    char path[];
+} search_file_t;
+
+/* ============================================================
+ * Kernels
+ * ============================================================ */
+
+static bool casecmp_eq(const char* a, const char* b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (tolower((unsigned char)a[i]) != tolower((unsigned char)b[i])) return false;
+    }
+    return true;
+}
+
+static const char* find_nocase(const search_pat_t* p, const char* hay, size_t n) {
+    if (p->len > n) return NULL;
+    size_t limit = n - p->len + 1;
+    size_t i = 0;
+
+    while (i < limit) {
+        const char* a = memchr(hay + i, p->first_lo, limit - i);
+        const char* c = a;
+        if (p->first_up != p->first_lo) {
+            size_t span = (a ? (size_t)(a - hay) : limit) - i;
+            const char* b = memchr(hay + i, p->first_up, span);
+            if (b) c = b;
+        }
+        if (!c) return NULL;
+        if (casecmp_eq(c, p->text, p->len)) return c;
+        i = (size_t)(c - hay) + 1;
+    }
+    return NULL;
+}
+
+/* Offset of the pattern's first hit at or after from, or SEARCH_NO_HIT */
+static size_t pat_find(const search_ctx_t* ctx, const search_pat_t* p,
+                       const char* data, size_t n, size_t from) {
+    const char* hit = ctx->nocase ? find_nocase(p, data + from, n - from)
+                                  : memmem(data + from, n - from, p->text, p->len);
+    return hit ? (size_t)(hit - data) : SEARCH_NO_HIT;
+}
+
+static size_t count_lines(const char* data, size_t from, size_t to) {
+    size_t lines = 0;
+    const char* p = data + from;
+    const char* end = data + to;
+    while (p < end && (p = memchr(p, '\n', (size_t)(end - p))) != NULL) {
+        lines++;
+        p++;
+    }
+    return lines;
+}
+
+/* ============================================================
+ * File Search
+ * ============================================================ */
+
+/* Report every matching line; returns false once the search must stop */
+static bool search_buffer(search_ctx_t* ctx, int worker, const search_file_t* file,
+                          const char* data, size_t n) {
+    const zfo_search_options_t* opts = ctx->opts;
+    size_t* next = ctx->workers[worker].next;
+    for (size_t i = 0; i < ctx->npats; i++) next[i] = SEARCH_UNKNOWN;
+
+    size_t pos = 0, counted = 0;
+    uint64_t line = 1;
+    bool matched = false;
+
+    while (pos < n) {
+        size_t best = SEARCH_NO_HIT;
+        uint32_t best_pat = 0;
+        for (size_t i = 0; i < ctx->npats; i++) {
+            if (next[i] == SEARCH_UNKNOWN || next[i] < pos) {
+                next[i] = pat_find(ctx, &ctx->pats[i], data, n, pos);
+            }
+            if (next[i] < best) {
+                best = next[i];
+                best_pat = (uint32_t)i;
+            }
+        }
+        if (best == SEARCH_NO_HIT) break;
+
+        const char* nl = best > pos ? memrchr(data + pos, '\n', best - pos) : NULL;
+        size_t start = nl ? (size_t)(nl - data) + 1 : pos;
+        const char* eol = memchr(data + best, '\n', n - best);
+        size_t end = eol ? (size_t)(eol - data) : n;
+
+        line += count_lines(data, counted, start);
+        counted = start;
+        if (!matched) {
+            matched = true;
+            ZFO_ATOMIC_ADD(&ctx->files_matched, 1);
+        }
+
+        uint64_t seq = ZFO_ATOMIC_ADD(&ctx->matches, 1);
+        if (opts->max_matches > 0 && seq > opts->max_matches) {
+            ZFO_ATOMIC_STORE(&ctx->limit_reached, 1);
+            zfo_pool_cancel(ctx->pool);
+            return false;
+        }
+
+        if (opts->on_match) {
+            size_t text_len = end - start;
+            if (text_len > 0 && data[start + text_len - 1] == '\r') text_len--;
+            if (opts->max_line_len > 0 && text_len > opts->max_line_len) {
+                text_len = opts->max_line_len;
+            }
+            zfo_search_match_t m = {
+                .path = file->path,
+                .path_len = file->path_len,
+                .line = line,
+                .column = best - start + 1,
+                .text = data + start,
+                .text_len = text_len,
+                .pattern = best_pat,
+                .worker = worker
+            };
+            if (opts->on_match(&m, opts->userdata) == ZFO_WALK_STOP) {
+                zfo_pool_cancel(ctx->pool);
+                return false;
+            }
+        }
+
+        if (opts->max_matches > 0 && seq == opts->max_matches) {
+            ZFO_ATOMIC_STORE(&ctx->limit_reached, 1);
+            zfo_pool_cancel(ctx->pool);
+            return false;
+        }
+        pos = end + 1;
+    }
+    return true;
+}
+
+static bool search_is_binary(const char* data, size_t n) {
+    return memchr(data, 0, n < SEARCH_BINARY_PROBE ? n : SEARCH_BINARY_PROBE) != NULL;
+}
+
+static void search_fd(search_ctx_t* ctx, int worker, const search_file_t* file, int fd) {
+    const zfo_search_options_t* opts = ctx->opts;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) return;
+
+    size_t size = (size_t)st.st_size;
+    if (opts->max_file_size > 0 && (uint64_t)size > opts->max_file_size) return;
+    ZFO_ATOMIC_ADD(&ctx->files_searched, 1);
+    if (size == 0) return;
+
+    if (size >= ctx->mmap_threshold) {
+        void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            ZFO_ATOMIC_ADD(&ctx->files_unreadable, 1);
+            return;
+        }
+        madvise(map, size, MADV_SEQUENTIAL);
+        if (!(opts->flags & ZFO_SEARCH_BINARY) && search_is_binary(map, size)) {
+            ZFO_ATOMIC_ADD(&ctx->files_binary, 1);
+        } else {
+            ZFO_ATOMIC_ADD(&ctx->bytes_searched, size);
+            search_buffer(ctx, worker, file, map, size);
+        }
+        munmap(map, size);
+        return;
+    }
+
+    search_worker_t* w = &ctx->workers[worker];
+    if (w->cap < size) {
+        char* nbuf = realloc(w->buf, size);
+        if (!nbuf) {
+            ZFO_ATOMIC_ADD(&ctx->files_unreadable, 1);
+            return;
+        }
+        w->buf = nbuf;
+        w->cap = size;
+    }
+
+    size_t got = 0;
+    while (got < size) {
+        ssize_t r = pread(fd, w->buf + got, size - got, (off_t)got);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) break;
+        got += (size_t)r;
+    }
+
+    if (!(opts->flags & ZFO_SEARCH_BINARY) && search_is_binary(w->buf, got)) {
+        ZFO_ATOMIC_ADD(&ctx->files_binary, 1);
+        return;
+    }
+    ZFO_ATOMIC_ADD(&ctx->bytes_searched, got);
+    search_buffer(ctx, worker, file, w->buf, got);
+}
+
+static void search_file_task(zfo_pool_t* pool, int worker, void* arg) {
+    search_file_t* file = arg;
+    search_ctx_t* ctx = file->ctx;
+
+    if (!zfo_pool_cancelled(pool)) {
+        int fd = open(file->path, O_RDONLY | O_CLOEXEC | O_NOCTTY);
+        if (fd < 0) {
+            ZFO_ATOMIC_ADD(&ctx->files_unreadable, 1);
+        } else {
+            search_fd(ctx, worker, file, fd);
+            close(fd);
+        }
+    }
+    free(file);
+}
+
+/* Runs inside the walk; queues the file on the caller's worker */
+static int search_visit(const zfo_walk_entry_t* entry, void* userdata) {
+    search_ctx_t* ctx = userdata;
+    if (entry->type != ZFO_TYPE_FILE) return ZFO_WALK_CONTINUE;
+
+    search_file_t* file = malloc(sizeof(search_file_t) + entry->path_len + 1);
+    if (!file) return ZFO_WALK_STOP;
+    file->ctx = ctx;
+    file->path_len = entry->path_len;
+    memcpy(file->path, entry->path, entry->path_len + 1);
+
+    if (zfo_pool_submit(ctx->pool, entry->worker, search_file_task, file) != ZFO_OK) {
+        search_file_task(ctx->pool, entry->worker, file);
+    }
+    return ZFO_WALK_CONTINUE;
+}
+
+/* ============================================================
+ * Public API
+ * ============================================================ */
+
+int zfo_search(const char* root, const char* const* patterns, size_t count,
+               const zfo_search_options_t* opts, zfo_search_result_t* result) {
+    if (!root || !patterns || count == 0 || !opts) return ZFO_ERR_INVALID_ARG;
+    if (result) memset(result, 0, sizeof(*result));
+
+    search_ctx_t ctx = {0};
+    ctx.opts = opts;
+    ctx.nocase = (opts->flags & ZFO_SEARCH_NOCASE) != 0;
+    ctx.mmap_threshold = opts->mmap_threshold > 0 ? opts->mmap_threshold : SEARCH_MMAP_THRESHOLD;
+
+    ctx.pats = calloc(count, sizeof(search_pat_t));
+    if (!ctx.pats) return ZFO_ERR_NO_MEMORY;
+    for (size_t i = 0; i < count; i++) {
+        if (!patterns[i] || !patterns[i][0]) continue;
+        search_pat_t* p = &ctx.pats[ctx.npats++];
+        p->text = patterns[i];
+        p->len = strlen(patterns[i]);
+        p->first_lo = (unsigned char)patterns[i][0];
+        p->first_up = p->first_lo;
+        if (ctx.nocase) {
+            p->first_lo = (unsigned char)tolower(p->first_lo);
+            p->first_up = (unsigned char)toupper(p->first_lo);
+        }
+    }
+    if (ctx.npats == 0) {
+        free(ctx.pats);
+        return ZFO_ERR_INVALID_ARG;
+    }
+
+    int rc = ZFO_ERR_NO_MEMORY;
+    ctx.pool = zfo_pool_create(opts->files.walk.threads);
+    if (!ctx.pool) goto out;
+
+    ctx.nworkers = zfo_pool_size(ctx.pool);
+    ctx.workers = calloc((size_t)ctx.nworkers, sizeof(search_worker_t));
+    if (!ctx.workers) goto out;
+    for (int i = 0; i < ctx.nworkers; i++) {
+        ctx.workers[i].next = malloc(ctx.npats * sizeof(size_t));
+        if (!ctx.workers[i].next) goto out;
+    }
+
+    zfo_glob_options_t files = opts->files;
+    files.walk.visit = search_visit;
+    files.walk.userdata = &ctx;
+    files.walk.flags &= ~(uint32_t)ZFO_WALK_STAT;
+
+    rc = zfo_glob_walk_run(ctx.pool, root, opts->include, &files, result ? &result->walk : NULL);
+    if (rc == ZFO_ERR_INTERRUPTED && ctx.limit_reached) rc = ZFO_OK;
+
+    if (result) {
+        result->files_searched = ctx.files_searched;
+        result->files_matched = ctx.files_matched;
+        result->files_binary = ctx.files_binary;
+        result->files_unreadable = ctx.files_unreadable;
+        result->bytes_searched = ctx.bytes_searched;
+        result->matches = ctx.matches;
+        result->limit_reached = ctx.limit_reached != 0;
+        if (result->limit_reached) result->matches = opts->max_matches;
+    }
+
+out:
+    if (ctx.workers) {
+        for (int i = 0; i < ctx.nworkers; i++) {
+            free(ctx.workers[i].buf);
+            free(ctx.workers[i].next);
+        }
+        free(ctx.workers);
+    }
+    if (ctx.pool) zfo_pool_destroy(ctx.pool);
+    free(ctx.pats);
+    return rc;
+}
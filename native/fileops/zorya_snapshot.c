@@ -0,0 +1,1151 @@
+/**
+ * @file zorya_snapshot.c
+ * @brief Zorya FileOps - Persistent directory snapshot index
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   Records (path, inode, size, mtime, ctime, mode, optional nxh64) for
+ *   every entry under a root, sorted by path with '/' ordered before
+ *   every other byte so that a directory's subtree directly follows it.
+ *
+ *   An update runs in two parallel phases on the work-stealing pool:
+ *
+ *     1. lstat every indexed path (in chunks). Files whose stats moved
+ *        are modified, vanished paths are removed, and directories
+ *        whose mtime or inode changed are marked for a rescan.
+ *     2. Read only the marked directories. Names missing from the
+ *        index are added, and new directories are scanned whole.
+ *
+ *   The results are merged into a fresh sorted array. Saved snapshots
+ *   are a header, fixed-size records and a string table, so loading is
+ *   a mapping plus one pass to point entries at their strings.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+#include "nxh.h"
+#include "dagger.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#define SNAP_MAGIC        "ZFOSNAP"
+#define SNAP_VERSION      1
+#define SNAP_STAT_CHUNK   512
+
+/* Header flag bits above the public ZFO_SNAP_* range */
+#define SNAP_SKIP_HIDDEN  0x10000
+
+/* Entry flags */
+#define SNAP_E_HASH       0x01
+#define SNAP_E_OWNED      0x02      /* path is malloc'd, not in the mapping */
+
+/* Per-entry status during an update */
+#define SNAP_ST_CHANGED   0x01
+#define SNAP_ST_REMOVED   0x02
+#define SNAP_ST_RESCAN    0x04
+
+/* ============================================================
+ * On-Disk Format
+ * ============================================================ */
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;                 /* ZFO_SNAP_* | SNAP_SKIP_HIDDEN */
+    uint64_t count;
+    uint64_t strings_len;
+    uint64_t root_ino;
+    int64_t root_mtime_ns;
+    uint32_t root_len;
+    uint32_t prune_len;             /* NUL-terminated names, back to back */
+    uint64_t checksum;              /* nxh64 of everything after the header */
+} snap_header_t;
+
+typedef struct {
+    uint64_t path_off;              /* Into the string table (NUL-terminated) */
+    uint32_t path_len;
+    uint16_t type;
+    uint16_t flags;
+    uint64_t ino;
+    uint64_t size;
+    int64_t mtime_ns;
+    int64_t ctime_ns;
+    uint64_t hash;
+    uint32_t mode;
+    uint32_t reserved;
+} snap_rec_t;
+
+typedef char snap_header_size_check[sizeof(snap_header_t) == 64 ? 1 : -1];
+typedef char snap_rec_size_check[sizeof(snap_rec_t) == 64 ? 1 : -1];
+
+/* ============================================================
+ * Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    const char* path;
+    uint32_t path_len;
+    uint8_t type;
+    uint8_t flags;                  /* SNAP_E_* */
+    uint32_t mode;
+    uint64_t ino;
+    uint64_t size;
+    int64_t mtime_ns;
+    int64_t ctime_ns;
+    uint64_t hash;
+} snap_ent_t;
+
+struct zfo_snapshot {
+    char* root;
+    uint32_t flags;
+    bool skip_hidden;
+    char** prune;
+    size_t prune_count;
+    int threads;
+
+    bool scanned;
+    uint64_t root_ino;
+    int64_t root_mtime_ns;
+
+    snap_ent_t* ents;
+    size_t count;
+    zfo_mmap_t* map;                /* Backs paths without SNAP_E_OWNED */
+};
+
+typedef struct {
+    snap_ent_t* ents;
+    size_t count;
+    size_t cap;
+} snap_list_t;
+
+typedef struct {
+    zfo_snapshot_t* snap;
+    int root_fd;
+    uint8_t* status;                /* One per snap->ents */
+    snap_list_t* added;             /* One per worker, plus one for the caller */
+    int nlists;
+    bool oom;
+    uint64_t checked;               /* Counters are atomic */
+    uint64_t scanned;
+} snap_ctx_t;
+
+typedef struct {
+    snap_ctx_t* ctx;
+    size_t begin;
+    size_t end;
+} stat_task_t;
+
+typedef struct {
+    snap_ctx_t* ctx;
+    bool fresh;                     /* New directory: nothing below it is indexed */
+    size_t rel_len;
+    char rel[];                     /* "" for the root */
+} scan_task_t;
+
+/* ============================================================
+ * Paths and Entries
+ * ============================================================ */
+
+/* strcmp with '/' below every other byte, keeping subtrees contiguous */
+static int snap_pathcmp(const char* a, const char* b) {
+    for (;; a++, b++) {
+        unsigned char x = (unsigned char)*a;
+        unsigned char y = (unsigned char)*b;
+        if (x != y) {
+            if (x == '/') x = 1;
+            if (y == '/') y = 1;
+            return x < y ? -1 : 1;
+        }
+        if (x == 0) return 0;
+    }
+}
+
+static int cmp_ent(const void* a, const void* b) {
+    return snap_pathcmp(((const snap_ent_t*)a)->path, ((const snap_ent_t*)b)->path);
+}
+
+static bool snap_find_index(const zfo_snapshot_t* snap, const char* path, size_t* index) {
+    size_t lo = 0;
+    size_t hi = snap->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int c = snap_pathcmp(snap->ents[mid].path, path);
+        if (c == 0) {
+            *index = mid;
+            return true;
+        }
+        if (c < 0) lo = mid + 1; else hi = mid;
+    }
+    *index = lo;
+    return false;
+}
+
+/* One past the last entry below ents[index] */
+static size_t snap_subtree_end(const zfo_snapshot_t* snap, size_t index) {
+    const snap_ent_t* dir = &snap->ents[index];
+    size_t end = index + 1;
+    while (end < snap->count &&
+           strncmp(snap->ents[end].path, dir->path, dir->path_len) == 0 &&
+           snap->ents[end].path[dir->path_len] == '/') {
+        end++;
+    }
+    return end;
+}
+
+static bool snap_pruned(const zfo_snapshot_t* snap, const char* name) {
+    for (size_t i = 0; i < snap->prune_count; i++) {
+        if (strcmp(snap->prune[i], name) == 0) return true;
+    }
+    return false;
+}
+
+static void ent_fill(snap_ent_t* e, const struct stat* st) {
+    e->type = (uint8_t)zfo_type_from_mode(st->st_mode);
+    e->mode = (uint32_t)(st->st_mode & 07777);
+    e->ino = (uint64_t)st->st_ino;
+    e->size = e->type == ZFO_TYPE_DIR ? 0 : (uint64_t)st->st_size;
+    e->mtime_ns = (int64_t)ZFO_ST_MTIM(st).tv_sec * 1000000000 + ZFO_ST_MTIM(st).tv_nsec;
+    e->ctime_ns = (int64_t)ZFO_ST_CTIM(st).tv_sec * 1000000000 + ZFO_ST_CTIM(st).tv_nsec;
+}
+
+static void ent_hash(int dir_fd, const char* name, snap_ent_t* e) {
+    e->flags &= (uint8_t)~SNAP_E_HASH;
+    if (e->type != ZFO_TYPE_FILE) return;
+
+    int fd = openat(dir_fd, name, O_RDONLY | O_CLOEXEC | O_NOCTTY | O_NOFOLLOW);
+    if (fd < 0) return;
+    if (zfo_hash_fd(fd, e->size, &e->hash) == ZFO_OK) e->flags |= SNAP_E_HASH;
+    close(fd);
+}
+
+/* Whether the change from old to cur is worth reporting */
+static bool ent_differs(const snap_ent_t* old, const snap_ent_t* cur, bool hashing) {
+    if (old->type != cur->type) return true;
+    if (cur->type == ZFO_TYPE_DIR) return false;
+    if (hashing && cur->type == ZFO_TYPE_FILE) {
+        return old->size != cur->size || !(old->flags & SNAP_E_HASH) ||
+               !(cur->flags & SNAP_E_HASH) || old->hash != cur->hash;
+    }
+    return old->ino != cur->ino || old->size != cur->size || old->mode != cur->mode ||
+           old->mtime_ns != cur->mtime_ns || old->ctime_ns != cur->ctime_ns;
+}
+
+static void ent_release(snap_ent_t* e) {
+    if (e->flags & SNAP_E_OWNED) free((char*)e->path);
+}
+
+static bool list_push(snap_list_t* list, const snap_ent_t* e) {
+    if (list->count == list->cap) {
+        size_t ncap = list->cap ? list->cap * 2 : 64;
+        snap_ent_t* nents = realloc(list->ents, ncap * sizeof(snap_ent_t));
+        if (!nents) return false;
+        list->ents = nents;
+        list->cap = ncap;
+    }
+    list->ents[list->count++] = *e;
+    return true;
+}
+
+static void to_entry(const snap_ent_t* e, zfo_snap_entry_t* out) {
+    out->path = e->path;
+    out->path_len = e->path_len;
+    out->type = (zfo_file_type_t)e->type;
+    out->mode = e->mode;
+    out->inode = e->ino;
+    out->size = e->size;
+    out->mtime_ns = e->mtime_ns;
+    out->ctime_ns = e->ctime_ns;
+    out->hash = e->hash;
+    out->has_hash = (e->flags & SNAP_E_HASH) != 0;
+}
+
+/* ============================================================
+ * Scan Tasks
+ * ============================================================ */
+
+static scan_task_t* scan_task_new(snap_ctx_t* ctx, const char* rel, size_t rel_len, bool fresh) {
+    scan_task_t* task = malloc(sizeof(scan_task_t) + rel_len + 1);
+    if (!task) return NULL;
+    task->ctx = ctx;
+    task->fresh = fresh;
+    task->rel_len = rel_len;
+    memcpy(task->rel, rel, rel_len);
+    task->rel[rel_len] = '\0';
+    return task;
+}
+
+static void scan_task(zfo_pool_t* pool, int worker, void* arg) {
+    scan_task_t* task = arg;
+    snap_ctx_t* ctx = task->ctx;
+    zfo_snapshot_t* snap = ctx->snap;
+    bool hashing = (snap->flags & ZFO_SNAP_HASH) != 0;
+
+    if (zfo_pool_cancelled(pool)) {
+        free(task);
+        return;
+    }
+
+    int fd = openat(ctx->root_fd, task->rel_len ? task->rel : ".",
+                    O_RDONLY | O_DIRECTORY | O_CLOEXEC | O_NOFOLLOW);
+    zfo_dirscan_t scan;
+    if (fd < 0 || zfo_dirscan_open(&scan, fd) != ZFO_OK) {
+        if (fd >= 0) close(fd);
+        free(task);
+        return;
+    }
+    ZFO_ATOMIC_ADD(&ctx->scanned, 1);
+
+    const char* name;
+    unsigned char d_type;
+    uint64_t inode;
+    while (zfo_dirscan_next(&scan, &name, &d_type, &inode)) {
+        if (snap->skip_hidden && name[0] == '.') continue;
+
+        size_t name_len = strlen(name);
+        size_t path_len = task->rel_len ? task->rel_len + 1 + name_len : name_len;
+        char* path = malloc(path_len + 1);
+        if (!path) {
+            ctx->oom = true;
+            zfo_pool_cancel(pool);
+            break;
+        }
+        if (task->rel_len) {
+            memcpy(path, task->rel, task->rel_len);
+            path[task->rel_len] = '/';
+            memcpy(path + task->rel_len + 1, name, name_len + 1);
+        } else {
+            memcpy(path, name, name_len + 1);
+        }
+
+        size_t index;
+        if (!task->fresh && snap_find_index(snap, path, &index) &&
+            !(ctx->status[index] & SNAP_ST_REMOVED)) {
+            free(path);
+            continue;
+        }
+
+        struct stat st;
+        if (fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+            free(path);
+            continue;
+        }
+
+        snap_ent_t e;
+        memset(&e, 0, sizeof(e));
+        e.path = path;
+        e.path_len = (uint32_t)path_len;
+        e.flags = SNAP_E_OWNED;
+        ent_fill(&e, &st);
+        if (e.type == ZFO_TYPE_DIR && snap_pruned(snap, name)) {
+            free(path);
+            continue;
+        }
+        if (hashing) ent_hash(fd, name, &e);
+
+        if (!list_push(&ctx->added[worker], &e)) {
+            free(path);
+            ctx->oom = true;
+            zfo_pool_cancel(pool);
+            break;
+        }
+
+        if (e.type == ZFO_TYPE_DIR) {
+            scan_task_t* child = scan_task_new(ctx, path, path_len, true);
+            if (!child || zfo_pool_submit(pool, worker, scan_task, child) != ZFO_OK) {
+                free(child);
+                ctx->oom = true;
+                zfo_pool_cancel(pool);
+                break;
+            }
+        }
+    }
+
+    zfo_dirscan_close(&scan);
+    close(fd);
+    free(task);
+}
+
+/* ============================================================
+ * Update
+ * ============================================================ */
+
+static void stat_task(zfo_pool_t* pool, int worker, void* arg) {
+    (void)worker;
+    stat_task_t* task = arg;
+    snap_ctx_t* ctx = task->ctx;
+    snap_ent_t* ents = ctx->snap->ents;
+    bool hashing = (ctx->snap->flags & ZFO_SNAP_HASH) != 0;
+
+    for (size_t i = task->begin; i < task->end && !zfo_pool_cancelled(pool); i++) {
+        snap_ent_t* e = &ents[i];
+        struct stat st;
+        if (fstatat(ctx->root_fd, e->path, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+            if (errno == ENOENT || errno == ENOTDIR) ctx->status[i] = SNAP_ST_REMOVED;
+            continue;
+        }
+
+        snap_ent_t cur = *e;
+        ent_fill(&cur, &st);
+        if (cur.type == ZFO_TYPE_DIR &&
+            (e->type != ZFO_TYPE_DIR || cur.ino != e->ino || cur.mtime_ns != e->mtime_ns)) {
+            ctx->status[i] |= SNAP_ST_RESCAN;
+        }
+        if (hashing && cur.type == ZFO_TYPE_FILE) {
+            if (e->type != ZFO_TYPE_FILE || !(e->flags & SNAP_E_HASH) || cur.ino != e->ino ||
+                cur.size != e->size || cur.mtime_ns != e->mtime_ns) {
+                ent_hash(ctx->root_fd, cur.path, &cur);
+            }
+        } else {
+            cur.flags &= (uint8_t)~SNAP_E_HASH;
+        }
+        if (ent_differs(e, &cur, hashing)) ctx->status[i] |= SNAP_ST_CHANGED;
+        *e = cur;
+    }
+    ZFO_ATOMIC_ADD(&ctx->checked, task->end - task->begin);
+    free(task);
+}
+
+static int ctx_init(snap_ctx_t* ctx, zfo_snapshot_t* snap, int nworkers) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->snap = snap;
+    ctx->root_fd = open(snap->root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (ctx->root_fd < 0) return zfo_error_from_errno(errno);
+
+    ctx->nlists = nworkers + 1;
+    ctx->status = calloc(snap->count ? snap->count : 1, 1);
+    ctx->added = calloc((size_t)ctx->nlists, sizeof(snap_list_t));
+    if (!ctx->status || !ctx->added) {
+        free(ctx->status);
+        free(ctx->added);
+        close(ctx->root_fd);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    return ZFO_OK;
+}
+
+static void ctx_cleanup(snap_ctx_t* ctx) {
+    for (int w = 0; w < ctx->nlists; w++) {
+        for (size_t i = 0; i < ctx->added[w].count; i++) ent_release(&ctx->added[w].ents[i]);
+        free(ctx->added[w].ents);
+    }
+    free(ctx->added);
+    free(ctx->status);
+    close(ctx->root_fd);
+}
+
+static bool diff_push(zfo_snap_diff_t* diff, size_t* cap, zfo_snap_change_kind_t kind,
+                      const snap_ent_t* e) {
+    if (!diff) return true;
+    if (diff->count == *cap) {
+        size_t ncap = *cap ? *cap * 2 : 64;
+        zfo_snap_change_t* nchanges = realloc(diff->changes, ncap * sizeof(zfo_snap_change_t));
+        if (!nchanges) return false;
+        diff->changes = nchanges;
+        *cap = ncap;
+    }
+    char* path = malloc(e->path_len + 1);
+    if (!path) return false;
+    memcpy(path, e->path, e->path_len + 1);
+
+    zfo_snap_change_t* c = &diff->changes[diff->count++];
+    c->kind = kind;
+    c->type = (zfo_file_type_t)e->type;
+    c->path = path;
+    return true;
+}
+
+/*
+ * Merge the surviving entries with the added ones into a new sorted
+ * array and build the diff in the same pass. An added path that also
+ * exists in the old array (rescanned after being replaced) is reported
+ * as modified, or not at all if nothing about it changed.
+ */
+static int snap_commit(snap_ctx_t* ctx, zfo_snap_diff_t* diff) {
+    zfo_snapshot_t* snap = ctx->snap;
+    bool hashing = (snap->flags & ZFO_SNAP_HASH) != 0;
+
+    size_t added_count = 0;
+    for (int w = 0; w < ctx->nlists; w++) added_count += ctx->added[w].count;
+
+    snap_ent_t* added = malloc((added_count ? added_count : 1) * sizeof(snap_ent_t));
+    snap_ent_t* merged = malloc((snap->count + added_count ? snap->count + added_count : 1) *
+                                sizeof(snap_ent_t));
+    if (!added || !merged) {
+        free(added);
+        free(merged);
+        return ZFO_ERR_NO_MEMORY;
+    }
+
+    size_t n = 0;
+    for (int w = 0; w < ctx->nlists; w++) {
+        if (ctx->added[w].count) {
+            memcpy(added + n, ctx->added[w].ents, ctx->added[w].count * sizeof(snap_ent_t));
+            n += ctx->added[w].count;
+        }
+        ctx->added[w].count = 0;
+    }
+    qsort(added, n, sizeof(snap_ent_t), cmp_ent);
+
+    /* Keep the last of any duplicates */
+    size_t m = 0;
+    for (size_t j = 0; j < n; j++) {
+        if (m > 0 && snap_pathcmp(added[m - 1].path, added[j].path) == 0) {
+            ent_release(&added[m - 1]);
+            added[m - 1] = added[j];
+        } else {
+            added[m++] = added[j];
+        }
+    }
+
+    size_t cap = 0;
+    bool ok = true;
+    size_t out = 0;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < snap->count || j < m) {
+        int c = i == snap->count ? 1 : j == m ? -1 : snap_pathcmp(snap->ents[i].path, added[j].path);
+        if (c < 0) {
+            snap_ent_t* e = &snap->ents[i];
+            uint8_t st = ctx->status[i++];
+            if (st & SNAP_ST_REMOVED) {
+                ok = diff_push(diff, &cap, ZFO_SNAP_REMOVED, e) && ok;
+                ent_release(e);
+            } else {
+                if (st & SNAP_ST_CHANGED) ok = diff_push(diff, &cap, ZFO_SNAP_MODIFIED, e) && ok;
+                merged[out++] = *e;
+            }
+        } else if (c > 0) {
+            ok = diff_push(diff, &cap, ZFO_SNAP_ADDED, &added[j]) && ok;
+            merged[out++] = added[j++];
+        } else {
+            snap_ent_t* e = &snap->ents[i++];
+            if (ent_differs(e, &added[j], hashing)) {
+                ok = diff_push(diff, &cap, ZFO_SNAP_MODIFIED, &added[j]) && ok;
+            }
+            ent_release(e);
+            merged[out++] = added[j++];
+        }
+    }
+
+    free(added);
+    free(snap->ents);
+    snap->ents = merged;
+    snap->count = out;
+    return ok ? ZFO_OK : ZFO_ERR_NO_MEMORY;
+}
+
+static void snap_stat_root(snap_ctx_t* ctx, bool* changed) {
+    zfo_snapshot_t* snap = ctx->snap;
+    struct stat st;
+    *changed = !snap->scanned;
+    if (fstat(ctx->root_fd, &st) != 0) return;
+
+    int64_t mtime_ns = (int64_t)ZFO_ST_MTIM(&st).tv_sec * 1000000000 + ZFO_ST_MTIM(&st).tv_nsec;
+    if ((uint64_t)st.st_ino != snap->root_ino || mtime_ns != snap->root_mtime_ns) *changed = true;
+    snap->root_ino = (uint64_t)st.st_ino;
+    snap->root_mtime_ns = mtime_ns;
+}
+
+static int submit_scan(zfo_pool_t* pool, snap_ctx_t* ctx, const char* rel, size_t rel_len,
+                       bool fresh) {
+    scan_task_t* task = scan_task_new(ctx, rel, rel_len, fresh);
+    if (!task) return ZFO_ERR_NO_MEMORY;
+    int rc = zfo_pool_submit(pool, -1, scan_task, task);
+    if (rc != ZFO_OK) free(task);
+    return rc;
+}
+
+int zfo_snapshot_update(zfo_snapshot_t* snap, int threads, zfo_snap_diff_t* diff) {
+    if (diff) memset(diff, 0, sizeof(*diff));
+    if (!snap) return ZFO_ERR_INVALID_ARG;
+
+    zfo_pool_t* pool = zfo_pool_create(threads > 0 ? threads : snap->threads);
+    if (!pool) return ZFO_ERR_NO_MEMORY;
+
+    snap_ctx_t ctx;
+    int rc = ctx_init(&ctx, snap, zfo_pool_size(pool));
+    if (rc != ZFO_OK) {
+        zfo_pool_destroy(pool);
+        return rc;
+    }
+
+    /* Phase 1: stat everything already indexed */
+    for (size_t begin = 0; begin < snap->count && rc == ZFO_OK; begin += SNAP_STAT_CHUNK) {
+        stat_task_t* task = malloc(sizeof(stat_task_t));
+        if (!task) {
+            rc = ZFO_ERR_NO_MEMORY;
+            break;
+        }
+        task->ctx = &ctx;
+        task->begin = begin;
+        task->end = snap->count - begin < SNAP_STAT_CHUNK ? snap->count : begin + SNAP_STAT_CHUNK;
+        rc = zfo_pool_submit(pool, -1, stat_task, task);
+        if (rc != ZFO_OK) free(task);
+    }
+    zfo_pool_wait(pool, 0, NULL, NULL);
+
+    /* Phase 2: read the directories that changed */
+    bool root_changed;
+    bool was_empty = !snap->scanned;
+    snap_stat_root(&ctx, &root_changed);
+    if (rc == ZFO_OK && root_changed) rc = submit_scan(pool, &ctx, "", 0, was_empty);
+    for (size_t i = 0; i < snap->count && rc == ZFO_OK; i++) {
+        if (!(ctx.status[i] & SNAP_ST_RESCAN) || (ctx.status[i] & SNAP_ST_REMOVED)) continue;
+        rc = submit_scan(pool, &ctx, snap->ents[i].path, snap->ents[i].path_len, false);
+    }
+    zfo_pool_wait(pool, 0, NULL, NULL);
+    zfo_pool_destroy(pool);
+
+    if (rc == ZFO_OK && ctx.oom) rc = ZFO_ERR_NO_MEMORY;
+    if (rc == ZFO_OK) {
+        snap->scanned = true;
+        rc = snap_commit(&ctx, diff);
+    }
+    if (diff) {
+        diff->entries_checked = ctx.checked;
+        diff->dirs_scanned = ctx.scanned;
+    }
+    ctx_cleanup(&ctx);
+    return rc;
+}
+
+/* ============================================================
+ * Watcher Events
+ * ============================================================ */
+
+typedef struct {
+    snap_ctx_t* ctx;
+    DaggerTable* pending;           /* Paths added or queued for a scan */
+    scan_task_t** scans;
+    size_t scan_count;
+    size_t scan_cap;
+    int rc;
+} apply_ctx_t;
+
+static const char* apply_relative(const zfo_snapshot_t* snap, const char* path) {
+    size_t root_len = strlen(snap->root);
+    if (root_len == 1 && snap->root[0] == '/') return path[0] == '/' ? path + 1 : NULL;
+    if (strncmp(path, snap->root, root_len) != 0) return NULL;
+    if (path[root_len] == '\0') return path + root_len;
+    return path[root_len] == '/' ? path + root_len + 1 : NULL;
+}
+
+/* Whether the path lies below a hidden or pruned component */
+static bool apply_excluded(const zfo_snapshot_t* snap, const char* rel) {
+    char name[256];
+    const char* p = rel;
+    while (*p) {
+        const char* slash = strchr(p, '/');
+        size_t len = slash ? (size_t)(slash - p) : strlen(p);
+        if (snap->skip_hidden && p[0] == '.') return true;
+        if (slash && len < sizeof(name)) {
+            memcpy(name, p, len);
+            name[len] = '\0';
+            if (snap_pruned(snap, name)) return true;
+        }
+        if (!slash) break;
+        p = slash + 1;
+    }
+    return false;
+}
+
+/* Whether the path or one of its parents is already pending */
+static bool apply_covered(apply_ctx_t* ac, const char* rel, size_t len) {
+    while (len > 0) {
+        if (dagger_contains(ac->pending, rel, (uint32_t)len)) return true;
+        while (len > 0 && rel[len - 1] != '/') len--;
+        if (len > 0) len--;
+    }
+    return false;
+}
+
+static void apply_queue_scan(apply_ctx_t* ac, const char* rel, size_t len) {
+    if (ac->scan_count == ac->scan_cap) {
+        size_t ncap = ac->scan_cap ? ac->scan_cap * 2 : 16;
+        scan_task_t** nscans = realloc(ac->scans, ncap * sizeof(scan_task_t*));
+        if (!nscans) {
+            ac->rc = ZFO_ERR_NO_MEMORY;
+            return;
+        }
+        ac->scans = nscans;
+        ac->scan_cap = ncap;
+    }
+    scan_task_t* task = scan_task_new(ac->ctx, rel, len, true);
+    if (!task) {
+        ac->rc = ZFO_ERR_NO_MEMORY;
+        return;
+    }
+    ac->scans[ac->scan_count++] = task;
+    dagger_set(ac->pending, task->rel, (uint32_t)len, task, 1);
+}
+
+static void apply_path(apply_ctx_t* ac, const char* rel, size_t len) {
+    snap_ctx_t* ctx = ac->ctx;
+    zfo_snapshot_t* snap = ctx->snap;
+    bool hashing = (snap->flags & ZFO_SNAP_HASH) != 0;
+    if (len == 0 || apply_covered(ac, rel, len)) return;
+
+    char* path = malloc(len + 1);
+    if (!path) {
+        ac->rc = ZFO_ERR_NO_MEMORY;
+        return;
+    }
+    memcpy(path, rel, len);
+    path[len] = '\0';
+
+    size_t index;
+    bool found = snap_find_index(snap, path, &index);
+    if (found && (ctx->status[index] & SNAP_ST_REMOVED)) found = false;
+
+    struct stat st;
+    if (fstatat(ctx->root_fd, path, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+        if (found) {
+            size_t end = snap_subtree_end(snap, index);
+            for (size_t i = index; i < end; i++) ctx->status[i] = SNAP_ST_REMOVED;
+        }
+        free(path);
+        return;
+    }
+
+    snap_ent_t cur;
+    memset(&cur, 0, sizeof(cur));
+    ent_fill(&cur, &st);
+    const char* slash = strrchr(path, '/');
+    if (cur.type == ZFO_TYPE_DIR && snap_pruned(snap, slash ? slash + 1 : path)) {
+        free(path);
+        return;
+    }
+
+    if (found) {
+        snap_ent_t* e = &snap->ents[index];
+        cur.path = e->path;
+        cur.path_len = e->path_len;
+        cur.flags = e->flags;
+        cur.hash = e->hash;
+        free(path);
+
+        bool replaced = e->type != cur.type || (cur.type == ZFO_TYPE_DIR && cur.ino != e->ino);
+        if (hashing && cur.type == ZFO_TYPE_FILE) {
+            if (replaced || !(e->flags & SNAP_E_HASH) || cur.size != e->size ||
+                cur.mtime_ns != e->mtime_ns) {
+                ent_hash(ctx->root_fd, cur.path, &cur);
+            }
+        } else {
+            cur.flags &= (uint8_t)~SNAP_E_HASH;
+        }
+        if (ent_differs(e, &cur, hashing)) ctx->status[index] |= SNAP_ST_CHANGED;
+
+        if (replaced) {
+            /* Everything below belonged to the old directory */
+            size_t end = snap_subtree_end(snap, index);
+            for (size_t i = index + 1; i < end; i++) ctx->status[i] = SNAP_ST_REMOVED;
+            if (cur.type == ZFO_TYPE_DIR) apply_queue_scan(ac, cur.path, cur.path_len);
+        }
+        *e = cur;
+        return;
+    }
+
+    /* A new path under a directory the index doesn't know yet: add that instead */
+    size_t parent_len = slash ? (size_t)(slash - path) : 0;
+    size_t parent;
+    if (parent_len > 0) {
+        path[parent_len] = '\0';
+        bool have_parent = snap_find_index(snap, path, &parent) &&
+                           !(ctx->status[parent] & SNAP_ST_REMOVED);
+        path[parent_len] = '/';
+        if (!have_parent) {
+            free(path);
+            apply_path(ac, rel, parent_len);
+            return;
+        }
+    }
+
+    cur.path = path;
+    cur.path_len = (uint32_t)len;
+    cur.flags = SNAP_E_OWNED;
+    if (hashing) ent_hash(ctx->root_fd, path, &cur);
+    if (!list_push(&ctx->added[ctx->nlists - 1], &cur)) {
+        free(path);
+        ac->rc = ZFO_ERR_NO_MEMORY;
+        return;
+    }
+    if (cur.type == ZFO_TYPE_DIR) {
+        apply_queue_scan(ac, path, len);
+    } else {
+        dagger_set(ac->pending, path, (uint32_t)len, path, 1);
+    }
+}
+
+/* Pick up the parent's new mtime so the next update doesn't reread it */
+static void apply_parent(apply_ctx_t* ac, const char* rel) {
+    snap_ctx_t* ctx = ac->ctx;
+    zfo_snapshot_t* snap = ctx->snap;
+    const char* slash = strrchr(rel, '/');
+    if (!slash) {
+        bool changed;
+        snap_stat_root(ctx, &changed);
+        return;
+    }
+
+    size_t len = (size_t)(slash - rel);
+    char* path = malloc(len + 1);
+    if (!path) return;
+    memcpy(path, rel, len);
+    path[len] = '\0';
+
+    size_t index;
+    struct stat st;
+    if (snap_find_index(snap, path, &index) && snap->ents[index].type == ZFO_TYPE_DIR &&
+        fstatat(ctx->root_fd, path, &st, AT_SYMLINK_NOFOLLOW) == 0 &&
+        (uint64_t)st.st_ino == snap->ents[index].ino) {
+        ent_fill(&snap->ents[index], &st);
+    }
+    free(path);
+}
+
+static void apply_change(apply_ctx_t* ac, const char* abs_path) {
+    if (!abs_path) return;
+    const char* rel = apply_relative(ac->ctx->snap, abs_path);
+    if (!rel || !*rel || apply_excluded(ac->ctx->snap, rel)) return;
+    apply_path(ac, rel, strlen(rel));
+    apply_parent(ac, rel);
+}
+
+int zfo_snapshot_apply(zfo_snapshot_t* snap, const zfo_watch_change_t* changes,
+                       size_t count, zfo_snap_diff_t* diff) {
+    if (diff) memset(diff, 0, sizeof(*diff));
+    if (!snap || (!changes && count > 0)) return ZFO_ERR_INVALID_ARG;
+
+    for (size_t i = 0; i < count; i++) {
+        if (changes[i].event & ZFO_EVENT_OVERFLOW) return zfo_snapshot_update(snap, 0, diff);
+    }
+
+    snap_ctx_t ctx;
+    int nworkers = zfo_thread_count(snap->threads);
+    int rc = ctx_init(&ctx, snap, nworkers);
+    if (rc != ZFO_OK) return rc;
+
+    apply_ctx_t ac;
+    memset(&ac, 0, sizeof(ac));
+    ac.ctx = &ctx;
+    ac.pending = dagger_create(count * 2, NULL);
+    if (!ac.pending) {
+        ctx_cleanup(&ctx);
+        return ZFO_ERR_NO_MEMORY;
+    }
+
+    for (size_t i = 0; i < count && ac.rc == ZFO_OK; i++) {
+        apply_change(&ac, changes[i].old_path);
+        apply_change(&ac, changes[i].path);
+    }
+    dagger_destroy(ac.pending);
+    rc = ac.rc;
+
+    /* New directories are read on the pool, like an update's second phase */
+    if (ac.scan_count > 0) {
+        zfo_pool_t* pool = rc == ZFO_OK ? zfo_pool_create(nworkers) : NULL;
+        if (!pool && rc == ZFO_OK) rc = ZFO_ERR_NO_MEMORY;
+        size_t next = 0;
+        for (; pool && next < ac.scan_count && rc == ZFO_OK; next++) {
+            rc = zfo_pool_submit(pool, -1, scan_task, ac.scans[next]);
+        }
+        if (rc != ZFO_OK && next > 0) next--;
+        for (size_t i = next; i < ac.scan_count; i++) free(ac.scans[i]);
+        if (pool) {
+            zfo_pool_wait(pool, 0, NULL, NULL);
+            zfo_pool_destroy(pool);
+        }
+        if (rc == ZFO_OK && ctx.oom) rc = ZFO_ERR_NO_MEMORY;
+    }
+    free(ac.scans);
+
+    if (rc == ZFO_OK) rc = snap_commit(&ctx, diff);
+    if (diff) {
+        diff->entries_checked = count;
+        diff->dirs_scanned = ctx.scanned;
+    }
+    ctx_cleanup(&ctx);
+    return rc;
+}
+
+/* ============================================================
+ * Create / Free
+ * ============================================================ */
+
+static zfo_snapshot_t* snap_alloc(const char* root, size_t root_len) {
+    zfo_snapshot_t* snap = calloc(1, sizeof(zfo_snapshot_t));
+    if (!snap) return NULL;
+
+    /* Trailing slashes would break matching watcher paths */
+    while (root_len > 1 && root[root_len - 1] == '/') root_len--;
+    snap->root = malloc(root_len + 1);
+    if (!snap->root) {
+        free(snap);
+        return NULL;
+    }
+    memcpy(snap->root, root, root_len);
+    snap->root[root_len] = '\0';
+    return snap;
+}
+
+static int snap_set_prune(zfo_snapshot_t* snap, const char* const* prune, size_t count) {
+    if (count == 0) return ZFO_OK;
+    snap->prune = calloc(count, sizeof(char*));
+    if (!snap->prune) return ZFO_ERR_NO_MEMORY;
+    for (size_t i = 0; i < count; i++) {
+        snap->prune[i] = strdup(prune[i]);
+        if (!snap->prune[i]) return ZFO_ERR_NO_MEMORY;
+        snap->prune_count++;
+    }
+    return ZFO_OK;
+}
+
+int zfo_snapshot_create(const char* root, const zfo_snapshot_options_t* opts,
+                        zfo_snapshot_t** out) {
+    if (!root || !*root || !out) return ZFO_ERR_INVALID_ARG;
+    *out = NULL;
+
+    struct stat st;
+    if (stat(root, &st) != 0) return zfo_error_from_errno(errno);
+    if (!S_ISDIR(st.st_mode)) return ZFO_ERR_NOT_DIR;
+
+    zfo_snapshot_t* snap = snap_alloc(root, strlen(root));
+    if (!snap) return ZFO_ERR_NO_MEMORY;
+    if (opts) {
+        snap->flags = opts->flags & ZFO_SNAP_HASH;
+        snap->skip_hidden = opts->skip_hidden;
+        snap->threads = opts->threads;
+    }
+
+    int rc = opts ? snap_set_prune(snap, opts->prune, opts->prune_count) : ZFO_OK;
+    if (rc == ZFO_OK) rc = zfo_snapshot_update(snap, 0, NULL);
+    if (rc != ZFO_OK) {
+        zfo_snapshot_free(snap);
+        return rc;
+    }
+    *out = snap;
+    return ZFO_OK;
+}
+
+void zfo_snapshot_free(zfo_snapshot_t* snap) {
+    if (!snap) return;
+    for (size_t i = 0; i < snap->count; i++) ent_release(&snap->ents[i]);
+    free(snap->ents);
+    for (size_t i = 0; i < snap->prune_count; i++) free(snap->prune[i]);
+    free(snap->prune);
+    if (snap->map) zfo_mmap_close(snap->map);
+    free(snap->root);
+    free(snap);
+}
+
+void zfo_snap_diff_free(zfo_snap_diff_t* diff) {
+    if (!diff) return;
+    for (size_t i = 0; i < diff->count; i++) free(diff->changes[i].path);
+    free(diff->changes);
+    memset(diff, 0, sizeof(*diff));
+}
+
+/* ============================================================
+ * Save / Load
+ * ============================================================ */
+
+#define SNAP_ALIGN8(n) (((n) + 7) & ~(size_t)7)
+
+int zfo_snapshot_save(const zfo_snapshot_t* snap, const char* path) {
+    if (!snap || !path) return ZFO_ERR_INVALID_ARG;
+
+    size_t root_len = strlen(snap->root);
+    size_t prune_len = 0;
+    for (size_t i = 0; i < snap->prune_count; i++) prune_len += strlen(snap->prune[i]) + 1;
+    size_t strings_len = 0;
+    for (size_t i = 0; i < snap->count; i++) strings_len += snap->ents[i].path_len + 1;
+
+    size_t recs_off = SNAP_ALIGN8(sizeof(snap_header_t) + root_len + prune_len);
+    size_t strings_off = recs_off + snap->count * sizeof(snap_rec_t);
+    size_t total = strings_off + strings_len;
+
+    char* buf = calloc(1, total);
+    if (!buf) return ZFO_ERR_NO_MEMORY;
+
+    snap_header_t* hdr = (snap_header_t*)buf;
+    memcpy(hdr->magic, SNAP_MAGIC, sizeof(hdr->magic));
+    hdr->version = SNAP_VERSION;
+    hdr->flags = snap->flags | (snap->skip_hidden ? SNAP_SKIP_HIDDEN : 0);
+    hdr->count = snap->count;
+    hdr->strings_len = strings_len;
+    hdr->root_ino = snap->root_ino;
+    hdr->root_mtime_ns = snap->root_mtime_ns;
+    hdr->root_len = (uint32_t)root_len;
+    hdr->prune_len = (uint32_t)prune_len;
+
+    char* p = buf + sizeof(snap_header_t);
+    memcpy(p, snap->root, root_len);
+    p += root_len;
+    for (size_t i = 0; i < snap->prune_count; i++) {
+        size_t len = strlen(snap->prune[i]) + 1;
+        memcpy(p, snap->prune[i], len);
+        p += len;
+    }
+
+    snap_rec_t* recs = (snap_rec_t*)(buf + recs_off);
+    char* strings = buf + strings_off;
+    uint64_t off = 0;
+    for (size_t i = 0; i < snap->count; i++) {
+        const snap_ent_t* e = &snap->ents[i];
+        snap_rec_t* r = &recs[i];
+        r->path_off = off;
+        r->path_len = e->path_len;
+        r->type = e->type;
+        r->flags = e->flags & SNAP_E_HASH;
+        r->ino = e->ino;
+        r->size = e->size;
+        r->mtime_ns = e->mtime_ns;
+        r->ctime_ns = e->ctime_ns;
+        r->hash = e->hash;
+        r->mode = e->mode;
+        memcpy(strings + off, e->path, e->path_len + 1);
+        off += e->path_len + 1;
+    }
+
+    hdr->checksum = nxh64(buf + sizeof(snap_header_t), total - sizeof(snap_header_t),
+                          NXH_SEED_DEFAULT);
+    int rc = zfo_atomic_write(path, buf, total);
+    free(buf);
+    return rc;
+}
+
+int zfo_snapshot_load(const char* path, zfo_snapshot_t** out) {
+    if (!path || !out) return ZFO_ERR_INVALID_ARG;
+    *out = NULL;
+
+    zfo_mmap_t* map;
+    int rc = zfo_mmap_read_file(path, &map);
+    if (rc != ZFO_OK) return rc;
+
+    const char* base = zfo_mmap_ptr(map);
+    size_t len = zfo_mmap_size(map);
+    const snap_header_t* hdr = (const snap_header_t*)base;
+    if (len < sizeof(snap_header_t) || memcmp(hdr->magic, SNAP_MAGIC, sizeof(hdr->magic)) != 0 ||
+        hdr->version != SNAP_VERSION) {
+        zfo_mmap_close(map);
+        return ZFO_ERR_INVALID_ARG;
+    }
+
+    size_t recs_off = SNAP_ALIGN8(sizeof(snap_header_t) + (size_t)hdr->root_len + hdr->prune_len);
+    bool valid = hdr->root_len > 0 && recs_off <= len &&
+                 hdr->count <= (len - recs_off) / sizeof(snap_rec_t) &&
+                 hdr->strings_len == len - recs_off - hdr->count * sizeof(snap_rec_t) &&
+                 nxh64(base + sizeof(snap_header_t), len - sizeof(snap_header_t),
+                       NXH_SEED_DEFAULT) == hdr->checksum;
+    if (!valid) {
+        zfo_mmap_close(map);
+        return ZFO_ERR_INVALID_ARG;
+    }
+
+    zfo_snapshot_t* snap = snap_alloc(base + sizeof(snap_header_t), hdr->root_len);
+    if (!snap) {
+        zfo_mmap_close(map);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    snap->map = map;
+    snap->flags = hdr->flags & ZFO_SNAP_HASH;
+    snap->skip_hidden = (hdr->flags & SNAP_SKIP_HIDDEN) != 0;
+    snap->scanned = true;
+    snap->root_ino = hdr->root_ino;
+    snap->root_mtime_ns = hdr->root_mtime_ns;
+
+    /* Prune names are NUL-terminated; the blob must end with one */
+    const char* prune = base + sizeof(snap_header_t) + hdr->root_len;
+    size_t prune_count = 0;
+    for (size_t i = 0; i < hdr->prune_len; i++) prune_count += prune[i] == '\0';
+    if (hdr->prune_len > 0 && prune[hdr->prune_len - 1] != '\0') rc = ZFO_ERR_INVALID_ARG;
+    if (rc == ZFO_OK && prune_count > 0) {
+        const char** names = malloc(prune_count * sizeof(char*));
+        if (!names) {
+            rc = ZFO_ERR_NO_MEMORY;
+        } else {
+            const char* p = prune;
+            for (size_t i = 0; i < prune_count; i++) {
+                names[i] = p;
+                p += strlen(p) + 1;
+            }
+            rc = snap_set_prune(snap, names, prune_count);
+            free(names);
+        }
+    }
+
+    const snap_rec_t* recs = (const snap_rec_t*)(base + recs_off);
+    const char* strings = base + recs_off + hdr->count * sizeof(snap_rec_t);
+    if (rc == ZFO_OK) {
+        snap->ents = malloc((hdr->count ? hdr->count : 1) * sizeof(snap_ent_t));
+        if (!snap->ents) rc = ZFO_ERR_NO_MEMORY;
+    }
+    for (size_t i = 0; rc == ZFO_OK && i < hdr->count; i++) {
+        const snap_rec_t* r = &recs[i];
+        if (r->path_off >= hdr->strings_len || r->path_len >= hdr->strings_len - r->path_off ||
+            strings[r->path_off + r->path_len] != '\0' || r->type > ZFO_TYPE_CHAR) {
+            rc = ZFO_ERR_INVALID_ARG;
+            break;
+        }
+        snap_ent_t* e = &snap->ents[i];
+        e->path = strings + r->path_off;
+        e->path_len = r->path_len;
+        e->type = (uint8_t)r->type;
+        e->flags = (uint8_t)(r->flags & SNAP_E_HASH);
+        e->mode = r->mode;
+        e->ino = r->ino;
+        e->size = r->size;
+        e->mtime_ns = r->mtime_ns;
+        e->ctime_ns = r->ctime_ns;
+        e->hash = r->hash;
+        snap->count++;
+    }
+
+    if (rc != ZFO_OK) {
+        zfo_snapshot_free(snap);
+        return rc;
+    }
+    *out = snap;
+    return ZFO_OK;
+}
+
+/* ============================================================
+ * Queries
+ * ============================================================ */
+
+const char* zfo_snapshot_root(const zfo_snapshot_t* snap) {
+    return snap ? snap->root : NULL;
+}
+
+size_t zfo_snapshot_count(const zfo_snapshot_t* snap) {
+    return snap ? snap->count : 0;
+}
+
+int zfo_snapshot_entry(const zfo_snapshot_t* snap, size_t index, zfo_snap_entry_t* entry) {
+    if (!snap || !entry) return ZFO_ERR_INVALID_ARG;
+    if (index >= snap->count) return ZFO_ERR_NOT_FOUND;
+    to_entry(&snap->ents[index], entry);
+    return ZFO_OK;
+}
+
+int zfo_snapshot_find(const zfo_snapshot_t* snap, const char* path, zfo_snap_entry_t* entry) {
+    if (!snap || !path || !entry) return ZFO_ERR_INVALID_ARG;
+    size_t index;
+    if (!snap_find_index(snap, path, &index)) return ZFO_ERR_NOT_FOUND;
+    to_entry(&snap->ents[index], entry);
+    return ZFO_OK;
+}
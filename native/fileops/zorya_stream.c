@@ -0,0 +1,488 @@
+/**
+ * @file zorya_stream.c
+ * @brief Zorya FileOps - Pipelined chunked reader
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   A background thread fills a ring of fixed-size buffers while the
+ *   caller consumes them in order. Each slot goes FREE -> FILLING ->
+ *   READY -> HELD (handed out by next) and back to FREE on release.
+ *   Chunks carry a sequence number, so slots can be released in any
+ *   order and the producer takes whichever slot frees up first; holding
+ *   a chunk only narrows the pipeline until every buffer is held.
+ *
+ *   Plain files are read with pread after posix_fadvise(SEQUENTIAL),
+ *   with readahead kept one ring ahead of the producer. Compressed
+ *   input (zstd, or LZ4 frames) is decoded on the producer thread
+ *   straight into the slots, so chunks are always chunk_size bytes of
+ *   output except the last one. The optional hash is computed there
+ *   too.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+#include "nxh.h"
+#include "zstd.h"
+#include "lz4frame.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#define READER_DEFAULT_CHUNK   (1u << 20)
+#define READER_DEFAULT_SLOTS   4
+#define READER_MAX_SLOTS       64
+
+/* ============================================================
+ * Internal Structures
+ * ============================================================ */
+
+typedef enum {
+    SLOT_FREE,
+    SLOT_FILLING,
+    SLOT_READY,
+    SLOT_HELD
+} slot_state_t;
+
+typedef struct {
+    char* buf;
+    size_t len;
+    uint64_t offset;
+    uint64_t seq;
+    uint64_t hash;
+    slot_state_t state;
+} reader_slot_t;
+
+struct zfo_reader {
+    int fd;
+    size_t chunk_size;
+    int slot_count;
+    zfo_codec_t codec;
+    uint32_t flags;
+    uint64_t start;
+    uint64_t end;                   /* Input range, end exclusive */
+
+    reader_slot_t* slots;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    pthread_t thread;
+    bool started;
+    bool stop;
+    bool eof;
+    int error;
+
+    uint64_t produced;              /* Chunks filled */
+    uint64_t consumed;              /* Chunks handed out */
+    uint64_t hash;                  /* Combined hash of chunks handed out */
+    uint64_t bytes_read;            /* Input bytes, before decoding */
+
+    bool want_notify;
+    zfo_reader_notify_fn notify;
+    void* userdata;
+};
+
+/* ============================================================
+ * Producer
+ * ============================================================ */
+
+static reader_slot_t* find_slot_locked(zfo_reader_t* r, slot_state_t state, uint64_t seq, bool any) {
+    for (int i = 0; i < r->slot_count; i++) {
+        reader_slot_t* slot = &r->slots[i];
+        if (slot->state == state && (any || slot->seq == seq)) return slot;
+    }
+    return NULL;
+}
+
+/* Claim a free slot, waiting for a release; NULL when stopping */
+static reader_slot_t* wait_free(zfo_reader_t* r) {
+    pthread_mutex_lock(&r->lock);
+    reader_slot_t* slot;
+    while (!r->stop && !(slot = find_slot_locked(r, SLOT_FREE, 0, true))) {
+        pthread_cond_wait(&r->cond, &r->lock);
+    }
+    if (r->stop) slot = NULL;
+    else slot->state = SLOT_FILLING;
+    pthread_mutex_unlock(&r->lock);
+    return slot;
+}
+
+static void wake_consumer_locked(zfo_reader_t* r, bool* notify) {
+    pthread_cond_broadcast(&r->cond);
+    if (r->want_notify && r->notify) {
+        r->want_notify = false;
+        *notify = true;
+    }
+}
+
+static void publish(zfo_reader_t* r, reader_slot_t* slot, size_t len, uint64_t offset) {
+    slot->len = len;
+    slot->offset = offset;
+    if (r->flags & ZFO_READER_HASH) slot->hash = nxh64(slot->buf, len, NXH_SEED_DEFAULT);
+
+    bool notify = false;
+    pthread_mutex_lock(&r->lock);
+    slot->seq = r->produced++;
+    slot->state = SLOT_READY;
+    wake_consumer_locked(r, &notify);
+    pthread_mutex_unlock(&r->lock);
+    if (notify) r->notify(r->userdata);
+}
+
+static void finish(zfo_reader_t* r, int rc) {
+    bool notify = false;
+    pthread_mutex_lock(&r->lock);
+    if (rc != ZFO_OK && !r->error) r->error = rc;
+    r->eof = true;
+    wake_consumer_locked(r, &notify);
+    pthread_mutex_unlock(&r->lock);
+    if (notify) r->notify(r->userdata);
+}
+
+/* Read up to size bytes at off; short only at end of file */
+static int64_t read_full(zfo_reader_t* r, char* buf, size_t size, uint64_t off) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = pread(r->fd, buf + done, size - done, (off_t)(off + done));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return zfo_error_from_errno(errno);
+        }
+        if (n == 0) break;
+        done += (size_t)n;
+    }
+#ifdef POSIX_FADV_DONTNEED
+    if ((r->flags & ZFO_READER_DROP_CACHE) && done > 0) {
+        posix_fadvise(r->fd, (off_t)off, (off_t)done, POSIX_FADV_DONTNEED);
+    }
+#endif
+    ZFO_ATOMIC_ADD(&r->bytes_read, (uint64_t)done);
+    return (int64_t)done;
+}
+
+static void ahead(zfo_reader_t* r, uint64_t off) {
+    uint64_t window = (uint64_t)r->chunk_size * (uint64_t)r->slot_count;
+    uint64_t at = off + window;
+    if (at >= r->end) return;
+#ifdef __linux__
+    readahead(r->fd, (off64_t)at, r->chunk_size);
+#elif defined(POSIX_FADV_WILLNEED)
+    posix_fadvise(r->fd, (off_t)at, (off_t)r->chunk_size, POSIX_FADV_WILLNEED);
+#endif
+}
+
+static void produce_raw(zfo_reader_t* r) {
+    uint64_t off = r->start;
+    while (off < r->end) {
+        reader_slot_t* slot = wait_free(r);
+        if (!slot) return;
+
+        size_t want = r->end - off < r->chunk_size ? (size_t)(r->end - off) : r->chunk_size;
+        int64_t n = read_full(r, slot->buf, want, off);
+        if (n < 0) {
+            finish(r, (int)n);
+            return;
+        }
+        if (n == 0) break;
+        ahead(r, off);
+
+        publish(r, slot, (size_t)n, off);
+        off += (uint64_t)n;
+        if ((size_t)n < want) break;
+    }
+    finish(r, ZFO_OK);
+}
+
+/*
+ * Decoder state shared by both codecs. step() consumes input and fills
+ * output, setting *more while the current frame is incomplete.
+ */
+typedef struct {
+    ZSTD_DCtx* zstd;
+    LZ4F_dctx* lz4;
+} decoder_t;
+
+static int decoder_step(decoder_t* d, const char* in, size_t* in_pos, size_t in_size,
+                        char* out, size_t* out_pos, size_t out_size, bool* more) {
+    if (d->zstd) {
+        ZSTD_inBuffer zin = { in, in_size, *in_pos };
+        ZSTD_outBuffer zout = { out, out_size, *out_pos };
+        size_t ret = ZSTD_decompressStream(d->zstd, &zout, &zin);
+        if (ZSTD_isError(ret)) return ZFO_ERR_IO;
+        *in_pos = zin.pos;
+        *out_pos = zout.pos;
+        *more = ret != 0;
+        return ZFO_OK;
+    }
+
+    size_t src = in_size - *in_pos;
+    size_t dst = out_size - *out_pos;
+    size_t ret = LZ4F_decompress(d->lz4, out + *out_pos, &dst, in + *in_pos, &src, NULL);
+    if (LZ4F_isError(ret)) return ZFO_ERR_IO;
+    *in_pos += src;
+    *out_pos += dst;
+    *more = ret != 0;
+    return ZFO_OK;
+}
+
+static void produce_decoded(zfo_reader_t* r) {
+    decoder_t d = { NULL, NULL };
+    if (r->codec == ZFO_CODEC_ZSTD) {
+        d.zstd = ZSTD_createDCtx();
+    } else if (LZ4F_isError(LZ4F_createDecompressionContext(&d.lz4, LZ4F_VERSION))) {
+        d.lz4 = NULL;
+    }
+    char* in = malloc(r->chunk_size);
+    if ((!d.zstd && !d.lz4) || !in) {
+        free(in);
+        finish(r, ZFO_ERR_NO_MEMORY);
+        goto done;
+    }
+
+    size_t in_pos = 0, in_size = 0;
+    uint64_t file_off = r->start;
+    uint64_t out_off = 0;
+    bool in_eof = false;
+    bool more = false;
+    int rc = ZFO_OK;
+
+    reader_slot_t* slot = NULL;
+    size_t out_pos = 0;
+    for (;;) {
+        if (!slot) {
+            slot = wait_free(r);
+            if (!slot) break;
+            out_pos = 0;
+        }
+
+        if (in_pos == in_size && !in_eof) {
+            size_t want = r->end - file_off < r->chunk_size ? (size_t)(r->end - file_off) : r->chunk_size;
+            int64_t n = want ? read_full(r, in, want, file_off) : 0;
+            if (n < 0) {
+                rc = (int)n;
+                break;
+            }
+            in_pos = 0;
+            in_size = (size_t)n;
+            file_off += (uint64_t)n;
+            if (n == 0) in_eof = true;
+        }
+
+        size_t before = out_pos;
+        size_t consumed = in_pos;
+        bool step_more;
+        rc = decoder_step(&d, in, &in_pos, in_size, slot->buf, &out_pos, r->chunk_size, &step_more);
+        if (rc != ZFO_OK) break;
+        /* An idle call between frames asks for the next header; ignore it */
+        if (in_pos != consumed || out_pos != before) more = step_more;
+
+        if (out_pos == r->chunk_size) {
+            publish(r, slot, out_pos, out_off);
+            out_off += out_pos;
+            slot = NULL;
+            continue;
+        }
+        if (in_eof && in_pos == in_size && out_pos == before) {
+            /* Input exhausted and the decoder has nothing left to give */
+            if (more) rc = ZFO_ERR_IO;      /* Truncated frame */
+            if (out_pos > 0) publish(r, slot, out_pos, out_off);
+            break;
+        }
+    }
+    free(in);
+    finish(r, rc);
+
+done:
+    if (d.zstd) ZSTD_freeDCtx(d.zstd);
+    if (d.lz4) LZ4F_freeDecompressionContext(d.lz4);
+}
+
+static void* reader_thread(void* arg) {
+    zfo_reader_t* r = arg;
+    if (r->codec == ZFO_CODEC_NONE) {
+        produce_raw(r);
+    } else {
+        produce_decoded(r);
+    }
+    return NULL;
+}
+
+/* ============================================================
+ * Public API
+ * ============================================================ */
+
+int zfo_reader_open(const char* path, const zfo_reader_options_t* opts, zfo_reader_t** out) {
+    if (!path || !out) return ZFO_ERR_INVALID_ARG;
+    *out = NULL;
+
+    zfo_codec_t codec = opts ? opts->codec : ZFO_CODEC_NONE;
+    if (codec != ZFO_CODEC_NONE && codec != ZFO_CODEC_ZSTD && codec != ZFO_CODEC_LZ4) {
+        return ZFO_ERR_INVALID_ARG;
+    }
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return zfo_error_from_errno(errno);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int rc = zfo_error_from_errno(errno);
+        close(fd);
+        return rc;
+    }
+    if (S_ISDIR(st.st_mode)) {
+        close(fd);
+        return ZFO_ERR_IS_DIR;
+    }
+
+    zfo_reader_t* r = calloc(1, sizeof(zfo_reader_t));
+    if (!r) {
+        close(fd);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    r->fd = fd;
+    r->codec = codec;
+    r->flags = opts ? opts->flags : 0;
+    r->chunk_size = opts && opts->chunk_size ? opts->chunk_size : READER_DEFAULT_CHUNK;
+    r->slot_count = opts && opts->slots > 0 ? opts->slots : READER_DEFAULT_SLOTS;
+    if (r->slot_count > READER_MAX_SLOTS) r->slot_count = READER_MAX_SLOTS;
+    r->notify = opts ? opts->notify : NULL;
+    r->userdata = opts ? opts->userdata : NULL;
+    pthread_mutex_init(&r->lock, NULL);
+    pthread_cond_init(&r->cond, NULL);
+
+    uint64_t size = (uint64_t)st.st_size;
+    r->start = opts && opts->offset > 0 ? (uint64_t)opts->offset : 0;
+    if (r->start > size) r->start = size;
+    r->end = opts && opts->length > 0 && r->start + (uint64_t)opts->length < size
+           ? r->start + (uint64_t)opts->length : size;
+
+    r->slots = calloc((size_t)r->slot_count, sizeof(reader_slot_t));
+    int rc = r->slots ? ZFO_OK : ZFO_ERR_NO_MEMORY;
+    for (int i = 0; i < r->slot_count && rc == ZFO_OK; i++) {
+        void* buf;
+        if (posix_memalign(&buf, 4096, r->chunk_size) != 0) rc = ZFO_ERR_NO_MEMORY;
+        else r->slots[i].buf = buf;
+    }
+    if (rc != ZFO_OK) {
+        zfo_reader_close(r);
+        return rc;
+    }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, (off_t)r->start, (off_t)(r->end - r->start), POSIX_FADV_SEQUENTIAL);
+#endif
+#ifdef __linux__
+    readahead(fd, (off64_t)r->start, r->chunk_size * (size_t)r->slot_count);
+#endif
+
+    if (pthread_create(&r->thread, NULL, reader_thread, r) != 0) {
+        zfo_reader_close(r);
+        return ZFO_ERR_UNKNOWN;
+    }
+    r->started = true;
+
+    *out = r;
+    return ZFO_OK;
+}
+
+int zfo_reader_next(zfo_reader_t* r, zfo_chunk_t* chunk, bool wait) {
+    if (!r || !chunk) return ZFO_ERR_INVALID_ARG;
+    memset(chunk, 0, sizeof(*chunk));
+
+    pthread_mutex_lock(&r->lock);
+    reader_slot_t* slot;
+    for (;;) {
+        slot = find_slot_locked(r, SLOT_READY, r->consumed, false);
+        if (slot) break;
+        if (r->error) {
+            int rc = r->error;
+            pthread_mutex_unlock(&r->lock);
+            return rc;
+        }
+        if (r->eof && r->consumed == r->produced) {
+            pthread_mutex_unlock(&r->lock);
+            return ZFO_OK;          /* End of stream: chunk->data stays NULL */
+        }
+        if (!r->eof && !find_slot_locked(r, SLOT_FREE, 0, true) &&
+            !find_slot_locked(r, SLOT_FILLING, 0, true)) {
+            pthread_mutex_unlock(&r->lock);
+            return ZFO_ERR_BUSY;    /* Every buffer is held by the caller */
+        }
+        if (!wait) {
+            r->want_notify = true;
+            pthread_mutex_unlock(&r->lock);
+            return ZFO_ERR_TIMEOUT;
+        }
+        pthread_cond_wait(&r->cond, &r->lock);
+    }
+
+    slot->state = SLOT_HELD;
+    r->consumed++;
+    if (r->flags & ZFO_READER_HASH) r->hash = nxh_combine(r->hash, slot->hash);
+    pthread_mutex_unlock(&r->lock);
+
+    chunk->data = slot->buf;
+    chunk->len = slot->len;
+    chunk->offset = slot->offset;
+    chunk->seq = slot->seq;
+    chunk->hash = slot->hash;
+    return ZFO_OK;
+}
+
+void zfo_reader_release(zfo_reader_t* r, uint64_t seq) {
+    if (!r) return;
+    pthread_mutex_lock(&r->lock);
+    reader_slot_t* slot = find_slot_locked(r, SLOT_HELD, seq, false);
+    if (slot) {
+        slot->state = SLOT_FREE;
+        pthread_cond_broadcast(&r->cond);
+    }
+    pthread_mutex_unlock(&r->lock);
+}
+
+uint64_t zfo_reader_hash(zfo_reader_t* r) {
+    if (!r) return 0;
+    pthread_mutex_lock(&r->lock);
+    uint64_t hash = r->hash;
+    pthread_mutex_unlock(&r->lock);
+    return hash;
+}
+
+uint64_t zfo_reader_bytes_read(zfo_reader_t* r) {
+    return r ? ZFO_ATOMIC_LOAD(&r->bytes_read) : 0;
+}
+
+void zfo_reader_stop(zfo_reader_t* r) {
+    if (!r || !r->started) return;
+    pthread_mutex_lock(&r->lock);
+    r->stop = true;
+    pthread_cond_broadcast(&r->cond);
+    pthread_mutex_unlock(&r->lock);
+    pthread_join(r->thread, NULL);
+    r->started = false;
+}
+
+void zfo_reader_close(zfo_reader_t* r) {
+    if (!r) return;
+    zfo_reader_stop(r);
+    if (r->slots) {
+        for (int i = 0; i < r->slot_count; i++) free(r->slots[i].buf);
+        free(r->slots);
+    }
+    if (r->fd >= 0) close(r->fd);
+    pthread_cond_destroy(&r->cond);
+    pthread_mutex_destroy(&r->lock);
+    free(r);
+}
@@ -0,0 +1,1472 @@
+/**
+ * @file zorya_tar.c
+ * @brief Zorya FileOps - Tar archives with zstd/LZ4
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   ustar pack and unpack, with pax records where ustar runs out of
+ *   room, streamed straight through zstd or LZ4 frame compression.
+ *
+ *   Packing walks the tree on the parallel walker, sorts the entries
+ *   and feeds headers and file data through one encoder into the
+ *   archive. zstd compresses on its own worker threads meanwhile.
+ *
+ *   Unpacking decodes on a chunked reader thread. Small files are copied
+ *   out of the stream and written on a pool, with a cap on bytes in
+ *   flight; large ones are written inline. Directory modes and times and
+ *   all symlinks are applied last, so nothing is written through a link
+ *   the archive itself created.
+ *
+ *   Seekable archives close a frame at the first member boundary past
+ *   frame_size and end with an index in a skippable frame:
+ *
+ *     entries:  [u64 frame offset][u64 offset in frame][u16 len][name]
+ *     tail:     [u32 count][u32 payload size]["ZTARIDX1"]
+ *
+ *   zstd and LZ4 decoders both skip it, so the archive stays a plain
+ *   .tar.zst / .tar.lz4 to other tools.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+#include "zstd.h"
+#include "lz4frame.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#define TAR_BLOCK           512
+#define TAR_IO_SIZE         (1024 * 1024)
+#define TAR_FRAME_DEFAULT   (1024 * 1024)
+#define TAR_INLINE_LIMIT    (1024 * 1024)       /* Larger files skip the pool */
+#define TAR_IN_FLIGHT_MAX   (64 * 1024 * 1024)
+#define TAR_INDEX_MAGIC     "ZTARIDX1"
+#define TAR_SKIPPABLE_MAGIC 0x184D2A5Eu         /* zstd and LZ4 agree on these */
+#define TAR_ZSTD_MAGIC      0xFD2FB528u
+#define TAR_LZ4_MAGIC       0x184D2204u
+
+typedef struct {
+    char name[100];
+    char mode[8];
+    char uid[8];
+    char gid[8];
+    char size[12];
+    char mtime[12];
+    char chksum[8];
+    char typeflag;
+    char linkname[100];
+    char magic[6];
+    char version[2];
+    char uname[32];
+    char gname[32];
+    char devmajor[8];
+    char devminor[8];
+    char prefix[155];
+    char pad[12];
+} tar_header_t;
+
+/* ============================================================
+ * Header Fields
+ * ============================================================ */
+
+static void put_le32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static void put_le64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint32_t get_le32(const uint8_t* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint64_t get_le64(const uint8_t* p) {
+    return (uint64_t)get_le32(p) | (uint64_t)get_le32(p + 4) << 32;
+}
+
+/* Octal with a NUL terminator, or base-256 (GNU) when it doesn't fit */
+static void put_number(char* field, size_t width, uint64_t v) {
+    if (width >= 2 && v < (1ull << (3 * (width - 1)))) {
+        field[width - 1] = 0;
+        for (size_t i = width - 1; i-- > 0;) {
+            field[i] = (char)('0' + (v & 7));
+            v >>= 3;
+        }
+        return;
+    }
+    for (size_t i = width; i-- > 1;) {
+        field[i] = (char)(v & 0xff);
+        v >>= 8;
+    }
+    field[0] = (char)0x80;
+}
+
+static uint64_t get_number(const char* field, size_t width) {
+    uint64_t v = 0;
+    if ((unsigned char)field[0] & 0x80) {
+        v = (unsigned char)field[0] & 0x7f;
+        for (size_t i = 1; i < width; i++) v = (v << 8) | (unsigned char)field[i];
+        return v;
+    }
+    size_t i = 0;
+    while (i < width && (field[i] == ' ' || field[i] == 0)) i++;
+    for (; i < width && field[i] >= '0' && field[i] <= '7'; i++) v = (v << 3) | (uint64_t)(field[i] - '0');
+    return v;
+}
+
+static uint32_t header_checksum(const tar_header_t* h) {
+    const unsigned char* p = (const unsigned char*)h;
+    uint32_t sum = 0;
+    for (size_t i = 0; i < TAR_BLOCK; i++) {
+        bool in_field = i >= offsetof(tar_header_t, chksum) &&
+                        i < offsetof(tar_header_t, chksum) + sizeof(h->chksum);
+        sum += in_field ? ' ' : p[i];
+    }
+    return sum;
+}
+
+static void header_finish(tar_header_t* h) {
+    memcpy(h->magic, "ustar", 6);
+    memcpy(h->version, "00", 2);
+    uint32_t sum = header_checksum(h);
+    snprintf(h->chksum, sizeof(h->chksum), "%06o", sum);
+    h->chksum[7] = ' ';
+}
+
+static bool is_zero_block(const char* block) {
+    for (size_t i = 0; i < TAR_BLOCK; i++) {
+        if (block[i]) return false;
+    }
+    return true;
+}
+
+static uint64_t padded(uint64_t size) {
+    return (size + TAR_BLOCK - 1) & ~(uint64_t)(TAR_BLOCK - 1);
+}
+
+/* Split into prefix/name for ustar; false if pax is needed */
+static bool split_name(const char* path, tar_header_t* h) {
+    size_t len = strlen(path);
+    if (len <= sizeof(h->name)) {
+        memcpy(h->name, path, len);
+        return true;
+    }
+    for (size_t i = len - 1; i > 0; i--) {
+        if (path[i] != '/') continue;
+        if (i > sizeof(h->prefix)) continue;
+        if (len - i - 1 > sizeof(h->name) || len - i - 1 == 0) return false;
+        memcpy(h->prefix, path, i);
+        memcpy(h->name, path + i + 1, len - i - 1);
+        return true;
+    }
+    return false;
+}
+
+/* Append one "len key=value\n" record; len counts itself */
+static size_t pax_record(char* out, size_t cap, size_t used, const char* key, const char* value) {
+    size_t body = 1 + strlen(key) + 1 + strlen(value) + 1;
+    size_t len = body + 1;
+    while (snprintf(NULL, 0, "%zu", len) + body != len) len++;
+    if (used + len > cap) return used;
+    snprintf(out + used, cap - used + 1, "%zu %s=%s\n", len, key, value);
+    return used + len;
+}
+
+/* Remove ".", leading "/", strip components; reject ".." */
+static bool sanitize(const char* in, char* out, size_t cap, int strip) {
+    size_t o = 0;
+    const char* p = in;
+    while (*p) {
+        while (*p == '/') p++;
+        const char* seg = p;
+        while (*p && *p != '/') p++;
+        size_t len = (size_t)(p - seg);
+        if (len == 0 || (len == 1 && seg[0] == '.')) continue;
+        if (len == 2 && seg[0] == '.' && seg[1] == '.') return false;
+        if (strip > 0) {
+            strip--;
+            continue;
+        }
+        if (o + len + 2 > cap) return false;
+        if (o) out[o++] = '/';
+        memcpy(out + o, seg, len);
+        o += len;
+    }
+    out[o] = 0;
+    return o > 0;
+}
+
+/* ============================================================
+ * Encoder
+ * ============================================================ */
+
+typedef struct {
+    int fd;
+    zfo_codec_t codec;
+    ZSTD_CCtx* zstd;
+    LZ4F_cctx* lz4;
+    LZ4F_preferences_t prefs;
+    bool in_frame;
+    char* buf;
+    size_t len;
+    uint64_t flushed;       /* Bytes written to fd */
+    uint64_t frame_start;   /* Archive offset of the current frame */
+    uint64_t frame_in;      /* Uncompressed bytes in the current frame */
+    int rc;
+} tar_out_t;
+
+static int write_all(int fd, const void* buf, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        ssize_t n = write(fd, (const char*)buf + written, size - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return zfo_error_from_errno(errno);
+        }
+        written += (size_t)n;
+    }
+    return ZFO_OK;
+}
+
+static void out_flush(tar_out_t* o) {
+    if (o->rc == ZFO_OK && o->len) o->rc = write_all(o->fd, o->buf, o->len);
+    o->flushed += o->len;
+    o->len = 0;
+}
+
+static void out_room(tar_out_t* o, size_t need) {
+    if (TAR_IO_SIZE - o->len < need) out_flush(o);
+}
+
+static void out_put(tar_out_t* o, const void* data, size_t size) {
+    if (o->rc != ZFO_OK) return;
+    const char* src = data;
+    o->frame_in += size;
+
+    if (o->codec == ZFO_CODEC_NONE) {
+        while (size) {
+            size_t n = TAR_IO_SIZE - o->len < size ? TAR_IO_SIZE - o->len : size;
+            memcpy(o->buf + o->len, src, n);
+            o->len += n;
+            src += n;
+            size -= n;
+            if (o->len == TAR_IO_SIZE) out_flush(o);
+        }
+        return;
+    }
+
+    if (o->codec == ZFO_CODEC_ZSTD) {
+        ZSTD_inBuffer in = { src, size, 0 };
+        while (in.pos < in.size && o->rc == ZFO_OK) {
+            ZSTD_outBuffer out = { o->buf, TAR_IO_SIZE, o->len };
+            size_t ret = ZSTD_compressStream2(o->zstd, &out, &in, ZSTD_e_continue);
+            if (ZSTD_isError(ret)) {
+                o->rc = ZFO_ERR_IO;
+                return;
+            }
+            o->len = out.pos;
+            if (o->len == TAR_IO_SIZE) out_flush(o);
+        }
+        o->in_frame = true;
+        return;
+    }
+
+    if (!o->in_frame) {
+        out_room(o, LZ4F_HEADER_SIZE_MAX);
+        size_t n = LZ4F_compressBegin(o->lz4, o->buf + o->len, TAR_IO_SIZE - o->len, &o->prefs);
+        if (LZ4F_isError(n)) {
+            o->rc = ZFO_ERR_IO;
+            return;
+        }
+        o->len += n;
+        o->in_frame = true;
+    }
+    while (size && o->rc == ZFO_OK) {
+        size_t piece = size < 64 * 1024 ? size : 64 * 1024;
+        out_room(o, LZ4F_compressBound(piece, &o->prefs));
+        size_t n = LZ4F_compressUpdate(o->lz4, o->buf + o->len, TAR_IO_SIZE - o->len,
+                                       src, piece, NULL);
+        if (LZ4F_isError(n)) {
+            o->rc = ZFO_ERR_IO;
+            return;
+        }
+        o->len += n;
+        src += piece;
+        size -= piece;
+    }
+}
+
+static void out_end_frame(tar_out_t* o) {
+    if (o->rc != ZFO_OK || !o->in_frame) return;
+
+    if (o->codec == ZFO_CODEC_ZSTD) {
+        ZSTD_inBuffer in = { NULL, 0, 0 };
+        size_t ret;
+        do {
+            out_room(o, 1);
+            ZSTD_outBuffer out = { o->buf, TAR_IO_SIZE, o->len };
+            ret = ZSTD_compressStream2(o->zstd, &out, &in, ZSTD_e_end);
+            if (ZSTD_isError(ret)) {
+                o->rc = ZFO_ERR_IO;
+                return;
+            }
+            o->len = out.pos;
+        } while (ret != 0 && o->rc == ZFO_OK);
+    } else if (o->codec == ZFO_CODEC_LZ4) {
+        out_room(o, LZ4F_compressBound(0, &o->prefs));
+        size_t n = LZ4F_compressEnd(o->lz4, o->buf + o->len, TAR_IO_SIZE - o->len, NULL);
+        if (LZ4F_isError(n)) {
+            o->rc = ZFO_ERR_IO;
+            return;
+        }
+        o->len += n;
+    }
+    o->in_frame = false;
+    o->frame_start = o->flushed + o->len;
+    o->frame_in = 0;
+}
+
+static int out_init(tar_out_t* o, int fd, const zfo_tar_pack_options_t* opts) {
+    memset(o, 0, sizeof(*o));
+    o->fd = fd;
+    o->codec = opts->codec;
+    o->buf = malloc(TAR_IO_SIZE);
+    if (!o->buf) return ZFO_ERR_NO_MEMORY;
+
+    if (o->codec == ZFO_CODEC_ZSTD) {
+        o->zstd = ZSTD_createCCtx();
+        if (!o->zstd) return ZFO_ERR_NO_MEMORY;
+        ZSTD_CCtx_setParameter(o->zstd, ZSTD_c_compressionLevel,
+                               opts->level ? opts->level : ZSTD_CLEVEL_DEFAULT);
+        ZSTD_CCtx_setParameter(o->zstd, ZSTD_c_checksumFlag, 1);
+        /* Fails harmlessly on a single-threaded libzstd */
+        int workers = zfo_thread_count(opts->threads);
+        if (workers > 1) ZSTD_CCtx_setParameter(o->zstd, ZSTD_c_nbWorkers, workers);
+    } else if (o->codec == ZFO_CODEC_LZ4) {
+        if (LZ4F_isError(LZ4F_createCompressionContext(&o->lz4, LZ4F_VERSION))) {
+            o->lz4 = NULL;
+            return ZFO_ERR_NO_MEMORY;
+        }
+        o->prefs.compressionLevel = opts->level;
+        o->prefs.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+    }
+    return ZFO_OK;
+}
+
+static void out_free(tar_out_t* o) {
+    if (o->zstd) ZSTD_freeCCtx(o->zstd);
+    if (o->lz4) LZ4F_freeCompressionContext(o->lz4);
+    free(o->buf);
+}
+
+/* ============================================================
+ * Packing
+ * ============================================================ */
+
+typedef struct {
+    char* name;             /* Relative path */
+    char* link;             /* Symlink target */
+    zfo_file_type_t type;
+    uint32_t mode;
+    uint32_t uid;
+    uint32_t gid;
+    uint64_t size;
+    int64_t mtime;
+} tar_item_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    tar_item_t* items;
+    size_t count;
+    size_t cap;
+    size_t root_len;
+    uint64_t skipped;
+} tar_collect_t;
+
+static int collect_visit(const zfo_walk_entry_t* entry, void* userdata) {
+    tar_collect_t* c = userdata;
+    const zfo_stat_t* st = entry->stat;
+    if (!st || (st->type != ZFO_TYPE_FILE && st->type != ZFO_TYPE_DIR &&
+                st->type != ZFO_TYPE_SYMLINK)) {
+        return ZFO_WALK_CONTINUE;       /* Devices, fifos and sockets stay out */
+    }
+
+    tar_item_t item = {
+        .type = st->type,
+        .mode = st->mode & 07777,
+        .uid = st->uid,
+        .gid = st->gid,
+        .size = st->type == ZFO_TYPE_FILE ? (uint64_t)st->size : 0,
+        .mtime = st->mtime
+    };
+    const char* rel = entry->path + c->root_len;
+    while (*rel == '/') rel++;
+    item.name = strdup(rel);
+
+    if (st->type == ZFO_TYPE_SYMLINK) {
+        char target[PATH_MAX];
+        ssize_t n = readlinkat(entry->dir_fd, entry->name, target, sizeof(target) - 1);
+        if (n >= 0) {
+            target[n] = 0;
+            item.link = strdup(target);
+        }
+        if (!item.link) {
+            free(item.name);
+            ZFO_ATOMIC_ADD(&c->skipped, 1);
+            return ZFO_WALK_CONTINUE;
+        }
+    }
+
+    pthread_mutex_lock(&c->lock);
+    if (item.name && c->count == c->cap) {
+        size_t cap = c->cap ? c->cap * 2 : 256;
+        tar_item_t* grown = realloc(c->items, cap * sizeof(tar_item_t));
+        if (grown) {
+            c->items = grown;
+            c->cap = cap;
+        }
+    }
+    bool stored = item.name && c->count < c->cap;
+    if (stored) c->items[c->count++] = item;
+    pthread_mutex_unlock(&c->lock);
+
+    if (!stored) {
+        free(item.name);
+        free(item.link);
+        ZFO_ATOMIC_ADD(&c->skipped, 1);
+    }
+    return ZFO_WALK_CONTINUE;
+}
+
+static int item_compare(const void* a, const void* b) {
+    return strcmp(((const tar_item_t*)a)->name, ((const tar_item_t*)b)->name);
+}
+
+typedef struct {
+    uint8_t* data;
+    size_t len;
+    size_t cap;
+    uint32_t count;
+} tar_index_t;
+
+static void index_add(tar_index_t* idx, const char* name, uint64_t frame_off, uint64_t inner) {
+    size_t name_len = strlen(name);
+    if (name_len > UINT16_MAX) return;
+    size_t need = idx->len + 18 + name_len;
+    if (need > idx->cap) {
+        size_t cap = idx->cap ? idx->cap * 2 : 64 * 1024;
+        while (cap < need) cap *= 2;
+        uint8_t* grown = realloc(idx->data, cap);
+        if (!grown) return;             /* Member stays reachable by scanning */
+        idx->data = grown;
+        idx->cap = cap;
+    }
+    uint8_t* p = idx->data + idx->len;
+    put_le64(p, frame_off);
+    put_le64(p + 8, inner);
+    p[16] = (uint8_t)(name_len & 0xff);
+    p[17] = (uint8_t)(name_len >> 8);
+    memcpy(p + 18, name, name_len);
+    idx->len = need;
+    idx->count++;
+}
+
+static void write_index(tar_out_t* o, tar_index_t* idx) {
+    uint32_t payload = (uint32_t)idx->len + 16;
+    uint8_t head[8], tail[16];
+    put_le32(head, TAR_SKIPPABLE_MAGIC);
+    put_le32(head + 4, payload);
+    put_le32(tail, idx->count);
+    put_le32(tail + 4, payload);
+    memcpy(tail + 8, TAR_INDEX_MAGIC, 8);
+
+    /* Raw bytes between frames, outside the encoder */
+    out_flush(o);
+    if (o->rc == ZFO_OK) o->rc = write_all(o->fd, head, sizeof(head));
+    if (o->rc == ZFO_OK && idx->len) o->rc = write_all(o->fd, idx->data, idx->len);
+    if (o->rc == ZFO_OK) o->rc = write_all(o->fd, tail, sizeof(tail));
+    o->flushed += sizeof(head) + idx->len + sizeof(tail);
+}
+
+/* Headers for one member: a pax record set first if ustar can't hold it */
+static void put_headers(tar_out_t* o, const tar_item_t* item, const char* name) {
+    tar_header_t h;
+    memset(&h, 0, sizeof(h));
+
+    char pax[2 * PATH_MAX + 128];
+    size_t pax_len = 0;
+    if (!split_name(name, &h)) {
+        memset(&h, 0, sizeof(h));
+        memcpy(h.name, name, strlen(name) < sizeof(h.name) ? strlen(name) : sizeof(h.name));
+        pax_len = pax_record(pax, sizeof(pax) - 1, pax_len, "path", name);
+    }
+    if (item->link) {
+        size_t link_len = strlen(item->link);
+        if (link_len > sizeof(h.linkname)) {
+            pax_len = pax_record(pax, sizeof(pax) - 1, pax_len, "linkpath", item->link);
+            link_len = sizeof(h.linkname);
+        }
+        memcpy(h.linkname, item->link, link_len);
+    }
+    if (item->size >= (1ull << 33)) {
+        char num[24];
+        snprintf(num, sizeof(num), "%llu", (unsigned long long)item->size);
+        pax_len = pax_record(pax, sizeof(pax) - 1, pax_len, "size", num);
+    }
+
+    if (pax_len) {
+        tar_header_t x;
+        memset(&x, 0, sizeof(x));
+        snprintf(x.name, sizeof(x.name), "PaxHeaders/%.80s", strrchr(name, '/') ? strrchr(name, '/') + 1 : name);
+        put_number(x.mode, sizeof(x.mode), 0644);
+        put_number(x.uid, sizeof(x.uid), 0);
+        put_number(x.gid, sizeof(x.gid), 0);
+        put_number(x.size, sizeof(x.size), pax_len);
+        put_number(x.mtime, sizeof(x.mtime), (uint64_t)(item->mtime > 0 ? item->mtime : 0));
+        x.typeflag = 'x';
+        header_finish(&x);
+        out_put(o, &x, TAR_BLOCK);
+
+        char zero[TAR_BLOCK] = { 0 };
+        out_put(o, pax, pax_len);
+        out_put(o, zero, padded(pax_len) - pax_len);
+    }
+
+    put_number(h.mode, sizeof(h.mode), item->mode);
+    put_number(h.uid, sizeof(h.uid), item->uid);
+    put_number(h.gid, sizeof(h.gid), item->gid);
+    put_number(h.size, sizeof(h.size), item->size);
+    put_number(h.mtime, sizeof(h.mtime), (uint64_t)(item->mtime > 0 ? item->mtime : 0));
+    h.typeflag = item->type == ZFO_TYPE_DIR ? '5' : item->type == ZFO_TYPE_SYMLINK ? '2' : '0';
+    header_finish(&h);
+    out_put(o, &h, TAR_BLOCK);
+}
+
+/* Stream one file's data; a file that shrank is padded with zeros */
+static bool put_file_data(tar_out_t* o, int fd, uint64_t size, char* buf) {
+    uint64_t done = 0;
+    bool complete = true;
+    while (done < size && o->rc == ZFO_OK) {
+        size_t want = size - done < TAR_IO_SIZE ? (size_t)(size - done) : TAR_IO_SIZE;
+        ssize_t n = read(fd, buf, want);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            complete = false;
+            memset(buf, 0, want);
+            n = (ssize_t)want;
+        }
+        out_put(o, buf, (size_t)n);
+        done += (uint64_t)n;
+    }
+    char zero[TAR_BLOCK] = { 0 };
+    out_put(o, zero, padded(size) - size);
+    return complete;
+}
+
+int zfo_tar_pack(const char* root, const char* archive,
+                 const zfo_tar_pack_options_t* opts, zfo_tar_stats_t* stats) {
+    if (!root || !archive) return ZFO_ERR_INVALID_ARG;
+    zfo_tar_pack_options_t defaults = { 0 };
+    if (!opts) opts = &defaults;
+    zfo_tar_stats_t local;
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+
+    char base[PATH_MAX];
+    size_t root_len = strlen(root);
+    while (root_len > 1 && root[root_len - 1] == '/') root_len--;
+    if (root_len >= sizeof(base)) return ZFO_ERR_NAME_TOO_LONG;
+    memcpy(base, root, root_len);
+    base[root_len] = 0;
+
+    /* Gather every entry on the walker's pool, then fix the order */
+    tar_collect_t c = { .root_len = root_len };
+    pthread_mutex_init(&c.lock, NULL);
+    zfo_walk_options_t walk = {
+        .threads = opts->threads,
+        .max_depth = -1,
+        .flags = ZFO_WALK_STAT,
+        .visit = collect_visit,
+        .userdata = &c
+    };
+    if (opts->flags & ZFO_TAR_SKIP_HIDDEN) walk.flags |= ZFO_WALK_SKIP_HIDDEN;
+    if (opts->flags & ZFO_TAR_FOLLOW_SYMLINKS) walk.flags |= ZFO_WALK_FOLLOW_SYMLINKS;
+
+    zfo_tree_result_t walked = { 0 };
+    int rc = zfo_walk_parallel(base, &walk, &walked);
+    stats->errors = walked.error_count + c.skipped;
+    zfo_tree_result_free(&walked);
+    pthread_mutex_destroy(&c.lock);
+    if (rc != ZFO_OK && c.count == 0) {
+        free(c.items);
+        return rc;
+    }
+    qsort(c.items, c.count, sizeof(tar_item_t), item_compare);
+
+    int fd = open(archive, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    tar_out_t o;
+    rc = fd < 0 ? zfo_error_from_errno(errno) : out_init(&o, fd, opts);
+    char* data = rc == ZFO_OK ? malloc(TAR_IO_SIZE) : NULL;
+    if (rc == ZFO_OK && !data) rc = ZFO_ERR_NO_MEMORY;
+
+    bool seekable = (opts->flags & ZFO_TAR_SEEKABLE) && opts->codec != ZFO_CODEC_NONE;
+    size_t frame_size = opts->frame_size ? opts->frame_size : TAR_FRAME_DEFAULT;
+    tar_index_t idx = { 0 };
+    char name[PATH_MAX + 1];
+
+    for (size_t i = 0; rc == ZFO_OK && i < c.count && o.rc == ZFO_OK; i++) {
+        tar_item_t* item = &c.items[i];
+        int src = -1;
+        if (item->type == ZFO_TYPE_FILE) {
+            char path[PATH_MAX];
+            int nofollow = (opts->flags & ZFO_TAR_FOLLOW_SYMLINKS) ? 0 : O_NOFOLLOW;
+            if ((size_t)snprintf(path, sizeof(path), "%s/%s", base, item->name) < sizeof(path)) {
+                src = open(path, O_RDONLY | O_CLOEXEC | nofollow);
+            }
+            if (src < 0) {
+                stats->errors++;        /* Vanished or unreadable since the walk */
+                continue;
+            }
+#ifdef POSIX_FADV_SEQUENTIAL
+            posix_fadvise(src, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        }
+
+        snprintf(name, sizeof(name), "%s%s", item->name, item->type == ZFO_TYPE_DIR ? "/" : "");
+        if (seekable) {
+            if (o.frame_in >= frame_size) out_end_frame(&o);
+            index_add(&idx, item->name, o.frame_start, o.frame_in);
+        }
+        put_headers(&o, item, name);
+
+        if (src >= 0) {
+            if (!put_file_data(&o, src, item->size, data)) stats->errors++;
+            close(src);
+            stats->files++;
+            stats->bytes += item->size;
+        } else if (item->type == ZFO_TYPE_DIR) {
+            stats->dirs++;
+        } else {
+            stats->links++;
+        }
+    }
+
+    if (rc == ZFO_OK) {
+        char end[2 * TAR_BLOCK] = { 0 };
+        out_put(&o, end, sizeof(end));
+        out_end_frame(&o);
+        if (seekable) write_index(&o, &idx);
+        out_flush(&o);
+        rc = o.rc;
+        stats->archive_bytes = o.flushed;
+    }
+    if (fd >= 0) out_free(&o);
+    if (fd >= 0 && close(fd) != 0 && rc == ZFO_OK) rc = zfo_error_from_errno(errno);
+    if (rc != ZFO_OK && fd >= 0) unlink(archive);
+
+    for (size_t i = 0; i < c.count; i++) {
+        free(c.items[i].name);
+        free(c.items[i].link);
+    }
+    free(c.items);
+    free(idx.data);
+    free(data);
+    return rc;
+}
+
+/* ============================================================
+ * Archive Input
+ * ============================================================ */
+
+/*
+ * Decoded stream over a chunked reader, or raw positioned reads for an
+ * uncompressed archive so that skipping file data costs nothing.
+ */
+typedef struct {
+    zfo_reader_t* reader;
+    zfo_chunk_t chunk;
+    size_t pos;
+    bool held;
+    int fd;
+    char* window;
+    uint64_t win_off;
+    size_t win_len;
+    uint64_t off;
+} tar_in_t;
+
+static int in_avail(tar_in_t* in, const char** p, size_t* n) {
+    if (in->reader) {
+        if (!in->held || in->pos == in->chunk.len) {
+            if (in->held) zfo_reader_release(in->reader, in->chunk.seq);
+            in->held = false;
+            int rc = zfo_reader_next(in->reader, &in->chunk, true);
+            if (rc != ZFO_OK) return rc;
+            if (!in->chunk.data) {
+                *n = 0;
+                return ZFO_OK;
+            }
+            in->held = true;
+            in->pos = 0;
+        }
+        *p = (const char*)in->chunk.data + in->pos;
+        *n = in->chunk.len - in->pos;
+        return ZFO_OK;
+    }
+
+    if (in->off < in->win_off || in->off >= in->win_off + in->win_len) {
+        ssize_t got;
+        do {
+            got = pread(in->fd, in->window, TAR_IO_SIZE, (off_t)in->off);
+        } while (got < 0 && errno == EINTR);
+        if (got < 0) return zfo_error_from_errno(errno);
+        in->win_off = in->off;
+        in->win_len = (size_t)got;
+        if (got == 0) {
+            *n = 0;
+            return ZFO_OK;
+        }
+    }
+    *p = in->window + (in->off - in->win_off);
+    *n = in->win_len - (size_t)(in->off - in->win_off);
+    return ZFO_OK;
+}
+
+static void in_consume(tar_in_t* in, size_t n) {
+    if (in->reader) {
+        in->pos += n;
+    } else {
+        in->off += n;
+    }
+}
+
+static int in_read(tar_in_t* in, void* dst, size_t size) {
+    char* out = dst;
+    while (size) {
+        const char* p = NULL;
+        size_t n = 0;
+        int rc = in_avail(in, &p, &n);
+        if (rc != ZFO_OK) return rc;
+        if (n == 0) return ZFO_ERR_IO;          /* Truncated archive */
+        if (n > size) n = size;
+        memcpy(out, p, n);
+        in_consume(in, n);
+        out += n;
+        size -= n;
+    }
+    return ZFO_OK;
+}
+
+static int in_skip(tar_in_t* in, uint64_t size) {
+    if (!in->reader) {
+        in->off += size;
+        return ZFO_OK;
+    }
+    while (size) {
+        const char* p = NULL;
+        size_t n = 0;
+        int rc = in_avail(in, &p, &n);
+        if (rc != ZFO_OK) return rc;
+        if (n == 0) return ZFO_ERR_IO;
+        if (n > size) n = (size_t)size;
+        in_consume(in, n);
+        size -= n;
+    }
+    return ZFO_OK;
+}
+
+static zfo_codec_t detect_codec(int fd) {
+    uint8_t magic[4];
+    if (pread(fd, magic, sizeof(magic), 0) != (ssize_t)sizeof(magic)) return ZFO_CODEC_NONE;
+    uint32_t m = get_le32(magic);
+    if (m == TAR_ZSTD_MAGIC) return ZFO_CODEC_ZSTD;
+    if (m == TAR_LZ4_MAGIC) return ZFO_CODEC_LZ4;
+    return ZFO_CODEC_NONE;
+}
+
+static int in_open(tar_in_t* in, const char* archive, zfo_codec_t codec, uint64_t offset,
+                   size_t chunk_size) {
+    memset(in, 0, sizeof(*in));
+    in->fd = -1;
+    if (codec != ZFO_CODEC_NONE) {
+        zfo_reader_options_t ropts = {
+            .chunk_size = chunk_size,
+            .offset = (zfo_off_t)offset,
+            .codec = codec
+        };
+        return zfo_reader_open(archive, &ropts, &in->reader);
+    }
+    in->fd = open(archive, O_RDONLY | O_CLOEXEC);
+    if (in->fd < 0) return zfo_error_from_errno(errno);
+    in->window = malloc(TAR_IO_SIZE);
+    if (!in->window) {
+        close(in->fd);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    in->off = offset;
+    return ZFO_OK;
+}
+
+static uint64_t in_close(tar_in_t* in) {
+    uint64_t consumed = in->off;
+    if (in->reader) {
+        consumed = zfo_reader_bytes_read(in->reader);
+        zfo_reader_close(in->reader);
+    }
+    if (in->fd >= 0) close(in->fd);
+    free(in->window);
+    return consumed;
+}
+
+/* ============================================================
+ * Member Headers
+ * ============================================================ */
+
+typedef struct {
+    char name[PATH_MAX];
+    char link[PATH_MAX];
+    char type;
+    uint32_t mode;
+    uint64_t size;          /* Data bytes that follow the header */
+    int64_t mtime;
+    long mtime_ns;
+    bool too_long;
+} tar_entry_t;
+
+static void pax_apply(const char* data, size_t len, tar_entry_t* e,
+                      bool* has_path, bool* has_link, bool* has_size, bool* has_mtime) {
+    size_t pos = 0;
+    while (pos < len) {
+        char* end;
+        unsigned long rec = strtoul(data + pos, &end, 10);
+        if (rec == 0 || pos + rec > len || *end != ' ') return;
+        const char* key = end + 1;
+        const char* eq = memchr(key, '=', data + pos + rec - key);
+        if (!eq) return;
+        size_t key_len = (size_t)(eq - key);
+        const char* val = eq + 1;
+        size_t val_len = (size_t)(data + pos + rec - 1 - val);
+
+        char value[PATH_MAX];
+        bool fits = val_len < sizeof(value);
+        if (fits) {
+            memcpy(value, val, val_len);
+            value[val_len] = 0;
+        }
+        if (key_len == 4 && memcmp(key, "path", 4) == 0) {
+            if (fits) memcpy(e->name, value, val_len + 1);
+            else e->too_long = true;
+            *has_path = true;
+        } else if (key_len == 8 && memcmp(key, "linkpath", 8) == 0) {
+            if (fits) memcpy(e->link, value, val_len + 1);
+            else e->too_long = true;
+            *has_link = true;
+        } else if (key_len == 4 && memcmp(key, "size", 4) == 0 && fits) {
+            e->size = strtoull(value, NULL, 10);
+            *has_size = true;
+        } else if (key_len == 5 && memcmp(key, "mtime", 5) == 0 && fits) {
+            e->mtime = strtoll(value, &end, 10);
+            e->mtime_ns = 0;
+            if (*end == '.') {
+                long scale = 100000000;
+                for (const char* d = end + 1; *d >= '0' && *d <= '9' && scale; d++, scale /= 10) {
+                    e->mtime_ns += (*d - '0') * scale;
+                }
+            }
+            *has_mtime = true;
+        }
+        pos += rec;
+    }
+}
+
+/* Extension payload (pax or GNU long name) into memory */
+static int read_payload(tar_in_t* in, uint64_t size, char** out) {
+    if (size > 16 * 1024 * 1024) return ZFO_ERR_IO;
+    *out = malloc((size_t)size + 1);
+    if (!*out) return ZFO_ERR_NO_MEMORY;
+    int rc = in_read(in, *out, (size_t)size);
+    if (rc == ZFO_OK) rc = in_skip(in, padded(size) - size);
+    (*out)[size] = 0;
+    return rc;
+}
+
+/*
+ * Next member, folding pax ('x'), global ('g', ignored) and GNU long
+ * name ('L'/'K') headers into it. *end is set at the end-of-archive
+ * marker or a clean end of stream.
+ */
+static int read_entry(tar_in_t* in, tar_entry_t* e, bool* end) {
+    bool has_path = false, has_link = false, has_size = false, has_mtime = false;
+    memset(e, 0, sizeof(*e));
+    *end = false;
+
+    for (;;) {
+        char block[TAR_BLOCK];
+        const char* p = NULL;
+        size_t n = 0;
+        int rc = in_avail(in, &p, &n);
+        if (rc != ZFO_OK) return rc;
+        if (n == 0) {
+            *end = true;
+            return ZFO_OK;
+        }
+        rc = in_read(in, block, TAR_BLOCK);
+        if (rc != ZFO_OK) return rc;
+        if (is_zero_block(block)) {
+            *end = true;
+            return ZFO_OK;
+        }
+
+        tar_header_t* h = (tar_header_t*)block;
+        if (get_number(h->chksum, sizeof(h->chksum)) != header_checksum(h)) return ZFO_ERR_IO;
+        uint64_t size = get_number(h->size, sizeof(h->size));
+
+        if (h->typeflag == 'x' || h->typeflag == 'g' || h->typeflag == 'L' || h->typeflag == 'K') {
+            char* payload = NULL;
+            rc = read_payload(in, size, &payload);
+            if (rc == ZFO_OK && h->typeflag == 'x') {
+                pax_apply(payload, (size_t)size, e, &has_path, &has_link, &has_size, &has_mtime);
+            } else if (rc == ZFO_OK && h->typeflag != 'g') {
+                char* dst = h->typeflag == 'L' ? e->name : e->link;
+                size_t len = strnlen(payload, (size_t)size);
+                if (len < PATH_MAX) memcpy(dst, payload, len + 1);
+                else e->too_long = true;
+                if (h->typeflag == 'L') has_path = true;
+                else has_link = true;
+            }
+            free(payload);
+            if (rc != ZFO_OK) return rc;
+            continue;
+        }
+
+        if (!has_path) {
+            size_t name_len = strnlen(h->name, sizeof(h->name));
+            size_t prefix_len = memcmp(h->magic, "ustar", 5) == 0
+                ? strnlen(h->prefix, sizeof(h->prefix)) : 0;
+            size_t o = 0;
+            if (prefix_len) {
+                memcpy(e->name, h->prefix, prefix_len);
+                e->name[prefix_len] = '/';
+                o = prefix_len + 1;
+            }
+            memcpy(e->name + o, h->name, name_len);
+            e->name[o + name_len] = 0;
+        }
+        if (!has_link) {
+            size_t link_len = strnlen(h->linkname, sizeof(h->linkname));
+            memcpy(e->link, h->linkname, link_len);
+            e->link[link_len] = 0;
+        }
+        if (!has_size) e->size = size;
+        if (!has_mtime) e->mtime = (int64_t)get_number(h->mtime, sizeof(h->mtime));
+        e->mode = (uint32_t)get_number(h->mode, sizeof(h->mode)) & 07777;
+        e->type = h->typeflag ? h->typeflag : '0';
+        /* Links and directories carry no data whatever size says */
+        if (e->type == '1' || e->type == '2' || e->type == '5') e->size = 0;
+        return ZFO_OK;
+    }
+}
+
+/* ============================================================
+ * Output Files
+ * ============================================================ */
+
+static int open_output(const char* path) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW | O_CLOEXEC, 0600);
+    if (fd < 0 && (errno == ELOOP || errno == EISDIR || errno == ETXTBSY)) {
+        /* Replace a symlink or whatever else is in the way */
+        if (errno == EISDIR) rmdir(path);
+        else unlink(path);
+        fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW | O_CLOEXEC, 0600);
+    }
+    return fd;
+}
+
+static int finish_output(int fd, uint32_t mode, int64_t mtime, long mtime_ns) {
+    struct timespec times[2] = { { 0, UTIME_OMIT }, { (time_t)mtime, mtime_ns } };
+    int rc = ZFO_OK;
+    if (fchmod(fd, mode) != 0 || futimens(fd, times) != 0) rc = zfo_error_from_errno(errno);
+    if (close(fd) != 0 && rc == ZFO_OK) rc = zfo_error_from_errno(errno);
+    return rc;
+}
+
+/*
+ * Stream size bytes from the archive into fd and skip the padding.
+ * Returns archive errors; a failed write goes to *write_rc and the
+ * data is still consumed so the stream stays in step.
+ */
+static int copy_data(tar_in_t* in, int fd, uint64_t size, int* write_rc) {
+    *write_rc = ZFO_OK;
+    uint64_t left = size;
+    while (left) {
+        const char* p = NULL;
+        size_t n = 0;
+        int rc = in_avail(in, &p, &n);
+        if (rc != ZFO_OK) return rc;
+        if (n == 0) return ZFO_ERR_IO;
+        if (n > left) n = (size_t)left;
+        if (*write_rc == ZFO_OK) *write_rc = write_all(fd, p, n);
+        in_consume(in, n);
+        left -= n;
+    }
+    return in_skip(in, padded(size) - size);
+}
+
+/* ============================================================
+ * Unpacking
+ * ============================================================ */
+
+typedef struct {
+    char* path;
+    char* link;
+    uint32_t mode;
+    int64_t mtime;
+    long mtime_ns;
+} tar_deferred_t;
+
+typedef struct {
+    zfo_pool_t* pool;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    size_t in_flight;
+    uint64_t errors;
+    tar_deferred_t* dirs;
+    size_t dir_count, dir_cap;
+    tar_deferred_t* links;
+    size_t link_count, link_cap;
+    char parent[PATH_MAX];          /* Last directory known to exist */
+} tar_unpack_t;
+
+typedef struct {
+    tar_unpack_t* u;
+    char* path;
+    char* data;
+    size_t size;
+    uint32_t mode;
+    int64_t mtime;
+    long mtime_ns;
+} tar_write_task_t;
+
+static void write_task(zfo_pool_t* pool, int worker, void* arg) {
+    (void)pool;
+    (void)worker;
+    tar_write_task_t* t = arg;
+    int fd = open_output(t->path);
+    int rc = fd < 0 ? zfo_error_from_errno(errno) : write_all(fd, t->data, t->size);
+    if (fd >= 0) {
+        int fin = finish_output(fd, t->mode, t->mtime, t->mtime_ns);
+        if (rc == ZFO_OK) rc = fin;
+    }
+    if (rc != ZFO_OK) ZFO_ATOMIC_ADD(&t->u->errors, 1);
+
+    pthread_mutex_lock(&t->u->lock);
+    t->u->in_flight -= t->size;
+    pthread_cond_signal(&t->u->cond);
+    pthread_mutex_unlock(&t->u->lock);
+
+    free(t->data);
+    free(t->path);
+    free(t);
+}
+
+static bool defer(tar_deferred_t** list, size_t* count, size_t* cap, const char* path,
+                  const tar_entry_t* e) {
+    if (*count == *cap) {
+        size_t ncap = *cap ? *cap * 2 : 64;
+        tar_deferred_t* grown = realloc(*list, ncap * sizeof(tar_deferred_t));
+        if (!grown) return false;
+        *list = grown;
+        *cap = ncap;
+    }
+    tar_deferred_t* d = &(*list)[*count];
+    d->path = strdup(path);
+    d->link = e->type == '2' ? strdup(e->link) : NULL;
+    d->mode = e->mode;
+    d->mtime = e->mtime;
+    d->mtime_ns = e->mtime_ns;
+    if (!d->path || (e->type == '2' && !d->link)) {
+        free(d->path);
+        free(d->link);
+        return false;
+    }
+    (*count)++;
+    return true;
+}
+
+static int ensure_parent(tar_unpack_t* u, const char* path) {
+    const char* slash = strrchr(path, '/');
+    if (!slash) return ZFO_OK;
+    size_t len = (size_t)(slash - path);
+    if (len == strlen(u->parent) && memcmp(u->parent, path, len) == 0) return ZFO_OK;
+
+    char dir[PATH_MAX];
+    memcpy(dir, path, len);
+    dir[len] = 0;
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+        int rc = zfo_mkdir_p(dir, 0755);
+        if (rc != ZFO_OK) return rc;
+    }
+    memcpy(u->parent, dir, len + 1);
+    return ZFO_OK;
+}
+
+static void drain(tar_unpack_t* u) {
+    zfo_pool_wait(u->pool, 0, NULL, NULL);
+}
+
+static void restore_member(tar_unpack_t* u, tar_in_t* in, const tar_entry_t* e,
+                           const char* path, zfo_tar_stats_t* stats, int* fatal) {
+    if (ensure_parent(u, path) != ZFO_OK && e->type != '5') {
+        u->errors++;
+        *fatal = in_skip(in, padded(e->size));
+        return;
+    }
+
+    switch (e->type) {
+        case '5':
+            if (mkdir(path, 0700) != 0 && errno != EEXIST && zfo_mkdir_p(path, 0700) != ZFO_OK) {
+                u->errors++;
+            } else if (!defer(&u->dirs, &u->dir_count, &u->dir_cap, path, e)) {
+                u->errors++;
+            }
+            stats->dirs++;
+            return;
+
+        case '2':
+            if (!defer(&u->links, &u->link_count, &u->link_cap, path, e)) u->errors++;
+            stats->links++;
+            return;
+
+        case '1':
+            /* The target may still be queued on the pool */
+            drain(u);
+            unlink(path);
+            if (link(e->link, path) != 0) u->errors++;
+            stats->links++;
+            return;
+
+        case '0':
+        case '7':
+            break;
+
+        default:
+            /* Devices and fifos are not restored */
+            u->errors++;
+            *fatal = in_skip(in, padded(e->size));
+            return;
+    }
+
+    stats->files++;
+    stats->bytes += e->size;
+
+    if (e->size > TAR_INLINE_LIMIT) {
+        int fd = open_output(path);
+        if (fd < 0) {
+            u->errors++;
+            *fatal = in_skip(in, padded(e->size));
+            return;
+        }
+        int write_rc;
+        *fatal = copy_data(in, fd, e->size, &write_rc);
+        int fin = finish_output(fd, e->mode, e->mtime, e->mtime_ns);
+        if (write_rc != ZFO_OK || fin != ZFO_OK) u->errors++;
+        return;
+    }
+
+    tar_write_task_t* t = calloc(1, sizeof(tar_write_task_t));
+    char* data = malloc(e->size ? (size_t)e->size : 1);
+    char* copy = strdup(path);
+    if (!t || !data || !copy) {
+        free(t);
+        free(data);
+        free(copy);
+        u->errors++;
+        *fatal = in_skip(in, padded(e->size));
+        return;
+    }
+    *fatal = in_read(in, data, (size_t)e->size);
+    if (*fatal == ZFO_OK) *fatal = in_skip(in, padded(e->size) - e->size);
+    if (*fatal != ZFO_OK) {
+        free(t);
+        free(data);
+        free(copy);
+        return;
+    }
+
+    pthread_mutex_lock(&u->lock);
+    while (u->in_flight && u->in_flight + e->size > TAR_IN_FLIGHT_MAX) {
+        pthread_cond_wait(&u->cond, &u->lock);
+    }
+    u->in_flight += e->size;
+    pthread_mutex_unlock(&u->lock);
+
+    *t = (tar_write_task_t){ u, copy, data, (size_t)e->size, e->mode, e->mtime, e->mtime_ns };
+    if (zfo_pool_submit(u->pool, -1, write_task, t) != ZFO_OK) {
+        write_task(u->pool, -1, t);
+    }
+}
+
+/* Symlinks, then directory modes and times deepest-first */
+static void apply_deferred(tar_unpack_t* u) {
+    for (size_t i = 0; i < u->link_count; i++) {
+        tar_deferred_t* d = &u->links[i];
+        unlink(d->path);
+        struct timespec times[2] = { { 0, UTIME_OMIT }, { (time_t)d->mtime, d->mtime_ns } };
+        if (symlink(d->link, d->path) != 0) {
+            u->errors++;
+        } else {
+            utimensat(AT_FDCWD, d->path, times, AT_SYMLINK_NOFOLLOW);
+        }
+    }
+    for (size_t i = u->dir_count; i-- > 0;) {
+        tar_deferred_t* d = &u->dirs[i];
+        struct timespec times[2] = { { 0, UTIME_OMIT }, { (time_t)d->mtime, d->mtime_ns } };
+        if (chmod(d->path, d->mode) != 0 || utimensat(AT_FDCWD, d->path, times, 0) != 0) {
+            u->errors++;
+        }
+    }
+}
+
+static void free_deferred(tar_deferred_t* list, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        free(list[i].path);
+        free(list[i].link);
+    }
+    free(list);
+}
+
+int zfo_tar_unpack(const char* archive, const char* dest,
+                   const zfo_tar_unpack_options_t* opts, zfo_tar_stats_t* stats) {
+    if (!archive || !dest) return ZFO_ERR_INVALID_ARG;
+    zfo_tar_unpack_options_t defaults = { 0 };
+    if (!opts) opts = &defaults;
+    zfo_tar_stats_t local;
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+
+    int rc = zfo_mkdir_p(dest, 0755);
+    if (rc != ZFO_OK) return rc;
+
+    int probe = open(archive, O_RDONLY | O_CLOEXEC);
+    if (probe < 0) return zfo_error_from_errno(errno);
+    zfo_codec_t codec = detect_codec(probe);
+    close(probe);
+
+    tar_in_t in;
+    rc = in_open(&in, archive, codec, 0, 0);
+    if (rc != ZFO_OK) return rc;
+
+    tar_unpack_t u;
+    memset(&u, 0, sizeof(u));
+    u.pool = zfo_pool_create(opts->threads);
+    if (!u.pool) {
+        in_close(&in);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    pthread_mutex_init(&u.lock, NULL);
+    pthread_cond_init(&u.cond, NULL);
+
+    size_t dest_len = strlen(dest);
+    while (dest_len > 1 && dest[dest_len - 1] == '/') dest_len--;
+
+    tar_entry_t* e = malloc(sizeof(tar_entry_t));
+    if (!e) rc = ZFO_ERR_NO_MEMORY;
+    while (rc == ZFO_OK) {
+        bool end;
+        rc = read_entry(&in, e, &end);
+        if (rc != ZFO_OK || end) break;
+
+        char rel[PATH_MAX], path[PATH_MAX];
+        if (e->too_long || !sanitize(e->name, rel, sizeof(rel), opts->strip) ||
+            dest_len + 1 + strlen(rel) >= sizeof(path)) {
+            /* Unsafe or unusable name; stripped-away entries aren't errors */
+            if (e->too_long || strstr(e->name, "..")) u.errors++;
+            rc = in_skip(&in, padded(e->size));
+            continue;
+        }
+        memcpy(path, dest, dest_len);
+        path[dest_len] = '/';
+        strcpy(path + dest_len + 1, rel);
+
+        if (e->type == '1') {
+            /* Hard link targets are archive paths, resolved under dest */
+            char target[PATH_MAX];
+            if (!sanitize(e->link, target, sizeof(target), opts->strip) ||
+                dest_len + 1 + strlen(target) >= sizeof(e->link)) {
+                u.errors++;
+                continue;
+            }
+            memcpy(e->link, dest, dest_len);
+            e->link[dest_len] = '/';
+            strcpy(e->link + dest_len + 1, target);
+        }
+
+        int fatal = ZFO_OK;
+        restore_member(&u, &in, e, path, stats, &fatal);
+        rc = fatal;
+    }
+    free(e);
+
+    drain(&u);
+    if (rc == ZFO_OK) apply_deferred(&u);
+    stats->errors = u.errors;
+    stats->archive_bytes = in_close(&in);
+
+    free_deferred(u.dirs, u.dir_count);
+    free_deferred(u.links, u.link_count);
+    zfo_pool_destroy(u.pool);
+    pthread_cond_destroy(&u.cond);
+    pthread_mutex_destroy(&u.lock);
+    return rc;
+}
+
+/* ============================================================
+ * Single-Member Extraction
+ * ============================================================ */
+
+/* Look member up in a seekable archive's trailing index */
+static int index_find(int fd, const char* member, uint64_t* frame_off, uint64_t* inner) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) return zfo_error_from_errno(errno);
+    if (st.st_size < 24) return ZFO_ERR_NOT_FOUND;
+
+    uint8_t tail[16];
+    if (pread(fd, tail, sizeof(tail), st.st_size - 16) != (ssize_t)sizeof(tail) ||
+        memcmp(tail + 8, TAR_INDEX_MAGIC, 8) != 0) {
+        return ZFO_ERR_NOT_FOUND;
+    }
+    uint32_t count = get_le32(tail);
+    uint32_t payload = get_le32(tail + 4);
+    if (payload < 16 || (uint64_t)payload + 8 > (uint64_t)st.st_size) return ZFO_ERR_NOT_FOUND;
+
+    uint8_t head[8];
+    off_t start = st.st_size - payload - 8;
+    if (pread(fd, head, sizeof(head), start) != (ssize_t)sizeof(head) ||
+        get_le32(head) != TAR_SKIPPABLE_MAGIC || get_le32(head + 4) != payload) {
+        return ZFO_ERR_NOT_FOUND;
+    }
+
+    size_t len = payload - 16;
+    uint8_t* data = malloc(len ? len : 1);
+    if (!data) return ZFO_ERR_NO_MEMORY;
+    if (pread(fd, data, len, start + 8) != (ssize_t)len) {
+        free(data);
+        return ZFO_ERR_IO;
+    }
+
+    size_t member_len = strlen(member);
+    int rc = ZFO_ERR_NOT_FOUND;
+    size_t pos = 0;
+    for (uint32_t i = 0; i < count && pos + 18 <= len; i++) {
+        size_t name_len = data[pos + 16] | (size_t)data[pos + 17] << 8;
+        if (pos + 18 + name_len > len) break;
+        if (name_len == member_len && memcmp(data + pos + 18, member, name_len) == 0) {
+            *frame_off = get_le64(data + pos);
+            *inner = get_le64(data + pos + 8);
+            rc = ZFO_OK;
+            break;
+        }
+        pos += 18 + name_len;
+    }
+    free(data);
+    return rc;
+}
+
+static int write_member(tar_in_t* in, const tar_entry_t* e, const char* out_path) {
+    char parent[PATH_MAX];
+    snprintf(parent, sizeof(parent), "%s", out_path);
+    char* slash = strrchr(parent, '/');
+    if (slash && slash != parent) {
+        *slash = 0;
+        int rc = zfo_mkdir_p(parent, 0755);
+        if (rc != ZFO_OK) return rc;
+    }
+
+    struct timespec times[2] = { { 0, UTIME_OMIT }, { (time_t)e->mtime, e->mtime_ns } };
+    switch (e->type) {
+        case '0':
+        case '7': {
+            int fd = open_output(out_path);
+            if (fd < 0) return zfo_error_from_errno(errno);
+            int write_rc;
+            int rc = copy_data(in, fd, e->size, &write_rc);
+            int fin = finish_output(fd, e->mode, e->mtime, e->mtime_ns);
+            if (rc != ZFO_OK) return rc;
+            return write_rc != ZFO_OK ? write_rc : fin;
+        }
+        case '5':
+            if (mkdir(out_path, e->mode | 0700) != 0 && errno != EEXIST) {
+                return zfo_error_from_errno(errno);
+            }
+            if (chmod(out_path, e->mode) != 0 || utimensat(AT_FDCWD, out_path, times, 0) != 0) {
+                return zfo_error_from_errno(errno);
+            }
+            return ZFO_OK;
+        case '2':
+            unlink(out_path);
+            if (symlink(e->link, out_path) != 0) return zfo_error_from_errno(errno);
+            utimensat(AT_FDCWD, out_path, times, AT_SYMLINK_NOFOLLOW);
+            return ZFO_OK;
+        default:
+            return ZFO_ERR_UNSUPPORTED;     /* Hard links, devices, fifos */
+    }
+}
+
+int zfo_tar_extract(const char* archive, const char* member, const char* out_path) {
+    if (!archive || !member || !out_path) return ZFO_ERR_INVALID_ARG;
+
+    char want[PATH_MAX];
+    if (!sanitize(member, want, sizeof(want), 0)) return ZFO_ERR_INVALID_ARG;
+
+    int fd = open(archive, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return zfo_error_from_errno(errno);
+    zfo_codec_t codec = detect_codec(fd);
+    uint64_t frame_off = 0, inner = 0;
+    if (codec != ZFO_CODEC_NONE && index_find(fd, want, &frame_off, &inner) != ZFO_OK) {
+        frame_off = inner = 0;          /* Not seekable: scan from the start */
+    }
+    close(fd);
+
+    /* Small chunks: only the member's own frames need decoding */
+    tar_in_t in;
+    int rc = in_open(&in, archive, codec, frame_off, 256 * 1024);
+    if (rc != ZFO_OK) return rc;
+    rc = in_skip(&in, inner);
+
+    tar_entry_t* e = malloc(sizeof(tar_entry_t));
+    if (!e && rc == ZFO_OK) rc = ZFO_ERR_NO_MEMORY;
+    while (rc == ZFO_OK) {
+        bool end;
+        rc = read_entry(&in, e, &end);
+        if (rc != ZFO_OK) break;
+        if (end) {
+            rc = ZFO_ERR_NOT_FOUND;
+            break;
+        }
+        char name[PATH_MAX];
+        if (!e->too_long && sanitize(e->name, name, sizeof(name), 0) && strcmp(name, want) == 0) {
+            rc = write_member(&in, e, out_path);
+            break;
+        }
+        rc = in_skip(&in, padded(e->size));
+    }
+    free(e);
+    in_close(&in);
+    return rc;
+}
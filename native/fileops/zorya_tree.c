@@ -0,0 +1,706 @@
+/**
+ * @file zorya_tree.c
+ * @brief Zorya FileOps - Parallel recursive copy, remove and move
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   Every directory becomes a task on the work-stealing pool. A task
+ *   opens its directory relative to the parent's descriptor, scans it
+ *   with getdents64, spawns a task per subdirectory and hands files to
+ *   the pool in batches. Directory nodes are reference counted: the
+ *   parent stays open until the last child finishes, then the node is
+ *   finalized (rmdir for remove, mode/times for copy) and releases its
+ *   own parent in turn.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#define _FILE_OFFSET_BITS 64
+
+#include "zorya_fileops_internal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#define TREE_BATCH_MAX 128
+#define TREE_BATCH_BYTES 8192
+#define TREE_DEFAULT_MAX_ERRORS 64
+#define TREE_DEFAULT_INTERVAL_MS 100
+
+/* ============================================================
+ * Internal Structures
+ * ============================================================ */
+
+typedef enum {
+    TREE_REMOVE,
+    TREE_COPY
+} tree_kind_t;
+
+typedef struct {
+    zfo_pool_t* pool;
+    tree_kind_t kind;
+    const char* src_root;
+    const char* dst_root;
+    zfo_copy_options_t copy;
+    size_t bufsize;
+
+    zfo_tree_progress_t counters;   /* Updated atomically */
+
+    pthread_mutex_t err_lock;
+    zfo_tree_error_t* errors;
+    size_t error_count;
+    size_t max_errors;
+    int first_error;
+
+    const zfo_tree_options_t* opts;
+} tree_ctx_t;
+
+typedef struct tree_node {
+    struct tree_node* parent;
+    tree_ctx_t* ctx;
+    char* name;                     /* NULL for the root */
+    int fd;                         /* Source (or doomed) directory */
+    int dst_fd;                     /* Copy destination directory */
+    uint32_t refs;                  /* Own scan + outstanding children */
+    int failed;                     /* A descendant failed */
+    struct stat st;                 /* Copy: source directory stat */
+} tree_node_t;
+
+typedef struct {
+    tree_node_t* dir;
+    uint32_t count;
+    uint32_t used;
+    uint32_t offsets[TREE_BATCH_MAX];
+    unsigned char types[TREE_BATCH_MAX];
+    char names[TREE_BATCH_BYTES];
+} tree_batch_t;
+
+/* ============================================================
+ * Error Collection
+ * ============================================================ */
+
+/* Rebuild "<root>/<a>/<b>/<name>" from the node chain */
+static char* node_path(const tree_node_t* node, const char* name, bool dst) {
+    const tree_ctx_t* ctx = node->ctx;
+    const char* root = dst ? ctx->dst_root : ctx->src_root;
+
+    size_t len = strlen(root) + (name ? strlen(name) + 1 : 0);
+    for (const tree_node_t* n = node; n && n->name; n = n->parent) {
+        len += strlen(n->name) + 1;
+    }
+
+    char* path = malloc(len + 1);
+    if (!path) return NULL;
+
+    size_t pos = len;
+    path[pos] = 0;
+    if (name) {
+        size_t l = strlen(name);
+        pos -= l;
+        memcpy(path + pos, name, l);
+        path[--pos] = '/';
+    }
+    for (const tree_node_t* n = node; n && n->name; n = n->parent) {
+        size_t l = strlen(n->name);
+        pos -= l;
+        memcpy(path + pos, n->name, l);
+        path[--pos] = '/';
+    }
+    memcpy(path, root, strlen(root));
+
+    return path;
+}
+
+static void record_error(tree_node_t* node, const char* name, bool dst, int code) {
+    tree_ctx_t* ctx = node->ctx;
+
+    ZFO_ATOMIC_ADD(&ctx->counters.errors, 1);
+    ZFO_ATOMIC_STORE(&node->failed, 1);
+
+    pthread_mutex_lock(&ctx->err_lock);
+    if (ctx->first_error == ZFO_OK) ctx->first_error = code;
+    if (ctx->error_count < ctx->max_errors) {
+        char* path = node_path(node, name, dst);
+        if (path) {
+            ctx->errors[ctx->error_count].path = path;
+            ctx->errors[ctx->error_count].error = code;
+            ctx->error_count++;
+        }
+    }
+    pthread_mutex_unlock(&ctx->err_lock);
+}
+
+/* ============================================================
+ * Node Lifecycle
+ * ============================================================ */
+
+static tree_node_t* node_new(tree_ctx_t* ctx, tree_node_t* parent, const char* name) {
+    tree_node_t* node = calloc(1, sizeof(tree_node_t));
+    if (!node) return NULL;
+
+    if (name) {
+        node->name = strdup(name);
+        if (!node->name) {
+            free(node);
+            return NULL;
+        }
+    }
+
+    node->parent = parent;
+    node->ctx = ctx;
+    node->fd = -1;
+    node->dst_fd = -1;
+    node->refs = 1;
+    if (parent) ZFO_ATOMIC_ADD(&parent->refs, 1);
+    return node;
+}
+
+static void finish_remove(tree_node_t* node) {
+    tree_ctx_t* ctx = node->ctx;
+
+    if (node->fd >= 0) close(node->fd);
+    if (node->failed || zfo_pool_cancelled(ctx->pool)) return;
+
+    int pfd = node->parent ? node->parent->fd : AT_FDCWD;
+    const char* name = node->parent ? node->name : ctx->src_root;
+
+    if (unlinkat(pfd, name, AT_REMOVEDIR) == 0) {
+        ZFO_ATOMIC_ADD(&ctx->counters.dirs, 1);
+    } else if (node->parent) {
+        record_error(node->parent, node->name, false, zfo_error_from_errno(errno));
+    } else {
+        record_error(node, NULL, false, zfo_error_from_errno(errno));
+    }
+}
+
+static void finish_copy(tree_node_t* node) {
+    tree_ctx_t* ctx = node->ctx;
+
+    if (node->dst_fd >= 0) {
+        /* Applied last so children could be created in read-only dirs */
+        if (ctx->copy.preserve_mode) fchmod(node->dst_fd, node->st.st_mode & 07777);
+        if (ctx->copy.preserve_owner) fchown(node->dst_fd, node->st.st_uid, node->st.st_gid);
+        if (ctx->copy.preserve_times) {
+            struct timespec times[2] = { ZFO_ST_ATIM(&node->st), ZFO_ST_MTIM(&node->st) };
+            futimens(node->dst_fd, times);
+        }
+        close(node->dst_fd);
+        ZFO_ATOMIC_ADD(&ctx->counters.dirs, 1);
+    }
+    if (node->fd >= 0) close(node->fd);
+}
+
+/* Drop one reference; finalize and walk up while counts reach zero */
+static void node_release(tree_node_t* node) {
+    while (node && ZFO_ATOMIC_SUB(&node->refs, 1) == 0) {
+        tree_node_t* parent = node->parent;
+
+        if (node->ctx->kind == TREE_REMOVE) finish_remove(node);
+        else finish_copy(node);
+
+        if (parent && ZFO_ATOMIC_LOAD(&node->failed)) {
+            ZFO_ATOMIC_STORE(&parent->failed, 1);
+        }
+
+        free(node->name);
+        free(node);
+        node = parent;
+    }
+}
+
+/* ============================================================
+ * File Batches
+ * ============================================================ */
+
+static void remove_batch_task(zfo_pool_t* pool, int worker, void* arg);
+static void copy_batch_task(zfo_pool_t* pool, int worker, void* arg);
+
+static void batch_flush(tree_node_t* dir, tree_batch_t** batchp, int worker) {
+    tree_batch_t* batch = *batchp;
+    if (!batch || batch->count == 0) return;
+
+    *batchp = NULL;
+    ZFO_ATOMIC_ADD(&dir->refs, 1);
+
+    zfo_task_fn fn = dir->ctx->kind == TREE_REMOVE ? remove_batch_task : copy_batch_task;
+    if (zfo_pool_submit(dir->ctx->pool, worker, fn, batch) != ZFO_OK) {
+        /* Out of memory queueing: do the work inline */
+        fn(dir->ctx->pool, worker, batch);
+    }
+}
+
+static void batch_add(tree_node_t* dir, tree_batch_t** batchp, int worker,
+                      const char* name, unsigned char type) {
+    size_t len = strlen(name) + 1;
+    tree_batch_t* batch = *batchp;
+
+    if (batch && (batch->count == TREE_BATCH_MAX || batch->used + len > TREE_BATCH_BYTES)) {
+        batch_flush(dir, batchp, worker);
+        batch = NULL;
+    }
+
+    if (!batch) {
+        batch = malloc(sizeof(tree_batch_t));
+        if (!batch) {
+            record_error(dir, name, false, ZFO_ERR_NO_MEMORY);
+            return;
+        }
+        batch->dir = dir;
+        batch->count = 0;
+        batch->used = 0;
+        *batchp = batch;
+    }
+
+    batch->offsets[batch->count] = batch->used;
+    batch->types[batch->count] = type;
+    memcpy(batch->names + batch->used, name, len);
+    batch->used += (uint32_t)len;
+    batch->count++;
+}
+
+/* ============================================================
+ * Remove
+ * ============================================================ */
+
+static void remove_dir_task(zfo_pool_t* pool, int worker, void* arg);
+
+static void remove_batch_task(zfo_pool_t* pool, int worker, void* arg) {
+    (void)worker;
+    tree_batch_t* batch = arg;
+    tree_node_t* dir = batch->dir;
+
+    for (uint32_t i = 0; i < batch->count && !zfo_pool_cancelled(pool); i++) {
+        const char* name = batch->names + batch->offsets[i];
+        if (unlinkat(dir->fd, name, 0) == 0) {
+            ZFO_ATOMIC_ADD(&dir->ctx->counters.files, 1);
+        } else {
+            record_error(dir, name, false, zfo_error_from_errno(errno));
+        }
+    }
+
+    free(batch);
+    node_release(dir);
+}
+
+static void remove_dir_task(zfo_pool_t* pool, int worker, void* arg) {
+    tree_node_t* node = arg;
+    tree_ctx_t* ctx = node->ctx;
+
+    if (zfo_pool_cancelled(pool)) goto done;
+
+    int pfd = node->parent ? node->parent->fd : AT_FDCWD;
+    const char* name = node->parent ? node->name : ctx->src_root;
+
+    node->fd = openat(pfd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (node->fd < 0) {
+        record_error(node->parent ? node->parent : node,
+                     node->parent ? node->name : NULL, false, zfo_error_from_errno(errno));
+        node->failed = 1;
+        goto done;
+    }
+
+    zfo_dirscan_t scan;
+    int rc = zfo_dirscan_open(&scan, node->fd);
+    if (rc != ZFO_OK) {
+        record_error(node, NULL, false, rc);
+        goto done;
+    }
+
+    tree_batch_t* batch = NULL;
+    const char* entry;
+    unsigned char type;
+
+    while (!zfo_pool_cancelled(pool) && zfo_dirscan_next(&scan, &entry, &type, NULL)) {
+        if (type == DT_UNKNOWN) {
+            struct stat st;
+            if (fstatat(node->fd, entry, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode)) {
+                type = DT_DIR;
+            }
+        }
+
+        if (type == DT_DIR) {
+            tree_node_t* child = node_new(ctx, node, entry);
+            if (!child) {
+                record_error(node, entry, false, ZFO_ERR_NO_MEMORY);
+                continue;
+            }
+            if (zfo_pool_submit(pool, worker, remove_dir_task, child) != ZFO_OK) {
+                remove_dir_task(pool, worker, child);
+            }
+        } else {
+            batch_add(node, &batch, worker, entry, type);
+        }
+    }
+
+    batch_flush(node, &batch, worker);
+    rc = zfo_dirscan_error(&scan);
+    if (rc != ZFO_OK) record_error(node, NULL, false, rc);
+    zfo_dirscan_close(&scan);
+
+done:
+    node_release(node);
+}
+
+/* ============================================================
+ * Copy
+ * ============================================================ */
+
+static void copy_file_at(tree_node_t* dir, const char* name) {
+    tree_ctx_t* ctx = dir->ctx;
+    int nofollow = ctx->copy.follow_symlinks ? 0 : O_NOFOLLOW;
+
+    int src_fd = openat(dir->fd, name, O_RDONLY | O_CLOEXEC | nofollow);
+    if (src_fd < 0) {
+        record_error(dir, name, false, zfo_error_from_errno(errno));
+        return;
+    }
+
+    struct stat st;
+    if (fstat(src_fd, &st) != 0) {
+        record_error(dir, name, false, zfo_error_from_errno(errno));
+        close(src_fd);
+        return;
+    }
+
+    int dst_flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    if (!ctx->copy.overwrite) dst_flags |= O_EXCL;
+
+    int dst_fd = openat(dir->dst_fd, name, dst_flags, st.st_mode & 07777);
+    if (dst_fd < 0) {
+        record_error(dir, name, true, zfo_error_from_errno(errno));
+        close(src_fd);
+        return;
+    }
+
+    int rc = zfo_copy_fd_data(src_fd, dst_fd, &st, ctx->bufsize);
+    if (rc == ZFO_OK) {
+        if (ctx->copy.preserve_mode) fchmod(dst_fd, st.st_mode & 07777);
+        if (ctx->copy.preserve_owner) fchown(dst_fd, st.st_uid, st.st_gid);
+        if (ctx->copy.preserve_times) {
+            struct timespec times[2] = { ZFO_ST_ATIM(&st), ZFO_ST_MTIM(&st) };
+            futimens(dst_fd, times);
+        }
+        ZFO_ATOMIC_ADD(&ctx->counters.files, 1);
+        ZFO_ATOMIC_ADD(&ctx->counters.bytes, (uint64_t)st.st_size);
+    } else {
+        record_error(dir, name, true, rc);
+    }
+
+    close(src_fd);
+    close(dst_fd);
+}
+
+static void copy_symlink_at(tree_node_t* dir, const char* name) {
+    tree_ctx_t* ctx = dir->ctx;
+    char target[PATH_MAX];
+
+    ssize_t len = readlinkat(dir->fd, name, target, sizeof(target) - 1);
+    if (len < 0) {
+        record_error(dir, name, false, zfo_error_from_errno(errno));
+        return;
+    }
+    target[len] = 0;
+
+    if (symlinkat(target, dir->dst_fd, name) != 0) {
+        if (errno == EEXIST && ctx->copy.overwrite && unlinkat(dir->dst_fd, name, 0) == 0 &&
+            symlinkat(target, dir->dst_fd, name) == 0) {
+            ZFO_ATOMIC_ADD(&ctx->counters.files, 1);
+            return;
+        }
+        record_error(dir, name, true, zfo_error_from_errno(errno));
+        return;
+    }
+
+    ZFO_ATOMIC_ADD(&ctx->counters.files, 1);
+}
+
+static void copy_batch_task(zfo_pool_t* pool, int worker, void* arg) {
+    (void)worker;
+    tree_batch_t* batch = arg;
+    tree_node_t* dir = batch->dir;
+
+    for (uint32_t i = 0; i < batch->count && !zfo_pool_cancelled(pool); i++) {
+        const char* name = batch->names + batch->offsets[i];
+        switch (batch->types[i]) {
+            case DT_REG: copy_file_at(dir, name); break;
+            case DT_LNK: copy_symlink_at(dir, name); break;
+            default:     record_error(dir, name, false, ZFO_ERR_UNSUPPORTED); break;
+        }
+    }
+
+    free(batch);
+    node_release(dir);
+}
+
+static void copy_dir_task(zfo_pool_t* pool, int worker, void* arg) {
+    tree_node_t* node = arg;
+    tree_ctx_t* ctx = node->ctx;
+
+    if (zfo_pool_cancelled(pool)) goto done;
+
+    int src_pfd = node->parent ? node->parent->fd : AT_FDCWD;
+    int dst_pfd = node->parent ? node->parent->dst_fd : AT_FDCWD;
+    const char* src_name = node->parent ? node->name : ctx->src_root;
+    const char* dst_name = node->parent ? node->name : ctx->dst_root;
+    tree_node_t* err_node = node->parent ? node->parent : node;
+    const char* err_name = node->parent ? node->name : NULL;
+    int nofollow = ctx->copy.follow_symlinks ? 0 : O_NOFOLLOW;
+
+    node->fd = openat(src_pfd, src_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC | nofollow);
+    if (node->fd < 0 || fstat(node->fd, &node->st) != 0) {
+        record_error(err_node, err_name, false, zfo_error_from_errno(errno));
+        goto done;
+    }
+
+    if (mkdirat(dst_pfd, dst_name, (node->st.st_mode & 07777) | 0700) != 0 && errno != EEXIST) {
+        record_error(err_node, err_name, true, zfo_error_from_errno(errno));
+        goto done;
+    }
+
+    node->dst_fd = openat(dst_pfd, dst_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (node->dst_fd < 0) {
+        record_error(err_node, err_name, true, zfo_error_from_errno(errno));
+        goto done;
+    }
+
+    zfo_dirscan_t scan;
+    int rc = zfo_dirscan_open(&scan, node->fd);
+    if (rc != ZFO_OK) {
+        record_error(node, NULL, false, rc);
+        goto done;
+    }
+
+    tree_batch_t* batch = NULL;
+    const char* entry;
+    unsigned char type;
+
+    while (!zfo_pool_cancelled(pool) && zfo_dirscan_next(&scan, &entry, &type, NULL)) {
+        if (type == DT_UNKNOWN || (type == DT_LNK && ctx->copy.follow_symlinks)) {
+            struct stat st;
+            int flags = ctx->copy.follow_symlinks ? 0 : AT_SYMLINK_NOFOLLOW;
+            if (fstatat(node->fd, entry, &st, flags) != 0) {
+                record_error(node, entry, false, zfo_error_from_errno(errno));
+                continue;
+            }
+            type = S_ISDIR(st.st_mode) ? DT_DIR :
+                   S_ISREG(st.st_mode) ? DT_REG :
+                   S_ISLNK(st.st_mode) ? DT_LNK : DT_UNKNOWN;
+        }
+
+        if (type == DT_DIR) {
+            tree_node_t* child = node_new(ctx, node, entry);
+            if (!child) {
+                record_error(node, entry, false, ZFO_ERR_NO_MEMORY);
+                continue;
+            }
+            if (zfo_pool_submit(pool, worker, copy_dir_task, child) != ZFO_OK) {
+                copy_dir_task(pool, worker, child);
+            }
+        } else {
+            batch_add(node, &batch, worker, entry, type);
+        }
+    }
+
+    batch_flush(node, &batch, worker);
+    rc = zfo_dirscan_error(&scan);
+    if (rc != ZFO_OK) record_error(node, NULL, false, rc);
+    zfo_dirscan_close(&scan);
+
+done:
+    node_release(node);
+}
+
+/* ============================================================
+ * Driver
+ * ============================================================ */
+
+static bool tree_tick(void* arg) {
+    tree_ctx_t* ctx = arg;
+    zfo_tree_progress_t snap = {
+        .files = ZFO_ATOMIC_LOAD(&ctx->counters.files),
+        .dirs = ZFO_ATOMIC_LOAD(&ctx->counters.dirs),
+        .bytes = ZFO_ATOMIC_LOAD(&ctx->counters.bytes),
+        .errors = ZFO_ATOMIC_LOAD(&ctx->counters.errors)
+    };
+    return ctx->opts->progress(&snap, ctx->opts->userdata) == 0;
+}
+
+static int tree_run(tree_ctx_t* ctx, zfo_task_fn root_task, zfo_tree_result_t* result) {
+    const zfo_tree_options_t* opts = ctx->opts;
+
+    ctx->max_errors = opts->max_errors > 0 ? opts->max_errors : TREE_DEFAULT_MAX_ERRORS;
+    ctx->errors = calloc(ctx->max_errors, sizeof(zfo_tree_error_t));
+    if (!ctx->errors) return ZFO_ERR_NO_MEMORY;
+
+    ctx->pool = zfo_pool_create(opts->threads);
+    if (!ctx->pool) {
+        free(ctx->errors);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    pthread_mutex_init(&ctx->err_lock, NULL);
+
+    int ret = ZFO_OK;
+    tree_node_t* root = node_new(ctx, NULL, NULL);
+    if (!root) {
+        ret = ZFO_ERR_NO_MEMORY;
+    } else if (zfo_pool_submit(ctx->pool, -1, root_task, root) != ZFO_OK) {
+        free(root);
+        ret = ZFO_ERR_NO_MEMORY;
+    }
+
+    if (ret == ZFO_OK) {
+        uint32_t interval = opts->progress_interval_ms > 0 ?
+                            opts->progress_interval_ms : TREE_DEFAULT_INTERVAL_MS;
+        if (opts->progress) {
+            zfo_pool_wait(ctx->pool, interval, tree_tick, ctx);
+        } else {
+            zfo_pool_wait(ctx->pool, 0, NULL, NULL);
+        }
+
+        ret = ctx->first_error;
+        if (zfo_pool_cancelled(ctx->pool) && ret == ZFO_OK) ret = ZFO_ERR_INTERRUPTED;
+    }
+
+    zfo_pool_destroy(ctx->pool);
+    pthread_mutex_destroy(&ctx->err_lock);
+
+    if (result) {
+        result->totals = ctx->counters;
+        result->errors = ctx->errors;
+        result->error_count = ctx->error_count;
+    } else {
+        for (size_t i = 0; i < ctx->error_count; i++) free(ctx->errors[i].path);
+        free(ctx->errors);
+    }
+
+    return ret;
+}
+
+static void result_init(zfo_tree_result_t* result) {
+    if (result) memset(result, 0, sizeof(*result));
+}
+
+/* ============================================================
+ * Public API
+ * ============================================================ */
+
+int zfo_remove_all_parallel(const char* path, const zfo_tree_options_t* opts,
+                            zfo_tree_result_t* result) {
+    if (!path) return ZFO_ERR_INVALID_ARG;
+    result_init(result);
+
+    struct stat st;
+    if (lstat(path, &st) != 0) {
+        return errno == ENOENT ? ZFO_OK : zfo_error_from_errno(errno);
+    }
+
+    if (!S_ISDIR(st.st_mode)) {
+        if (unlink(path) != 0) return zfo_error_from_errno(errno);
+        if (result) result->totals.files = 1;
+        return ZFO_OK;
+    }
+
+    zfo_tree_options_t defaults = {0};
+    tree_ctx_t ctx = {0};
+    ctx.kind = TREE_REMOVE;
+    ctx.src_root = path;
+    ctx.dst_root = path;
+    ctx.opts = opts ? opts : &defaults;
+
+    return tree_run(&ctx, remove_dir_task, result);
+}
+
+int zfo_copy_parallel(const char* src, const char* dst, const zfo_copy_options_t* copy_opts,
+                      const zfo_tree_options_t* opts, zfo_tree_result_t* result) {
+    if (!src || !dst) return ZFO_ERR_INVALID_ARG;
+    result_init(result);
+
+    zfo_copy_options_t default_copy = {
+        .overwrite = false,
+        .preserve_mode = true,
+        .preserve_times = true,
+        .preserve_owner = false,
+        .follow_symlinks = false,
+        .recursive = true,
+        .atomic = false,
+        .buffer_size = 64 * 1024
+    };
+    if (!copy_opts) copy_opts = &default_copy;
+
+    struct stat st;
+    int (*stat_fn)(const char*, struct stat*) = copy_opts->follow_symlinks ? stat : lstat;
+    if (stat_fn(src, &st) != 0) return zfo_error_from_errno(errno);
+
+    /* Single files go through the serial path */
+    if (!S_ISDIR(st.st_mode)) {
+        int ret = zfo_copy(src, dst, copy_opts);
+        if (ret == ZFO_OK && result) {
+            result->totals.files = 1;
+            result->totals.bytes = (uint64_t)st.st_size;
+        }
+        return ret;
+    }
+    if (!copy_opts->recursive) return ZFO_ERR_IS_DIR;
+
+    zfo_tree_options_t defaults = {0};
+    tree_ctx_t ctx = {0};
+    ctx.kind = TREE_COPY;
+    ctx.src_root = src;
+    ctx.dst_root = dst;
+    ctx.copy = *copy_opts;
+    ctx.bufsize = copy_opts->buffer_size > 0 ? copy_opts->buffer_size : 64 * 1024;
+    ctx.opts = opts ? opts : &defaults;
+
+    return tree_run(&ctx, copy_dir_task, result);
+}
+
+int zfo_move_parallel(const char* src, const char* dst, const zfo_copy_options_t* copy_opts,
+                      const zfo_tree_options_t* opts, zfo_tree_result_t* result) {
+    if (!src || !dst) return ZFO_ERR_INVALID_ARG;
+    result_init(result);
+
+    if (rename(src, dst) == 0) return ZFO_OK;
+    if (errno != EXDEV) return zfo_error_from_errno(errno);
+
+    /* Cross-device: copy everything, remove the source only if it all landed */
+    int ret = zfo_copy_parallel(src, dst, copy_opts, opts, result);
+    if (ret != ZFO_OK) return ret;
+
+    zfo_tree_result_t removed;
+    ret = zfo_remove_all_parallel(src, opts, &removed);
+    if (result && removed.error_count > 0) {
+        /* Copy succeeded without errors, so only the removal's are reported */
+        removed.totals.files = result->totals.files;
+        removed.totals.dirs = result->totals.dirs;
+        removed.totals.bytes = result->totals.bytes;
+        zfo_tree_result_free(result);
+        *result = removed;
+        return ret;
+    }
+    zfo_tree_result_free(&removed);
+    return ret;
+}
+
+void zfo_tree_result_free(zfo_tree_result_t* result) {
+    if (!result) return;
+    for (size_t i = 0; i < result->error_count; i++) {
+        free(result->errors[i].path);
+    }
+    free(result->errors);
+    result->errors = NULL;
+    result->error_count = 0;
+}
@@ -0,0 +1,675 @@
+/**
+ * @file zorya_wal.c
+ * @brief Zorya FileOps - Append-only write-ahead log
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   A log is a directory of segments named after the sequence number of
+ *   their first record ("00000000000000000001.wal"). Segments are
+ *   preallocated with fallocate, so appends never grow the file and
+ *   fdatasync has no size change to journal.
+ *
+ *   Each record is framed as
+ *
+ *     u32 length | u32 check | u64 seq | payload | pad to 8 bytes
+ *
+ *   where check is an nxh64 of the payload seeded with seq and length.
+ *   The preallocated tail is zeroes, which never validates, so the end
+ *   of the log is the first frame that fails its check or breaks the
+ *   sequence.
+ *
+ *   Appends copy into a user-space buffer under a mutex. The buffer
+ *   reaches the page cache when it fills or at a sync. An optional
+ *   flusher thread group-commits every sync_ms, or as soon as
+ *   sync_bytes are pending, with one fdatasync covering every append
+ *   before it.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+#include "nxh.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#define WAL_FRAME_SIZE        16
+#define WAL_DEFAULT_SEGMENT   (64ull * 1024 * 1024)
+#define WAL_BUFFER_SIZE       (1u << 20)
+#define WAL_NAME_DIGITS       20
+#define WAL_NAME_LEN          (WAL_NAME_DIGITS + 4)   /* digits + ".wal" */
+
+/* ============================================================
+ * Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    uint32_t len;
+    uint32_t check;
+    uint64_t seq;
+} wal_frame_t;
+
+typedef struct {
+    uint64_t start;                 /* First sequence number */
+    char name[WAL_NAME_LEN + 1];
+} wal_segment_t;
+
+struct zfo_wal {
+    char* dir;
+    int dir_fd;
+    uint64_t segment_size;
+    uint32_t sync_ms;
+    uint64_t sync_bytes;
+
+    pthread_mutex_t lock;
+    pthread_cond_t wake;            /* Flusher: time to sync */
+    pthread_cond_t idle;            /* An fdatasync finished */
+    pthread_t thread;
+    bool thread_started;
+    bool stop;
+
+    int fd;                         /* Current segment */
+    uint64_t seg_alloc;             /* Preallocated bytes */
+    uint64_t seg_used;              /* Bytes appended, buffered or not */
+    uint64_t seg_written;           /* Bytes handed to pwrite */
+
+    char* buf;
+    size_t buf_len;
+    size_t buf_cap;
+
+    uint64_t next_seq;
+    uint64_t written_seq;           /* Last record in the page cache */
+    uint64_t durable_seq;           /* Last record known to be on disk */
+    uint64_t pending_bytes;         /* Appended since the last sync */
+    bool syncing;
+    int error;                      /* Sticky I/O error */
+
+    uint64_t segments;
+    uint64_t syncs;
+};
+
+/* ============================================================
+ * Framing
+ * ============================================================ */
+
+static uint32_t wal_check(uint64_t seq, const void* data, uint32_t len) {
+    uint64_t h = nxh64(data, len, NXH_SEED_DEFAULT ^ seq ^ ((uint64_t)len << 32));
+    uint32_t c = (uint32_t)(h ^ (h >> 32));
+    return c ? c : 1;
+}
+
+static size_t wal_frame_total(size_t len) {
+    return WAL_FRAME_SIZE + ((len + 7) & ~(size_t)7);
+}
+
+/*
+ * Walk valid frames starting at start_seq.
+ * @return Bytes covered by valid frames; *last gets the last seq seen
+ */
+static uint64_t wal_scan(const char* base, uint64_t size, uint64_t start_seq, uint64_t* last,
+                         zfo_wal_record_fn fn, uint64_t from_seq, void* userdata, bool* stopped) {
+    uint64_t off = 0;
+    uint64_t expect = start_seq;
+    while (size - off >= WAL_FRAME_SIZE) {
+        wal_frame_t frame;
+        memcpy(&frame, base + off, sizeof(frame));
+        if (frame.seq != expect || frame.len > size - off - WAL_FRAME_SIZE) break;
+        const char* data = base + off + WAL_FRAME_SIZE;
+        if (frame.check != wal_check(frame.seq, data, frame.len)) break;
+
+        off += wal_frame_total(frame.len);
+        expect++;
+        if (fn && frame.seq >= from_seq && !fn(frame.seq, data, frame.len, userdata)) {
+            *stopped = true;
+            break;
+        }
+    }
+    if (off > size) off = size;
+    *last = expect - 1;
+    return off;
+}
+
+/* ============================================================
+ * Segments
+ * ============================================================ */
+
+static int cmp_segment(const void* a, const void* b) {
+    const wal_segment_t* x = a;
+    const wal_segment_t* y = b;
+    return x->start < y->start ? -1 : x->start > y->start;
+}
+
+static bool parse_segment_name(const char* name, uint64_t* start) {
+    if (strlen(name) != WAL_NAME_LEN || strcmp(name + WAL_NAME_DIGITS, ".wal") != 0) return false;
+    uint64_t v = 0;
+    for (int i = 0; i < WAL_NAME_DIGITS; i++) {
+        if (name[i] < '0' || name[i] > '9') return false;
+        v = v * 10 + (uint64_t)(name[i] - '0');
+    }
+    *start = v;
+    return true;
+}
+
+static int list_segments(int dir_fd, wal_segment_t** out, size_t* out_count) {
+    *out = NULL;
+    *out_count = 0;
+
+    int fd = dup(dir_fd);
+    if (fd < 0) return zfo_error_from_errno(errno);
+    lseek(fd, 0, SEEK_SET);
+
+    zfo_dirscan_t scan;
+    int rc = zfo_dirscan_open(&scan, fd);
+    if (rc != ZFO_OK) {
+        close(fd);
+        return rc;
+    }
+
+    wal_segment_t* segs = NULL;
+    size_t count = 0;
+    size_t cap = 0;
+    const char* name;
+    unsigned char d_type;
+    uint64_t inode;
+    while (zfo_dirscan_next(&scan, &name, &d_type, &inode)) {
+        uint64_t start;
+        if (!parse_segment_name(name, &start)) continue;
+        if (count == cap) {
+            size_t ncap = cap ? cap * 2 : 16;
+            wal_segment_t* nsegs = realloc(segs, ncap * sizeof(wal_segment_t));
+            if (!nsegs) {
+                rc = ZFO_ERR_NO_MEMORY;
+                break;
+            }
+            segs = nsegs;
+            cap = ncap;
+        }
+        segs[count].start = start;
+        memcpy(segs[count].name, name, WAL_NAME_LEN + 1);
+        count++;
+    }
+    if (rc == ZFO_OK) rc = zfo_dirscan_error(&scan);
+    zfo_dirscan_close(&scan);
+    close(fd);
+
+    if (rc != ZFO_OK) {
+        free(segs);
+        return rc;
+    }
+    qsort(segs, count, sizeof(wal_segment_t), cmp_segment);
+    *out = segs;
+    *out_count = count;
+    return ZFO_OK;
+}
+
+static void segment_name(uint64_t start, char* name) {
+    snprintf(name, WAL_NAME_LEN + 1, "%020llu.wal", (unsigned long long)start);
+}
+
+static void preallocate(int fd, uint64_t size) {
+#ifdef __linux__
+    if (fallocate(fd, 0, 0, (off_t)size) == 0) return;
+#endif
+    /* No fallocate: extend with a hole so the tail still reads as zeroes */
+    struct stat st;
+    if (fstat(fd, &st) == 0 && (uint64_t)st.st_size < size) {
+        if (ftruncate(fd, (off_t)size) != 0) return;
+    }
+}
+
+/* ============================================================
+ * Writer Internals (lock held)
+ * ============================================================ */
+
+static int wal_write_locked(zfo_wal_t* wal) {
+    size_t done = 0;
+    while (done < wal->buf_len) {
+        ssize_t n = pwrite(wal->fd, wal->buf + done, wal->buf_len - done,
+                           (off_t)(wal->seg_written + done));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            wal->error = zfo_error_from_errno(errno);
+            return wal->error;
+        }
+        done += (size_t)n;
+    }
+    wal->seg_written += wal->buf_len;
+    wal->buf_len = 0;
+    wal->written_seq = wal->next_seq - 1;
+    return ZFO_OK;
+}
+
+/* Write out the buffer and fdatasync; concurrent callers share one flush */
+static int wal_sync_locked(zfo_wal_t* wal) {
+    if (wal->error) return wal->error;
+    int rc = wal_write_locked(wal);
+    if (rc != ZFO_OK) return rc;
+
+    while (wal->syncing) pthread_cond_wait(&wal->idle, &wal->lock);
+    if (wal->durable_seq >= wal->written_seq) return wal->error;
+
+    int fd = wal->fd;
+    uint64_t target = wal->written_seq;
+    wal->syncing = true;
+    wal->pending_bytes = 0;
+
+    pthread_mutex_unlock(&wal->lock);
+    int r = fdatasync(fd);
+    int err = errno;
+    pthread_mutex_lock(&wal->lock);
+
+    wal->syncing = false;
+    pthread_cond_broadcast(&wal->idle);
+    if (r != 0) {
+        wal->error = zfo_error_from_errno(err);
+        return wal->error;
+    }
+    if (target > wal->durable_seq) wal->durable_seq = target;
+    wal->syncs++;
+    return ZFO_OK;
+}
+
+/* Trim the current segment to what was written and make it durable */
+static int wal_seal_locked(zfo_wal_t* wal) {
+    int rc = wal_write_locked(wal);
+    while (wal->syncing) pthread_cond_wait(&wal->idle, &wal->lock);
+    if (rc != ZFO_OK) return rc;
+
+    if (ftruncate(wal->fd, (off_t)wal->seg_written) != 0 || fdatasync(wal->fd) != 0) {
+        wal->error = zfo_error_from_errno(errno);
+        return wal->error;
+    }
+    wal->durable_seq = wal->written_seq;
+    wal->pending_bytes = 0;
+    wal->syncs++;
+    return ZFO_OK;
+}
+
+static int wal_open_segment(zfo_wal_t* wal, uint64_t min_size) {
+    char name[WAL_NAME_LEN + 1];
+    segment_name(wal->next_seq, name);
+
+    int fd = openat(wal->dir_fd, name, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return zfo_error_from_errno(errno);
+
+    uint64_t size = wal->segment_size > min_size ? wal->segment_size : min_size;
+    preallocate(fd, size);
+
+    /* The new name must survive a crash before any record in it does */
+    if (fsync(wal->dir_fd) != 0) {
+        int rc = zfo_error_from_errno(errno);
+        close(fd);
+        return rc;
+    }
+
+    wal->fd = fd;
+    wal->seg_alloc = size;
+    wal->seg_used = 0;
+    wal->seg_written = 0;
+    wal->segments++;
+    return ZFO_OK;
+}
+
+static int wal_rotate_locked(zfo_wal_t* wal, uint64_t need) {
+    int rc = wal_seal_locked(wal);
+    if (rc != ZFO_OK) return rc;
+    close(wal->fd);
+    wal->fd = -1;
+
+    rc = wal_open_segment(wal, need);
+    if (rc != ZFO_OK) wal->error = rc;
+    return rc;
+}
+
+static void* wal_flusher(void* arg) {
+    zfo_wal_t* wal = arg;
+    pthread_mutex_lock(&wal->lock);
+    while (!wal->stop) {
+        if (wal->sync_ms > 0) {
+            struct timespec ts;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            ts.tv_sec += wal->sync_ms / 1000;
+            ts.tv_nsec += (long)(wal->sync_ms % 1000) * 1000000L;
+            if (ts.tv_nsec >= 1000000000L) {
+                ts.tv_sec++;
+                ts.tv_nsec -= 1000000000L;
+            }
+            pthread_cond_timedwait(&wal->wake, &wal->lock, &ts);
+        } else {
+            pthread_cond_wait(&wal->wake, &wal->lock);
+        }
+        if (wal->stop) break;
+        if (!wal->error && wal->durable_seq + 1 < wal->next_seq) wal_sync_locked(wal);
+    }
+    pthread_mutex_unlock(&wal->lock);
+    return NULL;
+}
+
+/* ============================================================
+ * Open / Recover
+ * ============================================================ */
+
+/* Find the end of the last segment and cut off anything torn */
+static int wal_recover(zfo_wal_t* wal, const wal_segment_t* seg) {
+    int fd = openat(wal->dir_fd, seg->name, O_RDWR | O_CLOEXEC);
+    if (fd < 0) return zfo_error_from_errno(errno);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int rc = zfo_error_from_errno(errno);
+        close(fd);
+        return rc;
+    }
+
+    uint64_t end = 0;
+    uint64_t last = seg->start - 1;
+    if (st.st_size > 0) {
+        void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (map == MAP_FAILED) {
+            int rc = zfo_error_from_errno(errno);
+            close(fd);
+            return rc;
+        }
+        bool stopped = false;
+        end = wal_scan(map, (uint64_t)st.st_size, seg->start, &last, NULL, 0, NULL, &stopped);
+        munmap(map, (size_t)st.st_size);
+    }
+
+    /* Zero everything past the end so stale frames can't reappear */
+    if (ftruncate(fd, (off_t)end) != 0) {
+        int rc = zfo_error_from_errno(errno);
+        close(fd);
+        return rc;
+    }
+    uint64_t size = (uint64_t)st.st_size > wal->segment_size ? (uint64_t)st.st_size : wal->segment_size;
+    preallocate(fd, size);
+    fdatasync(fd);
+
+    wal->fd = fd;
+    wal->seg_alloc = size;
+    wal->seg_used = end;
+    wal->seg_written = end;
+    wal->next_seq = last + 1;
+    wal->written_seq = last;
+    wal->durable_seq = last;
+    return ZFO_OK;
+}
+
+int zfo_wal_open(const char* dir, const zfo_wal_options_t* opts, zfo_wal_t** out) {
+    if (!dir || !*dir || !out) return ZFO_ERR_INVALID_ARG;
+    *out = NULL;
+
+    int rc = zfo_mkdir_p(dir, 0755);
+    if (rc != ZFO_OK) return rc;
+
+    zfo_wal_t* wal = calloc(1, sizeof(zfo_wal_t));
+    if (!wal) return ZFO_ERR_NO_MEMORY;
+    wal->fd = -1;
+    wal->segment_size = opts && opts->segment_size ? opts->segment_size : WAL_DEFAULT_SEGMENT;
+    wal->sync_ms = opts ? opts->sync_ms : 0;
+    wal->sync_bytes = opts ? opts->sync_bytes : 0;
+    wal->buf_cap = WAL_BUFFER_SIZE;
+    wal->buf = malloc(wal->buf_cap);
+    wal->dir = strdup(dir);
+    pthread_mutex_init(&wal->lock, NULL);
+    pthread_cond_init(&wal->wake, NULL);
+    pthread_cond_init(&wal->idle, NULL);
+    if (!wal->buf || !wal->dir) {
+        zfo_wal_close(wal);
+        return ZFO_ERR_NO_MEMORY;
+    }
+
+    wal->dir_fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (wal->dir_fd < 0) {
+        rc = zfo_error_from_errno(errno);
+        wal->dir_fd = -1;
+        zfo_wal_close(wal);
+        return rc;
+    }
+
+    wal_segment_t* segs;
+    size_t count;
+    rc = list_segments(wal->dir_fd, &segs, &count);
+    if (rc == ZFO_OK) {
+        wal->segments = count;
+        if (count > 0) {
+            rc = wal_recover(wal, &segs[count - 1]);
+        } else {
+            wal->next_seq = 1;
+            rc = wal_open_segment(wal, 0);
+        }
+        free(segs);
+    }
+
+    if (rc == ZFO_OK && (wal->sync_ms > 0 || wal->sync_bytes > 0)) {
+        if (pthread_create(&wal->thread, NULL, wal_flusher, wal) != 0) {
+            rc = ZFO_ERR_UNKNOWN;
+        } else {
+            wal->thread_started = true;
+        }
+    }
+
+    if (rc != ZFO_OK) {
+        zfo_wal_close(wal);
+        return rc;
+    }
+    *out = wal;
+    return ZFO_OK;
+}
+
+/* ============================================================
+ * Public API
+ * ============================================================ */
+
+int zfo_wal_append(zfo_wal_t* wal, const void* data, size_t len, uint64_t* out_seq) {
+    if (!wal || (!data && len > 0) || len > UINT32_MAX - 8) return ZFO_ERR_INVALID_ARG;
+
+    size_t total = wal_frame_total(len);
+    pthread_mutex_lock(&wal->lock);
+    int rc = wal->error;
+
+    if (rc == ZFO_OK && wal->seg_used + total > wal->seg_alloc && wal->seg_used > 0) {
+        rc = wal_rotate_locked(wal, total);
+    }
+    if (rc == ZFO_OK && wal->buf_len + total > wal->buf_cap) {
+        rc = wal_write_locked(wal);
+        if (rc == ZFO_OK && total > wal->buf_cap) {
+            char* nbuf = realloc(wal->buf, total);
+            if (nbuf) {
+                wal->buf = nbuf;
+                wal->buf_cap = total;
+            } else {
+                rc = ZFO_ERR_NO_MEMORY;
+            }
+        }
+    }
+    if (rc != ZFO_OK) {
+        pthread_mutex_unlock(&wal->lock);
+        return rc;
+    }
+
+    wal_frame_t frame;
+    frame.len = (uint32_t)len;
+    frame.seq = wal->next_seq;
+    frame.check = wal_check(frame.seq, data, frame.len);
+
+    char* p = wal->buf + wal->buf_len;
+    memcpy(p, &frame, WAL_FRAME_SIZE);
+    if (len > 0) memcpy(p + WAL_FRAME_SIZE, data, len);
+    memset(p + WAL_FRAME_SIZE + len, 0, total - WAL_FRAME_SIZE - len);
+    wal->buf_len += total;
+    wal->seg_used += total;
+    wal->pending_bytes += total;
+
+    if (out_seq) *out_seq = wal->next_seq;
+    wal->next_seq++;
+
+    if (wal->sync_bytes > 0 && wal->pending_bytes >= wal->sync_bytes) {
+        wal->pending_bytes = 0;
+        pthread_cond_signal(&wal->wake);
+    }
+    pthread_mutex_unlock(&wal->lock);
+    return ZFO_OK;
+}
+
+int zfo_wal_flush(zfo_wal_t* wal) {
+    if (!wal) return ZFO_ERR_INVALID_ARG;
+    pthread_mutex_lock(&wal->lock);
+    int rc = wal->error ? wal->error : wal_write_locked(wal);
+    pthread_mutex_unlock(&wal->lock);
+    return rc;
+}
+
+int zfo_wal_sync(zfo_wal_t* wal) {
+    if (!wal) return ZFO_ERR_INVALID_ARG;
+    pthread_mutex_lock(&wal->lock);
+    int rc = wal_sync_locked(wal);
+    pthread_mutex_unlock(&wal->lock);
+    return rc;
+}
+
+int zfo_wal_truncate(zfo_wal_t* wal, uint64_t before_seq) {
+    if (!wal) return ZFO_ERR_INVALID_ARG;
+
+    pthread_mutex_lock(&wal->lock);
+    wal_segment_t* segs;
+    size_t count;
+    int rc = list_segments(wal->dir_fd, &segs, &count);
+    if (rc == ZFO_OK) {
+        /* A segment can go once the next one starts at or before before_seq */
+        size_t removed = 0;
+        for (size_t i = 0; i + 1 < count && segs[i + 1].start <= before_seq; i++) {
+            if (unlinkat(wal->dir_fd, segs[i].name, 0) != 0 && errno != ENOENT) {
+                rc = zfo_error_from_errno(errno);
+                break;
+            }
+            removed++;
+        }
+        if (removed > 0) {
+            wal->segments = wal->segments > removed ? wal->segments - removed : 1;
+            fsync(wal->dir_fd);
+        }
+        free(segs);
+    }
+    pthread_mutex_unlock(&wal->lock);
+    return rc;
+}
+
+void zfo_wal_stats(zfo_wal_t* wal, zfo_wal_stats_t* stats) {
+    if (!wal || !stats) return;
+    pthread_mutex_lock(&wal->lock);
+    stats->next_seq = wal->next_seq;
+    stats->written_seq = wal->written_seq;
+    stats->durable_seq = wal->durable_seq;
+    stats->segments = wal->segments;
+    stats->syncs = wal->syncs;
+    pthread_mutex_unlock(&wal->lock);
+}
+
+int zfo_wal_close(zfo_wal_t* wal) {
+    if (!wal) return ZFO_ERR_INVALID_ARG;
+
+    if (wal->thread_started) {
+        pthread_mutex_lock(&wal->lock);
+        wal->stop = true;
+        pthread_cond_signal(&wal->wake);
+        pthread_mutex_unlock(&wal->lock);
+        pthread_join(wal->thread, NULL);
+    }
+
+    int rc = ZFO_OK;
+    if (wal->fd >= 0) {
+        pthread_mutex_lock(&wal->lock);
+        rc = wal->error ? wal->error : wal_seal_locked(wal);
+        pthread_mutex_unlock(&wal->lock);
+        close(wal->fd);
+    }
+    if (wal->dir_fd >= 0) close(wal->dir_fd);
+
+    pthread_cond_destroy(&wal->idle);
+    pthread_cond_destroy(&wal->wake);
+    pthread_mutex_destroy(&wal->lock);
+    free(wal->buf);
+    free(wal->dir);
+    free(wal);
+    return rc;
+}
+
+/* ============================================================
+ * Replay
+ * ============================================================ */
+
+int zfo_wal_replay(const char* dir, uint64_t from_seq, zfo_wal_record_fn fn, void* userdata,
+                   uint64_t* out_last_seq) {
+    if (!dir || !fn) return ZFO_ERR_INVALID_ARG;
+    if (out_last_seq) *out_last_seq = 0;
+
+    int dir_fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd < 0) return zfo_error_from_errno(errno);
+
+    wal_segment_t* segs;
+    size_t count;
+    int rc = list_segments(dir_fd, &segs, &count);
+    if (rc != ZFO_OK) {
+        close(dir_fd);
+        return rc;
+    }
+
+    uint64_t last = 0;
+    bool stopped = false;
+    for (size_t i = 0; i < count && rc == ZFO_OK && !stopped; i++) {
+        /* Every record in this segment precedes from_seq */
+        if (i + 1 < count && segs[i + 1].start <= from_seq) continue;
+
+        /* A gap means a segment went missing or was cut short */
+        if (last != 0 && segs[i].start != last + 1) {
+            rc = ZFO_ERR_IO;
+            break;
+        }
+
+        int fd = openat(dir_fd, segs[i].name, O_RDONLY | O_CLOEXEC);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            rc = zfo_error_from_errno(errno);
+            if (fd >= 0) close(fd);
+            break;
+        }
+
+        uint64_t seg_last = segs[i].start - 1;
+        if (st.st_size > 0) {
+            void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (map == MAP_FAILED) {
+                rc = zfo_error_from_errno(errno);
+                close(fd);
+                break;
+            }
+            madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+            wal_scan(map, (uint64_t)st.st_size, segs[i].start, &seg_last, fn, from_seq,
+                     userdata, &stopped);
+            munmap(map, (size_t)st.st_size);
+        }
+        close(fd);
+        last = seg_last;
+    }
+
+    free(segs);
+    close(dir_fd);
+    if (out_last_seq) *out_last_seq = last;
+    return rc;
+}
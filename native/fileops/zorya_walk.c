@@ -0,0 +1,404 @@
+/**
+ * @file zorya_walk.c
+ * @brief Zorya FileOps - Parallel directory walker
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   One pool task per directory. A task opens its directory relative
+ *   to the parent's descriptor, reads it with getdents64 and trusts
+ *   d_type, so the common case performs no stat at all. The parent
+ *   descriptor is shared and reference counted: it closes as soon as
+ *   the last child has opened itself, which keeps the number of open
+ *   descriptors proportional to the work queued rather than the tree.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#define _FILE_OFFSET_BITS 64
+
+#include "zorya_fileops_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#define WALK_DEFAULT_MAX_ERRORS 64
+
+/* ============================================================
+ * Internal Structures
+ * ============================================================ */
+
+typedef struct {
+    int fd;
+    uint32_t refs;
+} walk_fd_t;
+
+typedef struct {
+    uint64_t dev;
+    uint64_t ino;
+} walk_ancestor_t;
+
+typedef struct {
+    zfo_pool_t* pool;
+    const zfo_walk_options_t* opts;
+    const char* root;
+
+    zfo_tree_progress_t counters;   /* Updated atomically */
+
+    pthread_mutex_t err_lock;
+    zfo_tree_error_t* errors;
+    size_t error_count;
+    size_t max_errors;
+} walk_ctx_t;
+
+typedef struct {
+    walk_ctx_t* ctx;
+    walk_fd_t* parent;              /* NULL for the root */
+    char* path;
+    size_t path_len;
+    size_t name_off;                /* Offset of the last component */
+    int depth;                      /* Root = 0 */
+    walk_ancestor_t* chain;         /* Only with ZFO_WALK_FOLLOW_SYMLINKS */
+    size_t chain_len;
+} walk_task_t;
+
+/* ============================================================
+ * Helpers
+ * ============================================================ */
+
+static void walk_fd_release(walk_fd_t* wfd) {
+    if (wfd && ZFO_ATOMIC_SUB(&wfd->refs, 1) == 0) {
+        close(wfd->fd);
+        free(wfd);
+    }
+}
+
+static void walk_record_error(walk_ctx_t* ctx, const char* path, size_t len, int code) {
+    ZFO_ATOMIC_ADD(&ctx->counters.errors, 1);
+
+    pthread_mutex_lock(&ctx->err_lock);
+    if (ctx->error_count < ctx->max_errors) {
+        char* copy = malloc(len + 1);
+        if (copy) {
+            memcpy(copy, path, len);
+            copy[len] = 0;
+            ctx->errors[ctx->error_count].path = copy;
+            ctx->errors[ctx->error_count].error = code;
+            ctx->error_count++;
+        }
+    }
+    pthread_mutex_unlock(&ctx->err_lock);
+}
+
+static bool walk_is_pruned(const zfo_walk_options_t* opts, const char* name) {
+    for (size_t i = 0; i < opts->prune_count; i++) {
+        if (strcmp(opts->prune[i], name) == 0) return true;
+    }
+    return false;
+}
+
+static void walk_task_free(walk_task_t* task) {
+    free(task->path);
+    free(task->chain);
+    free(task);
+}
+
+/* ============================================================
+ * Directory Task
+ * ============================================================ */
+
+static void walk_dir_task(zfo_pool_t* pool, int worker, void* arg);
+
+static void walk_spawn(walk_task_t* task, walk_fd_t* self, int worker,
+                       const char* path, size_t path_len, size_t name_off) {
+    walk_ctx_t* ctx = task->ctx;
+    walk_task_t* child = calloc(1, sizeof(walk_task_t));
+    char* copy = malloc(path_len + 1);
+
+    if (!child || !copy) {
+        free(child);
+        free(copy);
+        walk_record_error(ctx, path, path_len, ZFO_ERR_NO_MEMORY);
+        return;
+    }
+
+    memcpy(copy, path, path_len + 1);
+    child->ctx = ctx;
+    child->parent = self;
+    child->path = copy;
+    child->path_len = path_len;
+    child->name_off = name_off;
+    child->depth = task->depth + 1;
+
+    if (ctx->opts->flags & ZFO_WALK_FOLLOW_SYMLINKS) {
+        /* Loop detection: the child learns its own (dev, ino) on open */
+        child->chain = malloc((task->chain_len + 1) * sizeof(walk_ancestor_t));
+        if (child->chain) {
+            memcpy(child->chain, task->chain, task->chain_len * sizeof(walk_ancestor_t));
+            child->chain_len = task->chain_len;
+        }
+    }
+
+    ZFO_ATOMIC_ADD(&self->refs, 1);
+    if (zfo_pool_submit(ctx->pool, worker, walk_dir_task, child) != ZFO_OK) {
+        walk_dir_task(ctx->pool, worker, child);
+    }
+}
+
+static void walk_dir_task(zfo_pool_t* pool, int worker, void* arg) {
+    walk_task_t* task = arg;
+    walk_ctx_t* ctx = task->ctx;
+    const zfo_walk_options_t* opts = ctx->opts;
+    bool follow = (opts->flags & ZFO_WALK_FOLLOW_SYMLINKS) != 0;
+    walk_fd_t* self = NULL;
+    char* buf = NULL;
+
+    if (zfo_pool_cancelled(pool)) goto done;
+
+    /* The root itself is always followed, like find -H */
+    int oflags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+    int fd = task->parent
+        ? openat(task->parent->fd, task->path + task->name_off, oflags | (follow ? 0 : O_NOFOLLOW))
+        : open(task->path, oflags);
+    int open_err = errno;
+
+    walk_fd_release(task->parent);
+    task->parent = NULL;
+
+    if (fd < 0) {
+        walk_record_error(ctx, task->path, task->path_len, zfo_error_from_errno(open_err));
+        goto done;
+    }
+
+    if (follow) {
+        struct stat st;
+        if (fstat(fd, &st) == 0) {
+            for (size_t i = 0; i < task->chain_len; i++) {
+                if (task->chain[i].dev == (uint64_t)st.st_dev &&
+                    task->chain[i].ino == (uint64_t)st.st_ino) {
+                    walk_record_error(ctx, task->path, task->path_len, ZFO_ERR_LOOP);
+                    close(fd);
+                    goto done;
+                }
+            }
+            if (task->chain) {
+                task->chain[task->chain_len].dev = st.st_dev;
+                task->chain[task->chain_len].ino = st.st_ino;
+                task->chain_len++;
+            }
+        }
+    }
+
+    self = malloc(sizeof(walk_fd_t));
+    if (!self) {
+        close(fd);
+        walk_record_error(ctx, task->path, task->path_len, ZFO_ERR_NO_MEMORY);
+        goto done;
+    }
+    self->fd = fd;
+    self->refs = 1;
+
+    zfo_dirscan_t scan;
+    int rc = zfo_dirscan_open(&scan, fd);
+    if (rc != ZFO_OK) {
+        walk_record_error(ctx, task->path, task->path_len, rc);
+        goto done;
+    }
+
+    /* Child paths are assembled in place: "<dir>/<name>" */
+    size_t prefix = task->path_len;
+    bool need_sep = prefix > 0 && task->path[prefix - 1] != '/';
+    size_t base = prefix + (need_sep ? 1 : 0);
+    size_t cap = base + 256;
+    buf = malloc(cap);
+    if (!buf) {
+        zfo_dirscan_close(&scan);
+        walk_record_error(ctx, task->path, task->path_len, ZFO_ERR_NO_MEMORY);
+        goto done;
+    }
+    memcpy(buf, task->path, prefix);
+    if (need_sep) buf[prefix] = '/';
+
+    int depth = task->depth + 1;
+    bool descend_ok = opts->max_depth < 0 || depth < opts->max_depth;
+    const char* name;
+    unsigned char d_type;
+    uint64_t inode;
+
+    while (!zfo_pool_cancelled(pool) && zfo_dirscan_next(&scan, &name, &d_type, &inode)) {
+        if ((opts->flags & ZFO_WALK_SKIP_HIDDEN) && name[0] == '.') continue;
+
+        size_t name_len = strlen(name);
+        if (base + name_len + 1 > cap) {
+            size_t ncap = (base + name_len + 1) * 2;
+            char* nbuf = realloc(buf, ncap);
+            if (!nbuf) {
+                walk_record_error(ctx, task->path, task->path_len, ZFO_ERR_NO_MEMORY);
+                break;
+            }
+            buf = nbuf;
+            cap = ncap;
+        }
+        memcpy(buf + base, name, name_len + 1);
+        size_t path_len = base + name_len;
+
+        zfo_file_type_t type = zfo_type_from_dtype(d_type);
+        zfo_stat_t st;
+        bool have_stat = false;
+
+        if (type == ZFO_TYPE_UNKNOWN || (type == ZFO_TYPE_SYMLINK && follow) ||
+            (opts->flags & ZFO_WALK_STAT)) {
+            rc = zfo_stat_at(fd, name, follow, &st);
+            if (rc != ZFO_OK && follow && type == ZFO_TYPE_SYMLINK) {
+                /* Dangling link: report the link itself */
+                rc = zfo_stat_at(fd, name, false, &st);
+            }
+            if (rc != ZFO_OK) {
+                walk_record_error(ctx, buf, path_len, rc);
+                continue;
+            }
+            type = st.type;
+            have_stat = true;
+        }
+
+        if (type == ZFO_TYPE_DIR && opts->prune_count > 0 && walk_is_pruned(opts, name)) {
+            continue;
+        }
+
+        int action = ZFO_WALK_CONTINUE;
+        if (opts->visit) {
+            zfo_walk_entry_t entry = {
+                .path = buf,
+                .path_len = path_len,
+                .name = buf + base,
+                .depth = depth,
+                .type = type,
+                .inode = inode,
+                .dir_fd = fd,
+                .stat = (have_stat && (opts->flags & ZFO_WALK_STAT)) ? &st : NULL,
+                .worker = worker
+            };
+            action = opts->visit(&entry, opts->userdata);
+        }
+
+        if (type == ZFO_TYPE_DIR) {
+            ZFO_ATOMIC_ADD(&ctx->counters.dirs, 1);
+        } else {
+            ZFO_ATOMIC_ADD(&ctx->counters.files, 1);
+            if (have_stat) ZFO_ATOMIC_ADD(&ctx->counters.bytes, (uint64_t)st.size);
+        }
+
+        if (action == ZFO_WALK_STOP) {
+            zfo_pool_cancel(pool);
+            break;
+        }
+
+        if (type == ZFO_TYPE_DIR && action != ZFO_WALK_PRUNE && descend_ok) {
+            walk_spawn(task, self, worker, buf, path_len, base);
+        }
+    }
+
+    rc = zfo_dirscan_error(&scan);
+    if (rc != ZFO_OK) walk_record_error(ctx, task->path, task->path_len, rc);
+    zfo_dirscan_close(&scan);
+
+done:
+    free(buf);
+    walk_fd_release(self);
+    walk_fd_release(task->parent);
+    walk_task_free(task);
+}
+
+/* ============================================================
+ * Public API
+ * ============================================================ */
+
+int zfo_walk_parallel(const char* root, const zfo_walk_options_t* opts,
+                      zfo_tree_result_t* result) {
+    return zfo_walk_run(NULL, root, opts, result);
+}
+
+int zfo_walk_run(zfo_pool_t* pool, const char* root, const zfo_walk_options_t* opts,
+                 zfo_tree_result_t* result) {
+    if (!root || !opts) return ZFO_ERR_INVALID_ARG;
+    if (result) memset(result, 0, sizeof(*result));
+
+    /* Strip trailing slashes so joined paths stay canonical */
+    size_t root_len = strlen(root);
+    while (root_len > 1 && root[root_len - 1] == '/') root_len--;
+
+    struct stat st;
+    if (stat(root, &st) != 0) return zfo_error_from_errno(errno);
+    if (!S_ISDIR(st.st_mode)) return ZFO_ERR_NOT_DIR;
+
+    walk_ctx_t ctx = {0};
+    ctx.opts = opts;
+    ctx.root = root;
+    ctx.max_errors = opts->max_errors > 0 ? opts->max_errors : WALK_DEFAULT_MAX_ERRORS;
+    ctx.errors = calloc(ctx.max_errors, sizeof(zfo_tree_error_t));
+    if (!ctx.errors) return ZFO_ERR_NO_MEMORY;
+
+    walk_task_t* task = calloc(1, sizeof(walk_task_t));
+    char* path = malloc(root_len + 1);
+    if (!task || !path) {
+        free(task);
+        free(path);
+        free(ctx.errors);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    memcpy(path, root, root_len);
+    path[root_len] = 0;
+
+    task->ctx = &ctx;
+    task->path = path;
+    task->path_len = root_len;
+    if (opts->flags & ZFO_WALK_FOLLOW_SYMLINKS) {
+        task->chain = malloc(sizeof(walk_ancestor_t));
+    }
+
+    ctx.pool = pool ? pool : zfo_pool_create(opts->threads);
+    if (!ctx.pool) {
+        walk_task_free(task);
+        free(ctx.errors);
+        return ZFO_ERR_NO_MEMORY;
+    }
+    pthread_mutex_init(&ctx.err_lock, NULL);
+
+    int ret = ZFO_OK;
+    if (opts->max_depth == 0) {
+        walk_task_free(task);
+    } else if (zfo_pool_submit(ctx.pool, -1, walk_dir_task, task) != ZFO_OK) {
+        walk_task_free(task);
+        ret = ZFO_ERR_NO_MEMORY;
+    } else {
+        zfo_pool_wait(ctx.pool, 0, NULL, NULL);
+        if (zfo_pool_cancelled(ctx.pool)) ret = ZFO_ERR_INTERRUPTED;
+        else if (ctx.error_count > 0) ret = ctx.errors[0].error;
+    }
+
+    if (!pool) zfo_pool_destroy(ctx.pool);
+    pthread_mutex_destroy(&ctx.err_lock);
+
+    if (result) {
+        result->totals = ctx.counters;
+        result->errors = ctx.errors;
+        result->error_count = ctx.error_count;
+    } else {
+        for (size_t i = 0; i < ctx.error_count; i++) free(ctx.errors[i].path);
+        free(ctx.errors);
+    }
+
+    return ret;
+}
@@ -0,0 +1,397 @@
+/**
+ * @file zorya_watcher.c
+ * @brief Zorya FileOps - Event-driven watcher with native coalescing
+ *
+ * @author Anthony Taliento
+ * @date 2025-12-22
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 Zorya Corporation
+ * @license Apache-2.0
+ *
+ * DESCRIPTION:
+ *   Each watcher owns an inotify instance and a thread blocked in
+ *   poll() on it plus an eventfd used for shutdown. Raw events are
+ *   folded into an ordered list of pending changes indexed by path
+ *   (and by cookie for moves) in DAGGER tables, so an editor save or
+ *   a build writing the same file thousands of times costs one entry.
+ *   The list is handed over once the stream has been quiet for the
+ *   debounce period, or when the oldest change reaches max latency.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "zorya_fileops_internal.h"
+#include "dagger.h"
+
+#include <stdlib.h>
+
+#ifdef __linux__
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/eventfd.h>
+
+#define WATCHER_DEFAULT_DEBOUNCE_MS 50
+#define WATCHER_DEFAULT_LATENCY_MS  1000
+#define WATCHER_DEFAULT_MAX_BATCH   4096
+#define WATCHER_TABLE_CAPACITY      256
+
+/* ============================================================
+ * Internal Structures
+ * ============================================================ */
+
+typedef struct watch_item {
+    zfo_watch_change_t change;
+    struct watch_item* prev;
+    struct watch_item* next;
+    bool by_cookie;             /* Indexed in the cookie table */
+} watch_item_t;
+
+struct zfo_watcher {
+    zfo_watch_t* watch;
+    int wake_fd;
+    pthread_t thread;
+    int stopping;               /* atomic */
+    zfo_watcher_options_t opts;
+
+    /* Pending changes, touched only by the watcher thread */
+    watch_item_t* head;
+    watch_item_t* tail;
+    size_t pending;
+    DaggerTable* by_path;       /* path -> latest item for that path */
+    DaggerTable* by_cookie;     /* cookie -> unpaired MOVE_FROM item */
+    uint64_t first_ns;          /* Arrival of the oldest pending change */
+    uint64_t last_ns;           /* Arrival of the newest raw event */
+};
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* ============================================================
+ * Pending List
+ * ============================================================ */
+
+static watch_item_t* path_lookup(zfo_watcher_t* w, const char* path) {
+    void* value = NULL;
+    if (dagger_get(w->by_path, path, (uint32_t)strlen(path), &value) != DAGGER_OK) return NULL;
+    return value;
+}
+
+/* Drop index entries that point at item (keys borrow item's strings) */
+static void item_unindex(zfo_watcher_t* w, watch_item_t* item) {
+    const char* path = item->change.path;
+    if (path && path_lookup(w, path) == item) {
+        dagger_remove(w->by_path, path, (uint32_t)strlen(path));
+    }
+    if (item->by_cookie) {
+        dagger_remove(w->by_cookie, &item->change.cookie, sizeof(uint32_t));
+        item->by_cookie = false;
+    }
+}
+
+static void item_free(watch_item_t* item) {
+    free(item->change.path);
+    free(item->change.old_path);
+    free(item);
+}
+
+static void item_unlink(zfo_watcher_t* w, watch_item_t* item) {
+    item_unindex(w, item);
+    if (item->prev) item->prev->next = item->next;
+    else w->head = item->next;
+    if (item->next) item->next->prev = item->prev;
+    else w->tail = item->prev;
+    w->pending--;
+    item_free(item);
+}
+
+static watch_item_t* item_append(zfo_watcher_t* w, const zfo_watch_data_t* data) {
+    watch_item_t* item = calloc(1, sizeof(watch_item_t));
+    if (!item) return NULL;
+
+    item->change.path = strdup(data->path);
+    if (!item->change.path) {
+        free(item);
+        return NULL;
+    }
+    item->change.event = data->event;
+    item->change.cookie = data->cookie;
+    item->change.count = 1;
+    item->change.is_dir = data->is_dir;
+
+    item->prev = w->tail;
+    if (w->tail) w->tail->next = item;
+    else w->head = item;
+    w->tail = item;
+
+    if (w->pending++ == 0) w->first_ns = w->last_ns;
+
+    if (data->event != ZFO_EVENT_OVERFLOW) {
+        dagger_set(w->by_path, item->change.path, (uint32_t)strlen(item->change.path), item, 1);
+    }
+    return item;
+}
+
+/* ============================================================
+ * Coalescing
+ * ============================================================ */
+
+static bool creates_path(zfo_watch_event_t ev) {
+    return ev == ZFO_EVENT_CREATE || ev == ZFO_EVENT_MOVE_TO || ev == ZFO_EVENT_RENAME;
+}
+
+/* Pair a MOVE_TO with its pending MOVE_FROM; false if there is none */
+static bool pair_move(zfo_watcher_t* w, const zfo_watch_data_t* data) {
+    if (data->cookie == 0) return false;
+
+    void* value = NULL;
+    if (dagger_get(w->by_cookie, &data->cookie, sizeof(uint32_t), &value) != DAGGER_OK) return false;
+
+    watch_item_t* item = value;
+    char* to = strdup(data->path);
+    if (!to) return false;
+
+    item_unindex(w, item);
+    item->change.event = ZFO_EVENT_RENAME;
+    item->change.old_path = item->change.path;
+    item->change.path = to;
+    item->change.count++;
+    dagger_set(w->by_path, to, (uint32_t)strlen(to), item, 1);
+    return true;
+}
+
+static void watcher_coalesce(const zfo_watch_data_t* data, void* userdata) {
+    zfo_watcher_t* w = userdata;
+    if (data->event == 0) return;   /* IN_IGNORED, IN_DELETE_SELF, ... */
+
+    watch_item_t* item = data->event == ZFO_EVENT_OVERFLOW ? NULL : path_lookup(w, data->path);
+    zfo_watch_event_t prev = item ? item->change.event : 0;
+
+    switch (data->event) {
+        case ZFO_EVENT_MODIFY:
+        case ZFO_EVENT_ATTRIB:
+        case ZFO_EVENT_OPEN:
+        case ZFO_EVENT_CLOSE:
+            if (item && (prev == data->event || creates_path(prev) ||
+                         (prev == ZFO_EVENT_MODIFY && data->event == ZFO_EVENT_ATTRIB))) {
+                item->change.count++;
+                return;
+            }
+            if (item && prev == ZFO_EVENT_ATTRIB && data->event == ZFO_EVENT_MODIFY) {
+                item->change.event = ZFO_EVENT_MODIFY;
+                item->change.count++;
+                return;
+            }
+            break;
+
+        case ZFO_EVENT_DELETE:
+            if (item && prev == ZFO_EVENT_CREATE) {
+                /* Transient file: nothing observable happened */
+                item_unlink(w, item);
+                return;
+            }
+            if (item && (prev == ZFO_EVENT_MODIFY || prev == ZFO_EVENT_ATTRIB)) {
+                item->change.event = ZFO_EVENT_DELETE;
+                item->change.count++;
+                return;
+            }
+            break;
+
+        case ZFO_EVENT_CREATE:
+            if (item && prev == ZFO_EVENT_DELETE) {
+                /* Delete + recreate (atomic save) reads as a modification */
+                item->change.event = ZFO_EVENT_MODIFY;
+                item->change.is_dir = data->is_dir;
+                item->change.count++;
+                return;
+            }
+            break;
+
+        case ZFO_EVENT_MOVE_TO:
+            if (pair_move(w, data)) return;
+            break;
+
+        default:
+            break;
+    }
+
+    item = item_append(w, data);
+    if (item && data->event == ZFO_EVENT_MOVE_FROM && data->cookie != 0) {
+        if (dagger_set(w->by_cookie, &item->change.cookie, sizeof(uint32_t), item, 1) == DAGGER_OK) {
+            item->by_cookie = true;
+        }
+    }
+}
+
+/* ============================================================
+ * Flushing
+ * ============================================================ */
+
+static void watcher_flush(zfo_watcher_t* w) {
+    if (w->pending == 0) return;
+
+    zfo_watch_change_t* changes = malloc(w->pending * sizeof(zfo_watch_change_t));
+    size_t n = 0;
+
+    watch_item_t* item = w->head;
+    while (item) {
+        watch_item_t* next = item->next;
+        if (changes) {
+            changes[n++] = item->change;
+            free(item);
+        } else {
+            item_free(item);
+        }
+        item = next;
+    }
+
+    w->head = w->tail = NULL;
+    w->pending = 0;
+    dagger_clear(w->by_path);
+    dagger_clear(w->by_cookie);
+
+    if (changes) w->opts.on_batch(changes, n, w->opts.userdata);
+}
+
+static void watcher_discard(zfo_watcher_t* w) {
+    watch_item_t* item = w->head;
+    while (item) {
+        watch_item_t* next = item->next;
+        item_free(item);
+        item = next;
+    }
+    w->head = w->tail = NULL;
+    w->pending = 0;
+}
+
+/* ============================================================
+ * Event Thread
+ * ============================================================ */
+
+static bool flush_due(const zfo_watcher_t* w, uint64_t now, int* timeout) {
+    uint64_t quiet = w->last_ns + (uint64_t)w->opts.debounce_ms * 1000000ULL;
+    uint64_t hard = w->first_ns + (uint64_t)w->opts.max_latency_ms * 1000000ULL;
+    uint64_t deadline = quiet < hard ? quiet : hard;
+
+    if (now >= deadline) return true;
+    if (timeout) *timeout = (int)((deadline - now + 999999) / 1000000);
+    return false;
+}
+
+static void* watcher_main(void* arg) {
+    zfo_watcher_t* w = arg;
+    struct pollfd pfd[2] = {
+        { .fd = zfo_watch_fd(w->watch), .events = POLLIN },
+        { .fd = w->wake_fd, .events = POLLIN }
+    };
+
+    while (!ZFO_ATOMIC_LOAD(&w->stopping)) {
+        int timeout = -1;
+        if (w->pending > 0 && flush_due(w, monotonic_ns(), &timeout)) timeout = 0;
+
+        int ret = poll(pfd, 2, timeout);
+        if (ret < 0 && errno != EINTR) break;
+
+        /* The eventfd only ever signals shutdown */
+        if (ret > 0 && (pfd[1].revents & POLLIN)) continue;
+
+        if (ret > 0 && (pfd[0].revents & POLLIN)) {
+            w->last_ns = monotonic_ns();
+            while (w->pending < w->opts.max_batch &&
+                   zfo_watch_poll(w->watch, watcher_coalesce, w) > 0) {
+            }
+        }
+
+        if (w->pending >= w->opts.max_batch ||
+            (w->pending > 0 && flush_due(w, monotonic_ns(), NULL))) {
+            watcher_flush(w);
+        }
+    }
+
+    return NULL;
+}
+
+/* ============================================================
+ * Public API
+ * ============================================================ */
+
+zfo_watcher_t* zfo_watcher_create(const zfo_watcher_options_t* opts) {
+    if (!opts || !opts->on_batch) return NULL;
+
+    zfo_watcher_t* w = calloc(1, sizeof(zfo_watcher_t));
+    if (!w) return NULL;
+
+    w->opts = *opts;
+    if (w->opts.debounce_ms == 0) w->opts.debounce_ms = WATCHER_DEFAULT_DEBOUNCE_MS;
+    if (w->opts.max_latency_ms == 0) w->opts.max_latency_ms = WATCHER_DEFAULT_LATENCY_MS;
+    if (w->opts.max_latency_ms < w->opts.debounce_ms) w->opts.max_latency_ms = w->opts.debounce_ms;
+    if (w->opts.max_batch == 0) w->opts.max_batch = WATCHER_DEFAULT_MAX_BATCH;
+
+    w->wake_fd = -1;
+    w->watch = zfo_watch_create();
+    w->by_path = dagger_create(WATCHER_TABLE_CAPACITY, NULL);
+    w->by_cookie = dagger_create(16, NULL);
+    if (!w->watch || !w->by_path || !w->by_cookie) goto fail;
+
+    w->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (w->wake_fd < 0) goto fail;
+
+    if (pthread_create(&w->thread, NULL, watcher_main, w) != 0) goto fail;
+    return w;
+
+fail:
+    if (w->wake_fd >= 0) close(w->wake_fd);
+    if (w->by_cookie) dagger_destroy(w->by_cookie);
+    if (w->by_path) dagger_destroy(w->by_path);
+    zfo_watch_destroy(w->watch);
+    free(w);
+    return NULL;
+}
+
+int zfo_watcher_add(zfo_watcher_t* watcher, const char* path, int events, bool recursive) {
+    if (!watcher) return ZFO_ERR_INVALID_ARG;
+    return zfo_watch_add(watcher->watch, path, events, recursive);
+}
+
+int zfo_watcher_remove(zfo_watcher_t* watcher, int wd) {
+    if (!watcher) return ZFO_ERR_INVALID_ARG;
+    return zfo_watch_remove(watcher->watch, wd);
+}
+
+void zfo_watcher_destroy(zfo_watcher_t* watcher) {
+    if (!watcher) return;
+
+    ZFO_ATOMIC_STORE(&watcher->stopping, 1);
+    uint64_t one = 1;
+    ssize_t n = write(watcher->wake_fd, &one, sizeof(one));
+    (void)n;    /* Only fails when the counter is already saturated */
+    pthread_join(watcher->thread, NULL);
+
+    watcher_discard(watcher);
+    dagger_destroy(watcher->by_path);
+    dagger_destroy(watcher->by_cookie);
+    close(watcher->wake_fd);
+    zfo_watch_destroy(watcher->watch);
+    free(watcher);
+}
+
+#endif /* __linux__ */
+
+void zfo_watch_changes_free(zfo_watch_change_t* changes, size_t count) {
+    if (!changes) return;
+    for (size_t i = 0; i < count; i++) {
+        free(changes[i].path);
+        free(changes[i].old_path);
+    }
+    free(changes);
+}
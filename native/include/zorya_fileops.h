@@ -221,7 +221,7 @@ typedef struct {
     bool follow_symlinks;           /* Follow symlinks (copy target) */
     bool recursive;                 /* Recursive for directories */
     bool atomic;                    /* Use atomic rename */
-    size_t buffer_size;             /* I/O buffer size (0 = default) */
+    size_t buffer_size;             /* Fallback I/O buffer size (0 = default) */
 } zfo_copy_options_t;
 
 /* ============================================================
@@ -339,6 +339,413 @@ int zfo_sync(zfo_file_t* file);
  */
 int zfo_truncate(zfo_file_t* file, zfo_off_t size);
 
+/**
+ * Sync file data (and only the metadata needed to read it back)
+ */
+int zfo_datasync(zfo_file_t* file);
+
+/* ============================================================
+ * Positional & Vectored I/O
+ * ============================================================ */
+
+/** One buffer of a vectored read or write (same layout as struct iovec) */
+typedef struct {
+    void* base;
+    size_t len;
+} zfo_iovec_t;
+
+typedef enum {
+    ZFO_ADVISE_NORMAL     = 0,
+    ZFO_ADVISE_SEQUENTIAL = 1,
+    ZFO_ADVISE_RANDOM     = 2,
+    ZFO_ADVISE_WILLNEED   = 3,
+    ZFO_ADVISE_DONTNEED   = 4,
+    ZFO_ADVISE_NOREUSE    = 5
+} zfo_advice_t;
+
+typedef enum {
+    ZFO_ALLOC_KEEP_SIZE  = 0x01,    /* Reserve blocks without changing the size */
+    ZFO_ALLOC_PUNCH_HOLE = 0x02     /* Deallocate the range (implies KEEP_SIZE) */
+} zfo_alloc_flags_t;
+
+/**
+ * Read at offset without moving the file position
+ * @return Bytes read, 0 at EOF, negative on error
+ */
+zfo_off_t zfo_pread(zfo_file_t* file, void* buf, size_t size, zfo_off_t offset);
+
+/**
+ * Write at offset without moving the file position
+ * @return Bytes written, negative on error
+ */
+zfo_off_t zfo_pwrite(zfo_file_t* file, const void* buf, size_t size, zfo_off_t offset);
+
+/**
+ * Scatter read into several buffers with one syscall
+ * @param offset Position to read from, or -1 for the file position
+ * @return Bytes read, negative on error
+ */
+zfo_off_t zfo_readv(zfo_file_t* file, const zfo_iovec_t* iov, int count, zfo_off_t offset);
+
+/**
+ * Gather write from several buffers with one syscall
+ * @param offset Position to write at, or -1 for the file position
+ * @return Bytes written, negative on error
+ */
+zfo_off_t zfo_writev(zfo_file_t* file, const zfo_iovec_t* iov, int count, zfo_off_t offset);
+
+/**
+ * Access pattern hint for a range (length 0 = to end of file)
+ */
+int zfo_advise(zfo_file_t* file, zfo_off_t offset, zfo_off_t length, zfo_advice_t advice);
+
+/**
+ * Allocate or punch out blocks for a range
+ * @param flags ZFO_ALLOC_*
+ */
+int zfo_allocate(zfo_file_t* file, zfo_off_t offset, zfo_off_t length, int flags);
+
+/* ============================================================
+ * Buffered Writes
+ * ============================================================ */
+
+/**
+ * Give the file a write-coalescing buffer. zfo_write_buffered appends
+ * to it at the file position; it reaches the kernel when full, on
+ * zfo_flush, on close, or before any other operation on the file.
+ * @param size Buffer size, 0 to flush and drop the buffer
+ */
+int zfo_set_write_buffer(zfo_file_t* file, size_t size);
+
+/**
+ * Write through the buffer. Data larger than the buffer goes out
+ * together with anything pending in a single writev.
+ */
+int zfo_write_buffered(zfo_file_t* file, const void* buf, size_t size);
+
+/**
+ * Hand buffered data to the kernel. Bytes a failed write did not
+ * deliver stay buffered for the next flush.
+ */
+int zfo_flush(zfo_file_t* file);
+
+/**
+ * Bytes waiting in the write buffer
+ */
+size_t zfo_buffered(const zfo_file_t* file);
+
+/* ============================================================
+ * Chunked Reader
+ * ============================================================ */
+
+/** Hash every chunk (nxh64) on the reader thread */
+#define ZFO_READER_HASH        0x01
+/** Drop pages from the page cache once read */
+#define ZFO_READER_DROP_CACHE  0x02
+
+typedef enum {
+    ZFO_CODEC_NONE = 0,
+    ZFO_CODEC_ZSTD = 1,
+    ZFO_CODEC_LZ4  = 2              /* LZ4 frame format */
+} zfo_codec_t;
+
+typedef struct zfo_reader zfo_reader_t;
+
+/**
+ * Called from the reader thread when a chunk becomes ready after a
+ * non-blocking zfo_reader_next returned ZFO_ERR_TIMEOUT
+ */
+typedef void (*zfo_reader_notify_fn)(void* userdata);
+
+typedef struct {
+    size_t chunk_size;              /**< Bytes per chunk (0 = 1 MiB) */
+    int slots;                      /**< Buffers in the ring (0 = 4) */
+    zfo_off_t offset;               /**< Where to start in the file */
+    zfo_off_t length;               /**< Bytes of file to read (0 = to end) */
+    zfo_codec_t codec;              /**< Decode the file on the fly */
+    uint32_t flags;                 /**< ZFO_READER_* */
+    zfo_reader_notify_fn notify;
+    void* userdata;
+} zfo_reader_options_t;
+
+typedef struct {
+    const void* data;               /**< NULL at end of stream */
+    size_t len;
+    uint64_t offset;                /**< File offset, or decoded offset with a codec */
+    uint64_t seq;                   /**< Pass to zfo_reader_release */
+    uint64_t hash;                  /**< nxh64 of data with ZFO_READER_HASH */
+} zfo_chunk_t;
+
+/**
+ * Open a file and start filling the ring in the background
+ */
+int zfo_reader_open(const char* path, const zfo_reader_options_t* opts, zfo_reader_t** out);
+
+/**
+ * Take the next chunk in order. Its buffer stays valid until released.
+ * @param wait Block until a chunk is ready; otherwise return
+ *             ZFO_ERR_TIMEOUT and call notify once one is
+ * @return ZFO_OK (chunk->data is NULL at end of stream), ZFO_ERR_BUSY
+ *         when every buffer is held, or the error that stopped the reader
+ */
+int zfo_reader_next(zfo_reader_t* reader, zfo_chunk_t* chunk, bool wait);
+
+/**
+ * Give a chunk's buffer back to the ring (any order; unknown seq is ignored)
+ */
+void zfo_reader_release(zfo_reader_t* reader, uint64_t seq);
+
+/**
+ * nxh_combine of the hashes of every chunk taken so far
+ */
+uint64_t zfo_reader_hash(zfo_reader_t* reader);
+
+/**
+ * Bytes read from the file so far (compressed size when decoding)
+ */
+uint64_t zfo_reader_bytes_read(zfo_reader_t* reader);
+
+/**
+ * Stop the reader thread, keeping the buffers alive
+ */
+void zfo_reader_stop(zfo_reader_t* reader);
+
+/**
+ * Stop the thread and free every buffer
+ */
+void zfo_reader_close(zfo_reader_t* reader);
+
+/* ============================================================
+ * Content Cache
+ * ============================================================ */
+
+/** Trust cached entries until invalidated instead of stat'ing on every hit */
+#define ZFO_CACHE_NO_VALIDATE  0x01
+
+typedef enum {
+    ZFO_CACHE_RAW  = 0,             /* File contents as stored */
+    ZFO_CACHE_ZSTD = 1              /* zstd frame of the contents */
+} zfo_cache_variant_t;
+
+/**
+ * Reference-counted file contents. The cache holds one reference while
+ * the blob is cached; zfo_cache_get hands the caller another.
+ */
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    void* user;                     /**< Caller's wrapper, dropped through release */
+    uint32_t refs;
+} zfo_cache_blob_t;
+
+/** Called when the cache drops a blob whose user is set */
+typedef void (*zfo_cache_release_fn)(zfo_cache_blob_t* blob, void* userdata);
+
+typedef struct {
+    size_t max_bytes;               /**< Budget for cached data (0 = 64 MiB) */
+    size_t max_entry;               /**< Larger files are read but not kept (0 = max_bytes / 4) */
+    int zstd_level;                 /**< Level for ZFO_CACHE_ZSTD (0 = 3) */
+    uint32_t flags;                 /**< ZFO_CACHE_* */
+    zfo_cache_release_fn release;
+    void* userdata;
+} zfo_cache_options_t;
+
+typedef struct {
+    zfo_cache_blob_t* blob;         /**< Caller's reference; release when done */
+    bool hit;                       /**< Served from the cache */
+    bool cached;                    /**< The cache holds blob too */
+} zfo_cache_result_t;
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t entries;
+    uint64_t bytes;                 /**< Cached data, both variants */
+} zfo_cache_stats_t;
+
+typedef struct zfo_cache zfo_cache_t;
+
+/**
+ * Create a read-through cache. Entries are keyed by path and checked
+ * against (dev, inode, mtime_ns, size) from a stat on each hit;
+ * eviction is CLOCK over a byte budget.
+ */
+zfo_cache_t* zfo_cache_create(const zfo_cache_options_t* opts);
+
+/**
+ * Return a file's contents, reading and caching them on a miss.
+ * ZFO_CACHE_ZSTD compresses the cached contents once and keeps that too.
+ */
+int zfo_cache_get(zfo_cache_t* cache, const char* path, zfo_cache_variant_t variant,
+                  zfo_cache_result_t* out);
+
+/**
+ * Drop path, and with recursive everything below it
+ * @return Entries dropped
+ */
+size_t zfo_cache_invalidate(zfo_cache_t* cache, const char* path, bool recursive);
+
+/**
+ * Drop every entry
+ */
+void zfo_cache_clear(zfo_cache_t* cache);
+
+void zfo_cache_stats(zfo_cache_t* cache, zfo_cache_stats_t* out);
+
+/**
+ * Drop every entry and free the cache. Blobs still referenced elsewhere
+ * live until released.
+ */
+void zfo_cache_destroy(zfo_cache_t* cache);
+
+void zfo_cache_blob_retain(zfo_cache_blob_t* blob);
+void zfo_cache_blob_release(zfo_cache_blob_t* blob);
+
+/* ============================================================
+ * Shared-Memory Channel
+ * ============================================================ */
+
+typedef struct {
+    size_t capacity;                /**< Ring bytes, rounded up to a power of two (0 = 1 MiB) */
+    uint32_t mode;                  /**< Permissions for a created file (0 = 0600) */
+} zfo_channel_options_t;
+
+typedef struct {
+    uint64_t capacity;
+    uint64_t used;                  /**< Bytes claimed and not yet consumed */
+    uint64_t written;               /**< Bytes claimed since creation */
+    uint64_t read;                  /**< Bytes consumed since creation */
+} zfo_channel_stats_t;
+
+typedef struct zfo_channel zfo_channel_t;
+
+/**
+ * Create a channel backed by path, or by an anonymous memfd when path
+ * is NULL (other processes then open zfo_channel_path). An existing
+ * file is reset.
+ */
+int zfo_channel_create(const char* path, const zfo_channel_options_t* opts, zfo_channel_t** out);
+
+/**
+ * Attach to a channel another process created
+ * @return ZFO_ERR_INVALID_ARG if path isn't a channel
+ */
+int zfo_channel_open(const char* path, zfo_channel_t** out);
+
+const char* zfo_channel_path(const zfo_channel_t* ch);
+
+/** The whole mapping; offsets from reserve and receive are relative to it */
+void* zfo_channel_base(zfo_channel_t* ch);
+size_t zfo_channel_map_size(zfo_channel_t* ch);
+
+/** Largest payload a single message can carry */
+size_t zfo_channel_max_message(const zfo_channel_t* ch);
+
+/**
+ * Claim len bytes for a message; fill them at base + offset, then commit.
+ * Any number of producers may reserve concurrently.
+ * @param timeout_ms 0 = fail at once when full, < 0 = wait forever
+ * @return ZFO_ERR_TIMEOUT when the ring stays full
+ */
+int zfo_channel_reserve(zfo_channel_t* ch, size_t len, int timeout_ms, size_t* offset);
+
+/**
+ * Publish a reserved message and wake the consumer
+ */
+void zfo_channel_commit(zfo_channel_t* ch, size_t offset);
+
+/**
+ * Reserve, copy and commit
+ */
+int zfo_channel_send(zfo_channel_t* ch, const void* data, size_t len, int timeout_ms);
+
+/**
+ * Take the next message. It stays in place until the next receive or
+ * release; the first receive makes this handle the channel's consumer.
+ * @return ZFO_ERR_TIMEOUT when nothing arrived, ZFO_ERR_BUSY if another
+ *         process is the consumer
+ */
+int zfo_channel_receive(zfo_channel_t* ch, int timeout_ms, size_t* offset, size_t* len);
+
+/**
+ * Hand the last received message's space back to producers
+ */
+void zfo_channel_release(zfo_channel_t* ch);
+
+/**
+ * Block until a message beyond the one held is ready, without taking it
+ * @return ZFO_OK, ZFO_ERR_TIMEOUT or ZFO_ERR_INTERRUPTED
+ */
+int zfo_channel_wait(zfo_channel_t* ch, int timeout_ms);
+
+void zfo_channel_stats(zfo_channel_t* ch, zfo_channel_stats_t* out);
+
+/**
+ * Make this handle's waits return ZFO_ERR_INTERRUPTED
+ */
+void zfo_channel_interrupt(zfo_channel_t* ch);
+
+void zfo_channel_close(zfo_channel_t* ch);
+
+/* ============================================================
+ * Tar Archives
+ * ============================================================ */
+
+#define ZFO_TAR_SKIP_HIDDEN     0x01    /* Leave dot-entries out */
+#define ZFO_TAR_FOLLOW_SYMLINKS 0x02    /* Archive what symlinks point to */
+#define ZFO_TAR_SEEKABLE        0x04    /* Frames at member boundaries + index */
+
+typedef struct {
+    zfo_codec_t codec;              /**< Compress the tar stream */
+    int level;                      /**< Codec level (0 = codec default) */
+    int threads;                    /**< Walk and zstd threads (0 = CPU count) */
+    uint32_t flags;                 /**< ZFO_TAR_* */
+    size_t frame_size;              /**< Seekable: bytes per frame (0 = 1 MiB) */
+} zfo_tar_pack_options_t;
+
+typedef struct {
+    int threads;                    /**< File writer threads (0 = CPU count) */
+    int strip;                      /**< Leading path components to drop */
+} zfo_tar_unpack_options_t;
+
+typedef struct {
+    uint64_t files;
+    uint64_t dirs;
+    uint64_t links;                 /**< Symlinks and hard links */
+    uint64_t bytes;                 /**< File content bytes */
+    uint64_t archive_bytes;         /**< Size of the archive as stored */
+    uint64_t errors;                /**< Entries skipped or not restored */
+} zfo_tar_stats_t;
+
+/**
+ * Pack a tree into a ustar archive, using pax records for long names
+ * and sizes over 8 GiB. Entries are gathered with the parallel walker
+ * and streamed through the encoder in path order. With
+ * ZFO_TAR_SEEKABLE, frames end at member boundaries and a member index
+ * is appended as a skippable frame that other decoders ignore.
+ */
+int zfo_tar_pack(const char* root, const char* archive,
+                 const zfo_tar_pack_options_t* opts, zfo_tar_stats_t* stats);
+
+/**
+ * Unpack an archive (plain, zstd or LZ4, detected from the first bytes)
+ * into dest. Decoding runs on a reader thread while files are written
+ * on a pool. Modes and mtimes are restored; members with ".." in their
+ * path are skipped and symlinks are created last.
+ * @return ZFO_OK unless the archive is corrupt or dest is unusable;
+ *         per-entry failures are counted in stats->errors
+ */
+int zfo_tar_unpack(const char* archive, const char* dest,
+                   const zfo_tar_unpack_options_t* opts, zfo_tar_stats_t* stats);
+
+/**
+ * Extract one member to out_path. Seekable archives jump straight to
+ * the member's frame; others are scanned from the start.
+ * @return ZFO_ERR_NOT_FOUND if the archive has no such member
+ */
+int zfo_tar_extract(const char* archive, const char* member, const char* out_path);
+
 /* ============================================================
  * Convenience I/O Functions
  * ============================================================ */
@@ -357,6 +764,33 @@ int zfo_read_file(const char* path, uint8_t** out_buf, size_t* out_size);
  */
 int zfo_write_file(const char* path, const void* buf, size_t size);
 
+#define ZFO_WRITE_PREALLOCATE  0x01    /* fallocate before writing so the file lands in few extents */
+#define ZFO_WRITE_SPARSE       0x02    /* Leave runs of zero blocks as holes */
+
+#define ZFO_WRITE_BLOCK        4096u           /* Granularity of the zero scan */
+#define ZFO_WRITE_HOLE_MIN     (64u * 1024u)   /* Default smallest hole */
+
+typedef struct {
+    uint32_t flags;             /* ZFO_WRITE_* */
+    size_t hole_min;            /* Smallest zero run left as a hole (0 = 64 KiB; rounded to blocks) */
+} zfo_write_options_t;
+
+typedef struct {
+    size_t written;             /* Bytes actually written */
+    size_t holes;               /* Zero runs skipped */
+    size_t hole_bytes;          /* Bytes in those runs */
+} zfo_write_stats_t;
+
+/**
+ * zfo_write_file with allocation control. The file is sized once,
+ * either by fallocate or by a single ftruncate for sparse writes, and
+ * data goes out with pwrite at final offsets.
+ * @param opts NULL behaves like zfo_write_file
+ * @param stats Optional
+ */
+int zfo_write_file_opts(const char* path, const void* buf, size_t size,
+                        const zfo_write_options_t* opts, zfo_write_stats_t* stats);
+
 /**
  * Append buffer to file
  */
@@ -422,6 +856,11 @@ zfo_off_t zfo_size(const char* path);
 
 /**
  * Copy file or directory
+ *
+ * File data is copied in-kernel where possible: a reflink (FICLONE) on
+ * copy-on-write filesystems, then copy_file_range, then sendfile, with
+ * a buffered read/write loop as the last fallback. Holes in sparse
+ * sources are preserved via SEEK_DATA/SEEK_HOLE.
  */
 int zfo_copy(const char* src, const char* dst, const zfo_copy_options_t* opts);
 
@@ -480,6 +919,161 @@ int zfo_utime(const char* path, time_t atime, time_t mtime);
  */
 int zfo_touch(const char* path);
 
+/* ============================================================
+ * Parallel Tree Operations
+ * ============================================================ */
+
+/**
+ * Running totals for a tree operation
+ */
+typedef struct {
+    uint64_t files;                 /* Non-directory entries processed */
+    uint64_t dirs;                  /* Directories processed */
+    uint64_t bytes;                 /* File bytes copied */
+    uint64_t errors;                /* Failures encountered */
+} zfo_tree_progress_t;
+
+/**
+ * Progress callback, invoked on the calling thread
+ * @return 0 to continue, non-zero to cancel
+ */
+typedef int (*zfo_tree_progress_callback_t)(
+    const zfo_tree_progress_t* progress,
+    void* userdata
+);
+
+typedef struct {
+    int threads;                    /* Worker threads (0 = CPU count) */
+    zfo_tree_progress_callback_t progress;  /* Optional progress callback */
+    void* userdata;                 /* Passed to progress */
+    uint32_t progress_interval_ms;  /* Callback interval (0 = 100 ms) */
+    size_t max_errors;              /* Errors kept in result (0 = 64) */
+} zfo_tree_options_t;
+
+typedef struct {
+    char* path;                     /* Path that failed */
+    int error;                      /* ZFO_ERR_* code */
+} zfo_tree_error_t;
+
+typedef struct {
+    zfo_tree_progress_t totals;     /* Final counters */
+    zfo_tree_error_t* errors;       /* First max_errors failures */
+    size_t error_count;             /* Entries in errors */
+} zfo_tree_result_t;
+
+/**
+ * Delete a directory tree on a work-stealing thread pool
+ *
+ * Each directory is opened relative to its parent (openat) and its
+ * entries are unlinked with unlinkat, so no path is resolved twice.
+ * Failures don't stop the walk; they are collected in result.
+ *
+ * @param result Optional totals and errors (free with zfo_tree_result_free)
+ * @return ZFO_OK if everything was removed, else the first error
+ */
+int zfo_remove_all_parallel(
+    const char* path,
+    const zfo_tree_options_t* opts,
+    zfo_tree_result_t* result
+);
+
+/**
+ * Copy a directory tree on a work-stealing thread pool
+ * File data uses the same in-kernel copy path as zfo_copy().
+ */
+int zfo_copy_parallel(
+    const char* src,
+    const char* dst,
+    const zfo_copy_options_t* copy_opts,
+    const zfo_tree_options_t* opts,
+    zfo_tree_result_t* result
+);
+
+/**
+ * Move a tree: rename when possible, else parallel copy + remove
+ */
+int zfo_move_parallel(
+    const char* src,
+    const char* dst,
+    const zfo_copy_options_t* copy_opts,
+    const zfo_tree_options_t* opts,
+    zfo_tree_result_t* result
+);
+
+/**
+ * Release errors held by a tree result
+ */
+void zfo_tree_result_free(zfo_tree_result_t* result);
+
+/**
+ * Resolve a worker count the way the tree and walk functions do
+ * @param requested Requested threads (<= 0 = online CPUs)
+ * @return Count in [1, 64]
+ */
+int zfo_thread_count(int requested);
+
+/* ============================================================
+ * Parallel Walker
+ * ============================================================ */
+
+#define ZFO_WALK_STAT            0x01   /* statx every emitted entry */
+#define ZFO_WALK_FOLLOW_SYMLINKS 0x02   /* Descend into symlinked dirs */
+#define ZFO_WALK_SKIP_HIDDEN     0x04   /* Ignore dot-entries entirely */
+
+/* Visit callback results */
+#define ZFO_WALK_CONTINUE 0             /* Keep going */
+#define ZFO_WALK_PRUNE    1             /* Don't descend into this dir */
+#define ZFO_WALK_STOP     2             /* Cancel the whole walk */
+
+/**
+ * Entry handed to the visit callback. Everything is borrowed and
+ * only valid for the duration of the call.
+ */
+typedef struct {
+    const char* path;               /* root + "/" + relative path */
+    size_t path_len;
+    const char* name;               /* Final component (inside path) */
+    int depth;                      /* 1 for children of the root */
+    zfo_file_type_t type;           /* From d_type; resolved if unknown */
+    uint64_t inode;
+    int dir_fd;                     /* Open parent directory */
+    const zfo_stat_t* stat;         /* NULL unless ZFO_WALK_STAT */
+    int worker;                     /* Calling worker, < zfo_thread_count() */
+} zfo_walk_entry_t;
+
+/**
+ * Visit callback; runs concurrently on worker threads
+ * @return ZFO_WALK_CONTINUE, ZFO_WALK_PRUNE or ZFO_WALK_STOP
+ */
+typedef int (*zfo_walk_visit_t)(const zfo_walk_entry_t* entry, void* userdata);
+
+typedef struct {
+    int threads;                    /* Worker threads (0 = CPU count) */
+    int max_depth;                  /* Deepest entry emitted (< 0 = unlimited) */
+    uint32_t flags;                 /* ZFO_WALK_* */
+    const char* const* prune;       /* Directory names never entered */
+    size_t prune_count;
+    zfo_walk_visit_t visit;
+    void* userdata;
+    size_t max_errors;              /* Errors kept in result (0 = 64) */
+} zfo_walk_options_t;
+
+/**
+ * Walk a tree on a work-stealing thread pool
+ *
+ * Entries come from getdents64 with d_type, so nothing is stat'ed
+ * unless ZFO_WALK_STAT is set (or the filesystem reports DT_UNKNOWN).
+ * Each directory is opened relative to its parent's descriptor.
+ * Unreadable directories are recorded in result and skipped.
+ *
+ * @param result Optional totals and errors (free with zfo_tree_result_free)
+ */
+int zfo_walk_parallel(
+    const char* root,
+    const zfo_walk_options_t* opts,
+    zfo_tree_result_t* result
+);
+
 /* ============================================================
  * Directory Operations
  * ============================================================ */
@@ -516,7 +1110,7 @@ void zfo_rewinddir(zfo_dir_t* dir);
 int zfo_closedir(zfo_dir_t* dir);
 
 /**
- * Walk directory tree
+ * Walk directory tree (serial, stats every entry)
  * @param path Starting path
  * @param callback Called for each entry
  * @param max_depth Maximum depth (-1 for unlimited)
@@ -538,32 +1132,132 @@ int zfo_walk(
 int zfo_listdir(const char* path, zfo_dirent_t** out_entries, size_t* out_count);
 
 /* ============================================================
- * Path Utilities
+ * Columnar Stat
  * ============================================================ */
 
 /**
- * Get absolute path
+ * Stat results for many entries, one array per field. Every numeric
+ * column lives in one allocation (block) laid out so it can back JS
+ * typed arrays directly: three 8-byte columns, then the 4-byte ones,
+ * then type.
  */
-int zfo_realpath(const char* path, char* resolved, size_t size);
+typedef struct {
+    size_t count;
+    double* size;                   /* Apparent size in bytes */
+    double* mtime_ms;               /* Modification time, ms since the epoch */
+    uint64_t* inode;
+    uint32_t* mode;                 /* st_mode with type bits; 0 if stat failed */
+    uint32_t* name_offsets;         /* count + 1 offsets into names */
+    uint8_t* type;                  /* zfo_file_type_t */
+    void* block;
+    size_t block_size;
+    char* names;                    /* Packed UTF-8 names, no separators */
+    size_t names_len;
+} zfo_statcols_t;
 
 /**
- * Get directory name component
+ * statx every path in one call. Paths that can't be stat'ed get mode 0
+ * and type ZFO_TYPE_UNKNOWN. names is NULL.
  */
-int zfo_dirname(const char* path, char* buf, size_t size);
+int zfo_stat_many(const char* const* paths, size_t count, bool follow,
+                  zfo_statcols_t* out);
 
 /**
- * Get filename component
+ * List a directory and statx each entry relative to it, without
+ * following symlinks. Single getdents pass; names are packed.
  */
-int zfo_basename(const char* path, char* buf, size_t size);
+int zfo_readdir_plus(const char* path, zfo_statcols_t* out);
 
 /**
- * Get file extension (without dot)
+ * Free columns filled by zfo_stat_many or zfo_readdir_plus. Either
+ * block or names may be taken over by the caller and set to NULL first.
  */
-int zfo_extname(const char* path, char* buf, size_t size);
+void zfo_statcols_free(zfo_statcols_t* cols);
 
-/**
- * Join path components
- */
+/* ============================================================
+ * Disk Usage
+ * ============================================================ */
+
+#define ZFO_DU_SKIP_HIDDEN   0x01   /* Ignore dot-entries entirely */
+#define ZFO_DU_ONE_FS        0x02   /* Don't cross into other filesystems */
+#define ZFO_DU_COUNT_LINKS   0x04   /* Count every hard link, not just the first */
+
+typedef struct {
+    int threads;                    /* Worker threads (0 = CPU count) */
+    int max_depth;                  /* Deepest directory with its own row (< 0 = all) */
+    uint32_t flags;                 /* ZFO_DU_* */
+    const char* const* prune;       /* Directory names never entered */
+    size_t prune_count;
+} zfo_du_options_t;
+
+/**
+ * Per-directory totals, one row per directory down to max_depth,
+ * sorted by path so every parent comes before its children. Row 0 is
+ * the root (empty name). Totals cover the whole subtree; deeper
+ * directories are folded into their ancestor at max_depth. Columns
+ * share one block laid out like zfo_statcols_t.
+ */
+typedef struct {
+    size_t count;
+    double* apparent;               /* Sum of st_size */
+    double* allocated;              /* Sum of st_blocks * 512 */
+    double* files;                  /* Non-directories below */
+    double* dirs;                   /* Directories below, excluding itself */
+    int32_t* parent;                /* Row index of the parent (-1 for the root) */
+    uint32_t* depth;                /* 0 for the root */
+    uint32_t* name_offsets;         /* count + 1 offsets into names */
+    void* block;
+    size_t block_size;
+    char* names;                    /* Packed paths relative to the root */
+    size_t names_len;
+    uint64_t hardlinks;             /* Links skipped as already counted */
+    zfo_tree_result_t walk;         /* Walk totals and errors */
+} zfo_du_result_t;
+
+/**
+ * Measure a tree on the parallel walker with statx, counting hard
+ * linked files once per (dev, inode) unless ZFO_DU_COUNT_LINKS is set.
+ * Unreadable entries are recorded in result->walk and skipped; the
+ * rows are filled even when the return value reports one of them.
+ *
+ * @param opts Options (NULL = max_depth 1)
+ * @param result Output (free with zfo_du_result_free)
+ */
+int zfo_du(const char* root, const zfo_du_options_t* opts, zfo_du_result_t* result);
+
+/**
+ * Free rows and walk errors. block or names may be taken over by the
+ * caller and set to NULL first.
+ */
+void zfo_du_result_free(zfo_du_result_t* result);
+
+/* ============================================================
+ * Path Utilities
+ * ============================================================ */
+
+/**
+ * Get absolute path
+ */
+int zfo_realpath(const char* path, char* resolved, size_t size);
+
+/**
+ * Get directory name component
+ */
+int zfo_dirname(const char* path, char* buf, size_t size);
+
+/**
+ * Get filename component
+ */
+int zfo_basename(const char* path, char* buf, size_t size);
+
+/**
+ * Get file extension (without dot)
+ */
+int zfo_extname(const char* path, char* buf, size_t size);
+
+/**
+ * Join path components
+ */
 int zfo_join(char* buf, size_t size, const char* base, const char* path);
 
 /**
@@ -571,6 +1265,18 @@ int zfo_join(char* buf, size_t size, const char* base, const char* path);
  */
 int zfo_normalize(const char* path, char* buf, size_t size);
 
+/**
+ * Normalize len bytes of path into out, which needs len + 2 bytes
+ * @return Length written (out is NUL-terminated)
+ */
+size_t zfo_normalize_len(const char* path, size_t len, char* out);
+
+/**
+ * Relative path from one path to another, both taken lexically
+ * against the current directory ("" when they are the same)
+ */
+int zfo_relative(const char* from, const char* to, char* buf, size_t size);
+
 /**
  * Check if path is absolute
  */
@@ -599,6 +1305,67 @@ int zfo_tmpdir(char* buf, size_t size);
  */
 zfo_file_t* zfo_tmpfile(const char* prefix, char* out_path);
 
+/* ============================================================
+ * Path Batches
+ * ============================================================ */
+
+typedef enum {
+    ZFO_PATH_JOIN,          /* zfo_join(base, path) */
+    ZFO_PATH_NORMALIZE,     /* zfo_normalize(path) */
+    ZFO_PATH_RELATIVE,      /* zfo_relative(base or ".", path) */
+    ZFO_PATH_RESOLVE        /* zfo_realpath of path, joined to base if given */
+} zfo_path_op_t;
+
+/**
+ * Apply op to every path in a NUL-separated list
+ * @param base Base for join (required), relative and resolve (optional)
+ * @param out Results, each NUL-terminated, in input order (free with free).
+ *            A path that fails to resolve yields an empty string.
+ * @param out_count Number of results (may be NULL)
+ */
+int zfo_path_batch(zfo_path_op_t op, const char* base, const char* in, size_t in_len,
+                   char** out, size_t* out_len, size_t* out_count);
+
+/**
+ * Path table: interns normalized paths as (parent, name) nodes so
+ * shared directories are stored once. Ids are dense; 0 is "/" and
+ * 1 is ".". Not thread-safe.
+ */
+typedef struct zfo_path_table zfo_path_table_t;
+
+typedef struct {
+    size_t paths;           /* Nodes, including both roots */
+    size_t names;           /* Distinct components */
+    size_t bytes;           /* Approximate memory held */
+} zfo_path_table_stats_t;
+
+zfo_path_table_t* zfo_path_table_create(void);
+void zfo_path_table_destroy(zfo_path_table_t* table);
+
+/**
+ * Normalize path and return its id, adding nodes as needed
+ */
+int zfo_path_table_intern(zfo_path_table_t* table, const char* path, size_t len, uint32_t* out_id);
+
+/**
+ * Write the path for id into buf if it fits
+ * @return Length of the path (0 for an unknown id), like snprintf
+ */
+size_t zfo_path_table_get(const zfo_path_table_t* table, uint32_t id, char* buf, size_t size);
+
+/**
+ * Id of the directory holding id (roots are their own parent)
+ * @return UINT32_MAX for an unknown id
+ */
+uint32_t zfo_path_table_parent(const zfo_path_table_t* table, uint32_t id);
+
+/**
+ * Last component of id, or NULL for an unknown id
+ */
+const char* zfo_path_table_name(const zfo_path_table_t* table, uint32_t id, size_t* len);
+
+void zfo_path_table_stats(const zfo_path_table_t* table, zfo_path_table_stats_t* out);
+
 /* ============================================================
  * Memory Mapping
  * ============================================================ */
@@ -614,10 +1381,10 @@ typedef enum {
 /**
  * Memory-map a file
  * @param path File path
- * @param offset Offset into file
- * @param length Length to map (0 = entire file)
+ * @param offset Offset into file (need not be page aligned)
+ * @param length Length to map (0 = rest of the file)
  * @param flags Mapping flags
- * @return Map handle or NULL
+ * @return Map handle or NULL (EINVAL when the range extends past end of file)
  */
 zfo_mmap_t* zfo_mmap(const char* path, zfo_off_t offset, size_t length, int flags);
 
@@ -641,11 +1408,39 @@ size_t zfo_mmap_size(zfo_mmap_t* map);
  */
 int zfo_mmap_sync(zfo_mmap_t* map);
 
+typedef enum {
+    ZFO_MADV_NORMAL = 0,        /* No special treatment */
+    ZFO_MADV_SEQUENTIAL = 1,    /* Aggressive read-ahead, early reclaim */
+    ZFO_MADV_RANDOM = 2,        /* Disable read-ahead */
+    ZFO_MADV_WILLNEED = 3,      /* Start reading the range in now */
+    ZFO_MADV_DONTNEED = 4       /* Range may be dropped from memory */
+} zfo_mmap_advice_t;
+
+/**
+ * Give the kernel an access-pattern hint (madvise)
+ * @param length Bytes from offset (0 = to the end)
+ */
+int zfo_mmap_advise(zfo_mmap_t* map, zfo_mmap_advice_t advice, size_t offset, size_t length);
+
+/**
+ * Lock the mapping into RAM (mlock) or release the lock
+ */
+int zfo_mmap_lock(zfo_mmap_t* map, bool lock);
+
 /**
  * Unmap memory
  */
 int zfo_mmap_close(zfo_mmap_t* map);
 
+/**
+ * Map a whole regular file for reading without holding its descriptor.
+ * The mapping is private copy-on-write: pages are shared with the page
+ * cache until written, and writes never reach the file.
+ * @param out_map Output map (release with zfo_mmap_close)
+ * @return ZFO_OK, or ZFO_ERR_INVALID_ARG for an empty file
+ */
+int zfo_mmap_read_file(const char* path, zfo_mmap_t** out_map);
+
 /* ============================================================
  * File Watching
  * ============================================================ */
@@ -696,6 +1491,68 @@ int zfo_watch_fd(zfo_watch_t* watch);
  */
 void zfo_watch_destroy(zfo_watch_t* watch);
 
+/* ============================================================
+ * Event-Driven Watcher
+ * ============================================================ */
+
+/**
+ * A coalesced change. MODIFY/ATTRIB bursts fold into one entry per
+ * path, a CREATE followed by DELETE cancels out, and MOVE_FROM/MOVE_TO
+ * pairs with the same cookie become a single RENAME.
+ */
+typedef struct {
+    zfo_watch_event_t event;        /* Event type */
+    char* path;                     /* Affected path (new path for RENAME) */
+    char* old_path;                 /* Previous path (RENAME only, else NULL) */
+    uint32_t cookie;                /* Cookie for unpaired move events */
+    uint32_t count;                 /* Raw events folded into this change */
+    bool is_dir;                    /* Is directory? */
+} zfo_watch_change_t;
+
+/**
+ * Batch callback, run on the watcher thread.
+ * Takes ownership of changes (release with zfo_watch_changes_free).
+ */
+typedef void (*zfo_watch_batch_fn)(zfo_watch_change_t* changes, size_t count, void* userdata);
+
+typedef struct {
+    uint32_t debounce_ms;           /* Quiet period before a flush (0 = 50) */
+    uint32_t max_latency_ms;        /* Longest a change is held (0 = 1000) */
+    size_t max_batch;               /* Flush early at this many changes (0 = 4096) */
+    zfo_watch_batch_fn on_batch;    /* Required */
+    void* userdata;
+} zfo_watcher_options_t;
+
+typedef struct zfo_watcher zfo_watcher_t;
+
+/**
+ * Create a watcher with its own inotify instance and event thread
+ * @return Watcher handle or NULL
+ */
+zfo_watcher_t* zfo_watcher_create(const zfo_watcher_options_t* opts);
+
+/**
+ * Add path to watch (safe to call while the thread is running)
+ * @return Watch descriptor (>= 0) or error
+ */
+int zfo_watcher_add(zfo_watcher_t* watcher, const char* path, int events, bool recursive);
+
+/**
+ * Remove path from watch
+ */
+int zfo_watcher_remove(zfo_watcher_t* watcher, int wd);
+
+/**
+ * Stop the thread and destroy the watcher. Changes not yet flushed
+ * are discarded; on_batch is never called after this returns.
+ */
+void zfo_watcher_destroy(zfo_watcher_t* watcher);
+
+/**
+ * Free a batch handed to zfo_watch_batch_fn
+ */
+void zfo_watch_changes_free(zfo_watch_change_t* changes, size_t count);
+
 /* ============================================================
  * Locking
  * ============================================================ */
@@ -708,6 +1565,7 @@ typedef enum {
 
 /**
  * Lock file region
+ * @return ZFO_ERR_BUSY if NONBLOCK and another process holds it
  */
 int zfo_lock(zfo_file_t* file, zfo_off_t offset, zfo_off_t length, int flags);
 
@@ -733,6 +1591,214 @@ int zfo_atomic_write(const char* path, const void* buf, size_t size);
  */
 int zfo_atomic_update(const char* path, int (*callback)(zfo_file_t*, void*), void* userdata);
 
+/** Flush with one syncfs per filesystem instead of fdatasync per file */
+#define ZFO_BATCH_SYNCFS   0x01
+/** Stage data in unnamed O_TMPFILE inodes where the filesystem allows */
+#define ZFO_BATCH_TMPFILE  0x02
+
+/** Group-commit writer (opaque) */
+typedef struct zfo_write_batch zfo_write_batch_t;
+
+typedef struct {
+    uint64_t files;                 /**< Targets replaced */
+    uint64_t flushes;               /**< fdatasync or syncfs calls */
+    uint64_t dir_syncs;             /**< Directories fsync'ed */
+} zfo_batch_stats_t;
+
+/**
+ * Create a batch of atomic writes that share one commit
+ * @param flags ZFO_BATCH_*
+ */
+zfo_write_batch_t* zfo_batch_create(uint32_t flags);
+
+/**
+ * Write data to a temp file beside path. Nothing is visible at path
+ * until commit; a second add for the same path replaces the first.
+ */
+int zfo_batch_add(zfo_write_batch_t* batch, const char* path, const void* buf, size_t size);
+
+/**
+ * Number of staged files
+ */
+size_t zfo_batch_count(const zfo_write_batch_t* batch);
+
+/**
+ * Flush all staged data, rename every file into place and fsync each
+ * directory once. Each file is replaced atomically, but the batch is
+ * not: if a rename fails, the files before it stay replaced. The
+ * batch is empty afterwards either way and can be reused.
+ *
+ * @param stats Optional counters
+ */
+int zfo_batch_commit(zfo_write_batch_t* batch, zfo_batch_stats_t* stats);
+
+/**
+ * Drop everything staged, leaving targets untouched
+ */
+void zfo_batch_abort(zfo_write_batch_t* batch);
+
+/**
+ * Free the batch, aborting anything still staged
+ */
+void zfo_batch_free(zfo_write_batch_t* batch);
+
+/* ============================================================
+ * Write-Ahead Log
+ * ============================================================ */
+
+typedef struct zfo_wal zfo_wal_t;
+
+typedef struct {
+    uint64_t segment_size;          /**< Preallocated bytes per segment (0 = 64 MiB) */
+    uint32_t sync_ms;               /**< Group-commit interval (0 = none) */
+    uint64_t sync_bytes;            /**< Sync once this much is pending (0 = none) */
+} zfo_wal_options_t;
+
+typedef struct {
+    uint64_t next_seq;              /**< Sequence the next append gets */
+    uint64_t written_seq;           /**< Last record handed to the kernel */
+    uint64_t durable_seq;           /**< Last record known to be on disk */
+    uint64_t segments;
+    uint64_t syncs;
+} zfo_wal_stats_t;
+
+/**
+ * Record visitor for zfo_wal_replay
+ * @param data Valid only for the duration of the call
+ * @return false to stop
+ */
+typedef bool (*zfo_wal_record_fn)(uint64_t seq, const void* data, size_t len, void* userdata);
+
+/**
+ * Open (creating if needed) the log in dir. The last segment is
+ * scanned and any torn tail is cut off, so appends continue right
+ * after the last complete record. With sync_ms or sync_bytes set, a
+ * background thread group-commits pending appends.
+ */
+int zfo_wal_open(const char* dir, const zfo_wal_options_t* opts, zfo_wal_t** out);
+
+/**
+ * Append one record. This only copies into memory; durability comes
+ * from the sync policy or zfo_wal_sync.
+ * @param out_seq Optional, receives the record's sequence number
+ */
+int zfo_wal_append(zfo_wal_t* wal, const void* data, size_t len, uint64_t* out_seq);
+
+/**
+ * Hand buffered records to the kernel without waiting for the disk
+ */
+int zfo_wal_flush(zfo_wal_t* wal);
+
+/**
+ * Make every appended record durable
+ */
+int zfo_wal_sync(zfo_wal_t* wal);
+
+/**
+ * Delete whole segments holding only records before before_seq.
+ * The current segment is never removed.
+ */
+int zfo_wal_truncate(zfo_wal_t* wal, uint64_t before_seq);
+
+void zfo_wal_stats(zfo_wal_t* wal, zfo_wal_stats_t* stats);
+
+/**
+ * Sync, trim the preallocated tail and free the handle
+ * @return First I/O error the log hit, if any
+ */
+int zfo_wal_close(zfo_wal_t* wal);
+
+/**
+ * Visit every record with seq >= from_seq, in order. Reads whatever
+ * is on disk, so call zfo_wal_flush first when the log is open.
+ * @param out_last_seq Optional, last sequence number in the log
+ * @return ZFO_ERR_IO when a segment is missing or cut short
+ */
+int zfo_wal_replay(const char* dir, uint64_t from_seq, zfo_wal_record_fn fn, void* userdata,
+                   uint64_t* out_last_seq);
+
+/* ============================================================
+ * Key-Value Store
+ * ============================================================ */
+
+#define ZFO_KV_SYNC            0x01    /* fdatasync after every put and delete */
+#define ZFO_KV_NO_AUTO_MERGE   0x02    /* Merge only when zfo_kv_merge is called */
+
+typedef struct zfo_kv zfo_kv_t;
+
+typedef struct {
+    uint64_t max_file_size;         /**< Data file size before rolling over (0 = 64 MiB) */
+    uint32_t merge_dead_percent;    /**< Merge once this share is dead (0 = 50, > 100 = never) */
+    uint64_t merge_min_bytes;       /**< ...and at least this much (0 = max_file_size / 4) */
+    uint32_t flags;                 /**< ZFO_KV_* */
+} zfo_kv_options_t;
+
+typedef struct {
+    uint64_t keys;
+    uint64_t files;
+    uint64_t total_bytes;           /**< Every record on disk */
+    uint64_t live_bytes;            /**< Records the keydir points at */
+    uint64_t merges;
+    bool merging;
+} zfo_kv_stats_t;
+
+/** Key visitor for zfo_kv_keys; return false to stop */
+typedef bool (*zfo_kv_key_fn)(const void* key, size_t len, void* userdata);
+
+/**
+ * Open (creating if needed) the store in dir and rebuild the keydir
+ * from hint files and data files. Only one handle may have a directory
+ * open at a time.
+ * @return ZFO_ERR_BUSY if another handle has it open
+ */
+int zfo_kv_open(const char* dir, const zfo_kv_options_t* opts, zfo_kv_t** out);
+
+/**
+ * Store value under key with one append
+ */
+int zfo_kv_put(zfo_kv_t* kv, const void* key, size_t key_len, const void* value, size_t val_len);
+
+/**
+ * Read key's value with one pread, checked against its record checksum
+ * @param out Receives a malloc'd copy of the value (caller frees)
+ * @return ZFO_ERR_NOT_FOUND, or ZFO_ERR_IO if the record is corrupt
+ */
+int zfo_kv_get(zfo_kv_t* kv, const void* key, size_t key_len, void** out, size_t* out_len);
+
+bool zfo_kv_has(zfo_kv_t* kv, const void* key, size_t key_len);
+
+/**
+ * Append a delete marker and drop key
+ * @return ZFO_ERR_NOT_FOUND if key isn't stored
+ */
+int zfo_kv_delete(zfo_kv_t* kv, const void* key, size_t key_len);
+
+/**
+ * Visit every key, in no particular order, under the store's lock
+ * @return Keys visited
+ */
+size_t zfo_kv_keys(zfo_kv_t* kv, zfo_kv_key_fn fn, void* userdata);
+
+/**
+ * Make every put and delete so far durable
+ */
+int zfo_kv_sync(zfo_kv_t* kv);
+
+/**
+ * Rewrite the live records of every file but the active one into new
+ * files with hint files, then delete the old ones. Puts and gets carry
+ * on meanwhile.
+ * @return ZFO_ERR_BUSY if a merge is already running
+ */
+int zfo_kv_merge(zfo_kv_t* kv);
+
+void zfo_kv_stats(zfo_kv_t* kv, zfo_kv_stats_t* out);
+
+/**
+ * Stop the merge thread, seal the active file and free the handle
+ */
+int zfo_kv_close(zfo_kv_t* kv);
+
 /* ============================================================
  * Glob/Pattern Matching
  * ============================================================ */
@@ -755,6 +1821,295 @@ void zfo_glob_free(char** paths, size_t count);
  */
 bool zfo_match(const char* pattern, const char* filename);
 
+/** Wildcards and ** also match names starting with '.' */
+#define ZFO_GLOB_DOT     0x01
+/** Case-insensitive matching */
+#define ZFO_GLOB_NOCASE  0x02
+
+/** Compiled set of glob patterns */
+typedef struct zfo_glob_set zfo_glob_set_t;
+
+/**
+ * Compile glob patterns into a matcher set
+ *
+ * Supports * ? [...] \ escapes, {a,b} brace expansion (nested) and **
+ * across directories. A leading '!' excludes matches; a trailing '/'
+ * matches directories only.
+ *
+ * @param patterns Array of patterns
+ * @param count Number of patterns
+ * @param flags ZFO_GLOB_* flags
+ * @param out Output set (free with zfo_glob_set_free)
+ */
+int zfo_glob_compile(const char* const* patterns, size_t count, uint32_t flags,
+                     zfo_glob_set_t** out);
+
+/**
+ * Match a '/'-separated relative path against a compiled set
+ * @return true if any pattern matches and no '!' pattern does
+ */
+bool zfo_glob_set_match(const zfo_glob_set_t* set, const char* path, bool is_dir);
+
+/**
+ * Free a compiled set
+ */
+void zfo_glob_set_free(zfo_glob_set_t* set);
+
+/**
+ * Options for zfo_glob_walk
+ */
+typedef struct {
+    zfo_walk_options_t walk;            /**< Walk options; visit sees matches only */
+    const char* const* ignore;          /**< Extra ignore rules (.gitignore syntax) */
+    size_t ignore_count;
+    const char* const* ignore_files;    /**< Per-directory ignore file names, e.g. ".gitignore" */
+    size_t ignore_file_count;
+} zfo_glob_options_t;
+
+/**
+ * Walk root in parallel and visit entries matching the set
+ *
+ * Directories that no pattern can descend into, and directories
+ * excluded by ignore rules, are never opened.
+ *
+ * @param root Root directory; matched paths are relative to it
+ * @param set Compiled patterns
+ * @param opts Options
+ * @param result Optional totals
+ */
+int zfo_glob_walk(const char* root, const zfo_glob_set_t* set,
+                  const zfo_glob_options_t* opts, zfo_tree_result_t* result);
+
+/* ============================================================
+ * Content Search
+ * ============================================================ */
+
+/** ASCII case-insensitive matching */
+#define ZFO_SEARCH_NOCASE  0x01
+/** Search files that look binary (NUL in the first 8 KB) */
+#define ZFO_SEARCH_BINARY  0x02
+
+/**
+ * One matching line. Pointers are valid only during the callback.
+ */
+typedef struct {
+    const char* path;
+    size_t path_len;
+    uint64_t line;                  /**< 1-based line number */
+    uint64_t column;                /**< 1-based byte column of the first match */
+    const char* text;               /**< Line text (not NUL-terminated, no '\n') */
+    size_t text_len;
+    uint32_t pattern;               /**< Index of the pattern that matched */
+    int worker;                     /**< Pool worker running the callback */
+} zfo_search_match_t;
+
+/**
+ * Match callback, run on pool workers
+ * @return ZFO_WALK_CONTINUE, or ZFO_WALK_STOP to end the search
+ */
+typedef int (*zfo_search_match_fn)(const zfo_search_match_t* match, void* userdata);
+
+typedef struct {
+    zfo_glob_options_t files;       /**< Walk and ignore options (files.walk.visit is unused) */
+    const zfo_glob_set_t* include;  /**< Only search files matching this set (NULL = all) */
+    uint32_t flags;                 /**< ZFO_SEARCH_* */
+    uint64_t max_matches;           /**< Stop after this many lines (0 = unlimited) */
+    uint64_t max_file_size;         /**< Skip larger files (0 = unlimited) */
+    size_t mmap_threshold;          /**< Map files at least this big (0 = 256 KB) */
+    size_t max_line_len;            /**< Truncate reported text (0 = whole line) */
+    zfo_search_match_fn on_match;
+    void* userdata;
+} zfo_search_options_t;
+
+typedef struct {
+    zfo_tree_result_t walk;         /**< Walk totals and errors */
+    uint64_t files_searched;
+    uint64_t files_matched;
+    uint64_t files_binary;          /**< Skipped as binary */
+    uint64_t files_unreadable;
+    uint64_t bytes_searched;
+    uint64_t matches;
+    bool limit_reached;
+} zfo_search_result_t;
+
+/**
+ * Search file contents under root for any of the literal patterns
+ *
+ * Runs on the parallel walker; every file becomes a task on the same
+ * work-stealing pool. Small files are read with pread into a per-worker
+ * buffer, large ones are mapped. Reports each matching line once.
+ *
+ * @param result Optional totals (free with zfo_tree_result_free(&result->walk))
+ */
+int zfo_search(const char* root, const char* const* patterns, size_t count,
+               const zfo_search_options_t* opts, zfo_search_result_t* result);
+
+/* ============================================================
+ * Duplicate Finder
+ * ============================================================ */
+
+typedef struct {
+    zfo_glob_options_t files;       /**< Walk and ignore options (files.walk.visit is unused) */
+    const zfo_glob_set_t* include;  /**< Only consider files matching this set (NULL = all) */
+    uint64_t min_size;              /**< Ignore smaller files (0 = 1, empty files never count) */
+    uint64_t max_size;              /**< Ignore larger files (0 = unlimited) */
+    size_t partial_bytes;           /**< Bytes hashed at each end in the first pass (0 = 4096) */
+    bool skip_hardlinks;            /**< Report paths sharing an inode as a single file */
+} zfo_dedup_options_t;
+
+typedef struct {
+    uint64_t size;                  /**< Size of each file */
+    uint64_t hash;                  /**< Content hash (nxh64-based) */
+    char** paths;
+    size_t count;
+} zfo_dup_group_t;
+
+typedef struct {
+    zfo_tree_result_t walk;         /**< Walk totals and errors */
+    zfo_dup_group_t* groups;        /**< Largest files first */
+    size_t group_count;
+    uint64_t files_scanned;         /**< Files within the size limits */
+    uint64_t candidates;            /**< Files sharing a size with another file */
+    uint64_t partial_hashed;
+    uint64_t full_hashed;
+    uint64_t bytes_hashed;
+    uint64_t hardlinks_skipped;
+    uint64_t files_failed;          /**< Unreadable while hashing */
+    uint64_t wasted_bytes;          /**< Sum of size * (count - 1) */
+} zfo_dedup_result_t;
+
+/**
+ * Find files with identical content under root
+ *
+ * Files are bucketed by size from the walk's stat data, then by an
+ * nxh64 of their first and last partial_bytes, and only the survivors
+ * are hashed in full (via mmap) on the thread pool.
+ *
+ * @param result Output (free with zfo_dedup_result_free)
+ */
+int zfo_find_duplicates(const char* root, const zfo_dedup_options_t* opts,
+                        zfo_dedup_result_t* result);
+
+/**
+ * Free duplicate groups and walk errors
+ */
+void zfo_dedup_result_free(zfo_dedup_result_t* result);
+
+/* ============================================================
+ * Directory Snapshot
+ * ============================================================ */
+
+/** Keep an nxh64 of every regular file; only content changes are reported */
+#define ZFO_SNAP_HASH  0x01
+
+typedef struct zfo_snapshot zfo_snapshot_t;
+
+typedef struct {
+    int threads;                    /**< Worker threads for scans (0 = CPU count) */
+    uint32_t flags;                 /**< ZFO_SNAP_* */
+    bool skip_hidden;               /**< Leave dot-entries out of the index */
+    const char* const* prune;       /**< Directory names never entered */
+    size_t prune_count;
+} zfo_snapshot_options_t;
+
+/**
+ * One indexed path. Pointers are borrowed from the snapshot and valid
+ * until it is next updated or freed.
+ */
+typedef struct {
+    const char* path;               /**< Relative to the root, '/'-separated */
+    size_t path_len;
+    zfo_file_type_t type;
+    uint32_t mode;                  /**< Permission bits */
+    uint64_t inode;
+    uint64_t size;
+    int64_t mtime_ns;
+    int64_t ctime_ns;
+    uint64_t hash;                  /**< Content hash when has_hash */
+    bool has_hash;
+} zfo_snap_entry_t;
+
+typedef enum {
+    ZFO_SNAP_ADDED = 1,
+    ZFO_SNAP_REMOVED = 2,
+    ZFO_SNAP_MODIFIED = 3
+} zfo_snap_change_kind_t;
+
+typedef struct {
+    zfo_snap_change_kind_t kind;
+    zfo_file_type_t type;           /**< Type after the change (before, for REMOVED) */
+    char* path;                     /**< Relative to the root */
+} zfo_snap_change_t;
+
+typedef struct {
+    zfo_snap_change_t* changes;     /**< Sorted by path */
+    size_t count;
+    uint64_t entries_checked;       /**< Paths re-stat'ed */
+    uint64_t dirs_scanned;          /**< Directories read */
+} zfo_snap_diff_t;
+
+/**
+ * Index every path under root
+ *
+ * Directories are read in parallel on a work-stealing pool. Symlinks
+ * are recorded, never followed.
+ */
+int zfo_snapshot_create(const char* root, const zfo_snapshot_options_t* opts,
+                        zfo_snapshot_t** out);
+
+/**
+ * Bring the snapshot up to date and report what changed
+ *
+ * Every indexed path is lstat'ed in parallel, but only directories
+ * whose mtime or inode changed are read again, so an unchanged tree
+ * costs one stat per entry and no readdir at all.
+ *
+ * @param diff Optional output (free with zfo_snap_diff_free)
+ */
+int zfo_snapshot_update(zfo_snapshot_t* snap, int threads, zfo_snap_diff_t* diff);
+
+/**
+ * Apply watcher changes to keep a snapshot warm without a rescan
+ *
+ * Only the named paths (and new directories below them) are looked
+ * at. An OVERFLOW change falls back to zfo_snapshot_update.
+ *
+ * @param diff Optional output (free with zfo_snap_diff_free)
+ */
+int zfo_snapshot_apply(zfo_snapshot_t* snap, const zfo_watch_change_t* changes,
+                       size_t count, zfo_snap_diff_t* diff);
+
+/**
+ * Write the snapshot to a file (temp file, fsync, rename)
+ *
+ * The file holds a header, fixed 64-byte records sorted by path and
+ * a string table, and is loaded by mapping it.
+ */
+int zfo_snapshot_save(const zfo_snapshot_t* snap, const char* path);
+
+/**
+ * Map a saved snapshot. Strings stay in the mapping until they change.
+ */
+int zfo_snapshot_load(const char* path, zfo_snapshot_t** out);
+
+const char* zfo_snapshot_root(const zfo_snapshot_t* snap);
+size_t zfo_snapshot_count(const zfo_snapshot_t* snap);
+
+/**
+ * Entry by index, in path order
+ */
+int zfo_snapshot_entry(const zfo_snapshot_t* snap, size_t index, zfo_snap_entry_t* entry);
+
+/**
+ * Entry by relative path (binary search)
+ * @return ZFO_OK or ZFO_ERR_NOT_FOUND
+ */
+int zfo_snapshot_find(const zfo_snapshot_t* snap, const char* path, zfo_snap_entry_t* entry);
+
+void zfo_snapshot_free(zfo_snapshot_t* snap);
+
+void zfo_snap_diff_free(zfo_snap_diff_t* diff);
+
 /* ============================================================
  * Disk Space
  * ============================================================ */
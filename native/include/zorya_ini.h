@@ -220,9 +220,15 @@ zorya_ini_error_t zorya_ini_load_buffer(
 /**
  * @brief Load compiled binary INI
  *
+ * Maps the file read-only and serves lookups from it in place; no
+ * parsing or interpolation happens at load time. Keys parsed or set
+ * afterwards shadow compiled keys. Loading another blob replaces the
+ * previous mapping.
+ *
  * @param ini      INI context
  * @param filepath Path to compiled .dd file
- * @return ZORYA_INI_OK on success, error code on failure
+ * @return ZORYA_INI_OK on success, ZORYA_INI_ERROR_SYNTAX if the file
+ *         is not a valid compiled INI, error code on other failures
  */
 zorya_ini_error_t zorya_ini_load_binary(ZoryaIni *ini, const char *filepath);
 
@@ -471,7 +477,10 @@ char* zorya_ini_to_string(const ZoryaIni *ini, size_t *len);
 /**
  * @brief Compile to binary format
  *
- * Creates a DAGGER-backed binary file for O(1) lookups.
+ * Writes resolved values, pre-parsed typed values and a prebuilt
+ * hash index to a single blob for O(1) lookups after
+ * zorya_ini_load_binary(). The file is written to "<filepath>.tmp"
+ * and renamed into place. Blobs use host byte order.
  *
  * @param ini      INI context
  * @param filepath Output .dd file path
@@ -58,6 +58,69 @@
 #define DECLARE_NAPI_METHOD(name, func)                               \
     { name, 0, func, 0, 0, 0, napi_default, 0 }
 
+/* ============================================================
+ * KEY ARGUMENTS
+ * ============================================================ */
+
+#define INI_KEY_STACK_SIZE 256
+
+/**
+ * @brief Read a key argument without a heap copy when it fits
+ * 
+ * Getters run on hot paths, so keys shorter than the stack buffer are
+ * decoded in place. Longer keys fall back to malloc; release either
+ * with release_key().
+ * 
+ * @return Key string, or NULL with a pending exception
+ */
+static char* read_key(napi_env env, napi_value value, char *stack, size_t stack_size) {
+    size_t key_len;
+    NAPI_CALL(env, napi_get_value_string_utf8(env, value, stack, stack_size, &key_len));
+    
+    /* A truncated copy never ends in a partial UTF-8 sequence, so it can
+     * come back up to 3 bytes short; re-check the real length then. */
+    if (key_len + 4 < stack_size) {
+        return stack;
+    }
+    NAPI_CALL(env, napi_get_value_string_utf8(env, value, NULL, 0, &key_len));
+    if (key_len + 1 <= stack_size) {
+        return stack;
+    }
+    
+    char *key = malloc(key_len + 1);
+    if (key == NULL) {
+        napi_throw_error(env, NULL, "Memory allocation failed");
+        return NULL;
+    }
+    
+    if (napi_get_value_string_utf8(env, value, key, key_len + 1, &key_len) != napi_ok) {
+        free(key);
+        napi_throw_error(env, NULL, "Failed to read key");
+        return NULL;
+    }
+    return key;
+}
+
+/**
+ * @brief Release a key returned by read_key()
+ */
+static void release_key(char *key, char *stack) {
+    if (key != stack) {
+        free(key);
+    }
+}
+
+/**
+ * @brief Check whether an optional argument was passed
+ */
+static bool has_arg(napi_env env, size_t argc, napi_value *args, size_t index) {
+    if (argc <= index) return false;
+    
+    napi_valuetype type;
+    if (napi_typeof(env, args[index], &type) != napi_ok) return false;
+    return type != napi_undefined && type != napi_null;
+}
+
 /* ============================================================
  * ZORYA_INI_NEW - Create new INI context
  * ============================================================ */
@@ -229,6 +292,59 @@ static napi_value ZoryaIniLoadString(napi_env env, napi_callback_info info) {
     return result;
 }
 
+/* ============================================================
+ * ZORYA_INI_LOAD_BINARY - Load compiled .dd file
+ * ============================================================ */
+
+/**
+ * @brief Map a compiled INI blob into the context
+ * 
+ * JavaScript: ini.loadBinary(ctx, '/path/to/config.dd');
+ */
+static napi_value ZoryaIniLoadBinary(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+    
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Expected 2 arguments: context, filepath");
+        return NULL;
+    }
+    
+    /* Get context */
+    ZoryaIni *ini;
+    NAPI_CALL(env, napi_get_value_external(env, args[0], (void**)&ini));
+    
+    /* Get filepath */
+    size_t path_len;
+    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], NULL, 0, &path_len));
+    
+    char *filepath = malloc(path_len + 1);
+    if (filepath == NULL) {
+        napi_throw_error(env, NULL, "Memory allocation failed");
+        return NULL;
+    }
+    
+    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], filepath, path_len + 1, &path_len));
+    
+    /* Map blob */
+    zorya_ini_error_t err = zorya_ini_load_binary(ini, filepath);
+    free(filepath);
+    
+    if (err != ZORYA_INI_OK) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "INI binary load error: %s",
+                 err == ZORYA_INI_ERROR_SYNTAX ? "Not a compiled INI file" :
+                 zorya_ini_strerror(err));
+        napi_throw_error(env, NULL, error_msg);
+        return NULL;
+    }
+    
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, true, &result));
+    return result;
+}
+
 /* ============================================================
  * ZORYA_INI_GET - Get string value
  * ============================================================ */
@@ -253,20 +369,15 @@ static napi_value ZoryaIniGet(napi_env env, napi_callback_info info) {
     NAPI_CALL(env, napi_get_value_external(env, args[0], (void**)&ini));
     
     /* Get key */
-    size_t key_len;
-    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], NULL, 0, &key_len));
-    
-    char *key = malloc(key_len + 1);
+    char stack_key[INI_KEY_STACK_SIZE];
+    char *key = read_key(env, args[1], stack_key, sizeof(stack_key));
     if (key == NULL) {
-        napi_throw_error(env, NULL, "Memory allocation failed");
         return NULL;
     }
     
-    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], key, key_len + 1, &key_len));
-    
     /* Get value */
     const char *value = zorya_ini_get(ini, key);
-    free(key);
+    release_key(key, stack_key);
     
     if (value == NULL) {
         napi_value null_val;
@@ -342,10 +453,11 @@ static napi_value ZoryaIniGetDefault(napi_env env, napi_callback_info info) {
  * @brief Get integer value by key
  * 
  * JavaScript: const port = ini.getInt(ctx, 'server.port');
+ *             const v = ini.getInt(ctx, 'server.port', fallback);
  */
 static napi_value ZoryaIniGetInt(napi_env env, napi_callback_info info) {
-    size_t argc = 2;
-    napi_value args[2];
+    size_t argc = 3;
+    napi_value args[3];
     NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
     
     if (argc < 2) {
@@ -357,19 +469,22 @@ static napi_value ZoryaIniGetInt(napi_env env, napi_callback_info info) {
     ZoryaIni *ini;
     NAPI_CALL(env, napi_get_value_external(env, args[0], (void**)&ini));
     
+    /* Optional default (returned when missing or not convertible) */
+    int64_t def = 0;
+    if (has_arg(env, argc, args, 2)) {
+        NAPI_CALL(env, napi_get_value_int64(env, args[2], &def));
+    }
+    
     /* Get key */
-    size_t key_len;
-    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], NULL, 0, &key_len));
-    char *key = malloc(key_len + 1);
+    char stack_key[INI_KEY_STACK_SIZE];
+    char *key = read_key(env, args[1], stack_key, sizeof(stack_key));
     if (key == NULL) {
-        napi_throw_error(env, NULL, "Memory allocation failed");
         return NULL;
     }
-    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], key, key_len + 1, &key_len));
     
-    /* Get value */
-    int64_t value = zorya_ini_get_int(ini, key);
-    free(key);
+    /* Get value (typed value is cached in the entry after first access) */
+    int64_t value = zorya_ini_get_int_default(ini, key, def);
+    release_key(key, stack_key);
     
     napi_value result;
     NAPI_CALL(env, napi_create_int64(env, value, &result));
@@ -384,10 +499,11 @@ static napi_value ZoryaIniGetInt(napi_env env, napi_callback_info info) {
  * @brief Get float value by key
  * 
  * JavaScript: const rate = ini.getFloat(ctx, 'app.rate');
+ *             const v = ini.getFloat(ctx, 'app.rate', fallback);
  */
 static napi_value ZoryaIniGetFloat(napi_env env, napi_callback_info info) {
-    size_t argc = 2;
-    napi_value args[2];
+    size_t argc = 3;
+    napi_value args[3];
     NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
     
     if (argc < 2) {
@@ -399,19 +515,22 @@ static napi_value ZoryaIniGetFloat(napi_env env, napi_callback_info info) {
     ZoryaIni *ini;
     NAPI_CALL(env, napi_get_value_external(env, args[0], (void**)&ini));
     
+    /* Optional default (returned when missing or not convertible) */
+    double def = 0.0;
+    if (has_arg(env, argc, args, 2)) {
+        NAPI_CALL(env, napi_get_value_double(env, args[2], &def));
+    }
+    
     /* Get key */
-    size_t key_len;
-    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], NULL, 0, &key_len));
-    char *key = malloc(key_len + 1);
+    char stack_key[INI_KEY_STACK_SIZE];
+    char *key = read_key(env, args[1], stack_key, sizeof(stack_key));
     if (key == NULL) {
-        napi_throw_error(env, NULL, "Memory allocation failed");
         return NULL;
     }
-    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], key, key_len + 1, &key_len));
     
-    /* Get value */
-    double value = zorya_ini_get_float(ini, key);
-    free(key);
+    /* Get value (typed value is cached in the entry after first access) */
+    double value = zorya_ini_get_float_default(ini, key, def);
+    release_key(key, stack_key);
     
     napi_value result;
     NAPI_CALL(env, napi_create_double(env, value, &result));
@@ -426,10 +545,11 @@ static napi_value ZoryaIniGetFloat(napi_env env, napi_callback_info info) {
  * @brief Get boolean value by key
  * 
  * JavaScript: const enabled = ini.getBool(ctx, 'app.enabled');
+ *             const v = ini.getBool(ctx, 'app.enabled', fallback);
  */
 static napi_value ZoryaIniGetBool(napi_env env, napi_callback_info info) {
-    size_t argc = 2;
-    napi_value args[2];
+    size_t argc = 3;
+    napi_value args[3];
     NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
     
     if (argc < 2) {
@@ -441,19 +561,22 @@ static napi_value ZoryaIniGetBool(napi_env env, napi_callback_info info) {
     ZoryaIni *ini;
     NAPI_CALL(env, napi_get_value_external(env, args[0], (void**)&ini));
     
+    /* Optional default (returned when missing or not convertible) */
+    bool def = false;
+    if (has_arg(env, argc, args, 2)) {
+        NAPI_CALL(env, napi_get_value_bool(env, args[2], &def));
+    }
+    
     /* Get key */
-    size_t key_len;
-    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], NULL, 0, &key_len));
-    char *key = malloc(key_len + 1);
+    char stack_key[INI_KEY_STACK_SIZE];
+    char *key = read_key(env, args[1], stack_key, sizeof(stack_key));
     if (key == NULL) {
-        napi_throw_error(env, NULL, "Memory allocation failed");
         return NULL;
     }
-    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], key, key_len + 1, &key_len));
     
-    /* Get value */
-    bool value = zorya_ini_get_bool(ini, key);
-    free(key);
+    /* Get value (typed value is cached in the entry after first access) */
+    bool value = zorya_ini_get_bool_default(ini, key, def);
+    release_key(key, stack_key);
     
     napi_value result;
     NAPI_CALL(env, napi_get_boolean(env, value, &result));
@@ -484,19 +607,16 @@ static napi_value ZoryaIniGetArray(napi_env env, napi_callback_info info) {
     NAPI_CALL(env, napi_get_value_external(env, args[0], (void**)&ini));
     
     /* Get key */
-    size_t key_len;
-    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], NULL, 0, &key_len));
-    char *key = malloc(key_len + 1);
+    char stack_key[INI_KEY_STACK_SIZE];
+    char *key = read_key(env, args[1], stack_key, sizeof(stack_key));
     if (key == NULL) {
-        napi_throw_error(env, NULL, "Memory allocation failed");
         return NULL;
     }
-    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], key, key_len + 1, &key_len));
     
     /* Get array */
     size_t count = 0;
     const char **items = zorya_ini_get_array(ini, key, &count);
-    free(key);
+    release_key(key, stack_key);
     
     if (items == NULL) {
         napi_value empty_array;
@@ -541,18 +661,15 @@ static napi_value ZoryaIniHas(napi_env env, napi_callback_info info) {
     NAPI_CALL(env, napi_get_value_external(env, args[0], (void**)&ini));
     
     /* Get key */
-    size_t key_len;
-    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], NULL, 0, &key_len));
-    char *key = malloc(key_len + 1);
+    char stack_key[INI_KEY_STACK_SIZE];
+    char *key = read_key(env, args[1], stack_key, sizeof(stack_key));
     if (key == NULL) {
-        napi_throw_error(env, NULL, "Memory allocation failed");
         return NULL;
     }
-    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], key, key_len + 1, &key_len));
     
     /* Check existence */
     bool exists = zorya_ini_has(ini, key);
-    free(key);
+    release_key(key, stack_key);
     
     napi_value result;
     NAPI_CALL(env, napi_get_boolean(env, exists, &result));
@@ -734,6 +851,58 @@ static napi_value ZoryaIniSave(napi_env env, napi_callback_info info) {
     return NULL;
 }
 
+/* ============================================================
+ * ZORYA_INI_COMPILE - Compile to .dd file
+ * ============================================================ */
+
+/**
+ * @brief Compile INI context to a binary blob
+ * 
+ * JavaScript: ini.compile(ctx, '/path/to/config.dd');
+ */
+static napi_value ZoryaIniCompile(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+    
+    if (argc < 2) {
+        napi_throw_type_error(env, NULL, "Expected 2 arguments: context, filepath");
+        return NULL;
+    }
+    
+    /* Get context */
+    ZoryaIni *ini;
+    NAPI_CALL(env, napi_get_value_external(env, args[0], (void**)&ini));
+    
+    /* Get filepath */
+    size_t path_len;
+    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], NULL, 0, &path_len));
+    
+    char *filepath = malloc(path_len + 1);
+    if (filepath == NULL) {
+        napi_throw_error(env, NULL, "Memory allocation failed");
+        return NULL;
+    }
+    
+    NAPI_CALL(env, napi_get_value_string_utf8(env, args[1], filepath, path_len + 1, &path_len));
+    
+    /* Compile */
+    zorya_ini_error_t err = zorya_ini_compile(ini, filepath);
+    free(filepath);
+    
+    if (err != ZORYA_INI_OK) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "INI compile error: %s",
+                 zorya_ini_strerror(err));
+        napi_throw_error(env, NULL, error_msg);
+        return NULL;
+    }
+    
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, true, &result));
+    return result;
+}
+
 /* ============================================================
  * ZORYA_INI_STATS - Get statistics
  * ============================================================ */
@@ -797,6 +966,7 @@ static napi_value Init(napi_env env, napi_value exports) {
         /* Loading */
         DECLARE_NAPI_METHOD("load", ZoryaIniLoad),
         DECLARE_NAPI_METHOD("loadString", ZoryaIniLoadString),
+        DECLARE_NAPI_METHOD("loadBinary", ZoryaIniLoadBinary),
         
         /* Getters */
         DECLARE_NAPI_METHOD("get", ZoryaIniGet),
@@ -815,6 +985,7 @@ static napi_value Init(napi_env env, napi_value exports) {
         /* Serialization */
         DECLARE_NAPI_METHOD("toString", ZoryaIniToString),
         DECLARE_NAPI_METHOD("save", ZoryaIniSave),
+        DECLARE_NAPI_METHOD("compile", ZoryaIniCompile),
         
         /* Metadata */
         DECLARE_NAPI_METHOD("sections", ZoryaIniSections),
@@ -13,6 +13,12 @@
  *   Implementation of the ZORYA-INI parser with DAGGER-backed
  *   hash table for O(1) key lookup.
  *
+ *   Parsed documents can be compiled to a single ".dd" blob that
+ *   holds resolved values, pre-parsed typed values and a prebuilt
+ *   hash index. zorya_ini_load_binary() maps the blob read-only and
+ *   answers lookups from it in place, so loading a compiled config
+ *   costs one mmap() instead of a full parse.
+ *
  * DEPENDENCIES:
  *   - dagger.h (hash table)
  *   - nxh.h (hash function)
@@ -26,8 +32,13 @@
 #include <strings.h>  /* For strcasecmp on some systems */
 #include <ctype.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "zorya_ini.h"
 #include "dagger.h"
+#include "nxh.h"
 #include "weave.h"  /* Tablet for string interning */
 
 /* ============================================================
@@ -40,6 +51,18 @@
 #define INI_MAX_INCLUDE_DEPTH   16
 #define INI_INITIAL_CAPACITY    64
 
+#define INI_BLOB_MAGIC          "ZORYADD"   /* 8 bytes including NUL */
+#define INI_BLOB_VERSION        1
+#define INI_BLOB_ENDIAN         0x01020304u
+#define INI_BLOB_ALIGN          8
+
+/* Typed value flags (IniEntry.typed, IniBlobEntry.flags) */
+#define INI_VALUE_HAS_INT       0x01  /* Integer interpretation is valid */
+#define INI_VALUE_HAS_FLOAT     0x02  /* Float interpretation is valid */
+#define INI_VALUE_BOOL          0x04  /* Boolean interpretation is true */
+#define INI_VALUE_ARRAY         0x08  /* Value is a parsed array */
+#define INI_VALUE_CACHED        0x80  /* IniEntry only: flags are computed */
+
 /* ============================================================
  * INTERNAL STRUCTURES
  * ============================================================ */
@@ -52,6 +75,10 @@
  * 
  * Note: resolved_value is only allocated when interpolation changes
  * the value. Otherwise it's NULL and we use raw_value.
+ *
+ * Integer, float and boolean interpretations are computed on first
+ * typed access and cached in as_int/as_float/typed, so hot getters
+ * never re-run strtoll/strtod.
  */
 typedef struct {
     const Weave *section;       /**< Section name (interned, NOT owned) */
@@ -61,8 +88,65 @@ typedef struct {
     ZoryaIniValue parsed;       /**< Parsed value */
     zorya_ini_type_t hint;      /**< Type hint from key:type */
     int line;                   /**< Source line number */
+    int64_t as_int;             /**< Cached integer interpretation */
+    double as_float;            /**< Cached float interpretation */
+    uint8_t typed;              /**< INI_VALUE_* flags (0 = not cached yet) */
 } IniEntry;
 
+/**
+ * @brief Compiled blob header
+ *
+ * Layout of a .dd file (all sections 8-byte aligned, host byte order):
+ *
+ *   [header][buckets][entries][items][sections][string pool]
+ *
+ * Buckets form an open-addressed table (linear probing, load <= 0.5)
+ * keyed by nxh64 of the full key. Every string is stored once in the
+ * NUL-terminated pool and referenced by offset.
+ */
+typedef struct {
+    char magic[8];              /**< INI_BLOB_MAGIC */
+    uint32_t version;           /**< INI_BLOB_VERSION */
+    uint32_t endian;            /**< INI_BLOB_ENDIAN as written by the host */
+    uint32_t entry_count;       /**< Number of IniBlobEntry records */
+    uint32_t section_count;     /**< Number of section name offsets */
+    uint32_t bucket_mask;       /**< Bucket count - 1 (power of two) */
+    uint32_t item_count;        /**< Number of array item offsets */
+    uint64_t file_size;         /**< Total blob size */
+    uint64_t buckets_off;       /**< IniBlobBucket[bucket_mask + 1] */
+    uint64_t entries_off;       /**< IniBlobEntry[entry_count] */
+    uint64_t items_off;         /**< uint32_t[item_count] */
+    uint64_t sections_off;      /**< uint32_t[section_count] */
+    uint64_t strings_off;       /**< String pool */
+    uint64_t strings_size;      /**< String pool size (ends with NUL) */
+} IniBlobHeader;
+
+/**
+ * @brief Hash index slot
+ */
+typedef struct {
+    uint32_t tag;               /**< High 32 bits of the key hash */
+    uint32_t slot;              /**< Entry index + 1 (0 = empty) */
+} IniBlobBucket;
+
+/**
+ * @brief Compiled entry (values already resolved and parsed)
+ */
+typedef struct {
+    uint32_t key_off;           /**< Full "section.key" */
+    uint32_t key_len;           /**< Full key length */
+    uint32_t section_off;       /**< Section name ("" for root) */
+    uint32_t name_off;          /**< Key name without section */
+    uint32_t value_off;         /**< Value after interpolation */
+    uint32_t item_first;        /**< First array item slot */
+    uint32_t item_count;        /**< Number of array items */
+    uint8_t type;               /**< zorya_ini_type_t of parsed value */
+    uint8_t flags;              /**< INI_BLOB_* flags */
+    uint16_t reserved;
+    int64_t i;                  /**< Integer interpretation */
+    double f;                   /**< Float interpretation */
+} IniBlobEntry;
+
 /**
  * @brief Internal INI context
  */
@@ -83,8 +167,14 @@ struct ZoryaIni {
     char *error_message;        /**< Owned error message */
     char *error_file;           /**< Owned error file path */
     
+    /* Compiled blob (zorya_ini_load_binary) */
+    const IniBlobHeader *blob;  /**< Read-only mapping of a .dd file */
+    size_t blob_size;           /**< Mapping length */
+    const char **blob_items;    /**< Array item pointers, filled on first use */
+    size_t blob_keys;           /**< Blob entries not shadowed by parsed keys */
+    
     /* Statistics */
-    size_t key_count;
+    size_t key_count;           /**< Parsed and set keys */
     size_t include_count;
 };
 
@@ -103,6 +193,12 @@ static char** parse_array(const char *value, size_t *count);
 static zorya_ini_error_t resolve_all_interpolations(ZoryaIni *ini);
 static char* resolve_string(ZoryaIni *ini, const char *str, 
                             const char *current_section, int depth);
+static const IniBlobEntry* blob_find(const ZoryaIni *ini, const char *key,
+                                     size_t key_len);
+static const char* blob_str(const ZoryaIni *ini, uint32_t off);
+static const char** blob_array(const ZoryaIni *ini, const IniBlobEntry *e,
+                               size_t *count);
+static void blob_unmap(ZoryaIni *ini);
 
 /* ============================================================
  * HELPER FUNCTIONS
@@ -521,6 +617,7 @@ static int resolve_entry_callback(
     /* Store resolved value (raw_value remains interned, unchanged) */
     free(entry->resolved_value);  /* In case called multiple times */
     entry->resolved_value = resolved;
+    entry->typed = 0;             /* Drop cached typed values */
     
     /* Re-parse based on type hint */
     if (entry->parsed.is_array || strchr(resolved, '|') != NULL) {
@@ -665,6 +762,9 @@ void zorya_ini_free(ZoryaIni *ini) {
         free(ini->include_stack);
     }
     
+    /* Release compiled blob mapping */
+    blob_unmap(ini);
+    
     /* Free error strings */
     free(ini->error_message);
     free(ini->error_file);
@@ -791,16 +891,9 @@ zorya_ini_error_t zorya_ini_load_buffer(
  * ============================================================ */
 
 /**
- * @brief Add section to list if not exists
+ * @brief Append section name without a duplicate check
  */
-static void add_section(ZoryaIni *ini, const char *section) {
-    /* Check if already exists */
-    for (size_t i = 0; i < ini->section_count; i++) {
-        if (strcmp(ini->sections[i], section) == 0) {
-            return;
-        }
-    }
-    
+static void append_section(ZoryaIni *ini, const char *section) {
     /* Grow array if needed */
     if (ini->section_count >= ini->section_capacity) {
         size_t new_cap = ini->section_capacity * 2;
@@ -813,6 +906,20 @@ static void add_section(ZoryaIni *ini, const char *section) {
     ini->sections[ini->section_count++] = str_dup(section);
 }
 
+/**
+ * @brief Add section to list if not exists
+ */
+static void add_section(ZoryaIni *ini, const char *section) {
+    /* Check if already exists */
+    for (size_t i = 0; i < ini->section_count; i++) {
+        if (strcmp(ini->sections[i], section) == 0) {
+            return;
+        }
+    }
+    
+    append_section(ini, section);
+}
+
 /**
  * @brief Parse type hint from "key:type"
  */
@@ -990,9 +1097,15 @@ static zorya_ini_error_t add_entry(
         }
     }
     
+    /* A first parsed copy of a compiled key takes over its count */
+    size_t full_len = strlen(full_key);
+    bool takes_over = ini->blob_keys > 0 &&
+                      !dagger_contains(ini->entries, full_key, (uint32_t)full_len) &&
+                      blob_find(ini, full_key, full_len) != NULL;
+    
     /* Insert into hash table */
     dagger_result_t r = dagger_set(ini->entries, full_key, 
-                                   (uint32_t)strlen(full_key), entry, 1);
+                                   (uint32_t)full_len, entry, 1);
     
     if (r != DAGGER_OK) {
         /* Don't call entry_destroy - it would try to free Tablet strings */
@@ -1002,6 +1115,7 @@ static zorya_ini_error_t add_entry(
     }
     
     ini->key_count++;
+    if (takes_over) ini->blob_keys--;
     return ZORYA_INI_OK;
 }
 
@@ -1249,14 +1363,65 @@ static zorya_ini_error_t parse_buffer(
  * GETTERS
  * ============================================================ */
 
+/**
+ * @brief Get cached typed interpretations of an entry
+ *
+ * Parses the value once and caches the result in the entry. A type
+ * hint wins over parsing the string, matching add_entry().
+ *
+ * @param entry Entry to interpret
+ * @return INI_VALUE_* flags
+ */
+static uint8_t entry_typed(IniEntry *entry) {
+    if (entry->typed & INI_VALUE_CACHED) return entry->typed;
+    
+    const char *str_val = entry->resolved_value ? 
+                          entry->resolved_value : 
+                          weave_cstr(entry->raw_value);
+    uint8_t flags = INI_VALUE_CACHED;
+    char *endptr;
+    
+    if (entry->parsed.is_array) {
+        flags |= INI_VALUE_ARRAY;
+    }
+    
+    if (entry->parsed.type == ZORYA_INI_TYPE_INT) {
+        entry->as_int = entry->parsed.v.i;
+        flags |= INI_VALUE_HAS_INT;
+    } else {
+        entry->as_int = (int64_t)strtoll(str_val, &endptr, 10);
+        if (endptr != str_val) flags |= INI_VALUE_HAS_INT;
+    }
+    
+    if (entry->parsed.type == ZORYA_INI_TYPE_FLOAT) {
+        entry->as_float = entry->parsed.v.f;
+        flags |= INI_VALUE_HAS_FLOAT;
+    } else {
+        entry->as_float = strtod(str_val, &endptr);
+        if (endptr != str_val) flags |= INI_VALUE_HAS_FLOAT;
+    }
+    
+    bool b = entry->parsed.type == ZORYA_INI_TYPE_BOOL ?
+             entry->parsed.v.b : parse_bool_value(str_val);
+    if (b) flags |= INI_VALUE_BOOL;
+    
+    entry->typed = flags;
+    return flags;
+}
+
 const char* zorya_ini_get(const ZoryaIni *ini, const char *key) {
     if (ini == NULL || key == NULL) return NULL;
     
+    size_t key_len = strlen(key);
     void *value = NULL;
     dagger_result_t r = dagger_get(ini->entries, key, 
-                                   (uint32_t)strlen(key), &value);
+                                   (uint32_t)key_len, &value);
     
-    if (r != DAGGER_OK || value == NULL) return NULL;
+    if (r != DAGGER_OK || value == NULL) {
+        /* Fall back to the compiled blob (parsed entries shadow it) */
+        const IniBlobEntry *be = blob_find(ini, key, key_len);
+        return be != NULL ? blob_str(ini, be->value_off) : NULL;
+    }
     
     IniEntry *entry = (IniEntry*)value;
     /* Return resolved value if available, otherwise raw value */
@@ -1286,27 +1451,20 @@ int64_t zorya_ini_get_int_default(
 ) {
     if (ini == NULL || key == NULL) return def;
     
+    size_t key_len = strlen(key);
     void *value = NULL;
     dagger_result_t r = dagger_get(ini->entries, key,
-                                   (uint32_t)strlen(key), &value);
+                                   (uint32_t)key_len, &value);
     
-    if (r != DAGGER_OK || value == NULL) return def;
-    
-    IniEntry *entry = (IniEntry*)value;
-    
-    if (entry->parsed.type == ZORYA_INI_TYPE_INT) {
-        return entry->parsed.v.i;
+    if (r != DAGGER_OK || value == NULL) {
+        const IniBlobEntry *be = blob_find(ini, key, key_len);
+        if (be == NULL) return def;
+        return (be->flags & INI_VALUE_HAS_INT) ? be->i : def;
     }
     
-    /* Try to parse as int - use resolved_value if available */
-    const char *str_val = entry->resolved_value ? 
-                          entry->resolved_value : 
-                          weave_cstr(entry->raw_value);
-    char *endptr;
-    long long val = strtoll(str_val, &endptr, 10);
-    if (endptr == str_val) return def;
+    IniEntry *entry = (IniEntry*)value;
     
-    return (int64_t)val;
+    return (entry_typed(entry) & INI_VALUE_HAS_INT) ? entry->as_int : def;
 }
 
 double zorya_ini_get_float(const ZoryaIni *ini, const char *key) {
@@ -1320,27 +1478,20 @@ double zorya_ini_get_float_default(
 ) {
     if (ini == NULL || key == NULL) return def;
     
+    size_t key_len = strlen(key);
     void *value = NULL;
     dagger_result_t r = dagger_get(ini->entries, key,
-                                   (uint32_t)strlen(key), &value);
+                                   (uint32_t)key_len, &value);
     
-    if (r != DAGGER_OK || value == NULL) return def;
-    
-    IniEntry *entry = (IniEntry*)value;
-    
-    if (entry->parsed.type == ZORYA_INI_TYPE_FLOAT) {
-        return entry->parsed.v.f;
+    if (r != DAGGER_OK || value == NULL) {
+        const IniBlobEntry *be = blob_find(ini, key, key_len);
+        if (be == NULL) return def;
+        return (be->flags & INI_VALUE_HAS_FLOAT) ? be->f : def;
     }
     
-    /* Try to parse as float - use resolved_value if available */
-    const char *str_val = entry->resolved_value ? 
-                          entry->resolved_value : 
-                          weave_cstr(entry->raw_value);
-    char *endptr;
-    double val = strtod(str_val, &endptr);
-    if (endptr == str_val) return def;
+    IniEntry *entry = (IniEntry*)value;
     
-    return val;
+    return (entry_typed(entry) & INI_VALUE_HAS_FLOAT) ? entry->as_float : def;
 }
 
 bool zorya_ini_get_bool(const ZoryaIni *ini, const char *key) {
@@ -1354,23 +1505,20 @@ bool zorya_ini_get_bool_default(
 ) {
     if (ini == NULL || key == NULL) return def;
     
+    size_t key_len = strlen(key);
     void *value = NULL;
     dagger_result_t r = dagger_get(ini->entries, key,
-                                   (uint32_t)strlen(key), &value);
+                                   (uint32_t)key_len, &value);
     
-    if (r != DAGGER_OK || value == NULL) return def;
+    if (r != DAGGER_OK || value == NULL) {
+        const IniBlobEntry *be = blob_find(ini, key, key_len);
+        if (be == NULL) return def;
+        return (be->flags & INI_VALUE_BOOL) != 0;
+    }
     
     IniEntry *entry = (IniEntry*)value;
     
-    if (entry->parsed.type == ZORYA_INI_TYPE_BOOL) {
-        return entry->parsed.v.b;
-    }
-    
-    /* Use resolved_value if available */
-    const char *str_val = entry->resolved_value ? 
-                          entry->resolved_value : 
-                          weave_cstr(entry->raw_value);
-    return parse_bool_value(str_val);
+    return (entry_typed(entry) & INI_VALUE_BOOL) != 0;
 }
 
 const char** zorya_ini_get_array(
@@ -1381,11 +1529,15 @@ const char** zorya_ini_get_array(
     if (count != NULL) *count = 0;
     if (ini == NULL || key == NULL) return NULL;
     
+    size_t key_len = strlen(key);
     void *value = NULL;
     dagger_result_t r = dagger_get(ini->entries, key,
-                                   (uint32_t)strlen(key), &value);
+                                   (uint32_t)key_len, &value);
     
-    if (r != DAGGER_OK || value == NULL) return NULL;
+    if (r != DAGGER_OK || value == NULL) {
+        const IniBlobEntry *be = blob_find(ini, key, key_len);
+        return be != NULL ? blob_array(ini, be, count) : NULL;
+    }
     
     IniEntry *entry = (IniEntry*)value;
     
@@ -1411,11 +1563,13 @@ size_t zorya_ini_get_array_len(const ZoryaIni *ini, const char *key) {
 bool zorya_ini_has(const ZoryaIni *ini, const char *key) {
     if (ini == NULL || key == NULL) return false;
     
+    size_t key_len = strlen(key);
     void *value = NULL;
     dagger_result_t r = dagger_get(ini->entries, key,
-                                   (uint32_t)strlen(key), &value);
+                                   (uint32_t)key_len, &value);
     
-    return r == DAGGER_OK && value != NULL;
+    if (r == DAGGER_OK && value != NULL) return true;
+    return blob_find(ini, key, key_len) != NULL;
 }
 
 bool zorya_ini_has_section(const ZoryaIni *ini, const char *section) {
@@ -1555,6 +1709,7 @@ typedef struct {
     void *userdata;
     const char *filter_section;
     int count;
+    int stopped;
 } IterContext;
 
 /**
@@ -1588,12 +1743,47 @@ static int iter_callback(
     
     ctx->count++;
     
-    return ctx->callback(
+    ctx->stopped = ctx->callback(
         section_str[0] ? section_str : NULL,
         key_str,
         value_str,
         ctx->userdata
     );
+    return ctx->stopped;
+}
+
+/**
+ * @brief Visit compiled blob entries not shadowed by parsed entries
+ */
+static void iter_blob(const ZoryaIni *ini, IterContext *ctx) {
+    const IniBlobHeader *h = ini->blob;
+    if (h == NULL || ctx->stopped) return;
+    
+    const IniBlobEntry *entries = (const IniBlobEntry*)
+        ((const char*)h + h->entries_off);
+    
+    for (uint32_t i = 0; i < h->entry_count; i++) {
+        const IniBlobEntry *e = &entries[i];
+        const char *section_str = blob_str(ini, e->section_off);
+        
+        if (ctx->filter_section != NULL &&
+            strcmp(section_str, ctx->filter_section) != 0) {
+            continue;
+        }
+        if (dagger_contains(ini->entries, blob_str(ini, e->key_off),
+                            e->key_len)) {
+            continue;
+        }
+        
+        ctx->count++;
+        ctx->stopped = ctx->callback(
+            section_str[0] ? section_str : NULL,
+            blob_str(ini, e->name_off),
+            blob_str(ini, e->value_off),
+            ctx->userdata
+        );
+        if (ctx->stopped) return;
+    }
 }
 
 int zorya_ini_foreach(
@@ -1607,10 +1797,12 @@ int zorya_ini_foreach(
         .callback = callback,
         .userdata = userdata,
         .filter_section = NULL,
-        .count = 0
+        .count = 0,
+        .stopped = 0
     };
     
     dagger_foreach(ini->entries, iter_callback, &ctx);
+    iter_blob(ini, &ctx);
     
     return ctx.count;
 }
@@ -1627,10 +1819,12 @@ int zorya_ini_foreach_section(
         .callback = callback,
         .userdata = userdata,
         .filter_section = section,
-        .count = 0
+        .count = 0,
+        .stopped = 0
     };
     
     dagger_foreach(ini->entries, iter_callback, &ctx);
+    iter_blob(ini, &ctx);
     
     return ctx.count;
 }
@@ -1645,6 +1839,639 @@ const char** zorya_ini_sections(const ZoryaIni *ini, size_t *count) {
     return (const char**)ini->sections;
 }
 
+/* ============================================================
+ * BINARY COMPILATION
+ * ============================================================ */
+
+/**
+ * @brief Round up to blob section alignment
+ */
+static uint64_t blob_align(uint64_t n) {
+    return (n + (INI_BLOB_ALIGN - 1)) & ~(uint64_t)(INI_BLOB_ALIGN - 1);
+}
+
+/**
+ * @brief Get pool string by offset ("" if out of range)
+ */
+static const char* blob_str(const ZoryaIni *ini, uint32_t off) {
+    const IniBlobHeader *h = ini->blob;
+    if (off >= h->strings_size) return "";
+    return (const char*)h + h->strings_off + off;
+}
+
+/**
+ * @brief Look up a full key in the mapped hash index
+ */
+static const IniBlobEntry* blob_find(
+    const ZoryaIni *ini,
+    const char *key,
+    size_t key_len
+) {
+    const IniBlobHeader *h = ini->blob;
+    if (h == NULL || h->entry_count == 0) return NULL;
+    
+    const char *base = (const char*)h;
+    const IniBlobBucket *buckets = (const IniBlobBucket*)(base + h->buckets_off);
+    const IniBlobEntry *entries = (const IniBlobEntry*)(base + h->entries_off);
+    const char *strings = base + h->strings_off;
+    
+    uint64_t hash = nxh64(key, key_len, NXH_SEED_DEFAULT);
+    uint32_t tag = (uint32_t)(hash >> 32);
+    uint32_t mask = h->bucket_mask;
+    uint32_t idx = (uint32_t)hash & mask;
+    
+    for (uint32_t probes = 0; probes <= mask; probes++) {
+        const IniBlobBucket *b = &buckets[idx];
+        if (b->slot == 0) return NULL;
+        
+        if (b->tag == tag && b->slot <= h->entry_count) {
+            const IniBlobEntry *e = &entries[b->slot - 1];
+            if (e->key_len == key_len &&
+                e->key_off < h->strings_size &&
+                h->strings_size - e->key_off > key_len &&
+                memcmp(strings + e->key_off, key, key_len) == 0) {
+                return e;
+            }
+        }
+        idx = (idx + 1) & mask;
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief Get array items of a compiled entry
+ *
+ * Item pointers are materialized into blob_items on first access so
+ * the caller gets the same const char** shape as parsed entries.
+ */
+static const char** blob_array(
+    const ZoryaIni *ini,
+    const IniBlobEntry *e,
+    size_t *count
+) {
+    if (count != NULL) *count = 0;
+    
+    const IniBlobHeader *h = ini->blob;
+    if (!(e->flags & INI_VALUE_ARRAY)) return NULL;
+    if ((uint64_t)e->item_first + e->item_count > h->item_count) return NULL;
+    
+    const uint32_t *offsets = (const uint32_t*)
+        ((const char*)h + h->items_off);
+    const char **slots = ini->blob_items + e->item_first;
+    
+    if (e->item_count > 0 && slots[0] == NULL) {
+        for (uint32_t i = 0; i < e->item_count; i++) {
+            slots[i] = blob_str(ini, offsets[e->item_first + i]);
+        }
+    }
+    
+    if (count != NULL) *count = e->item_count;
+    return slots;
+}
+
+/**
+ * @brief Release the mapped blob, if any
+ */
+static void blob_unmap(ZoryaIni *ini) {
+    if (ini->blob == NULL) return;
+    
+    munmap((void*)ini->blob, ini->blob_size);
+    free(ini->blob_items);
+    
+    ini->blob = NULL;
+    ini->blob_size = 0;
+    ini->blob_items = NULL;
+    ini->blob_keys = 0;
+}
+
+/**
+ * @brief Check that a blob region lies inside the mapping
+ */
+static bool blob_region_ok(uint64_t size, uint64_t off, uint64_t bytes) {
+    return off % INI_BLOB_ALIGN == 0 && off <= size && bytes <= size - off;
+}
+
+/**
+ * @brief Validate header and section bounds of a mapped blob
+ *
+ * Per-entry string offsets are bounds-checked on access instead,
+ * which keeps loading O(1) in the number of keys.
+ */
+static bool blob_validate(const void *map, size_t size) {
+    if (size < sizeof(IniBlobHeader)) return false;
+    
+    const IniBlobHeader *h = (const IniBlobHeader*)map;
+    if (memcmp(h->magic, INI_BLOB_MAGIC, sizeof(h->magic)) != 0) return false;
+    if (h->version != INI_BLOB_VERSION) return false;
+    if (h->endian != INI_BLOB_ENDIAN) return false;
+    if (h->file_size != size) return false;
+    if ((h->bucket_mask & (h->bucket_mask + 1u)) != 0) return false;
+    
+    uint64_t bucket_count = (uint64_t)h->bucket_mask + 1;
+    if (h->entry_count >= bucket_count) return false;
+    
+    if (!blob_region_ok(size, h->buckets_off,
+                        bucket_count * sizeof(IniBlobBucket)) ||
+        !blob_region_ok(size, h->entries_off,
+                        (uint64_t)h->entry_count * sizeof(IniBlobEntry)) ||
+        !blob_region_ok(size, h->items_off,
+                        (uint64_t)h->item_count * sizeof(uint32_t)) ||
+        !blob_region_ok(size, h->sections_off,
+                        (uint64_t)h->section_count * sizeof(uint32_t)) ||
+        !blob_region_ok(size, h->strings_off, h->strings_size)) {
+        return false;
+    }
+    
+    /* Pool must be NUL-terminated so any in-range offset is a C string */
+    if (h->strings_size == 0) return false;
+    if (((const char*)map)[h->strings_off + h->strings_size - 1] != '\0') {
+        return false;
+    }
+    
+    return true;
+}
+
+zorya_ini_error_t zorya_ini_load_binary(ZoryaIni *ini, const char *filepath) {
+    if (ini == NULL || filepath == NULL) {
+        return ZORYA_INI_ERROR_NULLPTR;
+    }
+    
+    int fd = open(filepath, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return ZORYA_INI_ERROR_IO;
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return st.st_size == 0 ? ZORYA_INI_ERROR_SYNTAX : ZORYA_INI_ERROR_IO;
+    }
+    
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return ZORYA_INI_ERROR_IO;
+    }
+    
+    if (!blob_validate(map, size)) {
+        munmap(map, size);
+        return ZORYA_INI_ERROR_SYNTAX;
+    }
+    
+    const IniBlobHeader *h = (const IniBlobHeader*)map;
+    const char **items = calloc(h->item_count > 0 ? h->item_count : 1,
+                                sizeof(char*));
+    if (items == NULL) {
+        munmap(map, size);
+        return ZORYA_INI_ERROR_NOMEM;
+    }
+    
+    /* Replace any previously loaded blob */
+    blob_unmap(ini);
+    ini->blob = h;
+    ini->blob_size = size;
+    ini->blob_items = items;
+    
+    /* Keys already parsed or set shadow their compiled copies */
+    const IniBlobEntry *entries = (const IniBlobEntry*)
+        ((const char*)map + h->entries_off);
+    ini->blob_keys = 0;
+    for (uint32_t i = 0; i < h->entry_count; i++) {
+        if (!dagger_contains(ini->entries, blob_str(ini, entries[i].key_off),
+                             entries[i].key_len)) {
+            ini->blob_keys++;
+        }
+    }
+    
+    /* Copy section names so sections() works unchanged. Compiled names
+     * are unique, so a fresh context can skip the duplicate scan. */
+    const uint32_t *sections = (const uint32_t*)
+        ((const char*)map + h->sections_off);
+    bool fresh = ini->section_count == 0;
+    for (uint32_t i = 0; i < h->section_count; i++) {
+        const char *name = blob_str(ini, sections[i]);
+        if (fresh) {
+            append_section(ini, name);
+        } else {
+            add_section(ini, name);
+        }
+    }
+    
+    return ZORYA_INI_OK;
+}
+
+/**
+ * @brief One entry as it will be written to the blob
+ */
+typedef struct {
+    const char *key;            /**< Full key (NOT owned) */
+    uint32_t key_len;
+    const char *section;        /**< Section name (NOT owned) */
+    const char *name;           /**< Key name (NOT owned) */
+    const char *value;          /**< Resolved value (NOT owned) */
+    const char *const *items;   /**< Array items (NOT owned) */
+    size_t item_count;
+    uint8_t type;
+    uint8_t flags;
+    int64_t i;
+    double f;
+} CompileRecord;
+
+/**
+ * @brief Compilation state
+ */
+typedef struct {
+    const ZoryaIni *ini;
+    CompileRecord *recs;
+    size_t count;
+    size_t capacity;
+    zorya_ini_error_t error;
+} CompileContext;
+
+/**
+ * @brief String pool index slot
+ */
+typedef struct {
+    uint64_t hash;              /**< nxh64 of the string */
+    uint32_t off;               /**< Pool offset */
+    uint32_t len;               /**< String length (0 = empty slot) */
+} PoolSlot;
+
+/**
+ * @brief Deduplicating string pool
+ */
+typedef struct {
+    char *data;
+    size_t len;
+    size_t capacity;
+    PoolSlot *slots;            /**< Open-addressed index of pooled strings */
+    size_t slot_mask;
+    size_t slot_used;
+} StringPool;
+
+/**
+ * @brief Reserve the next compile record
+ */
+static CompileRecord* compile_push(CompileContext *ctx) {
+    if (ctx->count == ctx->capacity) {
+        size_t cap = ctx->capacity ? ctx->capacity * 2 : 64;
+        CompileRecord *recs = realloc(ctx->recs, cap * sizeof(*recs));
+        if (recs == NULL) {
+            ctx->error = ZORYA_INI_ERROR_NOMEM;
+            return NULL;
+        }
+        ctx->recs = recs;
+        ctx->capacity = cap;
+    }
+    
+    CompileRecord *rec = &ctx->recs[ctx->count++];
+    memset(rec, 0, sizeof(*rec));
+    return rec;
+}
+
+/**
+ * @brief DAGGER iteration callback collecting parsed entries
+ */
+static int compile_collect_callback(
+    const void *key,
+    uint32_t key_len,
+    void *value,
+    void *userdata
+) {
+    CompileContext *ctx = (CompileContext*)userdata;
+    IniEntry *entry = (IniEntry*)value;
+    
+    CompileRecord *rec = compile_push(ctx);
+    if (rec == NULL) return 1;
+    
+    rec->key = (const char*)key;
+    rec->key_len = key_len;
+    rec->section = weave_cstr(entry->section);
+    rec->name = weave_cstr(entry->key);
+    rec->value = entry->resolved_value ? entry->resolved_value :
+                                         weave_cstr(entry->raw_value);
+    rec->type = (uint8_t)entry->parsed.type;
+    
+    /* Same interpretation the getters apply */
+    rec->flags = entry_typed(entry) & (uint8_t)~INI_VALUE_CACHED;
+    rec->i = entry->as_int;
+    rec->f = entry->as_float;
+    
+    if (entry->parsed.is_array) {
+        rec->items = (const char *const *)entry->parsed.v.arr.items;
+        rec->item_count = entry->parsed.v.arr.items ?
+                          entry->parsed.v.arr.count : 0;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Collect blob entries not shadowed by parsed entries
+ */
+static void compile_collect_blob(CompileContext *ctx) {
+    const ZoryaIni *ini = ctx->ini;
+    const IniBlobHeader *h = ini->blob;
+    if (h == NULL) return;
+    
+    const IniBlobEntry *entries = (const IniBlobEntry*)
+        ((const char*)h + h->entries_off);
+    
+    for (uint32_t i = 0; i < h->entry_count && ctx->error == ZORYA_INI_OK; i++) {
+        const IniBlobEntry *e = &entries[i];
+        const char *key = blob_str(ini, e->key_off);
+        if (dagger_contains(ini->entries, key, e->key_len)) continue;
+        
+        CompileRecord *rec = compile_push(ctx);
+        if (rec == NULL) return;
+        
+        rec->key = key;
+        rec->key_len = e->key_len;
+        rec->section = blob_str(ini, e->section_off);
+        rec->name = blob_str(ini, e->name_off);
+        rec->value = blob_str(ini, e->value_off);
+        rec->items = blob_array(ini, e, &rec->item_count);
+        rec->type = e->type;
+        rec->flags = e->flags;
+        rec->i = e->i;
+        rec->f = e->f;
+    }
+}
+
+/**
+ * @brief Double the pool index
+ */
+static bool pool_grow_index(StringPool *pool) {
+    size_t count = (pool->slot_mask + 1) * 2;
+    PoolSlot *slots = calloc(count, sizeof(PoolSlot));
+    if (slots == NULL) return false;
+    
+    for (size_t i = 0; i <= pool->slot_mask; i++) {
+        const PoolSlot *old = &pool->slots[i];
+        if (old->len == 0) continue;
+        size_t idx = (size_t)old->hash & (count - 1);
+        while (slots[idx].len != 0) idx = (idx + 1) & (count - 1);
+        slots[idx] = *old;
+    }
+    
+    free(pool->slots);
+    pool->slots = slots;
+    pool->slot_mask = count - 1;
+    return true;
+}
+
+/**
+ * @brief Add a string to the pool, reusing an identical one
+ *
+ * @return Pool offset, or UINT32_MAX on failure
+ */
+static uint32_t pool_add(StringPool *pool, const char *str, size_t len) {
+    /* Empty string lives at offset 0 */
+    if (len == 0) return 0;
+    
+    uint64_t hash = nxh64(str, len, NXH_SEED_DEFAULT);
+    size_t idx = (size_t)hash & pool->slot_mask;
+    while (pool->slots[idx].len != 0) {
+        const PoolSlot *slot = &pool->slots[idx];
+        if (slot->hash == hash && slot->len == len &&
+            memcmp(pool->data + slot->off, str, len) == 0) {
+            return slot->off;
+        }
+        idx = (idx + 1) & pool->slot_mask;
+    }
+    
+    if (pool->len + len + 1 >= UINT32_MAX) return UINT32_MAX;
+    
+    if (pool->len + len + 1 > pool->capacity) {
+        size_t cap = pool->capacity ? pool->capacity : 4096;
+        while (cap < pool->len + len + 1) cap *= 2;
+        char *data = realloc(pool->data, cap);
+        if (data == NULL) return UINT32_MAX;
+        pool->data = data;
+        pool->capacity = cap;
+    }
+    
+    uint32_t off = (uint32_t)pool->len;
+    memcpy(pool->data + off, str, len);
+    pool->data[off + len] = '\0';
+    pool->len += len + 1;
+    
+    pool->slots[idx].hash = hash;
+    pool->slots[idx].off = off;
+    pool->slots[idx].len = (uint32_t)len;
+    
+    /* Keep the index at most half full */
+    if (++pool->slot_used * 2 > pool->slot_mask + 1 && !pool_grow_index(pool)) {
+        return UINT32_MAX;
+    }
+    
+    return off;
+}
+
+/**
+ * @brief Add a NUL-terminated string to the pool
+ */
+static uint32_t pool_add_str(StringPool *pool, const char *str) {
+    return pool_add(pool, str, strlen(str));
+}
+
+/**
+ * @brief Write a buffer to a temp file and rename it into place
+ */
+static zorya_ini_error_t write_atomic(
+    const char *filepath,
+    const void *data,
+    size_t len
+) {
+    size_t path_len = strlen(filepath);
+    char *tmp = malloc(path_len + 5);
+    if (tmp == NULL) return ZORYA_INI_ERROR_NOMEM;
+    memcpy(tmp, filepath, path_len);
+    memcpy(tmp + path_len, ".tmp", 5);
+    
+    FILE *fp = fopen(tmp, "wb");
+    if (fp == NULL) {
+        free(tmp);
+        return ZORYA_INI_ERROR_IO;
+    }
+    
+    bool ok = fwrite(data, 1, len, fp) == len;
+    ok = (fclose(fp) == 0) && ok;
+    
+    if (!ok || rename(tmp, filepath) != 0) {
+        remove(tmp);
+        free(tmp);
+        return ZORYA_INI_ERROR_IO;
+    }
+    
+    free(tmp);
+    return ZORYA_INI_OK;
+}
+
+zorya_ini_error_t zorya_ini_compile(const ZoryaIni *ini, const char *filepath) {
+    if (ini == NULL || filepath == NULL) {
+        return ZORYA_INI_ERROR_NULLPTR;
+    }
+    
+    CompileContext ctx = {
+        .ini = ini,
+        .recs = NULL,
+        .count = 0,
+        .capacity = 0,
+        .error = ZORYA_INI_OK
+    };
+    
+    dagger_foreach(ini->entries, compile_collect_callback, &ctx);
+    if (ctx.error == ZORYA_INI_OK) {
+        compile_collect_blob(&ctx);
+    }
+    if (ctx.error != ZORYA_INI_OK) {
+        free(ctx.recs);
+        return ctx.error;
+    }
+    
+    size_t n = ctx.count;
+    size_t item_total = 0;
+    for (size_t i = 0; i < n; i++) {
+        item_total += ctx.recs[i].item_count;
+    }
+    
+    if (n >= UINT32_MAX / 4 || item_total >= UINT32_MAX) {
+        free(ctx.recs);
+        return ZORYA_INI_ERROR_NOMEM;
+    }
+    
+    /* Load factor <= 0.5 keeps probe chains short */
+    uint32_t bucket_count = 8;
+    while (bucket_count < n * 2) bucket_count *= 2;
+    
+    StringPool pool = { NULL, 0, 0, NULL, INI_INITIAL_CAPACITY - 1, 0 };
+    pool.slots = calloc(INI_INITIAL_CAPACITY, sizeof(PoolSlot));
+    IniBlobEntry *entries = calloc(n > 0 ? n : 1, sizeof(IniBlobEntry));
+    uint32_t *items = calloc(item_total > 0 ? item_total : 1, sizeof(uint32_t));
+    uint32_t *sections = calloc(ini->section_count > 0 ? ini->section_count : 1,
+                                sizeof(uint32_t));
+    char *blob = NULL;
+    zorya_ini_error_t err = ZORYA_INI_OK;
+    
+    if (pool.slots == NULL || entries == NULL || items == NULL ||
+        sections == NULL) {
+        err = ZORYA_INI_ERROR_NOMEM;
+        goto cleanup;
+    }
+    
+    /* Empty string lives at offset 0 */
+    pool.data = malloc(4096);
+    if (pool.data == NULL) {
+        err = ZORYA_INI_ERROR_NOMEM;
+        goto cleanup;
+    }
+    pool.data[0] = '\0';
+    pool.len = 1;
+    pool.capacity = 4096;
+    
+    size_t item_next = 0;
+    for (size_t i = 0; i < n; i++) {
+        const CompileRecord *rec = &ctx.recs[i];
+        IniBlobEntry *e = &entries[i];
+        
+        e->key_off = pool_add(&pool, rec->key, rec->key_len);
+        e->key_len = rec->key_len;
+        e->section_off = pool_add_str(&pool, rec->section);
+        e->name_off = pool_add_str(&pool, rec->name);
+        e->value_off = pool_add_str(&pool, rec->value);
+        e->type = rec->type;
+        e->flags = rec->flags;
+        e->i = rec->i;
+        e->f = rec->f;
+        
+        if (e->key_off == UINT32_MAX || e->section_off == UINT32_MAX ||
+            e->name_off == UINT32_MAX || e->value_off == UINT32_MAX) {
+            err = ZORYA_INI_ERROR_NOMEM;
+            goto cleanup;
+        }
+        
+        e->item_first = (uint32_t)item_next;
+        e->item_count = (uint32_t)rec->item_count;
+        for (size_t j = 0; j < rec->item_count; j++) {
+            uint32_t off = pool_add_str(&pool, rec->items[j]);
+            if (off == UINT32_MAX) {
+                err = ZORYA_INI_ERROR_NOMEM;
+                goto cleanup;
+            }
+            items[item_next++] = off;
+        }
+    }
+    
+    for (size_t i = 0; i < ini->section_count; i++) {
+        sections[i] = pool_add_str(&pool, ini->sections[i]);
+        if (sections[i] == UINT32_MAX) {
+            err = ZORYA_INI_ERROR_NOMEM;
+            goto cleanup;
+        }
+    }
+    
+    /* Lay out the blob */
+    IniBlobHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, INI_BLOB_MAGIC, sizeof(h.magic));
+    h.version = INI_BLOB_VERSION;
+    h.endian = INI_BLOB_ENDIAN;
+    h.entry_count = (uint32_t)n;
+    h.section_count = (uint32_t)ini->section_count;
+    h.bucket_mask = bucket_count - 1;
+    h.item_count = (uint32_t)item_total;
+    h.buckets_off = blob_align(sizeof(h));
+    h.entries_off = blob_align(h.buckets_off +
+                               (uint64_t)bucket_count * sizeof(IniBlobBucket));
+    h.items_off = blob_align(h.entries_off + n * sizeof(IniBlobEntry));
+    h.sections_off = blob_align(h.items_off + item_total * sizeof(uint32_t));
+    h.strings_off = blob_align(h.sections_off +
+                               ini->section_count * sizeof(uint32_t));
+    h.strings_size = pool.len;
+    h.file_size = h.strings_off + pool.len;
+    
+    blob = calloc(1, (size_t)h.file_size);
+    if (blob == NULL) {
+        err = ZORYA_INI_ERROR_NOMEM;
+        goto cleanup;
+    }
+    
+    memcpy(blob, &h, sizeof(h));
+    memcpy(blob + h.entries_off, entries, n * sizeof(IniBlobEntry));
+    memcpy(blob + h.items_off, items, item_total * sizeof(uint32_t));
+    memcpy(blob + h.sections_off, sections,
+           ini->section_count * sizeof(uint32_t));
+    memcpy(blob + h.strings_off, pool.data, pool.len);
+    
+    /* Build the hash index */
+    IniBlobBucket *buckets = (IniBlobBucket*)(blob + h.buckets_off);
+    for (size_t i = 0; i < n; i++) {
+        uint64_t hash = nxh64(ctx.recs[i].key, ctx.recs[i].key_len,
+                              NXH_SEED_DEFAULT);
+        uint32_t idx = (uint32_t)hash & h.bucket_mask;
+        while (buckets[idx].slot != 0) {
+            idx = (idx + 1) & h.bucket_mask;
+        }
+        buckets[idx].tag = (uint32_t)(hash >> 32);
+        buckets[idx].slot = (uint32_t)i + 1;
+    }
+    
+    err = write_atomic(filepath, blob, (size_t)h.file_size);
+
+cleanup:
+    free(blob);
+    free(sections);
+    free(items);
+    free(entries);
+    free(pool.data);
+    free(pool.slots);
+    free(ctx.recs);
+    return err;
+}
+
 /* ============================================================
  * ERROR HANDLING
  * ============================================================ */
@@ -1680,11 +2507,11 @@ void zorya_ini_stats(const ZoryaIni *ini, ZoryaIniStats *stats) {
     
     memset(stats, 0, sizeof(*stats));
     stats->section_count = ini->section_count;
-    stats->key_count = ini->key_count;
+    stats->key_count = ini->key_count + ini->blob_keys;
     stats->include_count = ini->include_count;
     
     /* Estimate memory from key count */
-    stats->memory_bytes = ini->key_count * 200;  /* Rough estimate */
+    stats->memory_bytes = ini->key_count * 200 + ini->blob_size;  /* Rough estimate */
     stats->load_factor = 0.5;  /* Placeholder */
 }
 
@@ -78,6 +78,35 @@ export interface DirEntry {
   isSymlink: boolean;
 }
 
+/**
+ * Stat results as one typed array per field, index-aligned with the
+ * input. Entries that could not be stat'ed have mode 0.
+ */
+export interface StatColumns {
+  count: number;
+  size: Float64Array;
+  /** Modification time in ms since the epoch */
+  mtime: Float64Array;
+  ino: BigUint64Array;
+  /** st_mode including the file type bits */
+  mode: Uint32Array;
+  type: Uint8Array;
+}
+
+/**
+ * A directory listing with stats. Entry i is named
+ * names.toString('utf8', nameOffsets[i], nameOffsets[i + 1]).
+ */
+export interface DirColumns extends StatColumns {
+  names: Buffer;
+  nameOffsets: Uint32Array;
+}
+
+export interface StatManyOptions {
+  /** Stat symlink targets rather than the links (default true) */
+  followSymlinks?: boolean;
+}
+
 export interface WatchEvent {
   event: number;
   path: string;
@@ -90,15 +119,592 @@ export interface WatchEvent {
   isMove: boolean;
 }
 
+export enum WatchEventType {
+  Create = 0x01,
+  Delete = 0x02,
+  Modify = 0x04,
+  Rename = 0x08,
+  Attrib = 0x10,
+  Open = 0x20,
+  Close = 0x40,
+  MoveFrom = 0x80,
+  MoveTo = 0x100,
+  Overflow = 0x200,
+  Error = 0x400,
+}
+
+export interface WatchChange extends WatchEvent {
+  /** Raw events folded into this change */
+  count: number;
+}
+
+export interface EventWatcherOptions {
+  /** Quiet period in ms before a batch is delivered (default 50) */
+  debounce?: number;
+  /** Longest a change is held back in ms (default 1000) */
+  maxLatency?: number;
+  /** Deliver early once this many changes are pending (default 4096) */
+  maxBatch?: number;
+  /** Keep the process alive while open (default true) */
+  persistent?: boolean;
+}
+
+export interface WatchAddOptions {
+  /** Watch subdirectories too */
+  recursive?: boolean;
+  /** WatchEventType mask (default Create|Delete|Modify|Attrib|Rename) */
+  events?: number;
+}
+
+export enum MmapAdvice {
+  Normal = 0,
+  Sequential = 1,
+  Random = 2,
+  WillNeed = 3,
+  DontNeed = 4,
+}
+
+export interface MmapOptions {
+  /** Byte offset into the file (any alignment) */
+  offset?: number;
+  /** Bytes to map (default: to end of file) */
+  length?: number;
+  /** Map for writing; changes reach the file when shared (default) */
+  write?: boolean;
+  shared?: boolean;
+}
+
+export enum FileAdvice {
+  Normal = 0,
+  Sequential = 1,
+  Random = 2,
+  WillNeed = 3,
+  DontNeed = 4,
+  NoReuse = 5,
+}
+
+export type FileOpenFlags = 'r' | 'r+' | 'w' | 'w+' | 'wx' | 'wx+' | 'a' | 'a+' | 'ax' | 'ax+';
+
+export interface FileOpenOptions {
+  /** Permissions for a created file (default 0o644) */
+  mode?: number;
+  /** Size of the writeBuffered() coalescing buffer (default 64 KiB) */
+  bufferSize?: number;
+}
+
+export interface AllocateOptions {
+  /** Reserve blocks without changing the file size */
+  keepSize?: boolean;
+  /** Deallocate the range instead */
+  punchHole?: boolean;
+}
+
+export interface FileLockOptions {
+  /** Shared (read) lock instead of exclusive */
+  shared?: boolean;
+  /** Return false instead of waiting when the range is held (default true) */
+  wait?: boolean;
+}
+
+export interface ChunkReaderOptions {
+  /** Bytes per chunk (default 1 MiB) */
+  chunkSize?: number;
+  /** Chunk buffers in the ring (default 4) */
+  buffers?: number;
+  /** First byte to read (default 0) */
+  offset?: number;
+  /** Bytes to read from offset (default to end of file) */
+  length?: number;
+  /** Hash each chunk and the whole stream with nxh64 */
+  hash?: boolean;
+  /** Drop read pages from the page cache behind the reader */
+  dropCache?: boolean;
+  /** Decode a zstd or LZ4-frame file; chunks then hold decoded bytes */
+  decompress?: 'zstd' | 'lz4';
+}
+
+export interface Chunk {
+  /** View over the reader's buffer; valid until released */
+  data: Buffer;
+  /** File offset of data, or its offset in the decoded stream */
+  offset: number;
+  /** Sequence number, counting from 0 */
+  seq: number;
+  /** nxh64 of data as hex, or null without the hash option */
+  hash: string | null;
+}
+
+export interface ChunkReaderInfo {
+  /** Bytes read from the file so far */
+  bytesRead: number;
+  /** nxh64 over every chunk produced, or null without the hash option */
+  hash: string | null;
+}
+
+export interface ContentCacheOptions {
+  /** Budget for cached contents, both variants (default 64 MiB) */
+  maxBytes?: number;
+  /** Larger files are read but not kept (default maxBytes / 4) */
+  maxEntry?: number;
+  /** Level for readCompressed (default 3) */
+  zstdLevel?: number;
+  /**
+   * 'stat' checks dev, inode, mtime and size on every hit (default);
+   * 'none' trusts entries until invalidate() is called
+   */
+  validate?: 'stat' | 'none';
+}
+
+export interface ContentCacheStats {
+  hits: number;
+  misses: number;
+  evictions: number;
+  entries: number;
+  /** Cached contents, both variants */
+  bytes: number;
+}
+
+export interface PathTableStats {
+  /** Interned paths and directories, including the roots "/" and "." */
+  paths: number;
+  /** Distinct path components */
+  names: number;
+  /** Approximate memory held */
+  bytes: number;
+}
+
+export interface ChannelOptions {
+  /** Ring bytes, rounded up to a power of two (default 1 MiB) */
+  capacity?: number;
+  /** Permissions for a created file (default 0o600) */
+  mode?: number;
+}
+
+export interface ChannelInfo {
+  /** Path other processes pass to Channel.open */
+  path: string;
+  capacity: number;
+  /** Largest message (half the ring, less an 8-byte header) */
+  maxMessage: number;
+  /** Bytes sent and not yet consumed */
+  used: number;
+  /** Bytes sent since creation, padding included */
+  written: number;
+  read: number;
+}
+
+export interface TarPackOptions {
+  /** Compress the stream (default 'none') */
+  compress?: 'zstd' | 'lz4' | 'none';
+  /** Codec level (default: zstd 3, lz4 fast) */
+  level?: number;
+  /** Walk and zstd worker threads (default: CPU count) */
+  threads?: number;
+  includeHidden?: boolean;
+  /** Archive what symlinks point to instead of the links */
+  followSymlinks?: boolean;
+  /** Index members so tarExtract can jump straight to one */
+  seekable?: boolean;
+  /** Seekable: uncompressed bytes per frame (default 1 MiB) */
+  frameSize?: number;
+}
+
+export interface TarUnpackOptions {
+  /** File writer threads (default: CPU count) */
+  threads?: number;
+  /** Leading path components to drop from every member */
+  strip?: number;
+}
+
+export interface TarStats {
+  files: number;
+  dirs: number;
+  /** Symlinks and hard links */
+  links: number;
+  /** File content bytes */
+  bytes: number;
+  /** Size of the archive as stored */
+  archiveBytes: number;
+  /** Entries skipped or not restored */
+  errors: number;
+}
+
+export interface ReadFileOptions {
+  /** Map the file instead of reading it (copy-on-write, never written back) */
+  mmap?: boolean;
+  /** Map automatically when the file is at least this many bytes */
+  mmapThreshold?: number;
+}
+
+export interface WriteFileOptions {
+  /** Reserve the whole file with fallocate first so it lands in few extents */
+  preallocate?: boolean;
+  /** Leave runs of zero bytes as holes instead of writing them */
+  sparse?: boolean;
+  /** Smallest zero run left as a hole, rounded up to 4 KiB (default 64 KiB) */
+  holeMin?: number;
+}
+
+export interface AtomicWrite {
+  path: string;
+  data: Buffer | string;
+}
+
+export interface AtomicBatchOptions {
+  /** One syncfs per filesystem instead of fdatasync per file (flushes unrelated dirty data too) */
+  syncfs?: boolean;
+  /** Stage data in unnamed O_TMPFILE inodes, so a crash leaves no temp files */
+  tmpfile?: boolean;
+}
+
+export interface AtomicBatchResult {
+  files: number;
+  /** fdatasync or syncfs calls */
+  flushes: number;
+  /** Directories fsync'ed */
+  dirSyncs: number;
+}
+
+export interface WalOptions {
+  /** Bytes preallocated per segment (default 64 MiB) */
+  segmentSize?: number;
+  /** Group-commit appends every N ms in the background */
+  syncInterval?: number;
+  /** Group-commit as soon as N bytes are pending */
+  syncBytes?: number;
+}
+
+export interface WalStats {
+  /** Sequence number the next append gets */
+  nextSeq: number;
+  /** Last record handed to the kernel */
+  writtenSeq: number;
+  /** Last record known to be on disk */
+  durableSeq: number;
+  segments: number;
+  /** fdatasync calls */
+  syncs: number;
+}
+
+export interface WalReplayResult {
+  /** Records passed to the callback */
+  count: number;
+  /** Last sequence number in the log (0 when empty) */
+  lastSeq: number;
+}
+
+export interface KeyValueOptions {
+  /** Bytes preallocated per data file before rolling to a new one (default 64 MiB) */
+  maxFileSize?: number;
+  /** Merge once this share of the stored bytes is dead (default 50, over 100 never) */
+  mergeDeadPercent?: number;
+  /** ...and at least this many bytes are dead (default 16 MiB) */
+  mergeMinBytes?: number;
+  /** fdatasync every put and delete */
+  sync?: boolean;
+  /** Merge in the background when the thresholds are crossed (default true) */
+  autoMerge?: boolean;
+}
+
+export interface KeyValueStats {
+  keys: number;
+  files: number;
+  /** Bytes in all data files, live or not */
+  totalBytes: number;
+  /** Bytes of records still referenced by the key directory */
+  liveBytes: number;
+  /** Completed merges since open */
+  merges: number;
+  merging: boolean;
+}
+
+export interface TreeProgress {
+  files: number;
+  dirs: number;
+  bytes: number;
+  errors: number;
+}
+
+export interface TreeError {
+  path: string;
+  code: number;
+  message: string;
+}
+
+export interface TreeResult extends Omit<TreeProgress, 'errors'> {
+  errors: TreeError[];
+  cancelled: boolean;
+}
+
+export interface TreeOptions {
+  /** Worker threads (default: online CPUs) */
+  threads?: number;
+  /** Called periodically; return false to cancel */
+  onProgress?: (progress: TreeProgress) => boolean | void;
+  /** Progress interval in ms (default: 100) */
+  progressInterval?: number;
+}
+
+export interface CopyTreeOptions extends TreeOptions {
+  overwrite?: boolean;
+  preserveMode?: boolean;
+  preserveTimes?: boolean;
+  followSymlinks?: boolean;
+}
+
+export interface WalkOptions {
+  /** Worker threads (default: online CPUs) */
+  threads?: number;
+  /** Deepest level emitted, 1 = direct children (default: unlimited) */
+  maxDepth?: number;
+  /** statx each emitted entry (default: false, d_type only) */
+  stat?: boolean;
+  followSymlinks?: boolean;
+  /** Include dot-entries (default: true) */
+  includeHidden?: boolean;
+  /** Emit files / directories (both default: true) */
+  files?: boolean;
+  directories?: boolean;
+  /** Only emit files ending in one of these suffixes */
+  extensions?: string[];
+  /** Directory names that are never entered */
+  prune?: string[];
+  /** Entries per batch delivered to JS (default: 256) */
+  batchSize?: number;
+}
+
+export interface WalkEntry {
+  path: string;
+  name: string;
+  depth: number;
+  type: FileType;
+  isFile: boolean;
+  isDirectory: boolean;
+  isSymlink: boolean;
+  /** Present with `stat: true` (times in seconds) */
+  size?: number;
+  mode?: number;
+  uid?: number;
+  gid?: number;
+  ino?: number;
+  nlink?: number;
+  atime?: number;
+  mtime?: number;
+  ctime?: number;
+}
+
+export interface SearchOptions {
+  /** Worker threads (default: online CPUs) */
+  threads?: number;
+  maxDepth?: number;
+  followSymlinks?: boolean;
+  /** Include dot-entries (default: true) */
+  includeHidden?: boolean;
+  /** Directory names that are never entered */
+  prune?: string[];
+  /** Only search files matching these globs, relative to root */
+  include?: string[];
+  /** Let include globs match dot-names (default: false) */
+  dot?: boolean;
+  /** Extra ignore rules in .gitignore syntax */
+  ignore?: string[];
+  /** Ignore files read in every directory, e.g. ['.gitignore'] */
+  ignoreFiles?: string[];
+  /** ASCII case-insensitive matching (default: false) */
+  ignoreCase?: boolean;
+  /** Search files with a NUL in their first 8 KB (default: false) */
+  binary?: boolean;
+  /** Stop after this many matching lines */
+  limit?: number;
+  /** Skip files larger than this many bytes */
+  maxFileSize?: number;
+  /** Truncate reported line text to this many bytes */
+  maxLineLength?: number;
+  /** Map files at least this big instead of reading them (default: 256 KB) */
+  mmapThreshold?: number;
+  /** Matches per batch delivered to JS (default: 256) */
+  batchSize?: number;
+}
+
+export interface SearchMatch {
+  path: string;
+  /** 1-based line number */
+  line: number;
+  /** 1-based byte column of the first match on the line */
+  column: number;
+  /** Line text without the line terminator */
+  text: string;
+  /** Index of the pattern that matched */
+  pattern: number;
+}
+
+export interface SearchResult extends TreeResult {
+  /** Regular files opened */
+  searched: number;
+  matchedFiles: number;
+  /** Files skipped as binary */
+  binary: number;
+  unreadable: number;
+  bytesSearched: number;
+  /** Matching lines */
+  matches: number;
+  limitReached: boolean;
+}
+
+export interface DuplicateOptions {
+  /** Worker threads (default: online CPUs) */
+  threads?: number;
+  maxDepth?: number;
+  followSymlinks?: boolean;
+  /** Include dot-entries (default: true) */
+  includeHidden?: boolean;
+  /** Directory names that are never entered */
+  prune?: string[];
+  /** Only consider files matching these globs, relative to root */
+  include?: string[];
+  /** Let include globs match dot-names (default: false) */
+  dot?: boolean;
+  /** Extra ignore rules in .gitignore syntax */
+  ignore?: string[];
+  /** Ignore files read in every directory, e.g. ['.gitignore'] */
+  ignoreFiles?: string[];
+  /** Ignore files smaller than this (default: 1, empty files never count) */
+  minSize?: number;
+  /** Ignore files larger than this */
+  maxSize?: number;
+  /** Bytes hashed at each end in the first pass (default: 4096) */
+  partialBytes?: number;
+  /** Report paths sharing an inode as one file (default: false) */
+  skipHardlinks?: boolean;
+}
+
+export interface DuplicateGroup {
+  size: number;
+  /** Content hash as 16 hex digits */
+  hash: string;
+  paths: string[];
+}
+
+export interface DuplicateResult extends TreeResult {
+  /** Largest files first */
+  groups: DuplicateGroup[];
+  scanned: number;
+  /** Files sharing a size with another file */
+  candidates: number;
+  partialHashed: number;
+  fullHashed: number;
+  bytesHashed: number;
+  hardlinksSkipped: number;
+  /** Files that could not be read while hashing */
+  failed: number;
+  /** Bytes that removing every duplicate would free */
+  wastedBytes: number;
+}
+
+export interface DiskUsageOptions {
+  /** Deepest directory with its own row; -1 for every directory (default 1) */
+  maxDepth?: number;
+  /** Worker threads (default: online CPUs) */
+  threads?: number;
+  /** Include dot-entries (default: true) */
+  includeHidden?: boolean;
+  /** Don't descend into other filesystems (default: false) */
+  oneFileSystem?: boolean;
+  /** Count every hard link instead of each inode once (default: false) */
+  countLinks?: boolean;
+  /** Directory names that are never entered */
+  prune?: string[];
+}
+
+/**
+ * One row per directory, sorted by path; row 0 is the root. Each
+ * row's totals cover its whole subtree.
+ */
+export interface DiskUsage {
+  count: number;
+  /** Paths relative to the root, packed; row i is names[nameOffsets[i], nameOffsets[i + 1]) */
+  names: Buffer;
+  nameOffsets: Uint32Array;
+  /** Sum of file sizes */
+  apparent: Float64Array;
+  /** Bytes allocated on disk (st_blocks * 512) */
+  allocated: Float64Array;
+  files: Float64Array;
+  /** Directories below, excluding the row itself */
+  dirs: Float64Array;
+  /** Row index of the parent directory, -1 for the root */
+  parent: Int32Array;
+  depth: Uint32Array;
+  /** Hard links skipped as already counted */
+  hardlinks: number;
+  errors: TreeError[];
+}
+
+export interface SnapshotOptions {
+  /** Worker threads for scans (default: online CPUs) */
+  threads?: number;
+  /** Keep a content hash of every file; only content changes are reported (default: false) */
+  hash?: boolean;
+  /** Include dot-entries (default: true) */
+  includeHidden?: boolean;
+  /** Directory names that are never entered */
+  prune?: string[];
+}
+
+export interface SnapshotEntry {
+  /** Relative to the snapshot root */
+  path: string;
+  type: FileType;
+  mode: number;
+  inode: number;
+  size: number;
+  mtimeMs: number;
+  ctimeMs: number;
+  mtimeNs: bigint;
+  ctimeNs: bigint;
+  /** Content hash as 16 hex digits, or null without the hash option */
+  hash: string | null;
+}
+
+export interface SnapshotChange {
+  change: 'added' | 'removed' | 'modified';
+  /** Relative to the snapshot root */
+  path: string;
+  type: FileType;
+}
+
+export interface SnapshotDiff {
+  /** Sorted by path */
+  changes: SnapshotChange[];
+  /** Paths re-stat'ed */
+  checked: number;
+  /** Directories read */
+  dirsScanned: number;
+}
+
+export interface GlobMatchOptions {
+  /** Let wildcards and ** match names starting with '.' (default: false) */
+  dot?: boolean;
+  /** Case-insensitive matching (default: false) */
+  nocase?: boolean;
+}
+
+export interface GlobOptions extends WalkOptions, GlobMatchOptions {
+  /** Extra ignore rules in .gitignore syntax, relative to root */
+  ignore?: string[];
+  /** Ignore files read in every directory, e.g. ['.gitignore'] */
+  ignoreFiles?: string[];
+}
+
 /* ============================================================
  * File Operations
  * ============================================================ */
 
 /**
- * Read entire file into buffer
+ * Read entire file into buffer (no intermediate copy)
  */
-export function readFile(path: string): Buffer {
-  return native.readFile(path);
+export function readFile(path: string, options?: ReadFileOptions): Buffer {
+  return native.readFile(path, options);
 }
 
 /**
@@ -111,9 +717,9 @@ export function readText(path: string): string {
 /**
  * Write buffer to file
  */
-export function writeFile(path: string, data: Buffer | string): void {
+export function writeFile(path: string, data: Buffer | string, options?: WriteFileOptions): void {
   const buf = typeof data === 'string' ? Buffer.from(data, 'utf-8') : data;
-  native.writeFile(path, buf);
+  native.writeFile(path, buf, options);
 }
 
 /**
@@ -124,6 +730,18 @@ export function appendFile(path: string, data: Buffer | string): void {
   native.appendFile(path, buf);
 }
 
+/**
+ * Atomically replace many files under one group commit: every file is
+ * staged, all data is flushed together, then everything is renamed
+ * into place and each directory is fsync'ed once.
+ */
+export function writeFilesAtomic(
+  files: AtomicWrite[],
+  options: AtomicBatchOptions = {}
+): Promise<AtomicBatchResult> {
+  return native.writeFilesAtomic(files, options);
+}
+
 /**
  * Copy file
  */
@@ -152,6 +770,119 @@ export function removeRecursive(path: string): void {
   native.removeRecursive(path);
 }
 
+/* ============================================================
+ * Parallel Tree Operations
+ * ============================================================ */
+
+/**
+ * Remove a directory tree using a pool of worker threads.
+ * Per-entry failures are collected in `errors` instead of aborting.
+ */
+export function removeTree(path: string, options: TreeOptions = {}): TreeResult {
+  return native.removeTree(path, options);
+}
+
+/**
+ * Copy a directory tree in parallel
+ */
+export function copyTree(src: string, dst: string, options: CopyTreeOptions = {}): TreeResult {
+  return native.copyTree(src, dst, options);
+}
+
+/**
+ * Move a tree (rename, or parallel copy + remove across filesystems)
+ */
+export function moveTree(src: string, dst: string, options: CopyTreeOptions = {}): TreeResult {
+  return native.moveTree(src, dst, options);
+}
+
+/* ============================================================
+ * Parallel Walker
+ * ============================================================ */
+
+/**
+ * Walk a tree in parallel, delivering entries in batches as they are found.
+ * Return false from onBatch to stop early. Entry order is not defined.
+ */
+export function walkBatches(
+  root: string,
+  onBatch: (entries: WalkEntry[]) => boolean | void,
+  options: WalkOptions = {}
+): Promise<TreeResult> {
+  return native.walk(root, options, onBatch);
+}
+
+/**
+ * Walk a tree in parallel and collect every entry
+ */
+export async function walk(root: string, options: WalkOptions = {}): Promise<WalkEntry[]> {
+  const entries: WalkEntry[] = [];
+  await native.walk(root, options, (batch: WalkEntry[]) => {
+    for (const entry of batch) entries.push(entry);
+  });
+  return entries;
+}
+
+/* ============================================================
+ * Content Search
+ * ============================================================ */
+
+/**
+ * Search file contents for literal patterns, delivering matching lines
+ * in batches. Every file is a task on the walker's thread pool; return
+ * false from onBatch to stop early.
+ */
+export function searchBatches(
+  root: string,
+  patterns: string | string[],
+  onBatch: (matches: SearchMatch[]) => boolean | void,
+  options: SearchOptions = {}
+): Promise<SearchResult> {
+  const list = Array.isArray(patterns) ? patterns : [patterns];
+  return native.search(root, list, options, onBatch);
+}
+
+/**
+ * Search file contents for literal patterns and collect matching lines
+ */
+export async function searchFiles(
+  root: string,
+  patterns: string | string[],
+  options: SearchOptions = {}
+): Promise<SearchMatch[]> {
+  const matches: SearchMatch[] = [];
+  await searchBatches(root, patterns, (batch) => {
+    for (const m of batch) matches.push(m);
+  }, options);
+  return matches;
+}
+
+/* ============================================================
+ * Duplicate Finder
+ * ============================================================ */
+
+/**
+ * Find files with identical content. Files are bucketed by size, then
+ * by a hash of their first and last few KB, and only the survivors are
+ * hashed in full on the thread pool.
+ */
+export function findDuplicates(root: string, options: DuplicateOptions = {}): Promise<DuplicateResult> {
+  return native.findDuplicates(root, options);
+}
+
+/* ============================================================
+ * Disk Usage
+ * ============================================================ */
+
+/**
+ * Measure a tree on the parallel walker, summing apparent size and
+ * allocated blocks per directory down to maxDepth. Hard-linked files
+ * count once, in the directory where they are seen first.
+ */
+export function duTree(root: string, options: DiskUsageOptions = {}): Promise<DiskUsage> {
+  return native.duTree(root, options);
+}
+
 /* ============================================================
  * Stat Operations
  * ============================================================ */
@@ -182,6 +913,13 @@ export function lstat(path: string): StatResult {
   };
 }
 
+/**
+ * statx many paths in one native call
+ */
+export function statMany(paths: string[], options: StatManyOptions = {}): StatColumns {
+  return native.statMany(paths, options);
+}
+
 /**
  * Check if path exists
  */
@@ -251,6 +989,14 @@ export function readdirWithTypes(path: string): DirEntry[] {
   return native.readdirWithTypes(path);
 }
 
+/**
+ * List a directory and lstat every entry in one native call. Builds a
+ * handful of objects however large the directory is.
+ */
+export function readdirPlus(path: string): DirColumns {
+  return native.readdirPlus(path);
+}
+
 /* ============================================================
  * Path Operations
  * ============================================================ */
@@ -308,6 +1054,57 @@ export function isAbsolute(path: string): boolean {
   return native.isAbsolute(path);
 }
 
+/**
+ * Relative path from one path to another, worked out lexically
+ * against the current directory
+ */
+export function relative(from: string, to: string): string {
+  return native.relative(from, to);
+}
+
+/*
+ * Batch forms take a string array or a Buffer of NUL-separated paths
+ * and answer in kind. A Buffer skips the per-string conversions and is
+ * the fast path for large batches.
+ */
+
+/**
+ * join(base, path) for every path
+ */
+export function joinMany(base: string, paths: string[]): string[];
+export function joinMany(base: string, paths: Buffer): Buffer;
+export function joinMany(base: string, paths: string[] | Buffer): string[] | Buffer {
+  return native.pathBatch('join', paths, base);
+}
+
+/**
+ * normalize() every path
+ */
+export function normalizeMany(paths: string[]): string[];
+export function normalizeMany(paths: Buffer): Buffer;
+export function normalizeMany(paths: string[] | Buffer): string[] | Buffer {
+  return native.pathBatch('normalize', paths);
+}
+
+/**
+ * relative(from, path) for every path
+ */
+export function relativeMany(from: string, paths: string[]): string[];
+export function relativeMany(from: string, paths: Buffer): Buffer;
+export function relativeMany(from: string, paths: string[] | Buffer): string[] | Buffer {
+  return native.pathBatch('relative', paths, from);
+}
+
+/**
+ * resolve() every path, joined to base first when given. Paths that
+ * can't be resolved come back as empty strings instead of throwing.
+ */
+export function resolveMany(paths: string[], base?: string): string[];
+export function resolveMany(paths: Buffer, base?: string): Buffer;
+export function resolveMany(paths: string[] | Buffer, base?: string): string[] | Buffer {
+  return native.pathBatch('resolve', paths, base);
+}
+
 /* ============================================================
  * Symlink Operations
  * ============================================================ */
@@ -387,38 +1184,628 @@ export function glob(pattern: string): string[] {
   return native.glob(pattern);
 }
 
+/**
+ * Glob a tree with the parallel walker, delivering matches in batches.
+ * Supports {a,b}, ** and '!' exclusions; directories no pattern can
+ * reach and ignored directories are never read. Directories are only
+ * emitted with `directories: true`.
+ */
+export function globBatches(
+  root: string,
+  patterns: string | string[],
+  onBatch: (entries: WalkEntry[]) => boolean | void,
+  options: GlobOptions = {}
+): Promise<TreeResult> {
+  const list = Array.isArray(patterns) ? patterns : [patterns];
+  return native.globWalk(root, list, options, onBatch);
+}
+
+/**
+ * Glob a tree with the parallel walker and collect matching paths
+ */
+export async function globTree(
+  root: string,
+  patterns: string | string[],
+  options: GlobOptions = {}
+): Promise<string[]> {
+  const paths: string[] = [];
+  await globBatches(root, patterns, (batch) => {
+    for (const entry of batch) paths.push(entry.path);
+  }, options);
+  return paths;
+}
+
+/**
+ * Test relative paths against glob patterns (a trailing '/' marks a directory)
+ */
+export function globMatch(
+  paths: string[],
+  patterns: string | string[],
+  options: GlobMatchOptions = {}
+): boolean[] {
+  const list = Array.isArray(patterns) ? patterns : [patterns];
+  return native.globMatch(paths, list, options);
+}
+
 /* ============================================================
- * File Watcher
+ * File Handles
  * ============================================================ */
 
+/* ZFO_OPEN_* bits */
+const OPEN_READ = 0x01;
+const OPEN_WRITE = 0x02;
+const OPEN_APPEND = 0x04;
+const OPEN_CREATE = 0x08;
+const OPEN_TRUNCATE = 0x10;
+const OPEN_EXCLUSIVE = 0x20;
+
+const OPEN_FLAGS: Record<FileOpenFlags, number> = {
+  'r': OPEN_READ,
+  'r+': OPEN_READ | OPEN_WRITE,
+  'w': OPEN_WRITE | OPEN_CREATE | OPEN_TRUNCATE,
+  'w+': OPEN_READ | OPEN_WRITE | OPEN_CREATE | OPEN_TRUNCATE,
+  'wx': OPEN_WRITE | OPEN_CREATE | OPEN_TRUNCATE | OPEN_EXCLUSIVE,
+  'wx+': OPEN_READ | OPEN_WRITE | OPEN_CREATE | OPEN_TRUNCATE | OPEN_EXCLUSIVE,
+  'a': OPEN_WRITE | OPEN_APPEND | OPEN_CREATE,
+  'a+': OPEN_READ | OPEN_WRITE | OPEN_APPEND | OPEN_CREATE,
+  'ax': OPEN_WRITE | OPEN_APPEND | OPEN_CREATE | OPEN_EXCLUSIVE,
+  'ax+': OPEN_READ | OPEN_WRITE | OPEN_APPEND | OPEN_CREATE | OPEN_EXCLUSIVE,
+};
+
+const SEEK_WHENCE = { set: 0, cur: 1, end: 2 };
+
+/* ZFO_LOCK_* bits */
+const LOCK_SHARED = 0x01;
+const LOCK_EXCLUSIVE = 0x02;
+const LOCK_NONBLOCK = 0x04;
+
 /**
- * File system watcher using inotify
+ * An open file. Every method is one syscall on the kept descriptor.
+ * A position of null means the current file position, as with read(2)
+ * and write(2); a number reads or writes there without moving it.
  */
-export class Watcher {
-  private watches = new Map<number, string>();
-  private initialized = false;
+export class FileHandle {
+  private handle: unknown;
+  private bufferSize: number;
+  private buffered = false;
 
-  constructor() {
-    native.watchInit();
-    this.initialized = true;
+  private constructor(handle: unknown, bufferSize: number) {
+    this.handle = handle;
+    this.bufferSize = bufferSize;
+  }
+
+  static open(path: string, flags: FileOpenFlags = 'r', options: FileOpenOptions = {}): FileHandle {
+    const bits = OPEN_FLAGS[flags];
+    if (bits === undefined) throw new TypeError(`Unknown open flags: ${flags}`);
+    const handle = native.fileOpen(path, bits, options.mode ?? 0o644);
+    return new FileHandle(handle, options.bufferSize ?? 64 * 1024);
   }
 
   /**
-   * Add path to watch
+   * Read into buffer[offset, offset + length)
+   * @returns Bytes read, 0 at end of file
    */
-  add(path: string): number {
-    if (!this.initialized) throw new Error('Watcher closed');
-    const wd = native.watchAdd(path);
-    this.watches.set(wd, path);
-    return wd;
+  read(
+    buffer: Buffer,
+    offset: number = 0,
+    length: number = buffer.length - offset,
+    position: number | null = null
+  ): number {
+    return native.fileRead(this.open(), buffer, offset, length, position);
   }
 
   /**
-   * Remove watch
+   * Write data, returning the bytes written
    */
-  remove(wd: number): void {
-    if (!this.initialized) throw new Error('Watcher closed');
-    native.watchRemove(wd);
+  write(data: Buffer | string, position: number | null = null): number {
+    const buf = typeof data === 'string' ? Buffer.from(data) : data;
+    return native.fileWrite(this.open(), buf, 0, buf.length, position);
+  }
+
+  /**
+   * Fill several buffers in order with one readv
+   */
+  readv(buffers: Buffer[], position: number | null = null): number {
+    return native.fileReadv(this.open(), buffers, position);
+  }
+
+  /**
+   * Write several buffers in order with one writev
+   */
+  writev(buffers: Buffer[], position: number | null = null): number {
+    return native.fileWritev(this.open(), buffers, position);
+  }
+
+  /**
+   * Append at the file position through a native buffer, so many small
+   * writes cost one syscall. Buffered data is written out by flush(),
+   * close(), or before any other operation on the handle.
+   */
+  writeBuffered(data: Buffer | string): void {
+    const handle = this.open();
+    if (!this.buffered) {
+      native.fileSetBuffer(handle, this.bufferSize);
+      this.buffered = true;
+    }
+    native.fileWriteBuffered(handle, typeof data === 'string' ? Buffer.from(data) : data);
+  }
+
+  flush(): void {
+    native.fileFlush(this.open());
+  }
+
+  /**
+   * Move the file position
+   * @returns The new position
+   */
+  seek(offset: number, whence: 'set' | 'cur' | 'end' = 'set'): number {
+    return native.fileSeek(this.open(), offset, SEEK_WHENCE[whence]);
+  }
+
+  stat(): StatResult {
+    return native.fileStat(this.open());
+  }
+
+  truncate(size: number = 0): void {
+    native.fileTruncate(this.open(), size);
+  }
+
+  /** fsync */
+  sync(): void {
+    native.fileSync(this.open());
+  }
+
+  /** fdatasync */
+  datasync(): void {
+    native.fileDatasync(this.open());
+  }
+
+  /**
+   * Access-pattern hint for a range (length 0 = to end of file)
+   */
+  advise(advice: FileAdvice, offset: number = 0, length: number = 0): void {
+    native.fileAdvise(this.open(), advice, offset, length);
+  }
+
+  /**
+   * Reserve blocks so later writes can't fail with ENOSPC, or punch them out
+   */
+  allocate(offset: number, length: number, options: AllocateOptions = {}): void {
+    native.fileAllocate(this.open(), offset, length, options);
+  }
+
+  /**
+   * Take a POSIX record lock (length 0 = to end of file)
+   * @returns false if wait is off and another process holds the range
+   */
+  lock(offset: number = 0, length: number = 0, options: FileLockOptions = {}): boolean {
+    let flags = options.shared ? LOCK_SHARED : LOCK_EXCLUSIVE;
+    if (options.wait === false) flags |= LOCK_NONBLOCK;
+    return native.fileLock(this.open(), offset, length, flags);
+  }
+
+  unlock(offset: number = 0, length: number = 0): void {
+    native.fileUnlock(this.open(), offset, length);
+  }
+
+  /**
+   * Flush and close the descriptor
+   */
+  close(): void {
+    if (this.handle) {
+      const handle = this.handle;
+      this.handle = null;
+      native.fileClose(handle);
+    }
+  }
+
+  private open(): unknown {
+    if (!this.handle) throw new Error('File closed');
+    return this.handle;
+  }
+}
+
+/* ============================================================
+ * Chunked Reader
+ * ============================================================ */
+
+/**
+ * Reads a large file on a background thread into a small ring of
+ * aligned buffers, one buffer ahead of the consumer. Chunks are views
+ * over those buffers: release each one once done with it so the
+ * reader can refill it. Iterating with for await releases for you.
+ */
+export class ChunkReader {
+  private handle: unknown;
+
+  private constructor(handle: unknown) {
+    this.handle = handle;
+  }
+
+  static open(path: string, options: ChunkReaderOptions = {}): ChunkReader {
+    return new ChunkReader(native.readerOpen(path, options));
+  }
+
+  /**
+   * Resolve with the next chunk in order, or null at end of stream
+   */
+  next(): Promise<Chunk | null> {
+    return native.readerNext(this.open());
+  }
+
+  /**
+   * Block until the next chunk is ready
+   */
+  nextSync(): Chunk | null {
+    return native.readerNextSync(this.open());
+  }
+
+  /**
+   * Hand a chunk's buffer back to the reader. Its data must not be
+   * used afterwards.
+   */
+  release(chunk: Chunk): void {
+    native.readerRelease(this.open(), chunk.seq);
+  }
+
+  info(): ChunkReaderInfo {
+    return native.readerInfo(this.open());
+  }
+
+  /**
+   * Stop the reader thread. Buffers of unreleased chunks stay valid
+   * until they are garbage collected.
+   */
+  close(): void {
+    if (this.handle) {
+      const handle = this.handle;
+      this.handle = null;
+      native.readerClose(handle);
+    }
+  }
+
+  async *[Symbol.asyncIterator](): AsyncGenerator<Chunk> {
+    let chunk: Chunk | null;
+    while ((chunk = await this.next())) {
+      try {
+        yield chunk;
+      } finally {
+        if (this.handle) this.release(chunk);
+      }
+    }
+  }
+
+  private open(): unknown {
+    if (!this.handle) throw new Error('Reader closed');
+    return this.handle;
+  }
+}
+
+/* ============================================================
+ * Content Cache
+ * ============================================================ */
+
+/**
+ * Read-through cache of whole-file contents with a byte budget and
+ * CLOCK eviction. A hit costs one stat and returns the same Buffer as
+ * the previous read of that file, without copying; treat the Buffers
+ * as read-only since they are shared.
+ */
+export class ContentCache {
+  private handle: unknown;
+
+  constructor(options: ContentCacheOptions = {}) {
+    this.handle = native.cacheCreate(options);
+  }
+
+  /**
+   * Contents of path, read and cached on a miss
+   */
+  read(path: string): Buffer {
+    return native.cacheRead(this.handle, path, false);
+  }
+
+  /**
+   * zstd frame of path's contents, compressed once and cached alongside
+   * them (for serving with Content-Encoding: zstd)
+   */
+  readCompressed(path: string): Buffer {
+    return native.cacheRead(this.handle, path, true);
+  }
+
+  /**
+   * Drop path, and with recursive everything below it. Returns the
+   * number of entries dropped.
+   */
+  invalidate(path: string, recursive = false): number {
+    return native.cacheInvalidate(this.handle, path, recursive);
+  }
+
+  clear(): void {
+    native.cacheClear(this.handle);
+  }
+
+  stats(): ContentCacheStats {
+    return native.cacheStats(this.handle);
+  }
+
+  /**
+   * Drop every entry; Buffers already handed out stay valid
+   */
+  close(): void {
+    native.cacheClose(this.handle);
+  }
+}
+
+/* ============================================================
+ * Path Table
+ * ============================================================ */
+
+/**
+ * Interns normalized paths as small integer ids. Paths are stored as a
+ * tree of (directory, name) nodes, so a directory shared by many paths
+ * is kept once and comparing two paths is comparing two numbers.
+ */
+export class PathTable {
+  private handle: unknown;
+
+  constructor() {
+    this.handle = native.pathTableCreate();
+  }
+
+  /**
+   * Id of path, added if new. "a/./b" and "a/b" share an id.
+   */
+  intern(path: string): number {
+    return native.pathTableIntern(this.handle, path);
+  }
+
+  internMany(paths: string[] | Buffer): Uint32Array {
+    return native.pathTableIntern(this.handle, paths);
+  }
+
+  path(id: number): string {
+    return native.pathTableGet(this.handle, id);
+  }
+
+  paths(ids: Uint32Array | number[]): string[] {
+    return native.pathTableGet(this.handle, ids);
+  }
+
+  /**
+   * Id of the directory holding id
+   */
+  dirname(id: number): number {
+    return native.pathTableParent(this.handle, id);
+  }
+
+  basename(id: number): string {
+    return native.pathTableName(this.handle, id);
+  }
+
+  stats(): PathTableStats {
+    return native.pathTableStats(this.handle);
+  }
+
+  close(): void {
+    native.pathTableClose(this.handle);
+  }
+}
+
+/* ============================================================
+ * Shared-Memory Channel
+ * ============================================================ */
+
+/**
+ * Message channel between processes over a shared mapping: any number
+ * of processes send, one receives. Messages are written and read in
+ * place, so received messages and reserved slots are Buffers viewing
+ * the mapping rather than copies. A blocked side sleeps on a futex and
+ * is woken directly by the other, without going through the event loop.
+ */
+export class Channel {
+  private buffer: ArrayBuffer;
+  readonly path: string;
+
+  private constructor(buffer: ArrayBuffer) {
+    this.buffer = buffer;
+    this.path = native.channelInfo(buffer).path;
+  }
+
+  /**
+   * Create a channel in a file at path (reset if it exists), or in an
+   * anonymous memfd reachable through the returned channel's path
+   */
+  static create(path: string | null = null, options: ChannelOptions = {}): Channel {
+    return new Channel(native.channelCreate(path, options));
+  }
+
+  /** Attach to a channel created by another process */
+  static open(path: string): Channel {
+    return new Channel(native.channelOpen(path));
+  }
+
+  /**
+   * Copy data in as one message. Returns false if the ring stayed full
+   * for timeoutMs (0 = don't wait, -1 = wait as long as it takes).
+   */
+  send(data: Buffer | string, timeoutMs: number = 0): boolean {
+    return native.channelSend(this.buffer, typeof data === 'string' ? Buffer.from(data) : data, timeoutMs);
+  }
+
+  /**
+   * Claim a slot of length bytes to fill in place, then pass it to
+   * commit(). Returns null if the ring stayed full for timeoutMs.
+   */
+  reserve(length: number, timeoutMs: number = 0): Buffer | null {
+    const offset = native.channelReserve(this.buffer, length, timeoutMs);
+    return offset === null ? null : Buffer.from(this.buffer, offset, length);
+  }
+
+  /** Publish a slot from reserve() */
+  commit(slot: Buffer): void {
+    native.channelCommit(this.buffer, slot.byteOffset);
+  }
+
+  /**
+   * Take the next message, or null if none arrived within timeoutMs
+   * (which blocks the thread; prefer wait() on the main thread). The
+   * Buffer is only valid until the next receive() or release().
+   */
+  receive(timeoutMs: number = 0): Buffer | null {
+    const msg = native.channelReceive(this.buffer, timeoutMs);
+    return msg ? Buffer.from(this.buffer, msg.offset, msg.length) : null;
+  }
+
+  /** Give the last received message's space back to senders */
+  release(): void {
+    native.channelRelease(this.buffer);
+  }
+
+  /**
+   * Resolve true once receive() has a message, or false on timeout or
+   * close. Waits off the main thread.
+   */
+  wait(timeoutMs: number = -1): Promise<boolean> {
+    return native.channelWait(this.buffer, timeoutMs);
+  }
+
+  info(): ChannelInfo {
+    return native.channelInfo(this.buffer);
+  }
+
+  /** Unmap; message Buffers still held become empty */
+  close(): void {
+    native.channelClose(this.buffer);
+  }
+
+  async *[Symbol.asyncIterator](): AsyncGenerator<Buffer> {
+    for (;;) {
+      const msg = this.receive();
+      if (msg) {
+        yield msg;
+      } else if (!(await this.wait())) {
+        return;
+      }
+    }
+  }
+}
+
+/* ============================================================
+ * Tar Archives
+ * ============================================================ */
+
+/**
+ * Pack a tree into a tar archive, optionally zstd or LZ4 compressed.
+ * Everything runs natively: the tree is walked in parallel and file
+ * data streams through the encoder without passing through JS.
+ */
+export function tarPack(root: string, archive: string, options: TarPackOptions = {}): Promise<TarStats> {
+  return native.tarPack(root, archive, options);
+}
+
+/**
+ * Unpack a tar, tar.zst or tar.lz4 archive (detected from its first
+ * bytes) into dest, writing files in parallel. Modes and mtimes are
+ * restored; members whose path contains ".." are skipped.
+ */
+export function tarUnpack(archive: string, dest: string, options: TarUnpackOptions = {}): Promise<TarStats> {
+  return native.tarUnpack(archive, dest, options);
+}
+
+/**
+ * Extract a single member to outPath. Archives packed with seekable
+ * are read from the member's own frame; others are scanned.
+ */
+export function tarExtract(archive: string, member: string, outPath: string): Promise<void> {
+  return native.tarExtract(archive, member, outPath);
+}
+
+/* ============================================================
+ * Memory Mapping
+ * ============================================================ */
+
+/**
+ * A memory-mapped file region. `buffer` is an ArrayBuffer directly over
+ * the mapping; it is detached (length 0) once unmap() is called.
+ */
+export class MappedFile {
+  readonly buffer: ArrayBuffer;
+
+  constructor(path: string, options: MmapOptions = {}) {
+    this.buffer = native.mmap(path, options);
+  }
+
+  /** Byte view over the mapping (no copy) */
+  bytes(): Buffer {
+    return Buffer.from(this.buffer);
+  }
+
+  /** Flush written pages to the file (msync) */
+  sync(): void {
+    native.mmapSync(this.buffer);
+  }
+
+  /** Access-pattern hint for a range (default: whole mapping) */
+  advise(advice: MmapAdvice, offset: number = 0, length: number = 0): void {
+    native.mmapAdvise(this.buffer, advice, offset, length);
+  }
+
+  /** Pin pages in RAM (mlock) */
+  lock(): void {
+    native.mmapLock(this.buffer, true);
+  }
+
+  unlock(): void {
+    native.mmapLock(this.buffer, false);
+  }
+
+  /** Unmap now instead of waiting for garbage collection */
+  unmap(): void {
+    native.mmapUnmap(this.buffer);
+  }
+}
+
+/**
+ * Memory-map a file
+ */
+export function mmap(path: string, options: MmapOptions = {}): MappedFile {
+  return new MappedFile(path, options);
+}
+
+/* ============================================================
+ * File Watcher
+ * ============================================================ */
+
+/**
+ * File system watcher using inotify
+ */
+export class Watcher {
+  private watches = new Map<number, string>();
+  private initialized = false;
+
+  constructor() {
+    native.watchInit();
+    this.initialized = true;
+  }
+
+  /**
+   * Add path to watch
+   * @param recursive Also watch subdirectories, including ones created later
+   */
+  add(path: string, recursive: boolean = false): number {
+    if (!this.initialized) throw new Error('Watcher closed');
+    const wd = native.watchAdd(path, recursive);
+    this.watches.set(wd, path);
+    return wd;
+  }
+
+  /**
+   * Remove watch
+   */
+  remove(wd: number): void {
+    if (!this.initialized) throw new Error('Watcher closed');
+    native.watchRemove(wd);
     this.watches.delete(wd);
   }
 
@@ -459,6 +1846,339 @@ export function watch(path?: string): Watcher {
   return watcher;
 }
 
+/**
+ * Event-driven watcher. Events are read on a native thread, coalesced
+ * (bursts of writes fold into one change, moves pair into renames) and
+ * delivered in batches. Instances are independent of each other.
+ */
+export class EventWatcher {
+  private handle: unknown;
+  private watches = new Map<number, string>();
+
+  constructor(onChanges: (changes: WatchChange[]) => void, options: EventWatcherOptions = {}) {
+    this.handle = native.watcherCreate(onChanges, options);
+  }
+
+  /**
+   * Add path to watch
+   */
+  add(path: string, options: WatchAddOptions = {}): number {
+    if (!this.handle) throw new Error('Watcher closed');
+    const wd = native.watcherAdd(this.handle, path, options);
+    this.watches.set(wd, path);
+    return wd;
+  }
+
+  /**
+   * Remove watch
+   */
+  remove(wd: number): void {
+    if (!this.handle) throw new Error('Watcher closed');
+    native.watcherRemove(this.handle, wd);
+    this.watches.delete(wd);
+  }
+
+  /**
+   * Get path for watch descriptor
+   */
+  getPath(wd: number): string | undefined {
+    return this.watches.get(wd);
+  }
+
+  /**
+   * Stop the event thread; undelivered changes are dropped
+   */
+  close(): void {
+    if (this.handle) {
+      native.watcherClose(this.handle);
+      this.watches.clear();
+      this.handle = null;
+    }
+  }
+}
+
+/**
+ * Watch one or more paths, receiving coalesced batches of changes
+ */
+export function watchEvents(
+  paths: string | string[],
+  onChanges: (changes: WatchChange[]) => void,
+  options: EventWatcherOptions & WatchAddOptions = {}
+): EventWatcher {
+  const watcher = new EventWatcher(onChanges, options);
+  try {
+    for (const path of Array.isArray(paths) ? paths : [paths]) watcher.add(path, options);
+  } catch (err) {
+    watcher.close();
+    throw err;
+  }
+  return watcher;
+}
+
+/* ============================================================
+ * Directory Snapshot
+ * ============================================================ */
+
+/**
+ * Persistent index of a directory tree. update() re-stats every entry
+ * but only reads directories whose mtime changed; apply() folds
+ * EventWatcher changes in without touching anything else.
+ */
+export class Snapshot {
+  private handle: unknown;
+
+  private constructor(handle: unknown) {
+    this.handle = handle;
+  }
+
+  /**
+   * Index every path under root
+   */
+  static async create(root: string, options: SnapshotOptions = {}): Promise<Snapshot> {
+    return new Snapshot(await native.snapshotCreate(root, options));
+  }
+
+  /**
+   * Map a snapshot written by save()
+   */
+  static load(file: string): Snapshot {
+    return new Snapshot(native.snapshotLoad(file));
+  }
+
+  get root(): string {
+    return native.snapshotInfo(this.open()).root;
+  }
+
+  /** Number of indexed paths */
+  get size(): number {
+    return native.snapshotInfo(this.open()).count;
+  }
+
+  /**
+   * Rescan changed directories and report what changed
+   */
+  update(threads: number = 0): Promise<SnapshotDiff> {
+    return native.snapshotUpdate(this.open(), threads);
+  }
+
+  /**
+   * Apply watcher changes (absolute paths under root). An overflow
+   * event falls back to a full update.
+   */
+  apply(changes: WatchEvent[]): SnapshotDiff {
+    return native.snapshotApply(this.open(), changes);
+  }
+
+  /**
+   * Look up one path relative to root
+   */
+  get(path: string): SnapshotEntry | null {
+    return native.snapshotGet(this.open(), path);
+  }
+
+  /**
+   * Every entry, in path order
+   */
+  entries(): SnapshotEntry[] {
+    return native.snapshotEntries(this.open());
+  }
+
+  /**
+   * Write to a file atomically
+   */
+  save(file: string): void {
+    native.snapshotSave(this.open(), file);
+  }
+
+  /**
+   * Release the index now instead of waiting for garbage collection
+   */
+  close(): void {
+    if (this.handle) {
+      native.snapshotClose(this.handle);
+      this.handle = null;
+    }
+  }
+
+  private open(): unknown {
+    if (!this.handle) throw new Error('Snapshot closed');
+    return this.handle;
+  }
+}
+
+/* ============================================================
+ * Write-Ahead Log
+ * ============================================================ */
+
+/**
+ * Append-only record log in a directory of preallocated segments.
+ * append() only copies into memory; records become durable through
+ * the syncInterval/syncBytes policy or an explicit sync().
+ */
+export class WriteAheadLog {
+  private handle: unknown;
+
+  private constructor(handle: unknown) {
+    this.handle = handle;
+  }
+
+  /**
+   * Open or create the log in dir. A torn tail from a crash is cut
+   * off, so appends continue after the last complete record.
+   */
+  static open(dir: string, options: WalOptions = {}): WriteAheadLog {
+    return new WriteAheadLog(native.walOpen(dir, options));
+  }
+
+  /**
+   * Visit every record with seq >= fromSeq, in order. Return false
+   * from the callback to stop early.
+   */
+  static replay(
+    dir: string,
+    onRecord: (seq: number, data: Buffer) => boolean | void,
+    fromSeq: number = 0
+  ): WalReplayResult {
+    return native.walReplay(dir, fromSeq, onRecord);
+  }
+
+  /**
+   * Append one record and return its sequence number
+   */
+  append(data: Buffer | string): number {
+    return native.walAppend(this.open(), typeof data === 'string' ? Buffer.from(data) : data);
+  }
+
+  /**
+   * Hand buffered records to the kernel without waiting for the disk
+   */
+  flush(): void {
+    native.walFlush(this.open());
+  }
+
+  /**
+   * Block until every appended record is on disk
+   */
+  sync(): void {
+    native.walSync(this.open());
+  }
+
+  /**
+   * Delete segments holding only records before beforeSeq
+   */
+  truncate(beforeSeq: number): void {
+    native.walTruncate(this.open(), beforeSeq);
+  }
+
+  stats(): WalStats {
+    return native.walStats(this.open());
+  }
+
+  /**
+   * Sync and release the log
+   */
+  close(): void {
+    if (this.handle) {
+      const handle = this.handle;
+      this.handle = null;
+      native.walClose(handle);
+    }
+  }
+
+  private open(): unknown {
+    if (!this.handle) throw new Error('Log closed');
+    return this.handle;
+  }
+}
+
+/* ============================================================
+ * Key-Value Store
+ * ============================================================ */
+
+/**
+ * Log-structured key-value store in a directory. Every key lives in
+ * an in-memory directory pointing at its newest record, so get() is a
+ * single read; overwritten and deleted records are reclaimed by merge.
+ */
+export class KeyValueStore {
+  private handle: unknown;
+
+  private constructor(handle: unknown) {
+    this.handle = handle;
+  }
+
+  /**
+   * Open or create the store in dir. Only one store may have a
+   * directory open at a time.
+   */
+  static open(dir: string, options: KeyValueOptions = {}): KeyValueStore {
+    return new KeyValueStore(native.kvOpen(dir, options));
+  }
+
+  /**
+   * Value stored under key, or null
+   */
+  get(key: Buffer | string): Buffer | null {
+    return native.kvGet(this.open(), key);
+  }
+
+  put(key: Buffer | string, value: Buffer | string): void {
+    native.kvPut(this.open(), key, value);
+  }
+
+  /**
+   * Remove key; false if it was not stored
+   */
+  delete(key: Buffer | string): boolean {
+    return native.kvDelete(this.open(), key);
+  }
+
+  has(key: Buffer | string): boolean {
+    return native.kvHas(this.open(), key);
+  }
+
+  keys(): string[];
+  keys(asBuffers: true): Buffer[];
+  keys(asBuffers: boolean = false): Array<string | Buffer> {
+    return native.kvKeys(this.open(), asBuffers);
+  }
+
+  /**
+   * Block until every put and delete is on disk
+   */
+  sync(): void {
+    native.kvSync(this.open());
+  }
+
+  /**
+   * Rewrite the sealed data files keeping only live records. Reads
+   * and writes continue while it runs.
+   */
+  merge(): Promise<void> {
+    return native.kvMerge(this.open());
+  }
+
+  stats(): KeyValueStats {
+    return native.kvStats(this.open());
+  }
+
+  /**
+   * Sync and release the store
+   */
+  close(): void {
+    if (this.handle) {
+      const handle = this.handle;
+      this.handle = null;
+      native.kvClose(handle);
+    }
+  }
+
+  private open(): unknown {
+    if (!this.handle) throw new Error('Store closed');
+    return this.handle;
+  }
+}
+
 /**
  * Get version
  */
@@ -471,12 +2191,23 @@ export default {
   readText,
   writeFile,
   appendFile,
+  writeFilesAtomic,
   copyFile,
   moveFile,
   remove,
   removeRecursive,
+  removeTree,
+  copyTree,
+  moveTree,
+  walk,
+  walkBatches,
+  searchFiles,
+  searchBatches,
+  findDuplicates,
+  duTree,
   stat,
   lstat,
+  statMany,
   exists,
   isFile,
   isDirectory,
@@ -486,6 +2217,7 @@ export default {
   mkdirp,
   readdir,
   readdirWithTypes,
+  readdirPlus,
   basename,
   dirname,
   extname,
@@ -493,6 +2225,11 @@ export default {
   normalize,
   resolve,
   isAbsolute,
+  relative,
+  joinMany,
+  normalizeMany,
+  relativeMany,
+  resolveMany,
   symlink,
   readlink,
   tmpdir,
@@ -502,8 +2239,29 @@ export default {
   chmod,
   chown,
   glob,
+  globBatches,
+  globTree,
+  globMatch,
+  FileHandle,
+  ChunkReader,
+  ContentCache,
+  PathTable,
+  Channel,
+  tarPack,
+  tarUnpack,
+  tarExtract,
+  mmap,
+  MappedFile,
+  MmapAdvice,
+  FileAdvice,
   Watcher,
   watch,
+  EventWatcher,
+  watchEvents,
+  WatchEventType,
+  Snapshot,
+  WriteAheadLog,
+  KeyValueStore,
   version,
   FileType,
 };
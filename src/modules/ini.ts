@@ -49,16 +49,18 @@ interface NativeINI {
   free(handle: IniHandle): void;
   load(handle: IniHandle, path: string): boolean;
   loadString(handle: IniHandle, content: string): boolean;
+  loadBinary(handle: IniHandle, path: string): boolean;
   get(handle: IniHandle, key: string): string | null;
   getDefault(handle: IniHandle, key: string, defaultValue: string): string;
-  getInt(handle: IniHandle, key: string): number;
-  getFloat(handle: IniHandle, key: string): number;
-  getBool(handle: IniHandle, key: string): boolean;
+  getInt(handle: IniHandle, key: string, defaultValue?: number): number;
+  getFloat(handle: IniHandle, key: string, defaultValue?: number): number;
+  getBool(handle: IniHandle, key: string, defaultValue?: boolean): boolean;
   getArray(handle: IniHandle, key: string, delimiter?: string): string[];
   has(handle: IniHandle, key: string): boolean;
   set(handle: IniHandle, key: string, value: string): void;
   toString(handle: IniHandle): string;
   save(handle: IniHandle, path: string): boolean;
+  compile(handle: IniHandle, path: string): boolean;
   sections(handle: IniHandle): string[];
   stats(handle: IniHandle): IniStats;
 }
@@ -100,6 +102,13 @@ export function loadString(handle: IniHandle, content: string): boolean {
   return native.loadString(handle, content);
 }
 
+/**
+ * Map a compiled .dd file (from compile()) into an existing handle
+ */
+export function loadBinary(handle: IniHandle, path: string): boolean {
+  return native.loadBinary(handle, path);
+}
+
 /**
  * Get a string value (key format: "section.key")
  */
@@ -116,23 +125,26 @@ export function getDefault(handle: IniHandle, key: string, defaultValue: string)
 
 /**
  * Get an integer value (key format: "section.key")
+ * Returns defaultValue (0 if omitted) when missing or not an integer.
  */
-export function getInt(handle: IniHandle, key: string): number {
-  return native.getInt(handle, key);
+export function getInt(handle: IniHandle, key: string, defaultValue?: number): number {
+  return native.getInt(handle, key, defaultValue);
 }
 
 /**
  * Get a float value (key format: "section.key")
+ * Returns defaultValue (0 if omitted) when missing or not a number.
  */
-export function getFloat(handle: IniHandle, key: string): number {
-  return native.getFloat(handle, key);
+export function getFloat(handle: IniHandle, key: string, defaultValue?: number): number {
+  return native.getFloat(handle, key, defaultValue);
 }
 
 /**
  * Get a boolean value (key format: "section.key")
+ * Returns defaultValue (false if omitted) when missing.
  */
-export function getBool(handle: IniHandle, key: string): boolean {
-  return native.getBool(handle, key);
+export function getBool(handle: IniHandle, key: string, defaultValue?: boolean): boolean {
+  return native.getBool(handle, key, defaultValue);
 }
 
 /**
@@ -170,6 +182,13 @@ export function save(handle: IniHandle, path: string): boolean {
   return native.save(handle, path);
 }
 
+/**
+ * Compile INI to a binary .dd file for fast loading
+ */
+export function compile(handle: IniHandle, path: string): boolean {
+  return native.compile(handle, path);
+}
+
 /**
  * Get all section names
  */
@@ -220,6 +239,15 @@ export class INIDocument {
     return doc;
   }
 
+  /**
+   * Load a compiled .dd file
+   */
+  static loadBinary(path: string): INIDocument {
+    const doc = new INIDocument(native.create());
+    native.loadBinary(doc._handle, path);
+    return doc;
+  }
+
   private checkFreed(): void {
     if (this._freed) {
       throw new Error('INIDocument has been freed');
@@ -350,6 +378,14 @@ export class INIDocument {
     return native.save(this._handle, path);
   }
 
+  /**
+   * Compile to a binary .dd file
+   */
+  compile(path: string): boolean {
+    this.checkFreed();
+    return native.compile(this._handle, path);
+  }
+
   /**
    * Get all section names
    */
@@ -390,6 +426,7 @@ export default {
   free,
   load,
   loadString,
+  loadBinary,
   get,
   getDefault,
   getInt,
@@ -400,6 +437,7 @@ export default {
   set,
   toString,
   save,
+  compile,
   sections,
   stats,
   INIDocument,
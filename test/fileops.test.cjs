@@ -6,28 +6,72 @@
 'use strict';
 
 const assert = require('assert');
+const fs = require('fs');
 const path = require('path');
 const os = require('os');
+const crypto = require('crypto');
+const { execFileSync, spawn } = require('child_process');
+const v8 = require('v8');
+const vm = require('vm');
 
 /* Load native module directly */
 const native = require('../lib/native/pulsar_fileops.node');
+const { zstdCompress, zstdDecompress } = require('../lib/native/pulsar_compress.node');
+
+/* Native flag values: ZFO_OPEN_*, ZFO_LOCK_*, ZFO_ADVISE_*, seek whence, ZFO_EVENT_* */
+const OPEN_READ = 0x01;
+const OPEN_WRITE = 0x02;
+const OPEN_CREATE = 0x08;
+const OPEN_TRUNCATE = 0x10;
+const LOCK_EXCLUSIVE = 0x02;
+const LOCK_NONBLOCK = 0x04;
+const ADVISE_SEQUENTIAL = 1;
+const ADVISE_RANDOM = 2;
+const ADVISE_WILLNEED = 3;
+const SEEK_CUR = 1;
+const EVENT_CREATE = 0x01;
+const EVENT_DELETE = 0x02;
+const EVENT_RENAME = 0x08;
+const EVENT_OVERFLOW = 0x200;
 
 const TEST_DIR = path.join(os.tmpdir(), 'pulsar-fileops-test-' + process.pid);
 let testCount = 0;
 let passCount = 0;
+const queue = [];
+
+/* Sections and tests run in order once queued, awaiting async tests in place */
+function section(name) {
+    queue.push({ section: name });
+}
 
 function test(name, fn) {
-    testCount++;
-    try {
-        fn();
-        passCount++;
-        console.log(`   ${name}`);
-    } catch (err) {
-        console.log(`   ${name}`);
-        console.log(`     ${err.message}`);
+    queue.push({ name, fn });
+}
+
+async function runTests() {
+    for (const { section: heading, name, fn } of queue) {
+        if (heading) {
+            console.log(`\n ${heading}\n`);
+            continue;
+        }
+        testCount++;
+        try {
+            await fn();
+            passCount++;
+            console.log(`   ${name}`);
+        } catch (err) {
+            console.log(`   ${name}`);
+            console.log(`     ${err.message}`);
+        }
     }
 }
 
+/* Run a full GC without requiring --expose-gc on the command line */
+function forceGC() {
+    v8.setFlagsFromString('--expose-gc');
+    vm.runInNewContext('gc')();
+}
+
 function setup() {
     try { native.removeRecursive(TEST_DIR); } catch { /* ignore */ }
     native.mkdir(TEST_DIR, true);
@@ -41,7 +85,7 @@ console.log('\nPulsar FileOps Tests\n');
 setup();
 
 /* System Paths */
-console.log('System Paths\n');
+section('System Paths');
 test('cwd returns string', () => {
     const cwd = native.cwd();
     assert.strictEqual(typeof cwd, 'string');
@@ -59,7 +103,7 @@ test('tmpdir returns string', () => {
 });
 
 /* Path Operations */
-console.log('\n Path Operations\n');
+section('Path Operations');
 
 test('basename extracts filename', () => {
     assert.strictEqual(native.basename('/foo/bar/baz.txt'), 'baz.txt');
@@ -81,8 +125,28 @@ test('normalize resolves . and ..', () => {
     assert.strictEqual(native.normalize('/foo/bar/../baz'), '/foo/baz');
 });
 
+test('batch path operations match the single-path forms and intern by directory', () => {
+    assert.strictEqual(native.relative('/a/b/c', '/a/d'), path.relative('/a/b/c', '/a/d'));
+    assert.strictEqual(native.relative('x', 'x'), '');
+    const paths = ['a/./b/../c', '/x//y/', '../../z/..', ''];
+    assert.deepStrictEqual(native.pathBatch('normalize', paths), paths.map((p) => native.normalize(p)));
+    assert.deepStrictEqual(native.pathBatch('join', ['c', '/abs'], '/base'), ['/base/c', '/abs']);
+    assert.deepStrictEqual(native.pathBatch('relative', ['/r/s/t', '/r/u'], '/r/s'), ['t', '../u']);
+    const packed = native.pathBatch('normalize', Buffer.from('a/./b\0/x/../y\0'));
+    assert.strictEqual(packed.toString(), 'a/b\0/y\0');
+
+    const table = native.pathTableCreate();
+    const ids = native.pathTableIntern(table, ['/src/a/one.js', '/src/a/two.js', '/src/b/one.js', 'rel/./p']);
+    assert.strictEqual(native.pathTableIntern(table, '/src/a/../a/one.js'), ids[0]);
+    assert.deepStrictEqual(native.pathTableGet(table, ids), ['/src/a/one.js', '/src/a/two.js', '/src/b/one.js', 'rel/p']);
+    assert.strictEqual(native.pathTableParent(table, ids[0]), native.pathTableParent(table, ids[1]));
+    assert.strictEqual(native.pathTableName(table, ids[2]), 'one.js');
+    assert.strictEqual(native.pathTableStats(table).names, 7);
+    native.pathTableClose(table);
+});
+
 /* File Operations */
-console.log('\n File Operations\n');
+section('File Operations');
 
 test('writeFile creates file', () => {
     const file = path.join(TEST_DIR, 'test.txt');
@@ -90,6 +154,21 @@ test('writeFile creates file', () => {
     assert(native.exists(file));
 });
 
+test('writeFile preallocates, leaves zero runs as holes and accepts empty data', () => {
+    const file = path.join(TEST_DIR, 'sparse.bin');
+    const data = Buffer.alloc(4 << 20);
+    data.fill(1, 0, 100);
+    data.fill(2, 3 << 20, (3 << 20) + 5000);
+    native.writeFile(file, data, { sparse: true, preallocate: true });
+    assert(fs.readFileSync(file).equals(data));
+    assert(fs.statSync(file).blocks * 512 < 1 << 20);
+
+    native.writeFile(file, data, { preallocate: true });
+    assert(fs.readFileSync(file).equals(data));
+    native.writeFile(file, Buffer.alloc(0));
+    assert.strictEqual(fs.statSync(file).size, 0);
+});
+
 test('readFile reads content', () => {
     const file = path.join(TEST_DIR, 'read.txt');
     native.writeFile(file, Buffer.from('Content'));
@@ -97,6 +176,19 @@ test('readFile reads content', () => {
     assert.strictEqual(data.toString(), 'Content');
 });
 
+test('readFile mmap returns file contents', () => {
+    const file = path.join(TEST_DIR, 'mapped.txt');
+    native.writeFile(file, Buffer.from('Mapped content'));
+    const data = native.readFile(file, { mmap: true });
+    assert.strictEqual(data.toString(), 'Mapped content');
+    data[0] = 0x6d;
+    assert.strictEqual(native.readFile(file).toString(), 'Mapped content');
+    assert.strictEqual(native.readFile(file, { mmapThreshold: 1 }).length, 14);
+    const empty = path.join(TEST_DIR, 'empty.txt');
+    fs.writeFileSync(empty, '');
+    assert.strictEqual(native.readFile(empty, { mmap: true }).length, 0);
+});
+
 test('appendFile appends data', () => {
     const file = path.join(TEST_DIR, 'append.txt');
     native.writeFile(file, Buffer.from('A'));
@@ -112,6 +204,45 @@ test('copyFile copies file', () => {
     assert.strictEqual(native.readFile(dst).toString(), 'Copy me');
 });
 
+test('copyFile copies large file intact', () => {
+    const src = path.join(TEST_DIR, 'big-src.bin');
+    const dst = path.join(TEST_DIR, 'big-dst.bin');
+    const data = Buffer.alloc(3 * 1024 * 1024 + 17);
+    for (let i = 0; i < data.length; i++) data[i] = (i * 31) & 0xff;
+    native.writeFile(src, data);
+    native.copyFile(src, dst);
+    assert(native.readFile(dst).equals(data));
+});
+
+test('copyFile keeps sparse files sparse', () => {
+    const src = path.join(TEST_DIR, 'sparse-src.bin');
+    const dst = path.join(TEST_DIR, 'sparse-dst.bin');
+    const fd = fs.openSync(src, 'w');
+    fs.writeSync(fd, Buffer.from('head'), 0, 4, 0);
+    fs.writeSync(fd, Buffer.from('tail'), 0, 4, 16 * 1024 * 1024);
+    fs.closeSync(fd);
+    native.copyFile(src, dst);
+    const st = fs.statSync(dst);
+    assert.strictEqual(st.size, 16 * 1024 * 1024 + 4);
+    assert(st.blocks * 512 < 1024 * 1024);
+    const out = native.readFile(dst);
+    assert.strictEqual(out.subarray(0, 4).toString(), 'head');
+    assert.strictEqual(out.subarray(out.length - 4).toString(), 'tail');
+});
+
+test('copyFile copies files that report a size of zero', () => {
+    const dst = path.join(TEST_DIR, 'cmdline.txt');
+    native.copyFile('/proc/self/cmdline', dst);
+    const copied = fs.readFileSync(dst);
+    assert(copied.length > 0);
+    assert(copied.equals(fs.readFileSync('/proc/self/cmdline')));
+
+    const empty = path.join(TEST_DIR, 'empty-src.txt');
+    fs.writeFileSync(empty, '');
+    native.copyFile(empty, path.join(TEST_DIR, 'empty-dst.txt'));
+    assert.strictEqual(fs.statSync(path.join(TEST_DIR, 'empty-dst.txt')).size, 0);
+});
+
 test('moveFile moves file', () => {
     const src = path.join(TEST_DIR, 'move-src.txt');
     const dst = path.join(TEST_DIR, 'move-dst.txt');
@@ -128,8 +259,688 @@ test('remove deletes file', () => {
     assert(!native.exists(file));
 });
 
+/* Parallel Tree Operations */
+section('Parallel Tree Operations');
+
+function makeTree(root) {
+    for (let i = 0; i < 4; i++) {
+        const dir = path.join(root, 'd' + i, 'nested');
+        native.mkdir(dir, true);
+        for (let j = 0; j < 50; j++) {
+            native.writeFile(path.join(dir, 'f' + j + '.txt'), Buffer.from('data' + j));
+        }
+    }
+    native.symlink('d0', path.join(root, 'link'));
+}
+
+test('copyTree copies nested tree', () => {
+    const src = path.join(TEST_DIR, 'tree-src');
+    const dst = path.join(TEST_DIR, 'tree-dst');
+    makeTree(src);
+    const r = native.copyTree(src, dst, { threads: 4 });
+    assert.strictEqual(r.errors.length, 0);
+    assert.strictEqual(r.files, 201);
+    assert.strictEqual(r.dirs, 9);
+    assert.strictEqual(native.readFile(path.join(dst, 'd3', 'nested', 'f42.txt')).toString(), 'data42');
+    assert.strictEqual(native.readlink(path.join(dst, 'link')), 'd0');
+});
+
+test('copyTree collects per-entry errors', () => {
+    const src = path.join(TEST_DIR, 'tree-src');
+    const dst = path.join(TEST_DIR, 'tree-dst');
+    const r = native.copyTree(src, dst);
+    assert(r.errors.length > 0);
+    assert.strictEqual(typeof r.errors[0].path, 'string');
+    assert.strictEqual(typeof r.errors[0].message, 'string');
+    assert.strictEqual(native.copyTree(src, dst, { overwrite: true }).errors.length, 0);
+});
+
+test('copyTree reports progress and propagates callback errors', () => {
+    const src = path.join(TEST_DIR, 'tree-src');
+    let last = null;
+    native.copyTree(src, path.join(TEST_DIR, 'tree-progress'), { onProgress: (p) => { last = p; } });
+    assert.strictEqual(last.files, 201);
+    assert.throws(() => native.copyTree(src, path.join(TEST_DIR, 'tree-throw'), {
+        onProgress: () => { throw new Error('stop'); }
+    }), /stop/);
+});
+
+test('moveTree and removeTree', () => {
+    const src = path.join(TEST_DIR, 'tree-dst');
+    const moved = path.join(TEST_DIR, 'tree-moved');
+    native.moveTree(src, moved);
+    assert(!native.exists(src));
+    const r = native.removeTree(moved);
+    assert.strictEqual(r.errors.length, 0);
+    assert.strictEqual(r.files, 201);
+    assert(!native.exists(moved));
+    assert.throws(() => native.copyTree(path.join(TEST_DIR, 'missing'), moved));
+});
+
+/* Parallel Walker */
+section('Parallel Walker');
+
+function makeWalkTree(root) {
+    for (let i = 0; i < 5; i++) {
+        const dir = path.join(root, 'd' + i);
+        native.mkdir(path.join(dir, 'node_modules', 'pkg'), true);
+        native.writeFile(path.join(dir, 'node_modules', 'pkg', 'index.js'), Buffer.from('x'));
+        native.writeFile(path.join(dir, '.hidden'), Buffer.from('x'));
+        for (let j = 0; j < 20; j++) {
+            native.writeFile(path.join(dir, 'f' + j + (j % 2 ? '.ts' : '.js')), Buffer.from('x'));
+        }
+    }
+}
+
+test('walk streams every entry in batches', async () => {
+    const root = path.join(TEST_DIR, 'walk');
+    makeWalkTree(root);
+    const seen = [];
+    let batches = 0;
+    const summary = await native.walk(root, { batchSize: 16 }, (batch) => {
+        batches++;
+        seen.push(...batch);
+    });
+    assert.strictEqual(seen.length, 5 * (1 + 2 + 1 + 1 + 20));
+    assert.strictEqual(summary.files, 5 * 22);
+    assert.strictEqual(summary.dirs, 15);
+    assert(batches > 1);
+    const f = seen.find((e) => e.name === 'f3.ts');
+    assert(f.isFile);
+    assert.strictEqual(f.depth, 2);
+    assert(f.path.startsWith(root + '/d'));
+});
+
+test('walk applies filters, pruning and depth', async () => {
+    const root = path.join(TEST_DIR, 'walk');
+    const seen = [];
+    await native.walk(root, {
+        extensions: ['.ts'], prune: ['node_modules'], includeHidden: false, directories: false
+    }, (batch) => { seen.push(...batch); });
+    assert.strictEqual(seen.length, 50);
+    assert(seen.every((e) => e.name.endsWith('.ts')));
+
+    const shallow = [];
+    await native.walk(root, { maxDepth: 1, stat: true }, (batch) => { shallow.push(...batch); });
+    assert.strictEqual(shallow.length, 5);
+    assert.strictEqual(typeof shallow[0].mtime, 'number');
+});
+
+test('walk stops early and rejects on errors', async () => {
+    const root = path.join(TEST_DIR, 'walk');
+    let calls = 0;
+    const summary = await native.walk(root, { batchSize: 4 }, () => { calls++; return false; });
+    assert(summary.cancelled);
+    assert.strictEqual(calls, 1);
+    await assert.rejects(native.walk(root, {}, () => { throw new Error('boom'); }), /boom/);
+    await assert.rejects(native.walk(path.join(TEST_DIR, 'missing'), {}, () => {}));
+});
+
+/* Search */
+section('Search');
+
+test('search reports matching lines and skips binary files', async () => {
+    const root = path.join(TEST_DIR, 'search');
+    fs.mkdirSync(path.join(root, 'src'), { recursive: true });
+    fs.writeFileSync(path.join(root, 'src/a.c'), 'int x;\n  TODO: fix\nreturn 0; // todo\r\nFIXME');
+    fs.writeFileSync(path.join(root, 'bin.dat'), Buffer.concat([Buffer.from('TODO'), Buffer.alloc(8)]));
+    const big = Buffer.alloc(512 * 1024, 'a');
+    big.write('\nfound TODO here\n', 300000);
+    fs.writeFileSync(path.join(root, 'big.txt'), big);
+
+    const seen = [];
+    const summary = await native.search(root, ['TODO', 'FIXME'], {}, (batch) => { seen.push(...batch); });
+    seen.sort((a, b) => a.path.localeCompare(b.path) || a.line - b.line);
+    assert.deepStrictEqual(seen.map((m) => [path.relative(root, m.path), m.line, m.column, m.text, m.pattern]), [
+        ['big.txt', 2, 7, 'found TODO here', 0],
+        ['src/a.c', 2, 3, '  TODO: fix', 0],
+        ['src/a.c', 4, 1, 'FIXME', 1]
+    ]);
+    assert.strictEqual(summary.binary, 1);
+    assert.strictEqual(summary.matchedFiles, 2);
+
+    const nocase = [];
+    await native.search(root, ['todo'], { ignoreCase: true, include: ['src/*.c'] },
+        (batch) => { nocase.push(...batch); });
+    assert.deepStrictEqual(nocase.map((m) => m.text).sort(), ['  TODO: fix', 'return 0; // todo']);
+
+    const limited = await native.search(root, ['TODO'], { binary: true, limit: 2 }, () => {});
+    assert(limited.limitReached);
+    assert.strictEqual(limited.matches, 2);
+});
+
+/* Duplicate Files */
+section('Duplicate Files');
+
+test('findDuplicates groups identical files and skips hard links', async () => {
+    const root = path.join(TEST_DIR, 'dups');
+    fs.mkdirSync(path.join(root, 'a'), { recursive: true });
+    const big = Buffer.alloc(64 * 1024);
+    for (let i = 0; i < big.length; i++) big[i] = (i * 7) & 0xff;
+    const tweaked = Buffer.from(big);
+    tweaked[30000] ^= 1;                    /* Same size and ends, different middle */
+    fs.writeFileSync(path.join(root, 'big1'), big);
+    fs.writeFileSync(path.join(root, 'a/big2'), big);
+    fs.writeFileSync(path.join(root, 'big3'), tweaked);
+    fs.writeFileSync(path.join(root, 's1'), 'hello');
+    fs.writeFileSync(path.join(root, 'a/s2'), 'hello');
+    fs.writeFileSync(path.join(root, 'e1'), '');
+    fs.writeFileSync(path.join(root, 'e2'), '');
+    fs.linkSync(path.join(root, 's1'), path.join(root, 's1link'));
+
+    const rel = (r) => r.groups.map((g) => g.paths.map((p) => path.relative(root, p)).sort());
+    const all = await native.findDuplicates(root);
+    assert.deepStrictEqual(rel(all), [['a/big2', 'big1'], ['a/s2', 's1', 's1link']]);
+    assert.strictEqual(all.groups[0].size, 64 * 1024);
+    assert.strictEqual(all.fullHashed, 3);
+    assert.strictEqual(all.wastedBytes, 64 * 1024 + 10);
+
+    const linked = await native.findDuplicates(root, { skipHardlinks: true });
+    assert.strictEqual(linked.hardlinksSkipped, 1);
+    assert.strictEqual(linked.groups[1].paths.length, 2);
+});
+
+/* Atomic Batch Writes */
+section('Atomic Batch Writes');
+
+test('writeFilesAtomic commits a batch with one flush per filesystem', async () => {
+    const root = path.join(TEST_DIR, 'batch');
+    fs.mkdirSync(path.join(root, 'sub'), { recursive: true });
+    fs.writeFileSync(path.join(root, 'keep'), 'old');
+    fs.chmodSync(path.join(root, 'keep'), 0o640);
+
+    const files = [];
+    for (let i = 0; i < 20; i++) files.push({ path: path.join(root, i % 2 ? 'sub' : '', 'f' + i), data: 'v' + i });
+    files.push({ path: path.join(root, 'keep'), data: Buffer.from('new') });
+    files.push({ path: path.join(root, 'keep'), data: 'newest' });
+
+    for (const options of [{ syncfs: true }, { tmpfile: true }]) {
+        const result = await native.writeFilesAtomic(files, options);
+        assert.strictEqual(result.files, 21);
+        assert.strictEqual(result.dirSyncs, 2);
+        if (options.syncfs) assert.strictEqual(result.flushes, 1);
+    }
+    assert.strictEqual(fs.readFileSync(path.join(root, 'sub/f3'), 'utf8'), 'v3');
+    assert.strictEqual(fs.readFileSync(path.join(root, 'keep'), 'utf8'), 'newest');
+    assert.strictEqual(fs.statSync(path.join(root, 'keep')).mode & 0o777, 0o640);
+
+    await assert.rejects(native.writeFilesAtomic([
+        { path: path.join(root, 'staged'), data: 'x' },
+        { path: path.join(root, 'missing/x'), data: 'y' },
+    ]), /missing/);
+    assert(!fs.existsSync(path.join(root, 'staged')));
+    assert.deepStrictEqual(fs.readdirSync(root).filter((f) => f.endsWith('.tmp')), []);
+});
+
+/* Snapshots */
+section('Snapshots');
+
+test('snapshot update reports only changes and survives save/load', async () => {
+    const root = path.join(TEST_DIR, 'snap');
+    fs.mkdirSync(path.join(root, 'a/b'), { recursive: true });
+    fs.mkdirSync(path.join(root, 'skip'));
+    fs.writeFileSync(path.join(root, 'a/b/f1'), 'one');
+    fs.writeFileSync(path.join(root, 'a/f2'), 'two');
+    fs.writeFileSync(path.join(root, 'top'), 'top');
+    fs.writeFileSync(path.join(root, 'skip/x'), 'x');
+
+    const snap = await native.snapshotCreate(root, { hash: true, prune: ['skip'] });
+    const paths = (entries) => entries.map((e) => e.path);
+    assert.deepStrictEqual(paths(native.snapshotEntries(snap)), ['a', 'a/b', 'a/b/f1', 'a/f2', 'top']);
+    assert.strictEqual((await native.snapshotUpdate(snap)).dirsScanned, 0);
+
+    const file = path.join(TEST_DIR, 'snap.idx');
+    native.snapshotSave(snap, file);
+    native.snapshotClose(snap);
+    const loaded = native.snapshotLoad(file);
+    assert.strictEqual(native.snapshotGet(loaded, 'a/b/f1').size, 3);
+
+    fs.writeFileSync(path.join(root, 'a/b/f1'), 'uno!');
+    fs.writeFileSync(path.join(root, 'top'), 'top');     /* Rewritten, same content */
+    fs.rmSync(path.join(root, 'a/f2'));
+    fs.mkdirSync(path.join(root, 'c'));
+    fs.writeFileSync(path.join(root, 'c/g'), 'g');
+    const diff = await native.snapshotUpdate(loaded);
+    assert.deepStrictEqual(diff.changes.map((c) => c.change + ' ' + c.path),
+        ['modified a/b/f1', 'removed a/f2', 'added c', 'added c/g']);
+
+    fs.rmSync(path.join(root, 'a/b'), { recursive: true });
+    fs.renameSync(path.join(root, 'top'), path.join(root, 'top2'));
+    const applied = native.snapshotApply(loaded, [
+        { event: EVENT_DELETE, path: path.join(root, 'a/b') },
+        { event: EVENT_RENAME, path: path.join(root, 'top2'), oldPath: path.join(root, 'top') },
+    ]);
+    assert.deepStrictEqual(applied.changes.map((c) => c.change + ' ' + c.path),
+        ['removed a/b', 'removed a/b/f1', 'removed top', 'added top2']);
+    assert.strictEqual((await native.snapshotUpdate(loaded)).changes.length, 0);
+    native.snapshotClose(loaded);
+});
+
+/* File Handles */
+section('File Handles');
+
+test('file handle does positional, vectored and buffered I/O on one descriptor', () => {
+    const file = path.join(TEST_DIR, 'handle.bin');
+    const fh = native.fileOpen(file, OPEN_READ | OPEN_WRITE | OPEN_CREATE | OPEN_TRUNCATE);
+    native.fileAllocate(fh, 0, 65536, { keepSize: true });
+    native.fileAdvise(fh, ADVISE_SEQUENTIAL);
+
+    assert.strictEqual(native.fileWritev(fh, [Buffer.from('hello '), Buffer.from('world')]), 11);
+    assert.strictEqual(native.fileWrite(fh, Buffer.from('W'), 0, 1, 6), 1);
+    const head = Buffer.alloc(5), tail = Buffer.alloc(5);
+    assert.strictEqual(native.fileReadv(fh, [head, tail], 1), 10);
+    assert.strictEqual(head.toString() + tail.toString(), 'ello World');
+
+    native.fileSetBuffer(fh, 64);
+    for (let i = 0; i < 100; i++) native.fileWriteBuffered(fh, Buffer.from('x' + i));
+    assert.strictEqual(native.fileSeek(fh, 0, SEEK_CUR), 11 + 290);
+    assert.strictEqual(native.fileStat(fh).size, 11 + 290);
+
+    const buf = Buffer.alloc(4);
+    assert.strictEqual(native.fileRead(fh, buf, 1, 3, 11), 3);
+    assert.strictEqual(buf.toString('utf8', 1), 'x0x');
+    assert.throws(() => native.fileRead(fh, buf, 2, 3, 0), RangeError);
+
+    assert.strictEqual(native.fileLock(fh, 0, 0, LOCK_EXCLUSIVE | LOCK_NONBLOCK), true);
+    native.fileWriteBuffered(fh, Buffer.from('!'));
+    native.fileClose(fh);
+    assert.throws(() => native.fileFlush(fh), /closed/);
+    assert(fs.readFileSync(file, 'utf8').endsWith('x99!'));
+});
+
+test('file handle keeps buffered data when a flush fails', () => {
+    /* Every write to /dev/full fails with ENOSPC */
+    const fh = native.fileOpen('/dev/full', OPEN_WRITE);
+    native.fileSetBuffer(fh, 64);
+    native.fileWriteBuffered(fh, Buffer.from('pending'));
+    assert.throws(() => native.fileFlush(fh), /No space/);
+    assert.throws(() => native.fileFlush(fh), /No space/);
+    assert.throws(() => native.fileWriteBuffered(fh, Buffer.alloc(100)), /No space/);
+    assert.throws(() => native.fileClose(fh), /No space/);
+});
+
+/* Write-Ahead Log */
+section('Write-Ahead Log');
+
+test('write-ahead log rotates, recovers a torn tail and replays in order', () => {
+    const dir = path.join(TEST_DIR, 'wal');
+    let log = native.walOpen(dir, { segmentSize: 4096, syncBytes: 1024 });
+    for (let i = 1; i <= 300; i++) assert.strictEqual(native.walAppend(log, Buffer.from('rec' + i)), i);
+    native.walSync(log);
+    const stats = native.walStats(log);
+    assert.strictEqual(stats.durableSeq, 300);
+    assert(stats.segments > 1);
+    native.walClose(log);
+
+    const segments = fs.readdirSync(dir).sort();
+    fs.appendFileSync(path.join(dir, segments[segments.length - 1]), Buffer.from([9, 0, 0, 0, 1, 2, 3]));
+    log = native.walOpen(dir);
+    assert.strictEqual(native.walAppend(log, Buffer.alloc(0)), 301);
+    native.walTruncate(log, 200);
+    native.walClose(log);
+    assert(fs.readdirSync(dir).length < segments.length);
+
+    const seen = [];
+    const result = native.walReplay(dir, 250, (seq, data) => {
+        seen.push(seq);
+        if (seq <= 300) assert.strictEqual(data.toString(), 'rec' + seq);
+        return seq < 301;
+    });
+    assert.deepStrictEqual(result, { count: 52, lastSeq: 301 });
+    assert.strictEqual(seen[0], 250);
+    assert.strictEqual(seen[seen.length - 1], 301);
+});
+
+/* Key-Value Store */
+section('Key-Value Store');
+
+test('key-value store rebuilds its keys on open and merges dead records', async () => {
+    const dir = path.join(TEST_DIR, 'kv');
+    let kv = native.kvOpen(dir, { maxFileSize: 4096, autoMerge: false });
+    for (let round = 0; round < 5; round++) {
+        for (let i = 0; i < 100; i++) native.kvPut(kv, 'key' + i, 'value' + i + '.' + round);
+    }
+    native.kvPut(kv, Buffer.from([0, 1, 2]), Buffer.alloc(0));
+    assert.strictEqual(native.kvDelete(kv, 'key7'), true);
+    assert.strictEqual(native.kvDelete(kv, 'key7'), false);
+    assert.throws(() => native.kvOpen(dir), /already open/);
+    native.kvClose(kv);
+
+    kv = native.kvOpen(dir, { autoMerge: false });
+    assert.strictEqual(native.kvGet(kv, 'key3').toString(), 'value3.4');
+    assert.strictEqual(native.kvGet(kv, 'key7'), null);
+    assert.strictEqual(native.kvGet(kv, Buffer.from([0, 1, 2])).length, 0);
+    const before = native.kvStats(kv);
+    assert.strictEqual(before.keys, 100);
+    await native.kvMerge(kv);
+    const after = native.kvStats(kv);
+    assert.strictEqual(after.merges, 1);
+    assert(after.totalBytes < before.totalBytes / 3);
+    assert(fs.readdirSync(dir).some((name) => name.endsWith('.hint')));
+    native.kvClose(kv);
+
+    kv = native.kvOpen(dir);
+    assert.strictEqual(native.kvKeys(kv).length, 100);
+    assert.strictEqual(native.kvGet(kv, 'key99').toString(), 'value99.4');
+    assert.strictEqual(native.kvHas(kv, 'key7'), false);
+    native.kvClose(kv);
+});
+
+test('key-value merge runs off the event loop', async () => {
+    const kv = native.kvOpen(path.join(TEST_DIR, 'kv-busy'), { autoMerge: false });
+    const value = Buffer.alloc(2000, 7);
+    for (let round = 0; round < 4; round++) {
+        for (let i = 0; i < 3000; i++) native.kvPut(kv, 'key' + i, value);
+    }
+    let ticks = 0;
+    const timer = setInterval(() => ticks++, 1);
+    try {
+        await native.kvMerge(kv);
+    } finally {
+        clearInterval(timer);
+    }
+    assert(ticks > 2, `only ${ticks} timer ticks during the merge`);
+    assert.strictEqual(native.kvGet(kv, 'key2999').length, 2000);
+    native.kvClose(kv);
+});
+
+/* Disk Usage */
+section('Disk Usage');
+
+test('duTree sums per-directory usage and counts hard links once', async () => {
+    const root = path.join(TEST_DIR, 'du');
+    native.mkdir(path.join(root, 'a', 'b', 'c'), true);
+    native.mkdir(path.join(root, 'd'), true);
+    native.writeFile(path.join(root, 'a', 'one'), Buffer.alloc(10000, 1));
+    native.writeFile(path.join(root, 'a', 'b', 'c', 'deep'), Buffer.alloc(3000, 2));
+    fs.linkSync(path.join(root, 'a', 'one'), path.join(root, 'd', 'link'));
+    fs.writeFileSync(path.join(root, 'd', 'sparse'), '');
+    fs.truncateSync(path.join(root, 'd', 'sparse'), 1 << 20);
+
+    const du = await native.duTree(root);
+    const rows = {};
+    for (let i = 0; i < du.count; i++) {
+        rows[du.names.toString('utf8', du.nameOffsets[i], du.nameOffsets[i + 1])] = i;
+    }
+    assert.deepStrictEqual(Object.keys(rows), ['', 'a', 'd']);
+    assert.strictEqual(du.hardlinks, 1);
+    assert.strictEqual(du.files[0], 4);
+    assert.strictEqual(du.dirs[0], 4);
+    assert.strictEqual(du.dirs[rows.a], 2);
+    assert.strictEqual(du.parent[rows.d], 0);
+    assert(du.apparent[0] >= 10000 + 3000 + (1 << 20));
+    assert(du.allocated[rows.d] < (1 << 20));
+    assert.strictEqual(du.apparent[0], du.apparent.slice(1).reduce((a, b) => a + b) + fs.statSync(root).size);
+
+    const all = await native.duTree(root, { maxDepth: -1, countLinks: true });
+    assert.strictEqual(all.count, 5);
+    assert.strictEqual(all.hardlinks, 0);
+    assert.strictEqual(all.depth[all.count - 2], 3);
+    assert.strictEqual(all.apparent[0], du.apparent[0] + 10000);
+});
+
+/* Tar Archives */
+section('Tar Archives');
+
+test('tar pack and unpack round-trip with a seekable index', async () => {
+    const src = path.join(TEST_DIR, 'tarsrc');
+    const out = path.join(TEST_DIR, 'tarout');
+    const archive = path.join(TEST_DIR, 'tree.tar.zst');
+    native.mkdir(path.join(src, 'a', 'b'), true);
+    const big = Buffer.alloc(200000);
+    for (let i = 0; i < big.length; i++) big[i] = (i * 13) & 0xff;
+    native.writeFile(path.join(src, 'a', 'b', 'big.bin'), big);
+    native.writeFile(path.join(src, 'a', 'run.sh'), Buffer.from('#!/bin/sh\n'));
+    native.chmod(path.join(src, 'a', 'run.sh'), 0o755);
+    native.writeFile(path.join(src, 'x'.repeat(120)), Buffer.from('long'));
+    native.symlink('a/run.sh', path.join(src, 'link'));
+
+    const packed = await native.tarPack(src, archive, { compress: 'zstd', seekable: true, frameSize: 4096 });
+    assert.strictEqual(packed.files, 3);
+    assert.strictEqual(packed.links, 1);
+    assert(packed.archiveBytes > 0 && packed.archiveBytes < packed.bytes);
+
+    const unpacked = await native.tarUnpack(archive, out);
+    assert.strictEqual(unpacked.files, 3);
+    assert.strictEqual(unpacked.errors, 0);
+    assert(native.readFile(path.join(out, 'a', 'b', 'big.bin')).equals(big));
+    assert.strictEqual(native.stat(path.join(out, 'a', 'run.sh')).mode & 0o777, 0o755);
+    assert.strictEqual(native.readFile(path.join(out, 'x'.repeat(120))).toString(), 'long');
+    assert.strictEqual(native.readlink(path.join(out, 'link')), 'a/run.sh');
+
+    const one = path.join(TEST_DIR, 'one.bin');
+    await native.tarExtract(archive, 'a/b/big.bin', one);
+    assert(native.readFile(one).equals(big));
+    await assert.rejects(native.tarExtract(archive, 'nope', one));
+});
+
+/* Content Cache */
+section('Content Cache');
+
+test('content cache returns the same buffer until the file changes', () => {
+    const file = path.join(TEST_DIR, 'cached.txt');
+    native.writeFile(file, Buffer.from('hot '.repeat(500)));
+
+    const cache = native.cacheCreate({ maxBytes: 8192, maxEntry: 4096 });
+    const first = native.cacheRead(cache, file);
+    assert.strictEqual(native.cacheRead(cache, file), first);
+    const packed = native.cacheRead(cache, file, true);
+    assert(packed.length < first.length);
+    assert(zstdDecompress(packed).equals(first));
+
+    native.writeFile(file, Buffer.from('changed, and a different size'));
+    const second = native.cacheRead(cache, file);
+    assert.notStrictEqual(second, first);
+    assert.strictEqual(second.toString(), 'changed, and a different size');
+    assert.strictEqual(first.length, 2000);
+
+    for (let i = 0; i < 4; i++) {
+        const f = path.join(TEST_DIR, `cached${i}.bin`);
+        native.writeFile(f, Buffer.alloc(3000, i));
+        assert.strictEqual(native.cacheRead(cache, f)[0], i);
+    }
+    const stats = native.cacheStats(cache);
+    assert.strictEqual(stats.hits, 1);
+    assert(stats.evictions > 0 && stats.bytes <= 8192);
+    assert.throws(() => native.cacheRead(cache, path.join(TEST_DIR, 'missing')));
+
+    const trusting = native.cacheCreate({ validate: 'none' });
+    const held = native.cacheRead(trusting, file);
+    fs.writeFileSync(file, 'newer');
+    assert.strictEqual(native.cacheRead(trusting, file), held);
+    assert.strictEqual(native.cacheInvalidate(trusting, TEST_DIR, true), 1);
+    assert.strictEqual(native.cacheRead(trusting, file).toString(), 'newer');
+    native.cacheClose(cache);
+    assert.throws(() => native.cacheRead(cache, file), /closed/);
+});
+
+test('content cache keeps compressed copies of incompressible files', () => {
+    const file = path.join(TEST_DIR, 'random.bin');
+    const data = crypto.randomBytes(20000);
+    native.writeFile(file, data);
+
+    const cold = native.cacheCreate({ maxBytes: 100000 });
+    for (let i = 0; i < 3; i++) {
+        assert(zstdDecompress(native.cacheRead(cold, file, true)).equals(data));
+    }
+    assert.strictEqual(native.cacheStats(cold).hits, 2);
+
+    // Raw contents already cached are not charged against maxEntry again
+    const warm = native.cacheCreate({ maxBytes: 100000, maxEntry: 25000 });
+    native.cacheRead(warm, file);
+    native.cacheRead(warm, file, true);
+    assert(zstdDecompress(native.cacheRead(warm, file, true)).equals(data));
+    assert.strictEqual(native.cacheStats(warm).hits, 1);
+});
+
+/* Channels */
+section('Channels');
+
+test('channel carries messages from another process in order', async () => {
+    const ch = native.channelCreate(null, { capacity: 4096 });
+    const info = native.channelInfo(ch);
+    assert.strictEqual(info.capacity, 4096);
+    assert.strictEqual(info.maxMessage, 2040);
+    assert.throws(() => native.channelReserve(ch, 4000), /half/);
+
+    const sender = `
+        const native = require(${JSON.stringify(require.resolve('../lib/native/pulsar_fileops.node'))});
+        const ch = native.channelOpen(process.argv[1]);
+        for (let i = 0; i < 2000; i++) native.channelSend(ch, Buffer.alloc(i % 300 + 4, i % 251), -1);
+        const off = native.channelReserve(ch, 4, -1);
+        Buffer.from(ch, off, 4).write('done');
+        native.channelCommit(ch, off);
+    `;
+    const child = spawn(process.execPath, ['-e', sender, info.path], { stdio: 'inherit' });
+    const exited = new Promise((resolve) => child.on('exit', resolve));
+
+    let count = 0, last = null;
+    for (;;) {
+        const msg = native.channelReceive(ch);
+        if (!msg) {
+            assert.strictEqual(await native.channelWait(ch, 10000), true);
+            continue;
+        }
+        const view = Buffer.from(ch, msg.offset, msg.length);
+        if (count === 2000) {
+            last = view.toString();
+            break;
+        }
+        assert.strictEqual(view.length, count % 300 + 4);
+        assert(view.every((b) => b === count % 251));
+        count++;
+    }
+    assert.strictEqual(last, 'done');
+    assert.strictEqual(await exited, 0);
+
+    native.channelRelease(ch);
+    assert.strictEqual(native.channelInfo(ch).used, 0);
+    assert.strictEqual(await native.channelWait(ch, 20), false);
+    const pending = native.channelWait(ch);
+    native.channelClose(ch);
+    assert.strictEqual(await pending, false);
+    assert.strictEqual(ch.byteLength, 0);
+    assert.throws(() => native.channelSend(ch, Buffer.from('x')), /Invalid|closed/);
+});
+
+/* Chunk Reader */
+section('Chunk Reader');
+
+test('chunk reader streams ranges and zstd with held buffers', async () => {
+    const data = Buffer.alloc(300000);
+    for (let i = 0; i < data.length; i++) data[i] = (i * 7 + (i >> 9)) & 0xff;
+    const file = path.join(TEST_DIR, 'stream.bin');
+    fs.writeFileSync(file, data);
+
+    let r = native.readerOpen(file, { chunkSize: 65536, buffers: 2, offset: 1000, length: 200000, hash: true });
+    const held = [await native.readerNext(r), native.readerNextSync(r)];
+    assert.strictEqual(held[0].offset, 1000);
+    assert.strictEqual(held[1].offset, 1000 + 65536);
+    assert.strictEqual(typeof held[0].hash, 'string');
+    assert.throws(() => native.readerNextSync(r), /release/);
+    const parts = held.map((c) => Buffer.from(c.data));
+    held.forEach((c) => native.readerRelease(r, c.seq));
+    let chunk;
+    while ((chunk = native.readerNextSync(r))) {
+        parts.push(Buffer.from(chunk.data));
+        native.readerRelease(r, chunk.seq);
+    }
+    assert(Buffer.concat(parts).equals(data.subarray(1000, 201000)));
+    assert.strictEqual(native.readerInfo(r).bytesRead, 200000);
+    native.readerClose(r);
+
+    const packed = path.join(TEST_DIR, 'stream.zst');
+    fs.writeFileSync(packed, zstdCompress(data));
+    r = native.readerOpen(packed, { chunkSize: 40000, decompress: 'zstd' });
+    parts.length = 0;
+    while ((chunk = await native.readerNext(r))) {
+        parts.push(Buffer.from(chunk.data));
+        native.readerRelease(r, chunk.seq);
+    }
+    native.readerClose(r);
+    assert(Buffer.concat(parts).equals(data));
+
+    fs.truncateSync(packed, fs.statSync(packed).size - 4);
+    r = native.readerOpen(packed, { decompress: 'zstd' });
+    await assert.rejects(async () => {
+        while ((chunk = await native.readerNext(r))) native.readerRelease(r, chunk.seq);
+    });
+    native.readerClose(r);
+});
+
+/* Memory Mapping */
+section('Memory Mapping');
+
+test('mmap maps a range as an ArrayBuffer', () => {
+    const file = path.join(TEST_DIR, 'mmap.bin');
+    native.writeFile(file, Buffer.from('0123456789abcdef'));
+    const ab = native.mmap(file, { offset: 3, length: 5 });
+    assert(ab instanceof ArrayBuffer);
+    assert.strictEqual(Buffer.from(ab).toString(), '34567');
+    native.mmapAdvise(ab, ADVISE_RANDOM);
+    native.mmapAdvise(ab, ADVISE_WILLNEED, 1, 2);
+    native.mmapUnmap(ab);
+    assert.strictEqual(ab.byteLength, 0);
+    assert.throws(() => native.mmapSync(ab), /unmapped/);
+});
+
+test('mmap handle stays valid after unmap and GC', async () => {
+    const file = path.join(TEST_DIR, 'mmap-gc.bin');
+    native.writeFile(file, Buffer.from('0123456789abcdef'));
+    const ab = native.mmap(file, { write: true });
+    native.mmapUnmap(ab);
+    await new Promise((resolve) => setTimeout(resolve, 10));
+    forceGC();
+    await new Promise((resolve) => setTimeout(resolve, 10));
+    assert.throws(() => native.mmapSync(ab), /unmapped/);
+    assert.throws(() => native.mmapUnmap(ab), /unmapped/);
+    assert.throws(() => native.mmapLock(ab), /unmapped/);
+});
+
+test('mmap write mode reaches the file', () => {
+    const file = path.join(TEST_DIR, 'mmap.bin');
+    const ab = native.mmap(file, { write: true });
+    new Uint8Array(ab)[0] = 0x58;
+    native.mmapSync(ab);
+    native.mmapUnmap(ab);
+    assert.strictEqual(native.readFile(file).toString(), 'X123456789abcdef');
+
+    const ro = native.mmap(file);
+    new Uint8Array(ro)[1] = 0x59;
+    assert.strictEqual(native.readFile(file).toString(), 'X123456789abcdef');
+});
+
+test('mmap opens read-only files and rejects ranges past end of file', () => {
+    const file = path.join(TEST_DIR, 'mmap-ro.txt');
+    native.writeFile(file, Buffer.from('read only'));
+    fs.chmodSync(file, 0o444);
+    /* Root may write anything, so check as an unprivileged user who can
+     * also load a copy of the addon from the test directory */
+    const asUser = process.getuid && process.getuid() === 0 ? { uid: 65534, gid: 65534 } : {};
+    const addon = path.join(TEST_DIR, 'probe.node');
+    fs.copyFileSync(require.resolve('../lib/native/pulsar_fileops.node'), addon);
+    fs.chmodSync(TEST_DIR, 0o755);
+    const probe = `
+        const native = require(process.argv[2]);
+        const ab = native.mmap(process.argv[1]);
+        new Uint8Array(ab)[0] = 0x52;
+        process.stdout.write(Buffer.from(ab).toString());
+        native.mmapUnmap(ab);
+    `;
+    const out = execFileSync(process.execPath, ['-e', probe, file, addon], asUser);
+    assert.strictEqual(out.toString(), 'Read only');
+    assert.strictEqual(native.readFile(file).toString(), 'read only');
+
+    assert.throws(() => native.mmap(file, { length: 10 }), /Invalid argument/);
+    assert.throws(() => native.mmap(file, { offset: 4, length: 6 }), /Invalid argument/);
+    assert.throws(() => native.mmap(file, { offset: 10 }), /Invalid argument/);
+    const tail = native.mmap(file, { offset: 5 });
+    assert.strictEqual(Buffer.from(tail).toString(), 'only');
+    native.mmapUnmap(tail);
+});
+
 /* Stat Operations */
-console.log('\n Stat Operations\n');
+section('Stat Operations');
 
 test('exists returns true for existing', () => {
     assert(native.exists(TEST_DIR));
@@ -165,7 +976,7 @@ test('stat returns metadata', () => {
 });
 
 /* Directory Operations */
-console.log('\n Directory Operations\n');
+section('Directory Operations');
 
 test('mkdir creates directory', () => {
     const dir = path.join(TEST_DIR, 'newdir');
@@ -189,6 +1000,35 @@ test('readdir lists contents', () => {
     assert(entries.includes('b.txt'));
 });
 
+test('readdirPlus and statMany return packed columns', () => {
+    const dir = path.join(TEST_DIR, 'columns');
+    native.mkdir(path.join(dir, 'sub'), true);
+    const long = 'n'.repeat(255);
+    native.writeFile(path.join(dir, 'héllo.txt'), Buffer.from('12345'));
+    native.writeFile(path.join(dir, long), Buffer.from('x'));
+    native.symlink('héllo.txt', path.join(dir, 'link'));
+
+    const cols = native.readdirPlus(dir);
+    assert.strictEqual(cols.count, 4);
+    assert(cols.size instanceof Float64Array && cols.ino instanceof BigUint64Array);
+    const byName = {};
+    for (let i = 0; i < cols.count; i++) {
+        byName[cols.names.toString('utf8', cols.nameOffsets[i], cols.nameOffsets[i + 1])] = i;
+    }
+    assert.deepStrictEqual(Object.keys(byName).sort(), ['héllo.txt', 'link', long, 'sub'].sort());
+    assert.strictEqual(cols.size[byName['héllo.txt']], 5);
+    assert.strictEqual(cols.mode[byName.sub] & 0o170000, 0o040000);
+    assert.strictEqual(cols.type[byName.link], 3);
+    assert(Math.abs(cols.mtime[byName['héllo.txt']] - Date.now()) < 60000);
+
+    const many = native.statMany([path.join(dir, 'link'), path.join(dir, 'missing')]);
+    assert.strictEqual(many.size[0], 5);
+    assert.strictEqual(many.ino[0], cols.ino[byName['héllo.txt']]);
+    assert.strictEqual(many.mode[1], 0);
+    assert.strictEqual(many.names, undefined);
+    assert.throws(() => native.readdirPlus(path.join(dir, 'missing')));
+});
+
 test('removeRecursive removes tree', () => {
     const dir = path.join(TEST_DIR, 'rmtree');
     native.mkdir(path.join(dir, 'sub'), true);
@@ -198,7 +1038,7 @@ test('removeRecursive removes tree', () => {
 });
 
 /* Symlinks */
-console.log('\n Symlinks\n');
+section('Symlinks');
 
 test('symlink creates link', () => {
     const target = path.join(TEST_DIR, 'link-target.txt');
@@ -217,7 +1057,7 @@ test('readlink reads target', () => {
 });
 
 /* Glob */
-console.log('\n Glob\n');
+section('Glob');
 
 test('glob finds matches', () => {
     const dir = path.join(TEST_DIR, 'glob');
@@ -228,8 +1068,43 @@ test('glob finds matches', () => {
     assert.strictEqual(matches.length, 2);
 });
 
+test('globMatch handles braces, globstar, classes and negation', () => {
+    const m = (paths, pats, opts) => native.globMatch(paths, pats, opts);
+    assert.deepStrictEqual(m(['a.js', 'x/y/b.ts', 'c.c', '.h.ts', 'x/.d/e.ts'], ['**/*.{js,ts}']),
+        [true, true, false, false, false]);
+    assert.deepStrictEqual(m(['.h.ts', 'x/.d/e.ts'], ['**/*.ts'], { dot: true }), [true, true]);
+    assert.deepStrictEqual(m(['src/a/b.ts', 'src/node_modules/m.ts'], ['src/**', '!**/node_modules/**']),
+        [true, false]);
+    assert.deepStrictEqual(m(['f1.txt', 'fx.txt', 'F2.TXT'], ['f[0-9].txt']), [true, false, false]);
+    assert.deepStrictEqual(m(['F2.TXT'], ['f[0-9].txt'], { nocase: true }), [true]);
+    assert.deepStrictEqual(m(['out', 'out/'], ['out/']), [false, true]);
+});
+
+test('globWalk honours ignore files and prunes unreachable dirs', async () => {
+    const root = path.join(TEST_DIR, 'globwalk');
+    for (const f of ['a.js', 'src/b.ts', 'src/c.js', 'src/gen/g.js', 'src/keep.log', 'src/x.log',
+                     'node_modules/m/i.js', 'build/o.js']) {
+        fs.mkdirSync(path.dirname(path.join(root, f)), { recursive: true });
+        fs.writeFileSync(path.join(root, f), 'x');
+    }
+    fs.writeFileSync(path.join(root, '.gitignore'), '# deps\nnode_modules\n/build/\n*.log\n');
+    fs.writeFileSync(path.join(root, 'src/.gitignore'), 'gen/\n!keep.log\n');
+
+    const seen = [];
+    await native.globWalk(root, ['**/*.{js,ts,log}'], { ignoreFiles: ['.gitignore'] }, (batch) => {
+        for (const e of batch) seen.push(path.relative(root, e.path));
+    });
+    assert.deepStrictEqual(seen.sort(), ['a.js', 'src/b.ts', 'src/c.js', 'src/keep.log']);
+
+    /* Only src/ can hold matches, so nothing else is read */
+    const narrow = [];
+    const summary = await native.globWalk(root, ['src/*.ts'], {}, (batch) => { narrow.push(...batch); });
+    assert.deepStrictEqual(narrow.map((e) => e.name), ['b.ts']);
+    assert.strictEqual(summary.dirs, 4);
+});
+
 /* Watch */
-console.log('\n Watch\n');
+section('Watch');
 
 test('watch lifecycle works', () => {
     native.watchInit();
@@ -241,24 +1116,111 @@ test('watch lifecycle works', () => {
     native.watchClose();
 });
 
+test('event watcher coalesces bursts and pairs renames', async () => {
+    const dir = path.join(TEST_DIR, 'watch-events');
+    fs.mkdirSync(dir);
+    const changes = [];
+    const h = native.watcherCreate((batch) => changes.push(...batch), { debounce: 30 });
+    const other = native.watcherCreate(() => {}, { persistent: false });
+    try {
+        native.watcherAdd(h, dir);
+        const file = path.join(dir, 'a.txt');
+        fs.writeFileSync(file, 'x');
+        for (let i = 0; i < 20; i++) {
+            fs.appendFileSync(file, 'y');
+            fs.chmodSync(file, i % 2 ? 0o644 : 0o600);
+        }
+        fs.writeFileSync(path.join(dir, 'transient'), 'x');
+        fs.unlinkSync(path.join(dir, 'transient'));
+        fs.renameSync(file, path.join(dir, 'b.txt'));
+        await new Promise((r) => setTimeout(r, 300));
+    } finally {
+        native.watcherClose(h);
+        native.watcherClose(other);
+    }
+
+    assert.strictEqual(changes.length, 2);
+    assert.strictEqual(changes[0].event, EVENT_CREATE);
+    assert.strictEqual(changes[0].path, path.join(dir, 'a.txt'));
+    assert(changes[0].count > 2);
+    assert.strictEqual(changes[1].event, EVENT_RENAME);
+    assert.strictEqual(changes[1].oldPath, path.join(dir, 'a.txt'));
+    assert.strictEqual(changes[1].path, path.join(dir, 'b.txt'));
+    assert.throws(() => native.watcherAdd(h, dir), /closed/);
+});
+
+test('recursive watch scales past 256 dirs and follows new ones', async () => {
+    const dir = path.join(TEST_DIR, 'watch-deep');
+    for (let i = 0; i < 300; i++) fs.mkdirSync(path.join(dir, `d${i % 10}`, `s${i}`), { recursive: true });
+    const chain = path.join('chain', ...Array(200).fill('n'));
+    fs.mkdirSync(path.join(dir, chain), { recursive: true });
+    const changes = [];
+    const h = native.watcherCreate((batch) => changes.push(...batch), { debounce: 30 });
+    try {
+        native.watcherAdd(h, dir, { recursive: true });
+        fs.writeFileSync(path.join(dir, 'd9', 's299', 'deep'), 'x');
+        fs.writeFileSync(path.join(dir, chain, 'bottom'), 'x');
+        fs.mkdirSync(path.join(dir, 'fresh', 'a'), { recursive: true });
+        fs.writeFileSync(path.join(dir, 'fresh', 'a', 'early'), 'x');
+        await new Promise((r) => setTimeout(r, 150));
+        fs.writeFileSync(path.join(dir, 'fresh', 'a', 'late'), 'x');
+        await new Promise((r) => setTimeout(r, 150));
+    } finally {
+        native.watcherClose(h);
+    }
+
+    const created = changes.filter((c) => c.event === EVENT_CREATE).map((c) => path.relative(dir, c.path));
+    for (const p of ['d9/s299/deep', path.join(chain, 'bottom'), 'fresh', 'fresh/a', 'fresh/a/early', 'fresh/a/late']) {
+        assert(created.includes(p), `missing ${p}`);
+    }
+});
+
+test('watch rescans after queue overflow', () => {
+    const dir = path.join(TEST_DIR, 'watch-overflow');
+    fs.mkdirSync(dir);
+    native.watchInit();
+    try {
+        native.watchAdd(dir, true);
+        let limit = 16384;
+        try { limit = parseInt(fs.readFileSync('/proc/sys/fs/inotify/max_queued_events', 'utf8'), 10); } catch {}
+        for (let i = 0; i <= limit; i++) fs.writeFileSync(path.join(dir, `f${i}`), '');
+        fs.mkdirSync(path.join(dir, 'missed', 'sub'), { recursive: true });
+
+        let overflows = 0;
+        let events;
+        while ((events = native.watchPoll(0)).length) {
+            overflows += events.filter((e) => e.event === EVENT_OVERFLOW).length;
+        }
+        assert.strictEqual(overflows, 1);
+
+        const file = path.join(dir, 'missed', 'sub', 'after');
+        fs.writeFileSync(file, 'x');
+        assert(native.watchPoll(100).some((e) => e.path === file));
+    } finally {
+        native.watchClose();
+    }
+});
+
 /* Version */
-console.log('\n Version\n');
+section('Version');
 
 test('version returns string', () => {
     const v = native.version();
     assert.strictEqual(typeof v, 'string');
 });
 
-/* Cleanup */
-cleanup();
+/* Run everything in order, then cleanup */
+runTests().then(() => {
+    cleanup();
 
-/* Summary */
-console.log('\n' + '─'.repeat(40));
-console.log(`\n Results: ${passCount}/${testCount} tests passed\n`);
+    /* Summary */
+    console.log('\n' + '─'.repeat(40));
+    console.log(`\n Results: ${passCount}/${testCount} tests passed\n`);
 
-if (passCount === testCount) {
-    console.log('All fileops tests passed!\n');
-    process.exit(0);
-} else {
-    process.exit(1);
-}
+    if (passCount === testCount) {
+        console.log('All fileops tests passed!\n');
+        process.exit(0);
+    } else {
+        process.exit(1);
+    }
+});
@@ -111,6 +111,36 @@ test('getBool returns boolean', () => {
     native.free(ctx);
 });
 
+test('typed getters cache values and honor defaults', () => {
+    const ctx = native.create();
+    native.loadString(ctx, '[limits]\nrequests = 250\nratio = 0.75\nbeta = on\nname = edge');
+    for (let i = 0; i < 3; i++) {
+        assert.strictEqual(native.getInt(ctx, 'limits.requests'), 250);
+        assert.strictEqual(native.getFloat(ctx, 'limits.ratio'), 0.75);
+        assert.strictEqual(native.getBool(ctx, 'limits.beta'), true);
+    }
+    assert.strictEqual(native.getInt(ctx, 'limits.name', -1), -1);
+    assert.strictEqual(native.getInt(ctx, 'limits.missing', 42), 42);
+    assert.strictEqual(native.getFloat(ctx, 'limits.missing', 1.5), 1.5);
+    assert.strictEqual(native.getBool(ctx, 'limits.missing', true), true);
+
+    native.set(ctx, 'limits.requests', '300');
+    assert.strictEqual(native.getInt(ctx, 'limits.requests'), 300);
+
+    const longKey = 'limits.' + 'k'.repeat(400);
+    native.set(ctx, longKey, '7');
+    assert.strictEqual(native.getInt(ctx, longKey), 7);
+
+    /* Multi-byte character straddling the 256-byte key buffer */
+    const prefix = 'limits.' + 'k'.repeat(247);
+    native.set(ctx, prefix, '1');
+    native.set(ctx, prefix + '\u20ac', '2');
+    assert.strictEqual(native.getInt(ctx, prefix + '\u20ac'), 2);
+    assert.strictEqual(native.get(ctx, prefix + '\u20ac'), '2');
+    assert.strictEqual(native.has(ctx, prefix + '\u20ac\u20ac'), false);
+    native.free(ctx);
+});
+
 test('getArray returns array', () => {
     const ctx = native.create();
     // ZORYA-INI uses pipe (|) as array delimiter
@@ -177,6 +207,51 @@ test('save throws (not yet implemented)', () => {
     native.free(ctx);
 });
 
+test('compile and loadBinary round-trip resolved typed values', () => {
+    const ctx = native.create();
+    native.loadString(ctx, '[app]\nname=srv\nport:int=8080\nrate:float=0.5\n' +
+        'on:bool=yes\nurl=http://${name}:${port}\nlist=a | b | c');
+    const file = path.join(os.tmpdir(), `pulsar-ini-${process.pid}.dd`);
+    native.compile(ctx, file);
+    native.free(ctx);
+
+    const bin = native.create();
+    native.loadBinary(bin, file);
+    assert.strictEqual(native.get(bin, 'app.url'), 'http://srv:8080');
+    assert.strictEqual(native.getInt(bin, 'app.port'), 8080);
+    assert.strictEqual(native.getFloat(bin, 'app.rate'), 0.5);
+    assert.strictEqual(native.getBool(bin, 'app.on'), true);
+    assert.deepStrictEqual(native.getArray(bin, 'app.list'), ['a', 'b', 'c']);
+    assert.strictEqual(native.has(bin, 'app.missing'), false);
+    assert.deepStrictEqual(native.sections(bin), ['app']);
+
+    native.set(bin, 'app.name', 'override');
+    assert.strictEqual(native.get(bin, 'app.name'), 'override');
+    native.free(bin);
+    fs.unlinkSync(file);
+
+    assert.throws(() => native.loadBinary(native.create(), __filename), /Not a compiled INI file/);
+});
+
+test('stats count keys shared by parsed and compiled entries once', () => {
+    const src = native.create();
+    native.loadString(src, '[app]\nname=srv\nport:int=8080\nhost=local');
+    const file = path.join(os.tmpdir(), `pulsar-ini-keys-${process.pid}.dd`);
+    native.compile(src, file);
+    native.free(src);
+
+    const ctx = native.create();
+    native.loadString(ctx, '[app]\nname=mine\nextra=1');
+    native.loadBinary(ctx, file);
+    fs.unlinkSync(file);
+    assert.strictEqual(native.stats(ctx).keys, 4);
+    assert.strictEqual(native.get(ctx, 'app.name'), 'mine');
+
+    native.set(ctx, 'app.host', 'remote');
+    assert.strictEqual(native.stats(ctx).keys, 4);
+    native.free(ctx);
+});
+
 /* Sections */
 console.log('\n Sections\n');
 